@@ -0,0 +1,5 @@
+#include <sys/stat.h>
+
+int main() {
+	return 0;
+}
@@ -0,0 +1,5 @@
+#include <stdint.h>
+
+int main() {
+	return 0;
+}
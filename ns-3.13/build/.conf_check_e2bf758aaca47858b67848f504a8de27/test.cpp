@@ -0,0 +1,5 @@
+#include <linux/if_tun.h>
+
+int main() {
+	return 0;
+}
@@ -0,0 +1,8 @@
+#! /usr/bin/env python
+
+# Programs that are runnable.
+ns3_runnable_programs = ['aodv', 'csma-bridge', 'csma-bridge-one-hop', 'config-store-save', 'main-callback', 'sample-simulator', 'main-ptr', 'main-random-variable', 'sample-random-variable', 'main-test-sync', 'csma-one-subnet', 'csma-broadcast', 'csma-packet-socket', 'csma-multicast', 'csma-raw-ip-socket', 'csma-ping', 'csma-star', 'dsdv-manet', 'emu-udp-echo', 'emu-ping', 'li-ion-energy-source', 'main-simple', 'lte-phy-downlink', 'lte-phy-uplink', 'lte-device', 'lte-channel-model', 'lte-amc', 'lte-multiple-flows', 'mesh', 'main-grid-topology', 'main-random-topology', 'main-random-walk', 'simple-distributed', 'third-distributed', 'nms-p2p-nix-distributed', 'dumbbell-animation', 'grid-animation', 'star-animation', 'main-packet-header', 'main-packet-tag', 'nix-simple', 'nms-p2p-nix', 'simple-point-to-point-olsr', 'olsr-hna', 'pmip6-example', 'pmip6-scale', 'main-attribute-value', 'main-propagation-loss', 'adhoc-aloha-ideal-phy', 'adhoc-aloha-ideal-phy-matrix-propagation-loss-model', 'adhoc-aloha-ideal-phy-with-microwave-oven', 'tap-csma', 'tap-csma-virtual-machine', 'tap-wifi-virtual-machine', 'tap-wifi-dumbbell', 'gnuplot-example', 'topology-read', 'uan-cw-example', 'uan-rc-example', 'virtual-net-device', 'wifi-phy-test', 'wimax-ipv4', 'wimax-multicast', 'wimax-simple', 'tcp-large-transfer', 'tcp-nsc-lfn', 'tcp-nsc-zoo', 'tcp-star-server', 'star', 'tcp-bulk-send', 'energy-model-example', 'dynamic-global-routing', 'static-routing-slash32', 'global-routing-slash32', 'global-injection-slash32', 'simple-global-routing', 'simple-alternate-routing', 'mixed-global-routing', 'simple-routing-ping6', 'manet-routing-compare', 'wifi-example-sim', 'udp-client-server', 'udp-trace-client-server', 'simple-error-model', 'mixed-wireless', 'wifi-clear-channel-cmu', 'wifi-wired-bridging', 'simple-wifi-frame-aggregation', 'multirate', 'wifi-blockack', 'ofdm-validation', 'wifi-hidden-terminal', 'hello-simulator', 'first', 'second', 'third', 'fourth', 'fifth', 'sixth', 'udp-echo', 'socket-bound-static-routing', 'socket-bound-tcp-static-routing', 'realtime-udp-echo', 'object-names', 'icmpv6-redirect', 'ping6', 'radvd', 'radvd-two-prefix', 'test-ipv6', 'fragmentation-ipv6', 'loose-routing-ipv6', 'ns2-mobility-trace', 'matrix-topology', 'pmip6-wifi', 'udp6-client-server', 'scratch-simulator']
+
+# Scripts that are runnable.
+ns3_runnable_scripts = ['csma-bridge.py', 'sample-simulator.py', 'wifi-olsr-flowmon.py', 'tap-csma-virtual-machine.py', 'tap-wifi-virtual-machine.py', 'simple-routing-ping6.py', 'mixed-wireless.py', 'first.py', 'realtime-udp-echo.py']
+
@@ -0,0 +1,279 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Hyon-Young Choi <commani@gmail.com>
+ */
+
+#ifndef BINDING_CACHE_H
+#define BINDING_CACHE_H
+
+#include <stdint.h>
+
+#include <list>
+
+#include "ns3/packet.h"
+#include "ns3/nstime.h"
+#include "ns3/net-device.h"
+#include "ns3/ipv6-address.h"
+#include "ns3/ptr.h"
+#include "ns3/sgi-hashmap.h"
+#include "ns3/identifier.h"
+#include "ns3/ipv6-mobility-message-template.h"
+#include "ns3/pmipv6-timer-wheel.h"
+
+namespace ns3
+{
+
+class BindingCache : public Object
+{
+public:
+  class Entry;
+  
+  static TypeId GetTypeId ();
+
+  BindingCache();
+  
+  ~BindingCache();
+  
+  BindingCache::Entry *Lookup(Identifier mnId, std::list<Ipv6Address> hnpList, bool &allMatched);
+  BindingCache::Entry *Lookup(Identifier mnId, uint8_t att, Identifier mnLinkId);
+  BindingCache::Entry *Lookup(Identifier mnId);
+  
+  /**
+   * \brief lookup the binding which owns a home network prefix.
+   * \param hnp home network prefix
+   * \return the entry, or 0 if no binding holds the prefix
+   */
+  BindingCache::Entry *LookupByHomeNetworkPrefix(Ipv6Address hnp);
+
+  /**
+   * \brief lookup a binding by its MN link-layer identifier.
+   * \param mnLinkId MN link-layer identifier
+   * \return the entry, or 0 if not found
+   */
+  BindingCache::Entry *LookupByMnLinkIdentifier(Identifier mnLinkId);
+
+  /**
+   * \brief lookup the bindings registered through a MAG.
+   *
+   * The remaining entries of the same MAG are reached through
+   * Entry::GetNextByProxyCoa ().
+   *
+   * \param pcoa Proxy-CoA of the MAG
+   * \return the first entry, or 0 if the MAG has no binding
+   */
+  BindingCache::Entry *LookupByProxyCoa(Ipv6Address pcoa);
+
+  BindingCache::Entry *Add(Identifier mnId);
+  
+  /**
+   * \brief unlink the entry from all indexes and delete it.
+   *
+   * Runs in constant time, the entry is reached through its own links.
+   * A pending tentative entry is deleted as well.
+   */
+  void Remove(BindingCache::Entry *entry);
+  
+  void Flush();
+  
+  uint32_t GetNEntries() const;
+  
+  Ptr<Node> GetNode() const;
+  void SetNode(Ptr<Node> node);
+  
+  class Entry
+  {
+  public:
+    Entry(Ptr<BindingCache> bcache);
+    
+    Entry *Copy();
+    
+    bool IsUnreachable() const;
+    bool IsDeregistering() const;
+    bool IsRegistering() const;
+    bool IsReachable() const;
+    
+    void MarkUnreachable();
+    void MarkDeregistering();
+    void MarkRegistering();
+    void MarkReachable();
+    
+    void StartReachableTimer();
+    void StopReachableTimer();
+    
+    void StartDeregisterTimer();
+    void StopDeregisterTimer();
+    
+    void StartRegisterTimer();
+    void StopRegisterTimer();
+    
+    void FunctionReachableTimeout();
+    void FunctionDeregisterTimeout();
+    void FunctionRegisterTimeout();
+    
+    bool Match(Identifier mnId, std::list<Ipv6Address> hnpList, bool &allMatched) const;
+    bool Match(Identifier mnId, uint8_t att, Identifier mnLinkId) const;
+    
+    Identifier GetMnIdentifier() const;
+    void SetMnIdentifier(Identifier mnId);
+    
+    Identifier GetMnLinkIdentifier() const;
+    void SetMnLinkIdentifier(Identifier mnLinkId);
+    
+    std::list<Ipv6Address> GetHomeNetworkPrefixes() const;
+    void SetHomeNetworkPrefixes(std::list<Ipv6Address> hnpList);
+    
+    Ipv6Address GetMagLinkAddress() const;
+    void SetMagLinkAddress(Ipv6Address lla);
+    
+    Ipv6Address GetProxyCoa() const;
+    void SetProxyCoa(Ipv6Address pcoa);
+    
+    int16_t GetTunnelIfIndex() const;
+    void SetTunnelIfIndex(int16_t tunnelif);
+    
+    uint8_t GetAccessTechnologyType() const;
+    void SetAccessTechnologyType(uint8_t att);
+    
+    uint8_t GetHandoffIndicator() const;
+    void SetHandoffIndicator(uint8_t hi);
+    
+    Time GetLastBindingUpdateTime() const;
+    void SetLastBindingUpdateTime(Time tm);
+    
+    Time GetReachableTime() const;
+    void SetReachableTime(Time tm);
+    
+    uint16_t GetLastBindingUpdateSequence() const;
+    void SetLastBindingUpdateSequence(uint16_t seq);
+    
+    /**
+     * \brief Bulk binding update group (RFC 6602), 0 if the binding
+     * is only refreshed on its own.
+     */
+    uint32_t GetGroupIdentifier() const;
+    void SetGroupIdentifier(uint32_t groupId);
+    
+    /**
+     * \brief Wire image of the PBA, cleared when an option changes.
+     */
+    Ipv6MobilityMessageTemplate &GetPbaTemplate();
+    
+    Entry *GetNext() const;
+    void SetNext(Entry *entry);
+    
+    Entry *GetTentativeEntry() const;
+    void SetTentativeEntry(Entry *entry);
+    
+    Ipv6Address GetOldProxyCoa() const;
+    
+    Entry *GetNextByProxyCoa() const;
+    
+  private:
+    friend class BindingCache;
+
+    Ptr<BindingCache> m_bCache;
+    
+    enum BindingCacheState_e {
+      UNREACHABLE,
+      DEREGISTERING,
+      REGISTERING,
+      REACHABLE
+    };
+    
+    BindingCacheState_e m_state;
+    
+    Identifier m_mnIdentifier;
+    
+    Identifier m_mnLinkIdentifier;
+    
+    std::list<Ipv6Address> m_homeNetworkPrefixes;
+    
+    Ipv6Address m_magLinkAddress;
+    
+    Ipv6Address m_proxyCoa;
+    
+    int16_t m_tunnelIfIndex;
+    
+    uint8_t m_accessTechnologyType;
+    
+    uint8_t m_handoffIndicator;
+    
+    uint32_t m_groupIdentifier;
+    
+    Time m_lastBindingUpdateTime;
+    uint16_t m_lastBindingUpdateSequence;
+    Ipv6MobilityMessageTemplate m_pbaTemplate;
+    
+    Time m_reachableTime;
+    Pmipv6Timer m_reachableTimer;
+    Pmipv6Timer m_deregisterTimer;
+    Pmipv6Timer m_registerTimer;
+    
+    Entry *m_next;
+    
+    //internal
+    
+    Entry *m_tentativeEntry;
+    Ipv6Address m_oldProxyCoa;
+    
+    // true while the entry is linked in the cache; entries created
+    // by Copy () (tentative entries) are never indexed.
+    bool m_linked;
+    Entry *m_prev;
+    Entry *m_prevByProxyCoa;
+    Entry *m_nextByProxyCoa;
+
+  };
+  
+protected:
+
+private:
+  typedef sgi::hash_map<Identifier, BindingCache::Entry *, IdentifierHash> BCache;
+  typedef sgi::hash_map<Identifier, BindingCache::Entry *, IdentifierHash>::iterator BCacheI;
+  typedef sgi::hash_map<Ipv6Address, BindingCache::Entry *, Ipv6AddressHash> BCacheAddrIndex;
+  typedef sgi::hash_map<Ipv6Address, BindingCache::Entry *, Ipv6AddressHash>::iterator BCacheAddrIndexI;
+  
+  void DoDispose();
+  
+  void LinkPrefixes(BindingCache::Entry *entry);
+  void UnlinkPrefixes(BindingCache::Entry *entry);
+  void LinkMnLinkIdentifier(BindingCache::Entry *entry);
+  void UnlinkMnLinkIdentifier(BindingCache::Entry *entry);
+  void LinkProxyCoa(BindingCache::Entry *entry);
+  void UnlinkProxyCoa(BindingCache::Entry *entry);
+  
+  // per-MN chain heads, linked through Entry::m_next / m_prev
+  BCache m_bCache;
+  
+  // secondary indexes
+  BCacheAddrIndex m_hnpIndex;
+  BCache m_mnLinkIndex;
+  BCacheAddrIndex m_proxyCoaIndex;
+  
+  uint32_t m_nEntries;
+  
+  Ptr<Node> m_node;
+};
+
+} /* ns3 */
+
+#endif /* BINDING_CACHE_H */
@@ -0,0 +1,149 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Hyon-Young Choi <commani@gmail.com>
+ */
+ 
+#ifndef IDENTIFIER_H
+#define IDENTIFIER_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include <ostream>
+
+#include "ns3/attribute-helper.h"
+
+namespace ns3
+{
+
+class Mac48Address;
+
+/**
+ * \class Identifier
+ * \brief Identifier.
+ *
+ * The identifier bytes are interned: every distinct identifier value is
+ * stored once, together with its hash, in a reference counted record
+ * shared by all the Identifier instances holding that value. An
+ * Identifier is therefore a single pointer, comparison is a pointer
+ * comparison and hashing returns the value computed when the record
+ * was created.
+ */
+class Identifier
+{
+public:
+  enum MaxSize_e {
+    MAX_SIZE = 255
+  };
+  
+  Identifier();
+  Identifier(const uint8_t *buffer, uint8_t len);
+  Identifier(const char *str);
+  Identifier(Mac48Address addr);
+  Identifier(const Identifier & identifier);
+  Identifier &operator = (const Identifier &identifier);
+  ~Identifier();
+  
+  uint8_t GetLength (void) const;
+  
+  uint32_t CopyTo (uint8_t *buffer, uint8_t len) const;
+  
+  uint32_t CopyFrom (const uint8_t *buffer, uint8_t len);
+  
+  bool IsEmpty() const;
+  
+  /**
+   * \return the hash of the identifier bytes, 0 for an empty identifier.
+   */
+  uint32_t GetHash (void) const;
+  
+  /**
+   * \return the number of distinct identifiers currently interned.
+   */
+  static uint32_t GetNInterned (void);
+
+protected:
+
+private:
+  friend bool operator == (const Identifier &a, const Identifier &b);
+  friend bool operator != (const Identifier &a, const Identifier &b);
+  friend std::ostream& operator<< (std::ostream& os, const Identifier & identifier);
+  
+  /**
+   * \brief interned identifier value, allocated with room for m_len bytes.
+   */
+  struct Rep
+  {
+    uint32_t m_hash;
+    uint32_t m_refCount;
+    uint8_t m_len;
+    uint8_t m_data[1];
+  };
+  
+  class InternTable;
+  
+  static InternTable *GetInternTable (void);
+  static Rep *Intern (const uint8_t *buffer, uint8_t len);
+  static void Release (Rep *rep);
+  
+  Rep *m_rep; // 0 for the empty identifier
+};
+
+ATTRIBUTE_HELPER_HEADER (Identifier);
+
+inline bool operator == (const Identifier &a, const Identifier &b)
+{
+  return a.m_rep == b.m_rep;
+}
+
+inline bool operator != (const Identifier &a, const Identifier &b)
+{
+  return a.m_rep != b.m_rep;
+}
+
+inline uint32_t Identifier::GetHash (void) const
+{
+  return m_rep ? m_rep->m_hash : 0;
+}
+
+std::ostream& operator<< (std::ostream& os, const Identifier & identifier);
+
+/**
+ * \class IdentifierHash
+ * \brief Hash function class for Identifier.
+ */
+class IdentifierHash : public std::unary_function<Identifier, size_t>
+{
+public:
+  /**
+   * \brief Unary operator to hash Identifier.
+   * \param x Identifier to hash
+   */
+  size_t operator () (Identifier const &x) const
+  {
+    return x.GetHash ();
+  }
+};
+
+} /* namespace ns3 */
+
+#endif /* IDENTIFIER_H */
@@ -0,0 +1,10 @@
+/* WARNING! All changes made to this file will be lost! */
+
+#ifndef _NS3_NETANIM_CONFIG_H_WAF
+#define _NS3_NETANIM_CONFIG_H_WAF
+
+#define HAVE_PACKET_H 1
+#define HAVE_SYS_SOCKET_H 1
+#define HAVE_NETINET_IN_H 1
+
+#endif /* _NS3_NETANIM_CONFIG_H_WAF */
@@ -0,0 +1,211 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Hyon-Young Choi <commani@gmail.com>
+ */
+
+#ifndef PMIP6_HELPER_H
+#define PMIP6_HELPER_H
+
+#include <list>
+#include <utility>
+
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/packet.h"
+#include "ns3/ptr.h"
+#include "ns3/object-factory.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/ipv6-l3-protocol.h"
+#include "ns3/trace-helper.h"
+#include "ns3/nstime.h"
+
+#include "ns3/identifier.h"
+#include "ns3/pmipv6-handover-buffer.h"
+#include "ns3/pmipv6-processor.h"
+#include "ns3/pmipv6-lma-pool.h"
+
+namespace ns3 {
+
+class Node;
+class Pmip6ProfileHelper;
+class Pmipv6Profile;
+class Pmipv6Mag;
+
+class Pmip6LmaHelper {
+public:
+  Pmip6LmaHelper();
+  ~Pmip6LmaHelper();
+  /**
+   * 
+   * \param node The node on which to install the stack.
+   *
+   * Nothing is installed on a node of another rank of a distributed
+   * simulation (see Pmip6PartitionHelper).
+   */
+  void Install (Ptr<Node> node) const;
+  
+  void SetProfileHelper(Pmip6ProfileHelper *pf);
+  
+  void SetPrefixPoolBase(Ipv6Address prefixBegin, uint8_t prefixLen);
+  
+  /**
+   * \brief Add a disjoint pool, used once the previous ones are exhausted.
+   */
+  void AddPrefixPool(Ipv6Address prefixBegin, uint8_t prefixLen);
+  
+  /**
+   * \param quarantine how long released prefixes are kept before reuse (default 0)
+   */
+  void SetPrefixPoolQuarantine(Time quarantine);
+  
+  /**
+   * \param enable route the traffic between two MNs through their MAGs
+   * only (RFC 6705, default false)
+   */
+  void SetLocalizedRouting(bool enable);
+  
+  /**
+   * \brief Give the LMA a limited signaling capacity (default unlimited).
+   * \param serviceTime processing time of each mobility message, 0 to disable
+   * \param nServers messages processed at the same time
+   * \param maxQueue messages waiting for processing
+   * \param priority which messages are processed first
+   * \param policy which messages to drop when the queue is full
+   */
+  void SetProcessing(Time serviceTime, uint32_t nServers = 1, uint32_t maxQueue = 1000,
+                     Pmipv6Processor::PriorityPolicy_e priority = Pmipv6Processor::FIFO,
+                     Pmipv6Processor::DropPolicy_e policy = Pmipv6Processor::DROP_TAIL);
+  
+  /**
+   * \param maxBindings redirect the new registrations to a less loaded
+   * LMA of the pool beyond that many bindings (RFC 6463), 0 to disable
+   */
+  void SetRedirectThreshold(uint32_t maxBindings);
+
+protected:
+
+private:
+  Pmip6ProfileHelper *m_profile;
+  
+  Ipv6Address m_prefixBegin;
+  uint8_t m_prefixBeginLen;
+  
+  std::list<std::pair<Ipv6Address, uint8_t> > m_extraPools;
+  Time m_quarantine;
+  bool m_localizedRouting;
+  
+  Time m_serviceTime;
+  uint32_t m_servers;
+  uint32_t m_maxQueue;
+  Pmipv6Processor::PriorityPolicy_e m_priority;
+  Pmipv6Processor::DropPolicy_e m_dropPolicy;
+  
+  uint32_t m_redirectThreshold;
+};
+
+class Pmip6MagHelper {
+public:
+  Pmip6MagHelper();
+  ~Pmip6MagHelper();
+  
+  /**
+   * 
+   * \param node The node on which to install the stack.
+   *
+   * Nothing is installed on a node of another rank of a distributed
+   * simulation, nor on its access points of other ranks (see
+   * Pmip6PartitionHelper).
+   */
+  void Install (Ptr<Node> node) const;
+  void Install (Ptr<Node> node, Ipv6Address target, NodeContainer aps) const;
+  
+  void SetProfileHelper(Pmip6ProfileHelper *pf);
+  
+  /**
+   * \param bulk register the bindings for bulk refresh (RFC 6602, default false)
+   */
+  void SetBulkRegistration(bool bulk);
+  
+  /**
+   * \param lifetime binding lifetime requested by the MAGs, in seconds
+   */
+  void SetBindingLifetime(uint16_t lifetime);
+  
+  /**
+   * \param fast accept the MN contexts pushed by the previous MAGs (RFC 5949, default false)
+   */
+  void SetFastHandover(bool fast);
+  
+  /**
+   * \brief Hold, forward and deliver the downlink packets of the MNs
+   * handing over (default disabled).
+   * \param maxPackets packets held per MN, 0 to disable
+   * \param maxBytes bytes held for all the MNs of a MAG
+   * \param policy which packets to drop when a limit is reached
+   */
+  void SetHandoverBuffering(uint32_t maxPackets, uint32_t maxBytes = 1 << 20,
+                            Pmipv6HandoverBuffer::DropPolicy_e policy = Pmipv6HandoverBuffer::DROP_TAIL);
+  
+protected:
+
+private:
+  void Configure (Ptr<Pmipv6Mag> mag) const;
+  
+  Pmip6ProfileHelper *m_profile;
+  
+  bool m_bulk;
+  uint16_t m_lifetime;
+  bool m_fastHandover;
+  
+  uint32_t m_bufferPackets;
+  uint32_t m_bufferBytes;
+  Pmipv6HandoverBuffer::DropPolicy_e m_bufferPolicy;
+};
+
+class Pmip6ProfileHelper {
+public:
+  Pmip6ProfileHelper();
+  ~Pmip6ProfileHelper();
+  
+  Ptr<Pmipv6Profile> GetProfile();
+  
+  void AddProfile(Identifier mnId, Identifier mnLinkId, Ipv6Address lmaa, std::list<Ipv6Address> hnps);
+  
+  /**
+   * \brief Add a MN served by the LMA the pool gives it.
+   */
+  void AddProfile(Identifier mnId, Identifier mnLinkId, std::list<Ipv6Address> hnps);
+  
+  /**
+   * \brief Set the LMAs of the MNs added without LMA address.
+   */
+  void SetLmaPool(Ptr<Pmipv6LmaPool> pool);
+  Ptr<Pmipv6LmaPool> GetLmaPool();
+protected:
+
+private:
+  Ptr<Pmipv6Profile> m_profile;
+};
+
+} // namespace ns3
+
+#endif /* PMIP6_HELPER_H */
@@ -0,0 +1,45 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_PMIP6
+    
+
+// Module headers:
+#include "binding-cache.h"
+#include "binding-update-list.h"
+#include "identifier.h"
+#include "ipv6-mobility-demux.h"
+#include "ipv6-mobility-header.h"
+#include "ipv6-mobility-l4-protocol.h"
+#include "ipv6-mobility-message-template.h"
+#include "ipv6-mobility-option-demux.h"
+#include "ipv6-mobility-option-header.h"
+#include "ipv6-mobility-option.h"
+#include "ipv6-mobility.h"
+#include "ipv6-static-source-routing-helper.h"
+#include "ipv6-static-source-routing.h"
+#include "ipv6-tunnel-compressed-header.h"
+#include "ipv6-tunnel-l4-protocol.h"
+#include "pmip6-helper.h"
+#include "pmip6-partition-helper.h"
+#include "pmip6-stats-helper.h"
+#include "pmip6.h"
+#include "pmipv6-agent.h"
+#include "pmipv6-attachment-replay.h"
+#include "pmipv6-handover-buffer.h"
+#include "pmipv6-lma-pool.h"
+#include "pmipv6-lma.h"
+#include "pmipv6-mag-notifier.h"
+#include "pmipv6-mag.h"
+#include "pmipv6-prefix-pool.h"
+#include "pmipv6-prefix-routing-helper.h"
+#include "pmipv6-prefix-routing.h"
+#include "pmipv6-processor.h"
+#include "pmipv6-profile.h"
+#include "pmipv6-timer-wheel.h"
+#include "tunnel-net-device.h"
+#include "unicast-radvd-interface.h"
+#include "unicast-radvd.h"
+#endif
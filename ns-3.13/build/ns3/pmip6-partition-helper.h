@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PMIP6_PARTITION_HELPER_H
+#define PMIP6_PARTITION_HELPER_H
+
+#include <stdint.h>
+
+#include "ns3/node-container.h"
+#include "ns3/ptr.h"
+
+namespace ns3 {
+
+class Node;
+
+/**
+ * \brief Place the agents of a PMIPv6 domain on the ranks of a
+ * distributed simulation (DistributedSimulatorImpl).
+ *
+ * The LMAs and the MAGs, in clusters of neighbouring MAGs, are spread
+ * over the ranks in contiguous blocks; each MAG cluster stays on one
+ * rank, with its access points and mobile nodes, so that most handovers
+ * do not cross ranks. A node's rank is its system id, set when the node
+ * is created, so the helper creates the nodes.
+ *
+ * Every rank builds the whole topology and the same profiles, but the
+ * PMIPv6 helpers only install the agents of the nodes of the local rank
+ * (see IsLocal), and the other nodes must be silenced
+ * (SilenceRemoteNodes). The agents only talk through mobility messages, so a
+ * MAG and its LMA may be on different ranks as long as the links
+ * crossing ranks are point-to-point links with a non-zero delay, the
+ * lookahead of the ranks. The LMA pool is not shared between ranks:
+ * only its consistent hashing, which gives every rank the same LMA for
+ * a MN, fits a distributed run.
+ *
+ * With a single rank, every node is local and the helper makes no
+ * difference, so the same scenario runs sequentially.
+ */
+class Pmip6PartitionHelper
+{
+public:
+  Pmip6PartitionHelper ();
+
+  void SetNRanks (uint32_t nRanks);
+  uint32_t GetNRanks () const;
+
+  /**
+   * \brief Number of neighbouring MAGs kept on a rank together, by
+   * default (0) the MAGs are split evenly over the ranks.
+   */
+  void SetMagClusterSize (uint32_t nMags);
+
+  uint32_t GetLmaRank (uint32_t lma, uint32_t nLmas) const;
+  uint32_t GetMagRank (uint32_t mag, uint32_t nMags) const;
+
+  /**
+   * \brief Create the LMA nodes, each on its rank.
+   */
+  NodeContainer CreateLmas (uint32_t nLmas) const;
+
+  /**
+   * \brief Create the MAG nodes, each on the rank of its cluster.
+   */
+  NodeContainer CreateMags (uint32_t nMags) const;
+
+  /**
+   * \return whether the node is simulated by this rank
+   */
+  static bool IsLocal (Ptr<Node> node);
+
+  /**
+   * \brief Keep the copies of the nodes of the other ranks quiet.
+   *
+   * Their interfaces would start the duplicate address detection, and
+   * their remote point-to-point channels carry the messages to the rank
+   * simulating the node. Call it once the Internet stack is installed,
+   * before the interfaces are set up or given addresses.
+   */
+  static void SilenceRemoteNodes (NodeContainer c);
+
+private:
+  uint32_t GetRank (uint32_t index, uint32_t n) const;
+
+  uint32_t m_nRanks;
+  uint32_t m_clusterSize;
+};
+
+} // namespace ns3
+
+#endif /* PMIP6_PARTITION_HELPER_H */
@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PMIP6_STATS_HELPER_H
+#define PMIP6_STATS_HELPER_H
+
+#include <vector>
+#include <ostream>
+
+#include "ns3/node-container.h"
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/mac48-address.h"
+#include "ns3/sgi-hashmap.h"
+#include "ns3/basic-data-calculators.h"
+#include "ns3/data-collector.h"
+
+#include "ns3/identifier.h"
+
+namespace ns3 {
+
+class Node;
+
+/**
+ * \brief Measure the handovers and count the signaling of PMIPv6 nodes.
+ *
+ * The latencies of a handover are taken from the detection of the
+ * attachment by the MAG to each following stage: PBU sent, PBA received,
+ * tunnel up and first router advertisement sent to the MN, which ends
+ * the handover. Summaries of the latencies of all the MNs, in
+ * milliseconds, and the signaling counters are kept in calculators of
+ * the stats framework; the handover latencies of each MN are kept too.
+ *
+ * The helper is connected to the trace sources of the nodes, so it must
+ * outlive the simulation and not be copied after Install.
+ */
+class Pmip6StatsHelper
+{
+public:
+  enum Stage_e
+  {
+    STAGE_PBU = 0,      //!< PBU sent
+    STAGE_PBA,          //!< PBA received
+    STAGE_TUNNEL,       //!< tunnel and routes up
+    STAGE_RA,           //!< first RA sent, handover completed
+    N_STAGES
+  };
+
+  enum Counter_e
+  {
+    COUNTER_ATTACH = 0,
+    COUNTER_DETACH,
+    COUNTER_TX_PBU,         //!< PBUs sent by the MAGs, bulk ones included
+    COUNTER_RETRANSMIT_PBU,
+    COUNTER_RX_PBA,         //!< PBAs accepted by the MAGs
+    COUNTER_TX_RA,
+    COUNTER_LMA_RX_PBU,
+    COUNTER_LMA_TX_PBA,
+    N_COUNTERS
+  };
+
+  Pmip6StatsHelper ();
+
+  /**
+   * \brief Connect to the MAG or LMA of the nodes; other nodes are ignored.
+   */
+  void Install (Ptr<Node> node);
+  void Install (NodeContainer c);
+
+  /**
+   * \return the latencies from the attachment to the stage, in milliseconds
+   */
+  Ptr<MinMaxAvgTotalCalculator<double> > GetLatency (Stage_e stage) const;
+
+  Ptr<CounterCalculator<> > GetCounter (Counter_e counter) const;
+
+  /**
+   * \return the completed handover latencies of a MN, in milliseconds
+   */
+  std::vector<double> GetHandoverLatencies (const Identifier &mnId) const;
+
+  /**
+   * \brief Hand all the calculators to a collector, for its outputs.
+   */
+  void AddDataCalculators (Ptr<DataCollector> collector) const;
+
+  void Print (std::ostream &os) const;
+
+private:
+  /* handover of a MN in progress */
+  struct Handover
+  {
+    Time attach;
+    bool done[N_STAGES];
+  };
+
+  typedef sgi::hash_map<Identifier, Handover, IdentifierHash> Handovers;
+  typedef sgi::hash_map<Identifier, std::vector<double>, IdentifierHash> Latencies;
+
+  void Stage (const Identifier &mnId, Stage_e stage);
+
+  void Attach (const Identifier &mnId, Mac48Address mn);
+  void Detach (const Identifier &mnId, Mac48Address mn);
+  void TxPbu (const Identifier &mnId, uint16_t sequence);
+  void RetransmitPbu (const Identifier &mnId, uint16_t sequence);
+  void RxPba (const Identifier &mnId, uint8_t status);
+  void TunnelUp (const Identifier &mnId, uint32_t ifIndex);
+  void TxRa (const Identifier &mnId);
+  void LmaRxPbu (const Identifier &mnId, uint16_t sequence);
+  void LmaTxPba (const Identifier &mnId, uint8_t status);
+
+  Ptr<MinMaxAvgTotalCalculator<double> > m_latencies[N_STAGES];
+  Ptr<CounterCalculator<> > m_counters[N_COUNTERS];
+
+  Handovers m_handovers;
+  Latencies m_mnLatencies;
+};
+
+} // namespace ns3
+
+#endif /* PMIP6_STATS_HELPER_H */
@@ -0,0 +1,12 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+#ifndef __PMIP6_H__
+#define __PMIP6_H__
+
+namespace ns3 {
+
+/* ... */
+
+}
+
+#endif /* __PMIP6_H__ */
+
@@ -0,0 +1,197 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Hyon-Young Choi <commani@gmail.com>
+ */
+
+#ifndef PMIPV6_LMA_H
+#define PMIPV6_LMA_H
+
+#include <vector>
+#include <map>
+
+#include "ns3/sgi-hashmap.h"
+#include "ns3/traced-callback.h"
+
+#include "pmipv6-agent.h"
+#include "binding-cache.h"
+
+namespace ns3
+{
+class Packet;
+class Ipv6MobilityOptionBundle;
+class Pmipv6PrefixPool;
+
+class Pmipv6Lma : public Pmipv6Agent {
+public:
+  static TypeId GetTypeId ();
+  
+  Pmipv6Lma ();
+  
+  virtual ~Pmipv6Lma ();
+  
+  Ptr<Pmipv6PrefixPool> GetPrefixPool () const;
+  void SetPrefixPool (Ptr<Pmipv6PrefixPool> pool);
+  
+  /**
+   * \brief Add a disjoint pool; pools are used in the order they are added.
+   */
+  void AddPrefixPool (Ptr<Pmipv6PrefixPool> pool);
+  uint32_t GetNPrefixPools () const;
+  Ptr<Pmipv6PrefixPool> GetPrefixPool (uint32_t i) const;
+  
+  void DoDelayedRegistration (BindingCache::Entry *bce);
+  
+  /**
+   * \brief Remove a binding whose lifetime or deregistration delay elapsed,
+   * and give its pool-assigned prefixes back.
+   */
+  void DoBindingExpiry (BindingCache::Entry *bce);
+  
+  /**
+   * \brief Localized routing (RFC 6705, default false).
+   *
+   * When enabled, the LMA watches the packets it decapsulates and, on
+   * the first packet between two of its mobile nodes, asks their MAGs
+   * to route the traffic of the pair directly, without the LMA. The
+   * localized routing is terminated when either mobile node moves or
+   * its binding goes away.
+   */
+  void SetLocalizedRouting (bool enable);
+  bool IsLocalizedRouting () const;
+  
+  /**
+   * \return the number of mobile node pairs routed locally
+   */
+  uint32_t GetNLocalizedPairs () const;
+  
+  /**
+   * \brief Redirect the new registrations to a less loaded LMA of the
+   * pool of the profile (RFC 6463) once the LMA holds that many
+   * bindings, 0 to never redirect (default).
+   *
+   * Only the PBUs of MAGs announcing the Redirect-Capability are
+   * redirected: the PBA accepts them without creating a binding and
+   * names the LMA to register with instead.
+   */
+  void SetRedirectThreshold (uint32_t maxBindings);
+  uint32_t GetRedirectThreshold () const;
+  
+  /**
+   * \return the number of bindings in the binding cache
+   */
+  uint32_t GetNBindings () const;
+  
+  /**
+   * \return the number of registrations redirected to another LMA
+   */
+  uint32_t GetNRedirected () const;
+  
+protected:
+  virtual void NotifyNewAggregate ();
+  
+  Ptr<Packet> BuildPba (BindingCache::Entry *bce, uint8_t status);
+  Ptr<Packet> BuildPba (Ipv6MobilityBindingUpdateHeader pbu, Ipv6MobilityOptionBundle bundle, uint8_t status,
+                        Ipv6Address redirect = Ipv6Address::GetAny ());
+  Ptr<Packet> BuildBulkPba (Ipv6MobilityBindingUpdateHeader pbu, Ipv6MobilityOptionBundle bundle, uint8_t status);
+  
+  virtual uint8_t HandlePbu (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface);
+  
+  /**
+   * \brief Refresh or revoke (lifetime zero) all the bindings of the
+   * bulk binding group named in the PBU, in one pass over the bindings
+   * of the MAG.
+   */
+  uint8_t HandleBulkPbu (Ipv6MobilityBindingUpdateHeader pbu, Ipv6MobilityOptionBundle bundle, const Ipv6Address &src);
+  
+  /**
+   * \brief Get the bulk binding group of a MAG, assigned on first use.
+   */
+  uint32_t GetBulkGroup (Ipv6Address mag);
+  
+  bool SetupTunnelAndRouting (BindingCache::Entry *bce);
+  bool ModifyTunnelAndRouting (BindingCache::Entry *bce);
+  void ClearTunnelAndRouting (BindingCache::Entry *bce); 
+  
+  Ipv6Address AssignPrefix ();
+  bool ReservePrefixes (Identifier mnId, std::list<Ipv6Address> hnpList);
+  void ReleasePrefixes (BindingCache::Entry *bce);
+  Ptr<Pmipv6PrefixPool> FindPrefixPool (Ipv6Address prefix) const;
+  
+  virtual uint8_t HandleLra (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface);
+  
+  /**
+   * \brief Look for traffic between two mobile nodes in a decapsulated packet.
+   */
+  void HandleDecapsulated (const Ipv6Address &mag, const Ipv6Header &header);
+  
+  void InitiateLocalizedRouting (BindingCache::Entry *bce1, BindingCache::Entry *bce2);
+  
+  /**
+   * \brief Terminate the localized routing of all the pairs of a mobile node.
+   */
+  void TerminateLocalizedRouting (BindingCache::Entry *bce);
+  
+  void SendLri (Ipv6Address mag, uint16_t sequence, uint16_t lifetime, const std::list<Ipv6Address> &hnps, Ipv6Address peerMag);
+
+private:
+  Ptr<BindingCache> m_bCache;
+  
+  std::vector<Ptr<Pmipv6PrefixPool> > m_prefixPools;
+  
+  // one bulk binding group per MAG, by Proxy-CoA
+  typedef sgi::hash_map<Ipv6Address, uint32_t, Ipv6AddressHash> BulkGroups;
+  
+  BulkGroups m_bulkGroups;
+  uint32_t m_lastGroupId;
+  
+  // a locally routed pair, keyed by the first prefixes of the mobile nodes in order
+  typedef std::pair<Ipv6Address, Ipv6Address> PairKey;
+  
+  struct LocalizedPair
+  {
+    Identifier mnIds[2];
+    Ipv6Address mags[2];
+    std::list<Ipv6Address> hnps;    //!< prefixes of both mobile nodes
+    uint16_t sequence;
+  };
+  
+  typedef std::map<PairKey, LocalizedPair> LocalizedPairs;
+  typedef sgi::hash_map<Identifier, std::list<PairKey>, IdentifierHash> LocalizedIndex;
+  
+  bool m_localizedRouting;
+  LocalizedPairs m_localizedPairs;
+  LocalizedIndex m_localizedIndex;  //!< pairs of each mobile node
+  uint16_t m_lriSequence;
+  
+  uint32_t m_redirectThreshold;
+  uint32_t m_nRedirected;
+  
+  /* registration stages, by MN identifier; empty for bulk messages */
+  TracedCallback<const Identifier &, uint16_t> m_rxPbuTrace;
+  TracedCallback<const Identifier &, uint8_t> m_txPbaTrace;
+  TracedCallback<const Identifier &, uint32_t> m_tunnelUpTrace;
+};
+
+} /* namespace ns3 */
+
+#endif /* PMIPV6_LMA_H */
+
@@ -0,0 +1,136 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Hyon-Young Choi <commani@gmail.com>
+ */
+
+#ifndef PMIPV6_PREFIX_POOL_H
+#define PMIPV6_PREFIX_POOL_H
+
+#include <stdint.h>
+
+#include <deque>
+#include <utility>
+
+#include "ns3/simple-ref-count.h"
+#include "ns3/ipv6-address.h"
+#include "ns3/nstime.h"
+#include "ns3/sgi-hashmap.h"
+
+namespace ns3
+{
+
+/**
+ * \brief Allocator of /64 home network prefixes out of a shorter prefix.
+ *
+ * Prefixes are numbered by their index below the pool prefix. Indexes
+ * never handed out are free implicitly (everything above a high-water
+ * mark), so an untouched pool costs nothing whatever its size. Assigned
+ * prefixes are tracked in a sparse bitmap of 64-bit words, and released
+ * ones wait in a FIFO quarantine before going to a free-list for reuse.
+ * During the quarantine the previous owner can take its prefix back
+ * with Reserve.
+ */
+class Pmipv6PrefixPool : public SimpleRefCount<Pmipv6PrefixPool>
+{
+public:
+  Pmipv6PrefixPool(Ipv6Address prefixBegin, uint8_t prefixLen);
+  
+  /**
+   * \brief Assign a free /64, reusing released prefixes first.
+   * \return the prefix, or the unspecified address if the pool is exhausted
+   */
+  Ipv6Address Assign();
+  
+  /**
+   * \brief Mark a specific prefix as assigned.
+   * \param prefix prefix, e.g. the one an MN used before
+   * \return false if the prefix is not in this pool or already assigned
+   */
+  bool Reserve(Ipv6Address prefix);
+  
+  /**
+   * \brief Give a prefix back; it is reused after the quarantine period.
+   * \param prefix assigned prefix
+   * \return false if the prefix is not in this pool or not assigned
+   */
+  bool Release(Ipv6Address prefix);
+  
+  /**
+   * \return true if the prefix falls within this pool
+   */
+  bool Contains(Ipv6Address prefix) const;
+  
+  /**
+   * \return true if the prefix is currently assigned
+   */
+  bool IsAssigned(Ipv6Address prefix) const;
+  
+  /**
+   * \param quarantine how long a released prefix is kept before reuse
+   */
+  void SetQuarantine(Time quarantine);
+  Time GetQuarantine() const;
+  
+  uint64_t GetSize() const;
+  uint64_t GetNAssigned() const;
+  uint64_t GetNQuarantined() const;
+
+private:
+  struct IndexHash
+  {
+    size_t operator() (uint64_t x) const;
+  };
+  
+  typedef sgi::hash_map<uint64_t, uint64_t, IndexHash> Bitmap;
+  typedef sgi::hash_map<uint64_t, Time, IndexHash> Quarantine;
+  
+  bool GetIndex(Ipv6Address prefix, uint64_t &index) const;
+  Ipv6Address GetPrefix(uint64_t index) const;
+  
+  bool TestBit(uint64_t index) const;
+  void SetBit(uint64_t index);
+  void ClearBit(uint64_t index);
+  
+  /**
+   * \brief Move prefixes whose quarantine elapsed to the free-list.
+   */
+  void ExpireQuarantine();
+  
+  Ipv6Address m_prefixBegin;
+  uint8_t m_prefixBeginLen;
+  
+  uint64_t m_base;                //!< upper 64 bits of the pool prefix
+  uint64_t m_size;                //!< number of /64s, index 0 excluded
+  uint64_t m_lastPrefixIndex;     //!< high-water mark of assigned indexes
+  uint64_t m_nAssigned;
+  
+  Time m_quarantineTime;
+  
+  Bitmap m_assigned;              //!< assigned indexes, by word of 64
+  Quarantine m_quarantine;        //!< release expiry of quarantined indexes
+  std::deque<std::pair<Time, uint64_t> > m_quarantineQueue;
+  std::deque<uint64_t> m_freeList;
+};
+
+} /* namespace ns3 */
+
+#endif /* PMIPV6_PREFIX_POOL_H */
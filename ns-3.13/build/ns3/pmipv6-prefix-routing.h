@@ -0,0 +1,233 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PMIPV6_PREFIX_ROUTING_H
+#define PMIPV6_PREFIX_ROUTING_H
+
+#include <stdint.h>
+
+#include "ns3/ptr.h"
+#include "ns3/ipv6-address.h"
+#include "ns3/ipv6.h"
+#include "ns3/ipv6-header.h"
+#include "ns3/ipv6-route.h"
+#include "ns3/ipv6-routing-protocol.h"
+#include "ns3/sgi-hashmap.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup routing
+ * \class Pmipv6PrefixRouting
+ * \brief Home network prefix forwarding table of a PMIPv6 agent.
+ *
+ * Each home network prefix is a /64 and maps to exactly one interface
+ * (the tunnel towards the MAG on the LMA, the access link on the MAG),
+ * so routes are kept in a hash table keyed by the upper 64 bits of the
+ * destination and resolved with a single exact-match lookup, whatever
+ * the number of bindings.
+ *
+ * The table is meant to be inserted in Ipv6ListRouting ahead of
+ * Ipv6StaticRouting; destinations that are not a registered home network
+ * prefix fall through to the next protocol. Local delivery and the
+ * forwarding check of incoming packets are left to Ipv6ListRouting.
+ *
+ * A prefix can also be held instead of routed, while its mobile node
+ * hands over: the packets to a held prefix are handed to the hold
+ * callback rather than forwarded, until a route replaces the hold.
+ *
+ * \see Ipv6RoutingProtocol
+ * \see Ipv6ListRouting
+ */
+class Pmipv6PrefixRouting : public Ipv6RoutingProtocol
+{
+public:
+  /**
+   * \brief The interface Id associated with this class.
+   * \return type identifier
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief Constructor.
+   */
+  Pmipv6PrefixRouting ();
+
+  /**
+   * \brief Destructor.
+   */
+  virtual ~Pmipv6PrefixRouting ();
+
+  /**
+   * \brief Add or replace the route of a home network prefix.
+   * \param hnp home network prefix (only the upper 64 bits are used)
+   * \param interface interface index
+   * \param nextHop next hop address, if any
+   */
+  void AddPrefixRoute (Ipv6Address hnp, uint32_t interface, Ipv6Address nextHop = Ipv6Address::GetZero ());
+
+  /**
+   * \brief Remove the route of a home network prefix.
+   * \param hnp home network prefix
+   * \param interface interface the route must go through, so that a stale
+   * removal does not delete a route already re-pointed by a handover
+   * \return true if a route was removed
+   */
+  bool RemovePrefixRoute (Ipv6Address hnp, uint32_t interface);
+
+  /**
+   * \brief Hand the packets to a home network prefix to the hold
+   * callback instead of routing them, replacing its route if any.
+   * AddPrefixRoute replaces the hold in turn.
+   * \param hnp home network prefix
+   */
+  void AddHoldRoute (Ipv6Address hnp);
+
+  /**
+   * \brief Stop holding a home network prefix.
+   * \return true if the prefix was held
+   */
+  bool RemoveHoldRoute (Ipv6Address hnp);
+
+  /**
+   * \brief Callback receiving the held packets, without their IPv6
+   * header and with a SocketIpTtlTag set to the hop limit left.
+   */
+  typedef Callback<void, Ptr<Packet>, const Ipv6Header &> HoldCallback;
+
+  void SetHoldCallback (HoldCallback cb);
+
+  /**
+   * \param dst destination address
+   * \return true if the home network prefix of dst is held
+   */
+  bool IsHeld (Ipv6Address dst) const;
+
+  /**
+   * \brief Hand a packet to the hold callback if its destination is held.
+   * \param p packet without its IPv6 header, with a SocketIpTtlTag
+   * \param header its IPv6 header
+   * \return false if the destination is not held
+   */
+  bool Hold (Ptr<Packet> p, const Ipv6Header &header);
+
+  /**
+   * \brief Look up the interface of a home network prefix.
+   * \param hnp home network prefix or any address within it
+   * \return the interface index or -1 if the prefix is not routed here
+   * (or held)
+   */
+  int32_t LookupPrefix (Ipv6Address hnp) const;
+
+  /**
+   * \brief Get the number or entries in the routing table.
+   * \return number of entries, held prefixes excluded
+   */
+  uint32_t GetNRoutes () const;
+
+  virtual Ptr<Ipv6Route> RouteOutput (Ptr<Packet> p, const Ipv6Header &header, Ptr<NetDevice> oif, Socket::SocketErrno &sockerr);
+
+  virtual bool RouteInput  (Ptr<const Packet> p, const Ipv6Header &header, Ptr<const NetDevice> idev,
+                            UnicastForwardCallback ucb, MulticastForwardCallback mcb,
+                            LocalDeliverCallback lcb, ErrorCallback ecb);
+
+  virtual void NotifyInterfaceUp (uint32_t interface);
+  virtual void NotifyInterfaceDown (uint32_t interface);
+  virtual void NotifyAddAddress (uint32_t interface, Ipv6InterfaceAddress address);
+  virtual void NotifyRemoveAddress (uint32_t interface, Ipv6InterfaceAddress address);
+  virtual void NotifyAddRoute (Ipv6Address dst, Ipv6Prefix mask, Ipv6Address nextHop, uint32_t interface, Ipv6Address prefixToUse = Ipv6Address::GetZero ());
+  virtual void NotifyRemoveRoute (Ipv6Address dst, Ipv6Prefix mask, Ipv6Address nextHop, uint32_t interface, Ipv6Address prefixToUse = Ipv6Address::GetZero ());
+  virtual void SetIpv6 (Ptr<Ipv6> ipv6);
+
+protected:
+  /**
+   * \brief Dispose this object.
+   */
+  void DoDispose ();
+
+private:
+  struct PrefixKeyHash
+  {
+    size_t operator () (uint64_t x) const;
+  };
+
+  /* interface of the held prefixes */
+  static const uint32_t HOLD_INTERFACE = 0xffffffff;
+
+  struct PrefixRoute
+  {
+    uint32_t interface;
+    Ipv6Address network;
+    Ipv6Address nextHop;
+    Ptr<Ipv6Route> route;     //!< route handed out, built on first use
+    uint32_t generation;      //!< m_generation when route was built
+  };
+
+  typedef sgi::hash_map<uint64_t, PrefixRoute, PrefixKeyHash> PrefixRoutes;
+  typedef sgi::hash_map<uint64_t, PrefixRoute, PrefixKeyHash>::iterator PrefixRoutesI;
+  typedef sgi::hash_map<uint64_t, PrefixRoute, PrefixKeyHash>::const_iterator PrefixRoutesCI;
+
+  /**
+   * \brief Get the /64 key of an address.
+   */
+  static uint64_t GetKey (Ipv6Address addr);
+
+  /**
+   * \brief Lookup in the forwarding table for destination.
+   * \param dst destination address
+   * \param interface output interface if any (put 0 otherwise)
+   * \return Ipv6Route to route the packet to reach dest address
+   */
+  Ptr<Ipv6Route> LookupPrefixRoute (Ipv6Address dst, Ptr<NetDevice> interface);
+
+  /**
+   * \brief Choose the source address of locally originated packets.
+   */
+  Ipv6Address SourceAddressSelection (uint32_t interface, Ipv6Address dest);
+
+  /**
+   * \brief the forwarding table for home network prefixes.
+   */
+  PrefixRoutes m_prefixRoutes;
+
+  /**
+   * \brief Number of held prefixes in m_prefixRoutes.
+   */
+  uint32_t m_nHeld;
+
+  HoldCallback m_holdCallback;
+
+  /**
+   * \brief Bumped when interface addresses change, to rebuild routes.
+   */
+  uint32_t m_generation;
+
+  /**
+   * \brief Ipv6 reference.
+   */
+  Ptr<Ipv6> m_ipv6;
+};
+
+} /* namespace ns3 */
+
+#endif /* PMIPV6_PREFIX_ROUTING_H */
@@ -0,0 +1,215 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PMIPV6_PROCESSOR_H
+#define PMIPV6_PROCESSOR_H
+
+#include <stdint.h>
+#include <deque>
+#include <map>
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/packet.h"
+#include "ns3/callback.h"
+#include "ns3/nstime.h"
+#include "ns3/ipv6-address.h"
+#include "ns3/ipv6-interface.h"
+#include "ns3/traced-callback.h"
+#include "ns3/traced-value.h"
+
+namespace ns3
+{
+
+/**
+ * \class Pmipv6Processor
+ * \brief Signaling processing capacity of a PMIPv6 agent.
+ *
+ * Without a processor, the mobility messages are handled by the agent
+ * as soon as they are received. With one (see Pmipv6Agent::SetProcessor),
+ * each message takes a service time, set per mobility header type, on
+ * one of the servers of the processor, and waits in a bounded queue
+ * while all of them are busy.
+ *
+ * When the queue is full, the incoming message (drop tail) or the
+ * oldest queued one (drop head) is dropped. With the deregistrations
+ * first policy, the PBUs with a zero lifetime are queued apart and
+ * served before the other messages, and evict them from a full queue.
+ * Drop head never evicts a message of a higher class than the incoming
+ * one, which is dropped instead.
+ */
+class Pmipv6Processor : public Object
+{
+public:
+  static TypeId GetTypeId ();
+
+  enum DropPolicy_e
+  {
+    DROP_TAIL,
+    DROP_HEAD
+  };
+
+  enum PriorityPolicy_e
+  {
+    FIFO,
+    DEREGISTRATIONS_FIRST
+  };
+
+  /**
+   * \brief Handles the message once served, as Pmipv6Agent::Receive.
+   */
+  typedef Callback<uint8_t, Ptr<Packet>, const Ipv6Address &, const Ipv6Address &, Ptr<Ipv6Interface> > ProcessCallback;
+
+  /**
+   * \brief Queue length and sojourn time (waiting and service) statistics.
+   */
+  struct Statistics
+  {
+    Statistics ();
+
+    uint64_t received;
+    uint64_t processed;
+    uint64_t dropped;
+    uint32_t maxQueueLength;
+    double avgQueueLength;      //!< averaged over time
+    Time avgSojournTime;
+    Time maxSojournTime;
+  };
+
+  Pmipv6Processor ();
+  virtual ~Pmipv6Processor ();
+
+  void SetProcessCallback (ProcessCallback cb);
+
+  /**
+   * \brief Number of messages served at the same time (1 by default).
+   */
+  void SetNServers (uint32_t nServers);
+  uint32_t GetNServers () const;
+
+  /**
+   * \brief Maximum number of messages waiting for a server (1000 by default).
+   */
+  void SetMaxQueueLength (uint32_t maxQueueLength);
+  uint32_t GetMaxQueueLength () const;
+
+  /**
+   * \brief Service time of the types with no service time of their own
+   * (zero by default).
+   */
+  void SetDefaultServiceTime (Time serviceTime);
+
+  /**
+   * \brief Service time of a mobility header type (Ipv6MobilityHeader::MhType_e).
+   */
+  void SetServiceTime (uint8_t mhType, Time serviceTime);
+  Time GetServiceTime (uint8_t mhType) const;
+
+  void SetDropPolicy (enum DropPolicy_e policy);
+  enum DropPolicy_e GetDropPolicy () const;
+
+  void SetPriorityPolicy (enum PriorityPolicy_e policy);
+  enum PriorityPolicy_e GetPriorityPolicy () const;
+
+  /**
+   * \brief Serve a mobility message, or queue it.
+   * \return false if the message was dropped
+   */
+  bool Receive (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface);
+
+  /**
+   * \return the number of messages waiting for a server
+   */
+  uint32_t GetQueueLength () const;
+
+  /**
+   * \return the number of busy servers
+   */
+  uint32_t GetNBusy () const;
+
+  /**
+   * \return the statistics since creation or the last reset
+   */
+  Statistics GetStatistics () const;
+  void ResetStatistics ();
+
+protected:
+  virtual void DoDispose ();
+
+private:
+  enum
+  {
+    CLASS_HIGH = 0,
+    CLASS_NORMAL,
+    N_CLASSES
+  };
+
+  struct Message
+  {
+    Ptr<Packet> packet;
+    Ipv6Address src;
+    Ipv6Address dst;
+    Ptr<Ipv6Interface> interface;
+    uint8_t mhType;
+    Time arrival;
+  };
+
+  typedef std::deque<Message> Queue;
+
+  uint32_t Classify (const Message &message) const;
+  void Serve (const Message &message);
+  void Complete (Message message);
+  void Drop (const Message &message);
+  void UpdateQueueLength (int32_t delta);
+
+  ProcessCallback m_process;
+
+  uint32_t m_nServers;
+  uint32_t m_maxQueueLength;
+  Time m_defaultServiceTime;
+  std::map<uint8_t, Time> m_serviceTimes;
+  enum DropPolicy_e m_dropPolicy;
+  enum PriorityPolicy_e m_priorityPolicy;
+
+  Queue m_queues[N_CLASSES];
+  uint32_t m_nBusy;
+
+  TracedValue<uint32_t> m_queueLength;
+
+  /* statistics */
+  uint64_t m_received;
+  uint64_t m_processed;
+  uint64_t m_dropped;
+  uint32_t m_maxQueueLengthSeen;
+  double m_queueArea;           //!< integral of the queue length, in message.seconds
+  Time m_lastChange;
+  Time m_statsStart;
+  Time m_sojournTotal;
+  Time m_sojournMax;
+
+  TracedCallback<Ptr<const Packet> > m_droppedTrace;
+  TracedCallback<Ptr<const Packet>, Time> m_processedTrace;
+};
+
+} /* namespace ns3 */
+
+#endif /* PMIPV6_PROCESSOR_H */
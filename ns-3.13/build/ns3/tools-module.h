@@ -0,0 +1,14 @@
+
+#ifdef NS3_MODULE_COMPILATION
+# error "Do not include ns3 module aggregator headers from other modules; these are meant only for end user scripts."
+#endif
+
+#ifndef NS3_MODULE_TOOLS
+    
+
+// Module headers:
+#include "average.h"
+#include "delay-jitter-estimation.h"
+#include "event-garbage-collector.h"
+#include "gnuplot.h"
+#endif
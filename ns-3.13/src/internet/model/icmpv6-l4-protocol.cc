@@ -20,6 +20,8 @@
  *         Mehdi Benamor <benamor.mehdi@ensi.rnu.tn>
  */
 
+#include <string.h>
+
 #include "ns3/log.h"
 #include "ns3/assert.h"
 #include "ns3/packet.h"
@@ -215,6 +217,7 @@ enum Ipv6L4Protocol::RxStatus_e Icmpv6L4Protocol::Receive (Ptr<Packet> packet, I
     case Icmpv6Header::ICMPV6_ERROR_DESTINATION_UNREACHABLE:
       break;
     case Icmpv6Header::ICMPV6_ERROR_PACKET_TOO_BIG:
+      HandlePacketTooBig (p, src, dst, interface);
       break;
     case Icmpv6Header::ICMPV6_ERROR_TIME_EXCEEDED:
       break;
@@ -670,6 +673,68 @@ void Icmpv6L4Protocol::HandleNA (Ptr<Packet> packet, Ipv6Address const &src, Ipv
     }
 }
 
+void Icmpv6L4Protocol::HandlePacketTooBig (Ptr<Packet> packet, Ipv6Address const &src, Ipv6Address const &dst, Ptr<Ipv6Interface> interface)
+{
+  NS_LOG_FUNCTION (this << packet << src << dst << interface);
+  Icmpv6TooBig tooBig;
+  Ipv6Header ipHeader;
+  uint8_t payload[8];
+
+  packet->RemoveHeader (tooBig);
+  Ptr<Packet> p = tooBig.GetPacket ();
+
+  if (p->GetSize () < ipHeader.GetSerializedSize ())
+    {
+      NS_LOG_LOGIC ("Packet Too Big without the invoking header, ignored");
+      return;
+    }
+
+  p->RemoveHeader (ipHeader);
+
+  /* the packets this node sends to the destination are fragmented to the MTU */
+  Ptr<Ipv6L3Protocol> ipv6 = m_node->GetObject<Ipv6L3Protocol> ();
+  ipv6->SetPmtu (ipHeader.GetDestinationAddress (), tooBig.GetMtu ());
+
+  /* the protocol to notify follows the extension headers, e.g. the
+   * fragment header of a fragmented packet */
+  uint8_t nextHeader = ipHeader.GetNextHeader ();
+  while (nextHeader == Ipv6Header::IPV6_EXT_HOP_BY_HOP || nextHeader == Ipv6Header::IPV6_EXT_ROUTING
+         || nextHeader == Ipv6Header::IPV6_EXT_FRAGMENTATION || nextHeader == Ipv6Header::IPV6_EXT_DESTINATION)
+    {
+      uint8_t buf[2];
+
+      if (p->CopyData (buf, sizeof (buf)) < sizeof (buf))
+        {
+          NS_LOG_LOGIC ("Packet Too Big with truncated extension headers, ignored");
+          return;
+        }
+
+      /* the fragment header has a fixed length of 8 bytes */
+      uint32_t length = nextHeader == Ipv6Header::IPV6_EXT_FRAGMENTATION ? 8 : (buf[1] + 1) * 8;
+      nextHeader = buf[0];
+      p->RemoveAtStart (length);
+    }
+  ipHeader.SetNextHeader (nextHeader);
+
+  memset (payload, 0, sizeof (payload));
+  p->CopyData (payload, sizeof (payload));
+
+  Forward (src, tooBig, tooBig.GetMtu (), ipHeader, payload);
+}
+
+void Icmpv6L4Protocol::Forward (Ipv6Address source, Icmpv6Header icmp, uint32_t info, Ipv6Header ipHeader, const uint8_t payload[8])
+{
+  NS_LOG_FUNCTION (this << source << info);
+  Ptr<Ipv6L3Protocol> ipv6 = m_node->GetObject<Ipv6L3Protocol> ();
+  Ptr<Ipv6L4Protocol> l4 = ipv6->GetProtocol (ipHeader.GetNextHeader ());
+
+  if (l4 != 0)
+    {
+      l4->ReceiveIcmp (source, ipHeader.GetHopLimit (), icmp.GetType (), icmp.GetCode (),
+                       info, ipHeader.GetSourceAddress (), ipHeader.GetDestinationAddress (), payload);
+    }
+}
+
 void Icmpv6L4Protocol::HandleRedirection (Ptr<Packet> packet, Ipv6Address const &src, Ipv6Address const &dst, Ptr<Ipv6Interface> interface)
 {
   NS_LOG_FUNCTION (this << packet << src << dst << interface);
@@ -463,6 +463,29 @@ private:
    */
   void HandleRedirection (Ptr<Packet> p, Ipv6Address const &src, Ipv6Address const &dst, Ptr<Ipv6Interface> interface);
 
+  /**
+   * \brief Receive Packet Too Big method.
+   *
+   * The MTU becomes the path MTU to the destination of the packet which
+   * was too big, and is handed to its layer 4 protocol, found after the
+   * extension headers, through its ReceiveIcmp method.
+   * \param p the packet
+   * \param src source address
+   * \param dst destination address
+   * \param interface the interface from which the packet is coming
+   */
+  void HandlePacketTooBig (Ptr<Packet> p, Ipv6Address const &src, Ipv6Address const &dst, Ptr<Ipv6Interface> interface);
+
+  /**
+   * \brief Notify an ICMPv6 error to the layer 4 protocol of the packet which caused it.
+   * \param source the source address of the ICMPv6 message
+   * \param icmp the ICMPv6 header
+   * \param info extra information, the MTU for Packet Too Big
+   * \param ipHeader the IPv6 header of the packet which caused the error
+   * \param payload the first 8 bytes following that header
+   */
+  void Forward (Ipv6Address source, Icmpv6Header icmp, uint32_t info, Ipv6Header ipHeader, const uint8_t payload[8]);
+
   /**
    * \brief Link layer address option processing.
    * \param lla LLA option
@@ -290,6 +290,12 @@ Ipv4Interface::AddAddress (Ipv4InterfaceAddress addr)
 {
   NS_LOG_FUNCTION_NOARGS ();
   m_ifaddrs.push_back (addr);
+
+  Ptr<Ipv4L3Protocol> ipv4 = m_node ? m_node->GetObject<Ipv4L3Protocol> () : Ptr<Ipv4L3Protocol> ();
+  if (ipv4)
+    {
+      ipv4->NotifyAddressAdded (this, addr);
+    }
   return true;
 }
 
@@ -330,6 +336,12 @@ Ipv4Interface::RemoveAddress (uint32_t index)
         {
           Ipv4InterfaceAddress addr = *i;
           m_ifaddrs.erase (i);
+
+          Ptr<Ipv4L3Protocol> ipv4 = m_node ? m_node->GetObject<Ipv4L3Protocol> () : Ptr<Ipv4L3Protocol> ();
+          if (ipv4)
+            {
+              ipv4->NotifyAddressRemoved (this, addr);
+            }
           return addr;
         }
       ++tmp;
@@ -201,6 +201,9 @@ Ipv4L3Protocol::DoDispose (void)
       *i = 0;
     }
   m_interfaces.clear ();
+  m_deviceIndex.clear ();
+  m_addressIndex.clear ();
+  m_broadcastIndex.clear ();
   m_sockets.clear ();
   m_node = 0;
   m_routingProtocol = 0;
@@ -289,9 +292,97 @@ Ipv4L3Protocol::AddIpv4Interface (Ptr<Ipv4Interface>interface)
   NS_LOG_FUNCTION (this << interface);
   uint32_t index = m_interfaces.size ();
   m_interfaces.push_back (interface);
+
+  // the addresses added before the interface was registered (loopback);
+  // the following ones are notified by the interface itself
+  if (interface->GetDevice () && m_deviceIndex.find (PeekPointer (interface->GetDevice ())) == m_deviceIndex.end ())
+    {
+      m_deviceIndex[PeekPointer (interface->GetDevice ())] = index;
+    }
+  for (uint32_t j = 0; j < interface->GetNAddresses (); j++)
+    {
+      NotifyAddressAdded (PeekPointer (interface), interface->GetAddress (j));
+    }
   return index;
 }
 
+int32_t
+Ipv4L3Protocol::GetInterfaceIndex (const Ipv4Interface *interface) const
+{
+  NS_LOG_FUNCTION (this << interface);
+  int32_t index = GetInterfaceForDevice (interface->GetDevice ());
+  if (index >= 0 && PeekPointer (m_interfaces[index]) == interface)
+    {
+      return index;
+    }
+
+  // several interfaces on the same device, or not registered
+  for (uint32_t i = 0; i < m_interfaces.size (); i++)
+    {
+      if (PeekPointer (m_interfaces[i]) == interface)
+        {
+          return i;
+        }
+    }
+  return -1;
+}
+
+void
+Ipv4L3Protocol::NotifyAddressAdded (const Ipv4Interface *interface, Ipv4InterfaceAddress address)
+{
+  NS_LOG_FUNCTION (this << interface << address);
+  int32_t index = GetInterfaceIndex (interface);
+  if (index < 0)
+    {
+      // will be indexed by AddIpv4Interface
+      return;
+    }
+
+  AddressIndex::iterator it = m_addressIndex.find (address.GetLocal ());
+  if (it == m_addressIndex.end () || it->second > uint32_t (index))
+    {
+      m_addressIndex[address.GetLocal ()] = index;
+    }
+  m_broadcastIndex[address.GetBroadcast ()]++;
+}
+
+void
+Ipv4L3Protocol::NotifyAddressRemoved (const Ipv4Interface *interface, Ipv4InterfaceAddress address)
+{
+  NS_LOG_FUNCTION (this << interface << address);
+  int32_t index = GetInterfaceIndex (interface);
+  if (index < 0)
+    {
+      return;
+    }
+
+  BroadcastIndex::iterator bit = m_broadcastIndex.find (address.GetBroadcast ());
+  if (bit != m_broadcastIndex.end () && --bit->second == 0)
+    {
+      m_broadcastIndex.erase (bit);
+    }
+
+  AddressIndex::iterator it = m_addressIndex.find (address.GetLocal ());
+  if (it == m_addressIndex.end () || it->second != uint32_t (index))
+    {
+      return;
+    }
+
+  // the address may still be configured on this or another interface
+  m_addressIndex.erase (it);
+  for (uint32_t i = index; i < m_interfaces.size (); i++)
+    {
+      for (uint32_t j = 0; j < m_interfaces[i]->GetNAddresses (); j++)
+        {
+          if (m_interfaces[i]->GetAddress (j).GetLocal () == address.GetLocal ())
+            {
+              m_addressIndex[address.GetLocal ()] = i;
+              return;
+            }
+        }
+    }
+}
+
 Ptr<Ipv4Interface>
 Ipv4L3Protocol::GetInterface (uint32_t index) const
 {
@@ -312,18 +403,10 @@ int32_t
 Ipv4L3Protocol::GetInterfaceForAddress (
   Ipv4Address address) const
 {
-  int32_t interface = 0;
-  for (Ipv4InterfaceList::const_iterator i = m_interfaces.begin (); 
-       i != m_interfaces.end (); 
-       i++, interface++)
+  AddressIndex::const_iterator it = m_addressIndex.find (address);
+  if (it != m_addressIndex.end ())
     {
-      for (uint32_t j = 0; j < (*i)->GetNAddresses (); j++)
-        {
-          if ((*i)->GetAddress (j).GetLocal () == address)
-            {
-              return interface;
-            }
-        }
+      return it->second;
     }
 
   return -1;
@@ -355,15 +438,10 @@ int32_t
 Ipv4L3Protocol::GetInterfaceForDevice (
   Ptr<const NetDevice> device) const
 {
-  int32_t interface = 0;
-  for (Ipv4InterfaceList::const_iterator i = m_interfaces.begin (); 
-       i != m_interfaces.end (); 
-       i++, interface++)
+  DeviceIndex::const_iterator it = m_deviceIndex.find (PeekPointer (device));
+  if (it != m_deviceIndex.end ())
     {
-      if ((*i)->GetDevice () == device)
-        {
-          return interface;
-        }
+      return it->second;
     }
 
   return -1;
@@ -408,24 +486,16 @@ Ipv4L3Protocol::IsDestinationAddress (Ipv4Address address, uint32_t iif) const
 
   if (GetWeakEsModel ())  // Check other interfaces
     { 
-      for (uint32_t j = 0; j < GetNInterfaces (); j++)
+      if (GetInterfaceForAddress (address) >= 0)
         {
-          if (j == uint32_t (iif)) continue;
-          for (uint32_t i = 0; i < GetNAddresses (j); i++)
-            {
-              Ipv4InterfaceAddress iaddr = GetAddress (j, i);
-              if (address == iaddr.GetLocal ())
-                {
-                  NS_LOG_LOGIC ("For me (destination " << address << " match) on another interface");
-                  return true;
-                }
-              //  This is a small corner case:  match another interface's broadcast address
-              if (address == iaddr.GetBroadcast ())
-                {
-                  NS_LOG_LOGIC ("For me (interface broadcast address on another interface)");
-                  return true;
-                }
-            }
+          NS_LOG_LOGIC ("For me (destination " << address << " match) on another interface");
+          return true;
+        }
+      //  This is a small corner case:  match another interface's broadcast address
+      if (m_broadcastIndex.find (address) != m_broadcastIndex.end ())
+        {
+          NS_LOG_LOGIC ("For me (interface broadcast address on another interface)");
+          return true;
         }
     }
   return false;
@@ -440,30 +510,25 @@ Ipv4L3Protocol::Receive ( Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t p
   NS_LOG_LOGIC ("Packet from " << from << " received on node " << 
                 m_node->GetId ());
 
-  uint32_t interface = 0;
+  int32_t index = GetInterfaceForDevice (device);
+  uint32_t interface = index >= 0 ? index : m_interfaces.size ();
   Ptr<Packet> packet = p->Copy ();
 
   Ptr<Ipv4Interface> ipv4Interface;
-  for (Ipv4InterfaceList::const_iterator i = m_interfaces.begin (); 
-       i != m_interfaces.end (); 
-       i++, interface++)
+  if (index >= 0)
     {
-      ipv4Interface = *i;
-      if (ipv4Interface->GetDevice () == device)
+      ipv4Interface = m_interfaces[index];
+      if (ipv4Interface->IsUp ())
         {
-          if (ipv4Interface->IsUp ())
-            {
-              m_rxTrace (packet, m_node->GetObject<Ipv4> (), interface);
-              break;
-            }
-          else
-            {
-              NS_LOG_LOGIC ("Dropping received packet -- interface is down");
-              Ipv4Header ipHeader;
-              packet->RemoveHeader (ipHeader);
-              m_dropTrace (ipHeader, packet, DROP_INTERFACE_DOWN, m_node->GetObject<Ipv4> (), interface);
-              return;
-            }
+          m_rxTrace (packet, m_node->GetObject<Ipv4> (), interface);
+        }
+      else
+        {
+          NS_LOG_LOGIC ("Dropping received packet -- interface is down");
+          Ipv4Header ipHeader;
+          packet->RemoveHeader (ipHeader);
+          m_dropTrace (ipHeader, packet, DROP_INTERFACE_DOWN, m_node->GetObject<Ipv4> (), interface);
+          return;
         }
     }
 
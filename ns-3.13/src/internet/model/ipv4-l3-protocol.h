@@ -34,6 +34,7 @@
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/nstime.h"
 #include "ns3/simulator.h"
+#include "ns3/sgi-hashmap.h"
 
 namespace ns3 {
 
@@ -220,6 +221,8 @@ protected:
   virtual void NotifyNewAggregate ();
 private:
   friend class Ipv4L3ProtocolTestCase;
+  // keeps the address indexes up to date
+  friend class Ipv4Interface;
   Ipv4L3Protocol(const Ipv4L3Protocol &);
   Ipv4L3Protocol &operator = (const Ipv4L3Protocol &);
 
@@ -258,6 +261,27 @@ private:
   uint32_t AddIpv4Interface (Ptr<Ipv4Interface> interface);
   void SetupLoopback (void);
 
+  /**
+   * \brief Called by an interface when one of its addresses is added.
+   * \param interface the interface
+   * \param address the new address
+   */
+  void NotifyAddressAdded (const Ipv4Interface *interface, Ipv4InterfaceAddress address);
+
+  /**
+   * \brief Called by an interface when one of its addresses is removed.
+   * \param interface the interface
+   * \param address the removed address
+   */
+  void NotifyAddressRemoved (const Ipv4Interface *interface, Ipv4InterfaceAddress address);
+
+  /**
+   * \brief Get the index of a registered interface.
+   * \param interface the interface
+   * \return its index, or -1 if it is not (yet) part of the stack
+   */
+  int32_t GetInterfaceIndex (const Ipv4Interface *interface) const;
+
   /**
    * \brief Get ICMPv4 protocol.
    * \return Icmpv4L4Protocol pointer
@@ -291,6 +315,22 @@ private:
   void HandleFragmentsTimeout ( std::pair<uint64_t, uint32_t> key, Ipv4Header & ipHeader, uint32_t iif);
 
   typedef std::vector<Ptr<Ipv4Interface> > Ipv4InterfaceList;
+
+  class DeviceHash
+  {
+public:
+    size_t operator () (const NetDevice *device) const
+    {
+      return reinterpret_cast<size_t> (device) >> 3;
+    }
+  };
+
+  // interface index of each device
+  typedef sgi::hash_map<const NetDevice *, uint32_t, DeviceHash> DeviceIndex;
+  // lowest interface index of each local address
+  typedef sgi::hash_map<Ipv4Address, uint32_t, Ipv4AddressHash> AddressIndex;
+  // number of addresses with a given broadcast address
+  typedef sgi::hash_map<Ipv4Address, uint32_t, Ipv4AddressHash> BroadcastIndex;
   typedef std::list<Ptr<Ipv4RawSocketImpl> > SocketList;
   typedef std::list<Ptr<Ipv4L4Protocol> > L4List_t;
 
@@ -298,6 +338,9 @@ private:
   bool m_weakEsModel;
   L4List_t m_protocols;
   Ipv4InterfaceList m_interfaces;
+  DeviceIndex m_deviceIndex;
+  AddressIndex m_addressIndex;
+  BroadcastIndex m_broadcastIndex;
   uint8_t m_defaultTtl;
   uint16_t m_identification;
   Ptr<Node> m_node;
@@ -549,6 +549,13 @@ void Ipv6ExtensionFragment::HandleFragmentsTimeout (std::pair<Ipv6Address, uint3
 {
   Ptr<Packet> packet = fragments->GetPartialPacket ();
 
+  // the first fragment never arrived, there is nothing to report.
+  if (!packet)
+    {
+      m_fragments.erase (fragmentsId);
+      return;
+    }
+
   // if we have at least 8 bytes, we can send an ICMP.
   if ( packet->GetSize () > 8 )
     {
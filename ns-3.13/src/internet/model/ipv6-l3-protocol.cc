@@ -27,6 +27,7 @@
 #include "ns3/object-vector.h"
 #include "ns3/ipv6-routing-protocol.h"
 #include "ns3/ipv6-route.h"
+#include "ns3/channel.h"
 
 #include "loopback-net-device.h"
 #include "ipv6-l3-protocol.h"
@@ -102,6 +103,9 @@ void Ipv6L3Protocol::DoDispose ()
       *it = 0;
     }
   m_interfaces.clear ();
+  m_deviceIndex.clear ();
+  m_addressIndex.clear ();
+  m_pmtuCache.clear ();
 
   /* remove raw sockets */
   for (SocketList::iterator it = m_sockets.begin (); it != m_sockets.end (); ++it)
@@ -157,49 +161,112 @@ uint32_t Ipv6L3Protocol::AddIpv6Interface (Ptr<Ipv6Interface> interface)
 
   m_interfaces.push_back (interface);
   m_nInterfaces++;
+
+  /* index the device and the addresses the interface got before being added
+   * (link-local address, loopback), the following ones are notified by the
+   * interface itself
+   */
+  if (interface->GetDevice () && m_deviceIndex.find (PeekPointer (interface->GetDevice ())) == m_deviceIndex.end ())
+    {
+      m_deviceIndex[PeekPointer (interface->GetDevice ())] = index;
+    }
+  for (uint32_t j = 0; j < interface->GetNAddresses (); j++)
+    {
+      NotifyAddressAdded (PeekPointer (interface), interface->GetAddress (j).GetAddress ());
+    }
   return index;
 }
 
 Ptr<Ipv6Interface> Ipv6L3Protocol::GetInterface (uint32_t index) const
 {
   NS_LOG_FUNCTION (this << index);
-  uint32_t tmp = 0;
 
-  for (Ipv6InterfaceList::const_iterator it = m_interfaces.begin (); it != m_interfaces.end (); it++)
+  if (index < m_interfaces.size ())
     {
-      if (index == tmp)
+      return m_interfaces[index];
+    }
+  return 0;
+}
+
+int32_t Ipv6L3Protocol::GetInterfaceIndex (const Ipv6Interface *interface) const
+{
+  NS_LOG_FUNCTION (this << interface);
+  int32_t index = GetInterfaceForDevice (interface->GetDevice ());
+
+  if (index >= 0 && PeekPointer (m_interfaces[index]) == interface)
+    {
+      return index;
+    }
+
+  /* several interfaces on the same device, or not registered */
+  for (uint32_t i = 0; i < m_interfaces.size (); i++)
+    {
+      if (PeekPointer (m_interfaces[i]) == interface)
         {
-          return *it;
+          return i;
         }
-      tmp++;
     }
-  return 0;
+  return -1;
 }
 
-uint32_t Ipv6L3Protocol::GetNInterfaces () const 
+void Ipv6L3Protocol::NotifyAddressAdded (const Ipv6Interface *interface, Ipv6Address address)
 {
-  NS_LOG_FUNCTION_NOARGS ();
-  return m_nInterfaces;
+  NS_LOG_FUNCTION (this << interface << address);
+  int32_t index = GetInterfaceIndex (interface);
+
+  if (index < 0)
+    {
+      /* will be indexed by AddIpv6Interface */
+      return;
+    }
+
+  AddressIndex::iterator it = m_addressIndex.find (address);
+  if (it == m_addressIndex.end () || it->second > (uint32_t)index)
+    {
+      m_addressIndex[address] = index;
+    }
 }
 
-int32_t Ipv6L3Protocol::GetInterfaceForAddress (Ipv6Address address) const
+void Ipv6L3Protocol::NotifyAddressRemoved (const Ipv6Interface *interface, Ipv6Address address)
 {
-  NS_LOG_FUNCTION (this << address); 
-  int32_t index = 0;
+  NS_LOG_FUNCTION (this << interface << address);
+  int32_t index = GetInterfaceIndex (interface);
+  AddressIndex::iterator it = m_addressIndex.find (address);
 
-  for (Ipv6InterfaceList::const_iterator it = m_interfaces.begin (); it != m_interfaces.end (); it++)
+  if (index < 0 || it == m_addressIndex.end () || it->second != (uint32_t)index)
     {
-      uint32_t j = 0;
-      uint32_t max = (*it)->GetNAddresses ();
+      return;
+    }
 
-      for (j = 0; j < max; j++)
+  /* the address may still be configured on another interface */
+  m_addressIndex.erase (it);
+  for (uint32_t i = index + 1; i < m_interfaces.size (); i++)
+    {
+      for (uint32_t j = 0; j < m_interfaces[i]->GetNAddresses (); j++)
         {
-          if ((*it)->GetAddress (j).GetAddress () == address) 
+          if (m_interfaces[i]->GetAddress (j).GetAddress () == address)
             {
-              return index;
+              m_addressIndex[address] = i;
+              return;
             }
         }
-      index++;
+    }
+}
+
+uint32_t Ipv6L3Protocol::GetNInterfaces () const 
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  return m_nInterfaces;
+}
+
+int32_t Ipv6L3Protocol::GetInterfaceForAddress (Ipv6Address address) const
+{
+  NS_LOG_FUNCTION (this << address); 
+  AddressIndex::const_iterator it = m_addressIndex.find (address);
+
+  if (it != m_addressIndex.end ())
+    {
+      return it->second;
     }
   return -1;
 }
@@ -233,15 +300,11 @@ Ptr<NetDevice> Ipv6L3Protocol::GetNetDevice (uint32_t i)
 int32_t Ipv6L3Protocol::GetInterfaceForDevice (Ptr<const NetDevice> device) const
 {
   NS_LOG_FUNCTION (this << device);
-  int32_t index = 0;
+  DeviceIndex::const_iterator it = m_deviceIndex.find (PeekPointer (device));
 
-  for (Ipv6InterfaceList::const_iterator it = m_interfaces.begin (); it != m_interfaces.end (); it++)
+  if (it != m_deviceIndex.end ())
     {
-      if ((*it)->GetDevice () == device)
-        {
-          return index;
-        }
-      index++;
+      return it->second;
     }
   return -1;
 }
@@ -391,6 +454,35 @@ uint16_t Ipv6L3Protocol::GetMtu (uint32_t i) const
   return interface->GetDevice ()->GetMtu ();
 }
 
+void Ipv6L3Protocol::SetPmtu (Ipv6Address dst, uint32_t pmtu)
+{
+  NS_LOG_FUNCTION (this << dst << pmtu);
+
+  /* RFC 8201: a smaller MTU is not used, the packets are fragmented to 1280 */
+  if (pmtu < 1280)
+    {
+      pmtu = 1280;
+    }
+
+  PmtuCache::iterator it = m_pmtuCache.find (dst);
+  if (it == m_pmtuCache.end () || pmtu < it->second)
+    {
+      m_pmtuCache[dst] = pmtu;
+    }
+}
+
+uint32_t Ipv6L3Protocol::GetPmtu (Ipv6Address dst) const
+{
+  NS_LOG_FUNCTION (this << dst);
+  PmtuCache::const_iterator it = m_pmtuCache.find (dst);
+
+  if (it != m_pmtuCache.end ())
+    {
+      return it->second;
+    }
+  return 0;
+}
+
 bool Ipv6L3Protocol::IsUp (uint32_t i) const
 {
   NS_LOG_FUNCTION (this << i);
@@ -665,31 +757,24 @@ void Ipv6L3Protocol::Receive (Ptr<NetDevice> device, Ptr<const Packet> p, uint16
 {
   NS_LOG_FUNCTION (this << device << p << protocol << from << to << packetType);
   NS_LOG_LOGIC ("Packet from " << from << " received on node " << m_node->GetId ());
-  uint32_t interface = 0;
+  int32_t index = GetInterfaceForDevice (device);
+  uint32_t interface = index >= 0 ? index : m_nInterfaces;
   Ptr<Packet> packet = p->Copy ();
-  Ptr<Ipv6Interface> ipv6Interface = 0;
 
-  for (Ipv6InterfaceList::const_iterator it = m_interfaces.begin (); it != m_interfaces.end (); it++)
+  if (index >= 0)
     {
-      ipv6Interface = *it;
-
-      if (ipv6Interface->GetDevice () == device)
+      if (m_interfaces[index]->IsUp ())
         {
-          if (ipv6Interface->IsUp ())
-            {
-              m_rxTrace (packet, m_node->GetObject<Ipv6> (), interface);
-              break;
-            }
-          else
-            {
-              NS_LOG_LOGIC ("Dropping received packet-- interface is down");
-              Ipv6Header hdr;
-              packet->RemoveHeader (hdr);
-              m_dropTrace (hdr, packet, DROP_INTERFACE_DOWN, m_node->GetObject<Ipv6> (), interface);
-              return;
-            }
+          m_rxTrace (packet, m_node->GetObject<Ipv6> (), interface);
+        }
+      else
+        {
+          NS_LOG_LOGIC ("Dropping received packet-- interface is down");
+          Ipv6Header hdr;
+          packet->RemoveHeader (hdr);
+          m_dropTrace (hdr, packet, DROP_INTERFACE_DOWN, m_node->GetObject<Ipv6> (), interface);
+          return;
         }
-      interface++;
     }
 
   Ipv6Header hdr;
@@ -759,21 +844,34 @@ void Ipv6L3Protocol::SendRealOut (Ptr<Ipv6Route> route, Ptr<Packet> packet, Ipv6
   // Check packet size
   std::list<Ptr<Packet> > fragments;
 
-  if (packet->GetSize () > (size_t)(dev->GetMtu () + 40)) /* 40 => size of IPv6 header */
+  /* forwarded packets too big for the next hop were dropped by IpForward,
+   * or are going into a virtual device, such as a tunnel, which fragments
+   * the packets it encapsulates (RFC 2473 section 7.1); the ones sent by
+   * this node are fragmented, to the path MTU when one was learnt
+   */
+  uint32_t mtu = dev->GetMtu ();
+  bool local = GetInterfaceForAddress (ipHeader.GetSourceAddress ()) >= 0;
+
+  if (local)
     {
-      // Router => drop
-      if (m_ipForward)
+      uint32_t pmtu = GetPmtu (ipHeader.GetDestinationAddress ());
+
+      if (pmtu != 0 && pmtu < mtu)
         {
-          return;
+          mtu = pmtu;
         }
+    }
 
+  if (packet->GetSize () + 40 > mtu /* 40 => size of IPv6 header */
+      && (dev->GetChannel () != 0 || local))
+    {
       Ptr<Ipv6ExtensionDemux> ipv6ExtensionDemux = m_node->GetObject<Ipv6ExtensionDemux> ();
 
       packet->AddHeader (ipHeader);
 
       // To get specific method GetFragments from Ipv6ExtensionFragmentation
       Ipv6ExtensionFragment *ipv6Fragment = dynamic_cast<Ipv6ExtensionFragment *>(PeekPointer (ipv6ExtensionDemux->GetExtension (Ipv6Header::IPV6_EXT_FRAGMENTATION)));
-      ipv6Fragment->GetFragments (packet, outInterface->GetDevice ()->GetMtu (), fragments);
+      ipv6Fragment->GetFragments (packet, mtu, fragments);
     }
 
   if (!route->GetGateway ().IsEqual (Ipv6Address::GetAny ()))
@@ -868,6 +966,32 @@ void Ipv6L3Protocol::IpForward (Ptr<Ipv6Route> rtentry, Ptr<const Packet> p, con
       return;
     }
 
+  /* routers do not fragment, the source is told the MTU of the next hop,
+   * unless the next hop is a virtual device (no channel) such as a tunnel:
+   * the sources are not told about its smaller MTU, it fragments the
+   * encapsulating packet instead
+   */
+  uint32_t mtu = rtentry->GetOutputDevice ()->GetMtu ();
+  if (packet->GetSize () + 40 > mtu /* 40 => size of IPv6 header */
+      && rtentry->GetOutputDevice ()->GetChannel () != 0)
+    {
+      NS_LOG_WARN ("Packet too big for the next hop.  Drop.");
+      m_dropTrace (ipHeader, packet, DROP_PACKET_TOO_BIG, m_node->GetObject<Ipv6> (), 0);
+
+      /* never in response to an ICMPv6 error message */
+      uint8_t type = Icmpv6Header::ICMPV6_ECHO_REQUEST;
+      if (ipHeader.GetNextHeader () == Icmpv6L4Protocol::PROT_NUMBER)
+        {
+          packet->CopyData (&type, sizeof (type));
+        }
+      if (type >= Icmpv6Header::ICMPV6_ECHO_REQUEST)
+        {
+          packet->AddHeader (header);
+          GetIcmpv6 ()->SendErrorTooBig (packet, ipHeader.GetSourceAddress (), mtu);
+        }
+      return;
+    }
+
   /* ICMPv6 Redirect */
 
   /* if we forward to a machine on the same network as the source, 
@@ -22,12 +22,14 @@
 #define IPV6_L3_PROTOCOL_H
 
 #include <list>
+#include <vector>
 
 #include "ns3/traced-callback.h"
 #include "ns3/net-device.h"
 #include "ns3/ipv6.h"
 #include "ns3/ipv6-address.h"
 #include "ns3/ipv6-header.h"
+#include "ns3/sgi-hashmap.h"
 
 namespace ns3
 {
@@ -80,6 +82,7 @@ public:
     DROP_INTERFACE_DOWN, /**< Interface is down so can not send packet */
     DROP_ROUTE_ERROR, /**< Route error */
     DROP_UNKNOWN_PROTOCOL, /**< Unknown L4 protocol */
+    DROP_PACKET_TOO_BIG, /**< Packet larger than the MTU of the next hop */
   };
 
   /**
@@ -263,6 +266,24 @@ public:
    */
   uint16_t GetMtu (uint32_t i) const;
 
+  /**
+   * \brief Set the path MTU to a destination, learnt from a Packet Too Big.
+   *
+   * The packets sent by this node to the destination are fragmented to
+   * it. It is never set below the IPv6 minimum MTU (1280) and is not
+   * raised again.
+   * \param dst the destination
+   * \param pmtu the path MTU
+   */
+  void SetPmtu (Ipv6Address dst, uint32_t pmtu);
+
+  /**
+   * \brief Get the path MTU to a destination.
+   * \param dst the destination
+   * \return the path MTU, 0 if none was learnt
+   */
+  uint32_t GetPmtu (Ipv6Address dst) const;
+
   /**
    * \brief Is specified interface up ?
    * \param i interface index
@@ -357,8 +378,10 @@ private:
   /* for unit-tests */
   friend class Ipv6L3ProtocolTestCase;
   friend class Ipv6ExtensionLooseRouting;
+  /* keeps the address index up to date */
+  friend class Ipv6Interface;
 
-  typedef std::list<Ptr<Ipv6Interface> > Ipv6InterfaceList;
+  typedef std::vector<Ptr<Ipv6Interface> > Ipv6InterfaceList;
   typedef std::list<Ptr<Ipv6RawSocketImpl> > SocketList;
   typedef std::list<Ptr<Ipv6L4Protocol> > L4List_t;
 
@@ -451,6 +474,43 @@ private:
    */
   uint32_t AddIpv6Interface (Ptr<Ipv6Interface> interface);
 
+  /**
+   * \brief Hash function class for NetDevice pointers.
+   */
+  class DeviceHash
+  {
+public:
+    size_t operator () (const NetDevice *device) const
+    {
+      return reinterpret_cast<size_t> (device) >> 3;
+    }
+  };
+
+  typedef sgi::hash_map<const NetDevice *, uint32_t, DeviceHash> DeviceIndex;
+  typedef sgi::hash_map<Ipv6Address, uint32_t, Ipv6AddressHash> AddressIndex;
+  typedef sgi::hash_map<Ipv6Address, uint32_t, Ipv6AddressHash> PmtuCache;
+
+  /**
+   * \brief Called by an interface when one of its addresses is added.
+   * \param interface the interface
+   * \param address the new address
+   */
+  void NotifyAddressAdded (const Ipv6Interface *interface, Ipv6Address address);
+
+  /**
+   * \brief Called by an interface when one of its addresses is removed.
+   * \param interface the interface
+   * \param address the removed address
+   */
+  void NotifyAddressRemoved (const Ipv6Interface *interface, Ipv6Address address);
+
+  /**
+   * \brief Get the index of a registered interface.
+   * \param interface the interface
+   * \return its index, or -1 if it is not (yet) part of the stack
+   */
+  int32_t GetInterfaceIndex (const Ipv6Interface *interface) const;
+
   /**
    * \brief Setup loopback interface.
    */
@@ -493,6 +553,22 @@ private:
    */
   uint32_t m_nInterfaces;
 
+  /**
+   * \brief Interface index of each NetDevice.
+   */
+  DeviceIndex m_deviceIndex;
+
+  /**
+   * \brief Interface index of each local address (the lowest one if
+   * the address is configured on several interfaces).
+   */
+  AddressIndex m_addressIndex;
+
+  /**
+   * \brief Path MTU of the destinations that sent back a Packet Too Big.
+   */
+  PmtuCache m_pmtuCache;
+
   /**
    * \brief Default TTL for outgoing packets.
    */
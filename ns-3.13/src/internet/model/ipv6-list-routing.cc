@@ -151,28 +151,20 @@ Ipv6ListRouting::RouteInput (Ptr<const Packet> p, const Ipv6Header &header, Ptr<
   // a packet to one of our other interface addresses; that is, the
   // destination unicast address does not match one of the iif addresses,
   // but we check our other interfaces.  This could be an option
-  // (to remove the outer loop immediately below and just check iif).
-  for (uint32_t j = 0; j < m_ipv6->GetNInterfaces (); j++)
+  // (to only look at the iif addresses below).
+  int32_t j = m_ipv6->GetInterfaceForAddress (header.GetDestinationAddress ());
+  if (j >= 0)
     {
-      for (uint32_t i = 0; i < m_ipv6->GetNAddresses (j); i++)
+      if (uint32_t (j) == iif)
         {
-          Ipv6InterfaceAddress iaddr = m_ipv6->GetAddress (j, i);
-          Ipv6Address addr = iaddr.GetAddress ();
-          if (addr.IsEqual (header.GetDestinationAddress ()))
-            {
-              if (j == iif)
-                {
-                  NS_LOG_LOGIC ("For me (destination " << addr << " match)");
-                }
-              else
-                {
-                  NS_LOG_LOGIC ("For me (destination " << addr << " match) on another interface " << header.GetDestinationAddress ());
-                }
-              lcb (p, header, iif);
-              return true;
-            }
-          NS_LOG_LOGIC ("Address "<< addr << " not a match");
+          NS_LOG_LOGIC ("For me (destination " << header.GetDestinationAddress () << " match)");
+        }
+      else
+        {
+          NS_LOG_LOGIC ("For me (destination " << header.GetDestinationAddress () << " match) on another interface " << j);
         }
+      lcb (p, header, iif);
+      return true;
     }
   // Check if input device supports IP forwarding
   if (m_ipv6->IsForwarding (iif) == false)
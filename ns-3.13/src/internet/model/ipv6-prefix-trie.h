@@ -0,0 +1,361 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef IPV6_PREFIX_TRIE_H
+#define IPV6_PREFIX_TRIE_H
+
+#include <list>
+#include <vector>
+#include <string.h>
+#include <stdint.h>
+
+#include "ns3/assert.h"
+#include "ns3/ipv6-address.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup internet
+ * \class Ipv6PrefixTrie
+ * \brief Path-compressed binary trie of IPv6 prefixes.
+ *
+ * Each prefix holds a list of values, kept in insertion order. Only the
+ * prefixes and the branching points are stored, so a node never has
+ * a single child unless it holds values. Insert, Remove and Find walk
+ * at most one node per bit of the prefix, Match one node per bit of the
+ * address.
+ */
+template <typename T>
+class Ipv6PrefixTrie
+{
+public:
+  typedef std::list<T> Values;
+
+  Ipv6PrefixTrie ()
+    : m_root (new Node ()),
+      m_nNodes (1)
+  {
+  }
+
+  ~Ipv6PrefixTrie ()
+  {
+    Clear ();
+    delete m_root;
+  }
+
+  /**
+   * \brief Add a value at the end of the ones of a prefix.
+   * \param prefix the prefix (bits after length are ignored)
+   * \param length prefix length
+   * \param value the value
+   */
+  void Insert (Ipv6Address prefix, uint8_t length, T value)
+  {
+    NS_ASSERT (length <= 128);
+    uint8_t bits[16];
+    MaskedBytes (prefix, length, bits);
+
+    Node *node = m_root;
+    while (node->length != length)
+      {
+        uint8_t b = GetBit (bits, node->length);
+        Node *child = node->child[b];
+
+        if (!child)
+          {
+            child = NewNode (bits, length);
+            Attach (node, child);
+            child->values.push_back (value);
+            return;
+          }
+
+        uint8_t common = CommonLength (child->bits, bits, child->length < length ? child->length : length);
+        if (common == child->length)
+          {
+            node = child;
+            continue;
+          }
+
+        /* split the edge to the child at the first differing bit */
+        Node *branch = NewNode (bits, common);
+        Attach (node, branch);
+        Attach (branch, child);
+        if (common == length)
+          {
+            branch->values.push_back (value);
+            return;
+          }
+        Node *leaf = NewNode (bits, length);
+        Attach (branch, leaf);
+        leaf->values.push_back (value);
+        return;
+      }
+    node->values.push_back (value);
+  }
+
+  /**
+   * \brief Remove the first occurrence of a value from a prefix.
+   * \param prefix the prefix
+   * \param length prefix length
+   * \param value the value
+   * \return true if found
+   */
+  bool Remove (Ipv6Address prefix, uint8_t length, T value)
+  {
+    Node *node = FindNode (prefix, length);
+    if (!node)
+      {
+        return false;
+      }
+    for (typename Values::iterator it = node->values.begin (); it != node->values.end (); ++it)
+      {
+        if (*it == value)
+          {
+            node->values.erase (it);
+            Prune (node);
+            return true;
+          }
+      }
+    return false;
+  }
+
+  /**
+   * \brief Get the values of a prefix.
+   * \param prefix the prefix
+   * \param length prefix length
+   * \return the values, or 0 if the prefix has none
+   */
+  Values* Find (Ipv6Address prefix, uint8_t length) const
+  {
+    Node *node = FindNode (prefix, length);
+    if (node && !node->values.empty ())
+      {
+        return &node->values;
+      }
+    return 0;
+  }
+
+  /**
+   * \brief Remove all the values of a prefix.
+   * \param prefix the prefix
+   * \param length prefix length
+   */
+  void RemoveAll (Ipv6Address prefix, uint8_t length)
+  {
+    Node *node = FindNode (prefix, length);
+    if (node)
+      {
+        node->values.clear ();
+        Prune (node);
+      }
+  }
+
+  /**
+   * \brief Get the values of all the prefixes containing an address.
+   * \param address the address
+   * \param matches filled with the non-empty value lists, from the
+   * shortest prefix to the longest one
+   */
+  void Match (Ipv6Address address, std::vector<const Values *> &matches) const
+  {
+    uint8_t bits[16];
+    address.GetBytes (bits);
+    matches.clear ();
+
+    const Node *node = m_root;
+    while (node && CommonLength (node->bits, bits, node->length) == node->length)
+      {
+        if (!node->values.empty ())
+          {
+            matches.push_back (&node->values);
+          }
+        if (node->length == 128)
+          {
+            break;
+          }
+        node = node->child[GetBit (bits, node->length)];
+      }
+  }
+
+  /**
+   * \brief Remove all the prefixes.
+   */
+  void Clear ()
+  {
+    Free (m_root->child[0]);
+    Free (m_root->child[1]);
+    m_root->child[0] = m_root->child[1] = 0;
+    m_root->values.clear ();
+    m_nNodes = 1;
+  }
+
+  /**
+   * \brief Whether no prefix holds a value.
+   * \return true if the trie is empty
+   */
+  bool IsEmpty () const
+  {
+    return m_nNodes == 1 && m_root->values.empty ();
+  }
+
+  /**
+   * \brief Get the number of nodes, for tests.
+   * \return number of nodes, including the root one
+   */
+  uint32_t GetNNodes () const
+  {
+    return m_nNodes;
+  }
+
+private:
+  struct Node
+  {
+    Node ()
+      : length (0),
+        parent (0)
+    {
+      memset (bits, 0, 16);
+      child[0] = child[1] = 0;
+    }
+    uint8_t bits[16];
+    uint8_t length;
+    Node *parent;
+    Node *child[2];
+    Values values;
+  };
+
+  Ipv6PrefixTrie (const Ipv6PrefixTrie &);
+  Ipv6PrefixTrie &operator = (const Ipv6PrefixTrie &);
+
+  static uint8_t GetBit (const uint8_t *bits, uint8_t i)
+  {
+    return (bits[i >> 3] >> (7 - (i & 7))) & 1;
+  }
+
+  static void MaskedBytes (Ipv6Address address, uint8_t length, uint8_t bits[16])
+  {
+    address.GetBytes (bits);
+    for (uint8_t i = 0; i < 16; i++)
+      {
+        if (length >= 8 * (i + 1))
+          {
+            continue;
+          }
+        bits[i] = length > 8 * i ? bits[i] & (0xff << (8 - (length - 8 * i))) : 0;
+      }
+  }
+
+  /* number of leading bits a and b have in common, up to max */
+  static uint8_t CommonLength (const uint8_t *a, const uint8_t *b, uint8_t max)
+  {
+    uint8_t i = 0;
+    while (i < max && a[i >> 3] == b[i >> 3])
+      {
+        i += 8;
+      }
+    if (i >= max)
+      {
+        return max;
+      }
+    uint8_t diff = a[i >> 3] ^ b[i >> 3];
+    while (!(diff & 0x80))
+      {
+        diff <<= 1;
+        i++;
+      }
+    return i < max ? i : max;
+  }
+
+  Node* NewNode (const uint8_t *bits, uint8_t length)
+  {
+    Node *node = new Node ();
+    memcpy (node->bits, bits, 16);
+    MaskedBytes (Ipv6Address (node->bits), length, node->bits);
+    node->length = length;
+    m_nNodes++;
+    return node;
+  }
+
+  static void Attach (Node *parent, Node *child)
+  {
+    parent->child[GetBit (child->bits, parent->length)] = child;
+    child->parent = parent;
+  }
+
+  Node* FindNode (Ipv6Address prefix, uint8_t length) const
+  {
+    uint8_t bits[16];
+    MaskedBytes (prefix, length, bits);
+
+    Node *node = m_root;
+    while (node && node->length < length)
+      {
+        node = node->child[GetBit (bits, node->length)];
+      }
+    if (node && node->length == length && memcmp (node->bits, bits, 16) == 0)
+      {
+        return node;
+      }
+    return 0;
+  }
+
+  /* remove the nodes which neither hold values nor branch anymore */
+  void Prune (Node *node)
+  {
+    while (node != m_root && node->values.empty ())
+      {
+        Node *parent = node->parent;
+        Node *only = node->child[0] ? node->child[0] : node->child[1];
+
+        if (node->child[0] && node->child[1])
+          {
+            return;
+          }
+
+        parent->child[GetBit (node->bits, parent->length)] = 0;
+        if (only)
+          {
+            Attach (parent, only);
+          }
+        delete node;
+        m_nNodes--;
+
+        if (only)
+          {
+            return;
+          }
+        node = parent;
+      }
+  }
+
+  void Free (Node *node)
+  {
+    if (node)
+      {
+        Free (node->child[0]);
+        Free (node->child[1]);
+        delete node;
+      }
+  }
+
+  Node *m_root;
+  uint32_t m_nNodes;
+};
+
+} /* namespace ns3 */
+
+#endif /* IPV6_PREFIX_TRIE_H */
@@ -89,7 +89,7 @@ void Ipv6StaticRouting::AddNetworkRouteTo (Ipv6Address network, Ipv6Prefix netwo
   NS_LOG_FUNCTION (this << network << networkPrefix << nextHop << interface << metric);
   Ipv6RoutingTableEntry* route = new Ipv6RoutingTableEntry ();
   *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo (network, networkPrefix, nextHop, interface);
-  m_networkRoutes.push_back (std::make_pair (route, metric));
+  AddNetworkRoute (route, metric);
 }
 
 void Ipv6StaticRouting::AddNetworkRouteTo (Ipv6Address network, Ipv6Prefix networkPrefix, Ipv6Address nextHop, uint32_t interface, Ipv6Address prefixToUse, uint32_t metric)
@@ -97,7 +97,7 @@ void Ipv6StaticRouting::AddNetworkRouteTo (Ipv6Address network, Ipv6Prefix netwo
   NS_LOG_FUNCTION (this << network << networkPrefix << nextHop << interface << prefixToUse << metric);
   Ipv6RoutingTableEntry* route = new Ipv6RoutingTableEntry ();
   *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo (network, networkPrefix, nextHop, interface, prefixToUse);
-  m_networkRoutes.push_back (std::make_pair (route, metric));
+  AddNetworkRoute (route, metric);
 }
 
 void Ipv6StaticRouting::AddNetworkRouteTo (Ipv6Address network, Ipv6Prefix networkPrefix, uint32_t interface, uint32_t metric)
@@ -105,7 +105,7 @@ void Ipv6StaticRouting::AddNetworkRouteTo (Ipv6Address network, Ipv6Prefix netwo
   NS_LOG_FUNCTION (this << network << networkPrefix << interface);
   Ipv6RoutingTableEntry* route = new Ipv6RoutingTableEntry ();
   *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo (network, networkPrefix, interface);
-  m_networkRoutes.push_back (std::make_pair (route, metric));
+  AddNetworkRoute (route, metric);
 }
 
 void Ipv6StaticRouting::SetDefaultRoute (Ipv6Address nextHop, uint32_t interface, Ipv6Address prefixToUse, uint32_t metric)
@@ -129,7 +129,7 @@ void Ipv6StaticRouting::SetDefaultMulticastRoute (uint32_t outputInterface)
   Ipv6Address network = Ipv6Address ("ff00::"); /* RFC 3513 */
   Ipv6Prefix networkMask = Ipv6Prefix (8);
   *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo (network, networkMask, outputInterface);
-  m_networkRoutes.push_back (std::make_pair (route, 0));
+  AddNetworkRoute (route, 0);
 }
 
 uint32_t Ipv6StaticRouting::GetNMulticastRoutes () const
@@ -198,15 +198,17 @@ bool Ipv6StaticRouting::HasNetworkDest (Ipv6Address network, uint32_t interfaceI
   NS_LOG_FUNCTION (this << network << interfaceIndex);
 
   /* in the network table */
-  for (NetworkRoutesI j = m_networkRoutes.begin (); j != m_networkRoutes.end (); j++)
-    {
-      Ipv6RoutingTableEntry* rtentry = j->first;
-      Ipv6Prefix prefix = rtentry->GetDestNetworkPrefix ();
-      Ipv6Address entry = rtentry->GetDestNetwork ();
+  std::vector<const NetworkRoutesTrie::Values *> matches;
+  m_networkRoutesTrie.Match (network, matches);
 
-      if (prefix.IsMatch (network, entry) && rtentry->GetInterface () == interfaceIndex)
+  for (uint32_t i = 0; i < matches.size (); i++)
+    {
+      for (NetworkRoutesTrie::Values::const_iterator j = matches[i]->begin (); j != matches[i]->end (); j++)
         {
-          return true;
+          if ((*j)->first->GetInterface () == interfaceIndex)
+            {
+              return true;
+            }
         }
     }
 
@@ -218,8 +220,6 @@ Ptr<Ipv6Route> Ipv6StaticRouting::LookupStatic (Ipv6Address dst, Ptr<NetDevice>
 {
   NS_LOG_FUNCTION (this << dst << interface);
   Ptr<Ipv6Route> rtentry = 0;
-  uint16_t longestMask = 0;
-  uint32_t shortestMetric = 0xffffffff;
 
   /* when sending on link-local multicast, there have to be interface specified */
   if (dst == Ipv6Address::GetAllNodesMulticast () || dst.IsSolicitedMulticast () || 
@@ -234,64 +234,64 @@ Ptr<Ipv6Route> Ipv6StaticRouting::LookupStatic (Ipv6Address dst, Ptr<NetDevice>
       return rtentry;
     }
 
-  for (NetworkRoutesI it = m_networkRoutes.begin (); it != m_networkRoutes.end (); it++)
-    {
-      Ipv6RoutingTableEntry* j = it->first;
-      uint32_t metric = it->second;
-      Ipv6Prefix mask = j->GetDestNetworkPrefix ();
-      uint16_t maskLen = mask.GetPrefixLength ();
-      Ipv6Address entry = j->GetDestNetwork ();
+  /* the routes of the prefixes matching dst, from the shortest prefix to
+   * the longest one. The longest prefix with a route on the requested
+   * interface wins, and among its routes the lowest metric, the last
+   * added one on a tie.
+   */
+  std::vector<const NetworkRoutesTrie::Values *> matches;
+  m_networkRoutesTrie.Match (dst, matches);
 
-      NS_LOG_LOGIC ("Searching for route to " << dst << ", mask length " << maskLen << ", metric " << metric);
+  Ipv6RoutingTableEntry* route = 0;
+  for (int32_t i = matches.size () - 1; i >= 0 && !route; i--)
+    {
+      uint32_t shortestMetric = 0xffffffff;
 
-      if (mask.IsMatch (dst, entry))
+      for (NetworkRoutesTrie::Values::const_iterator it = matches[i]->begin (); it != matches[i]->end (); it++)
         {
-          NS_LOG_LOGIC ("Found global network route " << j << ", mask length " << maskLen << ", metric " << metric);
+          Ipv6RoutingTableEntry* j = (*it)->first;
+          uint32_t metric = (*it)->second;
+
+          NS_LOG_LOGIC ("Found global network route " << j << ", mask length " << (uint32_t)j->GetDestNetworkPrefix ().GetPrefixLength () << ", metric " << metric);
 
           /* if interface is given, check the route will output on this interface */
-          if (!interface || interface == m_ipv6->GetNetDevice (j->GetInterface ()))
+          if (interface && interface != m_ipv6->GetNetDevice (j->GetInterface ()))
             {
-              if (maskLen < longestMask)
-                {
-                  NS_LOG_LOGIC ("Previous match longer, skipping");
-                  continue;
-                }
-
-              if (maskLen > longestMask)
-                {
-                  shortestMetric = 0xffffffff;
-                }
+              continue;
+            }
 
-              longestMask = maskLen;
-              if (metric > shortestMetric)
-                {
-                  NS_LOG_LOGIC ("Equal mask length, but previous metric shorter, skipping");
-                  continue;
-                }
+          if (metric > shortestMetric)
+            {
+              NS_LOG_LOGIC ("Equal mask length, but previous metric shorter, skipping");
+              continue;
+            }
 
-              shortestMetric = metric;
-              Ipv6RoutingTableEntry* route = j;
-              uint32_t interfaceIdx = route->GetInterface ();
-              rtentry = Create<Ipv6Route> ();
+          shortestMetric = metric;
+          route = j;
+        }
+    }
 
-              if (route->GetGateway ().IsAny ())
-                {
-                  rtentry->SetSource (SourceAddressSelection (interfaceIdx, route->GetDest ()));
-                }
-              else if (route->GetDest ().IsAny ()) /* default route */
-                {
-                  rtentry->SetSource (SourceAddressSelection (interfaceIdx, route->GetPrefixToUse ().IsAny () ? route->GetGateway () : route->GetPrefixToUse ()));
-                }
-              else
-                {
-                  rtentry->SetSource (SourceAddressSelection (interfaceIdx, route->GetGateway ()));
-                }
+  if (route)
+    {
+      uint32_t interfaceIdx = route->GetInterface ();
+      rtentry = Create<Ipv6Route> ();
 
-              rtentry->SetDestination (route->GetDest ());
-              rtentry->SetGateway (route->GetGateway ());
-              rtentry->SetOutputDevice (m_ipv6->GetNetDevice (interfaceIdx));
-            }
+      if (route->GetGateway ().IsAny ())
+        {
+          rtentry->SetSource (SourceAddressSelection (interfaceIdx, route->GetDest ()));
+        }
+      else if (route->GetDest ().IsAny ()) /* default route */
+        {
+          rtentry->SetSource (SourceAddressSelection (interfaceIdx, route->GetPrefixToUse ().IsAny () ? route->GetGateway () : route->GetPrefixToUse ()));
+        }
+      else
+        {
+          rtentry->SetSource (SourceAddressSelection (interfaceIdx, route->GetGateway ()));
         }
+
+      rtentry->SetDestination (route->GetDest ());
+      rtentry->SetGateway (route->GetGateway ());
+      rtentry->SetOutputDevice (m_ipv6->GetNetDevice (interfaceIdx));
     }
 
   if(rtentry)
@@ -301,6 +301,22 @@ Ptr<Ipv6Route> Ipv6StaticRouting::LookupStatic (Ipv6Address dst, Ptr<NetDevice>
   return rtentry;
 }
 
+void Ipv6StaticRouting::AddNetworkRoute (Ipv6RoutingTableEntry *route, uint32_t metric)
+{
+  NS_LOG_FUNCTION (this << route << metric);
+  NetworkRoutesI it = m_networkRoutes.insert (m_networkRoutes.end (), std::make_pair (route, metric));
+  m_networkRoutesTrie.Insert (route->GetDestNetwork (), route->GetDestNetworkPrefix ().GetPrefixLength (), it);
+}
+
+Ipv6StaticRouting::NetworkRoutesI Ipv6StaticRouting::RemoveNetworkRoute (NetworkRoutesI it)
+{
+  NS_LOG_FUNCTION (this << it->first);
+  Ipv6RoutingTableEntry* route = it->first;
+  m_networkRoutesTrie.Remove (route->GetDestNetwork (), route->GetDestNetworkPrefix ().GetPrefixLength (), it);
+  delete route;
+  return m_networkRoutes.erase (it);
+}
+
 void Ipv6StaticRouting::DoDispose ()
 {
   NS_LOG_FUNCTION_NOARGS ();
@@ -310,6 +326,7 @@ void Ipv6StaticRouting::DoDispose ()
       delete j->first;
     }
   m_networkRoutes.clear ();
+  m_networkRoutesTrie.Clear ();
 
   for (MulticastRoutesI i = m_multicastRoutes.begin (); i != m_multicastRoutes.end (); i = m_multicastRoutes.erase (i))
     {
@@ -382,25 +399,23 @@ Ipv6RoutingTableEntry Ipv6StaticRouting::GetDefaultRoute ()
   uint32_t shortestMetric = 0xffffffff;
   Ipv6RoutingTableEntry* result = 0;
 
-  for (NetworkRoutesI it = m_networkRoutes.begin (); it != m_networkRoutes.end (); it++)
-    {
-      Ipv6RoutingTableEntry* j = it->first;
-      uint32_t metric = it->second;
-      Ipv6Prefix mask = j->GetDestNetworkPrefix ();
-      uint16_t maskLen = mask.GetPrefixLength ();
-      Ipv6Address entry = j->GetDestNetwork ();
+  /* the default routes are the ones of the root prefix */
+  NetworkRoutesTrie::Values *routes = m_networkRoutesTrie.Find (dst, 0);
 
-      if (maskLen)
+  if (routes)
+    {
+      for (NetworkRoutesTrie::Values::const_iterator it = routes->begin (); it != routes->end (); it++)
         {
-          continue;
-        }
+          Ipv6RoutingTableEntry* j = (*it)->first;
+          uint32_t metric = (*it)->second;
 
-      if (metric > shortestMetric)
-        {
-          continue;
+          if (metric > shortestMetric)
+            {
+              continue;
+            }
+          shortestMetric = metric;
+          result = j;
         }
-      shortestMetric = metric;
-      result = j;
     }
 
   if (result)
@@ -458,8 +473,7 @@ void Ipv6StaticRouting::RemoveRoute (uint32_t index)
     {
       if (tmp == index)
         {
-          delete it->first;
-          m_networkRoutes.erase (it);
+          RemoveNetworkRoute (it);
           return;
         }
       tmp++;
@@ -470,15 +484,20 @@ void Ipv6StaticRouting::RemoveRoute (uint32_t index)
 void Ipv6StaticRouting::RemoveRoute (Ipv6Address network, Ipv6Prefix prefix, uint32_t ifIndex, Ipv6Address prefixToUse)
 {
   NS_LOG_FUNCTION (this << network << prefix << ifIndex);
+  NetworkRoutesTrie::Values *routes = m_networkRoutesTrie.Find (network, prefix.GetPrefixLength ());
 
-  for (NetworkRoutesI it = m_networkRoutes.begin (); it != m_networkRoutes.end (); it++)
+  if (!routes)
+    {
+      return;
+    }
+
+  for (NetworkRoutesTrie::Values::iterator it = routes->begin (); it != routes->end (); it++)
     {
-      Ipv6RoutingTableEntry* rtentry = it->first;
+      Ipv6RoutingTableEntry* rtentry = (*it)->first;
       if (network == rtentry->GetDest () && rtentry->GetInterface () == ifIndex && 
           rtentry->GetPrefixToUse () == prefixToUse)
         {
-          delete it->first;
-          m_networkRoutes.erase (it);
+          RemoveNetworkRoute (*it);
           return;
         }
     }
@@ -548,28 +567,20 @@ bool Ipv6StaticRouting::RouteInput (Ptr<const Packet> p, const Ipv6Header &heade
   // a packet to one of our other interface addresses; that is, the
   // destination unicast address does not match one of the iif addresses,
   // but we check our other interfaces.  This could be an option
-  // (to remove the outer loop immediately below and just check iif).
-  for (uint32_t j = 0; j < m_ipv6->GetNInterfaces (); j++)
+  // (to only look at the iif addresses below).
+  int32_t j = m_ipv6->GetInterfaceForAddress (header.GetDestinationAddress ());
+  if (j >= 0)
     {
-      for (uint32_t i = 0; i < m_ipv6->GetNAddresses (j); i++)
+      if (uint32_t (j) == iif)
         {
-          Ipv6InterfaceAddress iaddr = m_ipv6->GetAddress (j, i);
-          Ipv6Address addr = iaddr.GetAddress ();
-          if (addr.IsEqual (header.GetDestinationAddress ()))
-            {
-              if (j == iif)
-                {
-                  NS_LOG_LOGIC ("For me (destination " << addr << " match)");
-                }
-              else
-                {
-                  NS_LOG_LOGIC ("For me (destination " << addr << " match) on another interface " << header.GetDestinationAddress ());
-                }
-              lcb (p, header, iif);
-              return true;
-            }
-          NS_LOG_LOGIC ("Address "<< addr << " not a match");
+          NS_LOG_LOGIC ("For me (destination " << header.GetDestinationAddress () << " match)");
+        }
+      else
+        {
+          NS_LOG_LOGIC ("For me (destination " << header.GetDestinationAddress () << " match) on another interface " << j);
         }
+      lcb (p, header, iif);
+      return true;
     }
   // Check if input device supports IP forwarding
   if (m_ipv6->IsForwarding (iif) == false)
@@ -619,21 +630,18 @@ void Ipv6StaticRouting::NotifyInterfaceUp (uint32_t i)
 void Ipv6StaticRouting::NotifyInterfaceDown (uint32_t i)
 {
   NS_LOG_FUNCTION (this << i);
-  uint32_t j = 0;
-  uint32_t max = GetNRoutes ();
 
   /* remove all static routes that are going through this interface */
-  while (j < max)
+  NetworkRoutesI it = m_networkRoutes.begin ();
+  while (it != m_networkRoutes.end ())
     {
-      Ipv6RoutingTableEntry route = GetRoute (j);
-
-      if (route.GetInterface () == i)
+      if (it->first->GetInterface () == i)
         {
-          RemoveRoute (j);
+          it = RemoveNetworkRoute (it);
         }
       else
         {
-          j++;
+          it++;
         }
     }
 }
@@ -666,18 +674,29 @@ void Ipv6StaticRouting::NotifyRemoveAddress (uint32_t interface, Ipv6InterfaceAd
 
   // Remove all static routes that are going through this interface
   // which reference this network
-  for (uint32_t j = 0; j < GetNRoutes (); j++)
+  NetworkRoutesTrie::Values *routes = m_networkRoutesTrie.Find (networkAddress, networkMask.GetPrefixLength ());
+  if (!routes)
+    {
+      return;
+    }
+
+  std::vector<NetworkRoutesI> toRemove;
+  for (NetworkRoutesTrie::Values::iterator it = routes->begin (); it != routes->end (); it++)
     {
-      Ipv6RoutingTableEntry route = GetRoute (j);
+      Ipv6RoutingTableEntry* route = (*it)->first;
 
-      if (route.GetInterface () == interface &&
-          route.IsNetwork () &&
-          route.GetDestNetwork () == networkAddress &&
-          route.GetDestNetworkPrefix () == networkMask)
+      if (route->GetInterface () == interface &&
+          route->IsNetwork () &&
+          route->GetDestNetwork () == networkAddress &&
+          route->GetDestNetworkPrefix () == networkMask)
         {
-          RemoveRoute (j);
+          toRemove.push_back (*it);
         }
     }
+  for (uint32_t j = 0; j < toRemove.size (); j++)
+    {
+      RemoveNetworkRoute (toRemove[j]);
+    }
 }
 
 void Ipv6StaticRouting::NotifyAddRoute (Ipv6Address dst, Ipv6Prefix mask, Ipv6Address nextHop, uint32_t interface, Ipv6Address prefixToUse)
@@ -706,18 +725,29 @@ void Ipv6StaticRouting::NotifyRemoveRoute (Ipv6Address dst, Ipv6Prefix mask, Ipv
   NS_LOG_FUNCTION (this << dst << mask << nextHop << interface);
   if (dst != Ipv6Address::GetZero ())
     {
-      for (NetworkRoutesI j = m_networkRoutes.begin (); j != m_networkRoutes.end (); j++)
+      NetworkRoutesTrie::Values *routes = m_networkRoutesTrie.Find (dst, mask.GetPrefixLength ());
+      std::vector<NetworkRoutesI> toRemove;
+
+      if (!routes)
+        {
+          return;
+        }
+
+      for (NetworkRoutesTrie::Values::iterator j = routes->begin (); j != routes->end (); j++)
         {
-          Ipv6RoutingTableEntry* rtentry = j->first;
+          Ipv6RoutingTableEntry* rtentry = (*j)->first;
           Ipv6Prefix prefix = rtentry->GetDestNetworkPrefix ();
           Ipv6Address entry = rtentry->GetDestNetwork ();
 
           if (dst == entry && prefix == mask && rtentry->GetInterface () == interface)
             {
-              delete j->first;
-              m_networkRoutes.erase (j);
+              toRemove.push_back (*j);
             } 
         }
+      for (uint32_t j = 0; j < toRemove.size (); j++)
+        {
+          RemoveNetworkRoute (toRemove[j]);
+        }
     }
   else
     {
@@ -30,6 +30,7 @@
 #include "ns3/ipv6.h"
 #include "ns3/ipv6-header.h"
 #include "ns3/ipv6-routing-protocol.h"
+#include "ns3/ipv6-prefix-trie.h"
 
 namespace ns3
 {
@@ -247,6 +248,7 @@ private:
   typedef std::list<std::pair <Ipv6RoutingTableEntry *, uint32_t> > NetworkRoutes;
   typedef std::list<std::pair <Ipv6RoutingTableEntry *, uint32_t> >::const_iterator NetworkRoutesCI;
   typedef std::list<std::pair <Ipv6RoutingTableEntry *, uint32_t> >::iterator NetworkRoutesI;
+  typedef Ipv6PrefixTrie<NetworkRoutesI> NetworkRoutesTrie;
 
   typedef std::list<Ipv6MulticastRoutingTableEntry *> MulticastRoutes;
   typedef std::list<Ipv6MulticastRoutingTableEntry *>::const_iterator MulticastRoutesCI;
@@ -277,11 +279,31 @@ private:
    */
   Ipv6Address SourceAddressSelection (uint32_t interface, Ipv6Address dest);
 
+  /**
+   * \brief Add a route to the forwarding table and to its index.
+   * \param route the route
+   * \param metric metric of the route
+   */
+  void AddNetworkRoute (Ipv6RoutingTableEntry *route, uint32_t metric);
+
+  /**
+   * \brief Remove and delete a route.
+   * \param it the route
+   * \return the next route of the forwarding table
+   */
+  NetworkRoutesI RemoveNetworkRoute (NetworkRoutesI it);
+
   /**
    * \brief the forwarding table for network.
    */
   NetworkRoutes m_networkRoutes;
 
+  /**
+   * \brief the routes of the forwarding table indexed by destination
+   * prefix, each prefix keeping its routes in the table order.
+   */
+  NetworkRoutesTrie m_networkRoutesTrie;
+
   /**
    * \brief the forwarding table for multicast.
    */
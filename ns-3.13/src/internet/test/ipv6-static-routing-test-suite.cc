@@ -0,0 +1,283 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/mac48-address.h"
+#include "ns3/ipv6-route.h"
+#include "ns3/ipv6-header.h"
+#include "ns3/ipv6-l3-protocol.h"
+#include "ns3/ipv6-prefix-trie.h"
+#include "ns3/ipv6-static-routing.h"
+#include "ns3/ipv6-routing-table-entry.h"
+#include "ns3/ipv6-static-routing-helper.h"
+#include "ns3/internet-stack-helper.h"
+
+namespace ns3 {
+
+class Ipv6PrefixTrieTestCase : public TestCase
+{
+public:
+  Ipv6PrefixTrieTestCase ();
+  virtual void DoRun (void);
+};
+
+Ipv6PrefixTrieTestCase::Ipv6PrefixTrieTestCase ()
+  : TestCase ("Insert, match and remove prefixes")
+{
+}
+
+void
+Ipv6PrefixTrieTestCase::DoRun (void)
+{
+  Ipv6PrefixTrie<uint32_t> trie;
+  std::vector<const Ipv6PrefixTrie<uint32_t>::Values *> matches;
+
+  trie.Insert ("::", 0, 0);
+  trie.Insert ("2001:db8:1::", 48, 1);
+  trie.Insert ("2001:db8:1:2::", 64, 2);
+  trie.Insert ("2001:db8:1:3::", 64, 3);
+  trie.Insert ("2001:db8:1:2::ffff", 64, 4); /* host bits are ignored */
+
+  trie.Match ("2001:db8:1:2::1", matches);
+  NS_TEST_ASSERT_MSG_EQ (matches.size (), 3, "::/0, /48 and 2001:db8:1:2::/64 should match");
+  NS_TEST_EXPECT_MSG_EQ (matches[0]->front (), 0, "Matches should go from the shortest prefix");
+  NS_TEST_EXPECT_MSG_EQ (matches[1]->front (), 1, "Matches should go from the shortest prefix");
+  NS_TEST_ASSERT_MSG_EQ (matches[2]->size (), 2, "Both values of the /64 should be there");
+  NS_TEST_EXPECT_MSG_EQ (matches[2]->front (), 2, "Values should keep the insertion order");
+  NS_TEST_EXPECT_MSG_EQ (matches[2]->back (), 4, "Values should keep the insertion order");
+
+  trie.Match ("2001:db8:2::1", matches);
+  NS_TEST_EXPECT_MSG_EQ (matches.size (), 1, "Only the default prefix should match");
+
+  /* root, /48, the /63 branching point and the two /64 */
+  NS_TEST_EXPECT_MSG_EQ (trie.GetNNodes (), 5, "Wrong number of nodes");
+
+  NS_TEST_EXPECT_MSG_EQ (trie.Remove ("2001:db8:1:3::", 64, 2), false, "Value 2 is not on that prefix");
+  NS_TEST_EXPECT_MSG_EQ (trie.Remove ("2001:db8:1:3::", 64, 3), true, "Value 3 should be removed");
+  NS_TEST_EXPECT_MSG_EQ (trie.GetNNodes (), 3, "The /64 and the branching point should be pruned");
+
+  NS_TEST_EXPECT_MSG_EQ (trie.Remove ("2001:db8:1::", 48, 1), true, "Value 1 should be removed");
+  NS_TEST_EXPECT_MSG_EQ (trie.GetNNodes (), 2, "The /48 should be pruned");
+  trie.Match ("2001:db8:1:2::1", matches);
+  NS_TEST_EXPECT_MSG_EQ (matches.size (), 2, "::/0 and the /64 should still match");
+
+  NS_TEST_EXPECT_MSG_EQ ((trie.Find ("2001:db8:1::", 48) == 0), true, "The /48 has no value anymore");
+  NS_TEST_EXPECT_MSG_EQ (trie.Find ("2001:db8:1:2::", 64)->size (), 2, "The /64 should be found");
+
+  trie.RemoveAll ("2001:db8:1:2::", 64);
+  NS_TEST_EXPECT_MSG_EQ (trie.GetNNodes (), 1, "Only the root should be left");
+
+  trie.Insert ("2001:db8::1", 128, 5);
+  trie.Match ("2001:db8::1", matches);
+  NS_TEST_EXPECT_MSG_EQ (matches.size (), 2, "::/0 and the host prefix should match");
+  trie.Match ("2001:db8::2", matches);
+  NS_TEST_EXPECT_MSG_EQ (matches.size (), 1, "The host prefix should not match");
+
+  NS_TEST_EXPECT_MSG_EQ (trie.Remove ("2001:db8::1", 128, 5), true, "Value 5 should be removed");
+  NS_TEST_EXPECT_MSG_EQ (trie.IsEmpty (), false, "::/0 still holds a value");
+  NS_TEST_EXPECT_MSG_EQ (trie.Remove ("::", 0, 0), true, "Value 0 should be removed");
+  NS_TEST_EXPECT_MSG_EQ (trie.IsEmpty (), true, "No prefix holds a value anymore");
+}
+
+/**
+ * Checks Ipv6StaticRouting against the linear search of the forwarding
+ * table it used to do, on random tables with overlapping prefixes and
+ * metric ties.
+ */
+class Ipv6StaticRoutingLookupTestCase : public TestCase
+{
+public:
+  Ipv6StaticRoutingLookupTestCase ();
+  virtual void DoRun (void);
+
+private:
+  uint32_t Random (uint32_t max);
+  Ipv6Address RandomAddress (void);
+  int32_t Reference (Ipv6Address dst);
+
+  uint32_t m_seed;
+  Ptr<Ipv6StaticRouting> m_routing;
+};
+
+Ipv6StaticRoutingLookupTestCase::Ipv6StaticRoutingLookupTestCase ()
+  : TestCase ("Lookup against the linear search of the table"),
+    m_seed (1)
+{
+}
+
+uint32_t
+Ipv6StaticRoutingLookupTestCase::Random (uint32_t max)
+{
+  m_seed = m_seed * 1103515245 + 12345;
+  return (m_seed >> 8) % max;
+}
+
+Ipv6Address
+Ipv6StaticRoutingLookupTestCase::RandomAddress (void)
+{
+  /* few different values per byte, so that prefixes overlap */
+  uint8_t buf[16] = { 0x20, 0x01, 0x0d, 0xb8 };
+  for (uint32_t i = 4; i < 16; i++)
+    {
+      buf[i] = Random (3) << (i % 2 ? 0 : 4);
+    }
+  return Ipv6Address (buf);
+}
+
+int32_t
+Ipv6StaticRoutingLookupTestCase::Reference (Ipv6Address dst)
+{
+  int32_t best = -1;
+  uint16_t longestMask = 0;
+  uint32_t shortestMetric = 0xffffffff;
+
+  for (uint32_t i = 0; i < m_routing->GetNRoutes (); i++)
+    {
+      Ipv6RoutingTableEntry route = m_routing->GetRoute (i);
+      uint32_t metric = m_routing->GetMetric (i);
+      Ipv6Prefix mask = route.GetDestNetworkPrefix ();
+      uint16_t maskLen = mask.GetPrefixLength ();
+
+      if (!mask.IsMatch (dst, route.GetDestNetwork ()) || maskLen < longestMask)
+        {
+          continue;
+        }
+      if (maskLen > longestMask)
+        {
+          shortestMetric = 0xffffffff;
+        }
+      longestMask = maskLen;
+      if (metric > shortestMetric)
+        {
+          continue;
+        }
+      shortestMetric = metric;
+      best = i;
+    }
+  return best;
+}
+
+void
+Ipv6StaticRoutingLookupTestCase::DoRun (void)
+{
+  Config::SetDefault ("ns3::Icmpv6L4Protocol::DAD", BooleanValue (false));
+
+  Ptr<Node> node = CreateObject<Node> ();
+  InternetStackHelper internet;
+  internet.SetIpv4StackInstall (false);
+  internet.Install (node);
+
+  Ptr<Ipv6L3Protocol> ipv6 = node->GetObject<Ipv6L3Protocol> ();
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+      device->SetAddress (Mac48Address::Allocate ());
+      node->AddDevice (device);
+      ipv6->SetUp (ipv6->AddInterface (device));
+    }
+
+  Ipv6StaticRoutingHelper helper;
+  m_routing = helper.GetStaticRouting (ipv6);
+
+  static const uint8_t lengths[] = { 0, 16, 32, 36, 48, 52, 63, 64, 65, 80, 96, 127, 128 };
+  uint32_t found = 0;
+
+  for (uint32_t round = 0; round < 20; round++)
+    {
+      for (uint32_t i = 0; i < 50; i++)
+        {
+          Ipv6Prefix prefix (lengths[Random (sizeof (lengths))]);
+          Ipv6Address network = RandomAddress ().CombinePrefix (prefix);
+          Ipv6Address gateway = Random (2) ? Ipv6Address::GetAny () : RandomAddress ();
+          m_routing->AddNetworkRouteTo (network, prefix, gateway, 1 + Random (3), Random (3));
+        }
+
+      /* remove some routes, by index and by destination */
+      for (uint32_t i = 0; i < 20 && m_routing->GetNRoutes () > 0; i++)
+        {
+          uint32_t index = Random (m_routing->GetNRoutes ());
+          if (Random (2))
+            {
+              m_routing->RemoveRoute (index);
+            }
+          else
+            {
+              Ipv6RoutingTableEntry route = m_routing->GetRoute (index);
+              if (!route.GetDestNetwork ().IsAny ())
+                {
+                  m_routing->NotifyRemoveRoute (route.GetDestNetwork (), route.GetDestNetworkPrefix (), route.GetGateway (), route.GetInterface ());
+                }
+            }
+        }
+
+      for (uint32_t i = 0; i < 200; i++)
+        {
+          Ipv6Address dst = RandomAddress ();
+          Ipv6Header header;
+          Socket::SocketErrno err;
+          header.SetDestinationAddress (dst);
+
+          Ptr<Ipv6Route> route = m_routing->RouteOutput (0, header, 0, err);
+          int32_t expected = Reference (dst);
+
+          if (expected < 0)
+            {
+              NS_TEST_ASSERT_MSG_EQ ((route == 0), true, "No route expected to " << dst);
+              continue;
+            }
+
+          found++;
+          Ipv6RoutingTableEntry entry = m_routing->GetRoute (expected);
+          NS_TEST_ASSERT_MSG_EQ ((route != 0), true, "A route was expected to " << dst);
+          NS_TEST_ASSERT_MSG_EQ (route->GetDestination (), entry.GetDest (), "Wrong route to " << dst);
+          NS_TEST_ASSERT_MSG_EQ (route->GetGateway (), entry.GetGateway (), "Wrong route to " << dst);
+          NS_TEST_ASSERT_MSG_EQ (route->GetOutputDevice (), ipv6->GetNetDevice (entry.GetInterface ()), "Wrong route to " << dst);
+        }
+    }
+
+  NS_TEST_EXPECT_MSG_GT (found, 1000, "Most lookups should find a route");
+
+  /* taking the interfaces down flushes their routes */
+  for (uint32_t i = 1; i < 4; i++)
+    {
+      ipv6->SetDown (i);
+    }
+  Ipv6Header header;
+  Socket::SocketErrno err;
+  header.SetDestinationAddress (RandomAddress ());
+  NS_TEST_EXPECT_MSG_EQ ((m_routing->RouteOutput (0, header, 0, err) == 0), true, "All the routes should be gone");
+
+  m_routing = 0;
+  Simulator::Destroy ();
+}
+
+static class Ipv6StaticRoutingTestSuite : public TestSuite
+{
+public:
+  Ipv6StaticRoutingTestSuite ()
+    : TestSuite ("ipv6-static-routing", UNIT)
+  {
+    AddTestCase (new Ipv6PrefixTrieTestCase ());
+    AddTestCase (new Ipv6StaticRoutingLookupTestCase ());
+  }
+} g_ipv6StaticRoutingTestSuite;
+
+} // namespace ns3
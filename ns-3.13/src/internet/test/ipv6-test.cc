@@ -135,6 +135,25 @@ Ipv6L3ProtocolTestCase::DoRun ()
 
   index = ipv6->GetInterfaceForAddress ("2001:ffff:5678:9000::1"); /* address we just remove */
   NS_TEST_ASSERT_MSG_EQ (index, (uint32_t) -1, "Address should not be found??");
+
+  /* lookups are indexed, check the index follows the interfaces */
+  index = ipv6->GetInterfaceForDevice (device2);
+  NS_TEST_ASSERT_MSG_EQ (index, 2, "Wrong interface for device 2");
+
+  interface2->AddAddress (ifaceAddr1); /* also configured on the first interface */
+  index = ipv6->GetInterfaceForAddress ("2001:1234:5678:9000::1");
+  NS_TEST_ASSERT_MSG_EQ (index, 1, "The lowest interface should be returned");
+
+  interface->RemoveAddress (1);
+  index = ipv6->GetInterfaceForAddress ("2001:1234:5678:9000::1");
+  NS_TEST_ASSERT_MSG_EQ (index, 2, "The address is still on the second interface");
+
+  Ipv6Address linkLocal = interface2->GetLinkLocalAddress ().GetAddress ();
+  interface2->SetDown ();
+  index = ipv6->GetInterfaceForAddress (linkLocal);
+  NS_TEST_ASSERT_MSG_EQ (index, 1, "Both devices have the same MAC, so the same link-local address");
+  index = ipv6->GetInterfaceForAddress ("2001:1234:5678:9000::1");
+  NS_TEST_ASSERT_MSG_EQ (index, (uint32_t) -1, "Addresses of a down interface should not be found");
   Simulator::Destroy ();
 } //end DoRun
 static class IPv6L3ProtocolTestSuite : public TestSuite
@@ -0,0 +1,1221 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Scale benchmark of a PMIPv6 domain.
+ *
+ *                      core (CN)
+ *            p2p /     |      |     \ p2p
+ *            LMA 0 .. LMA m  MAG 0 .. MAG n
+ *                              |  access  |
+ *                             MNs        MNs
+ *
+ * nLmas LMAs and nMags MAGs hang off a core router. The nMns mobile
+ * nodes are spread over the LMAs and attach to the MAGs round robin,
+ * then hand over to a neighbouring MAG (the MAGs form a ring) at
+ * handoverRate per MN and per second.
+ *
+ * Attachments are fed straight to the MAG through its notifier, so no
+ * radio is simulated. With --dataPlane=0 (the default) there are no MN
+ * nodes at all and only the signaling is simulated. With --dataPlane=1
+ * every MN is a node, linked to a MAG by a point-to-point link when it
+ * first attaches there, and the core sends it a UDP flow through the
+ * LMA tunnel.
+ *
+ * With --trace=<file>, the attachments and detachments are instead
+ * replayed from an attachment trace (see Pmipv6AttachmentReplay), MAG j
+ * being the j-th MAG and MN k having the MAC address 02:00:kk:kk:kk:kk
+ * (k in hexadecimal); there is then no generated mobility.
+ *
+ * With --bulk, the MAGs register the bindings for bulk refresh
+ * (RFC 6602): each MAG refreshes all its bindings with one PBU per
+ * lifetime period, set by --lifetime.
+ *
+ * With --fastHandover, the previous MAG pushes the context of the MN to
+ * the next MAG (RFC 5949) hiLead seconds before each generated handover,
+ * and the next MAG serves the MN as soon as it attaches.
+ *
+ * With --lmaSelection=hash or load, the MNs are not statically spread
+ * over the LMAs but given one by a Pmipv6LmaPool shared by the MAGs,
+ * by consistent hashing of their identifier or by load, and the LMA
+ * allocates their prefix. --redirect=<n> makes an LMA holding n
+ * bindings redirect the new registrations to a less loaded peer
+ * (RFC 6463). --serviceTime gives the LMAs a PBU processing time, so
+ * that a burst of first attachments (over --attachSpread seconds)
+ * saturates them; the registration rate then measures the binding
+ * capacity of the domain.
+ *
+ * With --backhaulRate, the links of the MAGs to the core run at that
+ * rate instead of 1Gbps. With --compression, the tunnel end-points
+ * compress the inner IPv6 header of the tunneled packets (see
+ * Ipv6TunnelCompressedHeader); the data plane then reports the goodput
+ * of small packets over a slow backhaul with and without it.
+ *
+ * With --distributed, the domain is split over the ranks of an MPI run
+ * (ns-3 configured with --enable-mpi) by Pmip6PartitionHelper: the core
+ * router on rank 0, the LMAs and the MAGs in contiguous blocks over
+ * the ranks. Every rank draws the mobility of all the MNs, but only
+ * notifies the attachments to its own MAGs; the counters and latencies
+ * of the ranks are summed up by rank 0, and match a sequential run of
+ * the same scenario. Signaling only, with static or hash LMA selection.
+ * --check verifies it: every rank first runs the scenario sequentially,
+ * and the run fails if the partitioned one disagrees on the attach, PBU
+ * and PBA counts, the registrations, the bindings of each LMA or the
+ * latency percentiles.
+ *
+ * Reports the wall-clock time, the simulator events scheduled per
+ * wall-clock second, the PBU and PBA rates, the peak RSS of the process
+ * and the percentiles of the handover latency, from the attachment to
+ * the reception of the accepting PBA by the MAG, or to the attachment
+ * itself when the MAG was prepared by a fast handover.
+ *
+ * ./waf --run "pmip6-scale --nMags=50 --nLmas=2 --nMns=10000 --duration=60"
+ * ./waf --run "pmip6-scale --nMags=1000 --nLmas=16 --nMns=1000000 --trace=attachments.txt"
+ * ./waf --run "pmip6-scale --nLmas=4 --nMns=20000 --lmaSelection=hash --serviceTime=0.0005 --handoverRate=0"
+ * ./waf --run "pmip6-scale --dataPlane=1 --nMns=100 --packetSize=40 --packetInterval=0.02 --backhaulRate=2Mbps --compression=1"
+ * mpirun -np 4 build/src/pmip6/examples/pmip6-scale --distributed=1 --nMags=64 --nLmas=4 --nMns=50000
+ * mpirun -np 2 build/src/pmip6/examples/pmip6-scale --distributed=1 --check=1 --nMags=8 --nLmas=4 --nMns=200
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/pmip6-module.h"
+#include "ns3/mpi-interface.h"
+
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/rng-stream.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simple-channel.h"
+#include "ns3/ipv6-static-routing-helper.h"
+#include "ns3/sgi-hashmap.h"
+
+#include <sys/resource.h>
+
+#ifdef NS3_MPI
+#include <mpi.h>
+#endif
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("Pmip6Scale");
+
+using namespace ns3;
+
+class Pmip6Scale
+{
+public:
+  Pmip6Scale ();
+
+  void Configure (int argc, char *argv[]);
+  void Build (void);
+  void Run (void);
+  void Reduce (void);
+  void Report (void);
+  bool Check (void);
+
+private:
+  /* What a partitioned run must reproduce of the sequential one */
+  struct Summary
+  {
+    uint64_t attach;
+    uint64_t pbu;
+    uint64_t pba;
+    uint64_t registered;
+    Time lastRegistration;
+    std::vector<uint32_t> lmaBindings;
+    std::vector<double> percentiles;  //!< p50, p90, p99 and max latency, in seconds
+  };
+
+  struct MobileNode
+  {
+    Identifier mnId;
+    Mac48Address mac;
+    Ipv6Address hnp;
+    int32_t mag;              //!< current MAG, -1 before the first attachment
+    int32_t pendingMag;       //!< MAG waiting for the PBA, -1 if none
+    bool prepared;            //!< context pushed to the next MAG
+    int32_t firstMag;         //!< MAG of the first attachment
+    bool registered;          //!< first registration completed
+    Time attachTime;
+    std::map<uint32_t, Mac48Address> links; //!< MAG access device, per MAG
+  };
+
+  static Mac48Address GetMacAddress (uint32_t mn);
+  static Mac48Address GetLinkAddress (uint32_t link, uint32_t end);
+  static Ipv6Address GetPoolBase (uint32_t lma);
+  static Ipv6Address GetHomeNetworkPrefix (uint32_t lma, uint32_t index);
+  static bool IsMobilityMessage (Ptr<const Packet> packet, uint8_t type, Ptr<Packet> &message);
+
+  Mac48Address GetAccessDevice (uint32_t mn, uint32_t mag);
+  void Attach (uint32_t mn, uint32_t mag);
+  void Handover (uint32_t mn);
+  void ReplayAttach (Mac48Address mac, uint32_t mag);
+
+  void LmaRx (Ptr<const Packet> packet, Ptr<Ipv6> ipv6, uint32_t interface);
+  static void MagRx (std::pair<Pmip6Scale *, uint32_t> ctx, Ptr<const Packet> packet, Ptr<Ipv6> ipv6, uint32_t interface);
+  void HandlePba (uint32_t mag, Ptr<Packet> message);
+  bool IsLocalMag (uint32_t mag) const;
+  void RunReference (void);
+  Summary Summarize (void);
+  static void Print (std::ostream &os, const Summary &summary);
+
+  uint32_t m_nMags;
+  uint32_t m_nLmas;
+  uint32_t m_nMns;
+  double m_handoverRate;
+  double m_duration;
+  bool m_dataPlane;
+  double m_packetInterval;
+  uint32_t m_packetSize;
+  uint32_t m_run;
+  std::string m_trace;
+  bool m_bulk;
+  uint32_t m_lifetime;
+  bool m_fastHandover;
+  double m_hiLead;
+  std::string m_lmaSelection;
+  double m_serviceTime;
+  uint32_t m_maxQueue;
+  uint32_t m_redirect;
+  double m_attachSpread;
+  bool m_distributed;
+  bool m_check;
+  std::string m_backhaulRate;
+  bool m_compression;
+  uint32_t m_rank;
+  uint32_t m_nRanks;
+
+  Ptr<Node> m_core;
+  NodeContainer m_lmas;
+  NodeContainer m_mags;
+  NodeContainer m_mns;
+  std::vector<Ipv6Address> m_lmaAddresses;
+  std::vector<Ipv6Address> m_magAddresses;
+  std::vector<Mac48Address> m_magAccess;  //!< signaling only: access device of each MAG
+  std::vector<MobileNode> m_mobileNodes;
+  ApplicationContainer m_servers;
+  Pmip6ProfileHelper m_profile;
+  Ptr<Pmipv6AttachmentReplay> m_replay;
+  Ptr<Pmipv6LmaPool> m_pool;
+
+  sgi::hash_map<Identifier, uint32_t, IdentifierHash> m_mnIndex;
+
+  UniformVariable m_uniform;
+  ExponentialVariable m_holdingTime;
+
+  uint64_t m_nAttach;
+  uint64_t m_nPbu;
+  uint64_t m_nPba;
+  uint64_t m_nPrepared;     //!< attachments served before the PBA
+  uint64_t m_nPacketsSent;
+  uint64_t m_nRegistered;   //!< first registrations completed
+  Time m_lastRegistration;
+  std::vector<double> m_latencies;   //!< in seconds
+  std::vector<uint32_t> m_lmaBindings;
+  std::vector<uint32_t> m_lmaRedirected;
+  std::vector<uint64_t> m_lmaDropped;
+
+  uint64_t m_buildMs;
+  uint64_t m_runMs;
+  uint64_t m_nEvents;
+  long m_peakRss;           //!< in kilobytes
+  Summary m_reference;      //!< of the sequential run, with --check
+};
+
+Pmip6Scale::Pmip6Scale ()
+  : m_nMags (4),
+    m_nLmas (2),
+    m_nMns (32),
+    m_handoverRate (0.1),
+    m_duration (20.0),
+    m_dataPlane (false),
+    m_packetInterval (0.1),
+    m_packetSize (512),
+    m_run (1),
+    m_bulk (false),
+    m_lifetime (Ipv6MobilityL4Protocol::MAX_BINDING_LIFETIME),
+    m_fastHandover (false),
+    m_hiLead (0.05),
+    m_lmaSelection ("static"),
+    m_serviceTime (0),
+    m_maxQueue (1000),
+    m_redirect (0),
+    m_attachSpread (1.0),
+    m_distributed (false),
+    m_check (false),
+    m_backhaulRate ("1Gbps"),
+    m_compression (false),
+    m_rank (0),
+    m_nRanks (1),
+    m_nAttach (0),
+    m_nPbu (0),
+    m_nPba (0),
+    m_nPrepared (0),
+    m_nPacketsSent (0),
+    m_nRegistered (0),
+    m_buildMs (0),
+    m_runMs (0),
+    m_nEvents (0),
+    m_peakRss (0)
+{
+}
+
+void
+Pmip6Scale::Configure (int argc, char *argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue ("nMags", "Number of MAGs", m_nMags);
+  cmd.AddValue ("nLmas", "Number of LMAs", m_nLmas);
+  cmd.AddValue ("nMns", "Number of mobile nodes", m_nMns);
+  cmd.AddValue ("handoverRate", "Handovers per MN and per second", m_handoverRate);
+  cmd.AddValue ("duration", "Simulated time in seconds", m_duration);
+  cmd.AddValue ("dataPlane", "Simulate MN nodes and downlink traffic", m_dataPlane);
+  cmd.AddValue ("packetInterval", "Data plane: seconds between packets of each flow", m_packetInterval);
+  cmd.AddValue ("packetSize", "Data plane: UDP payload size", m_packetSize);
+  cmd.AddValue ("run", "Run number of the random streams", m_run);
+  cmd.AddValue ("trace", "Replay the attachments of this trace (signaling only)", m_trace);
+  cmd.AddValue ("bulk", "Refresh the bindings of each MAG with bulk PBUs", m_bulk);
+  cmd.AddValue ("lifetime", "Binding lifetime requested by the MAGs, in seconds", m_lifetime);
+  cmd.AddValue ("fastHandover", "Push the MN context to the next MAG before each handover (RFC 5949)", m_fastHandover);
+  cmd.AddValue ("hiLead", "Fast handover: seconds between the HI and the attachment", m_hiLead);
+  cmd.AddValue ("lmaSelection", "LMA of the MNs: static, hash or load", m_lmaSelection);
+  cmd.AddValue ("serviceTime", "PBU processing time of the LMAs, in seconds (0: none)", m_serviceTime);
+  cmd.AddValue ("maxQueue", "Signaling queue length of the LMAs", m_maxQueue);
+  cmd.AddValue ("redirect", "Bindings from which an LMA redirects new registrations (0: never)", m_redirect);
+  cmd.AddValue ("attachSpread", "Seconds over which the first attachments are spread", m_attachSpread);
+  cmd.AddValue ("distributed", "Split the domain over the ranks of an MPI run", m_distributed);
+  cmd.AddValue ("check", "Distributed: compare with a sequential run of the scenario", m_check);
+  cmd.AddValue ("backhaulRate", "Data rate of the links of the MAGs to the core", m_backhaulRate);
+  cmd.AddValue ("compression", "Compress the inner header of the tunneled packets", m_compression);
+  cmd.Parse (argc, argv);
+
+#ifndef NS3_MPI
+  NS_ABORT_MSG_IF (m_distributed, "Distributed runs need ns-3 configured with --enable-mpi");
+#endif
+
+  NS_ABORT_MSG_IF (m_nMags == 0 || m_nLmas == 0 || m_nMns == 0, "Need at least one MAG, LMA and MN");
+  NS_ABORT_MSG_IF (m_nLmas > 255, "At most 255 LMAs");
+  NS_ABORT_MSG_IF (m_nMns / m_nLmas >= 0xffffffff, "At most 2^32 - 2 MNs per LMA");
+  NS_ABORT_MSG_IF (m_dataPlane && !m_trace.empty (), "Attachment traces are replayed without data plane");
+  NS_ABORT_MSG_IF (m_nMags + m_nLmas > 0xffff, "Too many agents");
+  NS_ABORT_MSG_IF (m_fastHandover && !m_trace.empty (), "Traces do not announce the handovers");
+  NS_ABORT_MSG_IF (m_lmaSelection != "static" && m_lmaSelection != "hash" && m_lmaSelection != "load",
+                   "Unknown LMA selection " << m_lmaSelection);
+  NS_ABORT_MSG_IF (m_dataPlane && m_lmaSelection != "static", "The data plane needs the prefixes before the first attachment");
+  NS_ABORT_MSG_IF (m_redirect && m_lmaSelection == "static", "Redirection needs an LMA pool");
+  //the ranks neither share the MN nodes nor the loads of the LMA pool
+  NS_ABORT_MSG_IF (m_distributed && (m_dataPlane || !m_trace.empty () || m_fastHandover),
+                   "Distributed runs simulate the signaling of generated attachments only");
+  NS_ABORT_MSG_IF (m_distributed && (m_lmaSelection == "load" || m_redirect),
+                   "Distributed runs need the LMA selection of every rank to agree: static or hash");
+  NS_ABORT_MSG_IF (m_check && !m_distributed, "Only distributed runs are checked against a sequential one");
+
+  SeedManager::SetRun (m_run);
+
+  if (m_compression)
+    {
+      Config::SetDefault ("ns3::TunnelNetDevice::HeaderCompression", BooleanValue (true));
+    }
+
+  if (m_handoverRate > 0)
+    {
+      m_holdingTime = ExponentialVariable (1.0 / m_handoverRate);
+    }
+
+  //before MPI and the distributed simulator are enabled
+  if (m_check)
+    {
+      RunReference ();
+    }
+
+#ifdef NS3_MPI
+  if (m_distributed)
+    {
+      MpiInterface::Enable (&argc, &argv);
+      GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DistributedSimulatorImpl"));
+
+      m_rank = MpiInterface::GetSystemId ();
+      m_nRanks = MpiInterface::GetSize ();
+    }
+#endif
+}
+
+/* The same scenario, run sequentially in this process for --check */
+void
+Pmip6Scale::RunReference (void)
+{
+  Pmip6Scale reference (*this);
+
+  reference.m_distributed = false;
+  reference.m_check = false;
+  //the helper would share its profiles with this run
+  reference.m_profile = Pmip6ProfileHelper ();
+
+  reference.Build ();
+  reference.Run ();
+  reference.Reduce ();
+  m_reference = reference.Summarize ();
+
+  Simulator::Destroy ();
+
+  //the partitioned run draws the same random streams
+  RngStream::SetPackageSeed (SeedManager::GetSeed ());
+}
+
+Mac48Address
+Pmip6Scale::GetMacAddress (uint32_t mn)
+{
+  //locally administered, out of the way of Mac48Address::Allocate
+  uint8_t buf[6] = { 0x02, 0x00, (uint8_t)(mn >> 24), (uint8_t)(mn >> 16), (uint8_t)(mn >> 8), (uint8_t)mn };
+  Mac48Address mac;
+
+  mac.CopyFrom (buf);
+
+  return mac;
+}
+
+/* End (0: core) of the link of the core to LMA or MAG i */
+Mac48Address
+Pmip6Scale::GetLinkAddress (uint32_t link, uint32_t end)
+{
+  uint8_t buf[6] = { 0x02, (uint8_t)(1 + end), 0x00, 0x00, (uint8_t)(link >> 8), (uint8_t)link };
+  Mac48Address mac;
+
+  mac.CopyFrom (buf);
+
+  return mac;
+}
+
+/* LMA l hands out the /64s of 3ffe:1ll::/32 */
+Ipv6Address
+Pmip6Scale::GetPoolBase (uint32_t lma)
+{
+  return GetHomeNetworkPrefix (lma, 0);
+}
+
+Ipv6Address
+Pmip6Scale::GetHomeNetworkPrefix (uint32_t lma, uint32_t index)
+{
+  uint8_t buf[16] = { 0x3f, 0xfe, 0x01, (uint8_t)lma,
+                      (uint8_t)(index >> 24), (uint8_t)(index >> 16), (uint8_t)(index >> 8), (uint8_t)index };
+
+  return Ipv6Address (buf);
+}
+
+void
+Pmip6Scale::Build (void)
+{
+  SystemWallClockMs clock;
+  clock.Start ();
+
+  Pmip6PartitionHelper partition;
+
+  partition.SetNRanks (m_nRanks);
+
+  m_core = CreateObject<Node> ();
+  m_lmas = partition.CreateLmas (m_nLmas);
+  m_mags = partition.CreateMags (m_nMags);
+
+  InternetStackHelper internet;
+  internet.Install (m_core);
+  internet.Install (m_lmas);
+  internet.Install (m_mags);
+
+  //nodes of the other ranks, before their interfaces come up
+  partition.SilenceRemoteNodes (NodeContainer (NodeContainer (m_core), m_lmas, m_mags));
+
+  PointToPointHelper backbone;
+  backbone.SetDeviceAttribute ("DataRate", StringValue ("1Gbps"));
+  backbone.SetChannelAttribute ("Delay", StringValue ("1ms"));
+
+  PointToPointHelper backhaul;
+  backhaul.SetDeviceAttribute ("DataRate", StringValue (m_backhaulRate));
+  backhaul.SetChannelAttribute ("Delay", StringValue ("1ms"));
+
+  Ipv6AddressHelper address;
+  Ipv6StaticRoutingHelper routingHelper;
+  Ptr<Ipv6StaticRouting> coreRouting = routingHelper.GetStaticRouting (m_core->GetObject<Ipv6> ());
+
+  NodeContainer edges (m_lmas, m_mags);
+
+  for (uint32_t i = 0; i < edges.GetN (); i++)
+    {
+      uint8_t buf[16] = { 0x3f, 0xfe, 0x00, 0x02, (uint8_t)(i >> 8), (uint8_t)i };
+
+      NetDeviceContainer devs = (i < m_nLmas ? backbone : backhaul).Install (m_core, edges.Get (i));
+
+      //the LMA addresses, hence the hash ring of the LMA pool, must not
+      //depend on what Mac48Address::Allocate gave out before (--check)
+      devs.Get (0)->SetAddress (GetLinkAddress (i, 0));
+      devs.Get (1)->SetAddress (GetLinkAddress (i, 1));
+
+      address.NewNetwork (Ipv6Address (buf), Ipv6Prefix (64));
+      Ipv6InterfaceContainer ifs = address.Assign (devs);
+
+      //core forwards, and is the default router of the agent
+      ifs.SetRouter (0, true);
+      edges.Get (i)->GetObject<Ipv6> ()->SetForwarding (ifs.GetInterfaceIndex (1), true);
+
+      if (i < m_nLmas)
+        {
+          m_lmaAddresses.push_back (ifs.GetAddress (1, 1));
+
+          coreRouting->AddNetworkRouteTo (GetPoolBase (i), Ipv6Prefix (32), ifs.GetAddress (1, 1), ifs.GetInterfaceIndex (0));
+        }
+      else
+        {
+          m_magAddresses.push_back (ifs.GetAddress (1, 1));
+        }
+    }
+
+  //profiles
+  if (m_lmaSelection != "static")
+    {
+      m_pool = CreateObject<Pmipv6LmaPool> ();
+      m_pool->SetSelection (m_lmaSelection == "hash" ? Pmipv6LmaPool::CONSISTENT_HASH : Pmipv6LmaPool::LEAST_LOADED);
+
+      for (uint32_t l = 0; l < m_nLmas; l++)
+        {
+          m_pool->AddLma (m_lmaAddresses[l]);
+        }
+
+      m_profile.SetLmaPool (m_pool);
+    }
+
+  if (m_dataPlane)
+    {
+      m_mns.Create (m_nMns);
+      internet.Install (m_mns);
+    }
+
+  m_mobileNodes.resize (m_nMns);
+
+  for (uint32_t k = 0; k < m_nMns; k++)
+    {
+      MobileNode &mn = m_mobileNodes[k];
+      std::ostringstream oss;
+      std::list<Ipv6Address> hnps;
+
+      oss << "mn" << k << "@pmip6.scale";
+
+      mn.mnId = Identifier (oss.str ().c_str ());
+      mn.mac = GetMacAddress (k);
+      mn.mag = -1;
+      mn.pendingMag = -1;
+      mn.prepared = false;
+      mn.firstMag = -1;
+      mn.registered = false;
+
+      if (m_pool)
+        {
+          //the LMA of the pool allocates the prefix, learnt from the PBA
+          m_profile.AddProfile (mn.mnId, Identifier (mn.mac), hnps);
+        }
+      else
+        {
+          mn.hnp = GetHomeNetworkPrefix (k % m_nLmas, k / m_nLmas + 1);
+          hnps.push_back (mn.hnp);
+          m_profile.AddProfile (mn.mnId, Identifier (mn.mac), m_lmaAddresses[k % m_nLmas], hnps);
+        }
+
+      m_mnIndex[mn.mnId] = k;
+    }
+
+  //agents
+  for (uint32_t l = 0; l < m_nLmas; l++)
+    {
+      Pmip6LmaHelper lmaHelper;
+
+      lmaHelper.SetPrefixPoolBase (GetPoolBase (l), 32);
+      lmaHelper.SetProfileHelper (&m_profile);
+      lmaHelper.SetRedirectThreshold (m_redirect);
+
+      if (m_serviceTime > 0)
+        {
+          lmaHelper.SetProcessing (Seconds (m_serviceTime), 1, m_maxQueue);
+        }
+
+      lmaHelper.Install (m_lmas.Get (l));
+
+      m_lmas.Get (l)->GetObject<Ipv6L3Protocol> ()->TraceConnectWithoutContext ("Rx", MakeCallback (&Pmip6Scale::LmaRx, this));
+    }
+
+  Pmip6MagHelper magHelper;
+
+  magHelper.SetProfileHelper (&m_profile);
+  magHelper.SetBulkRegistration (m_bulk);
+  magHelper.SetBindingLifetime (m_lifetime);
+  magHelper.SetFastHandover (m_fastHandover);
+
+  for (uint32_t j = 0; j < m_nMags; j++)
+    {
+      Ptr<Node> mag = m_mags.Get (j);
+
+      //no access point: attachments are notified by Attach
+      magHelper.Install (mag, Ipv6Address::GetAny (), NodeContainer ());
+
+      mag->GetObject<Ipv6L3Protocol> ()->TraceConnectWithoutContext ("Rx", MakeBoundCallback (&Pmip6Scale::MagRx, std::make_pair (this, j)));
+
+      if (!m_dataPlane)
+        {
+          //a single access device going nowhere
+          Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice> ();
+          Mac48Address mac = Mac48Address::Allocate ();
+
+          dev->SetAddress (mac);
+          dev->SetChannel (CreateObject<SimpleChannel> ());
+          mag->AddDevice (dev);
+
+          Ptr<Ipv6> ipv6 = mag->GetObject<Ipv6> ();
+          uint32_t ifIndex = ipv6->AddInterface (dev);
+
+          ipv6->SetUp (ifIndex);
+          ipv6->SetForwarding (ifIndex, true);
+
+          m_magAccess.push_back (mac);
+        }
+    }
+
+  //downlink flows from the core
+  if (m_dataPlane)
+    {
+      Udp6ServerHelper server (9);
+
+      m_servers = server.Install (m_mns);
+      m_servers.Start (Seconds (1.0));
+
+      for (uint32_t k = 0; k < m_nMns; k++)
+        {
+          Ipv6Address dst = Ipv6Address::MakeAutoconfiguredAddress (m_mobileNodes[k].mac, m_mobileNodes[k].hnp);
+          Udp6ClientHelper client (dst, 9);
+
+          client.SetAttribute ("Interval", TimeValue (Seconds (m_packetInterval)));
+          client.SetAttribute ("PacketSize", UintegerValue (m_packetSize));
+          client.SetAttribute ("MaxPackets", UintegerValue (0xffffffff));
+
+          //give the first attachments time to complete
+          ApplicationContainer apps = client.Install (m_core);
+          apps.Start (Seconds (4.0 + m_uniform.GetValue (0, m_packetInterval)));
+        }
+
+      if (m_duration > 4.0)
+        {
+          m_nPacketsSent = (uint64_t)(m_nMns * (m_duration - 4.0) / m_packetInterval);
+        }
+    }
+
+  if (!m_trace.empty ())
+    {
+      m_replay = CreateObject<Pmipv6AttachmentReplay> ();
+
+      for (uint32_t j = 0; j < m_nMags; j++)
+        {
+          m_replay->AddMag (m_mags.Get (j), m_magAccess[j]);
+        }
+
+      m_replay->TraceConnectWithoutContext ("Attach", MakeCallback (&Pmip6Scale::ReplayAttach, this));
+
+      NS_ABORT_MSG_IF (!m_replay->Open (m_trace), "Cannot read " << m_trace);
+    }
+  else
+    {
+      //first attachments, spread once the MAG advertisements started
+      for (uint32_t k = 0; k < m_nMns; k++)
+        {
+          Simulator::Schedule (Seconds (1.0 + m_uniform.GetValue (0, m_attachSpread)), &Pmip6Scale::Attach, this, k, k % m_nMags);
+        }
+    }
+
+  m_buildMs = clock.End ();
+}
+
+Mac48Address
+Pmip6Scale::GetAccessDevice (uint32_t mn, uint32_t mag)
+{
+  if (!m_dataPlane)
+    {
+      return m_magAccess[mag];
+    }
+
+  MobileNode &node = m_mobileNodes[mn];
+  std::map<uint32_t, Mac48Address>::iterator it = node.links.find (mag);
+
+  if (it != node.links.end ())
+    {
+      return it->second;
+    }
+
+  //first visit at this MAG, bring up the access link
+  PointToPointHelper access;
+  access.SetDeviceAttribute ("DataRate", StringValue ("100Mbps"));
+  access.SetChannelAttribute ("Delay", StringValue ("1ms"));
+
+  NetDeviceContainer devs = access.Install (m_mags.Get (mag), m_mns.Get (mn));
+
+  //the same MAC on every link, so that the MN keeps its address
+  devs.Get (1)->SetAddress (node.mac);
+
+  for (uint32_t i = 0; i < devs.GetN (); i++)
+    {
+      Ptr<Ipv6> ipv6 = devs.Get (i)->GetNode ()->GetObject<Ipv6> ();
+      uint32_t ifIndex = ipv6->AddInterface (devs.Get (i));
+
+      ipv6->SetUp (ifIndex);
+      ipv6->SetForwarding (ifIndex, i == 0);
+    }
+
+  Mac48Address mac = Mac48Address::ConvertFrom (devs.Get (0)->GetAddress ());
+
+  node.links[mag] = mac;
+
+  return mac;
+}
+
+void
+Pmip6Scale::Attach (uint32_t mn, uint32_t mag)
+{
+  MobileNode &node = m_mobileNodes[mn];
+
+  if (node.firstMag < 0)
+    {
+      node.firstMag = mag;
+    }
+
+  node.mag = mag;
+  node.pendingMag = mag;
+  node.attachTime = Simulator::Now ();
+
+  //the mobility of every MN is drawn on every rank, in the same order
+  if (IsLocalMag (mag))
+    {
+      Mac48Address to = GetAccessDevice (mn, mag);
+
+      m_nAttach++;
+      m_mags.Get (mag)->GetObject<Pmipv6MagNotifier> ()->NotifyNewNode (node.mac, to, Ipv6MobilityHeader::OPT_ATT_IEEE_802_11ABG);
+    }
+
+  //a prepared MAG routes the prefix as soon as the MN attaches
+  if (node.prepared)
+    {
+      Pmipv6PrefixRoutingHelper routingHelper;
+      Ptr<Pmipv6PrefixRouting> routing = routingHelper.GetPrefixRouting (m_mags.Get (mag)->GetObject<Ipv6> ());
+
+      if (routing->LookupPrefix (node.hnp) >= 0)
+        {
+          m_latencies.push_back (0);
+          node.pendingMag = -1;
+          m_nPrepared++;
+        }
+
+      node.prepared = false;
+    }
+
+  if (m_handoverRate > 0)
+    {
+      Simulator::Schedule (Seconds (m_holdingTime.GetValue ()), &Pmip6Scale::Handover, this, mn);
+    }
+}
+
+void
+Pmip6Scale::Handover (uint32_t mn)
+{
+  uint32_t mag = m_mobileNodes[mn].mag;
+
+  //move to a neighbour on the ring
+  if (m_uniform.GetValue () < 0.5)
+    {
+      mag = (mag + 1) % m_nMags;
+    }
+  else
+    {
+      mag = (mag + m_nMags - 1) % m_nMags;
+    }
+
+  if (m_fastHandover)
+    {
+      MobileNode &node = m_mobileNodes[mn];
+
+      //the previous MAG sees the handover coming
+      node.prepared = m_mags.Get (node.mag)->GetObject<Pmipv6Mag> ()->PrepareHandover (node.mac, m_magAddresses[mag]);
+
+      Simulator::Schedule (Seconds (m_hiLead), &Pmip6Scale::Attach, this, mn, mag);
+
+      return;
+    }
+
+  Attach (mn, mag);
+}
+
+void
+Pmip6Scale::ReplayAttach (Mac48Address mac, uint32_t mag)
+{
+  uint8_t buf[6];
+
+  mac.CopyTo (buf);
+
+  uint32_t mn = (buf[2] << 24) | (buf[3] << 16) | (buf[4] << 8) | buf[5];
+
+  if (buf[0] != 0x02 || buf[1] != 0x00 || mn >= m_nMns)
+    {
+      return;
+    }
+
+  MobileNode &node = m_mobileNodes[mn];
+
+  node.mag = mag;
+  node.pendingMag = mag;
+  node.attachTime = Simulator::Now ();
+  m_nAttach++;
+}
+
+bool
+Pmip6Scale::IsLocalMag (uint32_t mag) const
+{
+  return Pmip6PartitionHelper::IsLocal (m_mags.Get (mag));
+}
+
+bool
+Pmip6Scale::IsMobilityMessage (Ptr<const Packet> packet, uint8_t type, Ptr<Packet> &message)
+{
+  Ipv6Header ipHeader;
+
+  packet->PeekHeader (ipHeader);
+
+  if (ipHeader.GetNextHeader () != Ipv6MobilityL4Protocol::PROT_NUMBER)
+    {
+      return false;
+    }
+
+  message = packet->Copy ();
+  message->RemoveHeader (ipHeader);
+
+  Ipv6MobilityHeader mh;
+
+  message->PeekHeader (mh);
+
+  return mh.GetMhType () == type;
+}
+
+void
+Pmip6Scale::LmaRx (Ptr<const Packet> packet, Ptr<Ipv6> ipv6, uint32_t interface)
+{
+  Ptr<Packet> message;
+
+  if (IsMobilityMessage (packet, Ipv6MobilityHeader::IPV6_MOBILITY_BINDING_UPDATE, message))
+    {
+      m_nPbu++;
+    }
+}
+
+void
+Pmip6Scale::MagRx (std::pair<Pmip6Scale *, uint32_t> ctx, Ptr<const Packet> packet, Ptr<Ipv6> ipv6, uint32_t interface)
+{
+  Ptr<Packet> message;
+
+  if (IsMobilityMessage (packet, Ipv6MobilityHeader::IPV6_MOBILITY_BINDING_ACKNOWLEDGEMENT, message))
+    {
+      ctx.first->HandlePba (ctx.second, message);
+    }
+}
+
+void
+Pmip6Scale::HandlePba (uint32_t mag, Ptr<Packet> message)
+{
+  m_nPba++;
+
+  Ipv6MobilityBindingAckHeader pba;
+  Ipv6MobilityOptionBundle bundle;
+
+  message->PeekHeader (pba);
+
+  if (pba.GetStatus () != Ipv6MobilityHeader::BA_STATUS_BINDING_UPDATE_ACCEPTED)
+    {
+      return;
+    }
+
+  Ptr<Ipv6Mobility> mobility = m_mags.Get (mag)->GetObject<Ipv6MobilityDemux> ()->GetMobility (pba.GetMhType ());
+  uint8_t length = ((pba.GetHeaderLen () + 1) << 3) - pba.GetOptionsOffset ();
+
+  mobility->ProcessOptions (message, pba.GetOptionsOffset (), length, bundle);
+
+  sgi::hash_map<Identifier, uint32_t, IdentifierHash>::iterator it = m_mnIndex.find (bundle.GetMnIdentifier ());
+
+  if (it == m_mnIndex.end ())
+    {
+      return;
+    }
+
+  MobileNode &node = m_mobileNodes[it->second];
+
+  if (node.hnp.IsAny () && !bundle.GetHomeNetworkPrefixes ().empty ())
+    {
+      node.hnp = bundle.GetHomeNetworkPrefixes ().front ();
+    }
+
+  //registered by its first MAG, which only the rank of that MAG sees
+  if (!node.registered && node.firstMag == (int32_t)mag)
+    {
+      node.registered = true;
+      m_nRegistered++;
+      m_lastRegistration = Simulator::Now ();
+    }
+
+  if (node.pendingMag == (int32_t)mag)
+    {
+      m_latencies.push_back ((Simulator::Now () - node.attachTime).GetSeconds ());
+      node.pendingMag = -1;
+    }
+}
+
+static void
+Noop (void)
+{
+}
+
+void
+Pmip6Scale::Run (void)
+{
+  Simulator::Stop (Seconds (m_duration));
+
+  //event uids are allocated in sequence, the difference is the number
+  //of events scheduled in between
+  uint32_t firstUid = Simulator::Schedule (Seconds (0.0), &Noop).GetUid ();
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  m_runMs = clock.End ();
+
+  m_nEvents = Simulator::Schedule (Seconds (0.0), &Noop).GetUid () - firstUid - 1;
+}
+
+void
+Pmip6Scale::Reduce (void)
+{
+  struct rusage usage;
+
+  getrusage (RUSAGE_SELF, &usage);
+  m_peakRss = usage.ru_maxrss;
+
+  m_lmaBindings.assign (m_nLmas, 0);
+  m_lmaRedirected.assign (m_nLmas, 0);
+  m_lmaDropped.assign (m_nLmas, 0);
+
+  for (uint32_t l = 0; l < m_nLmas; l++)
+    {
+      Ptr<Pmipv6Lma> lma = m_lmas.Get (l)->GetObject<Pmipv6Lma> ();
+
+      //no agent on the LMAs of the other ranks
+      if (lma == 0)
+        {
+          continue;
+        }
+
+      m_lmaBindings[l] = lma->GetNBindings ();
+      m_lmaRedirected[l] = lma->GetNRedirected ();
+
+      if (lma->GetProcessor ())
+        {
+          m_lmaDropped[l] = lma->GetProcessor ()->GetStatistics ().dropped;
+        }
+    }
+
+#ifdef NS3_MPI
+  if (!m_distributed)
+    {
+      return;
+    }
+
+  uint64_t counters[8] = { m_nAttach, m_nPbu, m_nPba, m_nPrepared, m_nRegistered, m_nEvents, 0, 0 };
+  uint64_t sums[8];
+
+  MPI_Allreduce (counters, sums, 8, MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+
+  m_nAttach = sums[0];
+  m_nPbu = sums[1];
+  m_nPba = sums[2];
+  m_nPrepared = sums[3];
+  m_nRegistered = sums[4];
+  m_nEvents = sums[5];
+
+  //the slowest rank sets the wall-clock time
+  uint64_t maxima[3] = { m_runMs, m_buildMs, (uint64_t)m_lastRegistration.GetTimeStep () };
+  uint64_t results[3];
+
+  MPI_Allreduce (maxima, results, 3, MPI_UNSIGNED_LONG_LONG, MPI_MAX, MPI_COMM_WORLD);
+
+  m_runMs = results[0];
+  m_buildMs = results[1];
+  m_lastRegistration = TimeStep (results[2]);
+
+  long rss = m_peakRss;
+
+  MPI_Allreduce (&rss, &m_peakRss, 1, MPI_LONG, MPI_MAX, MPI_COMM_WORLD);
+
+  std::vector<uint32_t> bindings (m_nLmas);
+  std::vector<uint32_t> redirected (m_nLmas);
+  std::vector<uint64_t> dropped (m_nLmas);
+
+  MPI_Allreduce (&m_lmaBindings[0], &bindings[0], m_nLmas, MPI_UNSIGNED, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce (&m_lmaRedirected[0], &redirected[0], m_nLmas, MPI_UNSIGNED, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce (&m_lmaDropped[0], &dropped[0], m_nLmas, MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+
+  m_lmaBindings = bindings;
+  m_lmaRedirected = redirected;
+  m_lmaDropped = dropped;
+
+  //all the latencies, for the percentiles
+  int count = m_latencies.size ();
+  std::vector<int> counts (m_nRanks);
+  std::vector<int> offsets (m_nRanks, 0);
+
+  MPI_Allgather (&count, 1, MPI_INT, &counts[0], 1, MPI_INT, MPI_COMM_WORLD);
+
+  for (uint32_t r = 1; r < m_nRanks; r++)
+    {
+      offsets[r] = offsets[r - 1] + counts[r - 1];
+    }
+
+  std::vector<double> latencies (offsets[m_nRanks - 1] + counts[m_nRanks - 1]);
+
+  MPI_Allgatherv (m_latencies.empty () ? 0 : &m_latencies[0], count, MPI_DOUBLE,
+                  latencies.empty () ? 0 : &latencies[0], &counts[0], &offsets[0], MPI_DOUBLE, MPI_COMM_WORLD);
+
+  m_latencies.swap (latencies);
+#endif
+}
+
+static double
+Percentile (const std::vector<double> &sorted, double p)
+{
+  if (sorted.empty ())
+    {
+      return 0;
+    }
+
+  uint32_t index = (uint32_t)(p * (sorted.size () - 1) + 0.5);
+
+  return sorted[index];
+}
+
+void
+Pmip6Scale::Report (void)
+{
+  double seconds = std::max (m_runMs, (uint64_t)1) / 1000.0;
+
+  if (m_rank != 0)
+    {
+      return;
+    }
+
+  std::sort (m_latencies.begin (), m_latencies.end ());
+
+  std::cout << "pmip6-scale mags=" << m_nMags << " lmas=" << m_nLmas << " mns=" << m_nMns
+            << " handoverRate=" << m_handoverRate << " duration=" << m_duration
+            << " mode=" << (m_dataPlane ? "data-plane" : (m_trace.empty () ? "signaling" : "trace"))
+            << " lifetime=" << m_lifetime << (m_bulk ? " bulk" : "")
+            << (m_fastHandover ? " fast-handover" : "")
+            << " lmaSelection=" << m_lmaSelection << " serviceTime=" << m_serviceTime
+            << " redirect=" << m_redirect;
+
+  if (m_dataPlane)
+    {
+      std::cout << " backhaulRate=" << m_backhaulRate << (m_compression ? " compression" : "");
+    }
+
+  if (m_distributed)
+    {
+      std::cout << " ranks=" << m_nRanks;
+    }
+
+  std::cout << std::endl;
+
+  std::cout << "build=" << m_buildMs << " ms" << std::endl;
+  std::cout << "run=" << m_runMs << " ms" << std::endl;
+  std::cout << "events=" << m_nEvents << " (" << m_nEvents / seconds << " events/s)" << std::endl;
+  std::cout << "attach=" << m_nAttach << " completed=" << m_latencies.size ();
+
+  if (m_fastHandover)
+    {
+      std::cout << " prepared=" << m_nPrepared;
+    }
+
+  std::cout << std::endl;
+  std::cout << "pbu=" << m_nPbu << " (" << m_nPbu / seconds << " pbu/s)" << std::endl;
+  std::cout << "pba=" << m_nPba << " (" << m_nPba / seconds << " pba/s)" << std::endl;
+
+  //binding capacity: first registrations per simulated second, from
+  //the first attachment to the last registration
+  double span = m_lastRegistration.GetSeconds () - 1.0;
+
+  std::cout << "registered=" << m_nRegistered << " last=" << m_lastRegistration.GetSeconds () << " s"
+            << " (" << (span > 0 ? m_nRegistered / span : 0) << " registrations/s)" << std::endl;
+
+  uint32_t minBindings = 0xffffffff;
+  uint32_t maxBindings = 0;
+  uint32_t redirected = 0;
+  uint64_t dropped = 0;
+
+  for (uint32_t l = 0; l < m_nLmas; l++)
+    {
+      minBindings = std::min (minBindings, m_lmaBindings[l]);
+      maxBindings = std::max (maxBindings, m_lmaBindings[l]);
+      redirected += m_lmaRedirected[l];
+      dropped += m_lmaDropped[l];
+    }
+
+  std::cout << "lma-bindings min=" << minBindings << " max=" << maxBindings
+            << " redirected=" << redirected << " dropped=" << dropped << std::endl;
+
+  //ru_maxrss is in kilobytes on Linux
+  std::cout << "peak-rss=" << m_peakRss / 1024.0 << " MB" << std::endl;
+
+  std::cout << "handover-latency(ms) p50=" << Percentile (m_latencies, 0.50) * 1000
+            << " p90=" << Percentile (m_latencies, 0.90) * 1000
+            << " p99=" << Percentile (m_latencies, 0.99) * 1000
+            << " max=" << (m_latencies.empty () ? 0 : m_latencies.back () * 1000) << std::endl;
+
+  if (m_dataPlane)
+    {
+      uint64_t received = 0;
+
+      for (uint32_t i = 0; i < m_servers.GetN (); i++)
+        {
+          received += DynamicCast<Udp6Server> (m_servers.Get (i))->GetReceived ();
+        }
+
+      std::cout << "packets offered=" << m_nPacketsSent << " received=" << received << std::endl;
+
+      //UDP payload delivered to the MNs, once the flows started
+      double goodput = m_duration > 4.0 ? received * m_packetSize * 8 / (m_duration - 4.0) : 0;
+
+      std::cout << "goodput=" << goodput / 1000 << " kbps" << std::endl;
+    }
+
+  if (m_replay)
+    {
+      std::cout << "trace attach=" << m_replay->GetNAttachments ()
+                << " detach=" << m_replay->GetNDetachments ()
+                << " errors=" << m_replay->GetNErrors () << std::endl;
+    }
+}
+
+Pmip6Scale::Summary
+Pmip6Scale::Summarize (void)
+{
+  Summary summary;
+
+  std::sort (m_latencies.begin (), m_latencies.end ());
+
+  summary.attach = m_nAttach;
+  summary.pbu = m_nPbu;
+  summary.pba = m_nPba;
+  summary.registered = m_nRegistered;
+  summary.lastRegistration = m_lastRegistration;
+  summary.lmaBindings = m_lmaBindings;
+  summary.percentiles.push_back (Percentile (m_latencies, 0.50));
+  summary.percentiles.push_back (Percentile (m_latencies, 0.90));
+  summary.percentiles.push_back (Percentile (m_latencies, 0.99));
+  summary.percentiles.push_back (m_latencies.empty () ? 0 : m_latencies.back ());
+
+  return summary;
+}
+
+void
+Pmip6Scale::Print (std::ostream &os, const Summary &summary)
+{
+  os << "attach=" << summary.attach << " pbu=" << summary.pbu << " pba=" << summary.pba
+     << " registered=" << summary.registered << " last=" << summary.lastRegistration.GetSeconds () << " s"
+     << " lma-bindings=";
+
+  for (uint32_t l = 0; l < summary.lmaBindings.size (); l++)
+    {
+      os << (l ? "," : "") << summary.lmaBindings[l];
+    }
+
+  os << " latency(ms)=";
+
+  for (uint32_t i = 0; i < summary.percentiles.size (); i++)
+    {
+      os << (i ? "," : "") << summary.percentiles[i] * 1000;
+    }
+}
+
+/* Compares the reduced results of the partitioned run with the sequential ones */
+bool
+Pmip6Scale::Check (void)
+{
+  if (!m_check)
+    {
+      return true;
+    }
+
+  Summary summary = Summarize ();
+  bool same = summary.attach == m_reference.attach
+    && summary.pbu == m_reference.pbu
+    && summary.pba == m_reference.pba
+    && summary.registered == m_reference.registered
+    && summary.lastRegistration == m_reference.lastRegistration
+    && summary.lmaBindings == m_reference.lmaBindings
+    && summary.percentiles == m_reference.percentiles;
+
+  if (m_rank == 0)
+    {
+      std::cout << "check sequential  ";
+      Print (std::cout, m_reference);
+      std::cout << std::endl << "check partitioned ";
+      Print (std::cout, summary);
+      std::cout << std::endl << "check " << (same ? "passed" : "FAILED") << std::endl;
+    }
+
+  return same;
+}
+
+int
+main (int argc, char *argv[])
+{
+  Pmip6Scale scale;
+
+  scale.Configure (argc, argv);
+  scale.Build ();
+  scale.Run ();
+  scale.Reduce ();
+  scale.Report ();
+
+  bool checked = scale.Check ();
+
+  Simulator::Destroy ();
+
+  if (MpiInterface::IsEnabled ())
+    {
+      MpiInterface::Disable ();
+    }
+
+  return checked ? 0 : 1;
+}
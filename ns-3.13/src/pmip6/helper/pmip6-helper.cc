@@ -52,8 +52,10 @@
 
 #include "ns3/ipv6-list-routing.h"
 #include "ns3/ipv6-static-source-routing.h"
+#include "ns3/pmipv6-prefix-routing.h"
 
 #include "pmip6-helper.h"
+#include "pmip6-partition-helper.h"
 #include <limits>
 #include <map>
 
@@ -64,7 +66,15 @@ namespace ns3 {
 Pmip6LmaHelper::Pmip6LmaHelper()
  : m_profile(0),
    m_prefixBegin("3ffe:1:4::"),
-   m_prefixBeginLen(48)
+   m_prefixBeginLen(48),
+   m_quarantine(Seconds (0.0)),
+   m_localizedRouting(false),
+   m_serviceTime(Seconds (0.0)),
+   m_servers(1),
+   m_maxQueue(1000),
+   m_priority(Pmipv6Processor::FIFO),
+   m_dropPolicy(Pmipv6Processor::DROP_TAIL),
+   m_redirectThreshold(0)
 {
 }
 
@@ -75,6 +85,12 @@ Pmip6LmaHelper::~Pmip6LmaHelper()
 void
 Pmip6LmaHelper::Install (Ptr<Node> node) const
 {
+  if (!Pmip6PartitionHelper::IsLocal (node))
+    {
+      NS_LOG_LOGIC ("Node " << node->GetId () << " is simulated by rank " << node->GetSystemId ());
+      return;
+    }
+
   Ptr<Ipv6MobilityL4Protocol> mipv6 = node->GetObject<Ipv6MobilityL4Protocol>();
 
   if(mipv6 == 0)
@@ -109,7 +125,49 @@ Pmip6LmaHelper::Install (Ptr<Node> node) const
 	  lma->SetProfile (CreateObject<Pmipv6Profile> ());
 	}  
 	
-  lma->SetPrefixPool (Create<Pmipv6PrefixPool> (m_prefixBegin, m_prefixBeginLen));
+  Ptr<Pmipv6PrefixPool> pool = Create<Pmipv6PrefixPool> (m_prefixBegin, m_prefixBeginLen);
+  
+  pool->SetQuarantine (m_quarantine);
+  lma->SetPrefixPool (pool);
+  lma->SetLocalizedRouting (m_localizedRouting);
+  lma->SetRedirectThreshold (m_redirectThreshold);
+  
+  if (m_serviceTime > Seconds (0.0))
+    {
+      Ptr<Pmipv6Processor> processor = CreateObject<Pmipv6Processor> ();
+      
+      processor->SetDefaultServiceTime (m_serviceTime);
+      processor->SetNServers (m_servers);
+      processor->SetMaxQueueLength (m_maxQueue);
+      processor->SetPriorityPolicy (m_priority);
+      processor->SetDropPolicy (m_dropPolicy);
+      lma->SetProcessor (processor);
+    }
+  
+  for (std::list<std::pair<Ipv6Address, uint8_t> >::const_iterator i = m_extraPools.begin (); i != m_extraPools.end (); i++)
+    {
+      pool = Create<Pmipv6PrefixPool> (i->first, i->second);
+      pool->SetQuarantine (m_quarantine);
+      lma->AddPrefixPool (pool);
+    }
+  
+  //Attach home network prefix routing
+  Ptr<Ipv6> ipv6 = node->GetObject<Ipv6>();
+  
+  NS_ASSERT_MSG(ipv6, "Install Internet-stack first before installing PMIPv6-related agents");
+  
+  Ptr<Ipv6ListRouting> listRouting = DynamicCast<Ipv6ListRouting>(ipv6->GetRoutingProtocol());
+  
+  if (listRouting)
+    {
+      Ptr<Pmipv6PrefixRouting> prefixRouting = CreateObject<Pmipv6PrefixRouting>();
+      
+      listRouting->AddRoutingProtocol(prefixRouting, 5); //higher priority than static routing
+    }
+  else
+    {
+      NS_LOG_WARN ("No Ipv6-list-routing protocol, home network prefixes go to static routing");
+    }
   
   node->AggregateObject(lma);
 }
@@ -125,8 +183,45 @@ void Pmip6LmaHelper::SetPrefixPoolBase(Ipv6Address prefixBegin, uint8_t prefixLe
   m_prefixBeginLen = prefixLen;
 }
 
+void Pmip6LmaHelper::AddPrefixPool(Ipv6Address prefixBegin, uint8_t prefixLen)
+{
+  m_extraPools.push_back (std::make_pair (prefixBegin, prefixLen));
+}
+
+void Pmip6LmaHelper::SetPrefixPoolQuarantine(Time quarantine)
+{
+  m_quarantine = quarantine;
+}
+
+void Pmip6LmaHelper::SetLocalizedRouting(bool enable)
+{
+  m_localizedRouting = enable;
+}
+
+void Pmip6LmaHelper::SetProcessing(Time serviceTime, uint32_t nServers, uint32_t maxQueue,
+                                   Pmipv6Processor::PriorityPolicy_e priority,
+                                   Pmipv6Processor::DropPolicy_e policy)
+{
+  m_serviceTime = serviceTime;
+  m_servers = nServers;
+  m_maxQueue = maxQueue;
+  m_priority = priority;
+  m_dropPolicy = policy;
+}
+
+void Pmip6LmaHelper::SetRedirectThreshold(uint32_t maxBindings)
+{
+  m_redirectThreshold = maxBindings;
+}
+
 Pmip6MagHelper::Pmip6MagHelper()
-: m_profile(0)
+: m_profile(0),
+  m_bulk(false),
+  m_lifetime(Ipv6MobilityL4Protocol::MAX_BINDING_LIFETIME),
+  m_fastHandover(false),
+  m_bufferPackets(0),
+  m_bufferBytes(1 << 20),
+  m_bufferPolicy(Pmipv6HandoverBuffer::DROP_TAIL)
 {
 }
 
@@ -137,6 +232,12 @@ Pmip6MagHelper::~Pmip6MagHelper()
 void
 Pmip6MagHelper::Install (Ptr<Node> node) const
 {
+  if (!Pmip6PartitionHelper::IsLocal (node))
+    {
+      NS_LOG_LOGIC ("Node " << node->GetId () << " is simulated by rank " << node->GetSystemId ());
+      return;
+    }
+
   Ptr<Ipv6MobilityL4Protocol> mipv6 = node->GetObject<Ipv6MobilityL4Protocol>();
 
   if(mipv6 == 0)
@@ -172,8 +273,10 @@ Pmip6MagHelper::Install (Ptr<Node> node) const
     {
 	  mag->SetProfile(CreateObject<Pmipv6Profile>());
 	}
+  
+  Configure (mag);
 	
-  //Attach static source routing
+  //Attach static source routing and home network prefix routing
   Ptr<Ipv6> ipv6 = node->GetObject<Ipv6>();
   
   NS_ASSERT_MSG(ipv6, "Install Internet-stack first before installing PMIPv6-related agents");
@@ -186,6 +289,10 @@ Pmip6MagHelper::Install (Ptr<Node> node) const
   Ptr<Ipv6StaticSourceRouting> sourceRouting = CreateObject<Ipv6StaticSourceRouting>();
   
   listRouting->AddRoutingProtocol(sourceRouting, 10); //higher priority than static routing
+  
+  Ptr<Pmipv6PrefixRouting> prefixRouting = CreateObject<Pmipv6PrefixRouting>();
+  
+  listRouting->AddRoutingProtocol(prefixRouting, 5); //after source routing, before static routing
 	
   node->AggregateObject(mag);
 }
@@ -193,6 +300,12 @@ Pmip6MagHelper::Install (Ptr<Node> node) const
 void
 Pmip6MagHelper::Install (Ptr<Node> node, Ipv6Address target, NodeContainer aps) const
 {
+  if (!Pmip6PartitionHelper::IsLocal (node))
+    {
+      NS_LOG_LOGIC ("Node " << node->GetId () << " is simulated by rank " << node->GetSystemId ());
+      return;
+    }
+
   Ptr<Ipv6MobilityL4Protocol> mipv6 = node->GetObject<Ipv6MobilityL4Protocol>();
 
   if(mipv6 == 0)
@@ -223,6 +336,11 @@ Pmip6MagHelper::Install (Ptr<Node> node, Ipv6Address target, NodeContainer aps)
   //setup notifier sender
   for (NodeContainer::Iterator i = aps.Begin (); i != aps.End (); ++i)
     {
+      if (!Pmip6PartitionHelper::IsLocal (*i))
+        {
+          continue;
+        }
+
 	  noti = CreateObject<Pmipv6MagNotifier>();
 	  
 	  noti->SetTargetAddress(target);
@@ -243,8 +361,10 @@ Pmip6MagHelper::Install (Ptr<Node> node, Ipv6Address target, NodeContainer aps)
     {
 	  mag->SetProfile(CreateObject<Pmipv6Profile>());
 	}
+  
+  Configure (mag);
 
-  //Attach static source routing
+  //Attach static source routing and home network prefix routing
   Ptr<Ipv6> ipv6 = node->GetObject<Ipv6>();
   
   NS_ASSERT_MSG(ipv6, "Install Internet-stack first before installing PMIPv6-related agents");
@@ -258,6 +378,10 @@ Pmip6MagHelper::Install (Ptr<Node> node, Ipv6Address target, NodeContainer aps)
   
   listRouting->AddRoutingProtocol(sourceRouting, 10); //higher priority than static routing
   
+  Ptr<Pmipv6PrefixRouting> prefixRouting = CreateObject<Pmipv6PrefixRouting>();
+  
+  listRouting->AddRoutingProtocol(prefixRouting, 5); //after source routing, before static routing
+  
   node->AggregateObject(mag);
   
 }
@@ -268,6 +392,47 @@ Pmip6MagHelper::SetProfileHelper(Pmip6ProfileHelper *pf)
   m_profile = pf;
 }
 
+void
+Pmip6MagHelper::SetBulkRegistration(bool bulk)
+{
+  m_bulk = bulk;
+}
+
+void
+Pmip6MagHelper::SetBindingLifetime(uint16_t lifetime)
+{
+  m_lifetime = lifetime;
+}
+
+void
+Pmip6MagHelper::SetFastHandover(bool fast)
+{
+  m_fastHandover = fast;
+}
+
+void
+Pmip6MagHelper::SetHandoverBuffering(uint32_t maxPackets, uint32_t maxBytes, Pmipv6HandoverBuffer::DropPolicy_e policy)
+{
+  m_bufferPackets = maxPackets;
+  m_bufferBytes = maxBytes;
+  m_bufferPolicy = policy;
+}
+
+void
+Pmip6MagHelper::Configure (Ptr<Pmipv6Mag> mag) const
+{
+  mag->SetBulkRegistration(m_bulk);
+  mag->SetBindingLifetime(m_lifetime);
+  mag->SetFastHandover(m_fastHandover);
+  mag->SetHandoverBuffering(m_bufferPackets > 0);
+  
+  Ptr<Pmipv6HandoverBuffer> buffer = mag->GetHandoverBuffer();
+  
+  buffer->SetMaxPackets(m_bufferPackets);
+  buffer->SetMaxBytes(m_bufferBytes);
+  buffer->SetDropPolicy(m_bufferPolicy);
+}
+
 Pmip6ProfileHelper::Pmip6ProfileHelper()
 {
   m_profile = CreateObject<Pmipv6Profile>();
@@ -301,4 +466,19 @@ void Pmip6ProfileHelper::AddProfile(Identifier mnId, Identifier mnLinkId, Ipv6Ad
   entry->SetHomeNetworkPrefixes(hnps);
 }
 
+void Pmip6ProfileHelper::AddProfile(Identifier mnId, Identifier mnLinkId, std::list<Ipv6Address> hnps)
+{
+  AddProfile(mnId, mnLinkId, Ipv6Address::GetAny(), hnps);
+}
+
+void Pmip6ProfileHelper::SetLmaPool(Ptr<Pmipv6LmaPool> pool)
+{
+  m_profile->SetLmaPool(pool);
+}
+
+Ptr<Pmipv6LmaPool> Pmip6ProfileHelper::GetLmaPool()
+{
+  return m_profile->GetLmaPool();
+}
+
 } // namespace ns3
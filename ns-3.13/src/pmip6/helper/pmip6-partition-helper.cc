@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/icmpv6-l4-protocol.h"
+
+#include "pmip6-partition-helper.h"
+
+NS_LOG_COMPONENT_DEFINE ("Pmip6PartitionHelper");
+
+namespace ns3 {
+
+Pmip6PartitionHelper::Pmip6PartitionHelper ()
+  : m_nRanks (1),
+    m_clusterSize (0)
+{
+}
+
+void
+Pmip6PartitionHelper::SetNRanks (uint32_t nRanks)
+{
+  NS_ASSERT (nRanks > 0);
+
+  m_nRanks = nRanks;
+}
+
+uint32_t
+Pmip6PartitionHelper::GetNRanks () const
+{
+  return m_nRanks;
+}
+
+void
+Pmip6PartitionHelper::SetMagClusterSize (uint32_t nMags)
+{
+  m_clusterSize = nMags;
+}
+
+uint32_t
+Pmip6PartitionHelper::GetRank (uint32_t index, uint32_t n) const
+{
+  NS_ASSERT (index < n);
+
+  //contiguous blocks, as even as the count allows
+  return (uint32_t)(((uint64_t)index * m_nRanks) / n);
+}
+
+uint32_t
+Pmip6PartitionHelper::GetLmaRank (uint32_t lma, uint32_t nLmas) const
+{
+  return GetRank (lma, nLmas);
+}
+
+uint32_t
+Pmip6PartitionHelper::GetMagRank (uint32_t mag, uint32_t nMags) const
+{
+  if (m_clusterSize == 0)
+    {
+      return GetRank (mag, nMags);
+    }
+
+  uint32_t nClusters = (nMags + m_clusterSize - 1) / m_clusterSize;
+
+  return GetRank (mag / m_clusterSize, nClusters);
+}
+
+NodeContainer
+Pmip6PartitionHelper::CreateLmas (uint32_t nLmas) const
+{
+  NodeContainer c;
+
+  for (uint32_t i = 0; i < nLmas; i++)
+    {
+      c.Add (CreateObject<Node> (GetLmaRank (i, nLmas)));
+    }
+
+  return c;
+}
+
+NodeContainer
+Pmip6PartitionHelper::CreateMags (uint32_t nMags) const
+{
+  NodeContainer c;
+
+  for (uint32_t i = 0; i < nMags; i++)
+    {
+      c.Add (CreateObject<Node> (GetMagRank (i, nMags)));
+    }
+
+  return c;
+}
+
+bool
+Pmip6PartitionHelper::IsLocal (Ptr<Node> node)
+{
+  return node->GetSystemId () == Simulator::GetSystemId ();
+}
+
+void
+Pmip6PartitionHelper::SilenceRemoteNodes (NodeContainer c)
+{
+  for (NodeContainer::Iterator i = c.Begin (); i != c.End (); i++)
+    {
+      if (IsLocal (*i))
+        {
+          continue;
+        }
+
+      Ptr<Icmpv6L4Protocol> icmpv6 = (*i)->GetObject<Icmpv6L4Protocol> ();
+
+      NS_ASSERT_MSG (icmpv6, "Install the Internet stack first");
+
+      icmpv6->SetAttribute ("DAD", BooleanValue (false));
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,266 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/ipv6-mobility-header.h"
+#include "ns3/pmipv6-mag.h"
+#include "ns3/pmipv6-lma.h"
+
+#include "pmip6-stats-helper.h"
+
+NS_LOG_COMPONENT_DEFINE ("Pmip6StatsHelper");
+
+namespace ns3 {
+
+static const char *g_stageNames[Pmip6StatsHelper::N_STAGES] =
+{
+  "pbu-latency", "pba-latency", "tunnel-latency", "handover-latency"
+};
+
+static const char *g_counterNames[Pmip6StatsHelper::N_COUNTERS] =
+{
+  "attach", "detach", "tx-pbu", "retransmit-pbu", "rx-pba", "tx-ra", "lma-rx-pbu", "lma-tx-pba"
+};
+
+Pmip6StatsHelper::Pmip6StatsHelper ()
+{
+  for (uint32_t i = 0; i < N_STAGES; i++)
+    {
+      m_latencies[i] = CreateObject<MinMaxAvgTotalCalculator<double> > ();
+      m_latencies[i]->SetContext ("pmip6");
+      m_latencies[i]->SetKey (g_stageNames[i]);
+    }
+
+  for (uint32_t i = 0; i < N_COUNTERS; i++)
+    {
+      m_counters[i] = CreateObject<CounterCalculator<> > ();
+      m_counters[i]->SetContext ("pmip6");
+      m_counters[i]->SetKey (g_counterNames[i]);
+    }
+}
+
+void
+Pmip6StatsHelper::Install (Ptr<Node> node)
+{
+  NS_LOG_FUNCTION (this << node);
+
+  Ptr<Pmipv6Mag> mag = node->GetObject<Pmipv6Mag> ();
+
+  if (mag)
+    {
+      mag->TraceConnectWithoutContext ("Attach", MakeCallback (&Pmip6StatsHelper::Attach, this));
+      mag->TraceConnectWithoutContext ("Detach", MakeCallback (&Pmip6StatsHelper::Detach, this));
+      mag->TraceConnectWithoutContext ("TxPbu", MakeCallback (&Pmip6StatsHelper::TxPbu, this));
+      mag->TraceConnectWithoutContext ("RetransmitPbu", MakeCallback (&Pmip6StatsHelper::RetransmitPbu, this));
+      mag->TraceConnectWithoutContext ("RxPba", MakeCallback (&Pmip6StatsHelper::RxPba, this));
+      mag->TraceConnectWithoutContext ("TunnelUp", MakeCallback (&Pmip6StatsHelper::TunnelUp, this));
+      mag->TraceConnectWithoutContext ("TxRa", MakeCallback (&Pmip6StatsHelper::TxRa, this));
+    }
+
+  Ptr<Pmipv6Lma> lma = node->GetObject<Pmipv6Lma> ();
+
+  if (lma)
+    {
+      lma->TraceConnectWithoutContext ("RxPbu", MakeCallback (&Pmip6StatsHelper::LmaRxPbu, this));
+      lma->TraceConnectWithoutContext ("TxPba", MakeCallback (&Pmip6StatsHelper::LmaTxPba, this));
+    }
+}
+
+void
+Pmip6StatsHelper::Install (NodeContainer c)
+{
+  for (NodeContainer::Iterator i = c.Begin (); i != c.End (); i++)
+    {
+      Install (*i);
+    }
+}
+
+Ptr<MinMaxAvgTotalCalculator<double> >
+Pmip6StatsHelper::GetLatency (Stage_e stage) const
+{
+  NS_ASSERT (stage < N_STAGES);
+
+  return m_latencies[stage];
+}
+
+Ptr<CounterCalculator<> >
+Pmip6StatsHelper::GetCounter (Counter_e counter) const
+{
+  NS_ASSERT (counter < N_COUNTERS);
+
+  return m_counters[counter];
+}
+
+std::vector<double>
+Pmip6StatsHelper::GetHandoverLatencies (const Identifier &mnId) const
+{
+  Latencies::const_iterator it = m_mnLatencies.find (mnId);
+
+  if (it == m_mnLatencies.end ())
+    {
+      return std::vector<double> ();
+    }
+
+  return it->second;
+}
+
+void
+Pmip6StatsHelper::AddDataCalculators (Ptr<DataCollector> collector) const
+{
+  for (uint32_t i = 0; i < N_STAGES; i++)
+    {
+      collector->AddDataCalculator (m_latencies[i]);
+    }
+
+  for (uint32_t i = 0; i < N_COUNTERS; i++)
+    {
+      collector->AddDataCalculator (m_counters[i]);
+    }
+}
+
+void
+Pmip6StatsHelper::Print (std::ostream &os) const
+{
+  for (uint32_t i = 0; i < N_STAGES; i++)
+    {
+      os << g_stageNames[i] << ": count " << m_latencies[i]->getCount ();
+
+      if (m_latencies[i]->getCount () > 0)
+        {
+          os << " min " << m_latencies[i]->getMin ()
+             << " mean " << m_latencies[i]->getMean ()
+             << " max " << m_latencies[i]->getMax ()
+             << " stddev " << m_latencies[i]->getStddev ();
+        }
+
+      os << " (ms)" << std::endl;
+    }
+
+  for (uint32_t i = 0; i < N_COUNTERS; i++)
+    {
+      os << g_counterNames[i] << ": " << m_counters[i]->GetCount () << std::endl;
+    }
+}
+
+void
+Pmip6StatsHelper::Stage (const Identifier &mnId, Stage_e stage)
+{
+  Handovers::iterator it = m_handovers.find (mnId);
+
+  //refreshes, or a stage already passed
+  if (it == m_handovers.end () || it->second.done[stage])
+    {
+      return;
+    }
+
+  double latency = (Simulator::Now () - it->second.attach).GetSeconds () * 1000.0;
+
+  NS_LOG_LOGIC (mnId << " " << g_stageNames[stage] << " " << latency << "ms");
+
+  it->second.done[stage] = true;
+  m_latencies[stage]->Update (latency);
+
+  if (stage == STAGE_RA)
+    {
+      m_mnLatencies[mnId].push_back (latency);
+      m_handovers.erase (it);
+    }
+}
+
+void
+Pmip6StatsHelper::Attach (const Identifier &mnId, Mac48Address mn)
+{
+  m_counters[COUNTER_ATTACH]->Update ();
+
+  Handover &handover = m_handovers[mnId];
+
+  handover.attach = Simulator::Now ();
+
+  for (uint32_t i = 0; i < N_STAGES; i++)
+    {
+      handover.done[i] = false;
+    }
+}
+
+void
+Pmip6StatsHelper::Detach (const Identifier &mnId, Mac48Address mn)
+{
+  m_counters[COUNTER_DETACH]->Update ();
+
+  //an uncompleted handover is not measured
+  m_handovers.erase (mnId);
+}
+
+void
+Pmip6StatsHelper::TxPbu (const Identifier &mnId, uint16_t sequence)
+{
+  m_counters[COUNTER_TX_PBU]->Update ();
+
+  Stage (mnId, STAGE_PBU);
+}
+
+void
+Pmip6StatsHelper::RetransmitPbu (const Identifier &mnId, uint16_t sequence)
+{
+  m_counters[COUNTER_RETRANSMIT_PBU]->Update ();
+}
+
+void
+Pmip6StatsHelper::RxPba (const Identifier &mnId, uint8_t status)
+{
+  m_counters[COUNTER_RX_PBA]->Update ();
+
+  if (status < Ipv6MobilityHeader::BA_STATUS_REASON_UNSPECIFIED)
+    {
+      Stage (mnId, STAGE_PBA);
+    }
+}
+
+void
+Pmip6StatsHelper::TunnelUp (const Identifier &mnId, uint32_t ifIndex)
+{
+  Stage (mnId, STAGE_TUNNEL);
+}
+
+void
+Pmip6StatsHelper::TxRa (const Identifier &mnId)
+{
+  m_counters[COUNTER_TX_RA]->Update ();
+
+  Stage (mnId, STAGE_RA);
+}
+
+void
+Pmip6StatsHelper::LmaRxPbu (const Identifier &mnId, uint16_t sequence)
+{
+  m_counters[COUNTER_LMA_RX_PBU]->Update ();
+}
+
+void
+Pmip6StatsHelper::LmaTxPba (const Identifier &mnId, uint8_t status)
+{
+  m_counters[COUNTER_LMA_TX_PBA]->Update ();
+}
+
+} // namespace ns3
@@ -0,0 +1,90 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef PMIPV6_PREFIX_ROUTING_HELPER_H
+#define PMIPV6_PREFIX_ROUTING_HELPER_H
+
+#include "ns3/ipv6.h"
+#include "ns3/ptr.h"
+#include "ns3/node.h"
+#include "ns3/ipv6-routing-helper.h"
+
+#include "ns3/pmipv6-prefix-routing.h"
+
+namespace ns3 {
+
+/**
+ * \brief Helper class that adds ns3::Pmipv6PrefixRouting objects
+ *
+ * This class is expected to be used in conjunction with 
+ * ns3::Ipv6ListRoutingHelper; Pmip6LmaHelper and Pmip6MagHelper insert
+ * the protocol themselves.
+ */
+class Pmipv6PrefixRoutingHelper : public Ipv6RoutingHelper
+{
+public:
+  /**
+   * \brief Constructor.
+   */
+  Pmipv6PrefixRoutingHelper ();
+
+  /**
+   * \brief Construct a Pmipv6PrefixRoutingHelper from another previously 
+   * initialized instance (Copy Constructor).
+   */
+  Pmipv6PrefixRoutingHelper (const Pmipv6PrefixRoutingHelper &);
+
+  /**
+   * \internal
+   * \returns pointer to clone of this Pmipv6PrefixRoutingHelper
+   *
+   * This method is mainly for internal use by the other helpers;
+   * clients are expected to free the dynamic memory allocated by this method
+   */
+  Pmipv6PrefixRoutingHelper* Copy (void) const;
+
+  /**
+   * \param node the node on which the routing protocol will run
+   * \returns a newly-created routing protocol
+   */
+  virtual Ptr<Ipv6RoutingProtocol> Create (Ptr<Node> node) const;
+
+  /**
+   * \brief Get Pmipv6PrefixRouting pointer from IPv6 stack.
+   * \param ipv6 Ipv6 pointer
+   * \return Pmipv6PrefixRouting pointer or 0 if not exist
+   */
+  Ptr<Pmipv6PrefixRouting> GetPrefixRouting (Ptr<Ipv6> ipv6) const;
+
+private:
+  /**
+   * \internal
+   * \brief Assignment operator declared private and not implemented to disallow
+   * assignment and prevent the compiler from happily inserting its own.
+   */
+  Pmipv6PrefixRoutingHelper &operator = (const Pmipv6PrefixRoutingHelper &o);
+};
+
+} // namespace ns3
+
+#endif /* PMIPV6_PREFIX_ROUTING_HELPER_H */
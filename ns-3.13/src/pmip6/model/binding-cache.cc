@@ -52,6 +52,7 @@ TypeId BindingCache::GetTypeId ()
 } 
 
 BindingCache::BindingCache ()
+  : m_nEntries (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -73,54 +74,71 @@ BindingCache::Entry *BindingCache::Lookup(Identifier mnId, std::list<Ipv6Address
 {
   NS_LOG_FUNCTION (this << mnId);
   
-  if ( m_bCache.find (mnId) != m_bCache.end ())
+  BindingCache::Entry *partial = 0;
+  bool matchtemp;
+  
+  allMatched = false;
+  
+  for (std::list<Ipv6Address>::const_iterator i = hnpList.begin (); i != hnpList.end (); i++)
     {
-      BindingCache::Entry* entry = m_bCache[mnId];
-	  
-	  BindingCache::Entry* partial = 0;
-	  bool matchtemp;
-	  
-	  while ( entry )
-	    {
-		  matchtemp = false;
-		  if( entry->Match(mnId, hnpList, matchtemp) )
-		    {
-			  if ( matchtemp )
-			    {
-				  allMatched = true;
-				  return entry;
-				}
-			  
-			  if(partial == 0)
-			    {
-			      partial = entry;
-				}
-			}
-		  entry = entry->GetNext();
-		}
-		
-	  allMatched = false;
-	  return partial;
+      BCacheAddrIndexI it = m_hnpIndex.find (*i);
+      
+      if (it == m_hnpIndex.end ())
+        {
+          continue;
+        }
+      
+      BindingCache::Entry *entry = it->second;
+      
+      if (entry->GetMnIdentifier () != mnId)
+        {
+          continue;
+        }
+      
+      matchtemp = false;
+      if (entry->Match (mnId, hnpList, matchtemp))
+        {
+          if (matchtemp)
+            {
+              allMatched = true;
+              return entry;
+            }
+          
+          if (partial == 0)
+            {
+              partial = entry;
+            }
+        }
     }
-  return 0;
+  
+  return partial;
 }
 
 BindingCache::Entry *BindingCache::Lookup(Identifier mnId, uint8_t att, Identifier mnLinkId)
 {
   NS_LOG_FUNCTION (this << mnId << mnLinkId);
   
-  if ( m_bCache.find (mnId) != m_bCache.end ())
+  BCacheI it = m_mnLinkIndex.find (mnLinkId);
+  
+  if (it != m_mnLinkIndex.end () && it->second->GetMnIdentifier () == mnId &&
+      it->second->Match (mnId, att, mnLinkId))
     {
-      BindingCache::Entry* entry = m_bCache[mnId];
-	  
-	  while ( entry )
-	    {
-		  if( entry->Match(mnId, att, mnLinkId) )
-		    {
-			  return entry;
-			}
-		  entry = entry->GetNext();
-		}
+      return it->second;
+    }
+  
+  // the link-id index keeps one entry per identifier; the same
+  // link-layer id over another access technology lives on the MN chain.
+  it = m_bCache.find (mnId);
+  
+  if (it != m_bCache.end ())
+    {
+      for (BindingCache::Entry *entry = it->second; entry; entry = entry->GetNext ())
+        {
+          if (entry->Match (mnId, att, mnLinkId))
+            {
+              return entry;
+            }
+        }
     }
   return 0;
 }
@@ -129,11 +147,50 @@ BindingCache::Entry *BindingCache::Lookup(Identifier mnId)
 {
   NS_LOG_FUNCTION (this << mnId );
   
-  if ( m_bCache.find (mnId) != m_bCache.end ())
+  BCacheI it = m_bCache.find (mnId);
+  
+  if (it != m_bCache.end ())
     {
-      BindingCache::Entry* entry = m_bCache[mnId];
-	  
-	  return entry;
+      return it->second;
+    }
+  return 0;
+}
+
+BindingCache::Entry *BindingCache::LookupByHomeNetworkPrefix(Ipv6Address hnp)
+{
+  NS_LOG_FUNCTION (this << hnp);
+  
+  BCacheAddrIndexI it = m_hnpIndex.find (hnp);
+  
+  if (it != m_hnpIndex.end ())
+    {
+      return it->second;
+    }
+  return 0;
+}
+
+BindingCache::Entry *BindingCache::LookupByMnLinkIdentifier(Identifier mnLinkId)
+{
+  NS_LOG_FUNCTION (this << mnLinkId);
+  
+  BCacheI it = m_mnLinkIndex.find (mnLinkId);
+  
+  if (it != m_mnLinkIndex.end ())
+    {
+      return it->second;
+    }
+  return 0;
+}
+
+BindingCache::Entry *BindingCache::LookupByProxyCoa(Ipv6Address pcoa)
+{
+  NS_LOG_FUNCTION (this << pcoa);
+  
+  BCacheAddrIndexI it = m_proxyCoaIndex.find (pcoa);
+  
+  if (it != m_proxyCoaIndex.end ())
+    {
+      return it->second;
     }
   return 0;
 }
@@ -146,31 +203,62 @@ BindingCache::Entry* BindingCache::Add (Identifier mnId)
   
   entry->SetMnIdentifier(mnId);
   
-  if( m_bCache.find (mnId) != m_bCache.end ())
+  BCacheI it = m_bCache.find (mnId);
+  
+  if (it != m_bCache.end ())
     {
-	  BindingCache::Entry* entry2 = m_bCache[mnId];
-	  
-	  entry->SetNext(entry2);
-	}
-
-  m_bCache[mnId] = entry;
+      entry->m_next = it->second;
+      it->second->m_prev = entry;
+      it->second = entry;
+    }
+  else
+    {
+      m_bCache[mnId] = entry;
+    }
+  
+  entry->m_linked = true;
+  m_nEntries++;
   
   return entry;
 }
 
 void BindingCache::Remove (BindingCache::Entry* entry)
 {
-  NS_LOG_FUNCTION_NOARGS ();
+  NS_LOG_FUNCTION (this << entry);
+  NS_ASSERT (entry->m_linked);
 
-  for (BCacheI i = m_bCache.begin () ; i != m_bCache.end () ; i++)
+  UnlinkPrefixes (entry);
+  UnlinkMnLinkIdentifier (entry);
+  UnlinkProxyCoa (entry);
+  
+  if (entry->m_prev)
+    {
+      entry->m_prev->m_next = entry->m_next;
+    }
+  else
     {
-      if ((*i).second == entry)
+      BCacheI it = m_bCache.find (entry->GetMnIdentifier ());
+      NS_ASSERT (it != m_bCache.end () && it->second == entry);
+      
+      if (entry->m_next)
+        {
+          it->second = entry->m_next;
+        }
+      else
         {
-          m_bCache.erase (i);
-          delete entry;
-          return;
+          m_bCache.erase (it);
         }
     }
+  
+  if (entry->m_next)
+    {
+      entry->m_next->m_prev = entry->m_prev;
+    }
+  
+  m_nEntries--;
+  
+  delete entry->m_tentativeEntry;
+  delete entry;
 }
 
 void BindingCache::Flush ()
@@ -179,10 +267,155 @@ void BindingCache::Flush ()
 
   for (BCacheI i = m_bCache.begin () ; i != m_bCache.end () ; i++)
     {
-      delete (*i).second; /* delete the pointer BindingCache::Entry */
+      BindingCache::Entry *entry = (*i).second;
+      
+      while (entry)
+        {
+          BindingCache::Entry *next = entry->m_next;
+          
+          delete entry->m_tentativeEntry;
+          delete entry; /* delete the pointer BindingCache::Entry */
+          
+          entry = next;
+        }
     }
 
   m_bCache.erase (m_bCache.begin (), m_bCache.end ());
+  m_hnpIndex.erase (m_hnpIndex.begin (), m_hnpIndex.end ());
+  m_mnLinkIndex.erase (m_mnLinkIndex.begin (), m_mnLinkIndex.end ());
+  m_proxyCoaIndex.erase (m_proxyCoaIndex.begin (), m_proxyCoaIndex.end ());
+  
+  m_nEntries = 0;
+}
+
+uint32_t BindingCache::GetNEntries () const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  return m_nEntries;
+}
+
+void BindingCache::LinkPrefixes (BindingCache::Entry *entry)
+{
+  NS_LOG_FUNCTION (this << entry);
+  
+  for (std::list<Ipv6Address>::const_iterator i = entry->m_homeNetworkPrefixes.begin (); i != entry->m_homeNetworkPrefixes.end (); i++)
+    {
+      if ((*i).IsAny ())
+        {
+          continue;
+        }
+      
+      BCacheAddrIndexI it = m_hnpIndex.find (*i);
+      if (it != m_hnpIndex.end () && it->second != entry)
+        {
+          NS_LOG_WARN ("Prefix " << (*i) << " is already bound to " << it->second->GetMnIdentifier ());
+        }
+      
+      m_hnpIndex[*i] = entry;
+    }
+}
+
+void BindingCache::UnlinkPrefixes (BindingCache::Entry *entry)
+{
+  NS_LOG_FUNCTION (this << entry);
+  
+  for (std::list<Ipv6Address>::const_iterator i = entry->m_homeNetworkPrefixes.begin (); i != entry->m_homeNetworkPrefixes.end (); i++)
+    {
+      BCacheAddrIndexI it = m_hnpIndex.find (*i);
+      
+      if (it != m_hnpIndex.end () && it->second == entry)
+        {
+          m_hnpIndex.erase (it);
+        }
+    }
+}
+
+void BindingCache::LinkMnLinkIdentifier (BindingCache::Entry *entry)
+{
+  NS_LOG_FUNCTION (this << entry);
+  
+  if (entry->m_mnLinkIdentifier.IsEmpty ())
+    {
+      return;
+    }
+  
+  m_mnLinkIndex[entry->m_mnLinkIdentifier] = entry;
+}
+
+void BindingCache::UnlinkMnLinkIdentifier (BindingCache::Entry *entry)
+{
+  NS_LOG_FUNCTION (this << entry);
+  
+  BCacheI it = m_mnLinkIndex.find (entry->m_mnLinkIdentifier);
+  
+  if (it != m_mnLinkIndex.end () && it->second == entry)
+    {
+      m_mnLinkIndex.erase (it);
+    }
+}
+
+void BindingCache::LinkProxyCoa (BindingCache::Entry *entry)
+{
+  NS_LOG_FUNCTION (this << entry);
+  
+  if (entry->m_proxyCoa.IsAny ())
+    {
+      return;
+    }
+  
+  BCacheAddrIndexI it = m_proxyCoaIndex.find (entry->m_proxyCoa);
+  
+  entry->m_prevByProxyCoa = 0;
+  
+  if (it != m_proxyCoaIndex.end ())
+    {
+      entry->m_nextByProxyCoa = it->second;
+      it->second->m_prevByProxyCoa = entry;
+      it->second = entry;
+    }
+  else
+    {
+      entry->m_nextByProxyCoa = 0;
+      m_proxyCoaIndex[entry->m_proxyCoa] = entry;
+    }
+}
+
+void BindingCache::UnlinkProxyCoa (BindingCache::Entry *entry)
+{
+  NS_LOG_FUNCTION (this << entry);
+  
+  if (entry->m_proxyCoa.IsAny ())
+    {
+      return;
+    }
+  
+  if (entry->m_prevByProxyCoa)
+    {
+      entry->m_prevByProxyCoa->m_nextByProxyCoa = entry->m_nextByProxyCoa;
+    }
+  else
+    {
+      BCacheAddrIndexI it = m_proxyCoaIndex.find (entry->m_proxyCoa);
+      NS_ASSERT (it != m_proxyCoaIndex.end () && it->second == entry);
+      
+      if (entry->m_nextByProxyCoa)
+        {
+          it->second = entry->m_nextByProxyCoa;
+        }
+      else
+        {
+          m_proxyCoaIndex.erase (it);
+        }
+    }
+  
+  if (entry->m_nextByProxyCoa)
+    {
+      entry->m_nextByProxyCoa->m_prevByProxyCoa = entry->m_prevByProxyCoa;
+    }
+  
+  entry->m_prevByProxyCoa = 0;
+  entry->m_nextByProxyCoa = 0;
 }
 
 Ptr<Node> BindingCache::GetNode() const
@@ -203,11 +436,13 @@ BindingCache::Entry::Entry (Ptr<BindingCache> bcache)
   : m_bCache (bcache),
     m_state (UNREACHABLE),
     m_tunnelIfIndex (-1),
-    m_reachableTimer(Timer::CANCEL_ON_DESTROY),
-	m_deregisterTimer(Timer::CANCEL_ON_DESTROY),
-	m_registerTimer(Timer::CANCEL_ON_DESTROY),
+    m_groupIdentifier (0),
     m_next (0),
-	m_tentativeEntry (0)
+	m_tentativeEntry (0),
+    m_linked (false),
+    m_prev (0),
+    m_prevByProxyCoa (0),
+    m_nextByProxyCoa (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -229,6 +464,7 @@ BindingCache::Entry *BindingCache::Entry::Copy()
   bce->SetLastBindingUpdateTime(this->GetLastBindingUpdateTime());
   bce->SetReachableTime(this->GetReachableTime());
   bce->SetLastBindingUpdateSequence(this->GetLastBindingUpdateSequence());
+  bce->SetGroupIdentifier(this->GetGroupIdentifier());
   
   bce->SetNext(0);
   bce->SetTentativeEntry(0);
@@ -295,15 +531,29 @@ void BindingCache::Entry::MarkReachable()
 void BindingCache::Entry::FunctionReachableTimeout()
 {
   NS_LOG_FUNCTION_NOARGS();
-//  Ptr<Pmipv6Lma> lma = m_bCache->GetNode()->GetObject<Pmipv6Lma>();
+  Ptr<Pmipv6Lma> lma = m_bCache->GetNode()->GetObject<Pmipv6Lma>();
 
+  NS_LOG_LOGIC ("Binding lifetime expired");
+  
+  //deletes this entry
+  lma->DoBindingExpiry(this);
 }
 
 void BindingCache::Entry::FunctionDeregisterTimeout()
 {
   NS_LOG_FUNCTION_NOARGS();
-//  Ptr<Pmipv6Lma> lma = m_bCache->GetNode()->GetObject<Pmipv6Lma>();
+  Ptr<Pmipv6Lma> lma = m_bCache->GetNode()->GetObject<Pmipv6Lma>();
 
+  //registered again in the meantime
+  if (!IsDeregistering())
+    {
+      return;
+    }
+  
+  NS_LOG_LOGIC ("Deregistration delay elapsed");
+  
+  //deletes this entry
+  lma->DoBindingExpiry(this);
 }
 
 void BindingCache::Entry::FunctionRegisterTimeout()
@@ -446,6 +696,12 @@ Identifier BindingCache::Entry::GetMnIdentifier() const
 void BindingCache::Entry::SetMnIdentifier(Identifier mnId)
 {
   NS_LOG_FUNCTION ( this << mnId );
+  NS_ASSERT_MSG (!m_linked || mnId == m_mnIdentifier, "MN identifier of a cached entry cannot change");
+  
+  if (mnId != m_mnIdentifier)
+    {
+      m_pbaTemplate.Clear ();
+    }
   
   m_mnIdentifier = mnId;
 }
@@ -461,7 +717,22 @@ void BindingCache::Entry::SetMnLinkIdentifier(Identifier mnLinkId)
 {
   NS_LOG_FUNCTION ( this << mnLinkId );
   
+  if (mnLinkId != m_mnLinkIdentifier)
+    {
+      m_pbaTemplate.Clear ();
+    }
+  
+  if (m_linked)
+    {
+      m_bCache->UnlinkMnLinkIdentifier (this);
+    }
+  
   m_mnLinkIdentifier = mnLinkId;
+  
+  if (m_linked)
+    {
+      m_bCache->LinkMnLinkIdentifier (this);
+    }
 }
 
 std::list<Ipv6Address> BindingCache::Entry::GetHomeNetworkPrefixes() const
@@ -475,7 +746,22 @@ void BindingCache::Entry::SetHomeNetworkPrefixes(std::list<Ipv6Address> hnpList)
 {
   NS_LOG_FUNCTION_NOARGS ();
   
+  if (hnpList != m_homeNetworkPrefixes)
+    {
+      m_pbaTemplate.Clear ();
+    }
+  
+  if (m_linked)
+    {
+      m_bCache->UnlinkPrefixes (this);
+    }
+  
   m_homeNetworkPrefixes = hnpList;
+  
+  if (m_linked)
+    {
+      m_bCache->LinkPrefixes (this);
+    }
 }
 
 Ipv6Address BindingCache::Entry::GetMagLinkAddress() const
@@ -489,6 +775,11 @@ void BindingCache::Entry::SetMagLinkAddress(Ipv6Address lla)
 {
   NS_LOG_FUNCTION ( this << lla );
   
+  if (lla != m_magLinkAddress)
+    {
+      m_pbaTemplate.Clear ();
+    }
+  
   m_magLinkAddress = lla;
 }
 
@@ -503,8 +794,18 @@ void BindingCache::Entry::SetProxyCoa(Ipv6Address pcoa)
 {
   NS_LOG_FUNCTION ( this << pcoa );
 
+  if (m_linked)
+    {
+      m_bCache->UnlinkProxyCoa (this);
+    }
+
   m_oldProxyCoa = m_proxyCoa;
   m_proxyCoa = pcoa;
+  
+  if (m_linked)
+    {
+      m_bCache->LinkProxyCoa (this);
+    }
 }
 
 int16_t BindingCache::Entry::GetTunnelIfIndex() const
@@ -532,6 +833,11 @@ void BindingCache::Entry::SetAccessTechnologyType(uint8_t att)
 {
   NS_LOG_FUNCTION ( this << (uint32_t) att);
   
+  if (att != m_accessTechnologyType)
+    {
+      m_pbaTemplate.Clear ();
+    }
+  
   m_accessTechnologyType = att;
 }
 
@@ -546,6 +852,11 @@ void BindingCache::Entry::SetHandoffIndicator(uint8_t hi)
 {
   NS_LOG_FUNCTION ( this << (uint32_t) hi);
   
+  if (hi != m_handoffIndicator)
+    {
+      m_pbaTemplate.Clear ();
+    }
+  
   m_handoffIndicator = hi;
 }
 
@@ -591,6 +902,30 @@ void BindingCache::Entry::SetLastBindingUpdateSequence(uint16_t seq)
   m_lastBindingUpdateSequence = seq;
 }
 
+uint32_t BindingCache::Entry::GetGroupIdentifier() const
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  return m_groupIdentifier;
+}
+
+void BindingCache::Entry::SetGroupIdentifier(uint32_t groupId)
+{
+  NS_LOG_FUNCTION( this << groupId);
+  
+  if (groupId != m_groupIdentifier)
+    {
+      m_pbaTemplate.Clear ();
+    }
+  
+  m_groupIdentifier = groupId;
+}
+
+Ipv6MobilityMessageTemplate &BindingCache::Entry::GetPbaTemplate()
+{
+  return m_pbaTemplate;
+}
+
 BindingCache::Entry *BindingCache::Entry::GetNext() const
 {
   NS_LOG_FUNCTION_NOARGS();
@@ -626,4 +961,11 @@ Ipv6Address BindingCache::Entry::GetOldProxyCoa() const
   return m_oldProxyCoa;
 }
 
+BindingCache::Entry *BindingCache::Entry::GetNextByProxyCoa() const
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  return m_nextByProxyCoa;
+}
+
 } /* namespace ns3 */
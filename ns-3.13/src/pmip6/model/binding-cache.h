@@ -34,9 +34,10 @@
 #include "ns3/net-device.h"
 #include "ns3/ipv6-address.h"
 #include "ns3/ptr.h"
-#include "ns3/timer.h"
 #include "ns3/sgi-hashmap.h"
 #include "ns3/identifier.h"
+#include "ns3/ipv6-mobility-message-template.h"
+#include "ns3/pmipv6-timer-wheel.h"
 
 namespace ns3
 {
@@ -56,12 +57,45 @@ public:
   BindingCache::Entry *Lookup(Identifier mnId, uint8_t att, Identifier mnLinkId);
   BindingCache::Entry *Lookup(Identifier mnId);
   
+  /**
+   * \brief lookup the binding which owns a home network prefix.
+   * \param hnp home network prefix
+   * \return the entry, or 0 if no binding holds the prefix
+   */
+  BindingCache::Entry *LookupByHomeNetworkPrefix(Ipv6Address hnp);
+
+  /**
+   * \brief lookup a binding by its MN link-layer identifier.
+   * \param mnLinkId MN link-layer identifier
+   * \return the entry, or 0 if not found
+   */
+  BindingCache::Entry *LookupByMnLinkIdentifier(Identifier mnLinkId);
+
+  /**
+   * \brief lookup the bindings registered through a MAG.
+   *
+   * The remaining entries of the same MAG are reached through
+   * Entry::GetNextByProxyCoa ().
+   *
+   * \param pcoa Proxy-CoA of the MAG
+   * \return the first entry, or 0 if the MAG has no binding
+   */
+  BindingCache::Entry *LookupByProxyCoa(Ipv6Address pcoa);
+
   BindingCache::Entry *Add(Identifier mnId);
   
+  /**
+   * \brief unlink the entry from all indexes and delete it.
+   *
+   * Runs in constant time, the entry is reached through its own links.
+   * A pending tentative entry is deleted as well.
+   */
   void Remove(BindingCache::Entry *entry);
   
   void Flush();
   
+  uint32_t GetNEntries() const;
+  
   Ptr<Node> GetNode() const;
   void SetNode(Ptr<Node> node);
   
@@ -131,6 +165,18 @@ public:
     uint16_t GetLastBindingUpdateSequence() const;
     void SetLastBindingUpdateSequence(uint16_t seq);
     
+    /**
+     * \brief Bulk binding update group (RFC 6602), 0 if the binding
+     * is only refreshed on its own.
+     */
+    uint32_t GetGroupIdentifier() const;
+    void SetGroupIdentifier(uint32_t groupId);
+    
+    /**
+     * \brief Wire image of the PBA, cleared when an option changes.
+     */
+    Ipv6MobilityMessageTemplate &GetPbaTemplate();
+    
     Entry *GetNext() const;
     void SetNext(Entry *entry);
     
@@ -139,7 +185,11 @@ public:
     
     Ipv6Address GetOldProxyCoa() const;
     
+    Entry *GetNextByProxyCoa() const;
+    
   private:
+    friend class BindingCache;
+
     Ptr<BindingCache> m_bCache;
     
     enum BindingCacheState_e {
@@ -167,13 +217,16 @@ public:
     
     uint8_t m_handoffIndicator;
     
+    uint32_t m_groupIdentifier;
+    
     Time m_lastBindingUpdateTime;
     uint16_t m_lastBindingUpdateSequence;
+    Ipv6MobilityMessageTemplate m_pbaTemplate;
     
     Time m_reachableTime;
-    Timer m_reachableTimer;
-    Timer m_deregisterTimer;
-    Timer m_registerTimer;
+    Pmipv6Timer m_reachableTimer;
+    Pmipv6Timer m_deregisterTimer;
+    Pmipv6Timer m_registerTimer;
     
     Entry *m_next;
     
@@ -181,6 +234,13 @@ public:
     
     Entry *m_tentativeEntry;
     Ipv6Address m_oldProxyCoa;
+    
+    // true while the entry is linked in the cache; entries created
+    // by Copy () (tentative entries) are never indexed.
+    bool m_linked;
+    Entry *m_prev;
+    Entry *m_prevByProxyCoa;
+    Entry *m_nextByProxyCoa;
 
   };
   
@@ -189,11 +249,28 @@ protected:
 private:
   typedef sgi::hash_map<Identifier, BindingCache::Entry *, IdentifierHash> BCache;
   typedef sgi::hash_map<Identifier, BindingCache::Entry *, IdentifierHash>::iterator BCacheI;
+  typedef sgi::hash_map<Ipv6Address, BindingCache::Entry *, Ipv6AddressHash> BCacheAddrIndex;
+  typedef sgi::hash_map<Ipv6Address, BindingCache::Entry *, Ipv6AddressHash>::iterator BCacheAddrIndexI;
   
   void DoDispose();
   
+  void LinkPrefixes(BindingCache::Entry *entry);
+  void UnlinkPrefixes(BindingCache::Entry *entry);
+  void LinkMnLinkIdentifier(BindingCache::Entry *entry);
+  void UnlinkMnLinkIdentifier(BindingCache::Entry *entry);
+  void LinkProxyCoa(BindingCache::Entry *entry);
+  void UnlinkProxyCoa(BindingCache::Entry *entry);
+  
+  // per-MN chain heads, linked through Entry::m_next / m_prev
   BCache m_bCache;
   
+  // secondary indexes
+  BCacheAddrIndex m_hnpIndex;
+  BCache m_mnLinkIndex;
+  BCacheAddrIndex m_proxyCoaIndex;
+  
+  uint32_t m_nEntries;
+  
   Ptr<Node> m_node;
 };
 
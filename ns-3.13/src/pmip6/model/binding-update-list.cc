@@ -111,6 +111,11 @@ void BindingUpdateList::Remove (BindingUpdateList::Entry* entry)
     {
       if ((*i).second == entry)
         {
+          if (entry->GetGroup ())
+            {
+              entry->GetGroup ()->RemoveEntry (entry);
+            }
+          
           m_buList.erase (i);
           delete entry;
           return;
@@ -128,6 +133,54 @@ void BindingUpdateList::Flush ()
     }
 
   m_buList.erase (m_buList.begin (), m_buList.end ());
+  
+  for (BUGroupsI i = m_groups.begin (); i != m_groups.end (); i++)
+    {
+      delete (*i).second;
+    }
+  
+  m_groups.clear ();
+}
+
+BindingUpdateList::Group *BindingUpdateList::LookupGroup (Ipv6Address lma)
+{
+  NS_LOG_FUNCTION (this << lma);
+  
+  BUGroupsI it = m_groups.find (lma);
+  
+  if (it == m_groups.end ())
+    {
+      return 0;
+    }
+  
+  return it->second;
+}
+
+BindingUpdateList::Group *BindingUpdateList::AddGroup (Ipv6Address lma)
+{
+  NS_LOG_FUNCTION (this << lma);
+  NS_ASSERT (LookupGroup (lma) == 0);
+  
+  BindingUpdateList::Group *group = new BindingUpdateList::Group (this, lma);
+  
+  m_groups[lma] = group;
+  
+  return group;
+}
+
+void BindingUpdateList::RemoveGroup (BindingUpdateList::Group *group)
+{
+  NS_LOG_FUNCTION (this << group);
+  
+  std::list<Entry *> entries = group->GetEntries ();
+  
+  for (std::list<Entry *>::iterator i = entries.begin (); i != entries.end (); i++)
+    {
+      group->RemoveEntry (*i);
+    }
+  
+  m_groups.erase (group->GetLmaAddress ());
+  delete group;
 }
 
 Ptr<Node> BindingUpdateList::GetNode() const
@@ -147,12 +200,11 @@ void BindingUpdateList::SetNode(Ptr<Node> node)
 BindingUpdateList::Entry::Entry (Ptr<BindingUpdateList> bul)
   : m_buList (bul),
   m_state (UNREACHABLE),
+  m_redirected (false),
   m_ifIndex(-1),
   m_tunnelIfIndex(-1),
-  m_retransTimer (Timer::CANCEL_ON_DESTROY),
-  m_reachableTimer (Timer::CANCEL_ON_DESTROY),
-  m_refreshTimer (Timer::CANCEL_ON_DESTROY),
   m_radvdIfIndex (-1),
+  m_group (0),
   m_next (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
@@ -179,7 +231,7 @@ void BindingUpdateList::Entry::FunctionRefreshTimeout ()
   
   ResetRetryCount();
   
-  mag->SendMessage(p->Copy(), GetLmaAddress(), 64);
+  mag->SendPbu(this);
   
   MarkRefreshing();
   
@@ -209,6 +261,12 @@ void BindingUpdateList::Entry::FunctionReachableTimeout()
     {
       MarkUpdating();
     }
+  
+  //the bulk refresh failed as well
+  if (m_group)
+    {
+      m_group->RemoveEntry (this);
+    }
 
   if( m_radvdIfIndex >= 0 )
     {
@@ -240,10 +298,29 @@ void BindingUpdateList::Entry::FunctionRetransTimeout()
     {
       NS_LOG_LOGIC ("Maximum retry count reached. Giving up..");
       
+      //nothing left to wait for, the MN is gone
+      if (IsDeregistering())
+        {
+          m_buList->Remove(this);
+        }
+      else if (IsUpdating())
+        {
+          //served ahead of the PBA after a fast handover
+          if (m_radvdIfIndex >= 0)
+            {
+              mag->ClearRadvdInterface (this);
+            }
+          
+          if (m_tunnelIfIndex >= 0)
+            {
+              mag->ClearTunnelAndRouting (this);
+            }
+        }
+      
       return;
     }
   
-  mag->SendMessage(GetPbuPacket ()->Copy (), GetLmaAddress (), 64);
+  mag->SendPbu(this, true);
   
   StartRetransTimer();  
 }
@@ -276,6 +353,13 @@ bool BindingUpdateList::Entry::IsReachable() const
   return m_state == REACHABLE;
 }
 
+bool BindingUpdateList::Entry::IsDeregistering() const
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  return m_state == DEREGISTERING;
+}
+
 void BindingUpdateList::Entry::MarkUnreachable()
 {
   NS_LOG_FUNCTION_NOARGS();
@@ -303,6 +387,13 @@ void BindingUpdateList::Entry::MarkReachable()
   
   m_state = REACHABLE;
 }
+
+void BindingUpdateList::Entry::MarkDeregistering()
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  m_state = DEREGISTERING;
+}
     
 void BindingUpdateList::Entry::StartReachableTimer ()
 {
@@ -398,6 +489,11 @@ void BindingUpdateList::Entry::SetMnIdentifier(Identifier mnId)
 {
   NS_LOG_FUNCTION ( this << mnId );
   
+  if (mnId != m_mnIdentifier)
+    {
+      m_pbuTemplate.Clear ();
+    }
+  
   m_mnIdentifier = mnId;
 }
 
@@ -412,6 +508,11 @@ void BindingUpdateList::Entry::SetMnLinkIdentifier(Identifier mnLinkId)
 {
   NS_LOG_FUNCTION ( this << mnLinkId );
   
+  if (mnLinkId != m_mnLinkIdentifier)
+    {
+      m_pbuTemplate.Clear ();
+    }
+  
   m_mnLinkIdentifier = mnLinkId;
 }
 
@@ -426,6 +527,11 @@ void BindingUpdateList::Entry::SetHomeNetworkPrefixes(std::list<Ipv6Address> hnp
 {
   NS_LOG_FUNCTION_NOARGS ();
   
+  if (hnpList != m_homeNetworkPrefixes)
+    {
+      m_pbuTemplate.Clear ();
+    }
+  
   m_homeNetworkPrefixes = hnpList;
 }
 
@@ -440,6 +546,11 @@ void BindingUpdateList::Entry::SetMagLinkAddress(Ipv6Address lla)
 {
   NS_LOG_FUNCTION ( this << lla );
   
+  if (lla != m_magLinkAddress)
+    {
+      m_pbuTemplate.Clear ();
+    }
+  
   m_magLinkAddress = lla;
 }
 
@@ -457,6 +568,25 @@ void BindingUpdateList::Entry::SetLmaAddress(Ipv6Address lmaa)
   m_lmaAddress = lmaa;
 }
 
+bool BindingUpdateList::Entry::IsRedirected() const
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  return m_redirected;
+}
+
+void BindingUpdateList::Entry::SetRedirected(bool redirected)
+{
+  NS_LOG_FUNCTION ( this << redirected );
+  
+  if (redirected != m_redirected)
+    {
+      m_pbuTemplate.Clear ();
+    }
+  
+  m_redirected = redirected;
+}
+
 int16_t BindingUpdateList::Entry::GetIfIndex() const
 {
   NS_LOG_FUNCTION_NOARGS();
@@ -496,6 +626,11 @@ void BindingUpdateList::Entry::SetAccessTechnologyType(uint8_t att)
 {
   NS_LOG_FUNCTION ( this << (uint32_t) att);
   
+  if (att != m_accessTechnologyType)
+    {
+      m_pbuTemplate.Clear ();
+    }
+  
   m_accessTechnologyType = att;
 }
 
@@ -510,6 +645,11 @@ void BindingUpdateList::Entry::SetHandoffIndicator(uint8_t hi)
 {
   NS_LOG_FUNCTION ( this << (uint32_t) hi);
   
+  if (hi != m_handoffIndicator)
+    {
+      m_pbuTemplate.Clear ();
+    }
+  
   m_handoffIndicator = hi;
 }
 
@@ -569,6 +709,11 @@ void BindingUpdateList::Entry::SetPbuPacket(Ptr<Packet> pkt)
   m_pktPbu = pkt;
 }
 
+Ipv6MobilityMessageTemplate &BindingUpdateList::Entry::GetPbuTemplate()
+{
+  return m_pbuTemplate;
+}
+
 uint8_t BindingUpdateList::Entry::GetRetryCount() const
 {
   NS_LOG_FUNCTION_NOARGS();
@@ -618,4 +763,286 @@ void BindingUpdateList::Entry::SetRadvdIfIndex(int32_t ifIndex)
   m_radvdIfIndex = ifIndex;
 }
 
+BindingUpdateList::Group *BindingUpdateList::Entry::GetGroup() const
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  return m_group;
+}
+
+BindingUpdateList::Group::Group (Ptr<BindingUpdateList> bul, Ipv6Address lma)
+  : m_buList (bul),
+  m_lmaAddress (lma),
+  m_groupIdentifier (0),
+  m_deregistering (false),
+  m_lastBindingUpdateSequence (0),
+  m_retryCount (0)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+bool BindingUpdateList::Group::IsDeregistering() const
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  return m_deregistering;
+}
+
+void BindingUpdateList::Group::MarkDeregistering()
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  m_deregistering = true;
+}
+
+void BindingUpdateList::Group::FunctionRefreshTimeout ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  Ptr<Pmipv6Mag> mag = m_buList->GetNode ()->GetObject<Pmipv6Mag> ();
+   
+  if (mag == 0)
+    {
+      NS_LOG_WARN("No MAG agent for Binding Update List");
+      
+      return;
+    }
+  
+  SetLastBindingUpdateTime (MicroSeconds (Simulator::Now ().GetMicroSeconds ()));
+  SetLastBindingUpdateSequence (mag->GetSequence ());
+  
+  Ptr<Packet> p = mag->BuildBulkPbu (this);
+  
+  SetPbuPacket (p);
+  
+  ResetRetryCount ();
+  
+  mag->SendBulkPbu (this);
+  
+  StartRetransTimer ();
+}
+
+void BindingUpdateList::Group::FunctionRetransTimeout()
+{
+  NS_LOG_FUNCTION_NOARGS();
+  Ptr<Pmipv6Mag> mag = m_buList->GetNode()->GetObject<Pmipv6Mag>();
+  
+  if( mag == 0)
+    {
+      NS_LOG_WARN("No MAG agent for Binding Update List");
+      
+      return;
+    }
+  
+  IncreaseRetryCount();
+  
+  if ( GetRetryCount() > Ipv6MobilityL4Protocol::MAX_BINDING_UPDATE_RETRY_COUNT )
+    {
+      NS_LOG_LOGIC ("Maximum retry count reached. Giving up..");
+      
+      //the revoked bindings expire on the LMA anyway
+      if (IsDeregistering())
+        {
+          std::list<Entry *> entries = GetEntries ();
+          
+          for (std::list<Entry *>::iterator i = entries.begin (); i != entries.end (); i++)
+            {
+              m_buList->Remove (*i);
+            }
+          
+          m_buList->RemoveGroup (this);
+        }
+      
+      //otherwise the entries expire on their reachable timers
+      return;
+    }
+  
+  mag->SendBulkPbu(this, true);
+  
+  StartRetransTimer();  
+}
+
+void BindingUpdateList::Group::StartRetransTimer ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  m_retransTimer.SetFunction (&BindingUpdateList::Group::FunctionRetransTimeout, this);
+  
+  if (GetRetryCount () == 0)
+    {
+      m_retransTimer.SetDelay (Seconds (Ipv6MobilityL4Protocol::INITIAL_BINDING_ACK_TIMEOUT_FIRSTREG));
+    }
+  else
+    {
+      m_retransTimer.SetDelay (Seconds (Ipv6MobilityL4Protocol::INITIAL_BINDING_ACK_TIMEOUT_REREG));
+    }
+    
+  m_retransTimer.Schedule ();
+}
+
+void BindingUpdateList::Group::StopRetransTimer ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  m_retransTimer.Cancel ();
+}
+
+void BindingUpdateList::Group::StartRefreshTimer ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  NS_ASSERT ( !m_reachableTime.IsZero() );
+  
+  m_refreshTimer.SetFunction (&BindingUpdateList::Group::FunctionRefreshTimeout, this);
+  m_refreshTimer.SetDelay ( Seconds ( m_reachableTime.GetSeconds() * 0.9 ) );
+  m_refreshTimer.Schedule ();
+}
+
+void BindingUpdateList::Group::StopRefreshTimer ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_refreshTimer.Cancel ();
+}
+
+Ipv6Address BindingUpdateList::Group::GetLmaAddress() const
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  return m_lmaAddress;
+}
+
+uint32_t BindingUpdateList::Group::GetGroupIdentifier() const
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  return m_groupIdentifier;
+}
+
+void BindingUpdateList::Group::SetGroupIdentifier(uint32_t groupId)
+{
+  NS_LOG_FUNCTION ( this << groupId );
+  
+  m_groupIdentifier = groupId;
+}
+
+Time BindingUpdateList::Group::GetLastBindingUpdateTime() const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  return m_lastBindingUpdateTime;
+}
+
+void BindingUpdateList::Group::SetLastBindingUpdateTime(Time tm)
+{
+  NS_LOG_FUNCTION ( this << tm );
+  
+  m_lastBindingUpdateTime = tm;
+}
+
+Time BindingUpdateList::Group::GetReachableTime() const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  return m_reachableTime;
+}
+
+void BindingUpdateList::Group::SetReachableTime(Time tm)
+{
+  NS_LOG_FUNCTION (this << tm );
+  
+  m_reachableTime = tm;
+}
+
+uint16_t BindingUpdateList::Group::GetLastBindingUpdateSequence() const
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  return m_lastBindingUpdateSequence;
+}
+
+void BindingUpdateList::Group::SetLastBindingUpdateSequence(uint16_t seq)
+{
+  NS_LOG_FUNCTION( this << seq);
+  
+  m_lastBindingUpdateSequence = seq;
+}
+
+Ptr<Packet> BindingUpdateList::Group::GetPbuPacket() const
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  return m_pktPbu;
+}
+
+void BindingUpdateList::Group::SetPbuPacket(Ptr<Packet> pkt)
+{
+  NS_LOG_FUNCTION( this << pkt );
+  
+  m_pktPbu = pkt;
+}
+
+uint8_t BindingUpdateList::Group::GetRetryCount() const
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  return m_retryCount;
+}
+
+void BindingUpdateList::Group::ResetRetryCount()
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  m_retryCount = 0;
+}
+
+void BindingUpdateList::Group::IncreaseRetryCount()
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  m_retryCount++;
+}
+
+void BindingUpdateList::Group::AddEntry(Entry *entry)
+{
+  NS_LOG_FUNCTION ( this << entry );
+  NS_ASSERT (entry->m_group == 0 || entry->m_group == this);
+  
+  entry->StopRefreshTimer ();
+  entry->m_group = this;
+  
+  m_entries.insert (entry);
+  
+  if (!m_refreshTimer.IsRunning () && !IsDeregistering ())
+    {
+      StartRefreshTimer ();
+    }
+}
+
+void BindingUpdateList::Group::RemoveEntry(Entry *entry)
+{
+  NS_LOG_FUNCTION ( this << entry );
+  NS_ASSERT (entry->m_group == this);
+  
+  entry->m_group = 0;
+  
+  m_entries.erase (entry);
+  
+  if (m_entries.empty ())
+    {
+      StopRefreshTimer ();
+    }
+}
+
+std::list<BindingUpdateList::Entry *> BindingUpdateList::Group::GetEntries() const
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  return std::list<Entry *> (m_entries.begin (), m_entries.end ());
+}
+
+uint32_t BindingUpdateList::Group::GetNEntries() const
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  return m_entries.size ();
+}
+
 } /* namespace ns3 */
@@ -28,16 +28,18 @@
 #include <stdint.h>
 
 #include <list>
+#include <set>
 
 #include "ns3/packet.h"
 #include "ns3/nstime.h"
 #include "ns3/net-device.h"
 #include "ns3/ipv6-address.h"
 #include "ns3/ptr.h"
-#include "ns3/timer.h"
 #include "ns3/sgi-hashmap.h"
 
 #include "identifier.h"
+#include "ipv6-mobility-message-template.h"
+#include "pmipv6-timer-wheel.h"
 
 namespace ns3
 {
@@ -46,6 +48,7 @@ class BindingUpdateList : public Object
 {
 public:
   class Entry;
+  class Group;
   
   static TypeId GetTypeId ();
 
@@ -61,6 +64,20 @@ public:
   
   void Flush();
   
+  /**
+   * \brief lookup the bulk binding group (RFC 6602) of an LMA.
+   * \param lma LMA address
+   * \return the group, or 0 if none was assigned
+   */
+  BindingUpdateList::Group *LookupGroup(Ipv6Address lma);
+  
+  BindingUpdateList::Group *AddGroup(Ipv6Address lma);
+  
+  /**
+   * \brief delete the group; its entries are left, out of any group.
+   */
+  void RemoveGroup(BindingUpdateList::Group *group);
+  
   Ptr<Node> GetNode() const;
   void SetNode(Ptr<Node> node);
   
@@ -73,11 +90,13 @@ public:
 	bool IsUpdating() const;
 	bool IsRefreshing() const;
 	bool IsReachable() const;
+	bool IsDeregistering() const;
 	
 	void MarkUnreachable();
 	void MarkUpdating();
 	void MarkRefreshing();
 	void MarkReachable();
+	void MarkDeregistering();
 	
 	//timer processing
 	void StartRetransTimer();
@@ -110,6 +129,13 @@ public:
 	Ipv6Address GetLmaAddress() const;
 	void SetLmaAddress(Ipv6Address lmaa);
 	
+	/**
+	 * \brief Whether a LMA redirected the entry to the current one
+	 * (RFC 6463), which it then cannot be redirected from.
+	 */
+	bool IsRedirected() const;
+	void SetRedirected(bool redirected);
+	
 	int16_t GetIfIndex() const;
 	void SetIfIndex(int16_t ifi);
 	
@@ -134,6 +160,11 @@ public:
 	Ptr<Packet> GetPbuPacket() const;
 	void SetPbuPacket(Ptr<Packet> pkt);
 	
+	/**
+	 * \brief Wire image of the PBU, cleared when an option changes.
+	 */
+	Ipv6MobilityMessageTemplate &GetPbuTemplate();
+	
 	uint8_t GetRetryCount() const;
 	void IncreaseRetryCount();
 	void ResetRetryCount();
@@ -144,12 +175,21 @@ public:
 	int32_t GetRadvdIfIndex() const;
 	void SetRadvdIfIndex(int32_t ifIndex);
 	
+	/**
+	 * \brief Bulk binding group refreshing this entry, 0 if the entry
+	 * refreshes itself.
+	 */
+	Group *GetGroup() const;
+	
   private:
+	friend class Group;
+	
 	enum BindingUpdateState_e {
       UNREACHABLE,
 	  UPDATING,
 	  REFRESHING,
 	  REACHABLE,
+	  DEREGISTERING,
 	};
 
     Ptr<BindingUpdateList> m_buList;
@@ -166,6 +206,8 @@ public:
 	
 	Ipv6Address m_lmaAddress;
 	
+	bool m_redirected;
+	
 	int16_t m_ifIndex;
 	
 	int16_t m_tunnelIfIndex;
@@ -178,33 +220,127 @@ public:
 	
 	Time m_reachableTime;
 	
-	Timer m_retransTimer;
+	Pmipv6Timer m_retransTimer;
 	
-	Timer m_reachableTimer;
+	Pmipv6Timer m_reachableTimer;
 	
-	Timer m_refreshTimer;
+	Pmipv6Timer m_refreshTimer;
 	
 	uint16_t m_lastBindingUpdateSequence;
 	Ptr<Packet> m_pktPbu;
+	Ipv6MobilityMessageTemplate m_pbuTemplate;
 	
 	uint8_t m_retryCount;
 	
 	//internal
 	int32_t m_radvdIfIndex; //Radvd Interface Index
 	
+	Group *m_group;
+	
 	Entry *m_next;
   };
   
+  /**
+   * \class Group
+   * \brief Bindings of one LMA refreshed together (RFC 6602).
+   *
+   * The LMA assigns a group identifier to the bindings registered with
+   * the B flag. The group then refreshes (or revokes) all of them with a
+   * single bulk PBU, carrying only the group identifier, while its
+   * entries keep their reachable timers but no refresh timer.
+   */
+  class Group
+  {
+  public:
+    Group(Ptr<BindingUpdateList> bul, Ipv6Address lma);
+	
+	bool IsDeregistering() const;
+	void MarkDeregistering();
+	
+	//timer processing
+	void StartRetransTimer();
+	void StopRetransTimer();
+	
+	void StartRefreshTimer();
+	void StopRefreshTimer();
+	
+	void FunctionRetransTimeout();
+	void FunctionRefreshTimeout();
+	
+	Ipv6Address GetLmaAddress() const;
+	
+	uint32_t GetGroupIdentifier() const;
+	void SetGroupIdentifier(uint32_t groupId);
+	
+	Time GetLastBindingUpdateTime() const;
+	void SetLastBindingUpdateTime(Time tm);
+	
+	Time GetReachableTime() const;
+	void SetReachableTime(Time tm);
+	
+	uint16_t GetLastBindingUpdateSequence() const;
+	void SetLastBindingUpdateSequence(uint16_t seq);
+	
+	Ptr<Packet> GetPbuPacket() const;
+	void SetPbuPacket(Ptr<Packet> pkt);
+	
+	uint8_t GetRetryCount() const;
+	void IncreaseRetryCount();
+	void ResetRetryCount();
+	
+	/**
+	 * \brief Move an entry into the group, stopping its refresh timer.
+	 */
+	void AddEntry(Entry *entry);
+	
+	/**
+	 * \brief Take an entry out of the group; the refresh timer of
+	 * the group stops with the last entry.
+	 */
+	void RemoveEntry(Entry *entry);
+	
+	std::list<Entry *> GetEntries() const;
+	uint32_t GetNEntries() const;
+	
+  private:
+    Ptr<BindingUpdateList> m_buList;
+	
+	Ipv6Address m_lmaAddress;
+	
+	uint32_t m_groupIdentifier;
+	
+	bool m_deregistering;
+	
+	Time m_lastBindingUpdateTime;
+	
+	Time m_reachableTime;
+	
+	Pmipv6Timer m_retransTimer;
+	
+	Pmipv6Timer m_refreshTimer;
+	
+	uint16_t m_lastBindingUpdateSequence;
+	Ptr<Packet> m_pktPbu;
+	
+	uint8_t m_retryCount;
+	
+	std::set<Entry *> m_entries;
+  };
+  
 protected:
 
 private:
   typedef sgi::hash_map<Identifier, BindingUpdateList::Entry *, IdentifierHash> BUList;
   typedef sgi::hash_map<Identifier, BindingUpdateList::Entry *, IdentifierHash>::iterator BUListI;
+  typedef sgi::hash_map<Ipv6Address, BindingUpdateList::Group *, Ipv6AddressHash> BUGroups;
+  typedef sgi::hash_map<Ipv6Address, BindingUpdateList::Group *, Ipv6AddressHash>::iterator BUGroupsI;
   
   void DoDispose();
   
   BUList m_buList;
   
+  BUGroups m_groups;
+  
   Ptr<Node> m_node;
 };
 
@@ -24,109 +24,15 @@
 
 #include "ns3/assert.h"
 #include "ns3/mac48-address.h"
+#include "ns3/sgi-hashmap.h"
 
+#include <stdlib.h>
 #include <iomanip>
 
 #include "identifier.h"
 
 namespace ns3 {
 
-Identifier::Identifier()
-  : m_len(0)
-{
-  memset (m_identifier, 0, MAX_SIZE);
-}
-
-Identifier::Identifier(const uint8_t *identifier, uint8_t len)
-  : m_len(len)
-{
-  memcpy(m_identifier, identifier, m_len);
-}
-
-Identifier::Identifier(const char *str)
-{
-  m_len = strlen(str);
-  memcpy(m_identifier, str, m_len);
-}
-
-Identifier::Identifier(Mac48Address addr)
- : m_len(6)
-{
-  addr.CopyTo(m_identifier);
-}
-
-Identifier::Identifier(const Identifier &identifier)
-  : m_len(identifier.m_len)
-{
-  memcpy(m_identifier, identifier.m_identifier, m_len);
-}
-
-Identifier &
-Identifier::operator = (const Identifier &identifier)
-{
-  m_len = identifier.m_len;
-  memcpy(m_identifier, identifier.m_identifier, m_len);
-  return *this;
-}
-
-uint8_t
-Identifier::GetLength (void) const
-{
-  return m_len;
-}
-
-uint32_t
-Identifier::CopyTo (uint8_t *buffer, uint8_t len) const
-{
-  NS_ASSERT (len >= m_len);
-  
-  memcpy (buffer, m_identifier, m_len);
-  return m_len;
-}
-
-uint32_t
-Identifier::CopyFrom (const uint8_t *buffer, uint8_t len)
-{
-  memcpy (m_identifier, buffer, len);
-  m_len = len;
-  
-  return m_len;
-}
-
-bool Identifier::IsEmpty () const
-{
-  return (m_len == 0);
-}
-
-bool operator == (const Identifier &a, const Identifier &b)
-{
-  if(a.m_len != b.m_len)
-    {
-	  return false;
-	}
-  return memcmp (a.m_identifier, b.m_identifier, a.m_len) == 0;
-}
-
-bool operator != (const Identifier &a, const Identifier &b)
-{
-  return !(a == b);
-}
-
-std::ostream& operator<< (std::ostream& os, const Identifier & identifier)
-{
-  os.setf (std::ios::hex, std::ios::basefield);
-  os.fill('0');
-  for (uint8_t i = 0; i < (identifier.m_len-1); ++i)
-    {
-	  os << std::setw(2) << (uint32_t)identifier.m_identifier[i] << ":";
-	}
-  os << std::setw(2) << (uint32_t)identifier.m_identifier[identifier.m_len-1];
-  os.setf (std::ios::dec, std::ios::basefield);
-  os.fill(' ');
-  return os;
-}
-
-
 #ifdef __cplusplus
 extern "C"
 { /* } */
@@ -156,7 +62,6 @@ static uint32_t lookuphash (unsigned char* k, uint32_t length, uint32_t level)
    })
 
   typedef uint32_t  ub4;   /* unsigned 4-byte quantities */
-  typedef unsigned  char ub1;   /* unsigned 1-byte quantities */
   uint32_t a = 0;
   uint32_t b = 0;
   uint32_t c = 0;
@@ -207,13 +112,237 @@ static uint32_t lookuphash (unsigned char* k, uint32_t length, uint32_t level)
 }
 #endif
 
-size_t IdentifierHash::operator () (Identifier const &x) const
+/**
+ * \brief set of the interned identifier values.
+ *
+ * Records are looked up by content (hash, length and bytes) and keyed
+ * by the bytes stored in the record itself.
+ */
+class Identifier::InternTable
+{
+public:
+  Identifier::Rep *Find (uint32_t hash, const uint8_t *buffer, uint8_t len)
+  {
+    InternTableI it = m_table.find (Key (hash, buffer, len));
+    if (it == m_table.end ())
+      {
+        return 0;
+      }
+    return it->second;
+  }
+  
+  void Insert (Identifier::Rep *rep)
+  {
+    m_table[Key (rep->m_hash, rep->m_data, rep->m_len)] = rep;
+  }
+  
+  void Erase (Identifier::Rep *rep)
+  {
+    m_table.erase (Key (rep->m_hash, rep->m_data, rep->m_len));
+  }
+  
+  uint32_t GetSize (void) const
+  {
+    return m_table.size ();
+  }
+
+private:
+  struct Key
+  {
+    Key (uint32_t hash, const uint8_t *data, uint8_t len)
+      : m_hash (hash), m_data (data), m_len (len)
+    {
+    }
+    uint32_t m_hash;
+    const uint8_t *m_data;
+    uint8_t m_len;
+  };
+  
+  struct KeyHash
+  {
+    size_t operator () (const Key &k) const
+    {
+      return k.m_hash;
+    }
+  };
+  
+  struct KeyEqual
+  {
+    bool operator () (const Key &a, const Key &b) const
+    {
+      return a.m_hash == b.m_hash && a.m_len == b.m_len && memcmp (a.m_data, b.m_data, a.m_len) == 0;
+    }
+  };
+  
+  typedef sgi::hash_map<Key, Identifier::Rep *, KeyHash, KeyEqual> InternTableMap;
+  typedef sgi::hash_map<Key, Identifier::Rep *, KeyHash, KeyEqual>::iterator InternTableI;
+  
+  InternTableMap m_table;
+};
+
+Identifier::InternTable *
+Identifier::GetInternTable (void)
+{
+  // never destroyed: identifiers held by static objects may be released
+  // after the end of main ()
+  static InternTable *table = new InternTable ();
+  return table;
+}
+
+Identifier::Rep *
+Identifier::Intern (const uint8_t *buffer, uint8_t len)
 {
-  uint8_t buf[Identifier::MAX_SIZE];
+  if (len == 0)
+    {
+      return 0;
+    }
+  
+  uint32_t hash = lookuphash ((unsigned char *)buffer, len, 0);
+  InternTable *table = GetInternTable ();
+  Rep *rep = table->Find (hash, buffer, len);
+  
+  if (rep == 0)
+    {
+      rep = (Rep *)malloc (sizeof (Rep) + len - 1);
+      rep->m_hash = hash;
+      rep->m_refCount = 0;
+      rep->m_len = len;
+      memcpy (rep->m_data, buffer, len);
+      
+      table->Insert (rep);
+    }
+  
+  rep->m_refCount++;
+  return rep;
+}
 
-  x.CopyTo (buf, Identifier::MAX_SIZE);
+void
+Identifier::Release (Rep *rep)
+{
+  if (rep == 0)
+    {
+      return;
+    }
+  
+  NS_ASSERT (rep->m_refCount > 0);
+  
+  if (--rep->m_refCount == 0)
+    {
+      GetInternTable ()->Erase (rep);
+      free (rep);
+    }
+}
 
-  return lookuphash (buf, x.GetLength(), 0);
+uint32_t
+Identifier::GetNInterned (void)
+{
+  return GetInternTable ()->GetSize ();
+}
+
+Identifier::Identifier()
+  : m_rep(0)
+{
+}
+
+Identifier::Identifier(const uint8_t *identifier, uint8_t len)
+  : m_rep(Intern (identifier, len))
+{
+}
+
+Identifier::Identifier(const char *str)
+{
+  size_t len = strlen(str);
+  NS_ASSERT (len <= MAX_SIZE);
+  m_rep = Intern ((const uint8_t *)str, len);
+}
+
+Identifier::Identifier(Mac48Address addr)
+{
+  uint8_t buf[6];
+  addr.CopyTo(buf);
+  m_rep = Intern (buf, 6);
+}
+
+Identifier::Identifier(const Identifier &identifier)
+  : m_rep(identifier.m_rep)
+{
+  if (m_rep)
+    {
+      m_rep->m_refCount++;
+    }
+}
+
+Identifier &
+Identifier::operator = (const Identifier &identifier)
+{
+  if (identifier.m_rep)
+    {
+      identifier.m_rep->m_refCount++;
+    }
+  Release (m_rep);
+  m_rep = identifier.m_rep;
+  return *this;
+}
+
+Identifier::~Identifier()
+{
+  Release (m_rep);
+}
+
+uint8_t
+Identifier::GetLength (void) const
+{
+  return m_rep ? m_rep->m_len : 0;
+}
+
+uint32_t
+Identifier::CopyTo (uint8_t *buffer, uint8_t len) const
+{
+  uint8_t myLen = GetLength ();
+  NS_ASSERT (len >= myLen);
+  
+  if (myLen)
+    {
+      memcpy (buffer, m_rep->m_data, myLen);
+    }
+  return myLen;
+}
+
+uint32_t
+Identifier::CopyFrom (const uint8_t *buffer, uint8_t len)
+{
+  Rep *rep = Intern (buffer, len);
+  Release (m_rep);
+  m_rep = rep;
+  
+  return len;
+}
+
+bool Identifier::IsEmpty () const
+{
+  return (m_rep == 0);
+}
+
+std::ostream& operator<< (std::ostream& os, const Identifier & identifier)
+{
+  if (identifier.IsEmpty ())
+    {
+      return os;
+    }
+  
+  const uint8_t *data = identifier.m_rep->m_data;
+  uint8_t len = identifier.m_rep->m_len;
+  
+  os.setf (std::ios::hex, std::ios::basefield);
+  os.fill('0');
+  for (uint8_t i = 0; i < (len-1); ++i)
+    {
+	  os << std::setw(2) << (uint32_t)data[i] << ":";
+	}
+  os << std::setw(2) << (uint32_t)data[len-1];
+  os.setf (std::ios::dec, std::ios::basefield);
+  os.fill(' ');
+  return os;
 }
 
 } /* namespace ns3 */
@@ -40,6 +40,13 @@ class Mac48Address;
 /**
  * \class Identifier
  * \brief Identifier.
+ *
+ * The identifier bytes are interned: every distinct identifier value is
+ * stored once, together with its hash, in a reference counted record
+ * shared by all the Identifier instances holding that value. An
+ * Identifier is therefore a single pointer, comparison is a pointer
+ * comparison and hashing returns the value computed when the record
+ * was created.
  */
 class Identifier
 {
@@ -54,6 +61,7 @@ public:
   Identifier(Mac48Address addr);
   Identifier(const Identifier & identifier);
   Identifier &operator = (const Identifier &identifier);
+  ~Identifier();
   
   uint8_t GetLength (void) const;
   
@@ -62,6 +70,16 @@ public:
   uint32_t CopyFrom (const uint8_t *buffer, uint8_t len);
   
   bool IsEmpty() const;
+  
+  /**
+   * \return the hash of the identifier bytes, 0 for an empty identifier.
+   */
+  uint32_t GetHash (void) const;
+  
+  /**
+   * \return the number of distinct identifiers currently interned.
+   */
+  static uint32_t GetNInterned (void);
 
 protected:
 
@@ -70,14 +88,43 @@ private:
   friend bool operator != (const Identifier &a, const Identifier &b);
   friend std::ostream& operator<< (std::ostream& os, const Identifier & identifier);
   
-  uint8_t m_len;
-  uint8_t m_identifier[MAX_SIZE];
+  /**
+   * \brief interned identifier value, allocated with room for m_len bytes.
+   */
+  struct Rep
+  {
+    uint32_t m_hash;
+    uint32_t m_refCount;
+    uint8_t m_len;
+    uint8_t m_data[1];
+  };
+  
+  class InternTable;
+  
+  static InternTable *GetInternTable (void);
+  static Rep *Intern (const uint8_t *buffer, uint8_t len);
+  static void Release (Rep *rep);
+  
+  Rep *m_rep; // 0 for the empty identifier
 };
 
 ATTRIBUTE_HELPER_HEADER (Identifier);
 
-bool operator == (const Identifier &a, const Identifier &b);
-bool operator != (const Identifier &a, const Identifier &b);
+inline bool operator == (const Identifier &a, const Identifier &b)
+{
+  return a.m_rep == b.m_rep;
+}
+
+inline bool operator != (const Identifier &a, const Identifier &b)
+{
+  return a.m_rep != b.m_rep;
+}
+
+inline uint32_t Identifier::GetHash (void) const
+{
+  return m_rep ? m_rep->m_hash : 0;
+}
+
 std::ostream& operator<< (std::ostream& os, const Identifier & identifier);
 
 /**
@@ -91,9 +138,12 @@ public:
    * \brief Unary operator to hash Identifier.
    * \param x Identifier to hash
    */
-  size_t operator () (Identifier const &x) const;
+  size_t operator () (Identifier const &x) const
+  {
+    return x.GetHash ();
+  }
 };
 
 } /* namespace ns3 */
 
-#endif /* MOBILITY_HEADER_H */
+#endif /* IDENTIFIER_H */
@@ -257,6 +257,7 @@ Ipv6MobilityBindingUpdateHeader::Ipv6MobilityBindingUpdateHeader ()
   SetFlagM(0);
   SetFlagR(0);
   SetFlagP(0);
+  SetFlagB(0);
   SetReserved2(0);
   SetLifetime(0);
 }
@@ -345,6 +346,16 @@ void Ipv6MobilityBindingUpdateHeader::SetFlagP (bool p)
   m_flagP = p;
 }
 
+bool Ipv6MobilityBindingUpdateHeader::GetFlagB () const
+{
+  return m_flagB;
+}
+
+void Ipv6MobilityBindingUpdateHeader::SetFlagB (bool b)
+{
+  m_flagB = b;
+}
+
 uint16_t Ipv6MobilityBindingUpdateHeader::GetReserved2 () const
 {
   return m_reserved2;
@@ -419,6 +430,10 @@ void Ipv6MobilityBindingUpdateHeader::Serialize (Buffer::Iterator start) const
     reserved2 |= (uint16_t)(1 << 9);
   }
   
+  if (m_flagB) {
+    reserved2 |= (uint16_t)(1 << 6);
+  }
+  
   i.WriteHtonU16 (reserved2);
   i.WriteHtonU16 (m_lifetime);
   
@@ -447,6 +462,7 @@ uint32_t Ipv6MobilityBindingUpdateHeader::Deserialize (Buffer::Iterator start)
   m_flagM = false;
   m_flagR = false;
   m_flagP = false;
+  m_flagB = false;
   
   if (m_reserved2 & (1 << 15))
     {
@@ -483,6 +499,11 @@ uint32_t Ipv6MobilityBindingUpdateHeader::Deserialize (Buffer::Iterator start)
       m_flagP = true;
     }
 
+  if (m_reserved2 & (1 << 6))
+    {
+      m_flagB = true;
+    }
+
   m_lifetime = i.ReadNtohU16 ();
   
   MobilityOptionField::Deserialize(i, (( GetHeaderLen() + 1 ) << 3 ) - GetOptionsOffset() );
@@ -518,6 +539,7 @@ Ipv6MobilityBindingAckHeader::Ipv6MobilityBindingAckHeader ()
   SetFlagK(0);
   SetFlagR(0);
   SetFlagP(0);
+  SetFlagB(0);
   SetReserved2(0);
   SetSequence(0);
   SetLifetime(0);
@@ -567,6 +589,16 @@ void Ipv6MobilityBindingAckHeader::SetFlagP (bool p)
   m_flagP = p;
 }
 
+bool Ipv6MobilityBindingAckHeader::GetFlagB () const
+{
+  return m_flagB;
+}
+
+void Ipv6MobilityBindingAckHeader::SetFlagB (bool b)
+{
+  m_flagB = b;
+}
+
 uint8_t Ipv6MobilityBindingAckHeader::GetReserved2 () const
 {
   return m_reserved2;
@@ -634,6 +666,10 @@ void Ipv6MobilityBindingAckHeader::Serialize (Buffer::Iterator start) const
     reserved2 |= (uint8_t)(1 << 5);
   }
   
+  if (m_flagB) {
+    reserved2 |= (uint8_t)(1 << 3);
+  }
+  
   i.WriteU8 (reserved2);
   i.WriteHtonU16 (m_sequence);
   i.WriteHtonU16 (m_lifetime);
@@ -659,6 +695,7 @@ uint32_t Ipv6MobilityBindingAckHeader::Deserialize (Buffer::Iterator start)
   m_flagK = false;
   m_flagR = false;
   m_flagP = false;
+  m_flagB = false;
   
   if (m_reserved2 & (1 << 7))
     {
@@ -675,6 +712,11 @@ uint32_t Ipv6MobilityBindingAckHeader::Deserialize (Buffer::Iterator start)
       m_flagP = true;
     }
 
+  if (m_reserved2 & (1 << 3))
+    {
+      m_flagB = true;
+    }
+
   m_sequence = i.ReadNtohU16 ();
   m_lifetime = i.ReadNtohU16 ();
 
@@ -683,5 +725,607 @@ uint32_t Ipv6MobilityBindingAckHeader::Deserialize (Buffer::Iterator start)
   return GetSerializedSize ();
 }
 
-} /* namespace ns3 */
+NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityHandoverInitiateHeader);
+
+TypeId Ipv6MobilityHandoverInitiateHeader::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Ipv6MobilityHandoverInitiateHeader")
+    .SetParent<Ipv6MobilityHeader> ()
+    .AddConstructor<Ipv6MobilityHandoverInitiateHeader> ()
+    ;
+  return tid;
+}
+
+TypeId Ipv6MobilityHandoverInitiateHeader::GetInstanceTypeId () const
+{
+  return GetTypeId ();
+}
+
+Ipv6MobilityHandoverInitiateHeader::Ipv6MobilityHandoverInitiateHeader ()
+: MobilityOptionField(10)
+{
+  SetHeaderLen(0);
+  SetMhType(IPV6_MOBILITY_HANDOVER_INITIATE);
+  SetReserved(0);
+  SetChecksum(0);
+  
+  SetSequence(0);
+  SetFlagS(0);
+  SetFlagU(0);
+  SetFlagP(0);
+  SetFlagF(0);
+  m_reserved2 = 0;
+  SetCode(0);
+}
+
+Ipv6MobilityHandoverInitiateHeader::~Ipv6MobilityHandoverInitiateHeader ()
+{
+}
+
+uint16_t Ipv6MobilityHandoverInitiateHeader::GetSequence () const
+{
+  return m_sequence;
+}
+
+void Ipv6MobilityHandoverInitiateHeader::SetSequence (uint16_t sequence)
+{
+  m_sequence = sequence;
+}
+
+uint8_t Ipv6MobilityHandoverInitiateHeader::GetCode () const
+{
+  return m_code;
+}
+
+void Ipv6MobilityHandoverInitiateHeader::SetCode (uint8_t code)
+{
+  m_code = code;
+}
+
+bool Ipv6MobilityHandoverInitiateHeader::GetFlagS () const
+{
+  return m_flagS;
+}
+
+void Ipv6MobilityHandoverInitiateHeader::SetFlagS (bool s)
+{
+  m_flagS = s;
+}
+
+bool Ipv6MobilityHandoverInitiateHeader::GetFlagU () const
+{
+  return m_flagU;
+}
+
+void Ipv6MobilityHandoverInitiateHeader::SetFlagU (bool u)
+{
+  m_flagU = u;
+}
+
+bool Ipv6MobilityHandoverInitiateHeader::GetFlagP () const
+{
+  return m_flagP;
+}
+
+void Ipv6MobilityHandoverInitiateHeader::SetFlagP (bool p)
+{
+  m_flagP = p;
+}
+
+bool Ipv6MobilityHandoverInitiateHeader::GetFlagF () const
+{
+  return m_flagF;
+}
+
+void Ipv6MobilityHandoverInitiateHeader::SetFlagF (bool f)
+{
+  m_flagF = f;
+}
+
+void Ipv6MobilityHandoverInitiateHeader::Print (std::ostream& os) const
+{
+  os << "( payload_proto = " << (uint32_t)GetPayloadProto() << " header_len = " << (uint32_t)GetHeaderLen() << " mh_type = " << (uint32_t)GetMhType() << " checksum = " << (uint32_t)GetChecksum();
+  os << " sequence = " << (uint32_t)GetSequence () << " code = " << (uint32_t)GetCode() << ")";
+}
+
+uint32_t Ipv6MobilityHandoverInitiateHeader::GetSerializedSize () const
+{
+  return 10 + MobilityOptionField::GetSerializedSize();
+}
+
+void Ipv6MobilityHandoverInitiateHeader::Serialize (Buffer::Iterator start) const
+{
+  Buffer::Iterator i = start;
+  uint32_t reserved2 = m_reserved2;
+
+  i.WriteU8 (GetPayloadProto());
+  
+  i.WriteU8 ( (uint8_t) (( GetSerializedSize() >> 3) - 1) );
+  i.WriteU8 (GetMhType());
+  i.WriteU8 (GetReserved());
+  i.WriteU16 (0);
+  
+  i.WriteHtonU16 (m_sequence);
+  
+  if (m_flagS) {
+    reserved2 |= (uint8_t)(1 << 7);
+  }
+  
+  if (m_flagU) {
+    reserved2 |= (uint8_t)(1 << 6);
+  }
+  
+  if (m_flagP) {
+    reserved2 |= (uint8_t)(1 << 5);
+  }
+  
+  if (m_flagF) {
+    reserved2 |= (uint8_t)(1 << 4);
+  }
+  
+  i.WriteU8 (reserved2);
+  i.WriteU8 (m_code);
+  
+  MobilityOptionField::Serialize(i);
+}
+
+uint32_t Ipv6MobilityHandoverInitiateHeader::Deserialize (Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+
+  SetPayloadProto(i.ReadU8 ());
+  SetHeaderLen(i.ReadU8 ());
+  SetMhType(i.ReadU8 ());
+  SetReserved(i.ReadU8 ());
+  
+  SetChecksum(i.ReadU16 ());
+  
+  m_sequence = i.ReadNtohU16 ();
+  
+  m_reserved2 = i.ReadU8 ();
+  
+  m_flagS = false;
+  m_flagU = false;
+  m_flagP = false;
+  m_flagF = false;
+  
+  if (m_reserved2 & (1 << 7))
+    {
+      m_flagS = true;
+    }
+
+  if (m_reserved2 & (1 << 6))
+    {
+      m_flagU = true;
+    }
+
+  if (m_reserved2 & (1 << 5))
+    {
+      m_flagP = true;
+    }
+
+  if (m_reserved2 & (1 << 4))
+    {
+      m_flagF = true;
+    }
+
+  m_code = i.ReadU8 ();
+  
+  MobilityOptionField::Deserialize(i, (( GetHeaderLen() + 1 ) << 3 ) - GetOptionsOffset() );
+  
+  return GetSerializedSize ();
+}
+
+NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityHandoverAckHeader);
+
+TypeId Ipv6MobilityHandoverAckHeader::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Ipv6MobilityHandoverAckHeader")
+    .SetParent<Ipv6MobilityHeader> ()
+    .AddConstructor<Ipv6MobilityHandoverAckHeader> ()
+    ;
+  return tid;
+}
+
+TypeId Ipv6MobilityHandoverAckHeader::GetInstanceTypeId () const
+{
+  return GetTypeId ();
+}
+
+Ipv6MobilityHandoverAckHeader::Ipv6MobilityHandoverAckHeader ()
+: MobilityOptionField(10)
+{
+  SetHeaderLen(0);
+  SetMhType(IPV6_MOBILITY_HANDOVER_ACKNOWLEDGE);
+  SetReserved(0);
+  SetChecksum(0);
+  
+  SetSequence(0);
+  SetFlagU(0);
+  SetFlagP(0);
+  SetFlagF(0);
+  m_reserved2 = 0;
+  SetCode(0);
+}
+
+Ipv6MobilityHandoverAckHeader::~Ipv6MobilityHandoverAckHeader ()
+{
+}
+
+uint16_t Ipv6MobilityHandoverAckHeader::GetSequence () const
+{
+  return m_sequence;
+}
+
+void Ipv6MobilityHandoverAckHeader::SetSequence (uint16_t sequence)
+{
+  m_sequence = sequence;
+}
+
+uint8_t Ipv6MobilityHandoverAckHeader::GetCode () const
+{
+  return m_code;
+}
+
+void Ipv6MobilityHandoverAckHeader::SetCode (uint8_t code)
+{
+  m_code = code;
+}
+
+bool Ipv6MobilityHandoverAckHeader::GetFlagU () const
+{
+  return m_flagU;
+}
+
+void Ipv6MobilityHandoverAckHeader::SetFlagU (bool u)
+{
+  m_flagU = u;
+}
+
+bool Ipv6MobilityHandoverAckHeader::GetFlagP () const
+{
+  return m_flagP;
+}
+
+void Ipv6MobilityHandoverAckHeader::SetFlagP (bool p)
+{
+  m_flagP = p;
+}
+
+bool Ipv6MobilityHandoverAckHeader::GetFlagF () const
+{
+  return m_flagF;
+}
+
+void Ipv6MobilityHandoverAckHeader::SetFlagF (bool f)
+{
+  m_flagF = f;
+}
+
+void Ipv6MobilityHandoverAckHeader::Print (std::ostream& os) const
+{
+  os << "( payload_proto = " << (uint32_t)GetPayloadProto() << " header_len = " << (uint32_t)GetHeaderLen() << " mh_type = " << (uint32_t)GetMhType() << " checksum = " << (uint32_t)GetChecksum();
+  os << " sequence = " << (uint32_t)GetSequence () << " code = " << (uint32_t)GetCode() << ")";
+}
+
+uint32_t Ipv6MobilityHandoverAckHeader::GetSerializedSize () const
+{
+  return 10 + MobilityOptionField::GetSerializedSize();
+}
+
+void Ipv6MobilityHandoverAckHeader::Serialize (Buffer::Iterator start) const
+{
+  Buffer::Iterator i = start;
+  uint32_t reserved2 = m_reserved2;
+
+  i.WriteU8 (GetPayloadProto());
+  
+  i.WriteU8 ( (uint8_t) (( GetSerializedSize() >> 3) - 1) );
+  i.WriteU8 (GetMhType());
+  i.WriteU8 (GetReserved());
+  i.WriteU16 (0);
+  
+  i.WriteHtonU16 (m_sequence);
+  
+  if (m_flagU) {
+    reserved2 |= (uint8_t)(1 << 7);
+  }
+  
+  if (m_flagP) {
+    reserved2 |= (uint8_t)(1 << 6);
+  }
+  
+  if (m_flagF) {
+    reserved2 |= (uint8_t)(1 << 5);
+  }
+  
+  i.WriteU8 (reserved2);
+  i.WriteU8 (m_code);
+  
+  MobilityOptionField::Serialize(i);
+}
+
+uint32_t Ipv6MobilityHandoverAckHeader::Deserialize (Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+
+  SetPayloadProto(i.ReadU8 ());
+  SetHeaderLen(i.ReadU8 ());
+  SetMhType(i.ReadU8 ());
+  SetReserved(i.ReadU8 ());
+  
+  SetChecksum(i.ReadU16 ());
+  
+  m_sequence = i.ReadNtohU16 ();
+  
+  m_reserved2 = i.ReadU8 ();
+  
+  m_flagU = false;
+  m_flagP = false;
+  m_flagF = false;
+  
+  if (m_reserved2 & (1 << 7))
+    {
+      m_flagU = true;
+    }
+
+  if (m_reserved2 & (1 << 6))
+    {
+      m_flagP = true;
+    }
+
+  if (m_reserved2 & (1 << 5))
+    {
+      m_flagF = true;
+    }
+
+  m_code = i.ReadU8 ();
+  
+  MobilityOptionField::Deserialize(i, (( GetHeaderLen() + 1 ) << 3 ) - GetOptionsOffset() );
+  
+  return GetSerializedSize ();
+}
+
+NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityLocalizedRoutingInitiationHeader);
+
+TypeId Ipv6MobilityLocalizedRoutingInitiationHeader::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Ipv6MobilityLocalizedRoutingInitiationHeader")
+    .SetParent<Ipv6MobilityHeader> ()
+    .AddConstructor<Ipv6MobilityLocalizedRoutingInitiationHeader> ()
+    ;
+  return tid;
+}
+
+TypeId Ipv6MobilityLocalizedRoutingInitiationHeader::GetInstanceTypeId () const
+{
+  return GetTypeId ();
+}
+
+Ipv6MobilityLocalizedRoutingInitiationHeader::Ipv6MobilityLocalizedRoutingInitiationHeader ()
+: MobilityOptionField(12)
+{
+  SetHeaderLen(0);
+  SetMhType(IPV6_MOBILITY_LOCALIZED_ROUTING_INITIATION);
+  SetReserved(0);
+  SetChecksum(0);
+  
+  SetSequence(0);
+  m_reserved2 = 0;
+  SetLifetime(0);
+}
+
+Ipv6MobilityLocalizedRoutingInitiationHeader::~Ipv6MobilityLocalizedRoutingInitiationHeader ()
+{
+}
+
+uint16_t Ipv6MobilityLocalizedRoutingInitiationHeader::GetSequence () const
+{
+  return m_sequence;
+}
+
+void Ipv6MobilityLocalizedRoutingInitiationHeader::SetSequence (uint16_t sequence)
+{
+  m_sequence = sequence;
+}
+
+uint16_t Ipv6MobilityLocalizedRoutingInitiationHeader::GetLifetime () const
+{
+  return m_lifetime;
+}
+
+void Ipv6MobilityLocalizedRoutingInitiationHeader::SetLifetime (uint16_t lifetime)
+{
+  m_lifetime = lifetime;
+}
+
+void Ipv6MobilityLocalizedRoutingInitiationHeader::Print (std::ostream& os) const
+{
+  os << "( payload_proto = " << (uint32_t)GetPayloadProto() << " header_len = " << (uint32_t)GetHeaderLen() << " mh_type = " << (uint32_t)GetMhType() << " checksum = " << (uint32_t)GetChecksum();
+  os << " sequence = " << (uint32_t)GetSequence () << " lifetime = " << (uint32_t)GetLifetime() << ")";
+}
+
+uint32_t Ipv6MobilityLocalizedRoutingInitiationHeader::GetSerializedSize () const
+{
+  return 12 + MobilityOptionField::GetSerializedSize();
+}
+
+void Ipv6MobilityLocalizedRoutingInitiationHeader::Serialize (Buffer::Iterator start) const
+{
+  Buffer::Iterator i = start;
+
+  i.WriteU8 (GetPayloadProto());
+  
+  i.WriteU8 ( (uint8_t) (( GetSerializedSize() >> 3) - 1) );
+  i.WriteU8 (GetMhType());
+  i.WriteU8 (GetReserved());
+  i.WriteU16 (0);
+  
+  i.WriteHtonU16 (m_sequence);
+  i.WriteHtonU16 (m_reserved2);
+  i.WriteHtonU16 (m_lifetime);
+  
+  MobilityOptionField::Serialize(i);
+}
+
+uint32_t Ipv6MobilityLocalizedRoutingInitiationHeader::Deserialize (Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+
+  SetPayloadProto(i.ReadU8 ());
+  SetHeaderLen(i.ReadU8 ());
+  SetMhType(i.ReadU8 ());
+  SetReserved(i.ReadU8 ());
+  
+  SetChecksum(i.ReadU16 ());
+  
+  m_sequence = i.ReadNtohU16 ();
+  m_reserved2 = i.ReadNtohU16 ();
+  m_lifetime = i.ReadNtohU16 ();
+  
+  MobilityOptionField::Deserialize(i, (( GetHeaderLen() + 1 ) << 3 ) - GetOptionsOffset() );
+  
+  return GetSerializedSize ();
+}
 
+NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityLocalizedRoutingAckHeader);
+
+TypeId Ipv6MobilityLocalizedRoutingAckHeader::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Ipv6MobilityLocalizedRoutingAckHeader")
+    .SetParent<Ipv6MobilityHeader> ()
+    .AddConstructor<Ipv6MobilityLocalizedRoutingAckHeader> ()
+    ;
+  return tid;
+}
+
+TypeId Ipv6MobilityLocalizedRoutingAckHeader::GetInstanceTypeId () const
+{
+  return GetTypeId ();
+}
+
+Ipv6MobilityLocalizedRoutingAckHeader::Ipv6MobilityLocalizedRoutingAckHeader ()
+: MobilityOptionField(12)
+{
+  SetHeaderLen(0);
+  SetMhType(IPV6_MOBILITY_LOCALIZED_ROUTING_ACKNOWLEDGEMENT);
+  SetReserved(0);
+  SetChecksum(0);
+  
+  SetSequence(0);
+  SetFlagU(0);
+  m_reserved2 = 0;
+  SetStatus(0);
+  SetLifetime(0);
+}
+
+Ipv6MobilityLocalizedRoutingAckHeader::~Ipv6MobilityLocalizedRoutingAckHeader ()
+{
+}
+
+uint16_t Ipv6MobilityLocalizedRoutingAckHeader::GetSequence () const
+{
+  return m_sequence;
+}
+
+void Ipv6MobilityLocalizedRoutingAckHeader::SetSequence (uint16_t sequence)
+{
+  m_sequence = sequence;
+}
+
+bool Ipv6MobilityLocalizedRoutingAckHeader::GetFlagU () const
+{
+  return m_flagU;
+}
+
+void Ipv6MobilityLocalizedRoutingAckHeader::SetFlagU (bool u)
+{
+  m_flagU = u;
+}
+
+uint8_t Ipv6MobilityLocalizedRoutingAckHeader::GetStatus () const
+{
+  return m_status;
+}
+
+void Ipv6MobilityLocalizedRoutingAckHeader::SetStatus (uint8_t status)
+{
+  m_status = status;
+}
+
+uint16_t Ipv6MobilityLocalizedRoutingAckHeader::GetLifetime () const
+{
+  return m_lifetime;
+}
+
+void Ipv6MobilityLocalizedRoutingAckHeader::SetLifetime (uint16_t lifetime)
+{
+  m_lifetime = lifetime;
+}
+
+void Ipv6MobilityLocalizedRoutingAckHeader::Print (std::ostream& os) const
+{
+  os << "( payload_proto = " << (uint32_t)GetPayloadProto() << " header_len = " << (uint32_t)GetHeaderLen() << " mh_type = " << (uint32_t)GetMhType() << " checksum = " << (uint32_t)GetChecksum();
+  os << " sequence = " << (uint32_t)GetSequence () << " status = " << (uint32_t)GetStatus() << " lifetime = " << (uint32_t)GetLifetime() << ")";
+}
+
+uint32_t Ipv6MobilityLocalizedRoutingAckHeader::GetSerializedSize () const
+{
+  return 12 + MobilityOptionField::GetSerializedSize();
+}
+
+void Ipv6MobilityLocalizedRoutingAckHeader::Serialize (Buffer::Iterator start) const
+{
+  Buffer::Iterator i = start;
+  uint32_t reserved2 = m_reserved2;
+
+  i.WriteU8 (GetPayloadProto());
+  
+  i.WriteU8 ( (uint8_t) (( GetSerializedSize() >> 3) - 1) );
+  i.WriteU8 (GetMhType());
+  i.WriteU8 (GetReserved());
+  i.WriteU16 (0);
+  
+  i.WriteHtonU16 (m_sequence);
+  
+  if (m_flagU) {
+    reserved2 |= (uint8_t)(1 << 7);
+  }
+  
+  i.WriteU8 (reserved2);
+  i.WriteU8 (m_status);
+  i.WriteHtonU16 (m_lifetime);
+  
+  MobilityOptionField::Serialize(i);
+}
+
+uint32_t Ipv6MobilityLocalizedRoutingAckHeader::Deserialize (Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+
+  SetPayloadProto(i.ReadU8 ());
+  SetHeaderLen(i.ReadU8 ());
+  SetMhType(i.ReadU8 ());
+  SetReserved(i.ReadU8 ());
+  
+  SetChecksum(i.ReadU16 ());
+  
+  m_sequence = i.ReadNtohU16 ();
+  
+  m_reserved2 = i.ReadU8 ();
+  m_flagU = false;
+  
+  if (m_reserved2 & (1 << 7))
+    {
+      m_flagU = true;
+    }
+
+  m_status = i.ReadU8 ();
+  m_lifetime = i.ReadNtohU16 ();
+  
+  MobilityOptionField::Deserialize(i, (( GetHeaderLen() + 1 ) << 3 ) - GetOptionsOffset() );
+  
+  return GetSerializedSize ();
+}
+
+} /* namespace ns3 */
@@ -54,7 +54,16 @@ public:
 	IPV6_MOBILITY_CARE_OF_TEST,
 	IPV6_MOBILITY_BINDING_UPDATE,
 	IPV6_MOBILITY_BINDING_ACKNOWLEDGEMENT,
-	IPV6_MOBILITY_BINDING_ERROR
+	IPV6_MOBILITY_BINDING_ERROR,
+	
+	/* Fast handover (RFC 5568, RFC 5949) */
+	IPV6_MOBILITY_HANDOVER_INITIATE = 14,
+	IPV6_MOBILITY_HANDOVER_ACKNOWLEDGE
+	
+	/* Localized routing (RFC 6705) */
+	,
+	IPV6_MOBILITY_LOCALIZED_ROUTING_INITIATION = 17,
+	IPV6_MOBILITY_LOCALIZED_ROUTING_ACKNOWLEDGEMENT
   };
    
    enum OptionType_e
@@ -68,6 +77,10 @@ public:
 	
 	IPV6_MOBILITY_OPT_MOBILE_NODE_IDENTIFIER = 8
 	
+	/* Fast handover (RFC 5568) */
+	,
+	IPV6_MOBILITY_OPT_IPV6_ADDRESS_PREFIX = 17
+	
 	/* PMIPv6 options */
 	,
 	IPV6_MOBILITY_OPT_HOME_NETWORK_PREFIX = 22,
@@ -75,7 +88,14 @@ public:
 	IPV6_MOBILITY_OPT_ACCESS_TECHNOLOGY_TYPE,
 	IPV6_MOBILITY_OPT_MOBILE_NODE_LINK_LAYER_IDENTIFIER = 25,
 	IPV6_MOBILITY_OPT_LINK_LOCAL_ADDRESS,
-	IPV6_MOBILITY_OPT_TIMESTAMP
+	IPV6_MOBILITY_OPT_TIMESTAMP,
+	
+	/* Runtime LMA assignment (RFC 6463) */
+	IPV6_MOBILITY_OPT_REDIRECT_CAPABILITY = 46,
+	IPV6_MOBILITY_OPT_REDIRECT,
+	
+	/* Bulk binding update (RFC 6602) */
+	IPV6_MOBILITY_OPT_MOBILE_NODE_GROUP_IDENTIFIER = 50
   };
 
   enum BAStatus_e {
@@ -98,6 +118,19 @@ public:
 	BA_STATUS_MISSING_HANDOFF_INDICATOR_OPTION,
 	BA_STATUS_MISSING_ACCESS_TECH_TYPE_OPTION
   };
+
+  enum HAckCode_e {
+    HACK_CODE_HANDOVER_ACCEPTED = 0,
+	HACK_CODE_HANDOVER_NOT_ACCEPTED = 128,
+	HACK_CODE_ADMINISTRATIVELY_PROHIBITED,
+	HACK_CODE_INSUFFICIENT_RESOURCES
+  };
+  
+  enum LraStatus_e {
+    LRA_STATUS_SUCCESS = 0,
+	LRA_STATUS_NOT_ALLOWED = 128,
+	LRA_STATUS_MN_NOT_ATTACHED
+  };
   
   enum OptionHandoffIndicator_e {
     OPT_HI_RESERVED = 0,
@@ -459,6 +492,18 @@ public:
    */
   void SetFlagP(bool p);
 
+  /**
+   * \brief Get the B flag (bulk binding update, RFC 6602).
+   * \return B flag
+   */
+  bool GetFlagB() const;
+  
+  /**
+   * \brief Set the B flag.
+   * \param b value
+   */
+  void SetFlagB(bool b);
+
   /**
    * \brief Get the Reserved value.
    * \return Reserved value
@@ -550,6 +595,11 @@ private:
    */
   bool m_flagP;
 
+  /**
+   * \brief The B flag.
+   */
+  bool m_flagB;
+
   /**
    * \brief The reserved value.
    */
@@ -638,6 +688,18 @@ public:
    */
   void SetFlagP(bool p);
 
+  /**
+   * \brief Get the B flag (bulk binding update, RFC 6602).
+   * \return B flag
+   */
+  bool GetFlagB() const;
+  
+  /**
+   * \brief Set the B flag.
+   * \param b value
+   */
+  void SetFlagB(bool b);
+
   /**
    * \brief Get the Reserved2 field.
    * \return reserved2 value
@@ -721,6 +783,11 @@ private:
    */
   bool m_flagP;
 
+  /**
+   * \brief The B flag.
+   */
+  bool m_flagB;
+
   /**
    * \brief The reserved value.
    */
@@ -737,6 +804,547 @@ private:
   uint16_t m_lifetime;
 };
 
+/**
+ * \class Ipv6MobilityHandoverInitiateHeader
+ * \brief Ipv6 Mobility Handover Initiate header (RFC 5568).
+ *
+ * Sent by the previous MAG to the next MAG of a MN about to move, with
+ * the P flag and the context of the MN as options (RFC 5949).
+ */
+class Ipv6MobilityHandoverInitiateHeader : public Ipv6MobilityHeader, public MobilityOptionField
+{
+public:
+  /**
+   * \brief Get the UID of this class.
+   * \return UID
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief Get the instance type ID.
+   * \return instance type ID
+   */
+  virtual TypeId GetInstanceTypeId () const;
+
+  /**
+   * \brief Constructor.
+   */
+  Ipv6MobilityHandoverInitiateHeader ();
+
+  /**
+   * \brief Destructor.
+   */
+  virtual ~Ipv6MobilityHandoverInitiateHeader ();
+
+  /**
+   * \brief Get the Sequence field.
+   * \return sequence value
+   */
+  uint16_t GetSequence () const;
+
+  /**
+   * \brief Set the sequence field.
+   * \param sequence the sequence value
+   */
+  void SetSequence (uint16_t sequence);
+
+  /**
+   * \brief Get the Code field.
+   * \return code value
+   */
+  uint8_t GetCode () const;
+
+  /**
+   * \brief Set the Code field.
+   * \param code the code value
+   */
+  void SetCode (uint8_t code);
+
+  /**
+   * \brief Get the S flag (assigned address configuration).
+   * \return S flag
+   */
+  bool GetFlagS() const;
+  
+  /**
+   * \brief Set the S flag.
+   * \param s value
+   */
+  void SetFlagS(bool s);
+
+  /**
+   * \brief Get the U flag (buffer request).
+   * \return U flag
+   */
+  bool GetFlagU() const;
+  
+  /**
+   * \brief Set the U flag.
+   * \param u value
+   */
+  void SetFlagU(bool u);
+
+  /**
+   * \brief Get the P flag (proxy, RFC 5949).
+   * \return P flag
+   */
+  bool GetFlagP() const;
+  
+  /**
+   * \brief Set the P flag.
+   * \param p value
+   */
+  void SetFlagP(bool p);
+
+  /**
+   * \brief Get the F flag (forwarding request).
+   * \return F flag
+   */
+  bool GetFlagF() const;
+  
+  /**
+   * \brief Set the F flag.
+   * \param f value
+   */
+  void SetFlagF(bool f);
+
+  /**
+   * \brief Print informations.
+   * \param os output stream
+   */
+  virtual void Print (std::ostream& os) const;
+
+  /**
+   * \brief Get the serialized size.
+   * \return serialized size
+   */
+  virtual uint32_t GetSerializedSize () const;
+
+  /**
+   * \brief Serialize the packet.
+   * \param start start offset
+   */
+  virtual void Serialize (Buffer::Iterator start) const;
+
+  /**
+   * \brief Deserialize the packet.
+   * \param start start offset
+   * \return length of packet
+   */
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+
+private:
+
+  /**
+   * \brief The S flag.
+   */
+  bool m_flagS;
+
+  /**
+   * \brief The U flag.
+   */
+  bool m_flagU;
+
+  /**
+   * \brief The P flag.
+   */
+  bool m_flagP;
+
+  /**
+   * \brief The F flag.
+   */
+  bool m_flagF;
+
+  /**
+   * \brief The reserved value.
+   */
+  uint8_t m_reserved2;
+
+  /**
+   * \brief The Sequence field
+   */
+  uint16_t m_sequence;
+
+  /**
+   * \brief The Code field.
+   */
+  uint8_t m_code;
+};
+
+/**
+ * \class Ipv6MobilityHandoverAckHeader
+ * \brief Ipv6 Mobility Handover Acknowledge header (RFC 5568).
+ */
+class Ipv6MobilityHandoverAckHeader : public Ipv6MobilityHeader, public MobilityOptionField
+{
+public:
+  /**
+   * \brief Get the UID of this class.
+   * \return UID
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief Get the instance type ID.
+   * \return instance type ID
+   */
+  virtual TypeId GetInstanceTypeId () const;
+
+  /**
+   * \brief Constructor.
+   */
+  Ipv6MobilityHandoverAckHeader ();
+
+  /**
+   * \brief Destructor.
+   */
+  virtual ~Ipv6MobilityHandoverAckHeader ();
+
+  /**
+   * \brief Get the Sequence field.
+   * \return sequence value
+   */
+  uint16_t GetSequence () const;
+
+  /**
+   * \brief Set the sequence field.
+   * \param sequence the sequence value
+   */
+  void SetSequence (uint16_t sequence);
+
+  /**
+   * \brief Get the Code field.
+   * \return code value
+   */
+  uint8_t GetCode () const;
+
+  /**
+   * \brief Set the Code field.
+   * \param code the code value
+   */
+  void SetCode (uint8_t code);
+
+  /**
+   * \brief Get the U flag (buffer request).
+   * \return U flag
+   */
+  bool GetFlagU() const;
+  
+  /**
+   * \brief Set the U flag.
+   * \param u value
+   */
+  void SetFlagU(bool u);
+
+  /**
+   * \brief Get the P flag (proxy, RFC 5949).
+   * \return P flag
+   */
+  bool GetFlagP() const;
+  
+  /**
+   * \brief Set the P flag.
+   * \param p value
+   */
+  void SetFlagP(bool p);
+
+  /**
+   * \brief Get the F flag (forwarding request).
+   * \return F flag
+   */
+  bool GetFlagF() const;
+  
+  /**
+   * \brief Set the F flag.
+   * \param f value
+   */
+  void SetFlagF(bool f);
+
+  /**
+   * \brief Print informations.
+   * \param os output stream
+   */
+  virtual void Print (std::ostream& os) const;
+
+  /**
+   * \brief Get the serialized size.
+   * \return serialized size
+   */
+  virtual uint32_t GetSerializedSize () const;
+
+  /**
+   * \brief Serialize the packet.
+   * \param start start offset
+   */
+  virtual void Serialize (Buffer::Iterator start) const;
+
+  /**
+   * \brief Deserialize the packet.
+   * \param start start offset
+   * \return length of packet
+   */
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+
+private:
+
+  /**
+   * \brief The U flag.
+   */
+  bool m_flagU;
+
+  /**
+   * \brief The P flag.
+   */
+  bool m_flagP;
+
+  /**
+   * \brief The F flag.
+   */
+  bool m_flagF;
+
+  /**
+   * \brief The reserved value.
+   */
+  uint8_t m_reserved2;
+
+  /**
+   * \brief The Sequence field
+   */
+  uint16_t m_sequence;
+
+  /**
+   * \brief The Code field.
+   */
+  uint8_t m_code;
+};
+
+/**
+ * \class Ipv6MobilityLocalizedRoutingInitiationHeader
+ * \brief Ipv6 Mobility Localized Routing Initiation header (RFC 6705).
+ */
+class Ipv6MobilityLocalizedRoutingInitiationHeader : public Ipv6MobilityHeader, public MobilityOptionField
+{
+public:
+  /**
+   * \brief Get the UID of this class.
+   * \return UID
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief Get the instance type ID.
+   * \return instance type ID
+   */
+  virtual TypeId GetInstanceTypeId () const;
+
+  /**
+   * \brief Constructor.
+   */
+  Ipv6MobilityLocalizedRoutingInitiationHeader ();
+
+  /**
+   * \brief Destructor.
+   */
+  virtual ~Ipv6MobilityLocalizedRoutingInitiationHeader ();
+
+  /**
+   * \brief Get the Sequence field.
+   * \return sequence value
+   */
+  uint16_t GetSequence () const;
+
+  /**
+   * \brief Set the sequence field.
+   * \param sequence the sequence value
+   */
+  void SetSequence (uint16_t sequence);
+
+  /**
+   * \brief Get the Lifetime field, in seconds; zero terminates the
+   * localized routing.
+   * \return lifetime value
+   */
+  uint16_t GetLifetime () const;
+
+  /**
+   * \brief Set the Lifetime field.
+   * \param lifetime the lifetime value
+   */
+  void SetLifetime (uint16_t lifetime);
+
+  /**
+   * \brief Print informations.
+   * \param os output stream
+   */
+  virtual void Print (std::ostream& os) const;
+
+  /**
+   * \brief Get the serialized size.
+   * \return serialized size
+   */
+  virtual uint32_t GetSerializedSize () const;
+
+  /**
+   * \brief Serialize the packet.
+   * \param start start offset
+   */
+  virtual void Serialize (Buffer::Iterator start) const;
+
+  /**
+   * \brief Deserialize the packet.
+   * \param start start offset
+   * \return length of packet
+   */
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+
+private:
+
+  /**
+   * \brief The Sequence field
+   */
+  uint16_t m_sequence;
+
+  /**
+   * \brief The reserved value.
+   */
+  uint16_t m_reserved2;
+
+  /**
+   * \brief The Lifetime field.
+   */
+  uint16_t m_lifetime;
+};
+
+/**
+ * \class Ipv6MobilityLocalizedRoutingAckHeader
+ * \brief Ipv6 Mobility Localized Routing Acknowledgement header (RFC 6705).
+ */
+class Ipv6MobilityLocalizedRoutingAckHeader : public Ipv6MobilityHeader, public MobilityOptionField
+{
+public:
+  /**
+   * \brief Get the UID of this class.
+   * \return UID
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief Get the instance type ID.
+   * \return instance type ID
+   */
+  virtual TypeId GetInstanceTypeId () const;
+
+  /**
+   * \brief Constructor.
+   */
+  Ipv6MobilityLocalizedRoutingAckHeader ();
+
+  /**
+   * \brief Destructor.
+   */
+  virtual ~Ipv6MobilityLocalizedRoutingAckHeader ();
+
+  /**
+   * \brief Get the Sequence field.
+   * \return sequence value
+   */
+  uint16_t GetSequence () const;
+
+  /**
+   * \brief Set the sequence field.
+   * \param sequence the sequence value
+   */
+  void SetSequence (uint16_t sequence);
+
+  /**
+   * \brief Get the U flag (unsolicited).
+   * \return U flag
+   */
+  bool GetFlagU () const;
+
+  /**
+   * \brief Set the U flag.
+   * \param u value
+   */
+  void SetFlagU (bool u);
+
+  /**
+   * \brief Get the Status field.
+   * \return status value
+   */
+  uint8_t GetStatus () const;
+
+  /**
+   * \brief Set the Status field.
+   * \param status the status value
+   */
+  void SetStatus (uint8_t status);
+
+  /**
+   * \brief Get the Lifetime field, in seconds.
+   * \return lifetime value
+   */
+  uint16_t GetLifetime () const;
+
+  /**
+   * \brief Set the Lifetime field.
+   * \param lifetime the lifetime value
+   */
+  void SetLifetime (uint16_t lifetime);
+
+  /**
+   * \brief Print informations.
+   * \param os output stream
+   */
+  virtual void Print (std::ostream& os) const;
+
+  /**
+   * \brief Get the serialized size.
+   * \return serialized size
+   */
+  virtual uint32_t GetSerializedSize () const;
+
+  /**
+   * \brief Serialize the packet.
+   * \param start start offset
+   */
+  virtual void Serialize (Buffer::Iterator start) const;
+
+  /**
+   * \brief Deserialize the packet.
+   * \param start start offset
+   * \return length of packet
+   */
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+
+private:
+
+  /**
+   * \brief The Sequence field
+   */
+  uint16_t m_sequence;
+
+  /**
+   * \brief The U flag.
+   */
+  bool m_flagU;
+
+  /**
+   * \brief The reserved value.
+   */
+  uint8_t m_reserved2;
+
+  /**
+   * \brief The Status field.
+   */
+  uint8_t m_status;
+
+  /**
+   * \brief The Lifetime field.
+   */
+  uint16_t m_lifetime;
+};
+
 } /* namespace ns3 */
 
 #endif /* IPV6_MOBILITY_HEADER_H */
@@ -71,6 +71,8 @@ const uint32_t Ipv6MobilityL4Protocol::MIN_DELAY_BEFORE_NEW_BCE_ASSIGN = 1500;
 
 const uint32_t Ipv6MobilityL4Protocol::TIMESTAMP_VALIDITY_WINDOW = 300;
 
+const uint32_t Ipv6MobilityL4Protocol::HANDOVER_CONTEXT_LIFETIME = 5000;
+
 TypeId Ipv6MobilityL4Protocol::GetTypeId ()
 {
   static TypeId tid = TypeId ("ns3::Ipv6MobilityL4Protocol")
@@ -193,6 +195,22 @@ void Ipv6MobilityL4Protocol::RegisterMobility()
   Ptr<Ipv6MobilityBindingAck> ba = CreateObject<Ipv6MobilityBindingAck>();
   ba->SetNode(m_node);
   ipv6MobilityDemux->Insert(ba);  
+  
+  Ptr<Ipv6MobilityHandoverInitiate> hi = CreateObject<Ipv6MobilityHandoverInitiate>();
+  hi->SetNode(m_node);
+  ipv6MobilityDemux->Insert(hi);
+  
+  Ptr<Ipv6MobilityHandoverAck> hack = CreateObject<Ipv6MobilityHandoverAck>();
+  hack->SetNode(m_node);
+  ipv6MobilityDemux->Insert(hack);
+  
+  Ptr<Ipv6MobilityLocalizedRoutingInitiation> lri = CreateObject<Ipv6MobilityLocalizedRoutingInitiation>();
+  lri->SetNode(m_node);
+  ipv6MobilityDemux->Insert(lri);
+  
+  Ptr<Ipv6MobilityLocalizedRoutingAck> lra = CreateObject<Ipv6MobilityLocalizedRoutingAck>();
+  lra->SetNode(m_node);
+  ipv6MobilityDemux->Insert(lra);
 }
 
 void Ipv6MobilityL4Protocol::RegisterMobilityOptions()
@@ -238,6 +256,24 @@ void Ipv6MobilityL4Protocol::RegisterMobilityOptions()
   Ptr<Ipv6MobilityOptionTimestamp> timestamp = CreateObject<Ipv6MobilityOptionTimestamp>();
   timestamp->SetNode(m_node);
   ipv6MobilityOptionDemux->Insert(timestamp);
+  
+  Ptr<Ipv6MobilityOptionMobileNodeGroupIdentifier> group = CreateObject<Ipv6MobilityOptionMobileNodeGroupIdentifier>();
+  group->SetNode(m_node);
+  ipv6MobilityOptionDemux->Insert(group);
+  
+  //for fast handovers
+  Ptr<Ipv6MobilityOptionIpv6Address> addr = CreateObject<Ipv6MobilityOptionIpv6Address>();
+  addr->SetNode(m_node);
+  ipv6MobilityOptionDemux->Insert(addr);
+  
+  //for runtime LMA assignment
+  Ptr<Ipv6MobilityOptionRedirectCapability> redirectCapability = CreateObject<Ipv6MobilityOptionRedirectCapability>();
+  redirectCapability->SetNode(m_node);
+  ipv6MobilityOptionDemux->Insert(redirectCapability);
+  
+  Ptr<Ipv6MobilityOptionRedirect> redirect = CreateObject<Ipv6MobilityOptionRedirect>();
+  redirect->SetNode(m_node);
+  ipv6MobilityOptionDemux->Insert(redirect);
 }
 
 } /* namespace ns3 */
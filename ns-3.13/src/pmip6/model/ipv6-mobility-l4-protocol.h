@@ -85,6 +85,11 @@ public:
    * \brief The maximum amount of time difference between timestamps
    */  
   static const uint32_t TIMESTAMP_VALIDITY_WINDOW;
+  
+  /**
+   * \brief The amount of time in milliseconds a next MAG keeps the context of a MN pushed by its previous MAG (5000ms)
+   */  
+  static const uint32_t HANDOVER_CONTEXT_LIFETIME;
 
   /**
    * \brief Get PMIPv6 protocol number.
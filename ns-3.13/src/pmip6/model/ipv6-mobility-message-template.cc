@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include "ipv6-mobility-header.h"
+#include "ipv6-mobility-option.h"
+#include "ipv6-mobility-message-template.h"
+
+NS_LOG_COMPONENT_DEFINE ("Ipv6MobilityMessageTemplate");
+
+namespace ns3
+{
+
+Ipv6MobilityMessageTemplate::Ipv6MobilityMessageTemplate ()
+  : m_statusOffset (0),
+    m_sequenceOffset (0),
+    m_lifetimeOffset (0),
+    m_timestampOffset (0)
+{
+}
+
+bool Ipv6MobilityMessageTemplate::IsEmpty () const
+{
+  return m_buffer.empty ();
+}
+
+void Ipv6MobilityMessageTemplate::Clear ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  std::vector<uint8_t> empty;
+
+  /* release the storage too, as the template lives in every binding */
+  m_buffer.swap (empty);
+  m_timestampOffset = 0;
+}
+
+void Ipv6MobilityMessageTemplate::Set (Ptr<const Packet> packet)
+{
+  NS_LOG_FUNCTION (this << packet);
+
+  m_buffer.resize (packet->GetSize ());
+  packet->CopyData (&m_buffer[0], m_buffer.size ());
+
+  NS_ASSERT (m_buffer.size () >= 12);
+
+  /* fixed part, see Ipv6MobilityBindingUpdateHeader::Serialize and
+     Ipv6MobilityBindingAckHeader::Serialize */
+  if (m_buffer[2] == Ipv6MobilityHeader::IPV6_MOBILITY_BINDING_ACKNOWLEDGEMENT)
+    {
+      m_statusOffset = 6;
+      m_sequenceOffset = 8;
+    }
+  else
+    {
+      NS_ASSERT (m_buffer[2] == Ipv6MobilityHeader::IPV6_MOBILITY_BINDING_UPDATE);
+      m_statusOffset = 0;
+      m_sequenceOffset = 6;
+    }
+  m_lifetimeOffset = 10;
+
+  /* both messages carry their options from byte 12 */
+  uint32_t end = std::min ((uint32_t)(m_buffer[1] + 1) << 3, (uint32_t)m_buffer.size ());
+  uint32_t offset = 12;
+
+  m_timestampOffset = 0;
+
+  while (offset + 1 < end)
+    {
+      uint8_t type = m_buffer[offset];
+
+      if (type == Ipv6MobilityOptionPad1::OPT_NUMBER)
+        {
+          offset++;
+          continue;
+        }
+
+      if (type == Ipv6MobilityOptionTimestamp::OPT_NUMBER && offset + 10 <= end)
+        {
+          m_timestampOffset = offset + 2;
+        }
+
+      offset += m_buffer[offset + 1] + 2;
+    }
+}
+
+void Ipv6MobilityMessageTemplate::WriteU16 (uint32_t offset, uint16_t data)
+{
+  m_buffer[offset] = (data >> 8) & 0xff;
+  m_buffer[offset + 1] = data & 0xff;
+}
+
+void Ipv6MobilityMessageTemplate::SetStatus (uint8_t status)
+{
+  NS_ASSERT (!IsEmpty () && m_statusOffset != 0);
+
+  m_buffer[m_statusOffset] = status;
+}
+
+void Ipv6MobilityMessageTemplate::SetSequence (uint16_t sequence)
+{
+  NS_ASSERT (!IsEmpty ());
+
+  WriteU16 (m_sequenceOffset, sequence);
+}
+
+void Ipv6MobilityMessageTemplate::SetLifetime (uint16_t lifetime)
+{
+  NS_ASSERT (!IsEmpty ());
+
+  WriteU16 (m_lifetimeOffset, lifetime);
+}
+
+void Ipv6MobilityMessageTemplate::SetTimestamp (Time timestamp)
+{
+  NS_ASSERT (!IsEmpty ());
+
+  if (m_timestampOffset == 0)
+    {
+      return;
+    }
+
+  uint64_t ts = timestamp.GetMicroSeconds ();
+
+  for (int i = 7; i >= 0; i--)
+    {
+      m_buffer[m_timestampOffset + i] = ts & 0xff;
+      ts >>= 8;
+    }
+}
+
+Ptr<Packet> Ipv6MobilityMessageTemplate::CreatePacket () const
+{
+  NS_ASSERT (!IsEmpty ());
+
+  return Create<Packet> (&m_buffer[0], m_buffer.size ());
+}
+
+} /* namespace ns3 */
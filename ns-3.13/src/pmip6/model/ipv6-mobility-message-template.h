@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef IPV6_MOBILITY_MESSAGE_TEMPLATE_H
+#define IPV6_MOBILITY_MESSAGE_TEMPLATE_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "ns3/ptr.h"
+#include "ns3/packet.h"
+#include "ns3/nstime.h"
+
+namespace ns3
+{
+
+/**
+ * \class Ipv6MobilityMessageTemplate
+ * \brief Serialized Binding Update or Binding Acknowledgement of a binding.
+ *
+ * Between two refreshes of the same binding only the status, the sequence,
+ * the lifetime and the timestamp option of the message change. The template
+ * keeps the wire image of the first message, so that the next ones are
+ * produced by patching these fields instead of building and serializing all
+ * option headers again.
+ */
+class Ipv6MobilityMessageTemplate
+{
+public:
+  Ipv6MobilityMessageTemplate ();
+
+  /**
+   * \brief Whether a message has been kept.
+   */
+  bool IsEmpty () const;
+
+  /**
+   * \brief Forget the kept message, e.g. when an option changes.
+   */
+  void Clear ();
+
+  /**
+   * \brief Keep the wire image of a message.
+   * \param packet packet holding only a Binding Update or Acknowledgement
+   */
+  void Set (Ptr<const Packet> packet);
+
+  void SetStatus (uint8_t status);
+  void SetSequence (uint16_t sequence);
+  void SetLifetime (uint16_t lifetime);
+
+  /**
+   * \brief Patch the timestamp option, if the message has one.
+   */
+  void SetTimestamp (Time timestamp);
+
+  /**
+   * \brief Create a packet holding the (patched) message.
+   */
+  Ptr<Packet> CreatePacket () const;
+
+private:
+  void WriteU16 (uint32_t offset, uint16_t data);
+
+  std::vector<uint8_t> m_buffer;
+  uint32_t m_statusOffset;     //!< 0 for a Binding Update
+  uint32_t m_sequenceOffset;
+  uint32_t m_lifetimeOffset;
+  uint32_t m_timestampOffset;  //!< 0 without timestamp option
+};
+
+} /* namespace ns3 */
+
+#endif /* IPV6_MOBILITY_MESSAGE_TEMPLATE_H */
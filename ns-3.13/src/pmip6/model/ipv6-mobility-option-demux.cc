@@ -22,6 +22,8 @@
  * Author: Hyon-Young Choi <commani@gmail.com>
  */
 
+#include <algorithm>
+
 #include "ns3/assert.h"
 #include "ns3/address-utils.h"
 #include "ns3/log.h"
@@ -48,6 +50,7 @@ TypeId Ipv6MobilityOptionDemux::GetTypeId ()
 }
 
 Ipv6MobilityOptionDemux::Ipv6MobilityOptionDemux ()
+  : m_optionTable (256)
 {
 }
 
@@ -63,6 +66,7 @@ void Ipv6MobilityOptionDemux::DoDispose ()
       *it = 0;
     }
   m_options.clear ();
+  RebuildTable ();
   m_node = 0;
   Object::DoDispose ();
 }
@@ -75,23 +79,43 @@ void Ipv6MobilityOptionDemux::SetNode (Ptr<Node> node)
 void Ipv6MobilityOptionDemux::Insert (Ptr<Ipv6MobilityOption> option)
 {
   m_options.push_back (option);
+
+  uint8_t optionNumber = option->GetMobilityOptionNumber ();
+
+  if (m_optionTable[optionNumber] == 0)
+    {
+      m_optionTable[optionNumber] = option;
+    }
 }
 
 Ptr<Ipv6MobilityOption> Ipv6MobilityOptionDemux::GetOption (int optionNumber)
 {
-  for (Ipv6MobilityOptionList_t::iterator i = m_options.begin (); i != m_options.end (); ++i)
+  if (optionNumber < 0 || optionNumber >= (int)m_optionTable.size ())
     {
-      if ((*i)->GetMobilityOptionNumber () == optionNumber)
-        {
-          return *i;
-        }
+      return 0;
     }
-  return 0;
+  return m_optionTable[optionNumber];
 }
 
 void Ipv6MobilityOptionDemux::Remove (Ptr<Ipv6MobilityOption> option)
 {
   m_options.remove (option);
+  RebuildTable ();
+}
+
+void Ipv6MobilityOptionDemux::RebuildTable ()
+{
+  std::fill (m_optionTable.begin (), m_optionTable.end (), Ptr<Ipv6MobilityOption> (0));
+
+  for (Ipv6MobilityOptionList_t::iterator it = m_options.begin (); it != m_options.end (); ++it)
+    {
+      uint8_t optionNumber = (*it)->GetMobilityOptionNumber ();
+
+      if (m_optionTable[optionNumber] == 0)
+        {
+          m_optionTable[optionNumber] = *it;
+        }
+    }
 }
 
 } /* namespace ns3 */
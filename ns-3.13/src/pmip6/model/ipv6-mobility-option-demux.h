@@ -26,6 +26,7 @@
 #define IPV6_MOBILITY_OPTION_DEMUX_H
 
 #include <list>
+#include <vector>
 
 #include "ns3/header.h"
 #include "ns3/object.h"
@@ -74,6 +75,9 @@ public:
 
   /**
    * \brief Get the option corresponding to optionNumber.
+   *
+   * Options are indexed by number, so the lookup is done in constant time
+   * for every option of a received message.
    * \param optionNumber the option number of the option to retrieve
    * \return a matching IPv6 Mobility option
    */
@@ -94,11 +98,21 @@ protected:
 private:
   typedef std::list<Ptr<Ipv6MobilityOption> > Ipv6MobilityOptionList_t;
 
+  /**
+   * \brief Rebuild the option table from the option list.
+   */
+  void RebuildTable ();
+
   /**
    * \brief List of IPv6 Options supported.
    */
   Ipv6MobilityOptionList_t m_options;
 
+  /**
+   * \brief Options indexed by option number, first inserted wins.
+   */
+  std::vector<Ptr<Ipv6MobilityOption> > m_optionTable;
+
   /**
    * \brief The node.
    */
@@ -909,4 +909,376 @@ Ipv6MobilityOptionHeader::Alignment Ipv6MobilityOptionTimestampHeader::GetAlignm
   return (Alignment){8,6}; //8n+6
 }
 
+NS_OBJECT_ENSURE_REGISTERED(Ipv6MobilityOptionMobileNodeGroupIdentifierHeader);
+
+TypeId Ipv6MobilityOptionMobileNodeGroupIdentifierHeader::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Ipv6MobilityOptionMobileNodeGroupIdentifierHeader")
+    .SetParent<Ipv6MobilityOptionHeader> ()
+    .AddConstructor<Ipv6MobilityOptionMobileNodeGroupIdentifierHeader> ()
+    ;
+  return tid;
+}
+
+TypeId Ipv6MobilityOptionMobileNodeGroupIdentifierHeader::GetInstanceTypeId () const
+{
+  return GetTypeId ();
+}
+
+Ipv6MobilityOptionMobileNodeGroupIdentifierHeader::Ipv6MobilityOptionMobileNodeGroupIdentifierHeader()
+{
+  SetType(Ipv6MobilityHeader::IPV6_MOBILITY_OPT_MOBILE_NODE_GROUP_IDENTIFIER);
+  SetLength(6);
+  
+  m_subType = BULK_BINDING_UPDATE_GROUP;
+  m_reserved = 0;
+  m_groupIdentifier = 0;
+}
+
+Ipv6MobilityOptionMobileNodeGroupIdentifierHeader::Ipv6MobilityOptionMobileNodeGroupIdentifierHeader(uint32_t groupId)
+{
+  SetType(Ipv6MobilityHeader::IPV6_MOBILITY_OPT_MOBILE_NODE_GROUP_IDENTIFIER);
+  SetLength(6);
+  
+  m_subType = BULK_BINDING_UPDATE_GROUP;
+  m_reserved = 0;
+  m_groupIdentifier = groupId;
+}
+
+Ipv6MobilityOptionMobileNodeGroupIdentifierHeader::~Ipv6MobilityOptionMobileNodeGroupIdentifierHeader()
+{
+}
+
+uint8_t Ipv6MobilityOptionMobileNodeGroupIdentifierHeader::GetSubType() const
+{
+  return m_subType;
+}
+
+void Ipv6MobilityOptionMobileNodeGroupIdentifierHeader::SetSubType(uint8_t subType)
+{
+  m_subType = subType;
+}
+
+uint32_t Ipv6MobilityOptionMobileNodeGroupIdentifierHeader::GetGroupIdentifier() const
+{
+  return m_groupIdentifier;
+}
+
+void Ipv6MobilityOptionMobileNodeGroupIdentifierHeader::SetGroupIdentifier(uint32_t groupId)
+{
+  m_groupIdentifier = groupId;
+}
+
+void Ipv6MobilityOptionMobileNodeGroupIdentifierHeader::Print (std::ostream& os) const
+{
+  os << "( type=" << (uint32_t)GetType() << ", length(excluding TL)=" << (uint32_t)GetLength() << ", subtype=" << (uint32_t)m_subType << ", group=" << m_groupIdentifier << ")";
+}
+
+uint32_t Ipv6MobilityOptionMobileNodeGroupIdentifierHeader::GetSerializedSize () const
+{
+  return GetLength()+2;
+}
+
+void Ipv6MobilityOptionMobileNodeGroupIdentifierHeader::Serialize (Buffer::Iterator start) const
+{
+  Buffer::Iterator i = start;
+
+  i.WriteU8(GetType());
+  i.WriteU8(GetLength());
+  i.WriteU8(m_subType);
+  i.WriteU8(m_reserved);
+  i.WriteHtonU32(m_groupIdentifier);
+}
+
+uint32_t Ipv6MobilityOptionMobileNodeGroupIdentifierHeader::Deserialize (Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+  
+  SetType(i.ReadU8());
+  SetLength(i.ReadU8());
+  m_subType = i.ReadU8();
+  m_reserved = i.ReadU8();
+  m_groupIdentifier = i.ReadNtohU32();
+  
+  return GetSerializedSize();
+}
+
+Ipv6MobilityOptionHeader::Alignment Ipv6MobilityOptionMobileNodeGroupIdentifierHeader::GetAlignment () const
+{
+  return (Alignment){4,0}; //4n
+}
+
+NS_OBJECT_ENSURE_REGISTERED(Ipv6MobilityOptionIpv6AddressHeader);
+
+TypeId Ipv6MobilityOptionIpv6AddressHeader::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Ipv6MobilityOptionIpv6AddressHeader")
+    .SetParent<Ipv6MobilityOptionHeader> ()
+    .AddConstructor<Ipv6MobilityOptionIpv6AddressHeader> ()
+    ;
+  return tid;
+}
+
+TypeId Ipv6MobilityOptionIpv6AddressHeader::GetInstanceTypeId () const
+{
+  return GetTypeId ();
+}
+
+Ipv6MobilityOptionIpv6AddressHeader::Ipv6MobilityOptionIpv6AddressHeader()
+{
+  SetType(Ipv6MobilityHeader::IPV6_MOBILITY_OPT_IPV6_ADDRESS_PREFIX);
+  SetLength(18);
+  
+  m_optionCode = LMA_ADDRESS;
+  m_prefixLen = 128;
+  m_address.Set("::");
+}
+
+Ipv6MobilityOptionIpv6AddressHeader::Ipv6MobilityOptionIpv6AddressHeader(uint8_t code, Ipv6Address addr)
+{
+  SetType(Ipv6MobilityHeader::IPV6_MOBILITY_OPT_IPV6_ADDRESS_PREFIX);
+  SetLength(18);
+  
+  m_optionCode = code;
+  m_prefixLen = 128;
+  m_address = addr;
+}
+
+Ipv6MobilityOptionIpv6AddressHeader::~Ipv6MobilityOptionIpv6AddressHeader()
+{
+}
+
+uint8_t Ipv6MobilityOptionIpv6AddressHeader::GetOptionCode() const
+{
+  return m_optionCode;
+}
+
+void Ipv6MobilityOptionIpv6AddressHeader::SetOptionCode(uint8_t code)
+{
+  m_optionCode = code;
+}
+
+uint8_t Ipv6MobilityOptionIpv6AddressHeader::GetPrefixLength() const
+{
+  return m_prefixLen;
+}
+
+void Ipv6MobilityOptionIpv6AddressHeader::SetPrefixLength(uint8_t plen)
+{
+  m_prefixLen = plen;
+}
+
+Ipv6Address Ipv6MobilityOptionIpv6AddressHeader::GetAddress() const
+{
+  return m_address;
+}
+
+void Ipv6MobilityOptionIpv6AddressHeader::SetAddress(Ipv6Address addr)
+{
+  m_address = addr;
+}
+
+void Ipv6MobilityOptionIpv6AddressHeader::Print (std::ostream& os) const
+{
+  os << "( type=" << (uint32_t)GetType() << ", length(excluding TL)=" << (uint32_t)GetLength() << ", code=" << (uint32_t)m_optionCode << ", address=" << m_address << "/" << (uint32_t)m_prefixLen << ")";
+}
+
+uint32_t Ipv6MobilityOptionIpv6AddressHeader::GetSerializedSize () const
+{
+  return GetLength()+2;
+}
+
+void Ipv6MobilityOptionIpv6AddressHeader::Serialize (Buffer::Iterator start) const
+{
+  uint8_t buff_addr[16];
+  Buffer::Iterator i = start;
+
+  i.WriteU8(GetType());
+  i.WriteU8(GetLength());
+  i.WriteU8(m_optionCode);
+  i.WriteU8(m_prefixLen);
+  
+  m_address.Serialize(buff_addr);
+  i.Write(buff_addr, 16);
+}
+
+uint32_t Ipv6MobilityOptionIpv6AddressHeader::Deserialize (Buffer::Iterator start)
+{
+  uint8_t buff[16];
+  Buffer::Iterator i = start;
+  
+  SetType(i.ReadU8());
+  SetLength(i.ReadU8());
+  m_optionCode = i.ReadU8();
+  m_prefixLen = i.ReadU8();
+  
+  i.Read(buff, 16);
+  m_address.Set(buff);
+  
+  return GetSerializedSize();
+}
+
+Ipv6MobilityOptionHeader::Alignment Ipv6MobilityOptionIpv6AddressHeader::GetAlignment () const
+{
+  return (Alignment){8,4}; //8n+4
+}
+
+NS_OBJECT_ENSURE_REGISTERED(Ipv6MobilityOptionRedirectCapabilityHeader);
+
+TypeId Ipv6MobilityOptionRedirectCapabilityHeader::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Ipv6MobilityOptionRedirectCapabilityHeader")
+    .SetParent<Ipv6MobilityOptionHeader> ()
+    .AddConstructor<Ipv6MobilityOptionRedirectCapabilityHeader> ()
+    ;
+  return tid;
+}
+
+TypeId Ipv6MobilityOptionRedirectCapabilityHeader::GetInstanceTypeId () const
+{
+  return GetTypeId ();
+}
+
+Ipv6MobilityOptionRedirectCapabilityHeader::Ipv6MobilityOptionRedirectCapabilityHeader()
+{
+  SetType(Ipv6MobilityHeader::IPV6_MOBILITY_OPT_REDIRECT_CAPABILITY);
+  SetLength(2);
+  
+  m_reserved = 0;
+}
+
+Ipv6MobilityOptionRedirectCapabilityHeader::~Ipv6MobilityOptionRedirectCapabilityHeader()
+{
+}
+
+void Ipv6MobilityOptionRedirectCapabilityHeader::Print (std::ostream& os) const
+{
+  os << "( type=" << (uint32_t)GetType() << ", length(excluding TL)=" << (uint32_t)GetLength() << ")";
+}
+
+uint32_t Ipv6MobilityOptionRedirectCapabilityHeader::GetSerializedSize () const
+{
+  return GetLength()+2;
+}
+
+void Ipv6MobilityOptionRedirectCapabilityHeader::Serialize (Buffer::Iterator start) const
+{
+  Buffer::Iterator i = start;
+
+  i.WriteU8(GetType());
+  i.WriteU8(GetLength());
+  i.WriteHtonU16(m_reserved);
+}
+
+uint32_t Ipv6MobilityOptionRedirectCapabilityHeader::Deserialize (Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+  
+  SetType(i.ReadU8());
+  SetLength(i.ReadU8());
+  m_reserved = i.ReadNtohU16();
+  
+  return GetSerializedSize();
+}
+
+Ipv6MobilityOptionHeader::Alignment Ipv6MobilityOptionRedirectCapabilityHeader::GetAlignment () const
+{
+  return (Alignment){1,0}; //no alignment
+}
+
+NS_OBJECT_ENSURE_REGISTERED(Ipv6MobilityOptionRedirectHeader);
+
+TypeId Ipv6MobilityOptionRedirectHeader::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Ipv6MobilityOptionRedirectHeader")
+    .SetParent<Ipv6MobilityOptionHeader> ()
+    .AddConstructor<Ipv6MobilityOptionRedirectHeader> ()
+    ;
+  return tid;
+}
+
+TypeId Ipv6MobilityOptionRedirectHeader::GetInstanceTypeId () const
+{
+  return GetTypeId ();
+}
+
+Ipv6MobilityOptionRedirectHeader::Ipv6MobilityOptionRedirectHeader()
+{
+  SetType(Ipv6MobilityHeader::IPV6_MOBILITY_OPT_REDIRECT);
+  SetLength(18);
+  
+  m_flags = 0x80; //K: IPv6 r2LMA address present
+  m_reserved = 0;
+  m_lmaAddress = Ipv6Address::GetAny ();
+}
+
+Ipv6MobilityOptionRedirectHeader::Ipv6MobilityOptionRedirectHeader(Ipv6Address lma)
+{
+  SetType(Ipv6MobilityHeader::IPV6_MOBILITY_OPT_REDIRECT);
+  SetLength(18);
+  
+  m_flags = 0x80;
+  m_reserved = 0;
+  m_lmaAddress = lma;
+}
+
+Ipv6MobilityOptionRedirectHeader::~Ipv6MobilityOptionRedirectHeader()
+{
+}
+
+Ipv6Address Ipv6MobilityOptionRedirectHeader::GetLmaAddress() const
+{
+  return m_lmaAddress;
+}
+
+void Ipv6MobilityOptionRedirectHeader::SetLmaAddress(Ipv6Address lma)
+{
+  m_lmaAddress = lma;
+}
+
+void Ipv6MobilityOptionRedirectHeader::Print (std::ostream& os) const
+{
+  os << "( type=" << (uint32_t)GetType() << ", length(excluding TL)=" << (uint32_t)GetLength() << ", r2LMA=" << m_lmaAddress << ")";
+}
+
+uint32_t Ipv6MobilityOptionRedirectHeader::GetSerializedSize () const
+{
+  return GetLength()+2;
+}
+
+void Ipv6MobilityOptionRedirectHeader::Serialize (Buffer::Iterator start) const
+{
+  uint8_t buff_addr[16];
+  Buffer::Iterator i = start;
+
+  i.WriteU8(GetType());
+  i.WriteU8(GetLength());
+  i.WriteU8(m_flags);
+  i.WriteU8(m_reserved);
+  
+  m_lmaAddress.Serialize(buff_addr);
+  i.Write(buff_addr, 16);
+}
+
+uint32_t Ipv6MobilityOptionRedirectHeader::Deserialize (Buffer::Iterator start)
+{
+  uint8_t buff[16];
+  Buffer::Iterator i = start;
+  
+  SetType(i.ReadU8());
+  SetLength(i.ReadU8());
+  m_flags = i.ReadU8();
+  m_reserved = i.ReadU8();
+  
+  i.Read(buff, 16);
+  m_lmaAddress.Set(buff);
+  
+  return GetSerializedSize();
+}
+
+Ipv6MobilityOptionHeader::Alignment Ipv6MobilityOptionRedirectHeader::GetAlignment () const
+{
+  return (Alignment){8,4}; //8n+4
+}
+
 } /* namespace ns3 */
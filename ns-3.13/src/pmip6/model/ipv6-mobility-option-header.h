@@ -399,6 +399,161 @@ private:
   Time m_timestamp;
 };
 
+/**
+ * \class Ipv6MobilityOptionMobileNodeGroupIdentifierHeader
+ * \brief Mobile Node Group Identifier option (RFC 6602).
+ *
+ * Names the group a binding belongs to, so that all the bindings of a
+ * group can be refreshed or revoked by a single bulk binding update.
+ */
+class Ipv6MobilityOptionMobileNodeGroupIdentifierHeader : public Ipv6MobilityOptionHeader
+{
+public:
+  enum SubType_e
+  {
+    BULK_BINDING_UPDATE_GROUP = 1
+  };
+
+  static TypeId GetTypeId ();
+  virtual TypeId GetInstanceTypeId () const;
+
+  Ipv6MobilityOptionMobileNodeGroupIdentifierHeader();
+  Ipv6MobilityOptionMobileNodeGroupIdentifierHeader(uint32_t groupId);
+  
+  virtual ~Ipv6MobilityOptionMobileNodeGroupIdentifierHeader();
+
+  uint8_t GetSubType() const;
+  void SetSubType(uint8_t subType);
+  
+  uint32_t GetGroupIdentifier() const;
+  void SetGroupIdentifier(uint32_t groupId);
+  
+  virtual void Print (std::ostream& os) const;
+  virtual uint32_t GetSerializedSize () const;
+  virtual void Serialize (Buffer::Iterator start) const;
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+  virtual Alignment GetAlignment () const;
+ 
+protected:
+
+private:
+  uint8_t m_subType;
+  uint8_t m_reserved;
+  uint32_t m_groupIdentifier;
+};
+
+/**
+ * \class Ipv6MobilityOptionIpv6AddressHeader
+ * \brief Mobility Header IPv6 Address/Prefix option (RFC 5568).
+ *
+ * Carries the LMA address in the context transferred between MAGs
+ * (RFC 5949), and the address of the peer MAG in a Localized Routing
+ * Initiation (RFC 6705).
+ */
+class Ipv6MobilityOptionIpv6AddressHeader : public Ipv6MobilityOptionHeader
+{
+public:
+  enum OptionCode_e
+  {
+    LMA_ADDRESS = 5,
+    MAG_ADDRESS
+  };
+
+  static TypeId GetTypeId ();
+  virtual TypeId GetInstanceTypeId () const;
+
+  Ipv6MobilityOptionIpv6AddressHeader();
+  Ipv6MobilityOptionIpv6AddressHeader(uint8_t code, Ipv6Address addr);
+  
+  virtual ~Ipv6MobilityOptionIpv6AddressHeader();
+
+  uint8_t GetOptionCode() const;
+  void SetOptionCode(uint8_t code);
+  
+  uint8_t GetPrefixLength() const;
+  void SetPrefixLength(uint8_t plen);
+  
+  Ipv6Address GetAddress() const;
+  void SetAddress(Ipv6Address addr);
+  
+  virtual void Print (std::ostream& os) const;
+  virtual uint32_t GetSerializedSize () const;
+  virtual void Serialize (Buffer::Iterator start) const;
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+  virtual Alignment GetAlignment () const;
+ 
+protected:
+
+private:
+  uint8_t m_optionCode;
+  uint8_t m_prefixLen;
+  Ipv6Address m_address;
+};
+
+/**
+ * \class Ipv6MobilityOptionRedirectCapabilityHeader
+ * \brief Redirect-Capability option (RFC 6463).
+ *
+ * Sent by a MAG in its initial PBUs to tell the LMA that it accepts
+ * to be redirected to another LMA.
+ */
+class Ipv6MobilityOptionRedirectCapabilityHeader : public Ipv6MobilityOptionHeader
+{
+public:
+  static TypeId GetTypeId ();
+  virtual TypeId GetInstanceTypeId () const;
+
+  Ipv6MobilityOptionRedirectCapabilityHeader();
+  
+  virtual ~Ipv6MobilityOptionRedirectCapabilityHeader();
+
+  virtual void Print (std::ostream& os) const;
+  virtual uint32_t GetSerializedSize () const;
+  virtual void Serialize (Buffer::Iterator start) const;
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+  virtual Alignment GetAlignment () const;
+ 
+protected:
+
+private:
+  uint16_t m_reserved;
+};
+
+/**
+ * \class Ipv6MobilityOptionRedirectHeader
+ * \brief Redirect option (RFC 6463), IPv6 r2LMA address only.
+ *
+ * Sent by a LMA in the PBA to redirect the MAG to another LMA, the
+ * r2LMA, which the MAG registers the mobile node with instead.
+ */
+class Ipv6MobilityOptionRedirectHeader : public Ipv6MobilityOptionHeader
+{
+public:
+  static TypeId GetTypeId ();
+  virtual TypeId GetInstanceTypeId () const;
+
+  Ipv6MobilityOptionRedirectHeader();
+  Ipv6MobilityOptionRedirectHeader(Ipv6Address lma);
+  
+  virtual ~Ipv6MobilityOptionRedirectHeader();
+
+  Ipv6Address GetLmaAddress() const;
+  void SetLmaAddress(Ipv6Address lma);
+  
+  virtual void Print (std::ostream& os) const;
+  virtual uint32_t GetSerializedSize () const;
+  virtual void Serialize (Buffer::Iterator start) const;
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+  virtual Alignment GetAlignment () const;
+ 
+protected:
+
+private:
+  uint8_t m_flags;
+  uint8_t m_reserved;
+  Ipv6Address m_lmaAddress;
+};
+
 } /* namespace ns3 */
 
 #endif /* IPV6_MOBILITY_OPTION_HEADER_H */
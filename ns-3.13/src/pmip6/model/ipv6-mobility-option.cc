@@ -60,12 +60,21 @@ void Ipv6MobilityOption::SetNode (Ptr<Node> node)
   m_node = node;
 }
 
+uint8_t Ipv6MobilityOption::Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle)
+{
+  NS_LOG_FUNCTION ( this << (uint32_t)length );
+  
+  return 0;
+}
+
 Ipv6MobilityOptionBundle::Ipv6MobilityOptionBundle()
  : m_mnIdentifier(),
    m_mnLinkIdentifier(),
    m_accessTechnologyType(0),
    m_handoffIndicator(0),
-   m_timestamp(Seconds(0.0))
+   m_timestamp(Seconds(0.0)),
+   m_mnGroupIdentifier(0),
+   m_redirectCapability(false)
 {
   NS_LOG_FUNCTION_NOARGS();
 }
@@ -175,6 +184,76 @@ void Ipv6MobilityOptionBundle::SetTimestamp(Time tm)
   m_timestamp = tm;
 }
 
+uint32_t Ipv6MobilityOptionBundle::GetMnGroupIdentifier() const
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  return m_mnGroupIdentifier;
+}
+
+void Ipv6MobilityOptionBundle::SetMnGroupIdentifier(uint32_t groupId)
+{
+  NS_LOG_FUNCTION ( this << groupId );
+  
+  m_mnGroupIdentifier = groupId;
+}
+
+Ipv6Address Ipv6MobilityOptionBundle::GetLmaAddress() const
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  return m_lmaAddress;
+}
+
+void Ipv6MobilityOptionBundle::SetLmaAddress(Ipv6Address lma)
+{
+  NS_LOG_FUNCTION ( this << lma );
+  
+  m_lmaAddress = lma;
+}
+
+Ipv6Address Ipv6MobilityOptionBundle::GetMagAddress() const
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  return m_magAddress;
+}
+
+void Ipv6MobilityOptionBundle::SetMagAddress(Ipv6Address mag)
+{
+  NS_LOG_FUNCTION ( this << mag );
+  
+  m_magAddress = mag;
+}
+
+bool Ipv6MobilityOptionBundle::HasRedirectCapability() const
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  return m_redirectCapability;
+}
+
+void Ipv6MobilityOptionBundle::SetRedirectCapability(bool redirect)
+{
+  NS_LOG_FUNCTION ( this << redirect );
+  
+  m_redirectCapability = redirect;
+}
+
+Ipv6Address Ipv6MobilityOptionBundle::GetRedirectLmaAddress() const
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  return m_redirectLmaAddress;
+}
+
+void Ipv6MobilityOptionBundle::SetRedirectLmaAddress(Ipv6Address lma)
+{
+  NS_LOG_FUNCTION ( this << lma );
+  
+  m_redirectLmaAddress = lma;
+}
+
 NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityOptionPad1);
 
 TypeId Ipv6MobilityOptionPad1::GetTypeId ()
@@ -212,6 +291,13 @@ uint8_t Ipv6MobilityOptionPad1::Process (Ptr<Packet> packet, uint8_t offset, Ipv
   return pad1.GetSerializedSize();
 }
 
+uint8_t Ipv6MobilityOptionPad1::Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle)
+{
+  NS_LOG_FUNCTION ( this << (uint32_t)length );
+  
+  return length;
+}
+
 NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityOptionPadn);
 
 TypeId Ipv6MobilityOptionPadn::GetTypeId ()
@@ -249,6 +335,13 @@ uint8_t Ipv6MobilityOptionPadn::Process (Ptr<Packet> packet, uint8_t offset, Ipv
   return padn.GetSerializedSize();
 }
 
+uint8_t Ipv6MobilityOptionPadn::Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle)
+{
+  NS_LOG_FUNCTION ( this << (uint32_t)length );
+  
+  return length;
+}
+
 NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityOptionMobileNodeIdentifier);
 
 TypeId Ipv6MobilityOptionMobileNodeIdentifier::GetTypeId ()
@@ -291,6 +384,24 @@ uint8_t Ipv6MobilityOptionMobileNodeIdentifier::Process (Ptr<Packet> packet, uin
   return nai.GetSerializedSize();
 }
 
+uint8_t Ipv6MobilityOptionMobileNodeIdentifier::Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle)
+{
+  NS_LOG_FUNCTION ( this << (uint32_t)length );
+  
+  if (length < 3)
+    {
+      NS_LOG_LOGIC ("Truncated option, ignored");
+      return length;
+    }
+  
+  if ( data[2] == 1 ) //Network Address Identifier
+    {
+      bundle.SetMnIdentifier(Identifier(data + 3, length - 3));
+    }
+
+  return length;
+}
+
 NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityOptionHomeNetworkPrefix);
 
 TypeId Ipv6MobilityOptionHomeNetworkPrefix::GetTypeId ()
@@ -330,6 +441,21 @@ uint8_t Ipv6MobilityOptionHomeNetworkPrefix::Process (Ptr<Packet> packet, uint8_
   return hnp.GetSerializedSize();
 }
 
+uint8_t Ipv6MobilityOptionHomeNetworkPrefix::Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle)
+{
+  NS_LOG_FUNCTION ( this << (uint32_t)length );
+  
+  if (length < 20)
+    {
+      NS_LOG_LOGIC ("Truncated option, ignored");
+      return length;
+    }
+  
+  bundle.AddHomeNetworkPrefix(Ipv6Address(const_cast<uint8_t *> (data + 4)));
+
+  return length;
+}
+
 NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityOptionHandoffIndicator);
 
 TypeId Ipv6MobilityOptionHandoffIndicator::GetTypeId ()
@@ -369,6 +495,21 @@ uint8_t Ipv6MobilityOptionHandoffIndicator::Process (Ptr<Packet> packet, uint8_t
   return hi.GetSerializedSize();
 }
 
+uint8_t Ipv6MobilityOptionHandoffIndicator::Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle)
+{
+  NS_LOG_FUNCTION ( this << (uint32_t)length );
+  
+  if (length < 4)
+    {
+      NS_LOG_LOGIC ("Truncated option, ignored");
+      return length;
+    }
+  
+  bundle.SetHandoffIndicator(data[3]);
+
+  return length;
+}
+
 NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityOptionAccessTechnologyType);
 
 TypeId Ipv6MobilityOptionAccessTechnologyType::GetTypeId ()
@@ -408,6 +549,21 @@ uint8_t Ipv6MobilityOptionAccessTechnologyType::Process (Ptr<Packet> packet, uin
   return att.GetSerializedSize();
 }
 
+uint8_t Ipv6MobilityOptionAccessTechnologyType::Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle)
+{
+  NS_LOG_FUNCTION ( this << (uint32_t)length );
+  
+  if (length < 4)
+    {
+      NS_LOG_LOGIC ("Truncated option, ignored");
+      return length;
+    }
+  
+  bundle.SetAccessTechnologyType(data[3]);
+
+  return length;
+}
+
 NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityOptionMobileNodeLinkLayerIdentifier);
 
 TypeId Ipv6MobilityOptionMobileNodeLinkLayerIdentifier::GetTypeId ()
@@ -447,6 +603,21 @@ uint8_t Ipv6MobilityOptionMobileNodeLinkLayerIdentifier::Process (Ptr<Packet> pa
   return mnllid.GetSerializedSize();
 }
 
+uint8_t Ipv6MobilityOptionMobileNodeLinkLayerIdentifier::Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle)
+{
+  NS_LOG_FUNCTION ( this << (uint32_t)length );
+  
+  if (length < 4)
+    {
+      NS_LOG_LOGIC ("Truncated option, ignored");
+      return length;
+    }
+  
+  bundle.SetMnLinkIdentifier(Identifier(data + 4, length - 4));
+
+  return length;
+}
+
 NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityOptionLinkLocalAddress);
 
 TypeId Ipv6MobilityOptionLinkLocalAddress::GetTypeId ()
@@ -486,6 +657,21 @@ uint8_t Ipv6MobilityOptionLinkLocalAddress::Process (Ptr<Packet> packet, uint8_t
   return lla.GetSerializedSize();
 }
 
+uint8_t Ipv6MobilityOptionLinkLocalAddress::Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle)
+{
+  NS_LOG_FUNCTION ( this << (uint32_t)length );
+  
+  if (length < 18)
+    {
+      NS_LOG_LOGIC ("Truncated option, ignored");
+      return length;
+    }
+  
+  bundle.SetMagLinkAddress(Ipv6Address(const_cast<uint8_t *> (data + 2)));
+
+  return length;
+}
+
 NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityOptionTimestamp);
 
 TypeId Ipv6MobilityOptionTimestamp::GetTypeId ()
@@ -525,4 +711,264 @@ uint8_t Ipv6MobilityOptionTimestamp::Process (Ptr<Packet> packet, uint8_t offset
   return timestamp.GetSerializedSize();
 }
 
+uint8_t Ipv6MobilityOptionTimestamp::Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle)
+{
+  NS_LOG_FUNCTION ( this << (uint32_t)length );
+  
+  if (length < 10)
+    {
+      NS_LOG_LOGIC ("Truncated option, ignored");
+      return length;
+    }
+  
+  uint64_t timestamp = 0;
+  
+  for (uint8_t i = 2; i < 10; i++)
+    {
+      timestamp = (timestamp << 8) | data[i];
+    }
+  
+  bundle.SetTimestamp(MicroSeconds (timestamp));
+
+  return length;
+}
+
+NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityOptionMobileNodeGroupIdentifier);
+
+TypeId Ipv6MobilityOptionMobileNodeGroupIdentifier::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Ipv6MobilityOptionMobileNodeGroupIdentifier")
+    .SetParent<Ipv6MobilityOption>()
+	;
+  return tid;
+}
+
+Ipv6MobilityOptionMobileNodeGroupIdentifier::~Ipv6MobilityOptionMobileNodeGroupIdentifier()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+uint8_t Ipv6MobilityOptionMobileNodeGroupIdentifier::GetMobilityOptionNumber () const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  return OPT_NUMBER;
+}
+
+uint8_t Ipv6MobilityOptionMobileNodeGroupIdentifier::Process (Ptr<Packet> packet, uint8_t offset, Ipv6MobilityOptionBundle& bundle)
+{
+  NS_LOG_FUNCTION ( this << packet );
+  
+  Ptr<Packet> p = packet->Copy();
+  
+  p->RemoveAtStart(offset);
+  
+  Ipv6MobilityOptionMobileNodeGroupIdentifierHeader group;
+  
+  p->RemoveHeader(group);
+  
+  if (group.GetSubType() == Ipv6MobilityOptionMobileNodeGroupIdentifierHeader::BULK_BINDING_UPDATE_GROUP)
+    {
+      bundle.SetMnGroupIdentifier(group.GetGroupIdentifier());
+    }
+ 
+  return group.GetSerializedSize();
+}
+
+uint8_t Ipv6MobilityOptionMobileNodeGroupIdentifier::Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle)
+{
+  NS_LOG_FUNCTION ( this << (uint32_t)length );
+  
+  if (length < 8)
+    {
+      NS_LOG_LOGIC ("Truncated option, ignored");
+      return length;
+    }
+  
+  if (data[2] != Ipv6MobilityOptionMobileNodeGroupIdentifierHeader::BULK_BINDING_UPDATE_GROUP)
+    {
+      NS_LOG_LOGIC ("Unknown group sub-type " << (uint32_t)data[2] << ", ignored");
+      return length;
+    }
+  
+  bundle.SetMnGroupIdentifier(((uint32_t)data[4] << 24) | ((uint32_t)data[5] << 16) | ((uint32_t)data[6] << 8) | data[7]);
+
+  return length;
+}
+
+NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityOptionIpv6Address);
+
+TypeId Ipv6MobilityOptionIpv6Address::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Ipv6MobilityOptionIpv6Address")
+    .SetParent<Ipv6MobilityOption>()
+	;
+  return tid;
+}
+
+Ipv6MobilityOptionIpv6Address::~Ipv6MobilityOptionIpv6Address()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+uint8_t Ipv6MobilityOptionIpv6Address::GetMobilityOptionNumber () const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  return OPT_NUMBER;
+}
+
+uint8_t Ipv6MobilityOptionIpv6Address::Process (Ptr<Packet> packet, uint8_t offset, Ipv6MobilityOptionBundle& bundle)
+{
+  NS_LOG_FUNCTION ( this << packet );
+  
+  Ptr<Packet> p = packet->Copy();
+  
+  p->RemoveAtStart(offset);
+  
+  Ipv6MobilityOptionIpv6AddressHeader addr;
+  
+  p->RemoveHeader(addr);
+  
+  if (addr.GetOptionCode() == Ipv6MobilityOptionIpv6AddressHeader::LMA_ADDRESS)
+    {
+      bundle.SetLmaAddress(addr.GetAddress());
+    }
+  else if (addr.GetOptionCode() == Ipv6MobilityOptionIpv6AddressHeader::MAG_ADDRESS)
+    {
+      bundle.SetMagAddress(addr.GetAddress());
+    }
+ 
+  return addr.GetSerializedSize();
+}
+
+uint8_t Ipv6MobilityOptionIpv6Address::Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle)
+{
+  NS_LOG_FUNCTION ( this << (uint32_t)length );
+  
+  if (length < 20)
+    {
+      NS_LOG_LOGIC ("Truncated option, ignored");
+      return length;
+    }
+  
+  if (data[2] == Ipv6MobilityOptionIpv6AddressHeader::LMA_ADDRESS)
+    {
+      bundle.SetLmaAddress(Ipv6Address(const_cast<uint8_t *> (data + 4)));
+    }
+  else if (data[2] == Ipv6MobilityOptionIpv6AddressHeader::MAG_ADDRESS)
+    {
+      bundle.SetMagAddress(Ipv6Address(const_cast<uint8_t *> (data + 4)));
+    }
+  else
+    {
+      NS_LOG_LOGIC ("Unknown option code " << (uint32_t)data[2] << ", ignored");
+    }
+
+  return length;
+}
+
+NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityOptionRedirectCapability);
+
+TypeId Ipv6MobilityOptionRedirectCapability::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Ipv6MobilityOptionRedirectCapability")
+    .SetParent<Ipv6MobilityOption>()
+	;
+  return tid;
+}
+
+Ipv6MobilityOptionRedirectCapability::~Ipv6MobilityOptionRedirectCapability()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+uint8_t Ipv6MobilityOptionRedirectCapability::GetMobilityOptionNumber () const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  return OPT_NUMBER;
+}
+
+uint8_t Ipv6MobilityOptionRedirectCapability::Process (Ptr<Packet> packet, uint8_t offset, Ipv6MobilityOptionBundle& bundle)
+{
+  NS_LOG_FUNCTION ( this << packet );
+  
+  Ptr<Packet> p = packet->Copy();
+  
+  p->RemoveAtStart(offset);
+  
+  Ipv6MobilityOptionRedirectCapabilityHeader redirect;
+  
+  p->RemoveHeader(redirect);
+  
+  bundle.SetRedirectCapability(true);
+ 
+  return redirect.GetSerializedSize();
+}
+
+uint8_t Ipv6MobilityOptionRedirectCapability::Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle)
+{
+  NS_LOG_FUNCTION ( this << (uint32_t)length );
+  
+  bundle.SetRedirectCapability(true);
+
+  return length;
+}
+
+NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityOptionRedirect);
+
+TypeId Ipv6MobilityOptionRedirect::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Ipv6MobilityOptionRedirect")
+    .SetParent<Ipv6MobilityOption>()
+	;
+  return tid;
+}
+
+Ipv6MobilityOptionRedirect::~Ipv6MobilityOptionRedirect()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+uint8_t Ipv6MobilityOptionRedirect::GetMobilityOptionNumber () const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  return OPT_NUMBER;
+}
+
+uint8_t Ipv6MobilityOptionRedirect::Process (Ptr<Packet> packet, uint8_t offset, Ipv6MobilityOptionBundle& bundle)
+{
+  NS_LOG_FUNCTION ( this << packet );
+  
+  Ptr<Packet> p = packet->Copy();
+  
+  p->RemoveAtStart(offset);
+  
+  Ipv6MobilityOptionRedirectHeader redirect;
+  
+  p->RemoveHeader(redirect);
+  
+  bundle.SetRedirectLmaAddress(redirect.GetLmaAddress());
+ 
+  return redirect.GetSerializedSize();
+}
+
+uint8_t Ipv6MobilityOptionRedirect::Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle)
+{
+  NS_LOG_FUNCTION ( this << (uint32_t)length );
+  
+  //K flag: IPv6 r2LMA address, IPv4 ones are not supported
+  if (length < 20 || !(data[2] & 0x80))
+    {
+      NS_LOG_LOGIC ("Truncated or IPv4 only option, ignored");
+      return length;
+    }
+  
+  bundle.SetRedirectLmaAddress(Ipv6Address(const_cast<uint8_t *> (data + 4)));
+
+  return length;
+}
+
 } /* namespace ns3 */
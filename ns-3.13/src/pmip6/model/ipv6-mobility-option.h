@@ -83,6 +83,19 @@ public:
    */
   virtual uint8_t Process (Ptr<Packet> packet, uint8_t offset, Ipv6MobilityOptionBundle& bundle) = 0;
   
+  /**
+   * \brief Process method on the serialized option
+   *
+   * Called from Ipv6Mobility::ProcessOptions, which walks the options
+   * in a single copy of the packet and hands over each delimited option.
+   * \param data the option, starting with its type
+   * \param length the option size, type and length fields included
+   * \param bundle bundle of all option data
+   * \return the processed size, or 0 if only the packet based Process is
+   * supported (the default)
+   */
+  virtual uint8_t Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle);
+  
 private:
   /**
    * \brief The node.
@@ -117,6 +130,21 @@ public:
   Time GetTimestamp() const;
   void SetTimestamp(Time tm);
   
+  uint32_t GetMnGroupIdentifier() const;
+  void SetMnGroupIdentifier(uint32_t groupId);
+  
+  Ipv6Address GetLmaAddress() const;
+  void SetLmaAddress(Ipv6Address lma);
+  
+  Ipv6Address GetMagAddress() const;
+  void SetMagAddress(Ipv6Address mag);
+  
+  bool HasRedirectCapability() const;
+  void SetRedirectCapability(bool redirect);
+  
+  Ipv6Address GetRedirectLmaAddress() const;
+  void SetRedirectLmaAddress(Ipv6Address lma);
+  
 protected:
 private:
   //for PMIPv6
@@ -127,6 +155,11 @@ private:
   uint8_t m_accessTechnologyType;
   uint8_t m_handoffIndicator;
   Time m_timestamp;
+  uint32_t m_mnGroupIdentifier; //!< 0 if absent
+  Ipv6Address m_lmaAddress;     //!< context transfer, any if absent
+  Ipv6Address m_magAddress;     //!< localized routing peer, any if absent
+  bool m_redirectCapability;
+  Ipv6Address m_redirectLmaAddress; //!< r2LMA, any if absent
 };
 
 /**
@@ -164,6 +197,7 @@ public:
    * \return the processed size
    */
   virtual uint8_t Process (Ptr<Packet> packet, uint8_t offset, Ipv6MobilityOptionBundle& bundle);
+  virtual uint8_t Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle);
   
 private:
 };
@@ -203,6 +237,7 @@ public:
    * \return the processed size
    */
   virtual uint8_t Process (Ptr<Packet> packet, uint8_t offset, Ipv6MobilityOptionBundle& bundle);
+  virtual uint8_t Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle);
   
 private:
 };
@@ -242,6 +277,7 @@ public:
    * \return the processed size
    */
   virtual uint8_t Process (Ptr<Packet> packet, uint8_t offset, Ipv6MobilityOptionBundle& bundle);
+  virtual uint8_t Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle);
   
 private:
 };
@@ -281,6 +317,7 @@ public:
    * \return the processed size
    */
   virtual uint8_t Process (Ptr<Packet> packet, uint8_t offset, Ipv6MobilityOptionBundle& bundle);
+  virtual uint8_t Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle);
   
 private:
 };
@@ -320,6 +357,7 @@ public:
    * \return the processed size
    */
   virtual uint8_t Process (Ptr<Packet> packet, uint8_t offset, Ipv6MobilityOptionBundle& bundle);
+  virtual uint8_t Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle);
   
 private:
 };
@@ -359,6 +397,7 @@ public:
    * \return the processed size
    */
   virtual uint8_t Process (Ptr<Packet> packet, uint8_t offset, Ipv6MobilityOptionBundle& bundle);
+  virtual uint8_t Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle);
   
 private:
 };
@@ -398,6 +437,7 @@ public:
    * \return the processed size
    */
   virtual uint8_t Process (Ptr<Packet> packet, uint8_t offset, Ipv6MobilityOptionBundle& bundle);
+  virtual uint8_t Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle);
   
 private:
 };
@@ -437,6 +477,7 @@ public:
    * \return the processed size
    */
   virtual uint8_t Process (Ptr<Packet> packet, uint8_t offset, Ipv6MobilityOptionBundle& bundle);
+  virtual uint8_t Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle);
   
 private:
 };
@@ -476,6 +517,167 @@ public:
    * \return the processed size
    */
   virtual uint8_t Process (Ptr<Packet> packet, uint8_t offset, Ipv6MobilityOptionBundle& bundle);
+  virtual uint8_t Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle);
+  
+private:
+};
+
+/**
+ * \class Ipv6MobilityOptionMobileNodeGroupIdentifier
+ * \brief Ipv6 Mobility Option (RFC 6602)
+ */
+class Ipv6MobilityOptionMobileNodeGroupIdentifier : public Ipv6MobilityOption
+{
+public:
+  static const uint8_t OPT_NUMBER = 50;
+  
+  /**
+   * \brief Get the type identificator.
+   * \return type identificator
+   */
+  static TypeId GetTypeId (void);
+  
+  /**
+   * \brief Destructor.
+   */
+  virtual ~Ipv6MobilityOptionMobileNodeGroupIdentifier ();
+  
+  /**
+   * \brief Get the option number.
+   * \return option number
+   */
+  virtual uint8_t GetMobilityOptionNumber () const;
+  
+  /**
+   * \brief Process method
+   *
+   * Called from Ipv6MobilityL4Protocol::Receive.
+   * \param packet the packet
+   * \param bundle bundle of all option data
+   * \return the processed size
+   */
+  virtual uint8_t Process (Ptr<Packet> packet, uint8_t offset, Ipv6MobilityOptionBundle& bundle);
+  virtual uint8_t Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle);
+  
+private:
+};
+
+/**
+ * \class Ipv6MobilityOptionIpv6Address
+ * \brief Ipv6 Mobility Option (RFC 5568), LMA address only
+ */
+class Ipv6MobilityOptionIpv6Address : public Ipv6MobilityOption
+{
+public:
+  static const uint8_t OPT_NUMBER = 17;
+  
+  /**
+   * \brief Get the type identificator.
+   * \return type identificator
+   */
+  static TypeId GetTypeId (void);
+  
+  /**
+   * \brief Destructor.
+   */
+  virtual ~Ipv6MobilityOptionIpv6Address ();
+  
+  /**
+   * \brief Get the option number.
+   * \return option number
+   */
+  virtual uint8_t GetMobilityOptionNumber () const;
+  
+  /**
+   * \brief Process method
+   *
+   * Called from Ipv6MobilityL4Protocol::Receive.
+   * \param packet the packet
+   * \param bundle bundle of all option data
+   * \return the processed size
+   */
+  virtual uint8_t Process (Ptr<Packet> packet, uint8_t offset, Ipv6MobilityOptionBundle& bundle);
+  virtual uint8_t Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle);
+  
+private:
+};
+
+/**
+ * \class Ipv6MobilityOptionRedirectCapability
+ * \brief Ipv6 Mobility Option (RFC 6463)
+ */
+class Ipv6MobilityOptionRedirectCapability : public Ipv6MobilityOption
+{
+public:
+  static const uint8_t OPT_NUMBER = 46;
+  
+  /**
+   * \brief Get the type identificator.
+   * \return type identificator
+   */
+  static TypeId GetTypeId (void);
+  
+  /**
+   * \brief Destructor.
+   */
+  virtual ~Ipv6MobilityOptionRedirectCapability ();
+  
+  /**
+   * \brief Get the option number.
+   * \return option number
+   */
+  virtual uint8_t GetMobilityOptionNumber () const;
+  
+  /**
+   * \brief Process method
+   *
+   * Called from Ipv6MobilityL4Protocol::Receive.
+   * \param packet the packet
+   * \param bundle bundle of all option data
+   * \return the processed size
+   */
+  virtual uint8_t Process (Ptr<Packet> packet, uint8_t offset, Ipv6MobilityOptionBundle& bundle);
+  virtual uint8_t Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle);
+  
+private:
+};
+
+/**
+ * \class Ipv6MobilityOptionRedirect
+ * \brief Ipv6 Mobility Option (RFC 6463), IPv6 r2LMA address only
+ */
+class Ipv6MobilityOptionRedirect : public Ipv6MobilityOption
+{
+public:
+  static const uint8_t OPT_NUMBER = 47;
+  
+  /**
+   * \brief Get the type identificator.
+   * \return type identificator
+   */
+  static TypeId GetTypeId (void);
+  
+  /**
+   * \brief Destructor.
+   */
+  virtual ~Ipv6MobilityOptionRedirect ();
+  
+  /**
+   * \brief Get the option number.
+   * \return option number
+   */
+  virtual uint8_t GetMobilityOptionNumber () const;
+  
+  /**
+   * \brief Process method
+   *
+   * Called from Ipv6MobilityL4Protocol::Receive.
+   * \param packet the packet
+   * \param bundle bundle of all option data
+   * \return the processed size
+   */
+  virtual uint8_t Process (Ptr<Packet> packet, uint8_t offset, Ipv6MobilityOptionBundle& bundle);
+  virtual uint8_t Process (const uint8_t *data, uint8_t length, Ipv6MobilityOptionBundle& bundle);
   
 private:
 };
@@ -22,6 +22,8 @@
  * Author: Hyon-Young Choi <commani@gmail.com>
  */
 
+#include <algorithm>
+
 #include "ns3/assert.h"
 #include "ns3/address-utils.h"
 #include "ns3/log.h"
@@ -77,53 +79,62 @@ Ptr<Node> Ipv6Mobility::GetNode () const
 uint8_t Ipv6Mobility::ProcessOptions(Ptr<Packet> packet, uint8_t offset, uint8_t length, Ipv6MobilityOptionBundle &bundle)
 {
   NS_LOG_FUNCTION (this << packet << length);
-  Ptr<Packet> p = packet->Copy ();
-  p->RemoveAtStart(offset);
   
   Ptr<Ipv6MobilityOptionDemux> ipv6MobilityOptionDemux = GetNode()->GetObject<Ipv6MobilityOptionDemux>();
   NS_ASSERT(ipv6MobilityOptionDemux != 0);
   
   Ptr<Ipv6MobilityOption> ipv6MobilityOption = 0;
   
-  uint8_t processedSize = 0;
-  uint32_t size = p->GetSize ();
-  uint8_t *data = new uint8_t[size];
-  p->CopyData (data, size);
+  /* offset and length are both 8 bits wide, so the message up to the end
+     of its options always fits on the stack: copy it once and walk the
+     options in place. */
+  uint8_t buf[512];
+  uint32_t size = packet->CopyData (buf, (uint32_t)offset + length);
+  uint32_t end = std::min (size, (uint32_t)offset + length);
+  uint32_t processedSize = offset;
   
   uint8_t optType;
-  uint8_t optLen;
+  uint32_t optLen;
 
-  while ( processedSize < length )
+  while ( processedSize < end )
     {
-      optType = *(data + processedSize);
-	  
-	  ipv6MobilityOption = ipv6MobilityOptionDemux -> GetOption ( optType );
-	  
-	  if ( ipv6MobilityOption == 0 )
-	    {
-		  if ( optType == 0 )
-		    {
-			  optLen = 1;
-			}
-		  else
-		    {
-			  optLen = *(data + processedSize + 1) + 2;
-			}
-			
-		  NS_LOG_LOGIC("No matched Ipv6MobilityOption for type=" << (uint32_t)optType );
-		}
-	  else
-	    {
-		  optLen = ipv6MobilityOption -> Process (packet, offset + processedSize, bundle);
-		}
-	  
-	  processedSize += optLen;
-	  p->RemoveAtStart(optLen);
+      optType = buf[processedSize];
+      
+      if ( optType == Ipv6MobilityOptionPad1::OPT_NUMBER )
+        {
+          optLen = 1;
+        }
+      else if ( processedSize + 1 < end )
+        {
+          optLen = buf[processedSize + 1] + 2;
+        }
+      else
+        {
+          optLen = end - processedSize;
+        }
+      
+      if ( processedSize + optLen > end )
+        {
+          NS_LOG_LOGIC("Truncated Ipv6MobilityOption type=" << (uint32_t)optType << ", stop processing");
+          break;
+        }
+      
+      ipv6MobilityOption = ipv6MobilityOptionDemux -> GetOption ( optType );
+      
+      if ( ipv6MobilityOption == 0 )
+        {
+          NS_LOG_LOGIC("No matched Ipv6MobilityOption for type=" << (uint32_t)optType );
+        }
+      else if ( ipv6MobilityOption -> Process (buf + processedSize, optLen, bundle) == 0 )
+        {
+          /* option without a buffer parser */
+          optLen = ipv6MobilityOption -> Process (packet, (uint8_t)processedSize, bundle);
+        }
+      
+      processedSize += optLen;
     }
-
-  delete [] data;
  
-  return processedSize;
+  return processedSize - offset;
 }
 
 NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityBindingUpdate);
@@ -246,4 +257,174 @@ uint8_t Ipv6MobilityBindingAck::Process (Ptr<Packet> p, Ipv6Address src, Ipv6Add
   return 0;
 }
 
+NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityHandoverInitiate);
+
+TypeId Ipv6MobilityHandoverInitiate::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Ipv6MobilityHandoverInitiate")
+    .SetParent<Ipv6Mobility>()
+	.AddConstructor<Ipv6MobilityHandoverInitiate>()
+	;
+  return tid;
+}
+
+Ipv6MobilityHandoverInitiate::~Ipv6MobilityHandoverInitiate()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+uint8_t Ipv6MobilityHandoverInitiate::GetMobilityNumber () const
+{
+  return MOB_NUMBER;
+}
+
+uint8_t Ipv6MobilityHandoverInitiate::Process (Ptr<Packet> p, Ipv6Address src, Ipv6Address dst, Ptr<Ipv6Interface> interface)
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  Ipv6MobilityHandoverInitiateHeader header;
+  
+  p->PeekHeader(header);
+  
+  if(header.GetFlagP())
+    {
+      Ptr<Pmipv6Agent> pmip6 = GetNode()->GetObject<Pmipv6Agent>();
+      
+      if( pmip6 )
+        {
+          Simulator::ScheduleNow( &Pmipv6Agent::Receive, pmip6, p, src, dst, interface);
+          
+          return 0;
+        }
+    }
+  
+  NS_LOG_LOGIC(" No Handler for Handover Initiate");
+  
+  return 0;
+}
+
+NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityHandoverAck);
+
+TypeId Ipv6MobilityHandoverAck::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Ipv6MobilityHandoverAck")
+    .SetParent<Ipv6Mobility>()
+	.AddConstructor<Ipv6MobilityHandoverAck>()
+	;
+  return tid;
+}
+
+Ipv6MobilityHandoverAck::~Ipv6MobilityHandoverAck()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+uint8_t Ipv6MobilityHandoverAck::GetMobilityNumber () const
+{
+  return MOB_NUMBER;
+}
+
+uint8_t Ipv6MobilityHandoverAck::Process (Ptr<Packet> p, Ipv6Address src, Ipv6Address dst, Ptr<Ipv6Interface> interface)
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  Ipv6MobilityHandoverAckHeader header;
+  
+  p->PeekHeader(header);
+  
+  if(header.GetFlagP())
+    {
+      Ptr<Pmipv6Agent> pmip6 = GetNode()->GetObject<Pmipv6Agent>();
+      
+      if( pmip6 )
+        {
+          Simulator::ScheduleNow( &Pmipv6Agent::Receive, pmip6, p, src, dst, interface);
+          
+          return 0;
+        }
+    }
+  
+  NS_LOG_LOGIC(" No Handler for Handover Acknowledge");
+  
+  return 0;
+}
+
+NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityLocalizedRoutingInitiation);
+
+TypeId Ipv6MobilityLocalizedRoutingInitiation::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Ipv6MobilityLocalizedRoutingInitiation")
+    .SetParent<Ipv6Mobility>()
+	.AddConstructor<Ipv6MobilityLocalizedRoutingInitiation>()
+	;
+  return tid;
+}
+
+Ipv6MobilityLocalizedRoutingInitiation::~Ipv6MobilityLocalizedRoutingInitiation()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+uint8_t Ipv6MobilityLocalizedRoutingInitiation::GetMobilityNumber () const
+{
+  return MOB_NUMBER;
+}
+
+uint8_t Ipv6MobilityLocalizedRoutingInitiation::Process (Ptr<Packet> p, Ipv6Address src, Ipv6Address dst, Ptr<Ipv6Interface> interface)
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  Ptr<Pmipv6Agent> pmip6 = GetNode()->GetObject<Pmipv6Agent>();
+  
+  if( pmip6 )
+    {
+      Simulator::ScheduleNow( &Pmipv6Agent::Receive, pmip6, p, src, dst, interface);
+      
+      return 0;
+    }
+  
+  NS_LOG_LOGIC(" No Handler for Localized Routing Initiation");
+  
+  return 0;
+}
+
+NS_OBJECT_ENSURE_REGISTERED (Ipv6MobilityLocalizedRoutingAck);
+
+TypeId Ipv6MobilityLocalizedRoutingAck::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Ipv6MobilityLocalizedRoutingAck")
+    .SetParent<Ipv6Mobility>()
+	.AddConstructor<Ipv6MobilityLocalizedRoutingAck>()
+	;
+  return tid;
+}
+
+Ipv6MobilityLocalizedRoutingAck::~Ipv6MobilityLocalizedRoutingAck()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+uint8_t Ipv6MobilityLocalizedRoutingAck::GetMobilityNumber () const
+{
+  return MOB_NUMBER;
+}
+
+uint8_t Ipv6MobilityLocalizedRoutingAck::Process (Ptr<Packet> p, Ipv6Address src, Ipv6Address dst, Ptr<Ipv6Interface> interface)
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  Ptr<Pmipv6Agent> pmip6 = GetNode()->GetObject<Pmipv6Agent>();
+  
+  if( pmip6 )
+    {
+      Simulator::ScheduleNow( &Pmipv6Agent::Receive, pmip6, p, src, dst, interface);
+      
+      return 0;
+    }
+  
+  NS_LOG_LOGIC(" No Handler for Localized Routing Acknowledgement");
+  
+  return 0;
+}
+
 } /* namespace ns3 */
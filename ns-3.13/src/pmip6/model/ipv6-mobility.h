@@ -179,6 +179,176 @@ private:
 
 };
 
+/**
+ * \class Ipv6MobilityHandoverInitiate
+ * \brief Ipv6 Mobility Handover Initiate
+ *
+ * Only the proxy variant (RFC 5949) is handled, by the Pmipv6Agent.
+ */
+class Ipv6MobilityHandoverInitiate : public Ipv6Mobility
+{
+public:
+  static const uint8_t MOB_NUMBER = 14;
+
+  /**
+   * \brief Get the type identificator.
+   * \return type identificator
+   */
+  static TypeId GetTypeId (void);
+  
+  /**
+   * \brief Destructor.
+   */
+  virtual ~Ipv6MobilityHandoverInitiate ();
+  
+  /**
+   * \brief Get the option number.
+   * \return option number
+   */
+  virtual uint8_t GetMobilityNumber () const;
+  
+  /**
+   * \brief Process method
+   *
+   * Called from Ipv6MobilityL4Protocol::Receive.
+   * \param packet the packet
+   * \param offset the offset of the extension to process
+   * \return the processed size
+   */
+  virtual uint8_t Process (Ptr<Packet> p, Ipv6Address src, Ipv6Address dst, Ptr<Ipv6Interface> interface);
+  
+private:
+
+};
+
+/**
+ * \class Ipv6MobilityHandoverAck
+ * \brief Ipv6 Mobility Handover Acknowledge
+ *
+ * Only the proxy variant (RFC 5949) is handled, by the Pmipv6Agent.
+ */
+class Ipv6MobilityHandoverAck : public Ipv6Mobility
+{
+public:
+  static const uint8_t MOB_NUMBER = 15;
+
+  /**
+   * \brief Get the type identificator.
+   * \return type identificator
+   */
+  static TypeId GetTypeId (void);
+  
+  /**
+   * \brief Destructor.
+   */
+  virtual ~Ipv6MobilityHandoverAck ();
+  
+  /**
+   * \brief Get the option number.
+   * \return option number
+   */
+  virtual uint8_t GetMobilityNumber () const;
+  
+  /**
+   * \brief Process method
+   *
+   * Called from Ipv6MobilityL4Protocol::Receive.
+   * \param packet the packet
+   * \param offset the offset of the extension to process
+   * \return the processed size
+   */
+  virtual uint8_t Process (Ptr<Packet> p, Ipv6Address src, Ipv6Address dst, Ptr<Ipv6Interface> interface);
+  
+private:
+
+};
+
+/**
+ * \class Ipv6MobilityLocalizedRoutingInitiation
+ * \brief Ipv6 Mobility Localized Routing Initiation
+ *
+ * Exchanged between the LMA and the MAGs (RFC 6705), handled by the
+ * Pmipv6Agent.
+ */
+class Ipv6MobilityLocalizedRoutingInitiation : public Ipv6Mobility
+{
+public:
+  static const uint8_t MOB_NUMBER = 17;
+
+  /**
+   * \brief Get the type identificator.
+   * \return type identificator
+   */
+  static TypeId GetTypeId (void);
+  
+  /**
+   * \brief Destructor.
+   */
+  virtual ~Ipv6MobilityLocalizedRoutingInitiation ();
+  
+  /**
+   * \brief Get the option number.
+   * \return option number
+   */
+  virtual uint8_t GetMobilityNumber () const;
+  
+  /**
+   * \brief Process method
+   *
+   * Called from Ipv6MobilityL4Protocol::Receive.
+   * \param packet the packet
+   * \param offset the offset of the extension to process
+   * \return the processed size
+   */
+  virtual uint8_t Process (Ptr<Packet> p, Ipv6Address src, Ipv6Address dst, Ptr<Ipv6Interface> interface);
+  
+private:
+
+};
+
+/**
+ * \class Ipv6MobilityLocalizedRoutingAck
+ * \brief Ipv6 Mobility Localized Routing Acknowledgement
+ *
+ * Exchanged between the LMA and the MAGs (RFC 6705), handled by the
+ * Pmipv6Agent.
+ */
+class Ipv6MobilityLocalizedRoutingAck : public Ipv6Mobility
+{
+public:
+  static const uint8_t MOB_NUMBER = 18;
+
+  /**
+   * \brief Get the type identificator.
+   * \return type identificator
+   */
+  static TypeId GetTypeId (void);
+  
+  /**
+   * \brief Destructor.
+   */
+  virtual ~Ipv6MobilityLocalizedRoutingAck ();
+  
+  /**
+   * \brief Get the option number.
+   * \return option number
+   */
+  virtual uint8_t GetMobilityNumber () const;
+  
+  /**
+   * \brief Process method
+   *
+   * Called from Ipv6MobilityL4Protocol::Receive.
+   * \param packet the packet
+   * \param offset the offset of the extension to process
+   * \return the processed size
+   */
+  virtual uint8_t Process (Ptr<Packet> p, Ipv6Address src, Ipv6Address dst, Ptr<Ipv6Interface> interface);
+  
+private:
+
+};
+
 } /* namespace ns3 */
 
 #endif /* IPV6_MOBILITY_H */
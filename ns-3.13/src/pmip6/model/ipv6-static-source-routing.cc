@@ -93,7 +93,7 @@ void Ipv6StaticSourceRouting::AddNetworkRouteFrom (Ipv6Address network, Ipv6Pref
   NS_LOG_FUNCTION (this << network << networkPrefix << nextHop << interface << metric);
   Ipv6RoutingTableEntry* route = new Ipv6RoutingTableEntry ();
   *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo (network, networkPrefix, nextHop, interface);
-  m_networkRoutes.push_back (std::make_pair (route, metric));
+  AddNetworkRoute (route, metric);
 }
 
 void Ipv6StaticSourceRouting::AddNetworkRouteFrom (Ipv6Address network, Ipv6Prefix networkPrefix, Ipv6Address nextHop, uint32_t interface, Ipv6Address prefixToUse, uint32_t metric)
@@ -101,7 +101,7 @@ void Ipv6StaticSourceRouting::AddNetworkRouteFrom (Ipv6Address network, Ipv6Pref
   NS_LOG_FUNCTION (this << network << networkPrefix << nextHop << interface << prefixToUse << metric);
   Ipv6RoutingTableEntry* route = new Ipv6RoutingTableEntry ();
   *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo (network, networkPrefix, nextHop, interface, prefixToUse);
-  m_networkRoutes.push_back (std::make_pair (route, metric));
+  AddNetworkRoute (route, metric);
 }
 
 void Ipv6StaticSourceRouting::AddNetworkRouteFrom (Ipv6Address network, Ipv6Prefix networkPrefix, uint32_t interface, uint32_t metric)
@@ -109,15 +109,135 @@ void Ipv6StaticSourceRouting::AddNetworkRouteFrom (Ipv6Address network, Ipv6Pref
   NS_LOG_FUNCTION (this << network << networkPrefix << interface);
   Ipv6RoutingTableEntry* route = new Ipv6RoutingTableEntry ();
   *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo (network, networkPrefix, interface);
-  m_networkRoutes.push_back (std::make_pair (route, metric));
+  AddNetworkRoute (route, metric);
+}
+
+void Ipv6StaticSourceRouting::AddNetworkRouteFromTo (Ipv6Address network, Ipv6Prefix networkPrefix, Ipv6Address dest, Ipv6Prefix destPrefix, uint32_t interface, uint32_t metric)
+{
+  NS_LOG_FUNCTION (this << network << networkPrefix << dest << destPrefix << interface << metric);
+  DestinationRoute route;
+
+  route.network = network.CombinePrefix (networkPrefix);
+  route.networkPrefix = networkPrefix;
+  route.dest = dest.CombinePrefix (destPrefix);
+  route.destPrefix = destPrefix;
+  route.interface = interface;
+  route.metric = metric;
+
+  DestinationRoutesI it = m_destinationRoutes.insert (m_destinationRoutes.end (), route);
+
+  uint8_t networkLength = networkPrefix.GetPrefixLength ();
+  SourceTrie::Values *tries = m_destinationTries.Find (route.network, networkLength);
+  DestinationTrie *trie = 0;
+  if (tries)
+    {
+      trie = tries->front ();
+    }
+  else
+    {
+      trie = new DestinationTrie ();
+      m_destinationTries.Insert (route.network, networkLength, trie);
+    }
+  trie->Insert (route.dest, destPrefix.GetPrefixLength (), it);
+}
+
+bool Ipv6StaticSourceRouting::RemoveRouteFromTo (Ipv6Address network, Ipv6Prefix networkPrefix, Ipv6Address dest, Ipv6Prefix destPrefix, uint32_t interface)
+{
+  NS_LOG_FUNCTION (this << network << networkPrefix << dest << destPrefix << interface);
+  SourceTrie::Values *tries = m_destinationTries.Find (network, networkPrefix.GetPrefixLength ());
+  if (!tries)
+    {
+      return false;
+    }
+
+  DestinationTrie::Values *routes = tries->front ()->Find (dest, destPrefix.GetPrefixLength ());
+  if (!routes)
+    {
+      return false;
+    }
+
+  for (DestinationTrie::Values::iterator it = routes->begin () ; it != routes->end () ; it++)
+    {
+      if ((*it)->interface == interface)
+        {
+          RemoveDestinationRoute (*it);
+          return true;
+        }
+    }
+  return false;
+}
+
+Ipv6StaticSourceRouting::DestinationRoutesI Ipv6StaticSourceRouting::RemoveDestinationRoute (DestinationRoutesI it)
+{
+  NS_LOG_FUNCTION (this << it->network << it->dest << it->interface);
+  uint8_t networkLength = it->networkPrefix.GetPrefixLength ();
+  DestinationTrie *trie = m_destinationTries.Find (it->network, networkLength)->front ();
+
+  trie->Remove (it->dest, it->destPrefix.GetPrefixLength (), it);
+  if (trie->IsEmpty ())
+    {
+      m_destinationTries.Remove (it->network, networkLength, trie);
+      delete trie;
+    }
+  return m_destinationRoutes.erase (it);
+}
+
+uint32_t Ipv6StaticSourceRouting::GetNRoutesFromTo () const
+{
+  return m_destinationRoutes.size ();
+}
+
+Ptr<Ipv6Route> Ipv6StaticSourceRouting::LookupDestination (Ipv6Address src, Ipv6Address dst)
+{
+  NS_LOG_FUNCTION (this << src << dst);
+
+  /* the longest source prefix with a route matching dst wins, then the
+   * longest destination prefix, then the lowest metric, the first added
+   * one on a tie.
+   */
+  std::vector<const SourceTrie::Values *> sources;
+  std::vector<const DestinationTrie::Values *> matches;
+  m_destinationTries.Match (src, sources);
+
+  const DestinationRoute *best = 0;
+  for (int32_t i = sources.size () - 1; i >= 0 && !best; i--)
+    {
+      sources[i]->front ()->Match (dst, matches);
+      if (matches.empty ())
+        {
+          continue;
+        }
+
+      for (DestinationTrie::Values::const_iterator it = matches.back ()->begin () ; it != matches.back ()->end () ; it++)
+        {
+          if (!best || (*it)->metric < best->metric)
+            {
+              best = &(**it);
+            }
+        }
+    }
+
+  if (!best)
+    {
+      return 0;
+    }
+
+  NS_LOG_LOGIC ("Found route from " << best->network << " to " << best->dest << " via " << best->interface);
+
+  Ptr<Ipv6Route> rtentry = Create<Ipv6Route> ();
+
+  rtentry->SetSource (best->network);
+  rtentry->SetDestination (dst);
+  rtentry->SetGateway (Ipv6Address::GetZero ());
+  rtentry->SetOutputDevice (m_ipv6->GetNetDevice (best->interface));
+
+  return rtentry;
 }
 
 Ptr<Ipv6Route> Ipv6StaticSourceRouting::LookupStatic (Ipv6Address src, Ipv6Address dst)
 {
   NS_LOG_FUNCTION (this << src << dst);
   Ptr<Ipv6Route> rtentry = 0;
-  uint16_t longestMask = 0;
-  uint32_t shortestMetric = 0xffffffff;
 
   /* when sending on link-local multicast, there have to be interface specified */
   if (src == Ipv6Address::GetAllNodesMulticast () || src.IsSolicitedMulticast () || 
@@ -126,48 +246,49 @@ Ptr<Ipv6Route> Ipv6StaticSourceRouting::LookupStatic (Ipv6Address src, Ipv6Addre
       return 0;
     }
 
-  for (NetworkRoutesI it = m_networkRoutes.begin () ; it != m_networkRoutes.end () ; it++)
+  if (!m_destinationRoutes.empty ())
     {
-      Ipv6RoutingTableEntry* j = it->first;
-      uint32_t metric = it->second;
-      Ipv6Prefix mask = j->GetDestNetworkPrefix ();
-      uint16_t maskLen = mask.GetPrefixLength ();
-      Ipv6Address entry = j->GetDestNetwork ();
+      rtentry = LookupDestination (src, dst);
+
+      if (rtentry)
+        {
+          return rtentry;
+        }
+    }
 
-      NS_LOG_LOGIC ("Searching for route from " << src << ", mask length " << maskLen << ", metric " << metric);
+  /* the longest source prefix wins, and among its routes the lowest
+   * metric, the last added one on a tie.
+   */
+  std::vector<const NetworkRoutesTrie::Values *> matches;
+  m_networkRoutesTrie.Match (src, matches);
 
-      if (mask.IsMatch (src, entry))
+  if (!matches.empty ())
+    {
+      Ipv6RoutingTableEntry* route = 0;
+      uint32_t shortestMetric = 0xffffffff;
+
+      for (NetworkRoutesTrie::Values::const_iterator it = matches.back ()->begin () ; it != matches.back ()->end () ; it++)
         {
-          NS_LOG_LOGIC ("Found global network route " << j << ", mask length " << maskLen << ", metric " << metric);
-
-		  if (maskLen < longestMask)
-			{
-			  NS_LOG_LOGIC ("Previous match longer, skipping");
-			  continue;
-			}
-
-		  if (maskLen > longestMask)
-			{
-			  shortestMetric = 0xffffffff;
-			}
-
-		  longestMask = maskLen;
-		  if (metric > shortestMetric)
-			{
-			  NS_LOG_LOGIC ("Equal mask length, but previous metric shorter, skipping");
-			  continue;
-			}
-
-		  shortestMetric = metric;
-		  Ipv6RoutingTableEntry* route = j;
-		  uint32_t interfaceIdx = route->GetInterface ();
-		  rtentry = Create<Ipv6Route> ();
-
-		  rtentry->SetSource (route->GetDest());
-		  rtentry->SetDestination (dst);
-		  rtentry->SetGateway (route->GetGateway ());
-		  rtentry->SetOutputDevice (m_ipv6->GetNetDevice (interfaceIdx));
+          Ipv6RoutingTableEntry* j = (*it)->first;
+          uint32_t metric = (*it)->second;
+
+          NS_LOG_LOGIC ("Found global network route " << j << ", mask length " << (uint32_t)j->GetDestNetworkPrefix ().GetPrefixLength () << ", metric " << metric);
+
+          if (metric > shortestMetric)
+            {
+              NS_LOG_LOGIC ("Equal mask length, but previous metric shorter, skipping");
+              continue;
+            }
+
+          shortestMetric = metric;
+          route = j;
         }
+
+      rtentry = Create<Ipv6Route> ();
+      rtentry->SetSource (route->GetDest ());
+      rtentry->SetDestination (dst);
+      rtentry->SetGateway (route->GetGateway ());
+      rtentry->SetOutputDevice (m_ipv6->GetNetDevice (route->GetInterface ()));
     }
 
   if(rtentry)
@@ -177,6 +298,22 @@ Ptr<Ipv6Route> Ipv6StaticSourceRouting::LookupStatic (Ipv6Address src, Ipv6Addre
   return rtentry;
 }
 
+void Ipv6StaticSourceRouting::AddNetworkRoute (Ipv6RoutingTableEntry *route, uint32_t metric)
+{
+  NS_LOG_FUNCTION (this << route << metric);
+  NetworkRoutesI it = m_networkRoutes.insert (m_networkRoutes.end (), std::make_pair (route, metric));
+  m_networkRoutesTrie.Insert (route->GetDestNetwork (), route->GetDestNetworkPrefix ().GetPrefixLength (), it);
+}
+
+Ipv6StaticSourceRouting::NetworkRoutesI Ipv6StaticSourceRouting::RemoveNetworkRoute (NetworkRoutesI it)
+{
+  NS_LOG_FUNCTION (this << it->first);
+  Ipv6RoutingTableEntry* route = it->first;
+  m_networkRoutesTrie.Remove (route->GetDestNetwork (), route->GetDestNetworkPrefix ().GetPrefixLength (), it);
+  delete route;
+  return m_networkRoutes.erase (it);
+}
+
 void Ipv6StaticSourceRouting::DoDispose ()
 {
   NS_LOG_FUNCTION_NOARGS ();
@@ -186,6 +323,12 @@ void Ipv6StaticSourceRouting::DoDispose ()
       delete j->first;
     }
   m_networkRoutes.clear ();
+  m_networkRoutesTrie.Clear ();
+
+  for (DestinationRoutesI j = m_destinationRoutes.begin () ; j != m_destinationRoutes.end () ; )
+    {
+      j = RemoveDestinationRoute (j);
+    }
 
   m_ipv6 = 0;
   Ipv6RoutingProtocol::DoDispose ();
@@ -241,8 +384,7 @@ void Ipv6StaticSourceRouting::RemoveRoute (uint32_t index)
     {
       if (tmp == index)
         {
-          delete it->first;
-          m_networkRoutes.erase (it);
+          RemoveNetworkRoute (it);
           return;
         }
       tmp++;
@@ -253,15 +395,20 @@ void Ipv6StaticSourceRouting::RemoveRoute (uint32_t index)
 void Ipv6StaticSourceRouting::RemoveRoute (Ipv6Address network, Ipv6Prefix prefix, uint32_t ifIndex, Ipv6Address prefixToUse)
 {
   NS_LOG_FUNCTION (this << network << prefix << ifIndex);
+  NetworkRoutesTrie::Values *routes = m_networkRoutesTrie.Find (network, prefix.GetPrefixLength ());
 
-  for (NetworkRoutesI it = m_networkRoutes.begin () ; it != m_networkRoutes.end () ; it++)
+  if (!routes)
     {
-      Ipv6RoutingTableEntry* rtentry = it->first;
+      return;
+    }
+
+  for (NetworkRoutesTrie::Values::iterator it = routes->begin () ; it != routes->end () ; it++)
+    {
+      Ipv6RoutingTableEntry* rtentry = (*it)->first;
       if (network == rtentry->GetDest () && rtentry->GetInterface () == ifIndex && 
           rtentry->GetPrefixToUse () == prefixToUse)
         {
-          delete it->first;
-          m_networkRoutes.erase (it);
+          RemoveNetworkRoute (*it);
           return;
         }
     }
@@ -310,28 +457,20 @@ bool Ipv6StaticSourceRouting::RouteInput (Ptr<const Packet> p, const Ipv6Header
   // a packet to one of our other interface addresses; that is, the
   // destination unicast address does not match one of the iif addresses,
   // but we check our other interfaces.  This could be an option
-  // (to remove the outer loop immediately below and just check iif).
-  for (uint32_t j = 0; j < m_ipv6->GetNInterfaces (); j++)
+  // (to only look at the iif addresses below).
+  int32_t j = m_ipv6->GetInterfaceForAddress (dst);
+  if (j >= 0)
     {
-      for (uint32_t i = 0; i < m_ipv6->GetNAddresses (j); i++)
+      if (uint32_t (j) == iif)
         {
-          Ipv6InterfaceAddress iaddr = m_ipv6->GetAddress (j, i);
-          Ipv6Address addr = iaddr.GetAddress ();
-          if (addr.IsEqual (dst))
-            {
-              if (j == iif)
-                {
-                  NS_LOG_LOGIC ("For me (destination " << addr << " match)");
-                }
-              else
-                {
-                  NS_LOG_LOGIC ("For me (destination " << addr << " match) on another interface " << dst );
-                }
-              lcb (p, header, iif);
-              return true;
-            }
-          NS_LOG_LOGIC ("Address "<< addr << " not a match");
+          NS_LOG_LOGIC ("For me (destination " << dst << " match)");
+        }
+      else
+        {
+          NS_LOG_LOGIC ("For me (destination " << dst << " match) on another interface " << j);
         }
+      lcb (p, header, iif);
+      return true;
     }
   // Check if input device supports IP forwarding
   if (m_ipv6->IsForwarding (iif) == false)
@@ -364,21 +503,29 @@ void Ipv6StaticSourceRouting::NotifyInterfaceUp (uint32_t i)
 void Ipv6StaticSourceRouting::NotifyInterfaceDown (uint32_t i)
 {
   NS_LOG_FUNCTION (this << i);
-  uint32_t j = 0;
-  uint32_t max = GetNRoutes ();
 
-  /* remove all static routes that are going through this interface */
-  while (j < max)
+  for (DestinationRoutesI it = m_destinationRoutes.begin () ; it != m_destinationRoutes.end () ; )
     {
-      Ipv6RoutingTableEntry route = GetRoute (j);
+      if (it->interface == i)
+        {
+          it = RemoveDestinationRoute (it);
+        }
+      else
+        {
+          it++;
+        }
+    }
 
-      if (route.GetInterface () == i)
+  /* remove all static routes that are going through this interface */
+  for (NetworkRoutesI it = m_networkRoutes.begin () ; it != m_networkRoutes.end () ; )
+    {
+      if (it->first->GetInterface () == i)
         {
-          RemoveRoute (j);
+          it = RemoveNetworkRoute (it);
         }
       else
         {
-          j++;
+          it++;
         }
     }
 }
@@ -34,6 +34,7 @@
 #include "ns3/ipv6.h"
 #include "ns3/ipv6-header.h"
 #include "ns3/ipv6-routing-protocol.h"
+#include "ns3/ipv6-prefix-trie.h"
 
 namespace ns3
 {
@@ -124,6 +125,34 @@ public:
    */
   void AddNetworkRouteFrom (Ipv6Address network, Ipv6Prefix networkPrefix, uint32_t interface, uint32_t metric = 0);
 
+  /**
+   * \brief Add route from a network to another network.
+   *
+   * Routes from and to networks are preferred to the routes from a
+   * network only, the longest source prefix first, then the longest
+   * destination prefix. They are kept apart from the other routes, and
+   * not counted by GetNRoutes.
+   * \param network source network address
+   * \param networkPrefix source network prefix
+   * \param dest destination network address
+   * \param destPrefix destination network prefix
+   * \param interface interface index
+   * \param metric metric of route in case of multiple routes to same destination
+   */
+  void AddNetworkRouteFromTo (Ipv6Address network, Ipv6Prefix networkPrefix, Ipv6Address dest, Ipv6Prefix destPrefix, uint32_t interface, uint32_t metric = 0);
+
+  /**
+   * \brief Remove a route from a network to another network.
+   * \return false if there is no such route
+   */
+  bool RemoveRouteFromTo (Ipv6Address network, Ipv6Prefix networkPrefix, Ipv6Address dest, Ipv6Prefix destPrefix, uint32_t interface);
+
+  /**
+   * \brief Get the number of routes from a network to another network.
+   * \return number of entries
+   */
+  uint32_t GetNRoutesFromTo () const;
+
   /**
    * \brief Get the number or entries in the routing table.
    * \return number of entries
@@ -183,6 +212,61 @@ private:
   typedef std::list<std::pair <Ipv6RoutingTableEntry *, uint32_t> > NetworkRoutes;
   typedef std::list<std::pair <Ipv6RoutingTableEntry *, uint32_t> >::const_iterator NetworkRoutesCI;
   typedef std::list<std::pair <Ipv6RoutingTableEntry *, uint32_t> >::iterator NetworkRoutesI;
+  typedef Ipv6PrefixTrie<NetworkRoutesI> NetworkRoutesTrie;
+
+  /**
+   * \brief Route from a network to another network.
+   */
+  struct DestinationRoute
+  {
+    Ipv6Address network;
+    Ipv6Prefix networkPrefix;
+    Ipv6Address dest;
+    Ipv6Prefix destPrefix;
+    uint32_t interface;
+    uint32_t metric;
+  };
+
+  typedef std::list<DestinationRoute> DestinationRoutes;
+  typedef std::list<DestinationRoute>::iterator DestinationRoutesI;
+
+  /**
+   * \brief Routes from a source prefix, by destination prefix.
+   */
+  typedef Ipv6PrefixTrie<DestinationRoutesI> DestinationTrie;
+
+  /**
+   * \brief Destination tries, by source prefix. Each source prefix holds
+   * a single trie.
+   */
+  typedef Ipv6PrefixTrie<DestinationTrie *> SourceTrie;
+
+  /**
+   * \brief Add a route to the forwarding table and to its trie.
+   * \param route the route, owned by the table from now on
+   * \param metric metric of route
+   */
+  void AddNetworkRoute (Ipv6RoutingTableEntry *route, uint32_t metric);
+
+  /**
+   * \brief Remove and delete a route of the forwarding table.
+   * \param it the route
+   * \return the route following it
+   */
+  NetworkRoutesI RemoveNetworkRoute (NetworkRoutesI it);
+
+  /**
+   * \brief Remove a route from and to networks.
+   * \param it the route
+   * \return the route following it
+   */
+  DestinationRoutesI RemoveDestinationRoute (DestinationRoutesI it);
+
+  /**
+   * \brief Lookup in the routes from and to networks.
+   * \return the route, 0 if no route matches both addresses
+   */
+  Ptr<Ipv6Route> LookupDestination (Ipv6Address src, Ipv6Address dst);
 
   /**
    * \brief Lookup in the forwarding table for destination.
@@ -198,6 +282,22 @@ private:
    */
   NetworkRoutes m_networkRoutes;
 
+  /**
+   * \brief the routes of m_networkRoutes, by source prefix.
+   */
+  NetworkRoutesTrie m_networkRoutesTrie;
+
+  /**
+   * \brief the routes from and to networks.
+   */
+  DestinationRoutes m_destinationRoutes;
+
+  /**
+   * \brief the routes of m_destinationRoutes, by source prefix then by
+   * destination prefix.
+   */
+  SourceTrie m_destinationTries;
+
   /**
    * \brief Ipv6 reference.
    */
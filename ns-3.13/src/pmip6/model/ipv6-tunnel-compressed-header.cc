@@ -0,0 +1,196 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include "ipv6-tunnel-compressed-header.h"
+
+NS_LOG_COMPONENT_DEFINE ("Ipv6TunnelCompressedHeader");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED (Ipv6TunnelCompressedHeader);
+
+const uint8_t Ipv6TunnelCompressedHeader::PROT_NUMBER = 142; /* ROHC */
+
+static const uint8_t FLAG_REFRESH = 0x80;
+static const uint8_t FLAG_HOP_LIMIT = 0x40;
+static const uint8_t GENERATION_MASK = 0x3f;
+
+TypeId Ipv6TunnelCompressedHeader::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Ipv6TunnelCompressedHeader")
+    .SetParent<Header> ()
+    .AddConstructor<Ipv6TunnelCompressedHeader> ()
+    ;
+  return tid;
+}
+
+TypeId Ipv6TunnelCompressedHeader::GetInstanceTypeId () const
+{
+  return GetTypeId ();
+}
+
+Ipv6TunnelCompressedHeader::Ipv6TunnelCompressedHeader ()
+  : m_refresh (false),
+    m_hasHopLimit (false),
+    m_cid (0),
+    m_generation (0),
+    m_hopLimit (0)
+{
+}
+
+Ipv6TunnelCompressedHeader::~Ipv6TunnelCompressedHeader ()
+{
+}
+
+uint8_t Ipv6TunnelCompressedHeader::GetContextId () const
+{
+  return m_cid;
+}
+
+void Ipv6TunnelCompressedHeader::SetContextId (uint8_t cid)
+{
+  m_cid = cid;
+}
+
+uint8_t Ipv6TunnelCompressedHeader::GetGeneration () const
+{
+  return m_generation;
+}
+
+void Ipv6TunnelCompressedHeader::SetGeneration (uint8_t generation)
+{
+  m_generation = generation & GENERATION_MASK;
+}
+
+bool Ipv6TunnelCompressedHeader::IsRefresh () const
+{
+  return m_refresh;
+}
+
+void Ipv6TunnelCompressedHeader::SetInnerHeader (const Ipv6Header &header)
+{
+  m_refresh = true;
+  m_hasHopLimit = false;
+  m_innerHeader = header;
+}
+
+const Ipv6Header &Ipv6TunnelCompressedHeader::GetInnerHeader () const
+{
+  NS_ASSERT (m_refresh);
+  return m_innerHeader;
+}
+
+bool Ipv6TunnelCompressedHeader::HasHopLimit () const
+{
+  return m_hasHopLimit;
+}
+
+void Ipv6TunnelCompressedHeader::SetHopLimit (uint8_t hopLimit)
+{
+  NS_ASSERT (!m_refresh);
+  m_hasHopLimit = true;
+  m_hopLimit = hopLimit;
+}
+
+uint8_t Ipv6TunnelCompressedHeader::GetHopLimit () const
+{
+  return m_hopLimit;
+}
+
+void Ipv6TunnelCompressedHeader::Print (std::ostream& os) const
+{
+  os << "( " << (m_refresh ? "IR" : "CO") << " cid = " << (uint32_t)m_cid
+     << " generation = " << (uint32_t)m_generation;
+  if (m_refresh)
+    {
+      os << " inner = " << m_innerHeader;
+    }
+  else if (m_hasHopLimit)
+    {
+      os << " hop limit = " << (uint32_t)m_hopLimit;
+    }
+  os << " )";
+}
+
+uint32_t Ipv6TunnelCompressedHeader::GetSerializedSize () const
+{
+  if (m_refresh)
+    {
+      return 2 + m_innerHeader.GetSerializedSize ();
+    }
+  return m_hasHopLimit ? 3 : 2;
+}
+
+void Ipv6TunnelCompressedHeader::Serialize (Buffer::Iterator start) const
+{
+  Buffer::Iterator i = start;
+  uint8_t flags = m_generation;
+
+  if (m_refresh)
+    {
+      flags |= FLAG_REFRESH;
+    }
+  else if (m_hasHopLimit)
+    {
+      flags |= FLAG_HOP_LIMIT;
+    }
+
+  i.WriteU8 (flags);
+  i.WriteU8 (m_cid);
+
+  if (m_refresh)
+    {
+      m_innerHeader.Serialize (i);
+    }
+  else if (m_hasHopLimit)
+    {
+      i.WriteU8 (m_hopLimit);
+    }
+}
+
+uint32_t Ipv6TunnelCompressedHeader::Deserialize (Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+  uint8_t flags = i.ReadU8 ();
+
+  m_cid = i.ReadU8 ();
+  m_generation = flags & GENERATION_MASK;
+  m_refresh = (flags & FLAG_REFRESH) != 0;
+  m_hasHopLimit = !m_refresh && (flags & FLAG_HOP_LIMIT) != 0;
+
+  if (m_refresh)
+    {
+      m_innerHeader.Deserialize (i);
+    }
+  else if (m_hasHopLimit)
+    {
+      m_hopLimit = i.ReadU8 ();
+    }
+
+  return GetSerializedSize ();
+}
+
+} /* namespace ns3 */
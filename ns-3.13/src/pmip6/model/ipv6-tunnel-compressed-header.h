@@ -0,0 +1,198 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef IPV6_TUNNEL_COMPRESSED_HEADER_H
+#define IPV6_TUNNEL_COMPRESSED_HEADER_H
+
+#include "ns3/header.h"
+#include "ns3/ipv6-header.h"
+
+namespace ns3
+{
+
+/**
+ * \class Ipv6TunnelCompressedHeader
+ * \brief Compressed inner IPv6 header of a tunneled packet.
+ *
+ * Replaces the inner IPv6 header, in the spirit of ROHC (RFC 5795)
+ * unidirectional mode. An IR packet carries the whole inner header and
+ * (re)initializes the context of its context id at the decompressor;
+ * a CO packet only carries the context id, and the hop limit when it
+ * differs from the one of the context. The payload length is taken
+ * from the outer packet.
+ *
+ * Both carry the generation of the context, changed by the compressor
+ * each time the context is given another inner header: a CO packet
+ * whose generation is not the one of the context at the decompressor
+ * followed a lost IR, and is dropped rather than decompressed with the
+ * header of another flow.
+ *
+ * \verbatim
+    0                   1
+    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5
+   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   |I|H| generation|  context id   |  IR: + inner IPv6 header (40 bytes)
+   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+  CO: + hop limit (1 byte) if H
+   \endverbatim
+ */
+class Ipv6TunnelCompressedHeader : public Header
+{
+public:
+  /**
+   * \brief Protocol number of the compressed packets in the outer header (ROHC, RFC 5858).
+   */
+  static const uint8_t PROT_NUMBER;
+
+  /**
+   * \brief Get the UID of this class.
+   * \return UID
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief Get the instance type ID.
+   * \return instance type ID
+   */
+  virtual TypeId GetInstanceTypeId () const;
+
+  /**
+   * \brief Constructor, a CO packet of context 0.
+   */
+  Ipv6TunnelCompressedHeader ();
+
+  /**
+   * \brief Destructor.
+   */
+  virtual ~Ipv6TunnelCompressedHeader ();
+
+  /**
+   * \return the context id
+   */
+  uint8_t GetContextId () const;
+
+  /**
+   * \param cid the context id
+   */
+  void SetContextId (uint8_t cid);
+
+  /**
+   * \return the generation of the context, on 6 bits
+   */
+  uint8_t GetGeneration () const;
+
+  /**
+   * \param generation the generation of the context, only the 6 low bits are kept
+   */
+  void SetGeneration (uint8_t generation);
+
+  /**
+   * \return true for an IR packet, which carries the inner header
+   */
+  bool IsRefresh () const;
+
+  /**
+   * \brief Make an IR packet carrying a whole inner header.
+   * \param header the inner header
+   */
+  void SetInnerHeader (const Ipv6Header &header);
+
+  /**
+   * \return the inner header of an IR packet
+   */
+  const Ipv6Header &GetInnerHeader () const;
+
+  /**
+   * \return true if a CO packet carries the hop limit
+   */
+  bool HasHopLimit () const;
+
+  /**
+   * \brief Carry the hop limit in a CO packet.
+   * \param hopLimit the hop limit of the inner packet
+   */
+  void SetHopLimit (uint8_t hopLimit);
+
+  /**
+   * \return the hop limit carried by a CO packet
+   */
+  uint8_t GetHopLimit () const;
+
+  /**
+   * \brief Print informations.
+   * \param os output stream
+   */
+  virtual void Print (std::ostream& os) const;
+
+  /**
+   * \brief Get the serialized size.
+   * \return serialized size
+   */
+  virtual uint32_t GetSerializedSize () const;
+
+  /**
+   * \brief Serialize the packet.
+   * \param start start offset
+   */
+  virtual void Serialize (Buffer::Iterator start) const;
+
+  /**
+   * \brief Deserialize the packet.
+   * \param start start offset
+   * \return length of packet
+   */
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+
+private:
+  /**
+   * \brief IR packet.
+   */
+  bool m_refresh;
+
+  /**
+   * \brief The CO packet carries the hop limit.
+   */
+  bool m_hasHopLimit;
+
+  /**
+   * \brief The context id.
+   */
+  uint8_t m_cid;
+
+  /**
+   * \brief The generation of the context.
+   */
+  uint8_t m_generation;
+
+  /**
+   * \brief The hop limit of a CO packet.
+   */
+  uint8_t m_hopLimit;
+
+  /**
+   * \brief The inner header of an IR packet.
+   */
+  Ipv6Header m_innerHeader;
+};
+
+} /* namespace ns3 */
+
+#endif /* IPV6_TUNNEL_COMPRESSED_HEADER_H */
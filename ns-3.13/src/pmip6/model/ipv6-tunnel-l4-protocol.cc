@@ -30,6 +30,7 @@
 #include "ns3/packet.h"
 #include "ns3/node.h"
 #include "ns3/boolean.h"
+#include "ns3/uinteger.h"
 #include "ns3/ipv6-routing-protocol.h"
 #include "ns3/ipv6-route.h"
 #include "ns3/wifi-net-device.h"
@@ -38,10 +39,13 @@
 #include "ns3/virtual-net-device.h"
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/ipv6-interface.h"
+#include "ns3/icmpv6-header.h"
 
 #include "ns3/ipv6-static-routing-helper.h"
 #include "ns3/ipv6-static-routing.h"
+#include "ns3/pmipv6-prefix-routing-helper.h"
 
+#include "ipv6-tunnel-compressed-header.h"
 #include "ipv6-tunnel-l4-protocol.h"
 
 using namespace std;
@@ -52,6 +56,7 @@ namespace ns3
 {
 
 NS_OBJECT_ENSURE_REGISTERED (Ipv6TunnelL4Protocol);
+NS_OBJECT_ENSURE_REGISTERED (Ipv6TunnelCompressedL4Protocol);
 
 const uint8_t Ipv6TunnelL4Protocol::PROT_NUMBER = 41; /* IPV6-in-IPv6 */
 
@@ -60,12 +65,21 @@ TypeId Ipv6TunnelL4Protocol::GetTypeId ()
   static TypeId tid = TypeId ("ns3::Ipv6TunnelL4Protocol")
     .SetParent<Ipv6L4Protocol> ()
     .AddConstructor<Ipv6TunnelL4Protocol> ()
+    .AddAttribute ("RouteCache", "Cache the forwarding decision of decapsulated packets per tunnel and inner destination.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&Ipv6TunnelL4Protocol::m_routeCacheEnabled),
+                   MakeBooleanChecker ())
+    .AddAttribute ("RouteCacheSize", "Maximum number of inner destinations cached per tunnel.",
+                   UintegerValue (256),
+                   MakeUintegerAccessor (&Ipv6TunnelL4Protocol::m_routeCacheSize),
+                   MakeUintegerChecker<uint32_t> (1))
     ;
   return tid;
 }
 
 Ipv6TunnelL4Protocol::Ipv6TunnelL4Protocol ()
-  : m_node (0)
+  : m_node (0),
+    m_routeCacheGeneration (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -81,12 +95,16 @@ void Ipv6TunnelL4Protocol::DoDispose ()
 
   m_node = 0;
   
-  for ( TunnelListI i = m_tunnelList.begin(); i != m_tunnelList.end(); i++ )
+  m_tunnelTable.clear();
+  m_freeList.clear();
+  if (m_compressedProtocol)
     {
-	  (*i) = 0;
-	}
-	
-  m_tunnelList.clear();
+      m_compressedProtocol->SetTunnelProtocol (0);
+      m_compressedProtocol = 0;
+    }
+  m_staticRouting = 0;
+  m_prefixRouting = 0;
+  m_decapCallback = MakeNullCallback<void, const Ipv6Address &, const Ipv6Header &> ();
   
   Ipv6L4Protocol::DoDispose ();
 }
@@ -105,6 +123,10 @@ void Ipv6TunnelL4Protocol::NotifyNewAggregate ()
             {
               this->SetNode (node);
               ipv6->Insert (this);
+              
+              m_compressedProtocol = CreateObject<Ipv6TunnelCompressedL4Protocol> ();
+              m_compressedProtocol->SetTunnelProtocol (this);
+              ipv6->Insert (m_compressedProtocol);
             }
         }
     }
@@ -145,14 +167,42 @@ enum Ipv6L4Protocol::RxStatus_e Ipv6TunnelL4Protocol::Receive (Ptr<Packet> packe
 {
   NS_LOG_FUNCTION (this << packet << src << dst << interface);
   
-  Ptr<Ipv6L3Protocol> ipv6 = GetNode()->GetObject<Ipv6L3Protocol>();
-  NS_ASSERT (ipv6 != 0);
+  TunnelEntry *tunnel = LookupReceiveTunnel (src, dst);
   
-  Ptr<Packet> p = packet->Copy();
+  // Ipv6L3Protocol::LocalDeliver hands us its own copy of the packet,
+  // the inner packet is decapsulated in place.
+  Ptr<Packet> p = packet;
   
   Ipv6Header innerHeader;
   p->RemoveHeader(innerHeader);
   
+  return Decapsulate (tunnel, p, innerHeader, src);
+}
+
+enum Ipv6L4Protocol::RxStatus_e Ipv6TunnelL4Protocol::ReceiveCompressed (Ptr<Packet> packet, Ipv6Address const &src, Ipv6Address const &dst, Ptr<Ipv6Interface> interface)
+{
+  NS_LOG_FUNCTION (this << packet << src << dst << interface);
+  
+  TunnelEntry *tunnel = LookupReceiveTunnel (src, dst);
+  Ipv6Header innerHeader;
+  
+  // the contexts belong to the tunnel
+  if (tunnel == 0 || !tunnel->device->Decompress (packet, innerHeader))
+    {
+      m_decapStats.dropped++;
+      return Ipv6L4Protocol::RX_OK;
+    }
+  
+  return Decapsulate (tunnel, packet, innerHeader, src);
+}
+
+enum Ipv6L4Protocol::RxStatus_e Ipv6TunnelL4Protocol::Decapsulate (TunnelEntry *tunnel, Ptr<Packet> p, const Ipv6Header &innerHeader, Ipv6Address src)
+{
+  NS_LOG_FUNCTION (this << tunnel << p << src);
+  
+  Ptr<Ipv6L3Protocol> ipv6 = GetNode()->GetObject<Ipv6L3Protocol>();
+  NS_ASSERT (ipv6 != 0);
+  
   Ipv6Address source = innerHeader.GetSourceAddress();
   Ipv6Address destination = innerHeader.GetDestinationAddress();
   
@@ -163,6 +213,11 @@ enum Ipv6L4Protocol::RxStatus_e Ipv6TunnelL4Protocol::Receive (Ptr<Packet> packe
       destination.IsAllHostsMulticast() ||
       destination.IsSolicitedMulticast())
 	{
+	  m_decapStats.dropped++;
+	  if (tunnel)
+	    {
+	      tunnel->device->RecordReceive (p->GetSize (), false);
+	    }
 	  return Ipv6L4Protocol::RX_OK;
 	}
   
@@ -171,50 +226,160 @@ enum Ipv6L4Protocol::RxStatus_e Ipv6TunnelL4Protocol::Receive (Ptr<Packet> packe
   tag.SetTtl (innerHeader.GetHopLimit() - 1);
   p->AddPacketTag (tag);
   
-  //Prevent infinite loop
-  Ptr<Ipv6Route> route;
-  Socket::SocketErrno err;
-  Ptr<NetDevice> oif (0); //specify non-zero if bound to a source address
+  if (!m_decapCallback.IsNull ())
+    {
+      m_decapCallback (src, innerHeader);
+    }
   
-  Ipv6StaticRoutingHelper routingHelper;
+  //Prevent infinite loop
+  Ptr<Ipv6Route> route = RouteDecapsulated (tunnel, p, innerHeader);
   
-  Ptr<Ipv6StaticRouting> routing = routingHelper.GetStaticRouting (ipv6);
+  m_decapStats.packets++;
+  m_decapStats.bytes += p->GetSize ();
   
-  NS_ASSERT (routing);
+  if (tunnel)
+    {
+      tunnel->device->RecordReceive (p->GetSize (), true);
+    }
   
-  route = routing->RouteOutput (p, innerHeader, oif, err);
+  // Held while its mobile node hands over
+  if (route == 0 && m_prefixRouting && m_prefixRouting->Hold (p, innerHeader))
+    {
+      return Ipv6L4Protocol::RX_OK;
+    }
   
   ipv6->Send(p, source, destination, innerHeader.GetNextHeader(), route);
 
   return Ipv6L4Protocol::RX_OK;
 }
 
+void Ipv6TunnelL4Protocol::ReceiveIcmp (Ipv6Address icmpSource, uint8_t icmpTtl,
+                                        uint8_t icmpType, uint8_t icmpCode, uint32_t icmpInfo,
+                                        Ipv6Address payloadSource, Ipv6Address payloadDestination,
+                                        const uint8_t* payload)
+{
+  NS_LOG_FUNCTION (this << icmpSource << (uint32_t)icmpType << icmpInfo << payloadSource << payloadDestination);
+  
+  if (icmpType != Icmpv6Header::ICMPV6_ERROR_PACKET_TOO_BIG)
+    {
+      return;
+    }
+  
+  // the outer packet went from the local to the remote end-point
+  TunnelEntry *tunnel = LookupReceiveTunnel (payloadDestination, payloadSource);
+  
+  if (tunnel)
+    {
+      NS_LOG_LOGIC ("Path MTU to " << payloadDestination << " lowered to " << icmpInfo);
+      tunnel->device->NotifyPacketTooBig (icmpInfo);
+    }
+}
+
+Ptr<Ipv6Route> Ipv6TunnelL4Protocol::RouteDecapsulated (TunnelEntry *tunnel, Ptr<Packet> p, const Ipv6Header &innerHeader)
+{
+  NS_LOG_FUNCTION (this << tunnel << p);
+  
+  Ipv6Address destination = innerHeader.GetDestinationAddress ();
+  
+  if (tunnel && m_routeCacheEnabled)
+    {
+      if (tunnel->routeCacheGeneration != m_routeCacheGeneration)
+        {
+          tunnel->routeCache.clear ();
+          tunnel->routeCacheGeneration = m_routeCacheGeneration;
+        }
+      
+      RouteCacheI it = tunnel->routeCache.find (destination);
+      
+      if (it != tunnel->routeCache.end ())
+        {
+          m_decapStats.routeCacheHits++;
+          return it->second;
+        }
+    }
+  
+  if (m_staticRouting == 0)
+    {
+      Ipv6StaticRoutingHelper routingHelper;
+      Pmipv6PrefixRoutingHelper prefixRoutingHelper;
+      
+      m_staticRouting = routingHelper.GetStaticRouting (m_node->GetObject<Ipv6> ());
+      m_prefixRouting = prefixRoutingHelper.GetPrefixRouting (m_node->GetObject<Ipv6> ());
+      
+      NS_ASSERT (m_staticRouting);
+    }
+  
+  Socket::SocketErrno err;
+  Ptr<NetDevice> oif (0); //specify non-zero if bound to a source address
+  Ptr<Ipv6Route> route = 0;
+  
+  if (m_prefixRouting)
+    {
+      route = m_prefixRouting->RouteOutput (p, innerHeader, oif, err);
+      
+      if (route == 0 && m_prefixRouting->IsHeld (destination))
+        {
+          return 0;
+        }
+    }
+  if (route == 0)
+    {
+      route = m_staticRouting->RouteOutput (p, innerHeader, oif, err);
+    }
+  
+  m_decapStats.routeCacheMisses++;
+  
+  if (tunnel && m_routeCacheEnabled && route != 0)
+    {
+      if (tunnel->routeCache.size () >= m_routeCacheSize)
+        {
+          tunnel->routeCache.clear ();
+        }
+      tunnel->routeCache[destination] = route;
+    }
+  
+  return route;
+}
+
 uint16_t Ipv6TunnelL4Protocol::AddTunnel(Ipv6Address remote, Ipv6Address local)
 {
   NS_LOG_FUNCTION (this << remote << local);
   
   //Search existing tunnel device
-  Ptr<TunnelNetDevice> dev = GetTunnelDevice(remote);
+  TunnelKey key (local, remote);
+  TunnelTableI it = m_tunnelTable.find (key);
+  Ptr<TunnelNetDevice> dev;
   
-  if (dev == 0)
+  if (it != m_tunnelTable.end ())
     {
-      //Search freed tunnel device
-	  dev = GetTunnelDevice (Ipv6Address::GetZero ());
-	  
-	  if (dev == 0)
-	    {
-		  dev = CreateObject<TunnelNetDevice> ();
-		  dev->SetAddress (Mac48Address::Allocate ());
-		  m_node->AddDevice (dev);
-		  m_tunnelList.push_back (dev);
-		}
-		
-	  dev->SetRemoteAddress(remote);
-	  dev->SetLocalAddress(local);
-	}
-	
+      dev = it->second.device;
+    }
+  else
+    {
+      //Reuse a freed tunnel device
+      if (!m_freeList.empty ())
+        {
+          dev = m_freeList.front ();
+          m_freeList.pop_front ();
+          dev->ResetStatistics ();
+        }
+      else
+        {
+          dev = CreateObject<TunnelNetDevice> ();
+          dev->SetAddress (Mac48Address::Allocate ());
+          m_node->AddDevice (dev);
+        }
+      
+      dev->SetRemoteAddress (remote);
+      dev->SetLocalAddress (local);
+      
+      TunnelEntry &entry = m_tunnelTable[key];
+      entry.device = dev;
+      entry.routeCacheGeneration = m_routeCacheGeneration;
+    }
+  
   dev->IncreaseRefCount ();
-	
+  
   Ptr<Ipv6> ipv6 = m_node->GetObject<Ipv6> ();
   int32_t ifIndex = -1;
   
@@ -222,50 +387,71 @@ uint16_t Ipv6TunnelL4Protocol::AddTunnel(Ipv6Address remote, Ipv6Address local)
   
   if (ifIndex == -1)
     {
-	  ifIndex = ipv6->AddInterface (dev);
-	  
-	  NS_ASSERT_MSG (ifIndex >= 0, "Cannot add an IPv6 interface");
-	  
-	  ipv6->SetMetric (ifIndex, 1);
-	  ipv6->SetUp (ifIndex);
-	}
-	
+      ifIndex = ipv6->AddInterface (dev);
+      
+      NS_ASSERT_MSG (ifIndex >= 0, "Cannot add an IPv6 interface");
+      
+      ipv6->SetMetric (ifIndex, 1);
+      ipv6->SetUp (ifIndex);
+    }
+  
   return ifIndex;
 }
 
-void Ipv6TunnelL4Protocol::RemoveTunnel(Ipv6Address remote)
+void Ipv6TunnelL4Protocol::RemoveTunnel(Ipv6Address remote, Ipv6Address local)
 {
-  NS_LOG_FUNCTION ( this << remote );
+  NS_LOG_FUNCTION ( this << remote << local );
   
-  Ptr<TunnelNetDevice> dev = GetTunnelDevice(remote);
-
-  if( dev )
+  TunnelTableI it = m_tunnelTable.find (TunnelKey (local, remote));
+  
+  if (it == m_tunnelTable.end ())
     {
-	  dev->DecreaseRefCount();
-	  
-	  if(dev->GetRefCount() == 0)
-	    {
-		  dev->SetRemoteAddress(Ipv6Address::GetZero());
-		}
-	}
+      return;
+    }
+  
+  Ptr<TunnelNetDevice> dev = it->second.device;
+  
+  dev->DecreaseRefCount ();
+  
+  if (dev->GetRefCount () == 0)
+    {
+      NS_LOG_LOGIC ("Tunnel to " << remote << " released");
+      
+      m_tunnelTable.erase (it);
+      
+      dev->SetRemoteAddress (Ipv6Address::GetZero ());
+      dev->SetLocalAddress (Ipv6Address::GetZero ());
+      
+      m_freeList.push_back (dev);
+    }
 }
 
 uint16_t  Ipv6TunnelL4Protocol::ModifyTunnel(Ipv6Address remote, Ipv6Address newRemote, Ipv6Address local)
 {
   NS_LOG_FUNCTION ( this << remote << newRemote << local );
   
-  Ptr<TunnelNetDevice> dev = GetTunnelDevice(remote);
-  NS_ASSERT (dev != 0);
+  TunnelTableI it = m_tunnelTable.find (TunnelKey (local, remote));
+  NS_ASSERT (it != m_tunnelTable.end ());
+  
+  Ptr<TunnelNetDevice> dev = it->second.device;
   NS_ASSERT (dev->GetRefCount() > 0);
-	  
-  if (dev->GetRefCount() > 1)
-	{
-	  RemoveTunnel (remote);
-	  
-	  return AddTunnel (newRemote, local);
-	}
-	
+  
+  // the device is shared, or a tunnel to the new end-point already
+  // exists: move the reference instead of re-addressing the device
+  if (dev->GetRefCount() > 1 ||
+      m_tunnelTable.find (TunnelKey (local, newRemote)) != m_tunnelTable.end ())
+    {
+      RemoveTunnel (remote, local);
+      
+      return AddTunnel (newRemote, local);
+    }
+  
+  m_tunnelTable.erase (it);
+  
   dev->SetRemoteAddress (newRemote);
+  TunnelEntry &entry = m_tunnelTable[TunnelKey (local, newRemote)];
+  entry.device = dev;
+  entry.routeCacheGeneration = m_routeCacheGeneration;
   
   Ptr<Ipv6> ipv6 = m_node->GetObject<Ipv6> ();
   
@@ -276,20 +462,159 @@ uint16_t  Ipv6TunnelL4Protocol::ModifyTunnel(Ipv6Address remote, Ipv6Address new
   return ifIndex;
 }
 
-Ptr<TunnelNetDevice> Ipv6TunnelL4Protocol::GetTunnelDevice(Ipv6Address remote)
+Ptr<TunnelNetDevice> Ipv6TunnelL4Protocol::GetTunnelDevice(Ipv6Address remote, Ipv6Address local)
 {
-  NS_LOG_FUNCTION ( this << remote );
+  NS_LOG_FUNCTION ( this << remote << local );
+  
+  TunnelTableI it = m_tunnelTable.find (TunnelKey (local, remote));
   
-  for ( TunnelListI i = m_tunnelList.begin(); i != m_tunnelList.end(); i++ )
+  if (it != m_tunnelTable.end ())
     {
-	  if(remote == (*i)->GetRemoteAddress())
-	    {
-		  return (*i);
-		}
-	}
-
+      return it->second.device;
+    }
+  
   return 0;
 }
+
+uint32_t Ipv6TunnelL4Protocol::GetNTunnels () const
+{
+  NS_LOG_FUNCTION_NOARGS ();
   
-} /* namespace ns3 */
+  return m_tunnelTable.size ();
+}
+
+uint32_t Ipv6TunnelL4Protocol::GetNFreeTunnels () const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  return m_freeList.size ();
+}
+
+Ipv6TunnelL4Protocol::TunnelEntry *Ipv6TunnelL4Protocol::LookupReceiveTunnel (Ipv6Address remote, Ipv6Address local)
+{
+  NS_LOG_FUNCTION ( this << remote << local );
+  
+  TunnelTableI it = m_tunnelTable.find (TunnelKey (local, remote));
+  
+  if (it == m_tunnelTable.end ())
+    {
+      // tunnels whose local end-point is left to routing
+      it = m_tunnelTable.find (TunnelKey (Ipv6Address::GetZero (), remote));
+      
+      if (it == m_tunnelTable.end ())
+        {
+          return 0;
+        }
+    }
+  
+  return &it->second;
+}
+
+void Ipv6TunnelL4Protocol::InvalidateRouteCache ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  // cached routes are dropped lazily, on the next packet of each tunnel
+  m_routeCacheGeneration++;
+}
+
+Ipv6TunnelL4Protocol::DecapStatistics::DecapStatistics ()
+  : packets (0),
+    bytes (0),
+    dropped (0),
+    routeCacheHits (0),
+    routeCacheMisses (0)
+{
+}
+
+const Ipv6TunnelL4Protocol::DecapStatistics &Ipv6TunnelL4Protocol::GetDecapStatistics () const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  return m_decapStats;
+}
+
+void Ipv6TunnelL4Protocol::ResetDecapStatistics ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  m_decapStats = DecapStatistics ();
+}
 
+void Ipv6TunnelL4Protocol::SetDecapCallback (DecapCallback cb)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  m_decapCallback = cb;
+}
+
+TypeId Ipv6TunnelCompressedL4Protocol::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Ipv6TunnelCompressedL4Protocol")
+    .SetParent<Ipv6L4Protocol> ()
+    .AddConstructor<Ipv6TunnelCompressedL4Protocol> ()
+    ;
+  return tid;
+}
+
+Ipv6TunnelCompressedL4Protocol::Ipv6TunnelCompressedL4Protocol ()
+  : m_tunnel (0)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+void Ipv6TunnelCompressedL4Protocol::DoDispose ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  m_tunnel = 0;
+  
+  Ipv6L4Protocol::DoDispose ();
+}
+
+void Ipv6TunnelCompressedL4Protocol::SetTunnelProtocol (Ipv6TunnelL4Protocol *tunnel)
+{
+  NS_LOG_FUNCTION (this << tunnel);
+  
+  m_tunnel = tunnel;
+}
+
+int Ipv6TunnelCompressedL4Protocol::GetProtocolNumber () const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  return Ipv6TunnelCompressedHeader::PROT_NUMBER;
+}
+
+enum Ipv6L4Protocol::RxStatus_e Ipv6TunnelCompressedL4Protocol::Receive (Ptr<Packet> packet, Ipv6Address const &src, Ipv6Address const &dst, Ptr<Ipv6Interface> interface)
+{
+  NS_LOG_FUNCTION (this << packet << src << dst << interface);
+  
+  if (m_tunnel == 0)
+    {
+      return Ipv6L4Protocol::RX_ENDPOINT_UNREACH;
+    }
+  
+  return m_tunnel->ReceiveCompressed (packet, src, dst, interface);
+}
+
+void Ipv6TunnelCompressedL4Protocol::ReceiveIcmp (Ipv6Address icmpSource, uint8_t icmpTtl,
+                                                  uint8_t icmpType, uint8_t icmpCode, uint32_t icmpInfo,
+                                                  Ipv6Address payloadSource, Ipv6Address payloadDestination,
+                                                  const uint8_t* payload)
+{
+  NS_LOG_FUNCTION (this << icmpSource << (uint32_t)icmpType << icmpInfo);
+  
+  if (m_tunnel)
+    {
+      m_tunnel->ReceiveIcmp (icmpSource, icmpTtl, icmpType, icmpCode, icmpInfo, payloadSource, payloadDestination, payload);
+    }
+}
+
+size_t Ipv6TunnelL4Protocol::TunnelKeyHash::operator () (TunnelKey const &x) const
+{
+  Ipv6AddressHash hash;
+  
+  return hash (x.remote) * 31 + hash (x.local);
+}
+  
+} /* namespace ns3 */
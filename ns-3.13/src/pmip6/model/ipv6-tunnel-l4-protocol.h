@@ -25,8 +25,15 @@
 #ifndef IPV6_TUNNEL_L4_PROTOCOL_H
 #define IPV6_TUNNEL_L4_PROTOCOL_H
 
+#include <list>
+
 #include "ns3/ipv6-address.h"
 #include "ns3/ipv6-l4-protocol.h"
+#include "ns3/ipv6-header.h"
+#include "ns3/ipv6-route.h"
+#include "ns3/ipv6-static-routing.h"
+#include "ns3/pmipv6-prefix-routing.h"
+#include "ns3/sgi-hashmap.h"
 #include "ns3/tunnel-net-device.h"
 
 namespace ns3
@@ -34,6 +41,7 @@ namespace ns3
 
 class Node;
 class Packet;
+class Ipv6TunnelCompressedL4Protocol;
 
 /**
  * \class Ipv6TunnelL4Protocol
@@ -110,10 +118,108 @@ public:
    */
   virtual enum Ipv6L4Protocol::RxStatus_e Receive (Ptr<Packet> p, Ipv6Address const &src, Ipv6Address const &dst, Ptr<Ipv6Interface> interface);
 
+  /**
+   * \brief Receive a packet whose inner header is compressed.
+   *
+   * Called by the Ipv6TunnelCompressedL4Protocol of the node. The inner
+   * header is restored from the contexts of the receiving tunnel, then
+   * the packet is decapsulated as by Receive.
+   *
+   * \param p the packet, starting with an Ipv6TunnelCompressedHeader
+   * \param src source address
+   * \param dst destination address
+   * \param interface the interface from which the packet is coming
+   */
+  enum Ipv6L4Protocol::RxStatus_e ReceiveCompressed (Ptr<Packet> p, Ipv6Address const &src, Ipv6Address const &dst, Ptr<Ipv6Interface> interface);
+
+  /**
+   * \brief Receive an ICMPv6 error about an encapsulated packet.
+   *
+   * A Packet Too Big from the outer path lowers the path MTU of the
+   * tunnel which sent the packet.
+   */
+  virtual void ReceiveIcmp (Ipv6Address icmpSource, uint8_t icmpTtl,
+                            uint8_t icmpType, uint8_t icmpCode, uint32_t icmpInfo,
+                            Ipv6Address payloadSource, Ipv6Address payloadDestination,
+                            const uint8_t* payload);
+
+  /**
+   * \brief Get a reference on the tunnel between local and remote.
+   *
+   * The tunnel device is created, or taken from the free-list, when
+   * no tunnel exists between the two end-points.
+   *
+   * \param remote remote end-point
+   * \param local local end-point, any address when chosen by routing
+   * \return the interface index of the tunnel device
+   */
   uint16_t AddTunnel(Ipv6Address remote, Ipv6Address local=Ipv6Address::GetZero());
-  void RemoveTunnel(Ipv6Address remote);
+  
+  /**
+   * \brief Release a reference on a tunnel.
+   *
+   * The device goes back to the free-list when its last reference
+   * is released.
+   */
+  void RemoveTunnel(Ipv6Address remote, Ipv6Address local=Ipv6Address::GetZero());
+  
   uint16_t ModifyTunnel(Ipv6Address remote, Ipv6Address newRemote, Ipv6Address local=Ipv6Address::GetZero());
-  Ptr<TunnelNetDevice> GetTunnelDevice(Ipv6Address remote);
+  
+  Ptr<TunnelNetDevice> GetTunnelDevice(Ipv6Address remote, Ipv6Address local=Ipv6Address::GetZero());
+  
+  /**
+   * \return the number of tunnels in use
+   */
+  uint32_t GetNTunnels () const;
+  
+  /**
+   * \return the number of tunnel devices waiting in the free-list
+   */
+  uint32_t GetNFreeTunnels () const;
+  
+  /**
+   * \brief Drop the forwarding decisions cached for decapsulated packets.
+   *
+   * Must be called whenever the routes used to forward decapsulated
+   * packets change. Pmipv6Lma and Pmipv6Mag call it when they update
+   * the routes of a binding.
+   */
+  void InvalidateRouteCache ();
+  
+  /**
+   * \brief Decapsulation counters.
+   */
+  struct DecapStatistics
+  {
+    DecapStatistics ();
+    
+    uint64_t packets;          //!< packets decapsulated and forwarded
+    uint64_t bytes;            //!< bytes of the forwarded inner packets
+    uint64_t dropped;          //!< inner packets which are not forwarded
+    uint64_t routeCacheHits;   //!< forwarding decisions served by the cache
+    uint64_t routeCacheMisses; //!< forwarding decisions computed by routing
+  };
+  
+  /**
+   * \return the decapsulation counters since creation or the last reset
+   */
+  const DecapStatistics &GetDecapStatistics () const;
+  
+  void ResetDecapStatistics ();
+  
+  /**
+   * \brief Callback observing the decapsulated packets: outer source
+   * (the sending tunnel end-point) and inner header.
+   */
+  typedef Callback<void, const Ipv6Address &, const Ipv6Header &> DecapCallback;
+  
+  /**
+   * \brief Observe the packets decapsulated before they are forwarded.
+   *
+   * Used by Pmipv6Lma to detect the traffic between two of its mobile
+   * nodes. A null callback (the default) disables the observation.
+   */
+  void SetDecapCallback (DecapCallback cb);
   
 protected:
  
@@ -123,16 +229,171 @@ protected:
   virtual void DoDispose ();
   
 private:
+  /**
+   * \brief Tunnel end-points, the key of the tunnel table.
+   */
+  struct TunnelKey
+  {
+    TunnelKey (Ipv6Address l, Ipv6Address r)
+      : local (l), remote (r)
+    {
+    }
+    
+    bool operator == (const TunnelKey &o) const
+    {
+      return local == o.local && remote == o.remote;
+    }
+    
+    Ipv6Address local;
+    Ipv6Address remote;
+  };
+  
+  class TunnelKeyHash : public std::unary_function<TunnelKey, size_t>
+  {
+  public:
+    size_t operator () (TunnelKey const &x) const;
+  };
+  
+  typedef sgi::hash_map<Ipv6Address, Ptr<Ipv6Route>, Ipv6AddressHash> RouteCache;
+  typedef sgi::hash_map<Ipv6Address, Ptr<Ipv6Route>, Ipv6AddressHash>::iterator RouteCacheI;
+  
+  /**
+   * \brief A tunnel in use and the routes of the packets it delivered.
+   */
+  struct TunnelEntry
+  {
+    TunnelEntry ()
+      : routeCacheGeneration (0)
+    {
+    }
+    
+    Ptr<TunnelNetDevice> device;
+    RouteCache routeCache;             //!< inner destination to route
+    uint32_t routeCacheGeneration;     //!< valid while equal to m_routeCacheGeneration
+  };
+  
+  typedef sgi::hash_map<TunnelKey, TunnelEntry, TunnelKeyHash> TunnelTable;
+  typedef sgi::hash_map<TunnelKey, TunnelEntry, TunnelKeyHash>::iterator TunnelTableI;
   typedef std::list< Ptr<TunnelNetDevice> > TunnelList;
-  typedef std::list< Ptr<TunnelNetDevice> >::iterator TunnelListI;
+  
+  /**
+   * \brief Find the tunnel which terminates a received packet.
+   * \param remote outer source address
+   * \param local outer destination address
+   * \return the tunnel entry, or 0 if no tunnel matches
+   */
+  TunnelEntry *LookupReceiveTunnel (Ipv6Address remote, Ipv6Address local);
+  
+  /**
+   * \brief Forward a packet once its outer and inner headers are removed.
+   * \param tunnel the receiving tunnel, 0 if none
+   * \param p the inner payload
+   * \param innerHeader the inner header
+   * \param src outer source address
+   */
+  enum Ipv6L4Protocol::RxStatus_e Decapsulate (TunnelEntry *tunnel, Ptr<Packet> p, const Ipv6Header &innerHeader, Ipv6Address src);
+  
+  /**
+   * \brief Route a decapsulated packet, through the tunnel route cache if possible.
+   */
+  Ptr<Ipv6Route> RouteDecapsulated (TunnelEntry *tunnel, Ptr<Packet> p, const Ipv6Header &innerHeader);
   
   /**
    * \brief The node.
    */
   Ptr<Node> m_node;
   
-  TunnelList m_tunnelList;
+  /**
+   * \brief Tunnels in use, keyed by (local, remote).
+   */
+  TunnelTable m_tunnelTable;
   
+  /**
+   * \brief Released tunnel devices, reused before creating new ones.
+   */
+  TunnelList m_freeList;
+  
+  /**
+   * \brief Receives the packets with a compressed inner header.
+   */
+  Ptr<Ipv6TunnelCompressedL4Protocol> m_compressedProtocol;
+  
+  /**
+   * \brief Static routing of the node, used to forward decapsulated packets.
+   */
+  Ptr<Ipv6StaticRouting> m_staticRouting;
+  
+  /**
+   * \brief Home network prefix routing of the node, if any, looked up first.
+   */
+  Ptr<Pmipv6PrefixRouting> m_prefixRouting;
+  
+  bool m_routeCacheEnabled;
+  uint32_t m_routeCacheSize;
+  uint32_t m_routeCacheGeneration;
+  
+  DecapStatistics m_decapStats;
+  
+  DecapCallback m_decapCallback;
+  
+};
+
+/**
+ * \class Ipv6TunnelCompressedL4Protocol
+ * \brief Receives the tunneled packets with a compressed inner header
+ * (Ipv6TunnelCompressedHeader) and hands them to the Ipv6TunnelL4Protocol
+ * of the node, which creates it.
+ */
+class Ipv6TunnelCompressedL4Protocol : public Ipv6L4Protocol
+{
+public:
+  /**
+   * \brief Interface ID
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief Constructor.
+   */
+  Ipv6TunnelCompressedL4Protocol ();
+
+  /**
+   * \brief Set the tunnel protocol the packets are handed to.
+   * \param tunnel the tunnel protocol, not referenced
+   */
+  void SetTunnelProtocol (Ipv6TunnelL4Protocol *tunnel);
+
+  /**
+   * \brief Get the protocol number.
+   * \return Ipv6TunnelCompressedHeader::PROT_NUMBER
+   */
+  virtual int GetProtocolNumber () const;
+
+  /**
+   * \brief Receive method.
+   * \param p the packet
+   * \param src source address
+   * \param dst destination address
+   * \param interface the interface from which the packet is coming
+   */
+  virtual enum Ipv6L4Protocol::RxStatus_e Receive (Ptr<Packet> p, Ipv6Address const &src, Ipv6Address const &dst, Ptr<Ipv6Interface> interface);
+
+  /**
+   * \brief Receive an ICMPv6 error about a compressed packet.
+   */
+  virtual void ReceiveIcmp (Ipv6Address icmpSource, uint8_t icmpTtl,
+                            uint8_t icmpType, uint8_t icmpCode, uint32_t icmpInfo,
+                            Ipv6Address payloadSource, Ipv6Address payloadDestination,
+                            const uint8_t* payload);
+
+protected:
+  /**
+   * \brief Dispose this object.
+   */
+  virtual void DoDispose ();
+
+private:
+  Ipv6TunnelL4Protocol *m_tunnel;
 };
 
 } /* namespace ns3 */
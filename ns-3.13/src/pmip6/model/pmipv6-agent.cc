@@ -36,6 +36,7 @@
 #include "ns3/ipv6-interface.h"
 
 #include "pmipv6-profile.h"
+#include "pmipv6-processor.h"
 #include "ipv6-mobility-header.h"
 #include "pmipv6-agent.h"
 
@@ -74,6 +75,11 @@ void Pmipv6Agent::DoDispose ()
 
   m_node = 0;
   m_profile = 0;
+  if (m_processor)
+    {
+      m_processor->Dispose ();
+      m_processor = 0;
+    }
   Object::DoDispose ();
 }
 
@@ -103,10 +109,42 @@ void Pmipv6Agent::SetProfile(Ptr<Pmipv6Profile> pf)
   m_profile = pf;
 }
 
+void Pmipv6Agent::SetProcessor (Ptr<Pmipv6Processor> processor)
+{
+  NS_LOG_FUNCTION (this << processor);
+  
+  m_processor = processor;
+  
+  if (m_processor)
+    {
+      m_processor->SetProcessCallback (MakeCallback (&Pmipv6Agent::Dispatch, this));
+    }
+}
+
+Ptr<Pmipv6Processor> Pmipv6Agent::GetProcessor () const
+{
+  NS_LOG_FUNCTION_NOARGS();
+  
+  return m_processor;
+}
+
 uint8_t Pmipv6Agent::Receive (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface)
 {
   NS_LOG_FUNCTION ( this << packet << src << dst << interface );
   
+  if (m_processor)
+    {
+      m_processor->Receive (packet, src, dst, interface);
+      return 0;
+    }
+  
+  return Dispatch (packet, src, dst, interface);
+}
+
+uint8_t Pmipv6Agent::Dispatch (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface)
+{
+  NS_LOG_FUNCTION ( this << packet << src << dst << interface );
+  
   Ptr<Packet> p = packet->Copy ();
   
   Ipv6MobilityHeader mh;
@@ -123,6 +161,22 @@ uint8_t Pmipv6Agent::Receive (Ptr<Packet> packet, const Ipv6Address &src, const
     {
 	  HandlePba (packet, src, dst, interface);
 	}
+  else if (mhType == Ipv6MobilityHeader::IPV6_MOBILITY_HANDOVER_INITIATE)
+    {
+      HandleHi (packet, src, dst, interface);
+    }
+  else if (mhType == Ipv6MobilityHeader::IPV6_MOBILITY_HANDOVER_ACKNOWLEDGE)
+    {
+      HandleHack (packet, src, dst, interface);
+    }
+  else if (mhType == Ipv6MobilityHeader::IPV6_MOBILITY_LOCALIZED_ROUTING_INITIATION)
+    {
+      HandleLri (packet, src, dst, interface);
+    }
+  else if (mhType == Ipv6MobilityHeader::IPV6_MOBILITY_LOCALIZED_ROUTING_ACKNOWLEDGEMENT)
+    {
+      HandleLra (packet, src, dst, interface);
+    }
   else
     {
 	  NS_LOG_ERROR ("Unknown MHType (" << (uint32_t)mhType << ")");
@@ -180,5 +234,41 @@ uint8_t Pmipv6Agent::HandlePba (Ptr<Packet> packet, const Ipv6Address &src, cons
   return 0;
 }
 
+uint8_t Pmipv6Agent::HandleHi (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface)
+{
+  NS_LOG_FUNCTION ( this << src << dst );
+  
+  NS_LOG_WARN ("No handler for HI message");
+  
+  return 0;
+}
+
+uint8_t Pmipv6Agent::HandleHack (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface)
+{
+  NS_LOG_FUNCTION ( this << src << dst );
+  
+  NS_LOG_WARN ("No handler for HAck message");
+  
+  return 0;
+}
+
+uint8_t Pmipv6Agent::HandleLri (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface)
+{
+  NS_LOG_FUNCTION ( this << src << dst );
+  
+  NS_LOG_WARN ("No handler for LRI message");
+  
+  return 0;
+}
+
+uint8_t Pmipv6Agent::HandleLra (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface)
+{
+  NS_LOG_FUNCTION ( this << src << dst );
+  
+  NS_LOG_WARN ("No handler for LRA message");
+  
+  return 0;
+}
+
 } /* namespace ns3 */
 
@@ -35,6 +35,7 @@ class Node;
 class Packet;
 class Ipv6Interface;
 class Pmipv6Profile;
+class Pmipv6Processor;
 
 /**
  * \class Pmip6Agent
@@ -73,14 +74,34 @@ public:
   Ptr<Pmipv6Profile> GetProfile() const;
   void SetProfile (Ptr<Pmipv6Profile> pf);
   
+  /**
+   * \brief Set the signaling processing model of this agent.
+   * \param processor the processor, or 0 to handle the messages at once
+   */
+  void SetProcessor (Ptr<Pmipv6Processor> processor);
+  Ptr<Pmipv6Processor> GetProcessor () const;
+  
   virtual uint8_t Receive (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface);
   
   void SendMessage(Ptr<Packet> packet, Ipv6Address dst, uint32_t ttl);
   
 protected:
+  /**
+   * \brief Hand a mobility message to its handler.
+   */
+  uint8_t Dispatch (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface);
+  
   virtual uint8_t HandlePbu (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface);
   virtual uint8_t HandlePba (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface);
   
+  /* fast handover between MAGs (RFC 5949) */
+  virtual uint8_t HandleHi (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface);
+  virtual uint8_t HandleHack (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface);
+  
+  /* localized routing between MAGs (RFC 6705) */
+  virtual uint8_t HandleLri (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface);
+  virtual uint8_t HandleLra (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface);
+  
   /**
    * \brief Dispose this object.
    */
@@ -94,6 +115,8 @@ private:
   Ptr<Node> m_node;
   
   Ptr<Pmipv6Profile> m_profile;
+  
+  Ptr<Pmipv6Processor> m_processor;
 };
 
 } /* namespace ns3 */
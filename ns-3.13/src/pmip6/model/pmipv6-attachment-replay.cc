@@ -0,0 +1,247 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include <sstream>
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/trace-source-accessor.h"
+
+#include "ipv6-mobility-header.h"
+#include "pmipv6-mag-notifier.h"
+#include "pmipv6-attachment-replay.h"
+
+NS_LOG_COMPONENT_DEFINE ("Pmipv6AttachmentReplay");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED (Pmipv6AttachmentReplay);
+
+TypeId Pmipv6AttachmentReplay::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Pmipv6AttachmentReplay")
+    .SetParent<Object> ()
+    .AddConstructor<Pmipv6AttachmentReplay> ()
+    .AddTraceSource ("Attach",
+                     "A MN of the trace attached to a MAG.",
+                     MakeTraceSourceAccessor (&Pmipv6AttachmentReplay::m_attachTrace))
+    .AddTraceSource ("Detach",
+                     "A MN of the trace left a MAG.",
+                     MakeTraceSourceAccessor (&Pmipv6AttachmentReplay::m_detachTrace))
+    ;
+  return tid;
+}
+
+Pmipv6AttachmentReplay::Pmipv6AttachmentReplay ()
+  : m_line (0),
+    m_nAttachments (0),
+    m_nDetachments (0),
+    m_nErrors (0)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+Pmipv6AttachmentReplay::~Pmipv6AttachmentReplay ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+void Pmipv6AttachmentReplay::DoDispose ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  m_event.Cancel ();
+
+  if (m_trace.is_open ())
+    {
+      m_trace.close ();
+    }
+
+  m_mags.clear ();
+  Object::DoDispose ();
+}
+
+uint32_t Pmipv6AttachmentReplay::AddMag (Ptr<Node> mag, Mac48Address device)
+{
+  NS_LOG_FUNCTION (this << mag << device);
+
+  Ptr<Pmipv6MagNotifier> notifier = mag->GetObject<Pmipv6MagNotifier> ();
+
+  NS_ASSERT_MSG (notifier != 0, "MAG " << mag->GetId () << " is not installed for remote access points");
+
+  Mag entry;
+
+  entry.notifier = notifier;
+  entry.device = device;
+
+  m_mags.push_back (entry);
+
+  return m_mags.size () - 1;
+}
+
+bool Pmipv6AttachmentReplay::Open (std::string fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+
+  m_event.Cancel ();
+
+  if (m_trace.is_open ())
+    {
+      m_trace.close ();
+    }
+
+  m_trace.clear ();
+  m_trace.open (fileName.c_str ());
+
+  if (!m_trace.is_open ())
+    {
+      NS_LOG_WARN ("Cannot open attachment trace " << fileName);
+
+      return false;
+    }
+
+  m_fileName = fileName;
+  m_line = 0;
+
+  ScheduleNext ();
+
+  return true;
+}
+
+uint64_t Pmipv6AttachmentReplay::GetNAttachments () const
+{
+  return m_nAttachments;
+}
+
+uint64_t Pmipv6AttachmentReplay::GetNDetachments () const
+{
+  return m_nDetachments;
+}
+
+uint64_t Pmipv6AttachmentReplay::GetNErrors () const
+{
+  return m_nErrors;
+}
+
+bool Pmipv6AttachmentReplay::ReadRecord ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  std::string line;
+
+  while (std::getline (m_trace, line))
+    {
+      m_line++;
+
+      std::istringstream iss (line);
+      std::string kind, mac;
+      double seconds;
+      uint32_t mag;
+      uint32_t att = Ipv6MobilityHeader::OPT_ATT_IEEE_802_11ABG;
+
+      if (!(iss >> kind) || kind[0] == '#')
+        {
+          continue;
+        }
+
+      iss.clear ();
+      iss.seekg (0);
+
+      if (!(iss >> seconds >> kind >> mac >> mag) ||
+          (kind != "attach" && kind != "detach") ||
+          mac.size () != 17 ||
+          mag >= m_mags.size () ||
+          seconds < 0)
+        {
+          NS_LOG_WARN (m_fileName << ":" << m_line << ": malformed record skipped");
+          m_nErrors++;
+
+          continue;
+        }
+
+      iss >> att;
+
+      m_next.time = Seconds (seconds);
+      m_next.attach = (kind == "attach");
+      m_next.mn = Mac48Address (mac.c_str ());
+      m_next.mag = mag;
+      m_next.att = att;
+
+      return true;
+    }
+
+  NS_LOG_LOGIC ("End of attachment trace " << m_fileName);
+
+  m_trace.close ();
+
+  return false;
+}
+
+void Pmipv6AttachmentReplay::ScheduleNext ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  if (!ReadRecord ())
+    {
+      return;
+    }
+
+  Time delay = m_next.time - Simulator::Now ();
+
+  if (delay.IsStrictlyNegative ())
+    {
+      NS_LOG_WARN (m_fileName << ":" << m_line << ": record out of order, replayed now");
+      delay = Seconds (0);
+    }
+
+  m_event = Simulator::Schedule (delay, &Pmipv6AttachmentReplay::Replay, this);
+}
+
+void Pmipv6AttachmentReplay::Replay ()
+{
+  NS_LOG_FUNCTION (this << m_next.mn << m_next.mag);
+
+  Mag &mag = m_mags[m_next.mag];
+
+  if (m_next.attach)
+    {
+      m_nAttachments++;
+      m_attachTrace (m_next.mn, m_next.mag);
+
+      mag.notifier->NotifyNewNode (m_next.mn, mag.device, m_next.att);
+    }
+  else
+    {
+      m_nDetachments++;
+      m_detachTrace (m_next.mn, m_next.mag);
+
+      mag.notifier->NotifyDetachedNode (m_next.mn, mag.device);
+    }
+
+  ScheduleNext ();
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef PMIPV6_ATTACHMENT_REPLAY_H
+#define PMIPV6_ATTACHMENT_REPLAY_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/mac48-address.h"
+#include "ns3/traced-callback.h"
+
+namespace ns3
+{
+
+class Node;
+class Pmipv6MagNotifier;
+
+/**
+ * \class Pmipv6AttachmentReplay
+ * \brief Drives the MAGs from a trace of attachments and detachments.
+ *
+ * Stands in for the access networks when only the PMIPv6 signaling is
+ * of interest: no MN node, radio or access link is simulated, each
+ * record of the trace is handed to the Pmipv6MagNotifier of a MAG as if
+ * an access point had reported it. The MAGs must be installed with a
+ * (possibly empty) list of access points, and the MNs need a profile.
+ *
+ * A record is one line:
+ *
+ *   <time> attach|detach <MN MAC address> <MAG> [<ATT>]
+ *
+ * with the time in seconds, the MAG as its index in the order of AddMag
+ * and the access technology type defaulting to IEEE 802.11. Blank lines
+ * and lines starting with '#' are skipped. Records must be sorted by
+ * time; the trace is read as the simulation goes, one record ahead, so
+ * it can hold any number of subscribers.
+ */
+class Pmipv6AttachmentReplay : public Object
+{
+public:
+  static TypeId GetTypeId ();
+
+  Pmipv6AttachmentReplay ();
+  virtual ~Pmipv6AttachmentReplay ();
+
+  /**
+   * \param mag node with a MAG installed for remote access points
+   * \param device MAC address of the MAG access device the MNs attach to
+   * \return the index of the MAG in the trace
+   */
+  uint32_t AddMag (Ptr<Node> mag, Mac48Address device);
+
+  /**
+   * \brief Open the trace and schedule its first record.
+   * \return false if the file cannot be read
+   */
+  bool Open (std::string fileName);
+
+  uint64_t GetNAttachments () const;
+  uint64_t GetNDetachments () const;
+
+  /**
+   * \return the number of malformed records, skipped
+   */
+  uint64_t GetNErrors () const;
+
+protected:
+  virtual void DoDispose ();
+
+private:
+  struct Record
+  {
+    Time time;
+    bool attach;
+    Mac48Address mn;
+    uint32_t mag;
+    uint8_t att;
+  };
+
+  struct Mag
+  {
+    Ptr<Pmipv6MagNotifier> notifier;
+    Mac48Address device;
+  };
+
+  /**
+   * \brief Read the next valid record into m_next.
+   * \return false at the end of the trace
+   */
+  bool ReadRecord ();
+  void ScheduleNext ();
+  void Replay ();
+
+  std::vector<Mag> m_mags;
+
+  std::ifstream m_trace;
+  std::string m_fileName;
+  uint32_t m_line;
+  Record m_next;
+  EventId m_event;
+
+  uint64_t m_nAttachments;
+  uint64_t m_nDetachments;
+  uint64_t m_nErrors;
+
+  TracedCallback<Mac48Address, uint32_t> m_attachTrace;
+  TracedCallback<Mac48Address, uint32_t> m_detachTrace;
+};
+
+} /* namespace ns3 */
+
+#endif /* PMIPV6_ATTACHMENT_REPLAY_H */
@@ -0,0 +1,324 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/trace-source-accessor.h"
+
+#include "pmipv6-handover-buffer.h"
+
+NS_LOG_COMPONENT_DEFINE ("Pmipv6HandoverBuffer");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED (Pmipv6HandoverBuffer);
+
+TypeId Pmipv6HandoverBuffer::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Pmipv6HandoverBuffer")
+    .SetParent<Object> ()
+    .AddConstructor<Pmipv6HandoverBuffer> ()
+    .AddTraceSource ("Buffered",
+                     "A packet of a MN handing over was queued.",
+                     MakeTraceSourceAccessor (&Pmipv6HandoverBuffer::m_bufferedTrace))
+    .AddTraceSource ("Forwarded",
+                     "A packet of a MN handing over was forwarded or delivered.",
+                     MakeTraceSourceAccessor (&Pmipv6HandoverBuffer::m_forwardedTrace))
+    .AddTraceSource ("Dropped",
+                     "A packet of a MN handing over was dropped.",
+                     MakeTraceSourceAccessor (&Pmipv6HandoverBuffer::m_droppedTrace))
+    ;
+  return tid;
+}
+
+Pmipv6HandoverBuffer::Pmipv6HandoverBuffer ()
+  : m_maxPackets (64),
+    m_maxBytes (1 << 20),
+    m_dropPolicy (DROP_TAIL),
+    m_bytes (0),
+    m_nBuffered (0),
+    m_nForwarded (0),
+    m_nDropped (0)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+Pmipv6HandoverBuffer::~Pmipv6HandoverBuffer ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+void Pmipv6HandoverBuffer::DoDispose ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  m_queues.clear ();
+  m_owners.clear ();
+  m_bytes = 0;
+
+  Object::DoDispose ();
+}
+
+void Pmipv6HandoverBuffer::SetMaxPackets (uint32_t maxPackets)
+{
+  m_maxPackets = maxPackets;
+}
+
+uint32_t Pmipv6HandoverBuffer::GetMaxPackets () const
+{
+  return m_maxPackets;
+}
+
+void Pmipv6HandoverBuffer::SetMaxBytes (uint32_t maxBytes)
+{
+  m_maxBytes = maxBytes;
+}
+
+uint32_t Pmipv6HandoverBuffer::GetMaxBytes () const
+{
+  return m_maxBytes;
+}
+
+void Pmipv6HandoverBuffer::SetDropPolicy (enum DropPolicy_e policy)
+{
+  m_dropPolicy = policy;
+}
+
+enum Pmipv6HandoverBuffer::DropPolicy_e Pmipv6HandoverBuffer::GetDropPolicy () const
+{
+  return m_dropPolicy;
+}
+
+void Pmipv6HandoverBuffer::Open (const Identifier &mnId, const std::list<Ipv6Address> &hnps)
+{
+  NS_LOG_FUNCTION (this << mnId);
+
+  Queue &queue = m_queues[mnId];
+
+  for (std::list<Ipv6Address>::const_iterator i = hnps.begin (); i != hnps.end (); i++)
+    {
+      Ipv6Address prefix = (*i);
+
+      prefix = prefix.CombinePrefix (Ipv6Prefix (64));
+
+      queue.hnps.push_back (prefix);
+      m_owners[prefix] = mnId;
+    }
+}
+
+void Pmipv6HandoverBuffer::Close (const Identifier &mnId)
+{
+  NS_LOG_FUNCTION (this << mnId);
+
+  Queues::iterator it = m_queues.find (mnId);
+
+  if (it == m_queues.end ())
+    {
+      return;
+    }
+
+  Queue &queue = it->second;
+
+  for (std::list<Item>::iterator i = queue.items.begin (); i != queue.items.end (); i++)
+    {
+      Drop (i->packet);
+    }
+
+  m_bytes -= queue.bytes;
+
+  for (std::list<Ipv6Address>::iterator i = queue.hnps.begin (); i != queue.hnps.end (); i++)
+    {
+      PrefixOwners::iterator owner = m_owners.find (*i);
+
+      //the prefix may have been taken over by a newer queue
+      if (owner != m_owners.end () && owner->second == mnId)
+        {
+          m_owners.erase (owner);
+        }
+    }
+
+  m_queues.erase (it);
+}
+
+bool Pmipv6HandoverBuffer::IsOpen (const Identifier &mnId) const
+{
+  return m_queues.find (mnId) != m_queues.end ();
+}
+
+bool Pmipv6HandoverBuffer::Receive (Ptr<Packet> p, const Ipv6Header &header)
+{
+  NS_LOG_FUNCTION (this << p << header.GetDestinationAddress ());
+
+  Ipv6Address dst = header.GetDestinationAddress ();
+  PrefixOwners::iterator owner = m_owners.find (dst.CombinePrefix (Ipv6Prefix (64)));
+
+  if (owner == m_owners.end ())
+    {
+      NS_LOG_LOGIC ("No MN handing over for " << dst);
+      Drop (p);
+      return false;
+    }
+
+  Queue &queue = m_queues[owner->second];
+
+  if (!queue.forward.IsNull ())
+    {
+      m_nForwarded++;
+      m_forwardedTrace (p);
+      queue.forward (owner->second, p, header);
+      return true;
+    }
+
+  uint32_t size = p->GetSize () + header.GetSerializedSize ();
+
+  if (m_dropPolicy == DROP_HEAD)
+    {
+      while (!queue.items.empty () &&
+             (queue.items.size () >= m_maxPackets || m_bytes + size > m_maxBytes))
+        {
+          Item &head = queue.items.front ();
+          uint32_t headSize = head.packet->GetSize () + head.header.GetSerializedSize ();
+
+          Drop (head.packet);
+
+          queue.bytes -= headSize;
+          m_bytes -= headSize;
+          queue.items.pop_front ();
+        }
+    }
+
+  if (queue.items.size () >= m_maxPackets || m_bytes + size > m_maxBytes)
+    {
+      NS_LOG_LOGIC ("Buffer of " << owner->second << " full, packet dropped");
+      Drop (p);
+      return false;
+    }
+
+  Item item;
+
+  item.packet = p;
+  item.header = header;
+
+  queue.items.push_back (item);
+  queue.bytes += size;
+  m_bytes += size;
+
+  m_nBuffered++;
+  m_bufferedTrace (p);
+
+  return true;
+}
+
+void Pmipv6HandoverBuffer::Forward (const Identifier &mnId, ForwardCallback cb)
+{
+  NS_LOG_FUNCTION (this << mnId);
+
+  Queues::iterator it = m_queues.find (mnId);
+
+  if (it == m_queues.end ())
+    {
+      NS_LOG_LOGIC ("No buffer for " << mnId);
+      return;
+    }
+
+  it->second.forward = cb;
+
+  Dequeue (it->second, mnId, cb);
+}
+
+void Pmipv6HandoverBuffer::Flush (const Identifier &mnId, ForwardCallback cb)
+{
+  NS_LOG_FUNCTION (this << mnId);
+
+  Queues::iterator it = m_queues.find (mnId);
+
+  if (it == m_queues.end ())
+    {
+      NS_LOG_LOGIC ("No buffer for " << mnId);
+      return;
+    }
+
+  Dequeue (it->second, mnId, cb);
+
+  Close (mnId);
+}
+
+uint32_t Pmipv6HandoverBuffer::GetNPackets (const Identifier &mnId) const
+{
+  Queues::const_iterator it = m_queues.find (mnId);
+
+  if (it == m_queues.end ())
+    {
+      return 0;
+    }
+
+  return it->second.items.size ();
+}
+
+uint32_t Pmipv6HandoverBuffer::GetNBytes () const
+{
+  return m_bytes;
+}
+
+uint64_t Pmipv6HandoverBuffer::GetNBuffered () const
+{
+  return m_nBuffered;
+}
+
+uint64_t Pmipv6HandoverBuffer::GetNForwarded () const
+{
+  return m_nForwarded;
+}
+
+uint64_t Pmipv6HandoverBuffer::GetNDropped () const
+{
+  return m_nDropped;
+}
+
+void Pmipv6HandoverBuffer::Drop (Ptr<const Packet> p)
+{
+  m_nDropped++;
+  m_droppedTrace (p);
+}
+
+void Pmipv6HandoverBuffer::Dequeue (Queue &queue, const Identifier &mnId, ForwardCallback cb)
+{
+  NS_LOG_FUNCTION (this << mnId << queue.items.size ());
+
+  //the callback may hold packets again
+  std::list<Item> items;
+
+  items.swap (queue.items);
+  m_bytes -= queue.bytes;
+  queue.bytes = 0;
+
+  for (std::list<Item>::iterator i = items.begin (); i != items.end (); i++)
+    {
+      m_nForwarded++;
+      m_forwardedTrace (i->packet);
+      cb (mnId, i->packet, i->header);
+    }
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef PMIPV6_HANDOVER_BUFFER_H
+#define PMIPV6_HANDOVER_BUFFER_H
+
+#include <stdint.h>
+#include <list>
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/packet.h"
+#include "ns3/callback.h"
+#include "ns3/ipv6-address.h"
+#include "ns3/ipv6-header.h"
+#include "ns3/traced-callback.h"
+#include "ns3/sgi-hashmap.h"
+
+#include "identifier.h"
+
+namespace ns3
+{
+
+/**
+ * \class Pmipv6HandoverBuffer
+ * \brief Downlink packets of the MNs handing over between MAGs.
+ *
+ * The packets to the home network prefixes held by the prefix routing
+ * of a MAG (see Pmipv6PrefixRouting::AddHoldRoute) are queued per MN
+ * while the MN moves: on the previous MAG from the detachment until the
+ * next MAG is known, on the next MAG until the LMA accepted the binding.
+ * The queue is then handed to a callback, which forwards the packets to
+ * the next MAG or delivers them to the MN, and so are the packets held
+ * afterwards if the MN is forwarded.
+ *
+ * Each MN queue is bounded in packets and all the queues together in
+ * bytes, the packets over the limits are dropped at the tail (the
+ * incoming packet) or at the head (the oldest packets of the MN).
+ */
+class Pmipv6HandoverBuffer : public Object
+{
+public:
+  static TypeId GetTypeId ();
+
+  enum DropPolicy_e
+  {
+    DROP_TAIL,
+    DROP_HEAD
+  };
+
+  /**
+   * \brief Receives the packets handed over, without their IPv6 header
+   * and with a SocketIpTtlTag set to the hop limit left.
+   */
+  typedef Callback<void, const Identifier &, Ptr<Packet>, const Ipv6Header &> ForwardCallback;
+
+  Pmipv6HandoverBuffer ();
+  virtual ~Pmipv6HandoverBuffer ();
+
+  /**
+   * \brief Maximum number of packets queued per MN (64 by default).
+   */
+  void SetMaxPackets (uint32_t maxPackets);
+  uint32_t GetMaxPackets () const;
+
+  /**
+   * \brief Maximum number of bytes queued for all the MNs (1MB by default).
+   */
+  void SetMaxBytes (uint32_t maxBytes);
+  uint32_t GetMaxBytes () const;
+
+  void SetDropPolicy (enum DropPolicy_e policy);
+  enum DropPolicy_e GetDropPolicy () const;
+
+  /**
+   * \brief Start queuing the packets to the prefixes of a MN.
+   * \param mnId MN identifier
+   * \param hnps home network prefixes of the MN
+   */
+  void Open (const Identifier &mnId, const std::list<Ipv6Address> &hnps);
+
+  /**
+   * \brief Stop handling the packets of a MN, dropping those still queued.
+   */
+  void Close (const Identifier &mnId);
+
+  bool IsOpen (const Identifier &mnId) const;
+
+  /**
+   * \brief Queue a held packet, or forward it if its MN is forwarded.
+   * \param p packet without its IPv6 header, with a SocketIpTtlTag
+   * \param header its IPv6 header
+   * \return false if the packet was dropped
+   */
+  bool Receive (Ptr<Packet> p, const Ipv6Header &header);
+
+  /**
+   * \brief Hand the packets queued for a MN to a callback, and the
+   * packets received for it from now on.
+   */
+  void Forward (const Identifier &mnId, ForwardCallback cb);
+
+  /**
+   * \brief Hand the packets queued for a MN to a callback and close
+   * its queue.
+   */
+  void Flush (const Identifier &mnId, ForwardCallback cb);
+
+  /**
+   * \return the number of packets queued for a MN
+   */
+  uint32_t GetNPackets (const Identifier &mnId) const;
+
+  /**
+   * \return the number of bytes queued for all the MNs
+   */
+  uint32_t GetNBytes () const;
+
+  /**
+   * \return the number of packets queued, forwarded and dropped so far
+   */
+  uint64_t GetNBuffered () const;
+  uint64_t GetNForwarded () const;
+  uint64_t GetNDropped () const;
+
+protected:
+  virtual void DoDispose ();
+
+private:
+  struct Item
+  {
+    Ptr<Packet> packet;
+    Ipv6Header header;
+  };
+
+  struct Queue
+  {
+    Queue ()
+      : bytes (0)
+    {
+    }
+
+    std::list<Ipv6Address> hnps;
+    std::list<Item> items;
+    uint32_t bytes;
+    ForwardCallback forward;
+  };
+
+  typedef sgi::hash_map<Identifier, Queue, IdentifierHash> Queues;
+  typedef sgi::hash_map<Ipv6Address, Identifier, Ipv6AddressHash> PrefixOwners;
+
+  void Drop (Ptr<const Packet> p);
+  void Dequeue (Queue &queue, const Identifier &mnId, ForwardCallback cb);
+
+  uint32_t m_maxPackets;
+  uint32_t m_maxBytes;
+  enum DropPolicy_e m_dropPolicy;
+
+  Queues m_queues;
+  PrefixOwners m_owners;        //!< MN of each /64 home network prefix
+  uint32_t m_bytes;
+
+  uint64_t m_nBuffered;
+  uint64_t m_nForwarded;
+  uint64_t m_nDropped;
+
+  TracedCallback<Ptr<const Packet> > m_bufferedTrace;
+  TracedCallback<Ptr<const Packet> > m_forwardedTrace;
+  TracedCallback<Ptr<const Packet> > m_droppedTrace;
+};
+
+} /* namespace ns3 */
+
+#endif /* PMIPV6_HANDOVER_BUFFER_H */
@@ -0,0 +1,356 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include "pmipv6-lma-pool.h"
+
+NS_LOG_COMPONENT_DEFINE ("Pmipv6LmaPool");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED (Pmipv6LmaPool);
+
+/* spread the bits of a hash (MurmurHash3 finalizer) */
+static uint32_t
+Mix (uint32_t h)
+{
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35;
+  h ^= h >> 16;
+
+  return h;
+}
+
+/* FNV-1a of a LMA address and a point number */
+static uint32_t
+HashPoint (Ipv6Address lma, uint32_t point)
+{
+  uint8_t buf[20];
+  uint32_t h = 2166136261U;
+
+  lma.Serialize (buf);
+  buf[16] = point >> 24;
+  buf[17] = point >> 16;
+  buf[18] = point >> 8;
+  buf[19] = point;
+
+  for (uint32_t i = 0; i < sizeof (buf); i++)
+    {
+      h = (h ^ buf[i]) * 16777619U;
+    }
+
+  return Mix (h);
+}
+
+TypeId Pmipv6LmaPool::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Pmipv6LmaPool")
+    .SetParent<Object> ()
+    .AddConstructor<Pmipv6LmaPool> ()
+    ;
+  return tid;
+}
+
+Pmipv6LmaPool::Pmipv6LmaPool ()
+  : m_selection (CONSISTENT_HASH),
+    m_virtualNodes (64)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+Pmipv6LmaPool::~Pmipv6LmaPool ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+void Pmipv6LmaPool::DoDispose ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  m_lmas.clear ();
+  m_ring.clear ();
+  m_assignments.clear ();
+  Object::DoDispose ();
+}
+
+void Pmipv6LmaPool::SetSelection (enum Selection_e selection)
+{
+  NS_LOG_FUNCTION (this << selection);
+  m_selection = selection;
+}
+
+enum Pmipv6LmaPool::Selection_e Pmipv6LmaPool::GetSelection () const
+{
+  return m_selection;
+}
+
+void Pmipv6LmaPool::SetVirtualNodes (uint32_t virtualNodes)
+{
+  NS_LOG_FUNCTION (this << virtualNodes);
+  NS_ASSERT (virtualNodes > 0);
+
+  m_virtualNodes = virtualNodes;
+  BuildRing ();
+}
+
+void Pmipv6LmaPool::AddLma (Ipv6Address lma, uint32_t weight)
+{
+  NS_LOG_FUNCTION (this << lma << weight);
+  NS_ASSERT (weight > 0);
+  NS_ASSERT_MSG (Find (lma) < 0, "LMA " << lma << " already in the pool");
+
+  Lma entry;
+
+  entry.address = lma;
+  entry.weight = weight;
+  entry.load = 0;
+  m_lmas.push_back (entry);
+
+  BuildRing ();
+}
+
+void Pmipv6LmaPool::RemoveLma (Ipv6Address lma)
+{
+  NS_LOG_FUNCTION (this << lma);
+
+  int32_t index = Find (lma);
+
+  if (index < 0)
+    {
+      return;
+    }
+
+  //the mobile nodes of the LMA get a new one at their next registration
+  for (Assignments::iterator it = m_assignments.begin (); it != m_assignments.end (); )
+    {
+      if (it->second == (uint32_t)index)
+        {
+          m_assignments.erase (it++);
+        }
+      else
+        {
+          if (it->second > (uint32_t)index)
+            {
+              it->second--;
+            }
+          it++;
+        }
+    }
+
+  m_lmas.erase (m_lmas.begin () + index);
+
+  BuildRing ();
+}
+
+uint32_t Pmipv6LmaPool::GetNLmas () const
+{
+  return m_lmas.size ();
+}
+
+Ipv6Address Pmipv6LmaPool::GetLma (uint32_t i) const
+{
+  NS_ASSERT (i < m_lmas.size ());
+
+  return m_lmas[i].address;
+}
+
+int32_t Pmipv6LmaPool::Find (Ipv6Address lma) const
+{
+  for (uint32_t i = 0; i < m_lmas.size (); i++)
+    {
+      if (m_lmas[i].address == lma)
+        {
+          return i;
+        }
+    }
+
+  return -1;
+}
+
+void Pmipv6LmaPool::BuildRing ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  m_ring.clear ();
+
+  for (uint32_t i = 0; i < m_lmas.size (); i++)
+    {
+      for (uint32_t j = 0; j < m_lmas[i].weight * m_virtualNodes; j++)
+        {
+          Point point;
+
+          point.hash = HashPoint (m_lmas[i].address, j);
+          point.lma = i;
+          m_ring.push_back (point);
+        }
+    }
+
+  std::sort (m_ring.begin (), m_ring.end ());
+}
+
+uint32_t Pmipv6LmaPool::SelectByHash (Identifier mnId) const
+{
+  Point key;
+
+  key.hash = Mix (mnId.GetHash ());
+  key.lma = 0;
+
+  //first point clockwise from the identifier
+  std::vector<Point>::const_iterator it = std::lower_bound (m_ring.begin (), m_ring.end (), key);
+
+  if (it == m_ring.end ())
+    {
+      it = m_ring.begin ();
+    }
+
+  return it->lma;
+}
+
+int32_t Pmipv6LmaPool::SelectLeastLoaded (int32_t exclude) const
+{
+  int32_t best = -1;
+
+  for (uint32_t i = 0; i < m_lmas.size (); i++)
+    {
+      if ((int32_t)i == exclude)
+        {
+          continue;
+        }
+
+      //load / weight < best load / best weight
+      if (best < 0 || (uint64_t)m_lmas[i].load * m_lmas[best].weight < (uint64_t)m_lmas[best].load * m_lmas[i].weight)
+        {
+          best = i;
+        }
+    }
+
+  return best;
+}
+
+Ipv6Address Pmipv6LmaPool::Select (Identifier mnId)
+{
+  NS_LOG_FUNCTION (this << mnId);
+
+  Assignments::iterator it = m_assignments.find (mnId);
+
+  if (it != m_assignments.end ())
+    {
+      return m_lmas[it->second].address;
+    }
+
+  if (m_lmas.empty ())
+    {
+      return Ipv6Address::GetAny ();
+    }
+
+  uint32_t index = (m_selection == CONSISTENT_HASH) ? SelectByHash (mnId) : SelectLeastLoaded (-1);
+
+  m_assignments[mnId] = index;
+  m_lmas[index].load++;
+
+  NS_LOG_LOGIC (mnId << " given to LMA " << m_lmas[index].address);
+
+  return m_lmas[index].address;
+}
+
+Ipv6Address Pmipv6LmaPool::Lookup (Identifier mnId) const
+{
+  Assignments::const_iterator it = m_assignments.find (mnId);
+
+  if (it == m_assignments.end ())
+    {
+      return Ipv6Address::GetAny ();
+    }
+
+  return m_lmas[it->second].address;
+}
+
+void Pmipv6LmaPool::Assign (Identifier mnId, Ipv6Address lma)
+{
+  NS_LOG_FUNCTION (this << mnId << lma);
+
+  int32_t index = Find (lma);
+
+  if (index < 0)
+    {
+      NS_LOG_LOGIC ("LMA " << lma << " not in the pool");
+      return;
+    }
+
+  Release (mnId);
+
+  m_assignments[mnId] = index;
+  m_lmas[index].load++;
+}
+
+void Pmipv6LmaPool::Release (Identifier mnId)
+{
+  NS_LOG_FUNCTION (this << mnId);
+
+  Assignments::iterator it = m_assignments.find (mnId);
+
+  if (it == m_assignments.end ())
+    {
+      return;
+    }
+
+  NS_ASSERT (m_lmas[it->second].load > 0);
+  m_lmas[it->second].load--;
+  m_assignments.erase (it);
+}
+
+uint32_t Pmipv6LmaPool::GetLoad (Ipv6Address lma) const
+{
+  int32_t index = Find (lma);
+
+  return index < 0 ? 0 : m_lmas[index].load;
+}
+
+Ipv6Address Pmipv6LmaPool::SelectPeer (Ipv6Address lma) const
+{
+  NS_LOG_FUNCTION (this << lma);
+
+  int32_t self = Find (lma);
+  int32_t peer = SelectLeastLoaded (self);
+
+  if (self < 0 || peer < 0)
+    {
+      return Ipv6Address::GetAny ();
+    }
+
+  //only to a LMA with room to spare
+  if ((uint64_t)m_lmas[peer].load * m_lmas[self].weight >= (uint64_t)m_lmas[self].load * m_lmas[peer].weight)
+    {
+      return Ipv6Address::GetAny ();
+    }
+
+  return m_lmas[peer].address;
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PMIPV6_LMA_POOL_H
+#define PMIPV6_LMA_POOL_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "ns3/object.h"
+#include "ns3/ipv6-address.h"
+#include "ns3/sgi-hashmap.h"
+#include "ns3/identifier.h"
+
+namespace ns3
+{
+
+/**
+ * \class Pmipv6LmaPool
+ * \brief The LMAs of a PMIPv6 domain, and the LMA of each mobile node.
+ *
+ * Set on the profile (Pmipv6Profile::SetLmaPool), the pool gives the
+ * LMA of the mobile nodes whose profile has no LMA address. A mobile
+ * node keeps the LMA it was given until its binding goes away, so that
+ * all the MAGs it visits register it with the same LMA.
+ *
+ * New mobile nodes are given an LMA either by consistent hashing of
+ * their identifier, each LMA owning a number of points of a hash ring
+ * in proportion to its weight, so that adding or removing an LMA only
+ * moves the mobile nodes of its share of the ring; or by load, the LMA
+ * with the fewest mobile nodes for its weight.
+ *
+ * The pool is also where an overloaded LMA looks for a peer to
+ * redirect the new registrations to (RFC 6463).
+ */
+class Pmipv6LmaPool : public Object
+{
+public:
+  static TypeId GetTypeId ();
+
+  enum Selection_e
+  {
+    CONSISTENT_HASH,
+    LEAST_LOADED
+  };
+
+  Pmipv6LmaPool ();
+  virtual ~Pmipv6LmaPool ();
+
+  void SetSelection (enum Selection_e selection);
+  enum Selection_e GetSelection () const;
+
+  /**
+   * \brief Points of each LMA of unit weight on the hash ring (64 by default).
+   */
+  void SetVirtualNodes (uint32_t virtualNodes);
+
+  /**
+   * \param lma the LMA address
+   * \param weight the relative capacity of the LMA
+   */
+  void AddLma (Ipv6Address lma, uint32_t weight = 1);
+  void RemoveLma (Ipv6Address lma);
+
+  uint32_t GetNLmas () const;
+  Ipv6Address GetLma (uint32_t i) const;
+
+  /**
+   * \return the LMA of the mobile node, assigned now if it has none
+   */
+  Ipv6Address Select (Identifier mnId);
+
+  /**
+   * \return the LMA of the mobile node, any if it has none
+   */
+  Ipv6Address Lookup (Identifier mnId) const;
+
+  /**
+   * \brief Move a mobile node to an LMA, after a redirection.
+   */
+  void Assign (Identifier mnId, Ipv6Address lma);
+
+  /**
+   * \brief Forget the LMA of a mobile node whose binding went away.
+   */
+  void Release (Identifier mnId);
+
+  /**
+   * \return the number of mobile nodes given to the LMA
+   */
+  uint32_t GetLoad (Ipv6Address lma) const;
+
+  /**
+   * \brief Get the peer a LMA redirects a new registration to.
+   * \param lma the redirecting LMA
+   * \return the least loaded other LMA, if less loaded than lma, any otherwise
+   */
+  Ipv6Address SelectPeer (Ipv6Address lma) const;
+
+protected:
+  virtual void DoDispose ();
+
+private:
+  struct Lma
+  {
+    Ipv6Address address;
+    uint32_t weight;
+    uint32_t load;
+  };
+
+  struct Point
+  {
+    uint32_t hash;
+    uint32_t lma;
+
+    bool operator < (const Point &other) const
+    {
+      return hash < other.hash;
+    }
+  };
+
+  typedef sgi::hash_map<Identifier, uint32_t, IdentifierHash> Assignments;
+
+  int32_t Find (Ipv6Address lma) const;
+  uint32_t SelectByHash (Identifier mnId) const;
+  int32_t SelectLeastLoaded (int32_t exclude) const;
+  void BuildRing ();
+
+  enum Selection_e m_selection;
+  uint32_t m_virtualNodes;
+
+  std::vector<Lma> m_lmas;
+  std::vector<Point> m_ring;
+  Assignments m_assignments;
+};
+
+} /* namespace ns3 */
+
+#endif /* PMIPV6_LMA_POOL_H */
@@ -24,6 +24,7 @@
  
 #include <stdio.h>
 #include <sstream>
+#include <algorithm>
 
 #include "ns3/log.h"
 #include "ns3/assert.h"
@@ -44,6 +45,7 @@
 #include "ns3/ipv6-static-routing.h"
 
 #include "ns3/ipv6-static-source-routing-helper.h"
+#include "ns3/pmipv6-prefix-routing-helper.h"
 
 #include "ipv6-static-source-routing.h"
 #include "ipv6-mobility-header.h"
@@ -51,9 +53,11 @@
 #include "ipv6-mobility-demux.h"
 #include "ipv6-mobility-option-header.h"
 #include "ipv6-mobility-option.h"
+#include "ipv6-mobility-message-template.h"
 #include "ipv6-mobility-l4-protocol.h"
 #include "ipv6-tunnel-l4-protocol.h"
 #include "pmipv6-profile.h"
+#include "pmipv6-lma-pool.h"
 #include "pmipv6-prefix-pool.h"
 
 #include "pmipv6-lma.h"
@@ -67,30 +71,190 @@ namespace ns3
 
 NS_OBJECT_ENSURE_REGISTERED (Pmipv6Lma);
 
+TypeId Pmipv6Lma::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Pmipv6Lma")
+    .SetParent<Pmipv6Agent> ()
+    .AddConstructor<Pmipv6Lma> ()
+    .AddTraceSource ("RxPbu",
+                     "A PBU was received.",
+                     MakeTraceSourceAccessor (&Pmipv6Lma::m_rxPbuTrace))
+    .AddTraceSource ("TxPba",
+                     "A PBA was sent in reply to a PBU.",
+                     MakeTraceSourceAccessor (&Pmipv6Lma::m_txPbaTrace))
+    .AddTraceSource ("TunnelUp",
+                     "The tunnel and routes of a MN were set up or moved to its new MAG.",
+                     MakeTraceSourceAccessor (&Pmipv6Lma::m_tunnelUpTrace))
+    ;
+  return tid;
+}
+
 Pmipv6Lma::Pmipv6Lma ()
  : m_bCache (0),
-   m_prefixPool (0)
+   m_lastGroupId (0),
+   m_localizedRouting (false),
+   m_lriSequence (0),
+   m_redirectThreshold (0),
+   m_nRedirected (0)
 {
 }
 
 Pmipv6Lma::~Pmipv6Lma ()
 {
   m_bCache = 0;
-  m_prefixPool = 0;
+  m_prefixPools.clear ();
+  m_localizedPairs.clear ();
+  m_localizedIndex.clear ();
 }
 
 Ptr<Pmipv6PrefixPool> Pmipv6Lma::GetPrefixPool () const
 {
   NS_LOG_FUNCTION_NOARGS ();
   
-  return m_prefixPool;
+  if (m_prefixPools.empty ())
+    {
+      return 0;
+    }
+  
+  return m_prefixPools.front ();
 }
 
 void Pmipv6Lma::SetPrefixPool (Ptr<Pmipv6PrefixPool> pool)
 {
   NS_LOG_FUNCTION (this << pool);
   
-  m_prefixPool = pool;
+  m_prefixPools.clear ();
+  m_prefixPools.push_back (pool);
+}
+
+void Pmipv6Lma::AddPrefixPool (Ptr<Pmipv6PrefixPool> pool)
+{
+  NS_LOG_FUNCTION (this << pool);
+  
+  m_prefixPools.push_back (pool);
+}
+
+uint32_t Pmipv6Lma::GetNPrefixPools () const
+{
+  return m_prefixPools.size ();
+}
+
+Ptr<Pmipv6PrefixPool> Pmipv6Lma::GetPrefixPool (uint32_t i) const
+{
+  NS_ASSERT (i < m_prefixPools.size ());
+  
+  return m_prefixPools[i];
+}
+
+Ipv6Address Pmipv6Lma::AssignPrefix ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  for (std::vector<Ptr<Pmipv6PrefixPool> >::iterator i = m_prefixPools.begin (); i != m_prefixPools.end (); i++)
+    {
+      Ipv6Address prefix = (*i)->Assign ();
+      
+      if (!prefix.IsAny ())
+        {
+          return prefix;
+        }
+    }
+  
+  return Ipv6Address::GetAny ();
+}
+
+Ptr<Pmipv6PrefixPool> Pmipv6Lma::FindPrefixPool (Ipv6Address prefix) const
+{
+  for (std::vector<Ptr<Pmipv6PrefixPool> >::const_iterator i = m_prefixPools.begin (); i != m_prefixPools.end (); i++)
+    {
+      if ((*i)->Contains (prefix))
+        {
+          return (*i);
+        }
+    }
+  
+  return 0;
+}
+
+bool Pmipv6Lma::ReservePrefixes (Identifier mnId, std::list<Ipv6Address> hnpList)
+{
+  NS_LOG_FUNCTION (this << mnId);
+  
+  std::list<Ipv6Address> reserved;
+  
+  for (std::list<Ipv6Address>::iterator i = hnpList.begin (); i != hnpList.end (); i++)
+    {
+      Ptr<Pmipv6PrefixPool> pool = FindPrefixPool (*i);
+      
+      //statically configured prefix, not managed by the pools
+      if (pool == 0)
+        {
+          continue;
+        }
+      
+      if (pool->Reserve (*i))
+        {
+          reserved.push_back (*i);
+          continue;
+        }
+      
+      //already held by another binding of the same MN
+      BindingCache::Entry *holder = m_bCache->LookupByHomeNetworkPrefix (*i);
+      
+      if (holder && holder->GetMnIdentifier () == mnId)
+        {
+          continue;
+        }
+      
+      NS_LOG_LOGIC ("Prefix " << (*i) << " was reassigned");
+      
+      for (std::list<Ipv6Address>::iterator j = reserved.begin (); j != reserved.end (); j++)
+        {
+          FindPrefixPool (*j)->Release (*j);
+        }
+      
+      return false;
+    }
+  
+  return true;
+}
+
+void Pmipv6Lma::ReleasePrefixes (BindingCache::Entry *bce)
+{
+  NS_LOG_FUNCTION (this << bce);
+  
+  std::list<Ipv6Address> hnpList = bce->GetHomeNetworkPrefixes ();
+  
+  for (std::list<Ipv6Address>::iterator i = hnpList.begin (); i != hnpList.end (); i++)
+    {
+      Ptr<Pmipv6PrefixPool> pool = FindPrefixPool (*i);
+      
+      if (pool == 0)
+        {
+          continue;
+        }
+      
+      //keep prefixes another interface of the MN still uses
+      bool shared = false;
+      
+      for (BindingCache::Entry *entry = m_bCache->Lookup (bce->GetMnIdentifier ()); entry && !shared; entry = entry->GetNext ())
+        {
+          if (entry == bce)
+            {
+              continue;
+            }
+          
+          std::list<Ipv6Address> other = entry->GetHomeNetworkPrefixes ();
+          
+          shared = (std::find (other.begin (), other.end (), *i) != other.end ());
+        }
+      
+      if (!shared)
+        {
+          NS_LOG_LOGIC ("Release Prefix " << (*i));
+          pool->Release (*i);
+        }
+    }
 }
 
 void Pmipv6Lma::NotifyNewAggregate ()
@@ -103,15 +267,83 @@ void Pmipv6Lma::NotifyNewAggregate ()
       
       SetNode (node);
       m_bCache->SetNode (node);
+      
+      SetLocalizedRouting (m_localizedRouting);
     }
     
   Pmipv6Agent::NotifyNewAggregate ();
 }
 
+void Pmipv6Lma::SetLocalizedRouting (bool enable)
+{
+  NS_LOG_FUNCTION (this << enable);
+  
+  m_localizedRouting = enable;
+  
+  if (GetNode () == 0)
+    {
+      return;
+    }
+  
+  Ptr<Ipv6TunnelL4Protocol> th = GetNode ()->GetObject<Ipv6TunnelL4Protocol> ();
+  
+  if (th)
+    {
+      //only watch the decapsulated packets when asked to
+      th->SetDecapCallback (enable ? MakeCallback (&Pmipv6Lma::HandleDecapsulated, this) :
+                            MakeNullCallback<void, const Ipv6Address &, const Ipv6Header &> ());
+    }
+}
+
+bool Pmipv6Lma::IsLocalizedRouting () const
+{
+  return m_localizedRouting;
+}
+
+uint32_t Pmipv6Lma::GetNLocalizedPairs () const
+{
+  return m_localizedPairs.size ();
+}
+
+void Pmipv6Lma::SetRedirectThreshold (uint32_t maxBindings)
+{
+  NS_LOG_FUNCTION (this << maxBindings);
+  
+  m_redirectThreshold = maxBindings;
+}
+
+uint32_t Pmipv6Lma::GetRedirectThreshold () const
+{
+  return m_redirectThreshold;
+}
+
+uint32_t Pmipv6Lma::GetNBindings () const
+{
+  return m_bCache->GetNEntries ();
+}
+
+uint32_t Pmipv6Lma::GetNRedirected () const
+{
+  return m_nRedirected;
+}
+
 Ptr<Packet> Pmipv6Lma::BuildPba (BindingCache::Entry *bce, uint8_t status)
 {
   NS_LOG_FUNCTION (this << bce << status);
   
+  Ipv6MobilityMessageTemplate &pbaTemplate = bce->GetPbaTemplate ();
+  
+  //Reply for the same binding: only patch the changing fields
+  if (!pbaTemplate.IsEmpty ())
+    {
+      pbaTemplate.SetStatus (status);
+      pbaTemplate.SetSequence (bce->GetLastBindingUpdateSequence ());
+      pbaTemplate.SetLifetime ((uint16_t)bce->GetReachableTime ().GetSeconds ());
+      pbaTemplate.SetTimestamp (bce->GetLastBindingUpdateTime ());
+      
+      return pbaTemplate.CreatePacket ();
+    }
+  
    Ptr<Packet> p = Create<Packet> ();
   
   Ipv6MobilityBindingAckHeader pba;
@@ -157,15 +389,26 @@ Ptr<Packet> Pmipv6Lma::BuildPba (BindingCache::Entry *bce, uint8_t status)
       pba.AddOption (llah);
     }
   
+  if (bce->GetGroupIdentifier () != 0)
+    {
+      Ipv6MobilityOptionMobileNodeGroupIdentifierHeader groupidh;
+      
+      pba.SetFlagB (true);
+      groupidh.SetGroupIdentifier (bce->GetGroupIdentifier ());
+      pba.AddOption (groupidh);
+    }
+  
   timestamph.SetTimestamp (bce->GetLastBindingUpdateTime ());
   pba.AddOption (timestamph);
   
   p->AddHeader (pba);
   
+  pbaTemplate.Set (p);
+  
   return p;
 }
 
-Ptr<Packet> Pmipv6Lma::BuildPba(Ipv6MobilityBindingUpdateHeader pbu, Ipv6MobilityOptionBundle bundle, uint8_t status)
+Ptr<Packet> Pmipv6Lma::BuildPba(Ipv6MobilityBindingUpdateHeader pbu, Ipv6MobilityOptionBundle bundle, uint8_t status, Ipv6Address redirect)
 {
   NS_LOG_FUNCTION (this << status);
   
@@ -213,6 +456,41 @@ Ptr<Packet> Pmipv6Lma::BuildPba(Ipv6MobilityBindingUpdateHeader pbu, Ipv6Mobilit
       pba.AddOption (llah);
     }
   
+  if (!redirect.IsAny ())
+    {
+      Ipv6MobilityOptionRedirectHeader redirecth (redirect);
+      
+      pba.AddOption (redirecth);
+    }
+  
+  timestamph.SetTimestamp (bundle.GetTimestamp ());
+  pba.AddOption (timestamph);
+  
+  p->AddHeader (pba);
+  
+  return p;
+}
+
+Ptr<Packet> Pmipv6Lma::BuildBulkPba (Ipv6MobilityBindingUpdateHeader pbu, Ipv6MobilityOptionBundle bundle, uint8_t status)
+{
+  NS_LOG_FUNCTION (this << status);
+  
+  Ptr<Packet> p = Create<Packet> ();
+  
+  Ipv6MobilityBindingAckHeader pba;
+  
+  Ipv6MobilityOptionMobileNodeGroupIdentifierHeader groupidh;
+  Ipv6MobilityOptionTimestampHeader timestamph;
+  
+  pba.SetSequence (pbu.GetSequence ());
+  pba.SetFlagP (true);
+  pba.SetFlagB (true);
+  pba.SetStatus (status);
+  pba.SetLifetime (status == Ipv6MobilityHeader::BA_STATUS_BINDING_UPDATE_ACCEPTED ? pbu.GetLifetime () : 0);
+  
+  groupidh.SetGroupIdentifier (bundle.GetMnGroupIdentifier ());
+  pba.AddOption (groupidh);
+  
   timestamph.SetTimestamp (bundle.GetTimestamp ());
   pba.AddOption (timestamph);
   
@@ -221,6 +499,85 @@ Ptr<Packet> Pmipv6Lma::BuildPba(Ipv6MobilityBindingUpdateHeader pbu, Ipv6Mobilit
   return p;
 }
 
+uint32_t Pmipv6Lma::GetBulkGroup (Ipv6Address mag)
+{
+  NS_LOG_FUNCTION (this << mag);
+  
+  BulkGroups::iterator it = m_bulkGroups.find (mag);
+  
+  if (it != m_bulkGroups.end ())
+    {
+      return it->second;
+    }
+  
+  m_bulkGroups[mag] = ++m_lastGroupId;
+  
+  return m_lastGroupId;
+}
+
+uint8_t Pmipv6Lma::HandleBulkPbu (Ipv6MobilityBindingUpdateHeader pbu, Ipv6MobilityOptionBundle bundle, const Ipv6Address &src)
+{
+  NS_LOG_FUNCTION (this << src);
+  
+  uint8_t status = Ipv6MobilityHeader::BA_STATUS_BINDING_UPDATE_ACCEPTED;
+  uint32_t groupId = bundle.GetMnGroupIdentifier ();
+  BulkGroups::iterator it = m_bulkGroups.find (src);
+  
+  if (groupId == 0 || it == m_bulkGroups.end () || it->second != groupId)
+    {
+      NS_LOG_LOGIC ("Unknown group " << groupId << " for MAG " << src);
+      status = Ipv6MobilityHeader::BA_STATUS_REASON_UNSPECIFIED;
+    }
+  else if (bundle.GetTimestamp ().GetMicroSeconds ()!=0 && bundle.GetTimestamp ()>Simulator::Now ())
+    {
+      status = Ipv6MobilityHeader::BA_STATUS_TIMESTAMP_MISMATCH;
+    }
+  else
+    {
+      uint32_t n = 0;
+      
+      //the group is a subset of the bindings through the MAG
+      for (BindingCache::Entry *bce = m_bCache->LookupByProxyCoa (src); bce; bce = bce->GetNextByProxyCoa ())
+        {
+          if (bce->GetGroupIdentifier () != groupId || bce->IsDeregistering ())
+            {
+              continue;
+            }
+          
+          bce->SetLastBindingUpdateTime (bundle.GetTimestamp ());
+          
+          if (pbu.GetLifetime () > 0)
+            {
+              bce->SetReachableTime (Seconds (pbu.GetLifetime ()));
+              
+              bce->StopReachableTimer ();
+              bce->StartReachableTimer ();
+            }
+          else
+            {
+              bce->SetReachableTime (Seconds (0));
+              
+              //Deregistering
+              bce->StopReachableTimer ();
+              bce->MarkDeregistering ();
+              TerminateLocalizedRouting (bce);
+              
+              bce->StopDeregisterTimer ();
+              bce->StartDeregisterTimer ();
+            }
+          
+          n++;
+        }
+      
+      NS_LOG_LOGIC ((pbu.GetLifetime () > 0 ? "Refreshed " : "Revoked ") << n << " bindings of group " << groupId);
+    }
+  
+  SendMessage (BuildBulkPba (pbu, bundle, status), src, 64);
+  m_txPbaTrace (Identifier (), status);
+  
+  return 0;
+}
+
 uint8_t Pmipv6Lma::HandlePbu(Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface)
 {
   NS_LOG_FUNCTION (this << packet << src << dst << interface);
@@ -242,9 +599,18 @@ uint8_t Pmipv6Lma::HandlePbu(Ptr<Packet> packet, const Ipv6Address &src, const I
   
   ipv6Mobility->ProcessOptions (packet, pbu.GetOptionsOffset (), length, bundle);
   
+  m_rxPbuTrace (bundle.GetMnIdentifier (), pbu.GetSequence ());
+  
+  //bulk refresh or revocation, for a group instead of a MN
+  if (pbu.GetFlagB () && bundle.GetMnIdentifier ().IsEmpty ())
+    {
+      return HandleBulkPbu (pbu, bundle, src);
+    }
+  
   uint8_t errStatus = 0;
   BindingCache::Entry *bce = 0;
   Pmipv6Profile::Entry *pf = 0;
+  Ipv6Address redirect;
   
   bool delayedRegister = false;
   
@@ -285,6 +651,9 @@ uint8_t Pmipv6Lma::HandlePbu(Ptr<Packet> packet, const Ipv6Address &src, const I
       Identifier mnLinkId = bundle.GetMnLinkIdentifier ();
       std::list<Ipv6Address> hnpList;
       
+      //RFC 6602: put the binding in the bulk binding group of the MAG
+      uint32_t groupId = (pbu.GetFlagB () && pbu.GetLifetime () > 0) ? GetBulkGroup (src) : 0;
+      
       //copy home network prefixes which has NON_ZERO prefix
       if(bundle.GetHomeNetworkPrefixes ().size () > 0)
         {
@@ -359,6 +728,9 @@ uint8_t Pmipv6Lma::HandlePbu(Ptr<Packet> packet, const Ipv6Address &src, const I
             {
               if ((bce->GetProxyCoa () == src) || bce->IsDeregistering ())
                 {
+                  //re-registered from another MAG while deregistering
+                  bool moved = (bce->GetProxyCoa () != src);
+                  
                   //update BCE
                   bce->SetProxyCoa (src);
                   
@@ -370,10 +742,17 @@ uint8_t Pmipv6Lma::HandlePbu(Ptr<Packet> packet, const Ipv6Address &src, const I
                   bce->SetLastBindingUpdateTime (bundle.GetTimestamp ());
                   bce->SetReachableTime (Seconds (pbu.GetLifetime ()));
                   bce->SetLastBindingUpdateSequence (pbu.GetSequence ());
+                  bce->SetGroupIdentifier (groupId);
+                  
+                  if (moved)
+                    {
+                      ModifyTunnelAndRouting (bce);
+                    }
                   
                   bce->MarkReachable ();
                   
                   //start lifetime timer
+                  bce->StopDeregisterTimer ();
                   bce->StopReachableTimer ();
                   bce->StartReachableTimer ();
                 }
@@ -398,6 +777,7 @@ uint8_t Pmipv6Lma::HandlePbu(Ptr<Packet> packet, const Ipv6Address &src, const I
                           bce_temp->SetLastBindingUpdateTime (bundle.GetTimestamp ());
                           bce_temp->SetReachableTime (Seconds (pbu.GetLifetime ()));
                           bce_temp->SetLastBindingUpdateSequence (pbu.GetSequence ());
+                          bce_temp->SetGroupIdentifier (groupId);
                           
                           bce_temp->SetHomeNetworkPrefixes (bundle.GetHomeNetworkPrefixes ());
                           
@@ -430,6 +810,7 @@ uint8_t Pmipv6Lma::HandlePbu(Ptr<Packet> packet, const Ipv6Address &src, const I
                       bce->SetLastBindingUpdateTime (bundle.GetTimestamp ());
                       bce->SetReachableTime (Seconds (pbu.GetLifetime ()));
                       bce->SetLastBindingUpdateSequence (pbu.GetSequence ());
+                      bce->SetGroupIdentifier (groupId);
                       
                         ModifyTunnelAndRouting (bce);
 
@@ -446,69 +827,110 @@ uint8_t Pmipv6Lma::HandlePbu(Ptr<Packet> packet, const Ipv6Address &src, const I
               NS_LOG_LOGIC ("Lifetime is zero.. Deregistering..");
               if (bce->GetProxyCoa () == src)
                 {
+                  //acknowledge with the sequence, timestamp and lifetime of the PBU
+                  bce->SetLastBindingUpdateTime (bundle.GetTimestamp ());
+                  bce->SetReachableTime (Seconds (0));
+                  bce->SetLastBindingUpdateSequence (pbu.GetSequence ());
+                  
                   //Deregistering
+                  bce->StopReachableTimer ();
                   bce->MarkDeregistering ();
+                  TerminateLocalizedRouting (bce);
                   
+                  bce->StopDeregisterTimer ();
                   bce->StartDeregisterTimer ();
                 }
+              else
+                {
+                  //the MN already moved, only acknowledge the PBU
+                  bce = 0;
+                }
             }
         }
       else
         {
-          if (pbu.GetLifetime () > 0)
+          //RFC 6463: overloaded, send the new MN to a peer if the MAG can follow
+          if (pbu.GetLifetime () > 0 && m_redirectThreshold > 0 && bundle.HasRedirectCapability () &&
+              m_bCache->GetNEntries () >= m_redirectThreshold && GetProfile ()->GetLmaPool ())
             {
-              //No Binding Cache Exists
-              NS_LOG_LOGIC ("Createing new Binding Cache Entry");
-              
-              bce = m_bCache->Add (mnId);
-
-              bce->SetProxyCoa (src);
-              
-              bce->SetMnLinkIdentifier (mnLinkId);
-              bce->SetAccessTechnologyType (bundle.GetAccessTechnologyType ());
-              bce->SetHandoffIndicator (bundle.GetHandoffIndicator ());
-              bce->SetMagLinkAddress (bundle.GetMagLinkAddress ());
-              
-              bce->SetLastBindingUpdateTime (bundle.GetTimestamp ());
-              bce->SetReachableTime (Seconds (pbu.GetLifetime ()));
-              bce->SetLastBindingUpdateSequence (pbu.GetSequence ());
+              redirect = GetProfile ()->GetLmaPool ()->SelectPeer (dst);
+            }
+          
+          if (!redirect.IsAny ())
+            {
+              NS_LOG_LOGIC ("Redirect the registration of " << mnId << " to " << redirect);
               
-              //allocate new prefix
+              m_nRedirected++;
+            }
+          else if (pbu.GetLifetime () > 0)
+            {
+              //allocate home network prefixes, the former ones if still free
               std::list<Ipv6Address> hnpList;
               
-              if (pf && pf->GetHomeNetworkPrefixes ().size () > 0)
+              if (pf && pf->GetHomeNetworkPrefixes ().size () > 0 && ReservePrefixes (mnId, pf->GetHomeNetworkPrefixes ()))
                 {
-                  bce->SetHomeNetworkPrefixes (pf->GetHomeNetworkPrefixes ());
+                  hnpList = pf->GetHomeNetworkPrefixes ();
                 }
               else
                 {
-                  Ipv6Address prefix = m_prefixPool->Assign ();
+                  Ipv6Address prefix = AssignPrefix ();
                   
-                  NS_LOG_LOGIC ("Assign new Prefix from Pool: " << prefix);
+                  if (!prefix.IsAny ())
+                    {
+                      NS_LOG_LOGIC ("Assign new Prefix from Pool: " << prefix);
+                      
+                      hnpList.push_back (prefix);
+                      
+                      if (pf)
+                        {
+                          pf->SetHomeNetworkPrefixes (hnpList);
+                        }
+                    }
+                }
+              
+              if (hnpList.empty ())
+                {
+                  NS_LOG_LOGIC ("No home network prefix left in the pools");
+                  errStatus = Ipv6MobilityHeader::BA_STATUS_INSUFFICIENT_RESOURCES;
+                }
+              else
+                {
+                  //No Binding Cache Exists
+                  NS_LOG_LOGIC ("Createing new Binding Cache Entry");
                   
-                  hnpList.push_back (prefix);
+                  bce = m_bCache->Add (mnId);
+                  
+                  bce->SetProxyCoa (src);
+                  
+                  bce->SetMnLinkIdentifier (mnLinkId);
+                  bce->SetAccessTechnologyType (bundle.GetAccessTechnologyType ());
+                  bce->SetHandoffIndicator (bundle.GetHandoffIndicator ());
+                  bce->SetMagLinkAddress (bundle.GetMagLinkAddress ());
+                  
+                  bce->SetLastBindingUpdateTime (bundle.GetTimestamp ());
+                  bce->SetReachableTime (Seconds (pbu.GetLifetime ()));
+                  bce->SetLastBindingUpdateSequence (pbu.GetSequence ());
+                  bce->SetGroupIdentifier (groupId);
                   
                   bce->SetHomeNetworkPrefixes (hnpList);
                   
-                  if (pf)
-                    {
-                      pf->SetHomeNetworkPrefixes (hnpList);
-                    }
+                  //create tunnel
+                  SetupTunnelAndRouting (bce);
+                  
+                  bce->MarkReachable ();
+                  
+                  //start lifetime timer
+                  bce->StartReachableTimer ();
                 }
-                
-              //create tunnel
-              SetupTunnelAndRouting (bce);
-              
-              bce->MarkReachable ();
-              
-              //start lifetime timer
-              bce->StartReachableTimer ();
             }
         }
     
       //routing setup && tunneling
     
-      errStatus = Ipv6MobilityHeader::BA_STATUS_BINDING_UPDATE_ACCEPTED;
+      if (errStatus != Ipv6MobilityHeader::BA_STATUS_INSUFFICIENT_RESOURCES)
+        {
+          errStatus = Ipv6MobilityHeader::BA_STATUS_BINDING_UPDATE_ACCEPTED;
+        }
       
     }
     
@@ -520,11 +942,206 @@ uint8_t Pmipv6Lma::HandlePbu(Ptr<Packet> packet, const Ipv6Address &src, const I
       }
     else
       {
-        pktPba = BuildPba (pbu, bundle, errStatus);
+        pktPba = BuildPba (pbu, bundle, errStatus, redirect);
       }
       
     SendMessage (pktPba, src, 64);
+    m_txPbaTrace (bundle.GetMnIdentifier (), errStatus);
+
+  return 0;
+}
+
+void Pmipv6Lma::HandleDecapsulated (const Ipv6Address &mag, const Ipv6Header &header)
+{
+  Ipv6Address src = header.GetSourceAddress ();
+  Ipv6Address dst = header.GetDestinationAddress ();
+  
+  BindingCache::Entry *dstBce = m_bCache->LookupByHomeNetworkPrefix (dst.CombinePrefix (Ipv6Prefix (64)));
+  
+  if (dstBce == 0 || !dstBce->IsReachable () || dstBce->GetTunnelIfIndex () < 0)
+    {
+      return;
+    }
+  
+  BindingCache::Entry *srcBce = m_bCache->LookupByHomeNetworkPrefix (src.CombinePrefix (Ipv6Prefix (64)));
+  
+  if (srcBce == 0 || srcBce == dstBce || !srcBce->IsReachable () || srcBce->GetProxyCoa () != mag)
+    {
+      return;
+    }
+  
+  InitiateLocalizedRouting (srcBce, dstBce);
+}
+
+void Pmipv6Lma::InitiateLocalizedRouting (BindingCache::Entry *bce1, BindingCache::Entry *bce2)
+{
+  std::list<Ipv6Address> hnps1 = bce1->GetHomeNetworkPrefixes ();
+  std::list<Ipv6Address> hnps2 = bce2->GetHomeNetworkPrefixes ();
+  
+  NS_ASSERT (!hnps1.empty () && !hnps2.empty ());
+  
+  //both directions share the pair
+  if (hnps2.front () < hnps1.front ())
+    {
+      std::swap (bce1, bce2);
+      std::swap (hnps1, hnps2);
+    }
+  
+  PairKey key (hnps1.front (), hnps2.front ());
+  
+  if (m_localizedPairs.find (key) != m_localizedPairs.end ())
+    {
+      return;
+    }
+  
+  NS_LOG_FUNCTION (this << bce1 << bce2);
+  
+  LocalizedPair &pair = m_localizedPairs[key];
+  
+  pair.mnIds[0] = bce1->GetMnIdentifier ();
+  pair.mnIds[1] = bce2->GetMnIdentifier ();
+  pair.mags[0] = bce1->GetProxyCoa ();
+  pair.mags[1] = bce2->GetProxyCoa ();
+  pair.hnps = hnps1;
+  pair.hnps.insert (pair.hnps.end (), hnps2.begin (), hnps2.end ());
+  pair.sequence = ++m_lriSequence;
+  
+  m_localizedIndex[pair.mnIds[0]].push_back (key);
+  m_localizedIndex[pair.mnIds[1]].push_back (key);
+  
+  //the localized routing lasts as long as the shorter binding
+  uint16_t lifetime = (uint16_t)std::min (bce1->GetReachableTime ().GetSeconds (), bce2->GetReachableTime ().GetSeconds ());
+  
+  NS_LOG_LOGIC ("Localized routing " << key.first << " <-> " << key.second << " via " << pair.mags[0] << ", " << pair.mags[1]);
+  
+  if (pair.mags[0] == pair.mags[1])
+    {
+      SendLri (pair.mags[0], pair.sequence, lifetime, pair.hnps, Ipv6Address::GetAny ());
+    }
+  else
+    {
+      SendLri (pair.mags[0], pair.sequence, lifetime, pair.hnps, pair.mags[1]);
+      SendLri (pair.mags[1], pair.sequence, lifetime, pair.hnps, pair.mags[0]);
+    }
+}
+
+void Pmipv6Lma::TerminateLocalizedRouting (BindingCache::Entry *bce)
+{
+  LocalizedIndex::iterator it = m_localizedIndex.find (bce->GetMnIdentifier ());
+  
+  if (it == m_localizedIndex.end ())
+    {
+      return;
+    }
+  
+  NS_LOG_FUNCTION (this << bce);
+  
+  std::list<PairKey> keys;
+  keys.swap (it->second);
+  m_localizedIndex.erase (it);
+  
+  for (std::list<PairKey>::iterator i = keys.begin (); i != keys.end (); i++)
+    {
+      LocalizedPairs::iterator pi = m_localizedPairs.find (*i);
+      
+      if (pi == m_localizedPairs.end ())
+        {
+          continue;
+        }
+      
+      LocalizedPair &pair = pi->second;
+      
+      NS_LOG_LOGIC ("Terminate localized routing " << i->first << " <-> " << i->second);
+      
+      //lifetime zero, to the MAGs which set the routes up
+      SendLri (pair.mags[0], ++m_lriSequence, 0, pair.hnps, Ipv6Address::GetAny ());
+      
+      if (pair.mags[1] != pair.mags[0])
+        {
+          SendLri (pair.mags[1], m_lriSequence, 0, pair.hnps, Ipv6Address::GetAny ());
+        }
+      
+      //the other mobile node of the pair
+      Identifier peer = (pair.mnIds[0] == bce->GetMnIdentifier ()) ? pair.mnIds[1] : pair.mnIds[0];
+      LocalizedIndex::iterator pit = m_localizedIndex.find (peer);
+      
+      if (pit != m_localizedIndex.end ())
+        {
+          pit->second.remove (*i);
+          
+          if (pit->second.empty ())
+            {
+              m_localizedIndex.erase (pit);
+            }
+        }
+      
+      m_localizedPairs.erase (pi);
+    }
+}
 
+void Pmipv6Lma::SendLri (Ipv6Address mag, uint16_t sequence, uint16_t lifetime, const std::list<Ipv6Address> &hnps, Ipv6Address peerMag)
+{
+  NS_LOG_FUNCTION (this << mag << sequence << lifetime << peerMag);
+  
+  Ptr<Packet> p = Create<Packet> ();
+  
+  Ipv6MobilityLocalizedRoutingInitiationHeader lri;
+  Ipv6MobilityOptionHomeNetworkPrefixHeader hnph;
+  
+  lri.SetSequence (sequence);
+  lri.SetLifetime (lifetime);
+  
+  for (std::list<Ipv6Address>::const_iterator i = hnps.begin (); i != hnps.end (); i++)
+    {
+      hnph.SetPrefix ((*i));
+      hnph.SetPrefixLength (64);
+      lri.AddOption (hnph);
+    }
+  
+  if (!peerMag.IsAny ())
+    {
+      Ipv6MobilityOptionIpv6AddressHeader magh (Ipv6MobilityOptionIpv6AddressHeader::MAG_ADDRESS, peerMag);
+      
+      lri.AddOption (magh);
+    }
+  
+  p->AddHeader (lri);
+  
+  SendMessage (p, mag, 64);
+}
+
+uint8_t Pmipv6Lma::HandleLra (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface)
+{
+  NS_LOG_FUNCTION (this << packet << src << dst << interface);
+  
+  Ipv6MobilityLocalizedRoutingAckHeader lra;
+  
+  packet->PeekHeader (lra);
+  
+  if (lra.GetStatus () == Ipv6MobilityHeader::LRA_STATUS_SUCCESS)
+    {
+      return 0;
+    }
+  
+  NS_LOG_LOGIC ("Localized routing refused by " << src << " (" << (uint32_t)lra.GetStatus () << ")");
+  
+  //the traffic of the pair keeps going through the LMA
+  for (LocalizedPairs::iterator i = m_localizedPairs.begin (); i != m_localizedPairs.end (); i++)
+    {
+      if (i->second.sequence == lra.GetSequence () &&
+          (i->second.mags[0] == src || i->second.mags[1] == src))
+        {
+          BindingCache::Entry *bce = m_bCache->Lookup (i->second.mnIds[0]);
+          
+          if (bce)
+            {
+              TerminateLocalizedRouting (bce);
+            }
+          
+          break;
+        }
+    }
+  
   return 0;
 }
 
@@ -540,19 +1157,32 @@ bool Pmipv6Lma::SetupTunnelAndRouting (BindingCache::Entry *bce)
   
   bce->SetTunnelIfIndex (tunnelIf);
   
-  //routing setup by static routing protocol
+  //routing setup by prefix routing protocol, static routing if absent
   Ipv6StaticRoutingHelper staticRoutingHelper;
+  Pmipv6PrefixRoutingHelper prefixRoutingHelper;
   Ptr<Ipv6> ipv6 = GetNode ()->GetObject<Ipv6> ();
   
   std::list<Ipv6Address> hnpList = bce->GetHomeNetworkPrefixes ();
   
+  Ptr<Pmipv6PrefixRouting> prefixRouting = prefixRoutingHelper.GetPrefixRouting (ipv6);
   Ptr<Ipv6StaticRouting> staticRouting = staticRoutingHelper.GetStaticRouting (ipv6);
   
   for (std::list<Ipv6Address>::iterator i = hnpList.begin (); i != hnpList.end (); i++)
     {
       NS_LOG_LOGIC ("Add Route " << (*i) << "/64 via " << (uint32_t)bce->GetTunnelIfIndex ());
-      staticRouting->AddNetworkRouteTo ((*i), Ipv6Prefix (64), bce->GetTunnelIfIndex ());
+      if (prefixRouting)
+        {
+          prefixRouting->AddPrefixRoute ((*i), bce->GetTunnelIfIndex ());
+        }
+      else
+        {
+          staticRouting->AddNetworkRouteTo ((*i), Ipv6Prefix (64), bce->GetTunnelIfIndex ());
+        }
     }
+  
+  th->InvalidateRouteCache ();
+  
+  m_tunnelUpTrace (bce->GetMnIdentifier (), tunnelIf);
     
   return true;
 }
@@ -561,18 +1191,29 @@ void Pmipv6Lma::ClearTunnelAndRouting (BindingCache::Entry *bce)
 {
   NS_LOG_FUNCTION (this << bce);
   
-  //routing setup by static routing protocol
+  TerminateLocalizedRouting (bce);
+  
+  //routing setup by prefix routing protocol, static routing if absent
   Ipv6StaticRoutingHelper staticRoutingHelper;
+  Pmipv6PrefixRoutingHelper prefixRoutingHelper;
   Ptr<Ipv6> ipv6 = GetNode ()->GetObject<Ipv6> ();
   
   std::list<Ipv6Address> hnpList = bce->GetHomeNetworkPrefixes ();
   
+  Ptr<Pmipv6PrefixRouting> prefixRouting = prefixRoutingHelper.GetPrefixRouting (ipv6);
   Ptr<Ipv6StaticRouting> staticRouting = staticRoutingHelper.GetStaticRouting (ipv6);
   
   for (std::list<Ipv6Address>::iterator i = hnpList.begin (); i != hnpList.end (); i++)
     {
-      NS_LOG_LOGIC ("Add Route " << (*i) << "/64 via " << (uint32_t)bce->GetTunnelIfIndex ());
-      staticRouting->RemoveRoute ((*i), Ipv6Prefix (64), bce->GetTunnelIfIndex (), (*i));
+      NS_LOG_LOGIC ("Remove Route " << (*i) << "/64 via " << (uint32_t)bce->GetTunnelIfIndex ());
+      if (prefixRouting)
+        {
+          prefixRouting->RemovePrefixRoute ((*i), bce->GetTunnelIfIndex ());
+        }
+      else
+        {
+          staticRouting->RemoveRoute ((*i), Ipv6Prefix (64), bce->GetTunnelIfIndex (), (*i));
+        }
     }
     
   //create tunnel
@@ -580,6 +1221,7 @@ void Pmipv6Lma::ClearTunnelAndRouting (BindingCache::Entry *bce)
   NS_ASSERT (th);
   
   th->RemoveTunnel (bce->GetProxyCoa ());
+  th->InvalidateRouteCache ();
   
   bce->SetTunnelIfIndex (-1);
 }
@@ -587,12 +1229,17 @@ void Pmipv6Lma::ClearTunnelAndRouting (BindingCache::Entry *bce)
 bool Pmipv6Lma::ModifyTunnelAndRouting (BindingCache::Entry *bce)
 {
   NS_LOG_FUNCTION (this << bce);
+  
+  //the MAGs route the pairs of the MN to its former MAG
+  TerminateLocalizedRouting (bce);
   uint16_t oldTunnelIf = -1;
   
   Ptr<Ipv6TunnelL4Protocol> th = GetNode ()->GetObject<Ipv6TunnelL4Protocol> ();
   NS_ASSERT (th);
   Ipv6StaticRoutingHelper staticRoutingHelper;
+  Pmipv6PrefixRoutingHelper prefixRoutingHelper;
   Ptr<Ipv6> ipv6 = GetNode ()->GetObject<Ipv6> ();
+  Ptr<Pmipv6PrefixRouting> prefixRouting = prefixRoutingHelper.GetPrefixRouting (ipv6);
   Ptr<Ipv6StaticRouting> staticRouting = staticRoutingHelper.GetStaticRouting (ipv6);
   
   oldTunnelIf = bce->GetTunnelIfIndex ();
@@ -606,14 +1253,51 @@ bool Pmipv6Lma::ModifyTunnelAndRouting (BindingCache::Entry *bce)
       for (std::list<Ipv6Address>::iterator i = hnpList.begin (); i != hnpList.end (); i++)
         {
           NS_LOG_LOGIC ("Modify Route " << (*i) << "/64 via " << (uint32_t)oldTunnelIf << " to " << tunnelIf);
-          staticRouting->RemoveRoute ((*i), Ipv6Prefix (64), oldTunnelIf, (*i));
-          staticRouting->AddNetworkRouteTo ((*i), Ipv6Prefix (64), tunnelIf);
+          if (prefixRouting)
+            {
+              //re-pointed in place
+              prefixRouting->AddPrefixRoute ((*i), tunnelIf);
+            }
+          else
+            {
+              staticRouting->RemoveRoute ((*i), Ipv6Prefix (64), oldTunnelIf, (*i));
+              staticRouting->AddNetworkRouteTo ((*i), Ipv6Prefix (64), tunnelIf);
+            }
         }
+      
+      th->InvalidateRouteCache ();
+      
+      m_tunnelUpTrace (bce->GetMnIdentifier (), tunnelIf);
     }
     
   return true;
 }
 
+void Pmipv6Lma::DoBindingExpiry (BindingCache::Entry *bce)
+{
+  NS_LOG_FUNCTION (this << bce);
+  
+  NS_LOG_LOGIC ("Binding of " << bce->GetMnIdentifier () << " via " << bce->GetProxyCoa () << " expired");
+  
+  if (bce->GetTunnelIfIndex () >= 0)
+    {
+      ClearTunnelAndRouting (bce);
+    }
+  
+  ReleasePrefixes (bce);
+  
+  Identifier mnId = bce->GetMnIdentifier ();
+  
+  m_bCache->Remove (bce);
+  
+  //once its last binding is gone, the MN may be given another LMA of
+  //the pool next time
+  if (GetProfile ()->GetLmaPool () && !m_bCache->Lookup (mnId))
+    {
+      GetProfile ()->GetLmaPool ()->Release (mnId);
+    }
+}
+
 void Pmipv6Lma::DoDelayedRegistration (BindingCache::Entry *bce)
 {
   NS_LOG_FUNCTION (this << bce);
@@ -633,6 +1317,7 @@ void Pmipv6Lma::DoDelayedRegistration (BindingCache::Entry *bce)
   bce->SetLastBindingUpdateTime (bce_temp->GetLastBindingUpdateTime ());
   bce->SetReachableTime (bce_temp->GetReachableTime ());
   bce->SetLastBindingUpdateSequence (bce_temp->GetLastBindingUpdateSequence ());  
+  bce->SetGroupIdentifier (bce_temp->GetGroupIdentifier ());
 
   delete bce_temp;
   
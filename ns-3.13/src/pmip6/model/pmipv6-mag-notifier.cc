@@ -30,6 +30,8 @@
 #include "ns3/packet.h"
 #include "ns3/node.h"
 #include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/simulator.h"
 #include "ns3/ipv6-routing-protocol.h"
 #include "ns3/ipv6-route.h"
 #include "ns3/wifi-net-device.h"
@@ -76,44 +78,79 @@ TypeId Pmipv6MagNotifyHeader::GetInstanceTypeId () const
 }
 
 Pmipv6MagNotifyHeader::Pmipv6MagNotifyHeader()
- : m_nextHeader(59), /* no next header */
-   m_length(1)
+ : m_nextHeader(59) /* no next header */
 {
-  memset(m_reserved, 0, sizeof(m_reserved));
 }
 
 Pmipv6MagNotifyHeader::~Pmipv6MagNotifyHeader()
 {
 }
 
-Mac48Address Pmipv6MagNotifyHeader::GetMacAddress() const
+void Pmipv6MagNotifyHeader::AddNotification(Mac48Address macaddr, uint8_t att, bool detached)
 {
-  return m_macAddress;
+  NS_ASSERT (m_notifications.size () < MAX_NOTIFICATIONS);
+
+  Notification notification;
+
+  notification.macAddress = macaddr;
+  notification.accessTechnologyType = att;
+  notification.flags = detached ? DETACHED : 0;
+
+  m_notifications.push_back (notification);
+}
+
+uint32_t Pmipv6MagNotifyHeader::GetNNotifications() const
+{
+  return m_notifications.size ();
 }
 
-void Pmipv6MagNotifyHeader::SetMacAddress(Mac48Address macaddr)
+void Pmipv6MagNotifyHeader::Clear()
 {
-  m_macAddress = macaddr;
+  m_notifications.clear ();
 }
 
-uint8_t Pmipv6MagNotifyHeader::GetAccessTechnologyType() const
+Mac48Address Pmipv6MagNotifyHeader::GetMacAddress(uint32_t i) const
 {
-  return m_accessTechnologyType;
+  NS_ASSERT (i < m_notifications.size ());
+
+  return m_notifications[i].macAddress;
+}
+
+uint8_t Pmipv6MagNotifyHeader::GetAccessTechnologyType(uint32_t i) const
+{
+  NS_ASSERT (i < m_notifications.size ());
+
+  return m_notifications[i].accessTechnologyType;
 }
 
-void Pmipv6MagNotifyHeader::SetAccessTechnologyType(uint8_t att)
+bool Pmipv6MagNotifyHeader::IsDetached(uint32_t i) const
 {
-  m_accessTechnologyType =  att;
-} 
+  NS_ASSERT (i < m_notifications.size ());
+
+  return (m_notifications[i].flags & DETACHED) != 0;
+}
 
 void Pmipv6MagNotifyHeader::Print (std::ostream& os) const
 {
-  os << "( from: " << m_macAddress << ", ATT: " << (uint32_t)m_accessTechnologyType << ")";
+  os << "(";
+
+  for (uint32_t i = 0; i < m_notifications.size (); i++)
+    {
+      os << (i ? ", " : " ") << "from: " << m_notifications[i].macAddress
+         << " ATT: " << (uint32_t)m_notifications[i].accessTechnologyType;
+
+      if (IsDetached (i))
+        {
+          os << " detached";
+        }
+    }
+
+  os << " )";
 }
 
 uint32_t Pmipv6MagNotifyHeader::GetSerializedSize () const
 {
-  return 16;
+  return 8 * (m_notifications.size () + 1);
 }
 
 void Pmipv6MagNotifyHeader::Serialize (Buffer::Iterator start) const
@@ -122,15 +159,20 @@ void Pmipv6MagNotifyHeader::Serialize (Buffer::Iterator start) const
   Buffer::Iterator i = start;
   
   i.WriteU8(m_nextHeader);
-  i.WriteU8(m_length);
+  i.WriteU8(m_notifications.size ());
 
-  m_macAddress.CopyTo(buf);
+  for (std::vector<Notification>::const_iterator it = m_notifications.begin (); it != m_notifications.end (); it++)
+    {
+      it->macAddress.CopyTo(buf);
  
-  i.Write(buf, 6);
+      i.Write(buf, 6);
   
-  i.WriteU8(m_accessTechnologyType);
+      i.WriteU8(it->accessTechnologyType);
+      i.WriteU8(it->flags);
+    }
   
-  i.Write(m_reserved, sizeof(m_reserved));
+  //padding
+  i.WriteU8(0, 6);
 }
 
 uint32_t Pmipv6MagNotifyHeader::Deserialize (Buffer::Iterator start)
@@ -139,14 +181,24 @@ uint32_t Pmipv6MagNotifyHeader::Deserialize (Buffer::Iterator start)
   Buffer::Iterator i = start;
   
   m_nextHeader = i.ReadU8();
-  m_length = i.ReadU8();
+  uint8_t length = i.ReadU8();
   
-  i.Read(buf, 6);
-  m_macAddress.CopyFrom(buf);
+  m_notifications.clear ();
   
-  m_accessTechnologyType = i.ReadU8();
+  for (uint8_t n = 0; n < length; n++)
+    {
+      Notification notification;
+
+      i.Read(buf, 6);
+      notification.macAddress.CopyFrom(buf);
+  
+      notification.accessTechnologyType = i.ReadU8();
+      notification.flags = i.ReadU8();
+
+      m_notifications.push_back (notification);
+    }
   
-  i.Read(m_reserved, sizeof(m_reserved));
+  i.Next(6);
   
   return GetSerializedSize();
 }
@@ -160,6 +212,14 @@ TypeId Pmipv6MagNotifier::GetTypeId ()
   static TypeId tid = TypeId ("ns3::Pmipv6MagNotifier")
     .SetParent<Ipv6L4Protocol> ()
     .AddConstructor<Pmipv6MagNotifier> ()
+    .AddAttribute ("CoalescingWindow", "How long an access point gathers notifications before sending them to the MAG in one message (0 to send each one right away).",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&Pmipv6MagNotifier::m_coalescingWindow),
+                   MakeTimeChecker ())
+    .AddAttribute ("MaxNotifications", "Most notifications in one message, sent before the end of the window once reached.",
+                   UintegerValue (64),
+                   MakeUintegerAccessor (&Pmipv6MagNotifier::m_maxNotifications),
+                   MakeUintegerChecker<uint32_t> (1, Pmipv6MagNotifyHeader::MAX_NOTIFICATIONS))
     ;
   return tid;
 }
@@ -180,6 +240,8 @@ void Pmipv6MagNotifier::DoDispose ()
 {
   NS_LOG_FUNCTION_NOARGS ();
 
+  m_flushEvent.Cancel ();
+  m_pending.Clear ();
   m_node = 0;
   Ipv6L4Protocol::DoDispose ();
 }
@@ -286,13 +348,30 @@ enum Ipv6L4Protocol::RxStatus_e Pmipv6MagNotifier::Receive (Ptr<Packet> packet,
   Ptr<Packet> p = packet->Copy ();
   Pmipv6MagNotifyHeader header;
   
-  if (!m_newNodeCallback.IsNull ())
+  p->RemoveHeader(header);
+  
+  Mac48Address to = Mac48Address::ConvertFrom (interface->GetDevice ()->GetAddress ());
+  
+  if (!m_notificationsCallback.IsNull ())
     {
-      p->RemoveHeader(header);
+      m_notificationsCallback (to, header);
       
-      m_newNodeCallback (header.GetMacAddress (), 
-	                     Mac48Address::ConvertFrom (interface->GetDevice ()->GetAddress ()), 
-						 header.GetAccessTechnologyType ());
+      return Ipv6L4Protocol::RX_OK;
+    }
+  
+  for (uint32_t i = 0; i < header.GetNNotifications (); i++)
+    {
+      if (header.IsDetached (i))
+        {
+          if (!m_detachedNodeCallback.IsNull ())
+            {
+              m_detachedNodeCallback (header.GetMacAddress (i), to);
+            }
+        }
+      else if (!m_newNodeCallback.IsNull ())
+        {
+          m_newNodeCallback (header.GetMacAddress (i), to, header.GetAccessTechnologyType (i));
+        }
     }
 
   return Ipv6L4Protocol::RX_OK;
@@ -315,20 +394,95 @@ void Pmipv6MagNotifier::SetNewNodeCallback (Callback<void, Mac48Address, Mac48Ad
   m_newNodeCallback = cb;
 }
 
+void Pmipv6MagNotifier::NotifyNewNode (Mac48Address from, Mac48Address to, uint8_t att)
+{
+  NS_LOG_FUNCTION (this << from << to << (uint32_t) att);
+  
+  if (!m_newNodeCallback.IsNull ())
+    {
+      m_newNodeCallback (from, to, att);
+      
+      return;
+    }
+  
+  HandleNewNode (from, to, att);
+}
+
+void Pmipv6MagNotifier::SetDetachedNodeCallback (Callback<void, Mac48Address, Mac48Address> cb)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  m_detachedNodeCallback = cb;
+}
+
+void Pmipv6MagNotifier::NotifyDetachedNode (Mac48Address from, Mac48Address to)
+{
+  NS_LOG_FUNCTION (this << from << to);
+  
+  if (!m_detachedNodeCallback.IsNull ())
+    {
+      m_detachedNodeCallback (from, to);
+      
+      return;
+    }
+  
+  HandleDetachedNode (from);
+}
+
+void Pmipv6MagNotifier::SetNotificationsCallback (Callback<void, Mac48Address, const Pmipv6MagNotifyHeader &> cb)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  m_notificationsCallback = cb;
+}
+
 void Pmipv6MagNotifier::HandleNewNode(Mac48Address from, Mac48Address to, uint8_t att)
 {
   NS_LOG_FUNCTION (this << from << to << (uint32_t) att );
   
-  Ptr<Packet> p = Create<Packet>();
-  Pmipv6MagNotifyHeader header;
+  Enqueue (from, att, false);
+}
+
+void Pmipv6MagNotifier::HandleDetachedNode(Mac48Address from)
+{
+  NS_LOG_FUNCTION (this << from);
+  
+  Enqueue (from, 0, true);
+}
+
+void Pmipv6MagNotifier::Enqueue(Mac48Address from, uint8_t att, bool detached)
+{
+  NS_LOG_FUNCTION (this << from << (uint32_t) att << detached);
+  
+  m_pending.AddNotification (from, att, detached);
+  
+  if (m_coalescingWindow.IsZero () || m_pending.GetNNotifications () >= m_maxNotifications)
+    {
+      Flush ();
+    }
+  else if (!m_flushEvent.IsRunning ())
+    {
+      m_flushEvent = Simulator::Schedule (m_coalescingWindow, &Pmipv6MagNotifier::Flush, this);
+    }
+}
+
+void Pmipv6MagNotifier::Flush()
+{
+  NS_LOG_FUNCTION (this << m_pending.GetNNotifications ());
   
-  header.SetMacAddress(from);
-  header.SetAccessTechnologyType(att);
+  m_flushEvent.Cancel ();
   
-  p->AddHeader(header);
+  if (m_pending.GetNNotifications () == 0)
+    {
+      return;
+    }
+  
+  Ptr<Packet> p = Create<Packet>();
+  
+  p->AddHeader(m_pending);
+  m_pending.Clear ();
   
   SendMessage (p, Ipv6Address::GetAny(), m_targetAddress, 64);
 }
 
 } /* namespace ns3 */
-
@@ -25,7 +25,11 @@
 #ifndef PMIPV6_MAG_NOTIFIER_H
 #define PMIPV6_MAG_NOTIFIER_H
 
+#include <vector>
+
 #include "ns3/ipv6-address.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
 #include "ns3/mac48-address.h"
 #include "ns3/ipv6-l4-protocol.h"
 
@@ -35,21 +39,41 @@ namespace ns3
 class Node;
 class Packet;
 
+/**
+ * \class Pmipv6MagNotifyHeader
+ * \brief Attachments and detachments reported by an access point.
+ *
+ * After the next header and length octets, each notification takes
+ * eight octets (MAC address, access technology type, flags), and the
+ * message is padded to a multiple of eight octets: a single notification
+ * is the original 16 octets message.
+ */
 class Pmipv6MagNotifyHeader : public Header
 {
 public:
   static TypeId GetTypeId ();
   virtual TypeId GetInstanceTypeId () const;
 
+  /**
+   * \brief Most notifications in a message, bounded by the length octet.
+   */
+  static const uint32_t MAX_NOTIFICATIONS = 255;
+
   Pmipv6MagNotifyHeader();
  
   virtual ~Pmipv6MagNotifyHeader();
 
-  Mac48Address GetMacAddress() const;
-  void SetMacAddress(Mac48Address macaddr);
+  void AddNotification(Mac48Address macaddr, uint8_t att, bool detached);
+  uint32_t GetNNotifications() const;
+  void Clear();
+  
+  Mac48Address GetMacAddress(uint32_t i) const;
+  uint8_t GetAccessTechnologyType(uint32_t i) const;
   
-  uint8_t GetAccessTechnologyType() const;
-  void SetAccessTechnologyType(uint8_t att);
+  /**
+   * \brief Whether the node left the access link instead of attaching.
+   */
+  bool IsDetached(uint32_t i) const;
   
   virtual void Print (std::ostream& os) const;
   virtual uint32_t GetSerializedSize () const;
@@ -59,11 +83,20 @@ public:
 protected:
 
 private:
+  enum
+  {
+    DETACHED = 0x80
+  };
+
+  struct Notification
+  {
+    Mac48Address macAddress;
+    uint8_t accessTechnologyType;
+    uint8_t flags;
+  };
+
   uint8_t m_nextHeader;
-  uint8_t m_length;
-  Mac48Address m_macAddress;
-  uint8_t m_accessTechnologyType;
-  uint8_t m_reserved[7];
+  std::vector<Notification> m_notifications;
 };
 
 
@@ -94,17 +127,63 @@ public:
   
   void SetNewNodeCallback (Callback<void, Mac48Address, Mac48Address, uint8_t> cb);
   
+  /**
+   * \brief Report a node attachment that does not come from a wifi MAC.
+   *
+   * On the MAG, the attachment is handed to the MAG right away, \p to
+   * being the MAC address of its access device. On an access point, it
+   * is sent to the MAG like the associations of the wifi MAC.
+   *
+   * \param from MAC address of the attached node
+   * \param to MAC address of the access device
+   * \param att access technology type
+   */
+  void NotifyNewNode (Mac48Address from, Mac48Address to, uint8_t att);
+  
+  void SetDetachedNodeCallback (Callback<void, Mac48Address, Mac48Address> cb);
+  
+  /**
+   * \brief Report that a node left the access link, as NotifyNewNode.
+   *
+   * \param from MAC address of the detached node
+   * \param to MAC address of the access device
+   */
+  void NotifyDetachedNode (Mac48Address from, Mac48Address to);
+  
+  /**
+   * \brief Set the handler of the messages received by the MAG.
+   *
+   * Without it, each notification of a message is handed to the new or
+   * detached node callback.
+   */
+  void SetNotificationsCallback (Callback<void, Mac48Address, const Pmipv6MagNotifyHeader &> cb);
+  
 protected:
   virtual void DoDispose ();
 
 private:
   void HandleNewNode(Mac48Address from, Mac48Address to, uint8_t att);
+  void HandleDetachedNode(Mac48Address from);
+  
+  /**
+   * \brief Queue a notification for the MAG, sent at the end of the
+   * coalescing window or once the message is full.
+   */
+  void Enqueue(Mac48Address from, uint8_t att, bool detached);
+  void Flush();
   
   Ptr<Node> m_node;
   
   Ipv6Address m_targetAddress;
   
   Callback<void, Mac48Address, Mac48Address, uint8_t> m_newNodeCallback;
+  Callback<void, Mac48Address, Mac48Address> m_detachedNodeCallback;
+  Callback<void, Mac48Address, const Pmipv6MagNotifyHeader &> m_notificationsCallback;
+  
+  Time m_coalescingWindow;
+  uint32_t m_maxNotifications;
+  Pmipv6MagNotifyHeader m_pending;
+  EventId m_flushEvent;
   
 };
 
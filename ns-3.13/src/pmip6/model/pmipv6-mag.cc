@@ -24,6 +24,7 @@
 
 #include <stdio.h>
 #include <sstream>
+#include <algorithm>
 
 #include "ns3/log.h"
 #include "ns3/assert.h"
@@ -33,6 +34,7 @@
 #include "ns3/ipv6-route.h"
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/ipv6-interface.h"
+#include "ns3/socket.h"
 
 #include "ns3/wifi-net-device.h"
 #include "ns3/wifi-mac.h"
@@ -45,6 +47,7 @@
 #include "ns3/ipv6-static-routing.h"
 
 #include "ns3/ipv6-static-source-routing-helper.h"
+#include "ns3/pmipv6-prefix-routing-helper.h"
 
 #include "ipv6-static-source-routing.h"
 #include "ipv6-mobility-header.h"
@@ -52,10 +55,12 @@
 #include "ipv6-mobility-demux.h"
 #include "ipv6-mobility-option-header.h"
 #include "ipv6-mobility-option.h"
+#include "ipv6-mobility-message-template.h"
 #include "ipv6-mobility-l4-protocol.h"
 #include "ipv6-tunnel-l4-protocol.h"
 #include "unicast-radvd.h"
 #include "pmipv6-profile.h"
+#include "pmipv6-lma-pool.h"
 #include "pmipv6-mag-notifier.h"
 #include "pmipv6-mag.h"
 
@@ -68,8 +73,46 @@ namespace ns3
 
 NS_OBJECT_ENSURE_REGISTERED (Pmipv6Mag);
 
+TypeId Pmipv6Mag::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Pmipv6Mag")
+    .SetParent<Pmipv6Agent> ()
+    .AddConstructor<Pmipv6Mag> ()
+    .AddTraceSource ("Attach",
+                     "The attachment of a MN with a profile was detected.",
+                     MakeTraceSourceAccessor (&Pmipv6Mag::m_attachTrace))
+    .AddTraceSource ("Detach",
+                     "The detachment of a registered MN was detected.",
+                     MakeTraceSourceAccessor (&Pmipv6Mag::m_detachTrace))
+    .AddTraceSource ("TxPbu",
+                     "A PBU was sent for the first time.",
+                     MakeTraceSourceAccessor (&Pmipv6Mag::m_txPbuTrace))
+    .AddTraceSource ("RetransmitPbu",
+                     "A PBU was sent again, for want of a PBA.",
+                     MakeTraceSourceAccessor (&Pmipv6Mag::m_retransmitPbuTrace))
+    .AddTraceSource ("RxPba",
+                     "A PBA matching the last PBU was received.",
+                     MakeTraceSourceAccessor (&Pmipv6Mag::m_rxPbaTrace))
+    .AddTraceSource ("TunnelUp",
+                     "The tunnel and routes of a MN were set up.",
+                     MakeTraceSourceAccessor (&Pmipv6Mag::m_tunnelUpTrace))
+    .AddTraceSource ("TxRa",
+                     "A router advertisement was sent to a MN.",
+                     MakeTraceSourceAccessor (&Pmipv6Mag::m_txRaTrace))
+    .AddTraceSource ("Redirect",
+                     "A LMA redirected the registration of a MN to another LMA.",
+                     MakeTraceSourceAccessor (&Pmipv6Mag::m_redirectTrace))
+    ;
+  return tid;
+}
+
 Pmipv6Mag::Pmipv6Mag ()
 : m_useRemoteAp (false),
+  m_bulkRegistration (false),
+  m_bindingLifetime (Ipv6MobilityL4Protocol::MAX_BINDING_LIFETIME),
+  m_fastHandover (false),
+  m_handoverBuffering (false),
+  m_handoverBuffer (CreateObject<Pmipv6HandoverBuffer> ()),
   m_sequence (0),
   m_buList (0),
   m_radvd (0)
@@ -124,10 +167,13 @@ void Pmipv6Mag::NotifyNewAggregate ()
 		  NS_ASSERT (noti != 0);
 		  
 		  noti->SetNewNodeCallback (MakeCallback (&Pmipv6Mag::HandleNewNode, this));
+		  noti->SetDetachedNodeCallback (MakeCallback (&Pmipv6Mag::HandleDetachedNode, this));
+		  noti->SetNotificationsCallback (MakeCallback (&Pmipv6Mag::HandleNotifications, this));
 		}
 
       //RADVD Setting
       m_radvd = CreateObject<UnicastRadvd> ();
+      m_radvd->TraceConnectWithoutContext ("Tx", MakeCallback (&Pmipv6Mag::HandleRaSent, this));
       node->AddApplication (m_radvd);
 
       m_radvd->SetStartTime (Seconds (1.));
@@ -146,6 +192,53 @@ void Pmipv6Mag::UseRemoteAP (bool remoteAp)
   m_useRemoteAp = remoteAp;
 }
 
+void Pmipv6Mag::SetBulkRegistration (bool bulk)
+{
+  m_bulkRegistration = bulk;
+}
+
+bool Pmipv6Mag::IsBulkRegistration () const
+{
+  return m_bulkRegistration;
+}
+
+void Pmipv6Mag::SetBindingLifetime (uint16_t lifetime)
+{
+  NS_ASSERT (lifetime > 0);
+  
+  m_bindingLifetime = lifetime;
+}
+
+uint16_t Pmipv6Mag::GetBindingLifetime () const
+{
+  return m_bindingLifetime;
+}
+
+void Pmipv6Mag::SetFastHandover (bool fast)
+{
+  m_fastHandover = fast;
+}
+
+bool Pmipv6Mag::IsFastHandover () const
+{
+  return m_fastHandover;
+}
+
+void Pmipv6Mag::SetHandoverBuffering (bool buffering)
+{
+  m_handoverBuffering = buffering;
+}
+
+bool Pmipv6Mag::IsHandoverBuffering () const
+{
+  return m_handoverBuffering;
+}
+
+Ptr<Pmipv6HandoverBuffer> Pmipv6Mag::GetHandoverBuffer () const
+{
+  return m_handoverBuffer;
+}
+
 Ipv6Address Pmipv6Mag::GetLinkLocalAddress (Ipv6Address addr)
 {
   NS_LOG_FUNCTION (this << addr);
@@ -199,6 +292,18 @@ Ptr<Packet> Pmipv6Mag::BuildPbu (BindingUpdateList::Entry *bule)
 {
   NS_LOG_FUNCTION(this << bule);
 
+  Ipv6MobilityMessageTemplate &pbuTemplate = bule->GetPbuTemplate ();
+
+  //Refresh of the same binding: only patch the changing fields
+  if (!pbuTemplate.IsEmpty ())
+    {
+      pbuTemplate.SetSequence (bule->GetLastBindingUpdateSequence ());
+      pbuTemplate.SetLifetime (bule->IsDeregistering () ? 0 : m_bindingLifetime);
+      pbuTemplate.SetTimestamp (bule->GetLastBindingUpdateTime ());
+
+      return pbuTemplate.CreatePacket ();
+    }
+
   Ptr<Packet> p = Create<Packet> ();
 
   Ipv6MobilityBindingUpdateHeader pbu;
@@ -215,8 +320,9 @@ Ptr<Packet> Pmipv6Mag::BuildPbu (BindingUpdateList::Entry *bule)
   pbu.SetFlagH (true);
   pbu.SetFlagL (true);
   pbu.SetFlagP (true);
+  pbu.SetFlagB (m_bulkRegistration);
 
-  pbu.SetLifetime ((uint16_t)Ipv6MobilityL4Protocol::MAX_BINDING_LIFETIME);
+  pbu.SetLifetime (bule->IsDeregistering () ? 0 : m_bindingLifetime);
 
   //Add Mobile Node Identifier Option
   mnidh.SetSubtype (1);
@@ -269,55 +375,186 @@ Ptr<Packet> Pmipv6Mag::BuildPbu (BindingUpdateList::Entry *bule)
       pbu.AddOption (llah);
     }
 
+  //the LMA was picked from a pool, and may redirect to another one
+  if (GetProfile ()->GetLmaPool () && !bule->IsRedirected ())
+    {
+      Ipv6MobilityOptionRedirectCapabilityHeader rch;
+      
+      pbu.AddOption (rch);
+    }
+
   //Add Timestamp Option
   timestamph.SetTimestamp (bule->GetLastBindingUpdateTime ());
   pbu.AddOption (timestamph);
 
   p->AddHeader(pbu);
 
+  pbuTemplate.Set (p);
+
   return p;
 }
 
-void Pmipv6Mag::HandleNewNode (Mac48Address from, Mac48Address to, uint8_t att)
+Ptr<Packet> Pmipv6Mag::BuildBulkPbu (BindingUpdateList::Group *group)
 {
-  NS_LOG_FUNCTION (this << from << to <<(uint32_t)att);
-  NS_ASSERT ( GetProfile() != 0 );
+  NS_LOG_FUNCTION (this << group);
 
-  //get Profile
-  Pmipv6Profile::Entry *pf = GetProfile ()->Lookup (Identifier (from));
+  Ptr<Packet> p = Create<Packet> ();
+
+  Ipv6MobilityBindingUpdateHeader pbu;
+
+  Ipv6MobilityOptionMobileNodeGroupIdentifierHeader groupidh;
+  Ipv6MobilityOptionTimestampHeader timestamph;
+
+  pbu.SetSequence (group->GetLastBindingUpdateSequence ());
+  pbu.SetFlagA (true);
+  pbu.SetFlagP (true);
+  pbu.SetFlagB (true);
+
+  pbu.SetLifetime (group->IsDeregistering () ? 0 : m_bindingLifetime);
+
+  //the group stands for the Mobile Node Identifiers
+  groupidh.SetGroupIdentifier (group->GetGroupIdentifier ());
+  pbu.AddOption (groupidh);
+
+  timestamph.SetTimestamp (group->GetLastBindingUpdateTime ());
+  pbu.AddOption (timestamph);
+
+  p->AddHeader (pbu);
+
+  return p;
+}
+
+bool Pmipv6Mag::RevokeBindings (Ipv6Address lma)
+{
+  NS_LOG_FUNCTION (this << lma);
+
+  BindingUpdateList::Group *group = m_buList->LookupGroup (lma);
+
+  if (group == 0 || group->GetGroupIdentifier () == 0 || group->IsDeregistering ())
+    {
+      NS_LOG_LOGIC ("No bulk binding group for LMA " << lma);
+      return false;
+    }
+
+  std::list<BindingUpdateList::Entry *> entries = group->GetEntries ();
+
+  for (std::list<BindingUpdateList::Entry *>::iterator i = entries.begin (); i != entries.end (); i++)
+    {
+      BindingUpdateList::Entry *bule = (*i);
+
+      bule->StopReachableTimer ();
+      bule->StopRetransTimer ();
+
+      if (bule->GetRadvdIfIndex () >= 0)
+        {
+          ClearRadvdInterface (bule);
+        }
+
+      if (bule->GetTunnelIfIndex () >= 0)
+        {
+          ClearTunnelAndRouting (bule);
+        }
+
+      bule->MarkDeregistering ();
+    }
+
+  //Bulk De-Registration PBU (lifetime zero)
+  group->StopRefreshTimer ();
+  group->StopRetransTimer ();
+  group->MarkDeregistering ();
+  group->SetLastBindingUpdateSequence (GetSequence ());
+  group->SetLastBindingUpdateTime (MicroSeconds (Simulator::Now ().GetMicroSeconds ()));
+
+  Ptr<Packet> p = BuildBulkPbu (group);
+
+  group->SetPbuPacket (p);
+  group->ResetRetryCount ();
+
+  NS_LOG_INFO ("Revoking " << entries.size () << " bindings at " << Simulator::Now ().GetSeconds ());
+
+  SendBulkPbu (group);
+
+  group->StartRetransTimer ();
+
+  return true;
+}
+
+bool Pmipv6Mag::PrepareHandover (Mac48Address mn, Ipv6Address nMag)
+{
+  NS_LOG_FUNCTION (this << mn << nMag);
+  NS_ASSERT (GetProfile () != 0);
+
+  Pmipv6Profile::Entry *pf = GetProfile ()->Lookup (Identifier (mn));
 
   if (pf == 0)
     {
-      NS_LOG_LOGIC ("No profile exists for MAC(" << from << ") ATT(" << (uint32_t)att << ")");
-      return;
+      NS_LOG_LOGIC ("No profile exists for MAC(" << mn << ")");
+      return false;
     }
 
-  //check BUL
   BindingUpdateList::Entry *bule = m_buList->Lookup (pf->GetMnIdentifier ());
 
-  if (bule == 0)
+  if (bule == 0 || !bule->IsReachable ())
     {
-      bule = m_buList->Add (pf->GetMnIdentifier ());
+      NS_LOG_LOGIC ("No registered binding for MAC(" << mn << ")");
+      return false;
     }
 
-  bule->SetAccessTechnologyType (att);
-  bule->SetMnLinkIdentifier (pf->GetMnLinkIdentifier ());
-  bule->SetLmaAddress (pf->GetLmaAddress ());
+  Ptr<Packet> p = Create<Packet> ();
 
-  if (pf->GetHomeNetworkPrefixes ().size () > 0)
+  Ipv6MobilityHandoverInitiateHeader hi;
+
+  Ipv6MobilityOptionMobileNodeIdentifierHeader mnidh;
+  Ipv6MobilityOptionHomeNetworkPrefixHeader hnph;
+  Ipv6MobilityOptionAccessTechnologyTypeHeader atth;
+  Ipv6MobilityOptionMobileNodeLinkLayerIdentifierHeader mnllidh;
+  Ipv6MobilityOptionIpv6AddressHeader lmah (Ipv6MobilityOptionIpv6AddressHeader::LMA_ADDRESS, bule->GetLmaAddress ());
+
+  hi.SetSequence (GetSequence ());
+  hi.SetFlagP (true);
+
+  //ask the next MAG to hold the packets we forward until the MN arrives
+  if (m_handoverBuffering)
     {
-      bule->SetHomeNetworkPrefixes (pf->GetHomeNetworkPrefixes ());
+      hi.SetFlagU (true);
     }
 
-  //XXX: how to determine proper HI(Handoff Indicator) value??
-  bule->SetHandoffIndicator (Ipv6MobilityHeader::OPT_HI_HANDOFF_STATE_UNKNOWN);
+  //context of the MN, as registered at the LMA
+  mnidh.SetSubtype (1);
+  mnidh.SetNodeIdentifier (bule->GetMnIdentifier ());
+  hi.AddOption (mnidh);
 
-  Ipv6Address lla = GetLinkLocalAddress (bule->GetLmaAddress ());
-  if (!lla.IsAny ())
+  std::list<Ipv6Address> hnps = bule->GetHomeNetworkPrefixes ();
+
+  for (std::list<Ipv6Address>::iterator i = hnps.begin (); i != hnps.end (); i++)
     {
-      bule->SetMagLinkAddress (lla);
+      hnph.SetPrefix ((*i));
+      hnph.SetPrefixLength (64);
+
+      hi.AddOption (hnph);
     }
 
+  atth.SetAccessTechnologyType (bule->GetAccessTechnologyType ());
+  hi.AddOption (atth);
+
+  mnllidh.SetLinkLayerIdentifier (bule->GetMnLinkIdentifier ());
+  hi.AddOption (mnllidh);
+
+  hi.AddOption (lmah);
+
+  p->AddHeader (hi);
+
+  NS_LOG_INFO ("Preparing the handover of " << bule->GetMnIdentifier () << " to " << nMag);
+
+  SendMessage (p, nMag, 64);
+
+  return true;
+}
+
+int32_t Pmipv6Mag::GetAccessInterface (Mac48Address to)
+{
+  NS_LOG_FUNCTION (this << to);
+
   //Get IfIndex from "to"
   uint32_t nDev = GetNode ()->GetNDevices ();
   Ptr<NetDevice> dev = 0;
@@ -340,7 +577,7 @@ void Pmipv6Mag::HandleNewNode (Mac48Address from, Mac48Address to, uint8_t att)
     {
       NS_LOG_WARN ("Device Not Found for MAC address (" << to << ")");
 
-      return;
+      return -1;
     }
 
   Ptr<Ipv6> ipv6 = GetNode ()->GetObject<Ipv6> ();
@@ -351,153 +588,1053 @@ void Pmipv6Mag::HandleNewNode (Mac48Address from, Mac48Address to, uint8_t att)
   if (ifIndex == -1)
     {
       NS_LOG_LOGIC ("No Ipv6Interface for Device " << dev->GetIfIndex ());
+    }
+
+  return ifIndex;
+}
 
+void Pmipv6Mag::HandleNewNode (Mac48Address from, Mac48Address to, uint8_t att)
+{
+  NS_LOG_FUNCTION (this << from << to <<(uint32_t)att);
+
+  int32_t ifIndex = GetAccessInterface (to);
+
+  if (ifIndex == -1)
+    {
       return;
     }
 
-  bule->SetIfIndex (ifIndex);
-
-  //preset header information
-  bule->SetLastBindingUpdateSequence (GetSequence ());
-  //Cut to micro-seconds
-  bule->SetLastBindingUpdateTime (MicroSeconds (Simulator::Now ().GetMicroSeconds ()));
+  LinkLocalCache llas;
 
-  Ptr<Packet> p = BuildPbu (bule);
+  AttachNode (from, ifIndex, att, llas);
+}
 
-  //save packet
-  bule->SetPbuPacket (p);
+void Pmipv6Mag::HandleDetachedNode (Mac48Address from, Mac48Address to)
+{
+  NS_LOG_FUNCTION (this << from << to);
 
-  //reset (for the first registration)
-  bule->ResetRetryCount ();
-  
-  //INFO mesg
-  NS_LOG_INFO ("Attached at " << Simulator::Now ().GetSeconds ());
+  DetachNode (from, GetAccessInterface (to));
+}
 
-  //send PBU
-  SendMessage (p->Copy (), bule->GetLmaAddress (), 64);
+void Pmipv6Mag::HandleNotifications (Mac48Address to, const Pmipv6MagNotifyHeader &notifications)
+{
+  NS_LOG_FUNCTION (this << to << notifications.GetNNotifications ());
 
-  bule->StartRetransTimer ();
+  //all the nodes of a batch are on the same access link
+  int32_t ifIndex = GetAccessInterface (to);
 
-  if (bule->IsReachable ())
+  if (ifIndex == -1)
     {
-      bule->MarkRefreshing ();
+      return;
     }
-  else
+
+  LinkLocalCache llas;
+
+  for (uint32_t i = 0; i < notifications.GetNNotifications (); i++)
     {
-      bule->MarkUpdating ();
+      if (notifications.IsDetached (i))
+        {
+          DetachNode (notifications.GetMacAddress (i), ifIndex);
+        }
+      else
+        {
+          AttachNode (notifications.GetMacAddress (i), ifIndex, notifications.GetAccessTechnologyType (i), llas);
+        }
     }
 }
 
-uint8_t Pmipv6Mag::HandlePba (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface)
+void Pmipv6Mag::AttachNode (Mac48Address from, int32_t ifIndex, uint8_t att, LinkLocalCache &llas)
 {
-  NS_LOG_FUNCTION (this << packet << src << dst << interface);
-  Ptr<Packet> p = packet->Copy ();
-
-  Ipv6MobilityBindingAckHeader pba;
-  Ipv6MobilityOptionBundle bundle;
-
-  p->RemoveHeader (pba);
-
-  Ptr<Ipv6MobilityDemux> ipv6MobilityDemux = GetNode ()->GetObject<Ipv6MobilityDemux> ();
-  NS_ASSERT (ipv6MobilityDemux);
+  NS_LOG_FUNCTION (this << from << ifIndex << (uint32_t)att);
+  NS_ASSERT ( GetProfile() != 0 );
 
-  Ptr<Ipv6Mobility> ipv6Mobility = ipv6MobilityDemux->GetMobility (pba.GetMhType ());
-  NS_ASSERT (ipv6Mobility);
+  //get Profile
+  Pmipv6Profile::Entry *pf = GetProfile ()->Lookup (Identifier (from));
 
-  uint8_t length = ((pba.GetHeaderLen () + 1) << 3) - pba.GetOptionsOffset ();
+  if (pf == 0)
+    {
+      NS_LOG_LOGIC ("No profile exists for MAC(" << from << ") ATT(" << (uint32_t)att << ")");
+      return;
+    }
 
-  ipv6Mobility->ProcessOptions (packet, pba.GetOptionsOffset (), length, bundle);
+  //check BUL
+  BindingUpdateList::Entry *bule = m_buList->Lookup (pf->GetMnIdentifier ());
 
-  //option check
-  //Error Process for Mandatory Options
-  if (bundle.GetMnIdentifier ().IsEmpty () ||
-      bundle.GetHomeNetworkPrefixes ().size () == 0 ||
-      bundle.GetAccessTechnologyType () == Ipv6MobilityHeader::OPT_ATT_RESERVED ||
-      bundle.GetHandoffIndicator () == Ipv6MobilityHeader::OPT_HI_RESERVED ||
-      bundle.GetTimestamp ().GetMicroSeconds () == 0)
+  if (bule == 0)
     {
-      NS_LOG_LOGIC ("PBA Option missing.. Ignored.");
-
-      return 0;
+      bule = m_buList->Add (pf->GetMnIdentifier ());
     }
 
-  if (bundle.GetTimestamp () > Simulator::Now ())
+  bule->SetAccessTechnologyType (att);
+  bule->SetMnLinkIdentifier (pf->GetMnLinkIdentifier ());
+  
+  //no LMA in the profile: the LMA of the MN in the pool
+  if (pf->GetLmaAddress ().IsAny () && GetProfile ()->GetLmaPool ())
     {
-      NS_LOG_LOGIC ("Timestamp is mismatched. Ignored.");
-
-      return 0;
+      bule->SetLmaAddress (GetProfile ()->GetLmaPool ()->Select (pf->GetMnIdentifier ()));
     }
-
-  BindingUpdateList::Entry *bule = m_buList->Lookup (bundle.GetMnIdentifier ());
-
-  if (bule == 0)
+  else
     {
-      NS_LOG_LOGIC ("No matched PBA for PBU. Ignored.");
-
-      return 0;
+      bule->SetLmaAddress (pf->GetLmaAddress ());
     }
 
-  //check for timestamp and sequence
-  if (bule->GetLastBindingUpdateSequence () != pba.GetSequence () ||
-      bule->GetLastBindingUpdateTime () != bundle.GetTimestamp ())
+  if (pf->GetHomeNetworkPrefixes ().size () > 0)
     {
-      NS_LOG_LOGIC ("Sequence or Timestamp mismatch. Ignored. this: "
-                    << bule->GetLastBindingUpdateTime ()
-                    << ", from: "
-                    << bundle.GetTimestamp ());
-
-      return 0;
+      bule->SetHomeNetworkPrefixes (pf->GetHomeNetworkPrefixes ());
     }
 
-  //check status code
-  switch (pba.GetStatus ())
-    {
-    case Ipv6MobilityHeader::BA_STATUS_BINDING_UPDATE_ACCEPTED:
-    {
-      bule->StopRetransTimer ();
-      bule->SetPbuPacket (0);
+  //XXX: how to determine proper HI(Handoff Indicator) value??
+  bule->SetHandoffIndicator (Ipv6MobilityHeader::OPT_HI_HANDOFF_STATE_UNKNOWN);
 
-      //update information
-      bule->SetHomeNetworkPrefixes (bundle.GetHomeNetworkPrefixes ());
-      bule->SetReachableTime (Seconds (pba.GetLifetime ()));
+  //context pushed by the previous MAG: serve the MN before the PBA
+  bool prepared = false;
 
-      if (pba.GetLifetime () > 0)
+  if (!m_handoverContexts.empty ())
+    {
+      HandoverContexts::iterator ci = m_handoverContexts.find (pf->GetMnIdentifier ());
+
+      if (ci != m_handoverContexts.end ())
         {
-          if (bule->IsUpdating ())
+          if (ci->second.expires >= Simulator::Now () &&
+              bule->GetTunnelIfIndex () < 0 && bule->GetRadvdIfIndex () < 0)
             {
-              //register radvd interface
-              SetupRadvdInterface (bule);
+              bule->SetHomeNetworkPrefixes (ci->second.hnps);
+              bule->SetLmaAddress (ci->second.lma);
+              bule->SetHandoffIndicator (Ipv6MobilityHeader::OPT_HI_HANDOFF_BETWEEN_MAGS_FOR_SAME_INTERFACE);
+
+              prepared = true;
+            }
+
+          m_handoverContexts.erase (ci);
+        }
+    }
+
+  //one route lookup per LMA and batch
+  LinkLocalCache::iterator it = llas.find (bule->GetLmaAddress ());
+
+  if (it == llas.end ())
+    {
+      it = llas.insert (std::make_pair (bule->GetLmaAddress (), GetLinkLocalAddress (bule->GetLmaAddress ()))).first;
+    }
+
+  Ipv6Address lla = it->second;
+  if (!lla.IsAny ())
+    {
+      bule->SetMagLinkAddress (lla);
+    }
+
+  bule->SetIfIndex (ifIndex);
+
+  //preset header information
+  bule->SetLastBindingUpdateSequence (GetSequence ());
+  //Cut to micro-seconds
+  bule->SetLastBindingUpdateTime (MicroSeconds (Simulator::Now ().GetMicroSeconds ()));
+
+  //before the PBU is built: a re-attachment cancels a pending
+  //deregistration, whose lifetime of 0 must not be reused
+  if (bule->IsReachable ())
+    {
+      bule->MarkRefreshing ();
+    }
+  else
+    {
+      bule->MarkUpdating ();
+    }
+
+  Ptr<Packet> p = BuildPbu (bule);
+
+  //save packet
+  bule->SetPbuPacket (p);
+
+  //reset (for the first registration)
+  bule->ResetRetryCount ();
+  
+  //INFO mesg
+  NS_LOG_INFO ("Attached at " << Simulator::Now ().GetSeconds ());
+  m_attachTrace (bule->GetMnIdentifier (), from);
+
+  //send PBU
+  SendPbu (bule);
+
+  bule->StartRetransTimer ();
+
+  if (prepared)
+    {
+      NS_LOG_LOGIC ("Fast handover of " << bule->GetMnIdentifier ());
+
+      SetupRadvdInterface (bule);
+      SetupTunnelAndRouting (bule);
+
+      DeliverHeldPackets (bule->GetMnIdentifier ());
+    }
+}
+
+void Pmipv6Mag::DetachNode (Mac48Address from, int32_t ifIndex)
+{
+  NS_LOG_FUNCTION (this << from << ifIndex);
+  NS_ASSERT ( GetProfile() != 0 );
+
+  Pmipv6Profile::Entry *pf = GetProfile ()->Lookup (Identifier (from));
+
+  if (pf == 0)
+    {
+      NS_LOG_LOGIC ("No profile exists for MAC(" << from << ")");
+      return;
+    }
+
+  BindingUpdateList::Entry *bule = m_buList->Lookup (pf->GetMnIdentifier ());
+
+  if (bule == 0 || bule->IsDeregistering ())
+    {
+      NS_LOG_LOGIC ("No binding for MAC(" << from << ")");
+      return;
+    }
+
+  //the MN may already be attached through another access link
+  if (ifIndex != bule->GetIfIndex ())
+    {
+      NS_LOG_LOGIC ("MAC(" << from << ") is not attached through interface " << ifIndex);
+      return;
+    }
+
+  if (bule->GetGroup ())
+    {
+      bule->GetGroup ()->RemoveEntry (bule);
+    }
+
+  bule->StopRefreshTimer ();
+  bule->StopReachableTimer ();
+  bule->StopRetransTimer ();
+
+  if (bule->GetRadvdIfIndex () >= 0)
+    {
+      ClearRadvdInterface (bule);
+    }
+
+  if (bule->GetTunnelIfIndex () >= 0)
+    {
+      ClearTunnelAndRouting (bule);
+
+      //hold the packets still tunneled by the LMA
+      if (m_handoverBuffering && HoldPrefixes (bule->GetMnIdentifier (), bule->GetHomeNetworkPrefixes ()))
+        {
+          ForwardHeldPackets (bule->GetMnIdentifier ());
+        }
+    }
+
+  //De-Registration PBU (lifetime zero)
+  bule->SetLastBindingUpdateSequence (GetSequence ());
+  bule->SetLastBindingUpdateTime (MicroSeconds (Simulator::Now ().GetMicroSeconds ()));
+  bule->MarkDeregistering ();
+
+  Ptr<Packet> p = BuildPbu (bule);
+
+  bule->SetPbuPacket (p);
+  bule->ResetRetryCount ();
+
+  NS_LOG_INFO ("Detached at " << Simulator::Now ().GetSeconds ());
+  m_detachTrace (bule->GetMnIdentifier (), from);
+
+  SendPbu (bule);
+
+  bule->StartRetransTimer ();
+}
+
+uint8_t Pmipv6Mag::HandlePba (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface)
+{
+  NS_LOG_FUNCTION (this << packet << src << dst << interface);
+  Ptr<Packet> p = packet->Copy ();
+
+  Ipv6MobilityBindingAckHeader pba;
+  Ipv6MobilityOptionBundle bundle;
+
+  p->RemoveHeader (pba);
+
+  Ptr<Ipv6MobilityDemux> ipv6MobilityDemux = GetNode ()->GetObject<Ipv6MobilityDemux> ();
+  NS_ASSERT (ipv6MobilityDemux);
+
+  Ptr<Ipv6Mobility> ipv6Mobility = ipv6MobilityDemux->GetMobility (pba.GetMhType ());
+  NS_ASSERT (ipv6Mobility);
+
+  uint8_t length = ((pba.GetHeaderLen () + 1) << 3) - pba.GetOptionsOffset ();
+
+  ipv6Mobility->ProcessOptions (packet, pba.GetOptionsOffset (), length, bundle);
+
+  //reply to a bulk PBU, for a group instead of a MN
+  if (pba.GetFlagB () && bundle.GetMnIdentifier ().IsEmpty ())
+    {
+      return HandleBulkPba (pba, bundle, src);
+    }
+
+  //option check
+  //Error Process for Mandatory Options
+  if (bundle.GetMnIdentifier ().IsEmpty () ||
+      bundle.GetHomeNetworkPrefixes ().size () == 0 ||
+      bundle.GetAccessTechnologyType () == Ipv6MobilityHeader::OPT_ATT_RESERVED ||
+      bundle.GetHandoffIndicator () == Ipv6MobilityHeader::OPT_HI_RESERVED ||
+      bundle.GetTimestamp ().GetMicroSeconds () == 0)
+    {
+      NS_LOG_LOGIC ("PBA Option missing.. Ignored.");
+
+      return 0;
+    }
+
+  if (bundle.GetTimestamp () > Simulator::Now ())
+    {
+      NS_LOG_LOGIC ("Timestamp is mismatched. Ignored.");
+
+      return 0;
+    }
+
+  BindingUpdateList::Entry *bule = m_buList->Lookup (bundle.GetMnIdentifier ());
+
+  if (bule == 0)
+    {
+      NS_LOG_LOGIC ("No matched PBA for PBU. Ignored.");
+
+      return 0;
+    }
+
+  //check for timestamp and sequence
+  if (bule->GetLastBindingUpdateSequence () != pba.GetSequence () ||
+      bule->GetLastBindingUpdateTime () != bundle.GetTimestamp ())
+    {
+      NS_LOG_LOGIC ("Sequence or Timestamp mismatch. Ignored. this: "
+                    << bule->GetLastBindingUpdateTime ()
+                    << ", from: "
+                    << bundle.GetTimestamp ());
+
+      return 0;
+    }
+
+  m_rxPbaTrace (bule->GetMnIdentifier (), pba.GetStatus ());
+
+  //RFC 6463: the LMA accepted the PBU but sends the MN to another LMA
+  if (pba.GetStatus () == Ipv6MobilityHeader::BA_STATUS_BINDING_UPDATE_ACCEPTED &&
+      !bundle.GetRedirectLmaAddress ().IsAny ())
+    {
+      if (!bule->IsRedirected () && bundle.GetRedirectLmaAddress () != bule->GetLmaAddress ())
+        {
+          RedirectBinding (bule, bundle.GetRedirectLmaAddress ());
+        }
+      else
+        {
+          NS_LOG_LOGIC ("Redirected twice. Ignored.");
+        }
+
+      return 0;
+    }
+
+  //check status code
+  switch (pba.GetStatus ())
+    {
+    case Ipv6MobilityHeader::BA_STATUS_BINDING_UPDATE_ACCEPTED:
+    {
+      bule->StopRetransTimer ();
+      bule->SetPbuPacket (0);
+
+      //update information
+      bule->SetHomeNetworkPrefixes (bundle.GetHomeNetworkPrefixes ());
+      bule->SetReachableTime (Seconds (pba.GetLifetime ()));
+
+      if (pba.GetLifetime () > 0)
+        {
+          //already done at the attachment after a fast handover
+          if (bule->IsUpdating ())
+            {
+              //register radvd interface
+              if (bule->GetRadvdIfIndex () < 0)
+                {
+                  SetupRadvdInterface (bule);
+                }
 
               //create tunnel & setup routing
-              SetupTunnelAndRouting (bule);
+              if (bule->GetTunnelIfIndex () < 0)
+                {
+                  SetupTunnelAndRouting (bule);
+                }
+
+              DeliverHeldPackets (bule->GetMnIdentifier ());
+            }
+
+          bule->MarkReachable ();
+
+          //the LMA put the binding in the bulk binding group of this MAG
+          if (pba.GetFlagB () && bundle.GetMnGroupIdentifier () != 0)
+            {
+              BindingUpdateList::Group *group = m_buList->LookupGroup (bule->GetLmaAddress ());
+
+              if (group == 0)
+                {
+                  group = m_buList->AddGroup (bule->GetLmaAddress ());
+                }
+
+              if (!group->IsDeregistering ())
+                {
+                  group->SetGroupIdentifier (bundle.GetMnGroupIdentifier ());
+                  group->SetReachableTime (Seconds (pba.GetLifetime ()));
+                  group->AddEntry (bule);
+                }
+            }
+
+          //Setup lifetime, refreshed by the group if any
+          bule->StopRefreshTimer ();
+          if (bule->GetGroup () == 0)
+            {
+              bule->StartRefreshTimer ();
+            }
+          bule->StopReachableTimer ();
+          bule->StartReachableTimer ();
+        }
+      else
+        {
+          //de-registering, already cleared if the MN detached
+          if (bule->GetRadvdIfIndex () >= 0)
+            {
+              ClearRadvdInterface (bule);
+            }
+
+          if (bule->GetTunnelIfIndex () >= 0)
+            {
+              ClearTunnelAndRouting (bule);
+            }
+
+          m_buList->Remove (bule);
+        }
+      break;
+    }
+
+    default:
+      NS_LOG_LOGIC ("Error occurred code=" << pba.GetStatus ());
+
+      //refused after a fast handover, stop serving the MN
+      if (bule->IsUpdating ())
+        {
+          if (bule->GetRadvdIfIndex () >= 0)
+            {
+              ClearRadvdInterface (bule);
+            }
+
+          if (bule->GetTunnelIfIndex () >= 0)
+            {
+              ClearTunnelAndRouting (bule);
             }
+        }
+    }
+
+  return 0;
+}
+
+void Pmipv6Mag::RedirectBinding (BindingUpdateList::Entry *bule, Ipv6Address lma)
+{
+  NS_LOG_FUNCTION (this << bule << lma);
+
+  NS_LOG_LOGIC ("Registration of " << bule->GetMnIdentifier () << " redirected from " << bule->GetLmaAddress () << " to " << lma);
+
+  m_redirectTrace (bule->GetMnIdentifier (), lma);
+
+  bule->StopRetransTimer ();
+
+  bule->SetLmaAddress (lma);
+  bule->SetRedirected (true);
+
+  //the next MAGs of the MN register it with the same LMA
+  if (GetProfile ()->GetLmaPool ())
+    {
+      GetProfile ()->GetLmaPool ()->Assign (bule->GetMnIdentifier (), lma);
+    }
+
+  Ipv6Address lla = GetLinkLocalAddress (lma);
+  if (!lla.IsAny ())
+    {
+      bule->SetMagLinkAddress (lla);
+    }
+
+  //a new initial registration
+  bule->SetLastBindingUpdateSequence (GetSequence ());
+  bule->SetLastBindingUpdateTime (MicroSeconds (Simulator::Now ().GetMicroSeconds ()));
+  bule->SetPbuPacket (BuildPbu (bule));
+  bule->ResetRetryCount ();
+
+  SendPbu (bule);
+
+  bule->StartRetransTimer ();
+}
+
+uint8_t Pmipv6Mag::HandleBulkPba (const Ipv6MobilityBindingAckHeader &pba, const Ipv6MobilityOptionBundle &bundle, const Ipv6Address &src)
+{
+  NS_LOG_FUNCTION (this << src);
+
+  BindingUpdateList::Group *group = m_buList->LookupGroup (src);
+
+  if (group == 0 || group->GetPbuPacket () == 0)
+    {
+      NS_LOG_LOGIC ("No bulk PBU pending for " << src << ". Ignored.");
+
+      return 0;
+    }
+
+  //check for group, timestamp and sequence
+  if (group->GetGroupIdentifier () != bundle.GetMnGroupIdentifier () ||
+      group->GetLastBindingUpdateSequence () != pba.GetSequence () ||
+      group->GetLastBindingUpdateTime () != bundle.GetTimestamp ())
+    {
+      NS_LOG_LOGIC ("Group, Sequence or Timestamp mismatch. Ignored.");
+
+      return 0;
+    }
+
+  m_rxPbaTrace (Identifier (), pba.GetStatus ());
+
+  group->StopRetransTimer ();
+  group->SetPbuPacket (0);
+
+  std::list<BindingUpdateList::Entry *> entries = group->GetEntries ();
+
+  if (group->IsDeregistering ())
+    {
+      //revoked, whatever the status
+      for (std::list<BindingUpdateList::Entry *>::iterator i = entries.begin (); i != entries.end (); i++)
+        {
+          m_buList->Remove (*i);
+        }
+
+      m_buList->RemoveGroup (group);
+
+      return 0;
+    }
+
+  if (pba.GetStatus () != Ipv6MobilityHeader::BA_STATUS_BINDING_UPDATE_ACCEPTED || pba.GetLifetime () == 0)
+    {
+      NS_LOG_LOGIC ("Bulk refresh refused code=" << (uint32_t)pba.GetStatus () << ", refreshing bindings one by one");
+
+      //the entries refresh themselves again
+      m_buList->RemoveGroup (group);
+
+      for (std::list<BindingUpdateList::Entry *>::iterator i = entries.begin (); i != entries.end (); i++)
+        {
+          if ((*i)->IsReachable ())
+            {
+              (*i)->StartRefreshTimer ();
+            }
+        }
+
+      return 0;
+    }
+
+  NS_LOG_LOGIC ("Bulk refresh of " << entries.size () << " bindings accepted");
+
+  for (std::list<BindingUpdateList::Entry *>::iterator i = entries.begin (); i != entries.end (); i++)
+    {
+      BindingUpdateList::Entry *bule = (*i);
+
+      bule->SetReachableTime (Seconds (pba.GetLifetime ()));
+      bule->StopReachableTimer ();
+      bule->StartReachableTimer ();
+    }
+
+  group->SetReachableTime (Seconds (pba.GetLifetime ()));
+  group->StopRefreshTimer ();
+  group->StartRefreshTimer ();
+
+  return 0;
+}
+
+uint8_t Pmipv6Mag::HandleHi (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface)
+{
+  NS_LOG_FUNCTION (this << packet << src << dst << interface);
+
+  Ipv6MobilityHandoverInitiateHeader hi;
+  Ipv6MobilityOptionBundle bundle;
+
+  packet->PeekHeader (hi);
+
+  Ptr<Ipv6MobilityDemux> ipv6MobilityDemux = GetNode ()->GetObject<Ipv6MobilityDemux> ();
+  NS_ASSERT (ipv6MobilityDemux);
+
+  Ptr<Ipv6Mobility> ipv6Mobility = ipv6MobilityDemux->GetMobility (hi.GetMhType ());
+  NS_ASSERT (ipv6Mobility);
+
+  uint8_t length = ((hi.GetHeaderLen () + 1) << 3) - hi.GetOptionsOffset ();
+
+  ipv6Mobility->ProcessOptions (packet, hi.GetOptionsOffset (), length, bundle);
+
+  if (!m_fastHandover)
+    {
+      NS_LOG_LOGIC ("Fast handover disabled, HI refused");
+
+      SendHack (src, hi.GetSequence (), bundle.GetMnIdentifier (), Ipv6MobilityHeader::HACK_CODE_ADMINISTRATIVELY_PROHIBITED);
+
+      return 0;
+    }
+
+  if (bundle.GetMnIdentifier ().IsEmpty () ||
+      bundle.GetHomeNetworkPrefixes ().size () == 0 ||
+      bundle.GetLmaAddress ().IsAny ())
+    {
+      NS_LOG_LOGIC ("HI context incomplete, refused");
+
+      SendHack (src, hi.GetSequence (), bundle.GetMnIdentifier (), Ipv6MobilityHeader::HACK_CODE_HANDOVER_NOT_ACCEPTED);
+
+      return 0;
+    }
+
+  HandoverContext &context = m_handoverContexts[bundle.GetMnIdentifier ()];
+
+  context.hnps = bundle.GetHomeNetworkPrefixes ();
+  context.lma = bundle.GetLmaAddress ();
+  context.expires = Simulator::Now () + MilliSeconds (Ipv6MobilityL4Protocol::HANDOVER_CONTEXT_LIFETIME);
+
+  NS_LOG_LOGIC ("Context of " << bundle.GetMnIdentifier () << " received from " << src);
+
+  //hold the packets forwarded by the previous MAG until the MN is served
+  bool buffering = hi.GetFlagU () && m_handoverBuffering &&
+    HoldPrefixes (bundle.GetMnIdentifier (), bundle.GetHomeNetworkPrefixes ());
+
+  SendHack (src, hi.GetSequence (), bundle.GetMnIdentifier (), Ipv6MobilityHeader::HACK_CODE_HANDOVER_ACCEPTED, buffering);
+
+  return 0;
+}
+
+uint8_t Pmipv6Mag::HandleHack (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface)
+{
+  NS_LOG_FUNCTION (this << packet << src << dst << interface);
+
+  Ipv6MobilityHandoverAckHeader hack;
+  Ipv6MobilityOptionBundle bundle;
+
+  packet->PeekHeader (hack);
+
+  if (hack.GetCode () != Ipv6MobilityHeader::HACK_CODE_HANDOVER_ACCEPTED)
+    {
+      NS_LOG_LOGIC ("Handover refused by " << src << " code=" << (uint32_t)hack.GetCode ());
+
+      return 0;
+    }
+
+  NS_LOG_LOGIC ("Handover prepared by " << src);
+
+  if (!m_handoverBuffering)
+    {
+      //nothing to forward to the next MAG: the MN is served by the LMA
+      return 0;
+    }
+
+  Ptr<Ipv6MobilityDemux> ipv6MobilityDemux = GetNode ()->GetObject<Ipv6MobilityDemux> ();
+  NS_ASSERT (ipv6MobilityDemux);
+
+  Ptr<Ipv6Mobility> ipv6Mobility = ipv6MobilityDemux->GetMobility (hack.GetMhType ());
+  NS_ASSERT (ipv6Mobility);
+
+  uint8_t length = ((hack.GetHeaderLen () + 1) << 3) - hack.GetOptionsOffset ();
+
+  ipv6Mobility->ProcessOptions (packet, hack.GetOptionsOffset (), length, bundle);
+
+  if (bundle.GetMnIdentifier ().IsEmpty ())
+    {
+      return 0;
+    }
+
+  //forward the packets held after the detachment, if any, to the next MAG
+  HeldPrefixes &held = m_heldPrefixes[bundle.GetMnIdentifier ()];
+
+  held.nMag = src;
+
+  if (m_handoverBuffer->IsOpen (bundle.GetMnIdentifier ()))
+    {
+      ForwardHeldPackets (bundle.GetMnIdentifier ());
+    }
+  else if (held.hnps.empty () && !held.expire.IsRunning ())
+    {
+      //not detached yet, remember the next MAG as long as a context
+      held.expire = Simulator::Schedule (MilliSeconds (Ipv6MobilityL4Protocol::HANDOVER_CONTEXT_LIFETIME),
+                                         &Pmipv6Mag::ReleasePrefixes, this, bundle.GetMnIdentifier ());
+    }
+
+  return 0;
+}
+
+void Pmipv6Mag::SendHack (const Ipv6Address &dst, uint16_t sequence, const Identifier &mnId, uint8_t code, bool buffering)
+{
+  NS_LOG_FUNCTION (this << dst << sequence << (uint32_t)code << buffering);
+
+  Ptr<Packet> p = Create<Packet> ();
 
-          bule->MarkReachable ();
+  Ipv6MobilityHandoverAckHeader hack;
 
-          //Setup lifetime
-          bule->StopRefreshTimer ();
-          bule->StartRefreshTimer ();
-          bule->StopReachableTimer ();
-          bule->StartReachableTimer ();
+  hack.SetSequence (sequence);
+  hack.SetFlagU (buffering);
+  hack.SetFlagP (true);
+  hack.SetCode (code);
+
+  if (!mnId.IsEmpty ())
+    {
+      Ipv6MobilityOptionMobileNodeIdentifierHeader mnidh;
+
+      mnidh.SetSubtype (1);
+      mnidh.SetNodeIdentifier (mnId);
+
+      hack.AddOption (mnidh);
+    }
+
+  p->AddHeader (hack);
+
+  SendMessage (p, dst, 64);
+}
+
+uint8_t Pmipv6Mag::HandleLri (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface)
+{
+  NS_LOG_FUNCTION (this << packet << src << dst << interface);
+
+  Ipv6MobilityLocalizedRoutingInitiationHeader lri;
+  Ipv6MobilityOptionBundle bundle;
+
+  packet->PeekHeader (lri);
+
+  Ptr<Ipv6MobilityDemux> ipv6MobilityDemux = GetNode ()->GetObject<Ipv6MobilityDemux> ();
+  NS_ASSERT (ipv6MobilityDemux);
+
+  Ptr<Ipv6Mobility> ipv6Mobility = ipv6MobilityDemux->GetMobility (lri.GetMhType ());
+  NS_ASSERT (ipv6Mobility);
+
+  uint8_t length = ((lri.GetHeaderLen () + 1) << 3) - lri.GetOptionsOffset ();
+
+  ipv6Mobility->ProcessOptions (packet, lri.GetOptionsOffset (), length, bundle);
+
+  std::list<Ipv6Address> hnps = bundle.GetHomeNetworkPrefixes ();
+
+  if (lri.GetLifetime () == 0)
+    {
+      NS_LOG_LOGIC ("Localized routing terminated by " << src);
+
+      RemoveLocalizedRoutes (hnps);
+      SendLra (src, lri.GetSequence (), Ipv6MobilityHeader::LRA_STATUS_SUCCESS, 0);
+
+      return 0;
+    }
+
+  Ipv6StaticSourceRoutingHelper sourceRoutingHelper;
+  Pmipv6PrefixRoutingHelper prefixRoutingHelper;
+
+  Ptr<Ipv6> ipv6 = GetNode ()->GetObject<Ipv6> ();
+
+  Ptr<Ipv6StaticSourceRouting> sourceRouting = sourceRoutingHelper.GetStaticSourceRouting (ipv6);
+  Ptr<Pmipv6PrefixRouting> prefixRouting = prefixRoutingHelper.GetPrefixRouting (ipv6);
+
+  //the attached MNs are found by their prefix routes
+  if (prefixRouting == 0 || sourceRouting == 0)
+    {
+      NS_LOG_LOGIC ("No prefix routing, localized routing refused");
+
+      SendLra (src, lri.GetSequence (), Ipv6MobilityHeader::LRA_STATUS_NOT_ALLOWED, 0);
+
+      return 0;
+    }
+
+  Ptr<Ipv6TunnelL4Protocol> th = GetNode ()->GetObject<Ipv6TunnelL4Protocol> ();
+  NS_ASSERT (th);
+
+  bool attached = false;
+
+  for (std::list<Ipv6Address>::iterator i = hnps.begin (); i != hnps.end (); i++)
+    {
+      if (prefixRouting->LookupPrefix (*i) < 0)
+        {
+          continue;
         }
-      else
+
+      attached = true;
+
+      for (std::list<Ipv6Address>::iterator j = hnps.begin (); j != hnps.end (); j++)
         {
-          //de-registering
-          ClearRadvdInterface (bule);
-          ClearTunnelAndRouting (bule);
+          std::pair<Ipv6Address, Ipv6Address> key (*i, *j);
 
-          m_buList->Remove (bule);
+          if (*j == *i || m_localizedRoutes.find (key) != m_localizedRoutes.end ())
+            {
+              continue;
+            }
+
+          LocalizedRoute route;
+          int32_t ifIndex = prefixRouting->LookupPrefix (*j);
+
+          if (ifIndex >= 0)
+            {
+              route.interface = ifIndex;
+              route.peerMag = Ipv6Address::GetAny ();
+            }
+          else if (!bundle.GetMagAddress ().IsAny ())
+            {
+              route.interface = th->AddTunnel (bundle.GetMagAddress ());
+              route.peerMag = bundle.GetMagAddress ();
+            }
+          else
+            {
+              continue;
+            }
+
+          NS_LOG_LOGIC ("Add Localized Route from " << (*i) << "/64 to " << (*j) << "/64 via " << route.interface);
+          sourceRouting->AddNetworkRouteFromTo ((*i), Ipv6Prefix (64), (*j), Ipv6Prefix (64), route.interface);
+
+          m_localizedRoutes[key] = route;
         }
-      break;
     }
 
-    default:
-      NS_LOG_LOGIC ("Error occurred code=" << pba.GetStatus ());
+  if (!attached)
+    {
+      NS_LOG_LOGIC ("No MN of the LRI attached here");
+
+      SendLra (src, lri.GetSequence (), Ipv6MobilityHeader::LRA_STATUS_MN_NOT_ATTACHED, 0);
+
+      return 0;
     }
 
+  SendLra (src, lri.GetSequence (), Ipv6MobilityHeader::LRA_STATUS_SUCCESS, lri.GetLifetime ());
+
   return 0;
 }
 
+void Pmipv6Mag::SendLra (const Ipv6Address &dst, uint16_t sequence, uint8_t status, uint16_t lifetime)
+{
+  NS_LOG_FUNCTION (this << dst << sequence << (uint32_t)status << lifetime);
+
+  Ptr<Packet> p = Create<Packet> ();
+
+  Ipv6MobilityLocalizedRoutingAckHeader lra;
+
+  lra.SetSequence (sequence);
+  lra.SetStatus (status);
+  lra.SetLifetime (lifetime);
+
+  p->AddHeader (lra);
+
+  SendMessage (p, dst, 64);
+}
+
+void Pmipv6Mag::RemoveLocalizedRoutes (const std::list<Ipv6Address> &hnps)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_localizedRoutes.empty ())
+    {
+      return;
+    }
+
+  Ipv6StaticSourceRoutingHelper sourceRoutingHelper;
+  Ptr<Ipv6StaticSourceRouting> sourceRouting = sourceRoutingHelper.GetStaticSourceRouting (GetNode ()->GetObject<Ipv6> ());
+
+  Ptr<Ipv6TunnelL4Protocol> th = GetNode ()->GetObject<Ipv6TunnelL4Protocol> ();
+  NS_ASSERT (th && sourceRouting);
+
+  for (LocalizedRoutes::iterator i = m_localizedRoutes.begin (); i != m_localizedRoutes.end (); )
+    {
+      if (std::find (hnps.begin (), hnps.end (), i->first.first) == hnps.end () &&
+          std::find (hnps.begin (), hnps.end (), i->first.second) == hnps.end ())
+        {
+          i++;
+          continue;
+        }
+
+      NS_LOG_LOGIC ("Remove Localized Route from " << i->first.first << "/64 to " << i->first.second << "/64 via " << i->second.interface);
+      sourceRouting->RemoveRouteFromTo (i->first.first, Ipv6Prefix (64), i->first.second, Ipv6Prefix (64), i->second.interface);
+
+      if (!i->second.peerMag.IsAny ())
+        {
+          th->RemoveTunnel (i->second.peerMag);
+        }
+
+      m_localizedRoutes.erase (i++);
+    }
+}
+
+uint32_t Pmipv6Mag::GetNLocalizedRoutes () const
+{
+  return m_localizedRoutes.size ();
+}
+
+bool Pmipv6Mag::HoldPrefixes (const Identifier &mnId, const std::list<Ipv6Address> &hnps)
+{
+  NS_LOG_FUNCTION (this << mnId);
+
+  Pmipv6PrefixRoutingHelper prefixRoutingHelper;
+  Ptr<Pmipv6PrefixRouting> prefixRouting = prefixRoutingHelper.GetPrefixRouting (GetNode ()->GetObject<Ipv6> ());
+
+  if (prefixRouting == 0)
+    {
+      NS_LOG_LOGIC ("No prefix routing, packets of " << mnId << " not held");
+      return false;
+    }
+
+  prefixRouting->SetHoldCallback (MakeCallback (&Pmipv6Mag::HandleHeldPacket, this));
+
+  HeldPrefixes &held = m_heldPrefixes[mnId];
+
+  //a hold left by a previous handover of the MN is replaced
+  m_handoverBuffer->Close (mnId);
+
+  for (std::list<Ipv6Address>::const_iterator i = hnps.begin (); i != hnps.end (); i++)
+    {
+      //never hold a prefix this MAG serves
+      if (prefixRouting->LookupPrefix ((*i)) < 0)
+        {
+          prefixRouting->AddHoldRoute ((*i));
+        }
+    }
+
+  held.hnps = hnps;
+  m_handoverBuffer->Open (mnId, hnps);
+
+  held.expire.Cancel ();
+  held.expire = Simulator::Schedule (MilliSeconds (Ipv6MobilityL4Protocol::HANDOVER_CONTEXT_LIFETIME),
+                                     &Pmipv6Mag::ReleasePrefixes, this, mnId);
+
+  Ptr<Ipv6TunnelL4Protocol> th = GetNode ()->GetObject<Ipv6TunnelL4Protocol> ();
+  NS_ASSERT (th);
+
+  th->InvalidateRouteCache ();
+
+  return true;
+}
+
+void Pmipv6Mag::ReleasePrefixes (Identifier mnId)
+{
+  NS_LOG_FUNCTION (this << mnId);
+
+  HeldPrefixesMap::iterator it = m_heldPrefixes.find (mnId);
+
+  if (it == m_heldPrefixes.end ())
+    {
+      return;
+    }
+
+  HeldPrefixes &held = it->second;
+
+  //packets left are dropped
+  m_handoverBuffer->Close (mnId);
+
+  Pmipv6PrefixRoutingHelper prefixRoutingHelper;
+  Ptr<Pmipv6PrefixRouting> prefixRouting = prefixRoutingHelper.GetPrefixRouting (GetNode ()->GetObject<Ipv6> ());
+
+  Ptr<Ipv6TunnelL4Protocol> th = GetNode ()->GetObject<Ipv6TunnelL4Protocol> ();
+  NS_ASSERT (th);
+
+  if (prefixRouting)
+    {
+      for (std::list<Ipv6Address>::iterator i = held.hnps.begin (); i != held.hnps.end (); i++)
+        {
+          prefixRouting->RemoveHoldRoute ((*i));
+        }
+    }
+
+  if (held.forwarding)
+    {
+      th->RemoveTunnel (held.nMag);
+    }
+
+  held.expire.Cancel ();
+  m_heldPrefixes.erase (it);
+
+  th->InvalidateRouteCache ();
+}
+
+void Pmipv6Mag::ForwardHeldPackets (const Identifier &mnId)
+{
+  NS_LOG_FUNCTION (this << mnId);
+
+  HeldPrefixesMap::iterator it = m_heldPrefixes.find (mnId);
+
+  if (it == m_heldPrefixes.end () || it->second.nMag.IsAny ())
+    {
+      NS_LOG_LOGIC ("Next MAG of " << mnId << " unknown, packets held");
+      return;
+    }
+
+  HeldPrefixes &held = it->second;
+
+  if (!held.forwarding)
+    {
+      Ptr<Ipv6TunnelL4Protocol> th = GetNode ()->GetObject<Ipv6TunnelL4Protocol> ();
+      NS_ASSERT (th);
+
+      th->AddTunnel (held.nMag);
+      held.forwarding = true;
+    }
+
+  NS_LOG_LOGIC ("Forwarding the packets of " << mnId << " to " << held.nMag);
+
+  m_handoverBuffer->Forward (mnId, MakeCallback (&Pmipv6Mag::ForwardPacket, this));
+}
+
+void Pmipv6Mag::DeliverHeldPackets (const Identifier &mnId)
+{
+  NS_LOG_FUNCTION (this << mnId);
+
+  if (m_heldPrefixes.empty () || !m_handoverBuffer->IsOpen (mnId))
+    {
+      return;
+    }
+
+  m_handoverBuffer->Flush (mnId, MakeCallback (&Pmipv6Mag::DeliverPacket, this));
+
+  ReleasePrefixes (mnId);
+}
+
+void Pmipv6Mag::HandleHeldPacket (Ptr<Packet> p, const Ipv6Header &header)
+{
+  NS_LOG_FUNCTION (this << p);
+
+  m_handoverBuffer->Receive (p, header);
+}
+
+void Pmipv6Mag::ForwardPacket (const Identifier &mnId, Ptr<Packet> p, const Ipv6Header &header)
+{
+  NS_LOG_FUNCTION (this << mnId << p);
+
+  HeldPrefixesMap::iterator it = m_heldPrefixes.find (mnId);
+  NS_ASSERT (it != m_heldPrefixes.end ());
+
+  Ptr<Ipv6TunnelL4Protocol> th = GetNode ()->GetObject<Ipv6TunnelL4Protocol> ();
+  NS_ASSERT (th);
+
+  Ptr<TunnelNetDevice> tunnel = th->GetTunnelDevice (it->second.nMag);
+  NS_ASSERT (tunnel);
+
+  //restore the inner header, with the hop limit left
+  Ipv6Header inner = header;
+  SocketIpTtlTag tag;
+
+  if (p->RemovePacketTag (tag))
+    {
+      inner.SetHopLimit (tag.GetTtl ());
+    }
+
+  inner.SetPayloadLength (p->GetSize ());
+  p->AddHeader (inner);
+
+  tunnel->Send (p, tunnel->GetBroadcast (), Ipv6L3Protocol::PROT_NUMBER);
+}
+
+void Pmipv6Mag::DeliverPacket (const Identifier &mnId, Ptr<Packet> p, const Ipv6Header &header)
+{
+  NS_LOG_FUNCTION (this << mnId << p);
+
+  Pmipv6PrefixRoutingHelper prefixRoutingHelper;
+  Ptr<Ipv6L3Protocol> ipv6 = GetNode ()->GetObject<Ipv6L3Protocol> ();
+  Ptr<Pmipv6PrefixRouting> prefixRouting = prefixRoutingHelper.GetPrefixRouting (ipv6);
+
+  NS_ASSERT (prefixRouting);
+
+  Socket::SocketErrno err;
+  Ptr<Ipv6Route> route = prefixRouting->RouteOutput (p, header, 0, err);
+
+  if (route == 0)
+    {
+      NS_LOG_LOGIC ("No route to " << header.GetDestinationAddress () << " anymore");
+      return;
+    }
+
+  ipv6->Send (p, header.GetSourceAddress (), header.GetDestinationAddress (), header.GetNextHeader (), route);
+}
+
 bool Pmipv6Mag::SetupTunnelAndRouting (BindingUpdateList::Entry *bule)
 {
   NS_LOG_FUNCTION (this << bule);
@@ -510,14 +1647,16 @@ bool Pmipv6Mag::SetupTunnelAndRouting (BindingUpdateList::Entry *bule)
 
   bule->SetTunnelIfIndex (tunnelIf);
 
-  //routing setup by static routing protocol
+  //routing setup by prefix and source routing protocols, static routing if no prefix routing
   Ipv6StaticRoutingHelper staticRoutingHelper;
   Ipv6StaticSourceRoutingHelper sourceRoutingHelper;
+  Pmipv6PrefixRoutingHelper prefixRoutingHelper;
 
   Ptr<Ipv6> ipv6 = GetNode ()->GetObject<Ipv6> ();
 
   Ptr<Ipv6StaticRouting> staticRouting = staticRoutingHelper.GetStaticRouting (ipv6);
   Ptr<Ipv6StaticSourceRouting> sourceRouting = sourceRoutingHelper.GetStaticSourceRouting (ipv6);
+  Ptr<Pmipv6PrefixRouting> prefixRouting = prefixRoutingHelper.GetPrefixRouting (ipv6);
 
   NS_ASSERT (staticRouting && sourceRouting);
 
@@ -526,12 +1665,23 @@ bool Pmipv6Mag::SetupTunnelAndRouting (BindingUpdateList::Entry *bule)
   for (std::list<Ipv6Address>::iterator i = hnpList.begin (); i != hnpList.end (); i++)
     {
       NS_LOG_LOGIC ("Add Route to " << (*i) << "/64 via " << (uint32_t)bule->GetIfIndex ());
-      staticRouting->AddNetworkRouteTo ((*i), Ipv6Prefix (64), bule->GetIfIndex ());
+      if (prefixRouting)
+        {
+          prefixRouting->AddPrefixRoute ((*i), bule->GetIfIndex ());
+        }
+      else
+        {
+          staticRouting->AddNetworkRouteTo ((*i), Ipv6Prefix (64), bule->GetIfIndex ());
+        }
 
       NS_LOG_LOGIC ("Add Source Route from " << (*i) << "/64 via " << (uint32_t)bule->GetTunnelIfIndex ());
       sourceRouting->AddNetworkRouteFrom ((*i), Ipv6Prefix (64), bule->GetTunnelIfIndex ());
     }
 
+  th->InvalidateRouteCache ();
+
+  m_tunnelUpTrace (bule->GetMnIdentifier (), tunnelIf);
+
   return true;
 }
 
@@ -539,23 +1689,34 @@ void Pmipv6Mag::ClearTunnelAndRouting (BindingUpdateList::Entry *bule)
 {
   NS_LOG_FUNCTION (this << bule);
 
-  //routing setup by static routing protocol
+  //routing setup by prefix and source routing protocols, static routing if no prefix routing
   Ipv6StaticRoutingHelper staticRoutingHelper;
   Ipv6StaticSourceRoutingHelper sourceRoutingHelper;
+  Pmipv6PrefixRoutingHelper prefixRoutingHelper;
 
   Ptr<Ipv6> ipv6 = GetNode ()->GetObject<Ipv6> ();
 
   Ptr<Ipv6StaticRouting> staticRouting = staticRoutingHelper.GetStaticRouting (ipv6);
   Ptr<Ipv6StaticSourceRouting> sourceRouting = sourceRoutingHelper.GetStaticSourceRouting (ipv6);
+  Ptr<Pmipv6PrefixRouting> prefixRouting = prefixRoutingHelper.GetPrefixRouting (ipv6);
 
   NS_ASSERT (staticRouting && sourceRouting);
 
   std::list<Ipv6Address> hnpList = bule->GetHomeNetworkPrefixes ();
 
+  RemoveLocalizedRoutes (hnpList);
+
   for (std::list<Ipv6Address>::iterator i = hnpList.begin (); i != hnpList.end (); i++)
     {
       NS_LOG_LOGIC ("Remove Route to " << (*i) << "/64 via " << (uint32_t)bule->GetIfIndex ());
-      staticRouting->RemoveRoute ((*i), Ipv6Prefix (64), bule->GetIfIndex (), (*i));
+      if (prefixRouting)
+        {
+          prefixRouting->RemovePrefixRoute ((*i), bule->GetIfIndex ());
+        }
+      else
+        {
+          staticRouting->RemoveRoute ((*i), Ipv6Prefix (64), bule->GetIfIndex (), (*i));
+        }
 
       NS_LOG_LOGIC ("Remove Source Route from " << (*i) << "/64 via " << (uint32_t)bule->GetTunnelIfIndex ());
       sourceRouting->RemoveRoute ((*i), Ipv6Prefix (64), bule->GetTunnelIfIndex (), (*i));
@@ -566,9 +1727,57 @@ void Pmipv6Mag::ClearTunnelAndRouting (BindingUpdateList::Entry *bule)
   NS_ASSERT (th);
 
   th->RemoveTunnel (bule->GetLmaAddress ());
+  th->InvalidateRouteCache ();
   bule->SetTunnelIfIndex (-1);
 }
 
+void Pmipv6Mag::SendPbu (BindingUpdateList::Entry *bule, bool retransmit)
+{
+  NS_LOG_FUNCTION (this << bule << retransmit);
+
+  SendMessage (bule->GetPbuPacket ()->Copy (), bule->GetLmaAddress (), 64);
+
+  if (retransmit)
+    {
+      m_retransmitPbuTrace (bule->GetMnIdentifier (), bule->GetLastBindingUpdateSequence ());
+    }
+  else
+    {
+      m_txPbuTrace (bule->GetMnIdentifier (), bule->GetLastBindingUpdateSequence ());
+    }
+}
+
+void Pmipv6Mag::SendBulkPbu (BindingUpdateList::Group *group, bool retransmit)
+{
+  NS_LOG_FUNCTION (this << group << retransmit);
+
+  SendMessage (group->GetPbuPacket ()->Copy (), group->GetLmaAddress (), 64);
+
+  if (retransmit)
+    {
+      m_retransmitPbuTrace (Identifier (), group->GetLastBindingUpdateSequence ());
+    }
+  else
+    {
+      m_txPbuTrace (Identifier (), group->GetLastBindingUpdateSequence ());
+    }
+}
+
+void Pmipv6Mag::HandleRaSent (Ptr<const Packet> packet, uint32_t ifIndex, Address dst)
+{
+  if (!Mac48Address::IsMatchingType (dst))
+    {
+      return;
+    }
+
+  Pmipv6Profile::Entry *pf = GetProfile ()->Lookup (Identifier (Mac48Address::ConvertFrom (dst)));
+
+  if (pf)
+    {
+      m_txRaTrace (pf->GetMnIdentifier ());
+    }
+}
+
 bool Pmipv6Mag::SetupRadvdInterface (BindingUpdateList::Entry *bule)
 {
   NS_LOG_FUNCTION (this << bule);
@@ -25,16 +25,27 @@
 #ifndef PMIPV6_MAG_H
 #define PMIPV6_MAG_H
 
+#include <map>
+
+#include "ns3/event-id.h"
+#include "ns3/traced-callback.h"
+
 #include "pmipv6-agent.h"
 #include "binding-update-list.h"
+#include "pmipv6-mag-notifier.h"
+#include "pmipv6-handover-buffer.h"
 
 namespace ns3
 {
 class UnicastRadvd;
 class Mac48Address;
+class Ipv6MobilityBindingAckHeader;
+class Ipv6MobilityOptionBundle;
 
 class Pmipv6Mag : public Pmipv6Agent {
 public:
+  static TypeId GetTypeId ();
+  
   Pmipv6Mag();
   
   virtual ~Pmipv6Mag();
@@ -42,6 +53,66 @@ public:
   bool IsUseRemoteAP() const;
   void UseRemoteAP(bool remoteAp);
   
+  /**
+   * \brief Register the bindings with the B flag, so that the LMA puts
+   * them in a bulk binding group (RFC 6602) refreshed by a single PBU.
+   */
+  void SetBulkRegistration(bool bulk);
+  bool IsBulkRegistration() const;
+  
+  /**
+   * \brief Lifetime requested for the bindings, in seconds
+   * (MAX_BINDING_LIFETIME by default).
+   */
+  void SetBindingLifetime(uint16_t lifetime);
+  uint16_t GetBindingLifetime() const;
+  
+  /**
+   * \brief De-register all the grouped bindings of an LMA with a single
+   * bulk PBU.
+   * \return false if there is no bulk binding group for the LMA
+   */
+  bool RevokeBindings(Ipv6Address lma);
+  
+  /**
+   * \brief Accept the context of the MNs pushed by previous MAGs
+   * (predictive fast handover, RFC 5949), and serve a prepared MN as soon
+   * as it attaches, without waiting for the PBA.
+   */
+  void SetFastHandover(bool fast);
+  bool IsFastHandover() const;
+  
+  /**
+   * \brief Push the context of a MN about to move to its next MAG with a
+   * Handover Initiate.
+   * \param mn link-layer address of the MN
+   * \param nMag address of the next MAG
+   * \return false if the MN has no registered binding here
+   */
+  bool PrepareHandover(Mac48Address mn, Ipv6Address nMag);
+  
+  /**
+   * \brief Keep the downlink packets of the MNs handing over instead of
+   * dropping them.
+   *
+   * The previous MAG holds the packets of a MN from its detachment and
+   * forwards them through a tunnel to the next MAG which accepted its
+   * handover, the next MAG holds them until the binding is accepted (or
+   * the prepared MN attached) and then delivers them. Both MAGs need the
+   * prefix routing, the next MAG fast handover. The held packets go to
+   * the handover buffer.
+   */
+  void SetHandoverBuffering(bool buffering);
+  bool IsHandoverBuffering() const;
+  
+  Ptr<Pmipv6HandoverBuffer> GetHandoverBuffer() const;
+  
+  /**
+   * \return the number of localized routes (RFC 6705) from the prefixes
+   * of the attached MNs
+   */
+  uint32_t GetNLocalizedRoutes() const;
+  
   uint16_t GetSequence();
   
   bool SetupTunnelAndRouting(BindingUpdateList::Entry *bule);
@@ -51,6 +122,14 @@ public:
   void ClearRadvdInterface(BindingUpdateList::Entry *bule);
   
   Ptr<Packet> BuildPbu(BindingUpdateList::Entry *bule);
+  Ptr<Packet> BuildBulkPbu(BindingUpdateList::Group *group);
+  
+  /**
+   * \brief Send the PBU saved in the binding to its LMA.
+   * \param retransmit whether the PBU was already sent
+   */
+  void SendPbu(BindingUpdateList::Entry *bule, bool retransmit = false);
+  void SendBulkPbu(BindingUpdateList::Group *group, bool retransmit = false);
   
 protected:
   virtual void NotifyNewAggregate();
@@ -59,18 +138,134 @@ protected:
   
   Ptr<UnicastRadvd> GetRadvd() const;
   
+  /**
+   * \return the interface of the access device with address "to", -1 if none
+   */
+  int32_t GetAccessInterface(Mac48Address to);
+  
   virtual void HandleNewNode(Mac48Address from, Mac48Address to, uint8_t att);
+  
+  /**
+   * \brief De-register the binding of a MN which left the access link "to".
+   */
+  virtual void HandleDetachedNode(Mac48Address from, Mac48Address to);
+  
+  /**
+   * \brief Handle the attachments and detachments reported by an access
+   * point in one message, in order.
+   */
+  virtual void HandleNotifications(Mac48Address to, const Pmipv6MagNotifyHeader &notifications);
   virtual uint8_t HandlePba(Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface);
   
+  /**
+   * \brief Handle the reply to a bulk PBU of a group.
+   */
+  uint8_t HandleBulkPba(const Ipv6MobilityBindingAckHeader &pba, const Ipv6MobilityOptionBundle &bundle, const Ipv6Address &src);
+  
+  virtual uint8_t HandleHi(Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface);
+  virtual uint8_t HandleHack(Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface);
+  
+  /**
+   * \brief Route the traffic between the attached MNs and their
+   * correspondents named by the LMA directly, or stop doing so.
+   */
+  virtual uint8_t HandleLri(Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface);
+  
 private:
+  /* context of a MN pushed by its previous MAG, waiting for the MN */
+  struct HandoverContext
+  {
+    std::list<Ipv6Address> hnps;
+    Ipv6Address lma;
+    Time expires;
+  };
+  
+  typedef sgi::hash_map<Identifier, HandoverContext, IdentifierHash> HandoverContexts;
+  
+  void SendHack(const Ipv6Address &dst, uint16_t sequence, const Identifier &mnId, uint8_t code, bool buffering = false);
+  
+  /* prefixes of a MN held during its handover */
+  struct HeldPrefixes
+  {
+    HeldPrefixes ()
+      : forwarding (false)
+    {
+    }
+    
+    std::list<Ipv6Address> hnps;
+    Ipv6Address nMag;           //!< where to forward, any until known
+    bool forwarding;            //!< holding a tunnel to nMag
+    EventId expire;
+  };
+  
+  typedef sgi::hash_map<Identifier, HeldPrefixes, IdentifierHash> HeldPrefixesMap;
+  
+  bool HoldPrefixes(const Identifier &mnId, const std::list<Ipv6Address> &hnps);
+  void ReleasePrefixes(Identifier mnId);
+  void ForwardHeldPackets(const Identifier &mnId);
+  void DeliverHeldPackets(const Identifier &mnId);
+  void HandleHeldPacket(Ptr<Packet> p, const Ipv6Header &header);
+  void ForwardPacket(const Identifier &mnId, Ptr<Packet> p, const Ipv6Header &header);
+  void DeliverPacket(const Identifier &mnId, Ptr<Packet> p, const Ipv6Header &header);
+  
+  /* localized route of a local MN prefix to a correspondent prefix */
+  struct LocalizedRoute
+  {
+    uint32_t interface;
+    Ipv6Address peerMag;        //!< tunnel end-point, any when both MNs are attached here
+  };
+  
+  typedef std::map<std::pair<Ipv6Address, Ipv6Address>, LocalizedRoute> LocalizedRoutes;
+  
+  void SendLra(const Ipv6Address &dst, uint16_t sequence, uint8_t status, uint16_t lifetime);
+  
+  /**
+   * \brief Remove the localized routes from or to the prefixes.
+   */
+  void RemoveLocalizedRoutes(const std::list<Ipv6Address> &hnps);
+  
+  /* link-local address towards each LMA, resolved once per batch */
+  typedef std::map<Ipv6Address, Ipv6Address> LinkLocalCache;
+  
+  void AttachNode(Mac48Address from, int32_t ifIndex, uint8_t att, LinkLocalCache &llas);
+  void DetachNode(Mac48Address from, int32_t ifIndex);
+  
+  void HandleRaSent(Ptr<const Packet> packet, uint32_t ifIndex, Address dst);
+  
+  /**
+   * \brief Register a MN with the LMA a PBA redirected it to (RFC 6463).
+   */
+  void RedirectBinding(BindingUpdateList::Entry *bule, Ipv6Address lma);
   
   bool m_useRemoteAp;
   
+  bool m_bulkRegistration;
+  uint16_t m_bindingLifetime;
+  
+  bool m_fastHandover;
+  HandoverContexts m_handoverContexts;
+  
+  bool m_handoverBuffering;
+  Ptr<Pmipv6HandoverBuffer> m_handoverBuffer;
+  HeldPrefixesMap m_heldPrefixes;
+  
+  LocalizedRoutes m_localizedRoutes;
+  
   uint16_t m_sequence;
   
   Ptr<BindingUpdateList> m_buList;
   
   Ptr<UnicastRadvd> m_radvd;
+  
+  /* handover stages, by MN identifier; empty for bulk messages */
+  TracedCallback<const Identifier &, Mac48Address> m_attachTrace;
+  TracedCallback<const Identifier &, Mac48Address> m_detachTrace;
+  TracedCallback<const Identifier &, uint16_t> m_txPbuTrace;
+  TracedCallback<const Identifier &, uint16_t> m_retransmitPbuTrace;
+  TracedCallback<const Identifier &, uint8_t> m_rxPbaTrace;
+  TracedCallback<const Identifier &, uint32_t> m_tunnelUpTrace;
+  TracedCallback<const Identifier &> m_txRaTrace;
+  TracedCallback<const Identifier &, Ipv6Address> m_redirectTrace;
 };
 
 } /* namespace ns3 */
@@ -22,46 +22,250 @@
  * Author: Hyon-Young Choi <commani@gmail.com>
  */
  
- #include "ns3/log.h"
- #include "pmipv6-prefix-pool.h"
- 
- NS_LOG_COMPONENT_DEFINE( "Pmipv6PrefixPool" );
- 
- namespace ns3 
- {
- 
- Pmipv6PrefixPool::Pmipv6PrefixPool(Ipv6Address prefixBegin, uint8_t prefixLen)
-  : m_prefixBegin(prefixBegin),
-    m_prefixBeginLen(prefixLen),
-	m_lastPrefixIndex(0)
- {
-   NS_LOG_FUNCTION ( this << prefixBegin << (uint32_t) prefixLen);
-   
-   NS_ASSERT ( prefixLen < 64 );
- }
- 
- Ipv6Address Pmipv6PrefixPool::Assign()
- {
-   NS_LOG_FUNCTION_NOARGS();
-   
-   uint8_t buf[16];
-   Ipv6Address addr;
-   int len;
-   
-   m_prefixBegin.Serialize(buf);
-   
-   len = 8 - m_prefixBeginLen/8;
-   
-   m_lastPrefixIndex++;
-   
-   for ( int i = 0; i < len; i++ )
-     {
-	   buf[7-i] = (uint8_t)((m_lastPrefixIndex >> (i * 8)) & 0xff);
-	 }
-   
-   addr.Set(buf);
-   
-   return addr;
- }
- 
- }
\ No newline at end of file
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/simulator.h"
+#include "pmipv6-prefix-pool.h"
+
+NS_LOG_COMPONENT_DEFINE ("Pmipv6PrefixPool");
+
+namespace ns3
+{
+
+Pmipv6PrefixPool::Pmipv6PrefixPool(Ipv6Address prefixBegin, uint8_t prefixLen)
+  : m_prefixBegin (prefixBegin),
+    m_prefixBeginLen (prefixLen),
+    m_lastPrefixIndex (0),
+    m_nAssigned (0),
+    m_quarantineTime (Seconds (0.0))
+{
+  NS_LOG_FUNCTION (this << prefixBegin << (uint32_t) prefixLen);
+  
+  NS_ASSERT (prefixLen < 64);
+  
+  uint8_t buf[16];
+  uint64_t mask = (prefixLen == 0) ? 0 : ~(uint64_t)0 << (64 - prefixLen);
+  
+  m_prefixBegin.Serialize (buf);
+  
+  m_base = 0;
+  for (int i = 0; i < 8; i++)
+    {
+      m_base = (m_base << 8) | buf[i];
+    }
+  m_base &= mask;
+  
+  //index 0 is the pool prefix itself and never assigned
+  m_size = ~mask;
+}
+
+size_t Pmipv6PrefixPool::IndexHash::operator() (uint64_t x) const
+{
+  return (size_t)(x ^ (x >> 32));
+}
+
+bool Pmipv6PrefixPool::GetIndex(Ipv6Address prefix, uint64_t &index) const
+{
+  uint8_t buf[16];
+  uint64_t upper = 0;
+  
+  prefix.Serialize (buf);
+  
+  for (int i = 0; i < 8; i++)
+    {
+      upper = (upper << 8) | buf[i];
+    }
+  
+  if ((upper & ~m_size) != m_base)
+    {
+      return false;
+    }
+  
+  index = upper & m_size;
+  
+  return index != 0;
+}
+
+Ipv6Address Pmipv6PrefixPool::GetPrefix(uint64_t index) const
+{
+  uint8_t buf[16];
+  uint64_t upper = m_base | index;
+  
+  for (int i = 0; i < 8; i++)
+    {
+      buf[7 - i] = (uint8_t)((upper >> (i * 8)) & 0xff);
+      buf[15 - i] = 0;
+    }
+  
+  return Ipv6Address (buf);
+}
+
+bool Pmipv6PrefixPool::TestBit(uint64_t index) const
+{
+  Bitmap::const_iterator it = m_assigned.find (index >> 6);
+  
+  return it != m_assigned.end () && (it->second & ((uint64_t)1 << (index & 63)));
+}
+
+void Pmipv6PrefixPool::SetBit(uint64_t index)
+{
+  m_assigned[index >> 6] |= (uint64_t)1 << (index & 63);
+  m_nAssigned++;
+}
+
+void Pmipv6PrefixPool::ClearBit(uint64_t index)
+{
+  Bitmap::iterator it = m_assigned.find (index >> 6);
+  
+  NS_ASSERT (it != m_assigned.end ());
+  
+  it->second &= ~((uint64_t)1 << (index & 63));
+  if (it->second == 0)
+    {
+      m_assigned.erase (it);
+    }
+  m_nAssigned--;
+}
+
+void Pmipv6PrefixPool::ExpireQuarantine()
+{
+  Time now = Simulator::Now ();
+  
+  while (!m_quarantineQueue.empty () && m_quarantineQueue.front ().first <= now)
+    {
+      uint64_t index = m_quarantineQueue.front ().second;
+      Quarantine::iterator it = m_quarantine.find (index);
+      
+      //skip entries reserved back or released again since
+      if (it != m_quarantine.end () && it->second == m_quarantineQueue.front ().first)
+        {
+          m_quarantine.erase (it);
+          m_freeList.push_back (index);
+        }
+      m_quarantineQueue.pop_front ();
+    }
+}
+
+Ipv6Address Pmipv6PrefixPool::Assign()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  ExpireQuarantine ();
+  
+  while (!m_freeList.empty ())
+    {
+      uint64_t index = m_freeList.front ();
+      
+      m_freeList.pop_front ();
+      
+      if (!TestBit (index) && m_quarantine.find (index) == m_quarantine.end ())
+        {
+          SetBit (index);
+          
+          return GetPrefix (index);
+        }
+    }
+  
+  while (m_lastPrefixIndex < m_size)
+    {
+      uint64_t index = ++m_lastPrefixIndex;
+      
+      //may have been reserved ahead of the high-water mark
+      if (!TestBit (index) && m_quarantine.find (index) == m_quarantine.end ())
+        {
+          SetBit (index);
+          
+          return GetPrefix (index);
+        }
+    }
+  
+  NS_LOG_WARN ("Prefix pool " << m_prefixBegin << "/" << (uint32_t)m_prefixBeginLen << " exhausted");
+  
+  return Ipv6Address::GetAny ();
+}
+
+bool Pmipv6PrefixPool::Reserve(Ipv6Address prefix)
+{
+  NS_LOG_FUNCTION (this << prefix);
+  
+  uint64_t index;
+  
+  if (!GetIndex (prefix, index) || TestBit (index))
+    {
+      return false;
+    }
+  
+  m_quarantine.erase (index);
+  SetBit (index);
+  
+  return true;
+}
+
+bool Pmipv6PrefixPool::Release(Ipv6Address prefix)
+{
+  NS_LOG_FUNCTION (this << prefix);
+  
+  uint64_t index;
+  
+  if (!GetIndex (prefix, index) || !TestBit (index))
+    {
+      return false;
+    }
+  
+  ClearBit (index);
+  
+  if (m_quarantineTime.IsZero ())
+    {
+      m_freeList.push_back (index);
+    }
+  else
+    {
+      Time expiry = Simulator::Now () + m_quarantineTime;
+      
+      m_quarantine[index] = expiry;
+      m_quarantineQueue.push_back (std::make_pair (expiry, index));
+    }
+  
+  return true;
+}
+
+bool Pmipv6PrefixPool::Contains(Ipv6Address prefix) const
+{
+  uint64_t index;
+  
+  return GetIndex (prefix, index);
+}
+
+bool Pmipv6PrefixPool::IsAssigned(Ipv6Address prefix) const
+{
+  uint64_t index;
+  
+  return GetIndex (prefix, index) && TestBit (index);
+}
+
+void Pmipv6PrefixPool::SetQuarantine(Time quarantine)
+{
+  m_quarantineTime = quarantine;
+}
+
+Time Pmipv6PrefixPool::GetQuarantine() const
+{
+  return m_quarantineTime;
+}
+
+uint64_t Pmipv6PrefixPool::GetSize() const
+{
+  return m_size;
+}
+
+uint64_t Pmipv6PrefixPool::GetNAssigned() const
+{
+  return m_nAssigned;
+}
+
+uint64_t Pmipv6PrefixPool::GetNQuarantined() const
+{
+  return m_quarantine.size ();
+}
+
+} /* namespace ns3 */
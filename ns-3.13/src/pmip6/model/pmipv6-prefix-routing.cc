@@ -0,0 +1,382 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/packet.h"
+#include "ns3/ipv6-route.h"
+#include "ns3/net-device.h"
+#include "ns3/socket.h"
+
+#include "pmipv6-prefix-routing.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE ("Pmipv6PrefixRouting");
+
+NS_OBJECT_ENSURE_REGISTERED (Pmipv6PrefixRouting);
+
+TypeId Pmipv6PrefixRouting::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Pmipv6PrefixRouting")
+    .SetParent<Ipv6RoutingProtocol> ()
+    .AddConstructor<Pmipv6PrefixRouting> ()
+    ;
+  return tid;
+}
+
+Pmipv6PrefixRouting::Pmipv6PrefixRouting ()
+  : m_nHeld (0),
+    m_generation (0),
+    m_ipv6 (0)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+Pmipv6PrefixRouting::~Pmipv6PrefixRouting ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+void Pmipv6PrefixRouting::SetIpv6 (Ptr<Ipv6> ipv6)
+{
+  NS_LOG_FUNCTION (this << ipv6);
+  NS_ASSERT (m_ipv6 == 0 && ipv6 != 0);
+
+  m_ipv6 = ipv6;
+}
+
+void Pmipv6PrefixRouting::DoDispose ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  m_prefixRoutes.clear ();
+  m_nHeld = 0;
+  m_holdCallback = MakeNullCallback<void, Ptr<Packet>, const Ipv6Header &> ();
+  m_ipv6 = 0;
+  Ipv6RoutingProtocol::DoDispose ();
+}
+
+size_t Pmipv6PrefixRouting::PrefixKeyHash::operator () (uint64_t x) const
+{
+  return (size_t)(x ^ (x >> 32));
+}
+
+uint64_t Pmipv6PrefixRouting::GetKey (Ipv6Address addr)
+{
+  uint8_t buf[16];
+  uint64_t key = 0;
+
+  addr.GetBytes (buf);
+
+  for (uint32_t i = 0; i < 8; i++)
+    {
+      key = (key << 8) | buf[i];
+    }
+
+  return key;
+}
+
+void Pmipv6PrefixRouting::AddPrefixRoute (Ipv6Address hnp, uint32_t interface, Ipv6Address nextHop)
+{
+  NS_LOG_FUNCTION (this << hnp << interface << nextHop);
+
+  std::pair<PrefixRoutesI, bool> inserted = m_prefixRoutes.insert (std::make_pair (GetKey (hnp), PrefixRoute ()));
+  PrefixRoute &entry = inserted.first->second;
+
+  if (!inserted.second && entry.interface == HOLD_INTERFACE)
+    {
+      m_nHeld--;
+    }
+
+  entry.interface = interface;
+  entry.network = hnp.CombinePrefix (Ipv6Prefix (64));
+  entry.nextHop = nextHop;
+  entry.route = 0;
+  entry.generation = m_generation;
+}
+
+bool Pmipv6PrefixRouting::RemovePrefixRoute (Ipv6Address hnp, uint32_t interface)
+{
+  NS_LOG_FUNCTION (this << hnp << interface);
+
+  PrefixRoutesI it = m_prefixRoutes.find (GetKey (hnp));
+
+  if (it == m_prefixRoutes.end () || it->second.interface != interface)
+    {
+      NS_LOG_LOGIC ("No route for " << hnp << " via " << interface);
+      return false;
+    }
+
+  m_prefixRoutes.erase (it);
+
+  return true;
+}
+
+void Pmipv6PrefixRouting::AddHoldRoute (Ipv6Address hnp)
+{
+  NS_LOG_FUNCTION (this << hnp);
+
+  std::pair<PrefixRoutesI, bool> inserted = m_prefixRoutes.insert (std::make_pair (GetKey (hnp), PrefixRoute ()));
+  PrefixRoute &entry = inserted.first->second;
+
+  if (inserted.second || entry.interface != HOLD_INTERFACE)
+    {
+      m_nHeld++;
+    }
+
+  entry.interface = HOLD_INTERFACE;
+  entry.network = hnp.CombinePrefix (Ipv6Prefix (64));
+  entry.nextHop = Ipv6Address::GetZero ();
+  entry.route = 0;
+  entry.generation = m_generation;
+}
+
+bool Pmipv6PrefixRouting::RemoveHoldRoute (Ipv6Address hnp)
+{
+  NS_LOG_FUNCTION (this << hnp);
+
+  if (!RemovePrefixRoute (hnp, HOLD_INTERFACE))
+    {
+      return false;
+    }
+
+  m_nHeld--;
+
+  return true;
+}
+
+void Pmipv6PrefixRouting::SetHoldCallback (HoldCallback cb)
+{
+  m_holdCallback = cb;
+}
+
+bool Pmipv6PrefixRouting::IsHeld (Ipv6Address dst) const
+{
+  if (m_nHeld == 0)
+    {
+      return false;
+    }
+
+  PrefixRoutesCI it = m_prefixRoutes.find (GetKey (dst));
+
+  return it != m_prefixRoutes.end () && it->second.interface == HOLD_INTERFACE;
+}
+
+bool Pmipv6PrefixRouting::Hold (Ptr<Packet> p, const Ipv6Header &header)
+{
+  NS_LOG_FUNCTION (this << p << header.GetDestinationAddress ());
+
+  if (!IsHeld (header.GetDestinationAddress ()))
+    {
+      return false;
+    }
+
+  if (!m_holdCallback.IsNull ())
+    {
+      m_holdCallback (p, header);
+    }
+
+  return true;
+}
+
+int32_t Pmipv6PrefixRouting::LookupPrefix (Ipv6Address hnp) const
+{
+  PrefixRoutesCI it = m_prefixRoutes.find (GetKey (hnp));
+
+  if (it == m_prefixRoutes.end () || it->second.interface == HOLD_INTERFACE)
+    {
+      return -1;
+    }
+
+  return it->second.interface;
+}
+
+uint32_t Pmipv6PrefixRouting::GetNRoutes () const
+{
+  return m_prefixRoutes.size () - m_nHeld;
+}
+
+Ptr<Ipv6Route> Pmipv6PrefixRouting::LookupPrefixRoute (Ipv6Address dst, Ptr<NetDevice> interface)
+{
+  NS_LOG_FUNCTION (this << dst << interface);
+
+  if (dst.IsMulticast () || dst.IsLinkLocal ())
+    {
+      return 0;
+    }
+
+  PrefixRoutesI it = m_prefixRoutes.find (GetKey (dst));
+
+  if (it == m_prefixRoutes.end ())
+    {
+      return 0;
+    }
+
+  PrefixRoute &entry = it->second;
+
+  if (entry.interface == HOLD_INTERFACE)
+    {
+      return 0;
+    }
+
+  /* if interface is given, check the route will output on this interface */
+  if (interface && interface != m_ipv6->GetNetDevice (entry.interface))
+    {
+      return 0;
+    }
+
+  if (entry.route == 0 || entry.generation != m_generation)
+    {
+      Ptr<Ipv6Route> rtentry = Create<Ipv6Route> ();
+
+      rtentry->SetSource (SourceAddressSelection (entry.interface, entry.nextHop.IsAny () ? entry.network : entry.nextHop));
+      rtentry->SetDestination (entry.network);
+      rtentry->SetGateway (entry.nextHop);
+      rtentry->SetOutputDevice (m_ipv6->GetNetDevice (entry.interface));
+
+      entry.route = rtentry;
+      entry.generation = m_generation;
+    }
+
+  NS_LOG_LOGIC ("Matching route via " << entry.network << "/64 (through " << entry.nextHop << ") if " << entry.interface);
+
+  return entry.route;
+}
+
+Ipv6Address Pmipv6PrefixRouting::SourceAddressSelection (uint32_t interface, Ipv6Address dest)
+{
+  NS_LOG_FUNCTION (this << interface << dest);
+
+  /* first address of an IPv6 interface is link-local ones */
+  Ipv6Address ret = m_ipv6->GetAddress (interface, 0).GetAddress ();
+
+  for (uint32_t i = 1; i < m_ipv6->GetNAddresses (interface); i++)
+    {
+      Ipv6InterfaceAddress test = m_ipv6->GetAddress (interface, i);
+
+      if (test.GetAddress ().CombinePrefix (test.GetPrefix ()) == dest.CombinePrefix (test.GetPrefix ()))
+        {
+          return test.GetAddress ();
+        }
+    }
+
+  return ret;
+}
+
+Ptr<Ipv6Route> Pmipv6PrefixRouting::RouteOutput (Ptr<Packet> p, const Ipv6Header &header, Ptr<NetDevice> oif, Socket::SocketErrno &sockerr)
+{
+  NS_LOG_FUNCTION (this << header << oif);
+
+  Ptr<Ipv6Route> rtentry = LookupPrefixRoute (header.GetDestinationAddress (), oif);
+
+  if (rtentry)
+    {
+      sockerr = Socket::ERROR_NOTERROR;
+    }
+  else
+    {
+      sockerr = Socket::ERROR_NOROUTETOHOST;
+    }
+  return rtentry;
+}
+
+bool Pmipv6PrefixRouting::RouteInput (Ptr<const Packet> p, const Ipv6Header &header, Ptr<const NetDevice> idev,
+                                      UnicastForwardCallback ucb, MulticastForwardCallback mcb,
+                                      LocalDeliverCallback lcb, ErrorCallback ecb)
+{
+  NS_LOG_FUNCTION (this << p << header.GetSourceAddress () << header.GetDestinationAddress () << idev);
+  NS_ASSERT (m_ipv6 != 0);
+
+  Ptr<Ipv6Route> rtentry = LookupPrefixRoute (header.GetDestinationAddress (), 0);
+
+  if (rtentry != 0)
+    {
+      NS_LOG_LOGIC ("Found home network prefix - calling unicast callback");
+      ucb (rtentry, p, header);  // unicast forwarding callback
+      return true;
+    }
+
+  if (IsHeld (header.GetDestinationAddress ()))
+    {
+      NS_LOG_LOGIC ("Held home network prefix - calling hold callback");
+
+      Ptr<Packet> packet = p->Copy ();
+      SocketIpTtlTag tag;
+
+      tag.SetTtl (header.GetHopLimit () - 1);
+      packet->AddPacketTag (tag);
+
+      return Hold (packet, header);
+    }
+
+  NS_LOG_LOGIC ("Not a home network prefix - returning false");
+  return false; // Let other routing protocols try to handle this
+}
+
+void Pmipv6PrefixRouting::NotifyInterfaceUp (uint32_t i)
+{
+  NS_LOG_FUNCTION (this << i);
+}
+
+void Pmipv6PrefixRouting::NotifyInterfaceDown (uint32_t i)
+{
+  NS_LOG_FUNCTION (this << i);
+
+  /* remove all prefix routes that are going through this interface */
+  for (PrefixRoutesI it = m_prefixRoutes.begin (); it != m_prefixRoutes.end (); )
+    {
+      if (it->second.interface == i)
+        {
+          m_prefixRoutes.erase (it++);
+        }
+      else
+        {
+          it++;
+        }
+    }
+}
+
+void Pmipv6PrefixRouting::NotifyAddAddress (uint32_t interface, Ipv6InterfaceAddress address)
+{
+  NS_LOG_FUNCTION (this << interface << address);
+  m_generation++;
+}
+
+void Pmipv6PrefixRouting::NotifyRemoveAddress (uint32_t interface, Ipv6InterfaceAddress address)
+{
+  NS_LOG_FUNCTION (this << interface << address);
+  m_generation++;
+}
+
+void Pmipv6PrefixRouting::NotifyAddRoute (Ipv6Address dst, Ipv6Prefix mask, Ipv6Address nextHop, uint32_t interface, Ipv6Address prefixToUse)
+{
+  NS_LOG_FUNCTION (this << dst << mask << nextHop << interface << prefixToUse);
+}
+
+void Pmipv6PrefixRouting::NotifyRemoveRoute (Ipv6Address dst, Ipv6Prefix mask, Ipv6Address nextHop, uint32_t interface, Ipv6Address prefixToUse)
+{
+  NS_LOG_FUNCTION (this << dst << mask << nextHop << interface);
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,381 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/simulator.h"
+#include "ns3/trace-source-accessor.h"
+
+#include "ipv6-mobility-header.h"
+#include "pmipv6-processor.h"
+
+NS_LOG_COMPONENT_DEFINE ("Pmipv6Processor");
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED (Pmipv6Processor);
+
+TypeId Pmipv6Processor::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::Pmipv6Processor")
+    .SetParent<Object> ()
+    .AddConstructor<Pmipv6Processor> ()
+    .AddTraceSource ("QueueLength",
+                     "Number of mobility messages waiting for a server.",
+                     MakeTraceSourceAccessor (&Pmipv6Processor::m_queueLength))
+    .AddTraceSource ("Dropped",
+                     "A mobility message was dropped from a full queue.",
+                     MakeTraceSourceAccessor (&Pmipv6Processor::m_droppedTrace))
+    .AddTraceSource ("Processed",
+                     "A mobility message was served, with its sojourn time.",
+                     MakeTraceSourceAccessor (&Pmipv6Processor::m_processedTrace))
+    ;
+  return tid;
+}
+
+Pmipv6Processor::Statistics::Statistics ()
+  : received (0),
+    processed (0),
+    dropped (0),
+    maxQueueLength (0),
+    avgQueueLength (0.0),
+    avgSojournTime (Seconds (0.0)),
+    maxSojournTime (Seconds (0.0))
+{
+}
+
+Pmipv6Processor::Pmipv6Processor ()
+  : m_nServers (1),
+    m_maxQueueLength (1000),
+    m_defaultServiceTime (Seconds (0.0)),
+    m_dropPolicy (DROP_TAIL),
+    m_priorityPolicy (FIFO),
+    m_nBusy (0),
+    m_queueLength (0)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  ResetStatistics ();
+}
+
+Pmipv6Processor::~Pmipv6Processor ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+void Pmipv6Processor::DoDispose ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  for (uint32_t i = 0; i < N_CLASSES; i++)
+    {
+      m_queues[i].clear ();
+    }
+  m_serviceTimes.clear ();
+  m_process = MakeNullCallback<uint8_t, Ptr<Packet>, const Ipv6Address &, const Ipv6Address &, Ptr<Ipv6Interface> > ();
+  Object::DoDispose ();
+}
+
+void Pmipv6Processor::SetProcessCallback (ProcessCallback cb)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_process = cb;
+}
+
+void Pmipv6Processor::SetNServers (uint32_t nServers)
+{
+  NS_LOG_FUNCTION (this << nServers);
+  NS_ASSERT (nServers > 0);
+  m_nServers = nServers;
+}
+
+uint32_t Pmipv6Processor::GetNServers () const
+{
+  return m_nServers;
+}
+
+void Pmipv6Processor::SetMaxQueueLength (uint32_t maxQueueLength)
+{
+  NS_LOG_FUNCTION (this << maxQueueLength);
+  m_maxQueueLength = maxQueueLength;
+}
+
+uint32_t Pmipv6Processor::GetMaxQueueLength () const
+{
+  return m_maxQueueLength;
+}
+
+void Pmipv6Processor::SetDefaultServiceTime (Time serviceTime)
+{
+  NS_LOG_FUNCTION (this << serviceTime);
+  m_defaultServiceTime = serviceTime;
+}
+
+void Pmipv6Processor::SetServiceTime (uint8_t mhType, Time serviceTime)
+{
+  NS_LOG_FUNCTION (this << (uint32_t) mhType << serviceTime);
+  m_serviceTimes[mhType] = serviceTime;
+}
+
+Time Pmipv6Processor::GetServiceTime (uint8_t mhType) const
+{
+  std::map<uint8_t, Time>::const_iterator it = m_serviceTimes.find (mhType);
+
+  if (it == m_serviceTimes.end ())
+    {
+      return m_defaultServiceTime;
+    }
+
+  return it->second;
+}
+
+void Pmipv6Processor::SetDropPolicy (enum DropPolicy_e policy)
+{
+  NS_LOG_FUNCTION (this << policy);
+  m_dropPolicy = policy;
+}
+
+enum Pmipv6Processor::DropPolicy_e Pmipv6Processor::GetDropPolicy () const
+{
+  return m_dropPolicy;
+}
+
+void Pmipv6Processor::SetPriorityPolicy (enum PriorityPolicy_e policy)
+{
+  NS_LOG_FUNCTION (this << policy);
+  m_priorityPolicy = policy;
+}
+
+enum Pmipv6Processor::PriorityPolicy_e Pmipv6Processor::GetPriorityPolicy () const
+{
+  return m_priorityPolicy;
+}
+
+uint32_t Pmipv6Processor::GetQueueLength () const
+{
+  return m_queueLength;
+}
+
+uint32_t Pmipv6Processor::GetNBusy () const
+{
+  return m_nBusy;
+}
+
+bool Pmipv6Processor::Receive (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface)
+{
+  NS_LOG_FUNCTION (this << packet << src << dst << interface);
+
+  Ipv6MobilityHeader mh;
+  packet->PeekHeader (mh);
+
+  Message message;
+  message.packet = packet;
+  message.src = src;
+  message.dst = dst;
+  message.interface = interface;
+  message.mhType = mh.GetMhType ();
+  message.arrival = Simulator::Now ();
+
+  m_received++;
+
+  if (m_nBusy < m_nServers)
+    {
+      Serve (message);
+      return true;
+    }
+
+  uint32_t cls = Classify (message);
+
+  if (m_queueLength >= m_maxQueueLength)
+    {
+      //a deregistration takes the place of the newest other message
+      if (cls == CLASS_HIGH && !m_queues[CLASS_NORMAL].empty ())
+        {
+          Drop (m_queues[CLASS_NORMAL].back ());
+          m_queues[CLASS_NORMAL].pop_back ();
+          UpdateQueueLength (-1);
+        }
+      else
+        {
+          //the oldest message of the lowest class, never one of a
+          //higher class than the incoming one
+          uint32_t victim = N_CLASSES;
+
+          if (m_dropPolicy == DROP_HEAD)
+            {
+              for (uint32_t i = N_CLASSES; i > cls; i--)
+                {
+                  if (!m_queues[i - 1].empty ())
+                    {
+                      victim = i - 1;
+                      break;
+                    }
+                }
+            }
+
+          if (victim == N_CLASSES)
+            {
+              Drop (message);
+              return false;
+            }
+
+          Drop (m_queues[victim].front ());
+          m_queues[victim].pop_front ();
+          UpdateQueueLength (-1);
+        }
+    }
+
+  m_queues[cls].push_back (message);
+  UpdateQueueLength (1);
+
+  return true;
+}
+
+uint32_t Pmipv6Processor::Classify (const Message &message) const
+{
+  if (m_priorityPolicy != DEREGISTRATIONS_FIRST
+      || message.mhType != Ipv6MobilityHeader::IPV6_MOBILITY_BINDING_UPDATE)
+    {
+      return CLASS_NORMAL;
+    }
+
+  Ipv6MobilityBindingUpdateHeader bu;
+  message.packet->PeekHeader (bu);
+
+  return bu.GetLifetime () == 0 ? CLASS_HIGH : CLASS_NORMAL;
+}
+
+void Pmipv6Processor::Serve (const Message &message)
+{
+  NS_LOG_FUNCTION (this << message.packet);
+
+  m_nBusy++;
+  Simulator::Schedule (GetServiceTime (message.mhType), &Pmipv6Processor::Complete, this, message);
+}
+
+void Pmipv6Processor::Complete (Message message)
+{
+  NS_LOG_FUNCTION (this << message.packet);
+
+  NS_ASSERT (m_nBusy > 0);
+  m_nBusy--;
+
+  Time sojourn = Simulator::Now () - message.arrival;
+
+  m_processed++;
+  m_sojournTotal += sojourn;
+  if (sojourn > m_sojournMax)
+    {
+      m_sojournMax = sojourn;
+    }
+  m_processedTrace (message.packet, sojourn);
+
+  if (!m_process.IsNull ())
+    {
+      m_process (message.packet, message.src, message.dst, message.interface);
+    }
+
+  //the handler may have queued more work, serve the next waiting message
+  for (uint32_t i = 0; i < N_CLASSES && m_nBusy < m_nServers; i++)
+    {
+      if (!m_queues[i].empty ())
+        {
+          Message next = m_queues[i].front ();
+          m_queues[i].pop_front ();
+          UpdateQueueLength (-1);
+          Serve (next);
+          break;
+        }
+    }
+}
+
+void Pmipv6Processor::Drop (const Message &message)
+{
+  NS_LOG_FUNCTION (this << message.packet);
+
+  NS_LOG_LOGIC ("Processor queue full, drop mobility message (type " << (uint32_t) message.mhType << ")");
+
+  m_dropped++;
+  m_droppedTrace (message.packet);
+}
+
+void Pmipv6Processor::UpdateQueueLength (int32_t delta)
+{
+  Time now = Simulator::Now ();
+
+  m_queueArea += m_queueLength.Get () * (now - m_lastChange).GetSeconds ();
+  m_lastChange = now;
+
+  m_queueLength = m_queueLength.Get () + delta;
+  if (m_queueLength > m_maxQueueLengthSeen)
+    {
+      m_maxQueueLengthSeen = m_queueLength;
+    }
+}
+
+Pmipv6Processor::Statistics Pmipv6Processor::GetStatistics () const
+{
+  Statistics stats;
+  Time now = Simulator::Now ();
+
+  stats.received = m_received;
+  stats.processed = m_processed;
+  stats.dropped = m_dropped;
+  stats.maxQueueLength = m_maxQueueLengthSeen;
+
+  double elapsed = (now - m_statsStart).GetSeconds ();
+  if (elapsed > 0)
+    {
+      double area = m_queueArea + m_queueLength.Get () * (now - m_lastChange).GetSeconds ();
+      stats.avgQueueLength = area / elapsed;
+    }
+  else
+    {
+      stats.avgQueueLength = m_queueLength;
+    }
+
+  if (m_processed > 0)
+    {
+      stats.avgSojournTime = NanoSeconds (m_sojournTotal.GetNanoSeconds () / (int64_t) m_processed);
+    }
+  stats.maxSojournTime = m_sojournMax;
+
+  return stats;
+}
+
+void Pmipv6Processor::ResetStatistics ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  m_received = 0;
+  m_processed = 0;
+  m_dropped = 0;
+  m_maxQueueLengthSeen = m_queueLength;
+  m_queueArea = 0.0;
+  m_lastChange = Simulator::Now ();
+  m_statsStart = m_lastChange;
+  m_sojournTotal = Seconds (0.0);
+  m_sojournMax = Seconds (0.0);
+}
+
+} /* namespace ns3 */
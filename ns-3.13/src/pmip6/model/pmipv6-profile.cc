@@ -26,6 +26,7 @@
 #include "ns3/uinteger.h"
 #include "ns3/node.h"
 
+#include "pmipv6-lma-pool.h"
 #include "pmipv6-profile.h"
 
 NS_LOG_COMPONENT_DEFINE ("Pmipv6Profile");
@@ -59,9 +60,22 @@ void Pmipv6Profile::DoDispose ()
 {
   NS_LOG_FUNCTION_NOARGS ();
   Flush ();
+  m_lmaPool = 0;
   Object::DoDispose ();
 }
 
+void Pmipv6Profile::SetLmaPool (Ptr<Pmipv6LmaPool> pool)
+{
+  NS_LOG_FUNCTION (this << pool);
+  
+  m_lmaPool = pool;
+}
+
+Ptr<Pmipv6LmaPool> Pmipv6Profile::GetLmaPool () const
+{
+  return m_lmaPool;
+}
+
 Pmipv6Profile::Entry* Pmipv6Profile::Lookup (Identifier id)
 {
   NS_LOG_FUNCTION (this << id);
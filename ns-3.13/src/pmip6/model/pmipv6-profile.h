@@ -41,6 +41,8 @@
 namespace ns3
 {
 
+class Pmipv6LmaPool;
+
 class Pmipv6Profile : public Object
 {
 public:
@@ -61,6 +63,12 @@ public:
   
   void Flush();
   
+  /**
+   * \brief Set the LMAs of the mobile nodes whose profile has no LMA address.
+   */
+  void SetLmaPool(Ptr<Pmipv6LmaPool> pool);
+  Ptr<Pmipv6LmaPool> GetLmaPool() const;
+  
   class Entry
   {
   public:
@@ -98,6 +106,8 @@ private:
   void DoDispose();
   
   ProfileList m_profileList;
+  
+  Ptr<Pmipv6LmaPool> m_lmaPool;
 
 };
 
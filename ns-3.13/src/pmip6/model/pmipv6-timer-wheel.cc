@@ -0,0 +1,416 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/simulator.h"
+
+#include "pmipv6-timer-wheel.h"
+
+NS_LOG_COMPONENT_DEFINE ("Pmipv6TimerWheel");
+
+namespace ns3
+{
+
+Pmipv6Timer::Pmipv6Timer ()
+  : m_delay (Seconds (0)),
+    m_expires (0),
+    m_seq (0),
+    m_next (0),
+    m_pprev (0)
+{
+}
+
+Pmipv6Timer::~Pmipv6Timer ()
+{
+  Cancel ();
+}
+
+void Pmipv6Timer::SetDelay (const Time &delay)
+{
+  m_delay = delay;
+}
+
+Time Pmipv6Timer::GetDelay () const
+{
+  return m_delay;
+}
+
+void Pmipv6Timer::Schedule ()
+{
+  Schedule (m_delay);
+}
+
+void Pmipv6Timer::Schedule (const Time &delay)
+{
+  NS_ASSERT (!m_callback.IsNull ());
+
+  Pmipv6TimerWheel *wheel = Pmipv6TimerWheel::Get ();
+
+  if (IsRunning ())
+    {
+      wheel->Remove (this);
+    }
+  wheel->Add (this, delay);
+}
+
+void Pmipv6Timer::Cancel ()
+{
+  if (IsRunning ())
+    {
+      Pmipv6TimerWheel::Get ()->Remove (this);
+    }
+}
+
+bool Pmipv6Timer::IsRunning () const
+{
+  return m_pprev != 0;
+}
+
+Time Pmipv6Timer::GetDelayLeft () const
+{
+  if (!IsRunning ())
+    {
+      return Seconds (0);
+    }
+  return Pmipv6TimerWheel::Get ()->GetExpirationTime (this) - Simulator::Now ();
+}
+
+Pmipv6TimerWheel::Pmipv6TimerWheel ()
+  : m_resolution (MilliSeconds (10).GetTimeStep ()),
+    m_now (0),
+    m_nTimers (0),
+    m_nEvents (0),
+    m_seq (0),
+    m_expired (0),
+    m_eventTick (0),
+    m_destroyHooked (false)
+{
+  for (uint32_t i = 0; i < ROOT_SIZE; i++)
+    {
+      m_root[i] = 0;
+    }
+  for (uint32_t l = 0; l < N_LEVELS; l++)
+    {
+      for (uint32_t i = 0; i < LEVEL_SIZE; i++)
+        {
+          m_levels[l][i] = 0;
+        }
+    }
+}
+
+Pmipv6TimerWheel *Pmipv6TimerWheel::Get ()
+{
+  static Pmipv6TimerWheel wheel;
+
+  return &wheel;
+}
+
+void Pmipv6TimerWheel::SetResolution (Time resolution)
+{
+  Pmipv6TimerWheel *wheel = Get ();
+
+  NS_ASSERT_MSG (wheel->m_nTimers == 0, "Resolution changed while timers are running");
+  NS_ASSERT (resolution.GetTimeStep () > 0);
+
+  wheel->m_resolution = resolution.GetTimeStep ();
+}
+
+Time Pmipv6TimerWheel::GetResolution ()
+{
+  return TimeStep (Get ()->m_resolution);
+}
+
+uint32_t Pmipv6TimerWheel::GetNTimers ()
+{
+  return Get ()->m_nTimers;
+}
+
+uint64_t Pmipv6TimerWheel::GetNEvents ()
+{
+  return Get ()->m_nEvents;
+}
+
+void Pmipv6TimerWheel::Link (Pmipv6Timer *timer, Pmipv6Timer **head)
+{
+  timer->m_next = *head;
+  if (*head != 0)
+    {
+      (*head)->m_pprev = &timer->m_next;
+    }
+  *head = timer;
+  timer->m_pprev = head;
+}
+
+void Pmipv6TimerWheel::Unlink (Pmipv6Timer *timer)
+{
+  *timer->m_pprev = timer->m_next;
+  if (timer->m_next != 0)
+    {
+      timer->m_next->m_pprev = timer->m_pprev;
+    }
+  timer->m_next = 0;
+  timer->m_pprev = 0;
+}
+
+bool Pmipv6TimerWheel::FiresBefore (const Pmipv6Timer *a, const Pmipv6Timer *b)
+{
+  if (a->m_expires != b->m_expires)
+    {
+      return a->m_expires < b->m_expires;
+    }
+  return a->m_seq < b->m_seq;
+}
+
+void Pmipv6TimerWheel::Add (Pmipv6Timer *timer, const Time &delay)
+{
+  NS_LOG_FUNCTION (this << timer << delay);
+
+  int64_t now = Simulator::Now ().GetTimeStep ();
+  int64_t when = now + std::max (delay.GetTimeStep (), (int64_t)0);
+
+  /* first tick not before the current time, and the expiration */
+  uint64_t nowTick = (now + m_resolution - 1) / m_resolution;
+  uint64_t expires = (when + m_resolution - 1) / m_resolution;
+
+  if (m_nTimers == 0 && nowTick > 0)
+    {
+      /* nothing to catch up, restart from the current tick */
+      m_now = std::max (m_now, nowTick - 1);
+    }
+
+  if (!m_destroyHooked)
+    {
+      Simulator::ScheduleDestroy (&Pmipv6TimerWheel::Reset, this);
+      m_destroyHooked = true;
+    }
+
+  /* never in a tick already processed */
+  timer->m_expires = std::max (expires, m_now + 1);
+  timer->m_seq = m_seq++;
+
+  Place (timer);
+  m_nTimers++;
+
+  ScheduleEvent (std::min (timer->m_expires, (m_now | ROOT_MASK) + 1));
+}
+
+void Pmipv6TimerWheel::Remove (Pmipv6Timer *timer)
+{
+  NS_LOG_FUNCTION (this << timer);
+  NS_ASSERT (m_nTimers > 0);
+
+  /* the simulator event is left alone: if it was for this timer, it
+     finds nothing to do and schedules the next one */
+  Unlink (timer);
+  m_nTimers--;
+}
+
+Time Pmipv6TimerWheel::GetExpirationTime (const Pmipv6Timer *timer) const
+{
+  return TimeStep (timer->m_expires * m_resolution);
+}
+
+void Pmipv6TimerWheel::Place (Pmipv6Timer *timer)
+{
+  uint64_t expires = timer->m_expires;
+  uint64_t idx = expires - m_now;
+
+  if (idx < ROOT_SIZE)
+    {
+      Link (timer, &m_root[expires & ROOT_MASK]);
+      return;
+    }
+
+  uint32_t level = 0;
+  uint32_t shift = ROOT_BITS;
+
+  while (level < N_LEVELS - 1 && idx >= ((uint64_t)1 << (shift + LEVEL_BITS)))
+    {
+      level++;
+      shift += LEVEL_BITS;
+    }
+
+  if (idx >= ((uint64_t)1 << (shift + LEVEL_BITS)))
+    {
+      /* beyond the wheel: park it in the farthest slot, it is placed
+         again when that slot is cascaded */
+      expires = m_now + ((uint64_t)1 << (shift + LEVEL_BITS)) - 1;
+    }
+
+  Link (timer, &m_levels[level][(expires >> shift) & LEVEL_MASK]);
+}
+
+void Pmipv6TimerWheel::Cascade (uint32_t level, uint32_t index)
+{
+  Pmipv6Timer *timer = m_levels[level][index];
+
+  m_levels[level][index] = 0;
+
+  while (timer != 0)
+    {
+      Pmipv6Timer *next = timer->m_next;
+
+      timer->m_next = 0;
+      timer->m_pprev = 0;
+      Place (timer);
+
+      timer = next;
+    }
+}
+
+void Pmipv6TimerWheel::Expire ()
+{
+  NS_LOG_FUNCTION (this << m_eventTick);
+
+  uint64_t target = m_eventTick;
+
+  m_nEvents++;
+
+  while (m_now < target)
+    {
+      m_now++;
+
+      uint32_t index = m_now & ROOT_MASK;
+
+      if (index == 0)
+        {
+          for (uint32_t level = 0; level < N_LEVELS; level++)
+            {
+              uint32_t levelIndex = (m_now >> (ROOT_BITS + level * LEVEL_BITS)) & LEVEL_MASK;
+
+              Cascade (level, levelIndex);
+
+              if (levelIndex != 0)
+                {
+                  break;
+                }
+            }
+        }
+
+      while (m_root[index] != 0)
+        {
+          Pmipv6Timer *timer = m_root[index];
+
+          NS_ASSERT (timer->m_expires == m_now);
+          Unlink (timer);
+          m_due.push_back (timer);
+        }
+    }
+
+  /* a slot mixes timers placed directly and cascaded from coarser
+     levels: fire them in the order they were scheduled */
+  std::sort (m_due.begin (), m_due.end (), &Pmipv6TimerWheel::FiresBefore);
+
+  for (std::vector<Pmipv6Timer *>::reverse_iterator it = m_due.rbegin (); it != m_due.rend (); ++it)
+    {
+      Link (*it, &m_expired);
+    }
+  m_due.clear ();
+
+  /* a callback may schedule or cancel any timer, including the ones
+     still in the expired list */
+  while (m_expired != 0)
+    {
+      Pmipv6Timer *timer = m_expired;
+
+      Unlink (timer);
+      m_nTimers--;
+
+      timer->m_callback ();
+    }
+
+  if (m_nTimers > 0)
+    {
+      ScheduleEvent (GetNextTick ());
+    }
+}
+
+uint64_t Pmipv6TimerWheel::GetNextTick () const
+{
+  uint64_t boundary = (m_now | ROOT_MASK) + 1;
+
+  for (uint64_t tick = m_now + 1; tick < boundary; tick++)
+    {
+      if (m_root[tick & ROOT_MASK] != 0)
+        {
+          return tick;
+        }
+    }
+
+  /* the first level is empty up to the next cascade */
+  return boundary;
+}
+
+void Pmipv6TimerWheel::ScheduleEvent (uint64_t tick)
+{
+  if (m_event.IsRunning ())
+    {
+      if (m_eventTick <= tick)
+        {
+          return;
+        }
+      m_event.Cancel ();
+    }
+
+  m_eventTick = tick;
+  m_event = Simulator::Schedule (TimeStep (tick * m_resolution) - Simulator::Now (), &Pmipv6TimerWheel::Expire, this);
+}
+
+void Pmipv6TimerWheel::Release (Pmipv6Timer **head)
+{
+  while (*head != 0)
+    {
+      Unlink (*head);
+    }
+}
+
+void Pmipv6TimerWheel::Reset ()
+{
+  NS_LOG_FUNCTION (this);
+
+  /* the owners of the timers may outlive the simulation: leave them
+     stopped rather than linked in a wheel that starts over */
+  for (uint32_t i = 0; i < ROOT_SIZE; i++)
+    {
+      Release (&m_root[i]);
+    }
+  for (uint32_t l = 0; l < N_LEVELS; l++)
+    {
+      for (uint32_t i = 0; i < LEVEL_SIZE; i++)
+        {
+          Release (&m_levels[l][i]);
+        }
+    }
+  Release (&m_expired);
+
+  m_now = 0;
+  m_nTimers = 0;
+  m_seq = 0;
+  m_event = EventId ();
+  m_eventTick = 0;
+  m_destroyHooked = false;
+}
+
+} /* namespace ns3 */
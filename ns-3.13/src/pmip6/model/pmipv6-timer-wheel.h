@@ -0,0 +1,189 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PMIPV6_TIMER_WHEEL_H
+#define PMIPV6_TIMER_WHEEL_H
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "ns3/nstime.h"
+#include "ns3/callback.h"
+#include "ns3/event-id.h"
+
+namespace ns3
+{
+
+/**
+ * \class Pmipv6Timer
+ * \brief Binding timer driven by the shared Pmipv6TimerWheel.
+ *
+ * Used like ns3::Timer (SetFunction, SetDelay, Schedule, Cancel), but the
+ * expiration is only a link in the timing wheel, not an event of the
+ * simulator: scheduling and cancelling are O(1) and never touch the
+ * simulator event queue. The expiration is rounded up to the resolution
+ * of the wheel. A timer is cancelled when destroyed.
+ */
+class Pmipv6Timer
+{
+public:
+  Pmipv6Timer ();
+  ~Pmipv6Timer ();
+
+  /**
+   * \param memPtr member method to call on expiration
+   * \param objPtr object to call it on
+   */
+  template <typename MEM_PTR, typename OBJ_PTR>
+  void SetFunction (MEM_PTR memPtr, OBJ_PTR objPtr);
+
+  void SetDelay (const Time &delay);
+  Time GetDelay () const;
+
+  /**
+   * \brief Schedule the timer, cancelling it first if it is running.
+   */
+  void Schedule ();
+  void Schedule (const Time &delay);
+
+  void Cancel ();
+  bool IsRunning () const;
+
+  /**
+   * \return the time left before expiration, zero if not running
+   */
+  Time GetDelayLeft () const;
+
+private:
+  friend class Pmipv6TimerWheel;
+
+  /* timers are linked in the wheel by address */
+  Pmipv6Timer (const Pmipv6Timer &);
+  Pmipv6Timer &operator = (const Pmipv6Timer &);
+
+  Callback<void> m_callback;
+  Time m_delay;
+  uint64_t m_expires;       //!< expiration tick
+  uint64_t m_seq;           //!< scheduling order, for timers of the same tick
+
+  Pmipv6Timer *m_next;
+  Pmipv6Timer **m_pprev;    //!< link pointing at us, 0 when not running
+};
+
+/**
+ * \class Pmipv6TimerWheel
+ * \brief Hierarchical timing wheel shared by all PMIPv6 binding timers.
+ *
+ * Binding lifetimes and retransmissions are kept per binding on every
+ * MAG and LMA and are mostly rescheduled before they expire. Instead of
+ * one simulator event per timer, the wheel keeps them in per-tick lists
+ * (256 ticks in the first level, 64 slots in each of four coarser levels
+ * cascaded down as time goes by, as in the BSD/Linux kernel timers) and
+ * schedules a single simulator event for the next tick holding timers,
+ * which fires all of them. With no running timer, no event is scheduled.
+ *
+ * The wheel is reset by Simulator::Destroy.
+ */
+class Pmipv6TimerWheel
+{
+public:
+  /**
+   * \brief Set the tick of the wheel (10ms by default).
+   *
+   * Timers expire on the first tick after their delay, so the
+   * resolution trades timer accuracy for batching.
+   * Can only be changed while no timer is running.
+   */
+  static void SetResolution (Time resolution);
+  static Time GetResolution ();
+
+  /**
+   * \return the number of running timers
+   */
+  static uint32_t GetNTimers ();
+
+  /**
+   * \return the number of simulator events used by the wheel so far
+   */
+  static uint64_t GetNEvents ();
+
+private:
+  friend class Pmipv6Timer;
+
+  enum
+  {
+    ROOT_BITS = 8,
+    ROOT_SIZE = 1 << ROOT_BITS,
+    ROOT_MASK = ROOT_SIZE - 1,
+    LEVEL_BITS = 6,
+    LEVEL_SIZE = 1 << LEVEL_BITS,
+    LEVEL_MASK = LEVEL_SIZE - 1,
+    N_LEVELS = 4
+  };
+
+  Pmipv6TimerWheel ();
+
+  static Pmipv6TimerWheel *Get ();
+
+  void Add (Pmipv6Timer *timer, const Time &delay);
+  void Remove (Pmipv6Timer *timer);
+  Time GetExpirationTime (const Pmipv6Timer *timer) const;
+
+  void Place (Pmipv6Timer *timer);
+  void Cascade (uint32_t level, uint32_t index);
+  void Expire ();
+  void ScheduleEvent (uint64_t tick);
+  uint64_t GetNextTick () const;
+  void Reset ();
+
+  static void Link (Pmipv6Timer *timer, Pmipv6Timer **head);
+  static void Unlink (Pmipv6Timer *timer);
+  static void Release (Pmipv6Timer **head);
+  static bool FiresBefore (const Pmipv6Timer *a, const Pmipv6Timer *b);
+
+  int64_t m_resolution;     //!< in time steps
+  uint64_t m_now;           //!< last processed tick
+  uint32_t m_nTimers;
+  uint64_t m_nEvents;
+  uint64_t m_seq;           //!< timers scheduled so far
+
+  Pmipv6Timer *m_root[ROOT_SIZE];
+  Pmipv6Timer *m_levels[N_LEVELS][LEVEL_SIZE];
+  Pmipv6Timer *m_expired;   //!< being fired
+  std::vector<Pmipv6Timer *> m_due;  //!< timers of the processed ticks, sorted before firing
+
+  EventId m_event;
+  uint64_t m_eventTick;
+  bool m_destroyHooked;
+};
+
+template <typename MEM_PTR, typename OBJ_PTR>
+void
+Pmipv6Timer::SetFunction (MEM_PTR memPtr, OBJ_PTR objPtr)
+{
+  m_callback = MakeCallback (memPtr, objPtr);
+}
+
+} /* namespace ns3 */
+
+#endif /* PMIPV6_TIMER_WHEEL_H */
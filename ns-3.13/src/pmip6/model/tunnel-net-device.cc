@@ -30,6 +30,7 @@
 #include "ns3/channel.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/ipv6-routing-protocol.h"
@@ -38,6 +39,7 @@
 #include "ns3/ethernet-header.h"
 #include "ns3/ethernet-trailer.h"
 
+#include "ipv6-tunnel-compressed-header.h"
 #include "tunnel-net-device.h"
 
 NS_LOG_COMPONENT_DEFINE ("TunnelNetDevice");
@@ -57,6 +59,25 @@ TunnelNetDevice::GetTypeId (void)
                    MakeUintegerAccessor (&TunnelNetDevice::SetMtu,
                                          &TunnelNetDevice::GetMtu),
                    MakeUintegerChecker<uint16_t> ())                   
+    .AddAttribute ("PathMtuDiscovery", "Derive the MTU from the path to the remote end-point, "
+                   "less the outer header, and lower it on Packet Too Big.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&TunnelNetDevice::m_pathMtuDiscovery),
+                   MakeBooleanChecker ())
+    .AddAttribute ("HeaderCompression", "Compress the inner IPv6 header of the packets sent into "
+                   "the tunnel, the remote end-point must support it.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&TunnelNetDevice::m_compression),
+                   MakeBooleanChecker ())
+    .AddAttribute ("CompressionContexts", "Number of compression contexts, each one for an inner "
+                   "source and destination pair.",
+                   UintegerValue (256),
+                   MakeUintegerAccessor (&TunnelNetDevice::m_nContexts),
+                   MakeUintegerChecker<uint16_t> (1, 256))
+    .AddAttribute ("CompressionRefresh", "Send the whole inner header (IR) every this many packets of a context.",
+                   UintegerValue (32),
+                   MakeUintegerAccessor (&TunnelNetDevice::m_refreshInterval),
+                   MakeUintegerChecker<uint32_t> (1))
     .AddTraceSource ("MacTx", 
                      "Trace source indicating a packet has arrived for transmission by this device",
                      MakeTraceSourceAccessor (&TunnelNetDevice::m_macTxTrace))
@@ -82,9 +103,12 @@ TunnelNetDevice::GetTypeId (void)
 }
 
 TunnelNetDevice::TunnelNetDevice ()
- : m_localAddress("::"),
+ : m_pathMtu (0),
+   m_linkMtu (0),
+   m_localAddress("::"),
    m_remoteAddress("::"),
-   m_refCount(1)
+   m_refCount(0),
+   m_nextContext (0)
 {
   NS_LOG_FUNCTION_NOARGS();
   
@@ -162,6 +186,68 @@ void TunnelNetDevice::SetRemoteAddress(Ipv6Address raddr)
   NS_LOG_FUNCTION ( this << raddr );
   
   m_remoteAddress = raddr;
+  UpdatePathMtu ();
+  ResetContexts ();
+}
+
+void TunnelNetDevice::UpdatePathMtu ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  m_pathMtu = 0;
+  m_linkMtu = 0;
+  
+  if (m_node == 0 || m_remoteAddress.IsAny ())
+    {
+      return;
+    }
+  
+  Ptr<Ipv6L3Protocol> ipv6 = m_node->GetObject<Ipv6L3Protocol> ();
+  if (ipv6 == 0 || ipv6->GetRoutingProtocol () == 0)
+    {
+      return;
+    }
+  
+  Ipv6Header header;
+  Socket::SocketErrno err;
+  
+  header.SetDestinationAddress (m_remoteAddress);
+  Ptr<Ipv6Route> route = ipv6->GetRoutingProtocol ()->RouteOutput (Create<Packet> (), header, 0, err);
+  
+  if (route == 0 || route->GetOutputDevice () == this)
+    {
+      NS_LOG_LOGIC ("No route for tunnel remote address, path MTU unknown");
+      return;
+    }
+  
+  m_linkMtu = route->GetOutputDevice ()->GetMtu ();
+  m_pathMtu = m_linkMtu;
+  
+  NS_LOG_LOGIC ("Path MTU to " << m_remoteAddress << " is " << m_pathMtu);
+}
+
+void TunnelNetDevice::NotifyPacketTooBig (uint32_t mtu)
+{
+  NS_LOG_FUNCTION ( this << mtu );
+  
+  m_stats.rxTooBig++;
+  
+  // RFC 8201: never below the IPv6 minimum link MTU
+  if (mtu < 1280)
+    {
+      mtu = 1280;
+    }
+  if (m_pathMtu == 0 || mtu < m_pathMtu)
+    {
+      m_pathMtu = mtu;
+    }
+}
+
+uint16_t TunnelNetDevice::GetPathMtu () const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  return m_pathMtu;
 }
    
 void TunnelNetDevice::IncreaseRefCount()
@@ -181,6 +267,212 @@ uint32_t TunnelNetDevice::GetRefCount() const
   NS_LOG_FUNCTION_NOARGS();
   return m_refCount;
 }
+
+TunnelNetDevice::Statistics::Statistics ()
+  : txPackets (0),
+    txBytes (0),
+    txDropped (0),
+    txFragmented (0),
+    txCompressed (0),
+    rxTooBig (0),
+    rxContextErrors (0),
+    rxPackets (0),
+    rxBytes (0),
+    rxDropped (0)
+{
+}
+
+const TunnelNetDevice::Statistics &TunnelNetDevice::GetStatistics () const
+{
+  NS_LOG_FUNCTION_NOARGS();
+  return m_stats;
+}
+
+void TunnelNetDevice::ResetStatistics ()
+{
+  NS_LOG_FUNCTION_NOARGS();
+  m_stats = Statistics ();
+}
+
+void TunnelNetDevice::RecordTransmit (Ptr<const Packet> packet, uint16_t linkMtu)
+{
+  NS_LOG_FUNCTION ( this << packet << linkMtu );
+  
+  m_stats.txPackets++;
+  m_stats.txBytes += packet->GetSize ();
+  
+  if (linkMtu != 0 && packet->GetSize () + 40 > linkMtu) /* 40 => size of IPv6 header */
+    {
+      m_stats.txFragmented++;
+    }
+}
+
+uint8_t TunnelNetDevice::Compress (Ptr<Packet> packet, uint16_t protocolNumber)
+{
+  NS_LOG_FUNCTION ( this << packet << protocolNumber );
+  
+  if (!m_compression || protocolNumber != Ipv6L3Protocol::PROT_NUMBER)
+    {
+      return 41; /* IPv6-in-IPv6 */
+    }
+  
+  Ipv6Header inner;
+  packet->RemoveHeader (inner);
+  
+  FlowKey key (inner.GetSourceAddress (), inner.GetDestinationAddress ());
+  ContextIndex::iterator it = m_contextIndex.find (key);
+  uint8_t cid;
+  
+  if (it != m_contextIndex.end ())
+    {
+      cid = it->second;
+    }
+  else
+    {
+      // contexts are taken round robin (clock), skipping the ones used
+      // since the hand last went by: with more active flows than
+      // contexts, the new flow is sent uncompressed rather than every
+      // packet becoming an IR
+      cid = m_nextContext;
+      m_nextContext = (m_nextContext + 1) % m_nContexts;
+      
+      if (m_txContexts.size () <= cid)
+        {
+          m_txContexts.resize (cid + 1);
+        }
+      
+      CompressorContext &old = m_txContexts[cid];
+      if (old.used && old.referenced)
+        {
+          NS_LOG_LOGIC ("Context " << (uint32_t)cid << " in use, packet sent uncompressed");
+          old.referenced = false;
+          packet->AddHeader (inner);
+          
+          return 41; /* IPv6-in-IPv6 */
+        }
+      if (old.used)
+        {
+          m_contextIndex.erase (FlowKey (old.header.GetSourceAddress (), old.header.GetDestinationAddress ()));
+        }
+      old.used = false;
+      m_contextIndex[key] = cid;
+    }
+  
+  CompressorContext &context = m_txContexts[cid];
+  Ipv6TunnelCompressedHeader header;
+  
+  context.referenced = true;
+  
+  // the decompressor only learns the static fields from IR packets, a
+  // new generation tells it not to use the former ones until it got one
+  if (!context.used ||
+      context.header.GetNextHeader () != inner.GetNextHeader () ||
+      context.header.GetTrafficClass () != inner.GetTrafficClass () ||
+      context.header.GetFlowLabel () != inner.GetFlowLabel ())
+    {
+      context.used = true;
+      context.generation++;
+      context.irLeft = IR_REPEAT;
+    }
+  
+  header.SetContextId (cid);
+  header.SetGeneration (context.generation);
+  
+  if (context.irLeft > 0 || context.count >= m_refreshInterval)
+    {
+      header.SetInnerHeader (inner);
+      context.count = 0;
+      context.header = inner;
+      if (context.irLeft > 0)
+        {
+          context.irLeft--;
+        }
+    }
+  else
+    {
+      if (inner.GetHopLimit () != context.header.GetHopLimit ())
+        {
+          header.SetHopLimit (inner.GetHopLimit ());
+        }
+      m_stats.txCompressed++;
+    }
+  
+  context.count++;
+  packet->AddHeader (header);
+  
+  return Ipv6TunnelCompressedHeader::PROT_NUMBER;
+}
+
+bool TunnelNetDevice::Decompress (Ptr<Packet> packet, Ipv6Header &innerHeader)
+{
+  NS_LOG_FUNCTION ( this << packet );
+  
+  Ipv6TunnelCompressedHeader header;
+  packet->RemoveHeader (header);
+  
+  uint8_t cid = header.GetContextId ();
+  
+  if (m_rxContexts.size () <= cid)
+    {
+      m_rxContexts.resize (cid + 1);
+    }
+  
+  DecompressorContext &context = m_rxContexts[cid];
+  
+  if (header.IsRefresh ())
+    {
+      context.valid = true;
+      context.generation = header.GetGeneration ();
+      context.header = header.GetInnerHeader ();
+    }
+  else if (!context.valid || context.generation != header.GetGeneration ())
+    {
+      NS_LOG_LOGIC ("No context " << (uint32_t)cid << " of generation " << (uint32_t)header.GetGeneration () << ", packet dropped");
+      m_stats.rxContextErrors++;
+      return false;
+    }
+  
+  innerHeader = context.header;
+  if (header.HasHopLimit ())
+    {
+      innerHeader.SetHopLimit (header.GetHopLimit ());
+    }
+  innerHeader.SetPayloadLength (packet->GetSize ());
+  
+  return true;
+}
+
+void TunnelNetDevice::ResetContexts ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  
+  m_contextIndex.clear ();
+  m_txContexts.clear ();
+  m_rxContexts.clear ();
+  m_nextContext = 0;
+}
+
+size_t TunnelNetDevice::FlowKeyHash::operator () (FlowKey const &x) const
+{
+  Ipv6AddressHash hash;
+  
+  return hash (x.first) * 31 + hash (x.second);
+}
+
+void TunnelNetDevice::RecordReceive (uint32_t bytes, bool forwarded)
+{
+  NS_LOG_FUNCTION ( this << bytes << forwarded );
+  
+  if (forwarded)
+    {
+      m_stats.rxPackets++;
+      m_stats.rxBytes += bytes;
+    }
+  else
+    {
+      m_stats.rxDropped++;
+    }
+}
   
 bool
 TunnelNetDevice::Receive (Ptr<Packet> packet, uint16_t protocol,
@@ -254,7 +546,24 @@ uint16_t
 TunnelNetDevice::GetMtu (void) const
 {
   NS_LOG_FUNCTION_NOARGS();
-  return m_mtu;
+  
+  if (!m_pathMtuDiscovery || m_pathMtu == 0)
+    {
+      return m_mtu;
+    }
+  
+  // the inner packets are never fragmented below the IPv6 minimum MTU,
+  // the outer packets are fragmented instead (RFC 2473)
+  uint16_t mtu = m_pathMtu - 40; /* 40 => size of IPv6 header */
+  if (m_compression)
+    {
+      mtu -= 2; /* IR packets: the inner header and 2 bytes */
+    }
+  if (mtu < 1280)
+    {
+      mtu = 1280;
+    }
+  return mtu < m_mtu ? mtu : m_mtu;
 }
 
 bool
@@ -318,7 +627,16 @@ TunnelNetDevice::Send (Ptr<Packet> packet, const Address& dest, uint16_t protoco
   
   Ptr<Ipv6L3Protocol> ipv6 = GetNode()->GetObject<Ipv6L3Protocol>();
   NS_ASSERT (ipv6 != 0 && ipv6->GetRoutingProtocol () != 0);
-  NS_ASSERT ( !m_remoteAddress.IsAny() );
+  
+  //a released device waiting on the free list, its interface still
+  //sends the delayed neighbor discovery messages
+  if (m_remoteAddress.IsAny ())
+    {
+      NS_LOG_LOGIC ("Tunnel device released, packet dropped");
+      m_stats.txDropped++;
+      
+      return false;
+    }
   
   Ipv6Address src = m_localAddress;
   Ipv6Address dst = m_remoteAddress;
@@ -341,6 +659,7 @@ TunnelNetDevice::Send (Ptr<Packet> packet, const Address& dest, uint16_t protoco
 	  if (route == 0)
 		{
 		  NS_LOG_LOGIC ("No route for tunnel remote address");
+		  m_stats.txDropped++;
 		  
 		  return false;
 		}
@@ -350,14 +669,20 @@ TunnelNetDevice::Send (Ptr<Packet> packet, const Address& dest, uint16_t protoco
 	  tag.SetTtl (ttl);
 	  packet->AddPacketTag (tag);
 		
-      ipv6->Send (packet, src, dst, 41 /* IPv6-in-IPv6 */, route);
+      uint8_t protocol = Compress (packet, protocolNumber);
+      RecordTransmit (packet, route->GetOutputDevice ()->GetMtu ());
+
+      ipv6->Send (packet, src, dst, protocol, route);
 	}
   else
     {
 	  tag.SetTtl (ttl);
 	  packet->AddPacketTag (tag);
 	  
-	  ipv6->Send (packet, src, dst, 41 /* IPv6-in-IPv6 */, 0);
+	  uint8_t protocol = Compress (packet, protocolNumber);
+	  RecordTransmit (packet, m_linkMtu);
+
+	  ipv6->Send (packet, src, dst, protocol, 0);
 	}
 	
 	return true;
@@ -373,7 +698,16 @@ TunnelNetDevice::SendFrom (Ptr<Packet> packet, const Address& source, const Addr
   
   Ptr<Ipv6L3Protocol> ipv6 = GetNode()->GetObject<Ipv6L3Protocol>();
   NS_ASSERT (ipv6 != 0 && ipv6->GetRoutingProtocol () != 0);
-  NS_ASSERT ( !m_remoteAddress.IsAny() );
+  
+  //a released device waiting on the free list, its interface still
+  //sends the delayed neighbor discovery messages
+  if (m_remoteAddress.IsAny ())
+    {
+      NS_LOG_LOGIC ("Tunnel device released, packet dropped");
+      m_stats.txDropped++;
+      
+      return false;
+    }
   
   Ipv6Address src = m_localAddress;
   Ipv6Address dst = m_remoteAddress;
@@ -403,6 +737,7 @@ TunnelNetDevice::SendFrom (Ptr<Packet> packet, const Address& source, const Addr
 	  if (route == 0)
 		{
 		  NS_LOG_LOGIC ("No route for tunnel remote address");
+		  m_stats.txDropped++;
 		  
 		  return false;
 		}
@@ -412,14 +747,20 @@ TunnelNetDevice::SendFrom (Ptr<Packet> packet, const Address& source, const Addr
 	  tag.SetTtl (ttl);
 	  packet->AddPacketTag (tag);
 		
-      ipv6->Send (packet, src, dst, 41 /* IPv6-in-IPv6 */, route);
+      uint8_t protocol = Compress (packet, protocolNumber);
+      RecordTransmit (packet, route->GetOutputDevice ()->GetMtu ());
+
+      ipv6->Send (packet, src, dst, protocol, route);
 	}
   else
     {
 	  tag.SetTtl (ttl);
 	  packet->AddPacketTag (tag);
 	  
-	  ipv6->Send (packet, src, dst, 41 /* IPv6-in-IPv6 */, 0);
+	  uint8_t protocol = Compress (packet, protocolNumber);
+	  RecordTransmit (packet, m_linkMtu);
+
+	  ipv6->Send (packet, src, dst, protocol, 0);
 	}
 	
 	return true;
@@ -32,6 +32,10 @@
 #include "ns3/packet.h"
 #include "ns3/ptr.h"
 #include "ns3/traced-callback.h"
+#include "ns3/ipv6-header.h"
+#include "ns3/sgi-hashmap.h"
+
+#include <vector>
 
 namespace ns3 {
 
@@ -73,7 +77,13 @@ public:
   void SetSupportsSendFrom (bool supportsSendFrom);
 
   /**
-   * \brief Configure the reported MTU for the virtual device.
+   * \brief Configure the largest MTU reported for the virtual device.
+   *
+   * With path MTU discovery, GetMtu reports the path MTU to the remote
+   * end-point minus the outer header when it is lower. It sizes the
+   * packets the node sends itself: the larger packets forwarded into the
+   * tunnel are not refused, their outer packet is fragmented to the path
+   * MTU (RFC 2473 section 7.1).
    * \param mtu MTU value to set
    * \return whether the MTU value was within legal bounds
    */
@@ -85,9 +95,77 @@ public:
   Ipv6Address GetRemoteAddress() const;
   void SetRemoteAddress(Ipv6Address raddr);
   
+  /**
+   * \brief Take the path MTU from the link of the route to the remote end-point.
+   *
+   * Called when the remote end-point changes. Packet Too Big messages
+   * only lower the path MTU afterwards.
+   */
+  void UpdatePathMtu ();
+  
+  /**
+   * \brief Lower the path MTU on an ICMPv6 Packet Too Big from the outer path.
+   * \param mtu the MTU reported by the router, at least 1280 is used
+   */
+  void NotifyPacketTooBig (uint32_t mtu);
+  
+  /**
+   * \return the MTU of the path to the remote end-point, 0 while unknown
+   */
+  uint16_t GetPathMtu () const;
+  
+  /**
+   * \brief Restore the inner header of a packet received with a compressed header.
+   *
+   * The decompressor contexts are those of the packets sent by the
+   * remote end-point through this tunnel.
+   *
+   * \param packet the packet, starting with an Ipv6TunnelCompressedHeader
+   * which is removed
+   * \param innerHeader filled with the inner header
+   * \return false if the context of the packet is unknown, or of another generation
+   */
+  bool Decompress (Ptr<Packet> packet, Ipv6Header &innerHeader);
+  
   void IncreaseRefCount();
   void DecreaseRefCount();
   uint32_t GetRefCount() const;
+  
+  /**
+   * \brief Per-tunnel packet counters.
+   */
+  struct Statistics
+  {
+    Statistics ();
+    
+    uint64_t txPackets; //!< packets encapsulated and sent to the remote end
+    uint64_t txBytes;   //!< bytes of the inner packets sent
+    uint64_t txDropped; //!< packets dropped for lack of a route to the remote end
+    uint64_t txFragmented; //!< packets sent in several fragments on the outer link
+    uint64_t txCompressed; //!< packets sent with a compressed inner header (CO)
+    uint64_t rxTooBig;  //!< Packet Too Big received from the outer path
+    uint64_t rxContextErrors; //!< compressed packets dropped for an unknown or outdated context
+    uint64_t rxPackets; //!< packets received from the remote end and decapsulated
+    uint64_t rxBytes;   //!< bytes of the decapsulated inner packets
+    uint64_t rxDropped; //!< decapsulated packets which could not be forwarded
+  };
+  
+  /**
+   * \return the counters of this tunnel since creation or the last reset
+   */
+  const Statistics &GetStatistics () const;
+  
+  /**
+   * \brief Reset the counters, e.g. when the device is recycled.
+   */
+  void ResetStatistics ();
+  
+  /**
+   * \brief Account a packet decapsulated from this tunnel.
+   * \param bytes size of the inner packet
+   * \param forwarded whether the inner packet could be forwarded
+   */
+  void RecordReceive (uint32_t bytes, bool forwarded);
 
   /**
    * \param packet packet sent from below up to Network Device
@@ -135,6 +213,76 @@ protected:
   virtual void DoDispose (void);
 
 private:
+  /**
+   * \brief Account a packet encapsulated and sent to the remote end.
+   * \param packet the inner packet
+   * \param linkMtu MTU of the outer link, 0 if unknown
+   */
+  void RecordTransmit (Ptr<const Packet> packet, uint16_t linkMtu);
+  
+  /**
+   * \brief Compress the inner header of a packet about to be encapsulated.
+   * \param packet the inner packet
+   * \param protocolNumber the protocol of the inner packet
+   * \return the protocol number of the outer header
+   */
+  uint8_t Compress (Ptr<Packet> packet, uint16_t protocolNumber);
+  
+  /**
+   * \brief Forget the compressor and decompressor contexts.
+   */
+  void ResetContexts ();
+  
+  typedef std::pair<Ipv6Address, Ipv6Address> FlowKey;
+  
+  class FlowKeyHash : public std::unary_function<FlowKey, size_t>
+  {
+  public:
+    size_t operator () (FlowKey const &x) const;
+  };
+  
+  /**
+   * \brief Inner header of a context and packets sent since its last IR.
+   */
+  struct CompressorContext
+  {
+    CompressorContext ()
+      : used (false),
+        referenced (false),
+        generation (0),
+        irLeft (0),
+        count (0)
+    {
+    }
+    
+    bool used;
+    bool referenced;    //!< used since the clock hand last went by
+    uint8_t generation; //!< changed with the static fields of the context
+    uint32_t irLeft;    //!< IR packets still to send for this generation
+    uint32_t count;
+    Ipv6Header header;
+  };
+  
+  struct DecompressorContext
+  {
+    DecompressorContext ()
+      : valid (false),
+        generation (0)
+    {
+    }
+    
+    bool valid;
+    uint8_t generation;
+    Ipv6Header header;
+  };
+  
+  /**
+   * \brief IR packets sent for a new generation of a context before CO
+   * packets, in case some are lost (RFC 3095 optimistic approach).
+   */
+  static const uint32_t IR_REPEAT = 3;
+  
+  typedef sgi::hash_map<FlowKey, uint8_t, FlowKeyHash> ContextIndex;
 
   Address m_myAddress;
   TracedCallback<Ptr<const Packet> > m_macRxTrace;
@@ -148,6 +296,12 @@ private:
   std::string m_name;
   uint32_t m_index;
   uint16_t m_mtu;
+  uint16_t m_pathMtu;
+  uint16_t m_linkMtu;
+  bool m_pathMtuDiscovery;
+  bool m_compression;
+  uint16_t m_nContexts;
+  uint32_t m_refreshInterval;
   bool m_needsArp;
   bool m_supportsSendFrom;
   bool m_isPointToPoint;
@@ -155,6 +309,13 @@ private:
   Ipv6Address m_localAddress;
   Ipv6Address m_remoteAddress;
   uint32_t m_refCount;
+  
+  ContextIndex m_contextIndex;                        //!< inner (source, destination) to context id
+  std::vector<CompressorContext> m_txContexts;        //!< by context id
+  uint16_t m_nextContext;                             //!< next context id to (re)assign
+  std::vector<DecompressorContext> m_rxContexts;      //!< by context id, grown on demand
+  
+  Statistics m_stats;
 };
 
 }; // namespace ns3
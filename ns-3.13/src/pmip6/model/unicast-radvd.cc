@@ -51,6 +51,9 @@ TypeId UnicastRadvd::GetTypeId ()
   static TypeId tid = TypeId ("ns3::UnicastRadvd")
     .SetParent<Application> ()
     .AddConstructor<UnicastRadvd> ()
+    .AddTraceSource ("Tx",
+                     "A router advertisement was sent to a link-layer address.",
+                     MakeTraceSourceAccessor (&UnicastRadvd::m_txTrace))
     ;
   return tid;
 }
@@ -274,6 +277,7 @@ void UnicastRadvd::Send (Ptr<UnicastRadvdInterface> config, Ipv6Address dst, boo
   /* send RA */
   NS_LOG_LOGIC ("Send RA");
   m_socket->SendTo (p, 0, target);
+  m_txTrace (p, config->GetInterface (), config->GetPhysicalAddress ());
 
   if (reschedule)
     {
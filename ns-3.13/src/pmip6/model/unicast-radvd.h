@@ -29,6 +29,7 @@
 
 #include "ns3/application.h"
 #include "ns3/socket.h"
+#include "ns3/traced-callback.h"
 
 #include "unicast-radvd-interface.h"
 
@@ -138,6 +139,11 @@ private:
    * \brief Event ID map.
    */
   EventIdMap m_eventIds;
+
+  /**
+   * \brief Sent RA, interface and link-layer destination.
+   */
+  TracedCallback<Ptr<const Packet>, uint32_t, Address> m_txTrace;
 };
 
 } /* namespace ns3 */
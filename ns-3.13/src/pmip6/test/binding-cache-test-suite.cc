@@ -0,0 +1,124 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <list>
+
+#include "ns3/test.h"
+#include "ns3/mac48-address.h"
+#include "ns3/binding-cache.h"
+
+namespace ns3 {
+
+class BindingCacheIndexTestCase : public TestCase
+{
+public:
+  BindingCacheIndexTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+BindingCacheIndexTestCase::BindingCacheIndexTestCase ()
+  : TestCase ("Check secondary lookups and removal of binding cache entries")
+{
+}
+
+void
+BindingCacheIndexTestCase::DoRun (void)
+{
+  Ptr<BindingCache> bCache = CreateObject<BindingCache> ();
+  Identifier mnId ("mn1@example.com");
+  Identifier mnLinkId1 (Mac48Address ("00:00:00:00:00:01"));
+  Identifier mnLinkId2 (Mac48Address ("00:00:00:00:00:02"));
+  Ipv6Address mag1 ("2001:db8::1");
+  Ipv6Address mag2 ("2001:db8::2");
+  std::list<Ipv6Address> hnps1;
+  std::list<Ipv6Address> hnps2;
+  bool allMatched;
+
+  hnps1.push_back (Ipv6Address ("3ffe:1:4:1::"));
+  hnps2.push_back (Ipv6Address ("3ffe:1:4:2::"));
+  hnps2.push_back (Ipv6Address ("3ffe:1:4:3::"));
+
+  BindingCache::Entry *bce1 = bCache->Add (mnId);
+  bce1->SetProxyCoa (mag1);
+  bce1->SetMnLinkIdentifier (mnLinkId1);
+  bce1->SetAccessTechnologyType (4);
+  bce1->SetHomeNetworkPrefixes (hnps1);
+
+  BindingCache::Entry *bce2 = bCache->Add (mnId);
+  bce2->SetProxyCoa (mag1);
+  bce2->SetMnLinkIdentifier (mnLinkId2);
+  bce2->SetAccessTechnologyType (4);
+  bce2->SetHomeNetworkPrefixes (hnps2);
+
+  NS_TEST_EXPECT_MSG_EQ (bCache->GetNEntries (), 2, "two entries expected");
+  NS_TEST_EXPECT_MSG_EQ (bCache->LookupByHomeNetworkPrefix (Ipv6Address ("3ffe:1:4:3::")), bce2, "HNP index");
+  NS_TEST_EXPECT_MSG_EQ (bCache->LookupByMnLinkIdentifier (mnLinkId1), bce1, "MN link-id index");
+  NS_TEST_EXPECT_MSG_EQ (bCache->Lookup (mnId, 4, mnLinkId2), bce2, "Lookup by ATT and link-id");
+  NS_TEST_EXPECT_MSG_EQ (bCache->Lookup (mnId, hnps2, allMatched), bce2, "Lookup by HNP list");
+  NS_TEST_EXPECT_MSG_EQ (allMatched, true, "all prefixes should match");
+
+  std::list<Ipv6Address> partial;
+  partial.push_back (Ipv6Address ("3ffe:1:4:2::"));
+  partial.push_back (Ipv6Address ("3ffe:1:4:9::"));
+  NS_TEST_EXPECT_MSG_EQ (bCache->Lookup (mnId, partial, allMatched), bce2, "partial HNP match");
+  NS_TEST_EXPECT_MSG_EQ (allMatched, false, "not all prefixes match");
+
+  uint32_t n = 0;
+  for (BindingCache::Entry *e = bCache->LookupByProxyCoa (mag1); e; e = e->GetNextByProxyCoa ())
+    {
+      n++;
+    }
+  NS_TEST_EXPECT_MSG_EQ (n, 2, "both entries registered through mag1");
+
+  // handover of the first interface
+  bce1->SetProxyCoa (mag2);
+  NS_TEST_EXPECT_MSG_EQ (bCache->LookupByProxyCoa (mag2), bce1, "entry should move to mag2");
+  NS_TEST_EXPECT_MSG_EQ (bCache->LookupByProxyCoa (mag1), bce2, "mag1 keeps the second entry");
+  NS_TEST_EXPECT_MSG_EQ (bce2->GetNextByProxyCoa (), (BindingCache::Entry *)0, "mag1 list has one entry");
+
+  // removing the chain head keeps the MN reachable through the other entry
+  bCache->Remove (bce2);
+  NS_TEST_EXPECT_MSG_EQ (bCache->GetNEntries (), 1, "one entry left");
+  NS_TEST_EXPECT_MSG_EQ (bCache->Lookup (mnId), bce1, "remaining entry is the new chain head");
+  NS_TEST_EXPECT_MSG_EQ (bCache->LookupByHomeNetworkPrefix (Ipv6Address ("3ffe:1:4:2::")), (BindingCache::Entry *)0, "HNP unlinked");
+  NS_TEST_EXPECT_MSG_EQ (bCache->LookupByMnLinkIdentifier (mnLinkId2), (BindingCache::Entry *)0, "link-id unlinked");
+  NS_TEST_EXPECT_MSG_EQ (bCache->LookupByProxyCoa (mag1), (BindingCache::Entry *)0, "mag1 has no binding");
+
+  bCache->Remove (bce1);
+  NS_TEST_EXPECT_MSG_EQ (bCache->Lookup (mnId), (BindingCache::Entry *)0, "cache should be empty");
+  NS_TEST_EXPECT_MSG_EQ (bCache->GetNEntries (), 0, "cache should be empty");
+
+  bCache->Dispose ();
+}
+
+static class BindingCacheTestSuite : public TestSuite
+{
+public:
+  BindingCacheTestSuite ()
+    : TestSuite ("pmip6-binding-cache", UNIT)
+  {
+    AddTestCase (new BindingCacheIndexTestCase ());
+  }
+} g_bindingCacheTestSuite;
+
+} // namespace ns3
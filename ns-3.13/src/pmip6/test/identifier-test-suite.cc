@@ -0,0 +1,89 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/mac48-address.h"
+#include "ns3/identifier.h"
+
+namespace ns3 {
+
+class IdentifierInternTestCase : public TestCase
+{
+public:
+  IdentifierInternTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+IdentifierInternTestCase::IdentifierInternTestCase ()
+  : TestCase ("Check interning, comparison and release of identifiers")
+{
+}
+
+void
+IdentifierInternTestCase::DoRun (void)
+{
+  uint32_t base = Identifier::GetNInterned ();
+  uint8_t buf[Identifier::MAX_SIZE];
+
+  {
+    Identifier a ("mn1@example.com");
+    Identifier b ((const uint8_t *)"mn1@example.com", 15);
+    Identifier c ("mn2@example.com");
+    Identifier mac (Mac48Address ("00:00:00:00:00:01"));
+    Identifier empty;
+
+    NS_TEST_EXPECT_MSG_EQ ((a == b), true, "same bytes should give the same identifier");
+    NS_TEST_EXPECT_MSG_EQ ((a != c), true, "different bytes should differ");
+    NS_TEST_EXPECT_MSG_EQ (a.GetHash (), b.GetHash (), "hash must follow equality");
+    NS_TEST_EXPECT_MSG_EQ (a.GetLength (), 15, "length");
+    NS_TEST_EXPECT_MSG_EQ (mac.GetLength (), 6, "MAC identifier length");
+    NS_TEST_EXPECT_MSG_EQ (empty.IsEmpty (), true, "default identifier is empty");
+    NS_TEST_EXPECT_MSG_EQ (empty.GetHash (), 0, "empty identifier hash");
+    NS_TEST_EXPECT_MSG_EQ (Identifier::GetNInterned (), base + 3, "three distinct values interned");
+
+    NS_TEST_EXPECT_MSG_EQ (c.CopyTo (buf, sizeof (buf)), 15, "copied length");
+    NS_TEST_EXPECT_MSG_EQ (memcmp (buf, "mn2@example.com", 15), 0, "copied bytes");
+
+    Identifier d = c;
+    c.CopyFrom ((const uint8_t *)"mn1@example.com", 15);
+    NS_TEST_EXPECT_MSG_EQ ((c == a), true, "CopyFrom should re-intern");
+    NS_TEST_EXPECT_MSG_EQ ((d == Identifier ("mn2@example.com")), true, "copy keeps its value");
+
+    d = empty;
+    NS_TEST_EXPECT_MSG_EQ (Identifier::GetNInterned (), base + 2, "last reference released");
+  }
+
+  NS_TEST_EXPECT_MSG_EQ (Identifier::GetNInterned (), base, "all values released");
+}
+
+static class IdentifierTestSuite : public TestSuite
+{
+public:
+  IdentifierTestSuite ()
+    : TestSuite ("pmip6-identifier", UNIT)
+  {
+    AddTestCase (new IdentifierInternTestCase ());
+  }
+} g_identifierTestSuite;
+
+} // namespace ns3
@@ -0,0 +1,281 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <string.h>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/mac48-address.h"
+#include "ns3/identifier.h"
+#include "ns3/ipv6-mobility.h"
+#include "ns3/ipv6-mobility-header.h"
+#include "ns3/ipv6-mobility-option.h"
+#include "ns3/ipv6-mobility-option-header.h"
+#include "ns3/ipv6-mobility-option-demux.h"
+#include "ns3/ipv6-mobility-message-template.h"
+
+namespace ns3 {
+
+class Ipv6MobilityOptionParseTestCase : public TestCase
+{
+public:
+  Ipv6MobilityOptionParseTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+Ipv6MobilityOptionParseTestCase::Ipv6MobilityOptionParseTestCase ()
+  : TestCase ("Check the single pass option walker against the per-option parsers")
+{
+}
+
+void
+Ipv6MobilityOptionParseTestCase::DoRun (void)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<Ipv6MobilityOptionDemux> demux = CreateObject<Ipv6MobilityOptionDemux> ();
+  demux->SetNode (node);
+  node->AggregateObject (demux);
+
+  demux->Insert (CreateObject<Ipv6MobilityOptionPad1> ());
+  demux->Insert (CreateObject<Ipv6MobilityOptionPadn> ());
+  demux->Insert (CreateObject<Ipv6MobilityOptionMobileNodeIdentifier> ());
+  demux->Insert (CreateObject<Ipv6MobilityOptionHomeNetworkPrefix> ());
+  demux->Insert (CreateObject<Ipv6MobilityOptionHandoffIndicator> ());
+  demux->Insert (CreateObject<Ipv6MobilityOptionMobileNodeLinkLayerIdentifier> ());
+  demux->Insert (CreateObject<Ipv6MobilityOptionLinkLocalAddress> ());
+  demux->Insert (CreateObject<Ipv6MobilityOptionTimestamp> ());
+  demux->Insert (CreateObject<Ipv6MobilityOptionRedirectCapability> ());
+  demux->Insert (CreateObject<Ipv6MobilityOptionRedirect> ());
+  // access technology type is left out on purpose: it must be skipped
+
+  NS_TEST_EXPECT_MSG_EQ (demux->GetOption (Ipv6MobilityOptionAccessTechnologyType::OPT_NUMBER), Ptr<Ipv6MobilityOption> (0), "not registered");
+  NS_TEST_EXPECT_MSG_EQ (demux->GetOption (300), Ptr<Ipv6MobilityOption> (0), "out of range");
+
+  Ptr<Ipv6Mobility> mobility = CreateObject<Ipv6MobilityBindingUpdate> ();
+  mobility->SetNode (node);
+
+  Ipv6MobilityBindingUpdateHeader pbu;
+  Ipv6MobilityOptionMobileNodeIdentifierHeader mnidh;
+  Ipv6MobilityOptionHomeNetworkPrefixHeader hnph;
+  Ipv6MobilityOptionHandoffIndicatorHeader hih;
+  Ipv6MobilityOptionAccessTechnologyTypeHeader atth;
+  Ipv6MobilityOptionMobileNodeLinkLayerIdentifierHeader mnllidh;
+  Ipv6MobilityOptionLinkLocalAddressHeader llah;
+  Ipv6MobilityOptionTimestampHeader timestamph;
+  Ipv6MobilityOptionRedirectCapabilityHeader rch;
+  Ipv6MobilityOptionRedirectHeader redirecth (Ipv6Address ("2001:db8::2"));
+
+  mnidh.SetSubtype (1);
+  mnidh.SetNodeIdentifier (Identifier ("mn1@example"));
+  pbu.AddOption (mnidh);
+
+  hnph.SetPrefix (Ipv6Address ("2001:db8:1::"));
+  hnph.SetPrefixLength (64);
+  pbu.AddOption (hnph);
+  hnph.SetPrefix (Ipv6Address ("2001:db8:2::"));
+  pbu.AddOption (hnph);
+
+  hih.SetHandoffIndicator (2);
+  pbu.AddOption (hih);
+
+  atth.SetAccessTechnologyType (4);
+  pbu.AddOption (atth);
+
+  mnllidh.SetLinkLayerIdentifier (Identifier (Mac48Address ("00:00:00:00:00:01")));
+  pbu.AddOption (mnllidh);
+
+  llah.SetLinkLocalAddress (Ipv6Address ("fe80::1"));
+  pbu.AddOption (llah);
+
+  pbu.AddOption (rch);
+  pbu.AddOption (redirecth);
+
+  timestamph.SetTimestamp (MicroSeconds (1234567));
+  pbu.AddOption (timestamph);
+
+  Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (pbu);
+
+  // the header length is only known once deserialized, as in Pmipv6Lma::HandlePbu
+  Ipv6MobilityBindingUpdateHeader received;
+  packet->PeekHeader (received);
+
+  uint8_t offset = received.GetOptionsOffset ();
+  uint8_t length = ((received.GetHeaderLen () + 1) << 3) - received.GetOptionsOffset ();
+
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t)offset + length, packet->GetSize (), "options up to the end of the message");
+
+  Ipv6MobilityOptionBundle bundle;
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t)mobility->ProcessOptions (packet, offset, length, bundle), (uint32_t)length, "all options walked");
+
+  // reference: the packet based parser of each registered option
+  Ipv6MobilityOptionBundle reference;
+  uint8_t processed = 0;
+  uint8_t data[256];
+  packet->CopyData (data, offset + length);
+
+  while (processed < length)
+    {
+      uint8_t type = data[offset + processed];
+      Ptr<Ipv6MobilityOption> option = demux->GetOption (type);
+
+      if (option == 0)
+        {
+          processed += type == 0 ? 1 : data[offset + processed + 1] + 2;
+        }
+      else
+        {
+          processed += option->Process (packet, offset + processed, reference);
+        }
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (bundle.GetMnIdentifier (), reference.GetMnIdentifier (), "MN identifier");
+  NS_TEST_EXPECT_MSG_EQ (bundle.GetMnIdentifier (), Identifier ("mn1@example"), "MN identifier value");
+  NS_TEST_EXPECT_MSG_EQ (bundle.GetMnLinkIdentifier (), reference.GetMnLinkIdentifier (), "MN link-layer identifier");
+  NS_TEST_EXPECT_MSG_EQ (bundle.GetHomeNetworkPrefixes ().size (), 2, "two prefixes");
+  NS_TEST_EXPECT_MSG_EQ ((bundle.GetHomeNetworkPrefixes () == reference.GetHomeNetworkPrefixes ()), true, "prefixes in order");
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t)bundle.GetHandoffIndicator (), 2, "handoff indicator");
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t)bundle.GetAccessTechnologyType (), (uint32_t)reference.GetAccessTechnologyType (), "unknown option skipped");
+  NS_TEST_EXPECT_MSG_EQ (bundle.GetMagLinkAddress (), Ipv6Address ("fe80::1"), "link-local address");
+  NS_TEST_EXPECT_MSG_EQ (bundle.GetTimestamp (), reference.GetTimestamp (), "timestamp");
+  NS_TEST_EXPECT_MSG_EQ (bundle.GetTimestamp (), MicroSeconds (1234567), "timestamp value");
+  NS_TEST_EXPECT_MSG_EQ (bundle.HasRedirectCapability (), true, "redirect capability");
+  NS_TEST_EXPECT_MSG_EQ (reference.HasRedirectCapability (), true, "redirect capability");
+  NS_TEST_EXPECT_MSG_EQ (bundle.GetRedirectLmaAddress (), reference.GetRedirectLmaAddress (), "r2LMA");
+  NS_TEST_EXPECT_MSG_EQ (bundle.GetRedirectLmaAddress (), Ipv6Address ("2001:db8::2"), "r2LMA value");
+
+  // an option running past the end of the options is not parsed
+  Ipv6MobilityOptionBundle truncated;
+  mobility->ProcessOptions (packet, offset, length - 2, truncated);
+  NS_TEST_EXPECT_MSG_EQ (truncated.GetTimestamp (), Time (0), "truncated timestamp ignored");
+  NS_TEST_EXPECT_MSG_EQ (truncated.GetMnIdentifier (), Identifier ("mn1@example"), "preceding options parsed");
+
+  demux->Remove (demux->GetOption (Ipv6MobilityOptionHandoffIndicator::OPT_NUMBER));
+  NS_TEST_EXPECT_MSG_EQ (demux->GetOption (Ipv6MobilityOptionHandoffIndicator::OPT_NUMBER), Ptr<Ipv6MobilityOption> (0), "option removed");
+  NS_TEST_EXPECT_MSG_NE (demux->GetOption (Ipv6MobilityOptionTimestamp::OPT_NUMBER), Ptr<Ipv6MobilityOption> (0), "other options kept");
+
+  node->Dispose ();
+  Simulator::Destroy ();
+}
+
+class Ipv6MobilityMessageTemplateTestCase : public TestCase
+{
+public:
+  Ipv6MobilityMessageTemplateTestCase ();
+private:
+  virtual void DoRun (void);
+  Ptr<Packet> BuildPba (uint8_t status, uint16_t sequence, uint16_t lifetime, Time timestamp);
+  bool SameBytes (Ptr<Packet> a, Ptr<Packet> b);
+};
+
+Ipv6MobilityMessageTemplateTestCase::Ipv6MobilityMessageTemplateTestCase ()
+  : TestCase ("Check that a patched message template matches a serialized message")
+{
+}
+
+Ptr<Packet>
+Ipv6MobilityMessageTemplateTestCase::BuildPba (uint8_t status, uint16_t sequence, uint16_t lifetime, Time timestamp)
+{
+  Ipv6MobilityBindingAckHeader pba;
+  Ipv6MobilityOptionMobileNodeIdentifierHeader nai;
+  Ipv6MobilityOptionHomeNetworkPrefixHeader hnph (Ipv6Address ("2001:db8:1::"), 64);
+  Ipv6MobilityOptionTimestampHeader timestamph;
+
+  pba.SetStatus (status);
+  pba.SetFlagP (true);
+  pba.SetSequence (sequence);
+  pba.SetLifetime (lifetime);
+
+  nai.SetSubtype (1);
+  nai.SetNodeIdentifier (Identifier ("mn1@example"));
+  pba.AddOption (nai);
+  pba.AddOption (hnph);
+
+  timestamph.SetTimestamp (timestamp);
+  pba.AddOption (timestamph);
+
+  Ptr<Packet> p = Create<Packet> ();
+  p->AddHeader (pba);
+
+  return p;
+}
+
+bool
+Ipv6MobilityMessageTemplateTestCase::SameBytes (Ptr<Packet> a, Ptr<Packet> b)
+{
+  uint8_t bufA[256];
+  uint8_t bufB[256];
+
+  if (a->GetSize () != b->GetSize () || a->GetSize () > 256)
+    {
+      return false;
+    }
+
+  a->CopyData (bufA, a->GetSize ());
+  b->CopyData (bufB, b->GetSize ());
+
+  return memcmp (bufA, bufB, a->GetSize ()) == 0;
+}
+
+void
+Ipv6MobilityMessageTemplateTestCase::DoRun (void)
+{
+  Ipv6MobilityMessageTemplate pbaTemplate;
+
+  NS_TEST_EXPECT_MSG_EQ (pbaTemplate.IsEmpty (), true, "empty template");
+
+  pbaTemplate.Set (BuildPba (0, 1, 100, MicroSeconds (1000)));
+  NS_TEST_EXPECT_MSG_EQ (pbaTemplate.IsEmpty (), false, "template kept");
+
+  pbaTemplate.SetStatus (129);
+  pbaTemplate.SetSequence (0xbeef);
+  pbaTemplate.SetLifetime (300);
+  pbaTemplate.SetTimestamp (MicroSeconds (0x0123456789aULL));
+
+  NS_TEST_EXPECT_MSG_EQ (SameBytes (pbaTemplate.CreatePacket (), BuildPba (129, 0xbeef, 300, MicroSeconds (0x0123456789aULL))),
+                         true, "patched PBA identical to a serialized one");
+
+  Ipv6MobilityBindingAckHeader pba;
+  pbaTemplate.CreatePacket ()->RemoveHeader (pba);
+  NS_TEST_EXPECT_MSG_EQ (pba.GetSequence (), 0xbeef, "sequence");
+  NS_TEST_EXPECT_MSG_EQ (pba.GetLifetime (), 300, "lifetime");
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t)pba.GetStatus (), 129, "status");
+
+  pbaTemplate.Clear ();
+  NS_TEST_EXPECT_MSG_EQ (pbaTemplate.IsEmpty (), true, "template cleared");
+}
+
+static class Ipv6MobilityOptionTestSuite : public TestSuite
+{
+public:
+  Ipv6MobilityOptionTestSuite ()
+    : TestSuite ("pmip6-mobility-option", UNIT)
+  {
+    AddTestCase (new Ipv6MobilityOptionParseTestCase ());
+    AddTestCase (new Ipv6MobilityMessageTemplateTestCase ());
+  }
+} g_ipv6MobilityOptionTestSuite;
+
+} // namespace ns3
@@ -0,0 +1,329 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/mac48-address.h"
+#include "ns3/ipv6-route.h"
+#include "ns3/ipv6-header.h"
+#include "ns3/ipv6-l3-protocol.h"
+#include "ns3/ipv6-routing-table-entry.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv6-static-source-routing.h"
+
+namespace ns3 {
+
+/**
+ * Checks Ipv6StaticSourceRouting against the linear search of both
+ * tables it used to do, on random tables with overlapping source and
+ * destination prefixes and metric ties.
+ */
+class Ipv6StaticSourceRoutingLookupTestCase : public TestCase
+{
+public:
+  Ipv6StaticSourceRoutingLookupTestCase ();
+  virtual void DoRun (void);
+
+private:
+  struct FromTo
+  {
+    Ipv6Address network;
+    Ipv6Prefix networkPrefix;
+    Ipv6Address dest;
+    Ipv6Prefix destPrefix;
+    uint32_t interface;
+    uint32_t metric;
+  };
+
+  uint32_t Random (uint32_t max);
+  Ipv6Address RandomAddress (void);
+  Ipv6Prefix RandomPrefix (void);
+  int32_t Reference (Ipv6Address src);
+  int32_t ReferenceFromTo (Ipv6Address src, Ipv6Address dst);
+
+  uint32_t m_seed;
+  Ptr<Ipv6StaticSourceRouting> m_routing;
+  std::vector<FromTo> m_fromTo;
+};
+
+Ipv6StaticSourceRoutingLookupTestCase::Ipv6StaticSourceRoutingLookupTestCase ()
+  : TestCase ("Source routing lookup against the linear search of the tables"),
+    m_seed (1)
+{
+}
+
+uint32_t
+Ipv6StaticSourceRoutingLookupTestCase::Random (uint32_t max)
+{
+  m_seed = m_seed * 1103515245 + 12345;
+  return (m_seed >> 8) % max;
+}
+
+Ipv6Address
+Ipv6StaticSourceRoutingLookupTestCase::RandomAddress (void)
+{
+  /* few different values per byte, so that prefixes overlap */
+  uint8_t buf[16] = { 0x20, 0x01, 0x0d, 0xb8 };
+  for (uint32_t i = 4; i < 16; i++)
+    {
+      buf[i] = Random (3) << (i % 2 ? 0 : 4);
+    }
+  return Ipv6Address (buf);
+}
+
+Ipv6Prefix
+Ipv6StaticSourceRoutingLookupTestCase::RandomPrefix (void)
+{
+  static const uint8_t lengths[] = { 0, 32, 48, 52, 63, 64, 65, 96, 128 };
+  return Ipv6Prefix (lengths[Random (sizeof (lengths))]);
+}
+
+int32_t
+Ipv6StaticSourceRoutingLookupTestCase::Reference (Ipv6Address src)
+{
+  int32_t best = -1;
+  uint16_t longestMask = 0;
+  uint32_t shortestMetric = 0xffffffff;
+
+  for (uint32_t i = 0; i < m_routing->GetNRoutes (); i++)
+    {
+      Ipv6RoutingTableEntry route = m_routing->GetRoute (i);
+      uint32_t metric = m_routing->GetMetric (i);
+      Ipv6Prefix mask = route.GetDestNetworkPrefix ();
+      uint16_t maskLen = mask.GetPrefixLength ();
+
+      if (!mask.IsMatch (src, route.GetDestNetwork ()) || maskLen < longestMask)
+        {
+          continue;
+        }
+      if (maskLen > longestMask)
+        {
+          shortestMetric = 0xffffffff;
+        }
+      longestMask = maskLen;
+      if (metric > shortestMetric)
+        {
+          continue;
+        }
+      shortestMetric = metric;
+      best = i;
+    }
+  return best;
+}
+
+int32_t
+Ipv6StaticSourceRoutingLookupTestCase::ReferenceFromTo (Ipv6Address src, Ipv6Address dst)
+{
+  int32_t best = -1;
+
+  for (uint32_t i = 0; i < m_fromTo.size (); i++)
+    {
+      const FromTo &it = m_fromTo[i];
+      if (!it.networkPrefix.IsMatch (src, it.network) || !it.destPrefix.IsMatch (dst, it.dest))
+        {
+          continue;
+        }
+      if (best >= 0)
+        {
+          const FromTo &b = m_fromTo[best];
+          uint8_t srcLen = it.networkPrefix.GetPrefixLength ();
+          uint8_t bestSrcLen = b.networkPrefix.GetPrefixLength ();
+          uint8_t dstLen = it.destPrefix.GetPrefixLength ();
+          uint8_t bestDstLen = b.destPrefix.GetPrefixLength ();
+
+          if (srcLen < bestSrcLen || (srcLen == bestSrcLen && dstLen < bestDstLen) ||
+              (srcLen == bestSrcLen && dstLen == bestDstLen && it.metric >= b.metric))
+            {
+              continue;
+            }
+        }
+      best = i;
+    }
+  return best;
+}
+
+void
+Ipv6StaticSourceRoutingLookupTestCase::DoRun (void)
+{
+  Config::SetDefault ("ns3::Icmpv6L4Protocol::DAD", BooleanValue (false));
+
+  Ptr<Node> node = CreateObject<Node> ();
+  InternetStackHelper internet;
+  internet.SetIpv4StackInstall (false);
+  internet.Install (node);
+
+  Ptr<Ipv6L3Protocol> ipv6 = node->GetObject<Ipv6L3Protocol> ();
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+      device->SetAddress (Mac48Address::Allocate ());
+      node->AddDevice (device);
+      ipv6->SetUp (ipv6->AddInterface (device));
+    }
+
+  m_routing = CreateObject<Ipv6StaticSourceRouting> ();
+  m_routing->SetIpv6 (ipv6);
+
+  uint32_t found = 0;
+  uint32_t foundFromTo = 0;
+
+  for (uint32_t round = 0; round < 20; round++)
+    {
+      for (uint32_t i = 0; i < 30; i++)
+        {
+          Ipv6Prefix prefix = RandomPrefix ();
+          Ipv6Address network = RandomAddress ().CombinePrefix (prefix);
+          Ipv6Address gateway = Random (2) ? Ipv6Address::GetAny () : RandomAddress ();
+          m_routing->AddNetworkRouteFrom (network, prefix, gateway, 1 + Random (3), Random (3));
+        }
+
+      for (uint32_t i = 0; i < 30; i++)
+        {
+          FromTo route;
+          route.networkPrefix = RandomPrefix ();
+          route.network = RandomAddress ().CombinePrefix (route.networkPrefix);
+          route.destPrefix = RandomPrefix ();
+          route.dest = RandomAddress ().CombinePrefix (route.destPrefix);
+          route.interface = 1 + Random (3);
+          route.metric = Random (3);
+          m_routing->AddNetworkRouteFromTo (route.network, route.networkPrefix, route.dest, route.destPrefix, route.interface, route.metric);
+          m_fromTo.push_back (route);
+        }
+
+      /* remove some routes, by index and by source network */
+      for (uint32_t i = 0; i < 10 && m_routing->GetNRoutes () > 0; i++)
+        {
+          uint32_t index = Random (m_routing->GetNRoutes ());
+          if (Random (2))
+            {
+              m_routing->RemoveRoute (index);
+            }
+          else
+            {
+              Ipv6RoutingTableEntry route = m_routing->GetRoute (index);
+              uint32_t before = m_routing->GetNRoutes ();
+              m_routing->RemoveRoute (route.GetDest (), route.GetDestNetworkPrefix (), route.GetInterface (), route.GetPrefixToUse ());
+              NS_TEST_ASSERT_MSG_EQ (m_routing->GetNRoutes (), before - 1, "Route from " << route.GetDest () << " should be removed");
+            }
+        }
+
+      for (uint32_t i = 0; i < 10 && !m_fromTo.empty (); i++)
+        {
+          uint32_t index = Random (m_fromTo.size ());
+          FromTo route = m_fromTo[index];
+          bool removed = m_routing->RemoveRouteFromTo (route.network, route.networkPrefix, route.dest, route.destPrefix, route.interface);
+          NS_TEST_ASSERT_MSG_EQ (removed, true, "Route from " << route.network << " to " << route.dest << " should be removed");
+
+          /* the first route with the same key is the one removed */
+          for (std::vector<FromTo>::iterator it = m_fromTo.begin (); it != m_fromTo.end (); it++)
+            {
+              if (it->network == route.network && it->networkPrefix == route.networkPrefix &&
+                  it->dest == route.dest && it->destPrefix == route.destPrefix && it->interface == route.interface)
+                {
+                  m_fromTo.erase (it);
+                  break;
+                }
+            }
+        }
+      NS_TEST_ASSERT_MSG_EQ (m_routing->GetNRoutesFromTo (), m_fromTo.size (), "Wrong number of routes from and to networks");
+
+      for (uint32_t i = 0; i < 200; i++)
+        {
+          Ipv6Address src = RandomAddress ();
+          Ipv6Address dst = RandomAddress ();
+          Ipv6Header header;
+          Socket::SocketErrno err;
+          header.SetSourceAddress (src);
+          header.SetDestinationAddress (dst);
+
+          Ptr<Ipv6Route> route = m_routing->RouteOutput (0, header, 0, err);
+          int32_t expectedFromTo = ReferenceFromTo (src, dst);
+          int32_t expected = Reference (src);
+
+          if (expectedFromTo >= 0)
+            {
+              foundFromTo++;
+              const FromTo &entry = m_fromTo[expectedFromTo];
+              NS_TEST_ASSERT_MSG_EQ ((route != 0), true, "A route was expected from " << src << " to " << dst);
+              NS_TEST_ASSERT_MSG_EQ (route->GetSource (), entry.network, "Wrong route from " << src << " to " << dst);
+              NS_TEST_ASSERT_MSG_EQ (route->GetGateway (), Ipv6Address::GetZero (), "Wrong route from " << src << " to " << dst);
+              NS_TEST_ASSERT_MSG_EQ (route->GetOutputDevice (), ipv6->GetNetDevice (entry.interface), "Wrong route from " << src << " to " << dst);
+            }
+          else if (expected >= 0)
+            {
+              found++;
+              Ipv6RoutingTableEntry entry = m_routing->GetRoute (expected);
+              NS_TEST_ASSERT_MSG_EQ ((route != 0), true, "A route was expected from " << src);
+              NS_TEST_ASSERT_MSG_EQ (route->GetSource (), entry.GetDest (), "Wrong route from " << src);
+              NS_TEST_ASSERT_MSG_EQ (route->GetGateway (), entry.GetGateway (), "Wrong route from " << src);
+              NS_TEST_ASSERT_MSG_EQ (route->GetOutputDevice (), ipv6->GetNetDevice (entry.GetInterface ()), "Wrong route from " << src);
+            }
+          else
+            {
+              NS_TEST_ASSERT_MSG_EQ ((route == 0), true, "No route expected from " << src << " to " << dst);
+            }
+        }
+    }
+
+  NS_TEST_EXPECT_MSG_GT (found, 100, "Some lookups should only find a route from the source");
+  NS_TEST_EXPECT_MSG_GT (foundFromTo, 500, "Many lookups should find a route from and to networks");
+
+  NS_TEST_EXPECT_MSG_EQ (m_routing->RemoveRouteFromTo ("2001:db8:ff::", Ipv6Prefix (64), "2001:db8:ff::", Ipv6Prefix (64), 1),
+                         false, "There is no such route");
+
+  /* taking the interfaces down flushes their routes */
+  for (uint32_t i = 1; i < 4; i++)
+    {
+      ipv6->SetDown (i);
+      m_routing->NotifyInterfaceDown (i);
+    }
+  NS_TEST_EXPECT_MSG_EQ (m_routing->GetNRoutes (), 0, "All the routes should be gone");
+  NS_TEST_EXPECT_MSG_EQ (m_routing->GetNRoutesFromTo (), 0, "All the routes from and to networks should be gone");
+
+  Ipv6Header header;
+  Socket::SocketErrno err;
+  header.SetSourceAddress (RandomAddress ());
+  header.SetDestinationAddress (RandomAddress ());
+  NS_TEST_EXPECT_MSG_EQ ((m_routing->RouteOutput (0, header, 0, err) == 0), true, "No route should be left");
+
+  m_routing->Dispose ();
+  m_routing = 0;
+  Simulator::Destroy ();
+}
+
+static class Ipv6StaticSourceRoutingTestSuite : public TestSuite
+{
+public:
+  Ipv6StaticSourceRoutingTestSuite ()
+    : TestSuite ("ipv6-static-source-routing", UNIT)
+  {
+    AddTestCase (new Ipv6StaticSourceRoutingLookupTestCase ());
+  }
+} g_ipv6StaticSourceRoutingTestSuite;
+
+} // namespace ns3
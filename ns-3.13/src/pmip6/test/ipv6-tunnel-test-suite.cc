@@ -0,0 +1,554 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/uinteger.h"
+#include "ns3/socket.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simple-channel.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv6-l3-protocol.h"
+#include "ns3/ipv6-interface.h"
+#include "ns3/ipv6-header.h"
+#include "ns3/ipv6-static-routing-helper.h"
+#include "ns3/ipv6-tunnel-l4-protocol.h"
+#include "ns3/ipv6-tunnel-compressed-header.h"
+
+#include <vector>
+
+namespace ns3 {
+
+class Ipv6TunnelTableTestCase : public TestCase
+{
+public:
+  Ipv6TunnelTableTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+Ipv6TunnelTableTestCase::Ipv6TunnelTableTestCase ()
+  : TestCase ("Check tunnel table reference counting and device recycling")
+{
+}
+
+void
+Ipv6TunnelTableTestCase::DoRun (void)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  InternetStackHelper internet;
+  internet.SetIpv4StackInstall (false);
+  internet.Install (node);
+
+  Ptr<Ipv6TunnelL4Protocol> th = CreateObject<Ipv6TunnelL4Protocol> ();
+  node->AggregateObject (th);
+
+  Ipv6Address mag1 ("2001:db8::1");
+  Ipv6Address mag2 ("2001:db8::2");
+  Ipv6Address mag3 ("2001:db8::3");
+
+  uint16_t if1 = th->AddTunnel (mag1);
+  uint16_t if1b = th->AddTunnel (mag1);
+  uint16_t if2 = th->AddTunnel (mag2);
+
+  NS_TEST_EXPECT_MSG_EQ (if1, if1b, "same end-points share a tunnel");
+  NS_TEST_EXPECT_MSG_NE (if1, if2, "different MAGs use different tunnels");
+  NS_TEST_EXPECT_MSG_EQ (th->GetNTunnels (), 2, "two tunnels");
+  NS_TEST_EXPECT_MSG_EQ (th->GetTunnelDevice (mag1)->GetRefCount (), 2, "two references on mag1");
+
+  // a shared tunnel is not re-addressed, the reference moves
+  uint16_t if3 = th->ModifyTunnel (mag1, mag3);
+  NS_TEST_EXPECT_MSG_NE (if3, if1, "a new tunnel is used for mag3");
+  NS_TEST_EXPECT_MSG_EQ (th->GetTunnelDevice (mag1)->GetRefCount (), 1, "one reference left on mag1");
+
+  // a single reference is re-addressed in place
+  uint16_t if2b = th->ModifyTunnel (mag2, Ipv6Address ("2001:db8::4"));
+  NS_TEST_EXPECT_MSG_EQ (if2b, if2, "tunnel device re-addressed");
+  NS_TEST_EXPECT_MSG_EQ (th->GetTunnelDevice (mag2), Ptr<TunnelNetDevice> (0), "old end-point no longer mapped");
+
+  th->RemoveTunnel (mag1);
+  NS_TEST_EXPECT_MSG_EQ (th->GetTunnelDevice (mag1), Ptr<TunnelNetDevice> (0), "tunnel released");
+  NS_TEST_EXPECT_MSG_EQ (th->GetNFreeTunnels (), 1, "device in the free-list");
+
+  uint16_t if5 = th->AddTunnel (Ipv6Address ("2001:db8::5"));
+  NS_TEST_EXPECT_MSG_EQ (if5, if1, "freed device reused");
+  NS_TEST_EXPECT_MSG_EQ (th->GetNFreeTunnels (), 0, "free-list empty");
+  NS_TEST_EXPECT_MSG_EQ (th->GetNTunnels (), 3, "three tunnels");
+
+  Simulator::Destroy ();
+}
+
+class Ipv6TunnelDecapTestCase : public TestCase
+{
+public:
+  Ipv6TunnelDecapTestCase ();
+private:
+  virtual void DoRun (void);
+  void ReceiveTunnelled (Ptr<Ipv6TunnelL4Protocol> th, Ipv6Address innerDst);
+};
+
+Ipv6TunnelDecapTestCase::Ipv6TunnelDecapTestCase ()
+  : TestCase ("Check the route cache of the decapsulation path")
+{
+}
+
+void
+Ipv6TunnelDecapTestCase::ReceiveTunnelled (Ptr<Ipv6TunnelL4Protocol> th, Ipv6Address innerDst)
+{
+  Ptr<Packet> p = Create<Packet> (100);
+  Ipv6Header inner;
+
+  inner.SetSourceAddress (Ipv6Address ("2001:db8:1::10"));
+  inner.SetDestinationAddress (innerDst);
+  inner.SetNextHeader (59);
+  inner.SetPayloadLength (p->GetSize ());
+  inner.SetHopLimit (64);
+  p->AddHeader (inner);
+
+  th->Receive (p, Ipv6Address ("2001:db8::1"), Ipv6Address ("2001:db8::100"), 0);
+}
+
+void
+Ipv6TunnelDecapTestCase::DoRun (void)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  InternetStackHelper internet;
+  internet.SetIpv4StackInstall (false);
+  internet.Install (node);
+
+  Ptr<Ipv6TunnelL4Protocol> th = CreateObject<Ipv6TunnelL4Protocol> ();
+  node->AggregateObject (th);
+
+  Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice> ();
+  dev->SetAddress (Mac48Address::Allocate ());
+  dev->SetChannel (CreateObject<SimpleChannel> ());
+  node->AddDevice (dev);
+
+  Ptr<Ipv6> ipv6 = node->GetObject<Ipv6> ();
+  uint32_t ifIndex = ipv6->AddInterface (dev);
+  ipv6->AddAddress (ifIndex, Ipv6InterfaceAddress (Ipv6Address ("2001:db8::100"), Ipv6Prefix (64)));
+  ipv6->SetUp (ifIndex);
+
+  Ipv6StaticRoutingHelper routingHelper;
+  routingHelper.GetStaticRouting (ipv6)->AddNetworkRouteTo (Ipv6Address ("2001:db8:2::"), Ipv6Prefix (64), ifIndex);
+
+  th->AddTunnel (Ipv6Address ("2001:db8::1"));
+
+  ReceiveTunnelled (th, Ipv6Address ("2001:db8:2::1"));
+  ReceiveTunnelled (th, Ipv6Address ("2001:db8:2::1"));
+  ReceiveTunnelled (th, Ipv6Address ("ff02::1"));
+
+  Ipv6TunnelL4Protocol::DecapStatistics stats = th->GetDecapStatistics ();
+  NS_TEST_EXPECT_MSG_EQ (stats.packets, 2, "two packets forwarded");
+  NS_TEST_EXPECT_MSG_EQ (stats.dropped, 1, "multicast inner packet not forwarded");
+  NS_TEST_EXPECT_MSG_EQ (stats.routeCacheMisses, 1, "first packet routed");
+  NS_TEST_EXPECT_MSG_EQ (stats.routeCacheHits, 1, "second packet served by the cache");
+
+  TunnelNetDevice::Statistics tstats = th->GetTunnelDevice (Ipv6Address ("2001:db8::1"))->GetStatistics ();
+  NS_TEST_EXPECT_MSG_EQ (tstats.rxPackets, 2, "tunnel rx counter");
+  NS_TEST_EXPECT_MSG_EQ (tstats.rxDropped, 1, "tunnel rx drop counter");
+
+  th->InvalidateRouteCache ();
+  ReceiveTunnelled (th, Ipv6Address ("2001:db8:2::1"));
+  NS_TEST_EXPECT_MSG_EQ (th->GetDecapStatistics ().routeCacheMisses, 2, "cache invalidated");
+
+  Simulator::Destroy ();
+}
+
+/* links a (::1) and b (::2) on prefix, returns the interface of a */
+static uint32_t
+Connect (Ptr<Node> a, Ptr<Node> b, uint16_t mtu, Ipv6Address prefix)
+{
+  Ptr<SimpleChannel> channel = CreateObject<SimpleChannel> ();
+  uint8_t buf[16];
+  uint32_t ifIndex = 0;
+
+  prefix.GetBytes (buf);
+  for (uint8_t i = 0; i < 2; i++)
+    {
+      Ptr<Node> node = i == 0 ? a : b;
+      Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice> ();
+      dev->SetAddress (Mac48Address::Allocate ());
+      dev->SetChannel (channel);
+      dev->SetMtu (mtu);
+      node->AddDevice (dev);
+
+      Ptr<Ipv6> ipv6 = node->GetObject<Ipv6> ();
+      uint32_t index = ipv6->AddInterface (dev);
+      buf[15] = i + 1;
+      ipv6->AddAddress (index, Ipv6InterfaceAddress (Ipv6Address (buf), Ipv6Prefix (64)));
+      ipv6->SetUp (index);
+      if (i == 0)
+        {
+          ifIndex = index;
+        }
+    }
+  return ifIndex;
+}
+
+class Ipv6TunnelMtuTestCase : public TestCase
+{
+public:
+  Ipv6TunnelMtuTestCase ();
+private:
+  virtual void DoRun (void);
+  void SendInner (Ptr<Ipv6L3Protocol> ipv6, uint32_t size);
+};
+
+Ipv6TunnelMtuTestCase::Ipv6TunnelMtuTestCase ()
+  : TestCase ("Check the tunnel MTU derived from the outer path and Packet Too Big")
+{
+}
+
+void
+Ipv6TunnelMtuTestCase::SendInner (Ptr<Ipv6L3Protocol> ipv6, uint32_t size)
+{
+  ipv6->Send (Create<Packet> (size), Ipv6Address ("2001:db8:1::1"), Ipv6Address ("2001:db8:9::1"), 59, 0);
+}
+
+void
+Ipv6TunnelMtuTestCase::DoRun (void)
+{
+  Config::SetDefault ("ns3::Icmpv6L4Protocol::DAD", BooleanValue (false));
+
+  /* mag -- router -- lma, the second link has a smaller MTU */
+  Ptr<Node> mag = CreateObject<Node> ();
+  Ptr<Node> router = CreateObject<Node> ();
+  Ptr<Node> lma = CreateObject<Node> ();
+  InternetStackHelper internet;
+  internet.SetIpv4StackInstall (false);
+  internet.Install (mag);
+  internet.Install (router);
+  internet.Install (lma);
+
+  uint32_t magIf = Connect (mag, router, 1500, Ipv6Address ("2001:db8:1::"));
+  Connect (router, lma, 1400, Ipv6Address ("2001:db8:2::"));
+  Ptr<Ipv6> routerIpv6 = router->GetObject<Ipv6> ();
+  routerIpv6->SetForwarding (1, true);
+  routerIpv6->SetForwarding (2, true);
+
+  Ipv6StaticRoutingHelper routingHelper;
+  Ptr<Ipv6L3Protocol> magIpv6 = mag->GetObject<Ipv6L3Protocol> ();
+  routingHelper.GetStaticRouting (magIpv6)->AddNetworkRouteTo (Ipv6Address ("2001:db8:2::"), Ipv6Prefix (64), Ipv6Address ("2001:db8:1::2"), magIf);
+  routingHelper.GetStaticRouting (lma->GetObject<Ipv6> ())->AddNetworkRouteTo (Ipv6Address ("2001:db8:1::"), Ipv6Prefix (64), Ipv6Address ("2001:db8:2::1"), 1);
+
+  Ptr<Ipv6TunnelL4Protocol> magTh = CreateObject<Ipv6TunnelL4Protocol> ();
+  mag->AggregateObject (magTh);
+  Ptr<Ipv6TunnelL4Protocol> lmaTh = CreateObject<Ipv6TunnelL4Protocol> ();
+  lma->AggregateObject (lmaTh);
+
+  uint16_t tunnelIf = magTh->AddTunnel (Ipv6Address ("2001:db8:2::2"));
+  lmaTh->AddTunnel (Ipv6Address ("2001:db8:1::1"));
+  routingHelper.GetStaticRouting (magIpv6)->AddNetworkRouteTo (Ipv6Address ("2001:db8:9::"), Ipv6Prefix (64), tunnelIf);
+
+  Ptr<TunnelNetDevice> tunnel = magTh->GetTunnelDevice (Ipv6Address ("2001:db8:2::2"));
+  NS_TEST_EXPECT_MSG_EQ (tunnel->GetPathMtu (), 1500, "path MTU taken from the first link");
+  NS_TEST_EXPECT_MSG_EQ (tunnel->GetMtu (), 1460, "room left for the outer header");
+
+  /* full-size inner packet, fragmented before the encapsulation:
+   * the first link is fine, the router answers Packet Too Big */
+  Simulator::Schedule (Seconds (1), &Ipv6TunnelMtuTestCase::SendInner, this, magIpv6, 1460);
+  Simulator::Run ();
+
+  TunnelNetDevice::Statistics stats = tunnel->GetStatistics ();
+  NS_TEST_EXPECT_MSG_EQ (stats.txPackets, 2, "inner packet sent in two fragments");
+  NS_TEST_EXPECT_MSG_EQ (stats.txFragmented, 0, "no outer fragmentation");
+  NS_TEST_EXPECT_MSG_EQ (stats.rxTooBig, 1, "Packet Too Big for the first fragment");
+  NS_TEST_EXPECT_MSG_EQ (tunnel->GetPathMtu (), 1400, "path MTU lowered");
+  NS_TEST_EXPECT_MSG_EQ (tunnel->GetMtu (), 1360, "tunnel MTU lowered");
+  NS_TEST_EXPECT_MSG_EQ (lmaTh->GetDecapStatistics ().packets, 1, "only the last fragment went through");
+
+  Simulator::Schedule (Seconds (2), &Ipv6TunnelMtuTestCase::SendInner, this, magIpv6, 1460);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (lmaTh->GetDecapStatistics ().packets, 3, "both fragments went through");
+  NS_TEST_EXPECT_MSG_EQ (tunnel->GetStatistics ().txFragmented, 0, "still no outer fragmentation");
+
+  /* the path MTU is not lowered under the IPv6 minimum */
+  tunnel->NotifyPacketTooBig (1000);
+  NS_TEST_EXPECT_MSG_EQ (tunnel->GetPathMtu (), 1280, "path MTU floored");
+  NS_TEST_EXPECT_MSG_EQ (tunnel->GetMtu (), 1280, "tunnel MTU floored");
+
+  /* with a fixed MTU the outer packet is fragmented instead */
+  tunnel->SetAttribute ("PathMtuDiscovery", BooleanValue (false));
+  NS_TEST_EXPECT_MSG_EQ (tunnel->GetMtu (), 1500, "fixed MTU");
+  Simulator::Schedule (Seconds (3), &Ipv6TunnelMtuTestCase::SendInner, this, magIpv6, 1460);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (tunnel->GetStatistics ().txFragmented, 1, "outer packet fragmented");
+
+  Simulator::Destroy ();
+  Config::SetDefault ("ns3::Icmpv6L4Protocol::DAD", BooleanValue (true));
+}
+
+class Ipv6TunnelForwardTestCase : public TestCase
+{
+public:
+  Ipv6TunnelForwardTestCase ();
+private:
+  virtual void DoRun (void);
+  void SendFromMn (Ptr<Ipv6L3Protocol> ipv6);
+};
+
+Ipv6TunnelForwardTestCase::Ipv6TunnelForwardTestCase ()
+  : TestCase ("Check full-size packets forwarded into the tunnel across a smaller MTU link")
+{
+}
+
+void
+Ipv6TunnelForwardTestCase::SendFromMn (Ptr<Ipv6L3Protocol> ipv6)
+{
+  ipv6->Send (Create<Packet> (1460), Ipv6Address ("2001:db8:3::2"), Ipv6Address ("2001:db8:9::1"), 59, 0);
+}
+
+void
+Ipv6TunnelForwardTestCase::DoRun (void)
+{
+  Config::SetDefault ("ns3::Icmpv6L4Protocol::DAD", BooleanValue (false));
+
+  /* mn -- mag -- router -- lma, the last link at the IPv6 minimum MTU */
+  Ptr<Node> mn = CreateObject<Node> ();
+  Ptr<Node> mag = CreateObject<Node> ();
+  Ptr<Node> router = CreateObject<Node> ();
+  Ptr<Node> lma = CreateObject<Node> ();
+  InternetStackHelper internet;
+  internet.SetIpv4StackInstall (false);
+  internet.Install (mn);
+  internet.Install (mag);
+  internet.Install (router);
+  internet.Install (lma);
+
+  uint32_t magIf = Connect (mag, router, 1500, Ipv6Address ("2001:db8:1::"));
+  Connect (router, lma, 1280, Ipv6Address ("2001:db8:2::"));
+  Ptr<Ipv6> routerIpv6 = router->GetObject<Ipv6> ();
+  routerIpv6->SetForwarding (1, true);
+  routerIpv6->SetForwarding (2, true);
+
+  uint32_t accessIf = Connect (mag, mn, 1500, Ipv6Address ("2001:db8:3::"));
+  Ptr<Ipv6L3Protocol> magIpv6 = mag->GetObject<Ipv6L3Protocol> ();
+  magIpv6->SetForwarding (accessIf, true);
+
+  Ipv6StaticRoutingHelper routingHelper;
+  Ptr<Ipv6L3Protocol> mnIpv6 = mn->GetObject<Ipv6L3Protocol> ();
+  routingHelper.GetStaticRouting (mnIpv6)->AddNetworkRouteTo (Ipv6Address ("2001:db8:9::"), Ipv6Prefix (64), Ipv6Address ("2001:db8:3::1"), 1);
+  routingHelper.GetStaticRouting (magIpv6)->AddNetworkRouteTo (Ipv6Address ("2001:db8:2::"), Ipv6Prefix (64), Ipv6Address ("2001:db8:1::2"), magIf);
+  routingHelper.GetStaticRouting (lma->GetObject<Ipv6> ())->AddNetworkRouteTo (Ipv6Address ("2001:db8:1::"), Ipv6Prefix (64), Ipv6Address ("2001:db8:2::1"), 1);
+
+  Ptr<Ipv6TunnelL4Protocol> magTh = CreateObject<Ipv6TunnelL4Protocol> ();
+  mag->AggregateObject (magTh);
+  Ptr<Ipv6TunnelL4Protocol> lmaTh = CreateObject<Ipv6TunnelL4Protocol> ();
+  lma->AggregateObject (lmaTh);
+
+  uint16_t tunnelIf = magTh->AddTunnel (Ipv6Address ("2001:db8:2::2"));
+  lmaTh->AddTunnel (Ipv6Address ("2001:db8:1::1"));
+  routingHelper.GetStaticRouting (magIpv6)->AddNetworkRouteTo (Ipv6Address ("2001:db8:9::"), Ipv6Prefix (64), tunnelIf);
+
+  Ptr<TunnelNetDevice> tunnel = magTh->GetTunnelDevice (Ipv6Address ("2001:db8:2::2"));
+  NS_TEST_EXPECT_MSG_EQ (tunnel->GetMtu (), 1460, "tunnel MTU derived from the first link");
+
+  /* the MN does not know the tunnel MTU: the MAG encapsulates its
+   * 1500-byte packet and fragments the outer packet to the first link,
+   * the router answers Packet Too Big for the first fragment */
+  Simulator::Schedule (Seconds (1), &Ipv6TunnelForwardTestCase::SendFromMn, this, mnIpv6);
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (tunnel->GetStatistics ().txPackets, 1, "forwarded into the tunnel whole");
+  NS_TEST_EXPECT_MSG_EQ (tunnel->GetStatistics ().txFragmented, 1, "outer packet fragmented");
+  NS_TEST_EXPECT_MSG_EQ (tunnel->GetStatistics ().rxTooBig, 1, "Packet Too Big behind the fragment header");
+  NS_TEST_EXPECT_MSG_EQ (tunnel->GetPathMtu (), 1280, "path MTU lowered");
+  NS_TEST_EXPECT_MSG_EQ (magIpv6->GetPmtu (Ipv6Address ("2001:db8:2::2")), 1280, "path MTU to the LMA");
+  NS_TEST_EXPECT_MSG_EQ (lmaTh->GetDecapStatistics ().packets, 0, "first packet lost");
+
+  /* the next outer packets are fragmented to the path MTU */
+  Simulator::Schedule (Seconds (2), &Ipv6TunnelForwardTestCase::SendFromMn, this, mnIpv6);
+  Simulator::Schedule (Seconds (3), &Ipv6TunnelForwardTestCase::SendFromMn, this, mnIpv6);
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (tunnel->GetStatistics ().rxTooBig, 1, "no more Packet Too Big");
+  NS_TEST_EXPECT_MSG_EQ (lmaTh->GetDecapStatistics ().packets, 2, "packets reached the LMA");
+
+  Simulator::Destroy ();
+  Config::SetDefault ("ns3::Icmpv6L4Protocol::DAD", BooleanValue (true));
+}
+
+class Ipv6TunnelCompressionTestCase : public TestCase
+{
+public:
+  Ipv6TunnelCompressionTestCase ();
+private:
+  virtual void DoRun (void);
+  void SendInner (Ptr<Ipv6L3Protocol> ipv6, uint8_t hopLimit, Ipv6Address dst);
+  void Decapsulated (const Ipv6Address &remote, const Ipv6Header &inner);
+  std::vector<Ipv6Header> m_inner;
+};
+
+Ipv6TunnelCompressionTestCase::Ipv6TunnelCompressionTestCase ()
+  : TestCase ("Check the compression of the inner header")
+{
+}
+
+void
+Ipv6TunnelCompressionTestCase::SendInner (Ptr<Ipv6L3Protocol> ipv6, uint8_t hopLimit, Ipv6Address dst)
+{
+  Ptr<Packet> p = Create<Packet> (100);
+  SocketIpTtlTag tag;
+
+  tag.SetTtl (hopLimit);
+  p->AddPacketTag (tag);
+  ipv6->Send (p, Ipv6Address ("2001:db8:1::1"), dst, 59, 0);
+}
+
+void
+Ipv6TunnelCompressionTestCase::Decapsulated (const Ipv6Address &remote, const Ipv6Header &inner)
+{
+  m_inner.push_back (inner);
+}
+
+void
+Ipv6TunnelCompressionTestCase::DoRun (void)
+{
+  Config::SetDefault ("ns3::Icmpv6L4Protocol::DAD", BooleanValue (false));
+
+  Ptr<Node> mag = CreateObject<Node> ();
+  Ptr<Node> lma = CreateObject<Node> ();
+  InternetStackHelper internet;
+  internet.SetIpv4StackInstall (false);
+  internet.Install (mag);
+  internet.Install (lma);
+
+  Connect (mag, lma, 1500, Ipv6Address ("2001:db8:1::"));
+
+  Ptr<Ipv6TunnelL4Protocol> magTh = CreateObject<Ipv6TunnelL4Protocol> ();
+  mag->AggregateObject (magTh);
+  Ptr<Ipv6TunnelL4Protocol> lmaTh = CreateObject<Ipv6TunnelL4Protocol> ();
+  lma->AggregateObject (lmaTh);
+
+  uint16_t tunnelIf = magTh->AddTunnel (Ipv6Address ("2001:db8:1::2"));
+  lmaTh->AddTunnel (Ipv6Address ("2001:db8:1::1"));
+  lmaTh->SetDecapCallback (MakeCallback (&Ipv6TunnelCompressionTestCase::Decapsulated, this));
+
+  Ptr<Ipv6L3Protocol> magIpv6 = mag->GetObject<Ipv6L3Protocol> ();
+  Ipv6StaticRoutingHelper routingHelper;
+  routingHelper.GetStaticRouting (magIpv6)->AddNetworkRouteTo (Ipv6Address ("2001:db8:9::"), Ipv6Prefix (64), tunnelIf);
+
+  Ptr<TunnelNetDevice> tunnel = magTh->GetTunnelDevice (Ipv6Address ("2001:db8:1::2"));
+  tunnel->SetAttribute ("HeaderCompression", BooleanValue (true));
+  tunnel->SetAttribute ("CompressionRefresh", UintegerValue (4));
+  tunnel->SetAttribute ("CompressionContexts", UintegerValue (1));
+  NS_TEST_EXPECT_MSG_EQ (tunnel->GetMtu (), 1458, "room left for the outer header and an IR");
+
+  /* IR, IR, IR, CO, CO, CO, IR, CO, then a CO with its hop limit */
+  Ipv6Address cn1 ("2001:db8:9::1");
+  for (uint32_t i = 0; i < 8; i++)
+    {
+      Simulator::Schedule (Seconds (1), &Ipv6TunnelCompressionTestCase::SendInner, this, magIpv6, 64, cn1);
+    }
+  Simulator::Schedule (Seconds (2), &Ipv6TunnelCompressionTestCase::SendInner, this, magIpv6, 10, cn1);
+  Simulator::Run ();
+
+  TunnelNetDevice::Statistics stats = tunnel->GetStatistics ();
+  NS_TEST_EXPECT_MSG_EQ (stats.txPackets, 9, "nine packets sent");
+  NS_TEST_EXPECT_MSG_EQ (stats.txCompressed, 5, "three IR packets at first, one refresh");
+  NS_TEST_EXPECT_MSG_EQ (stats.txBytes, 4 * 142 + 4 * 102 + 103, "compressed sizes");
+
+  NS_TEST_EXPECT_MSG_EQ (lmaTh->GetDecapStatistics ().packets, 9, "nine packets decapsulated");
+  NS_TEST_EXPECT_MSG_EQ (lmaTh->GetDecapStatistics ().bytes, 900, "payloads restored");
+  NS_TEST_ASSERT_MSG_EQ (m_inner.size (), 9, "nine inner headers");
+  NS_TEST_EXPECT_MSG_EQ (m_inner[3].GetSourceAddress (), Ipv6Address ("2001:db8:1::1"), "inner source restored");
+  NS_TEST_EXPECT_MSG_EQ (m_inner[3].GetDestinationAddress (), cn1, "inner destination restored");
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t)m_inner[3].GetNextHeader (), 59, "inner next header restored");
+  NS_TEST_EXPECT_MSG_EQ (m_inner[3].GetPayloadLength (), 100, "inner payload length restored");
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t)m_inner[7].GetHopLimit (), 64, "hop limit of the context");
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t)m_inner[8].GetHopLimit (), 10, "hop limit carried by the CO");
+
+  /* a second flow does not evict the context of the first one while it
+   * is in use, it is sent uncompressed; once the first flow is idle,
+   * the context is reused with a new generation */
+  Ipv6Address cn2 ("2001:db8:9::2");
+  Simulator::Schedule (Seconds (3), &Ipv6TunnelCompressionTestCase::SendInner, this, magIpv6, 64, cn2);
+  Simulator::Schedule (Seconds (3), &Ipv6TunnelCompressionTestCase::SendInner, this, magIpv6, 64, cn2);
+  Simulator::Schedule (Seconds (3), &Ipv6TunnelCompressionTestCase::SendInner, this, magIpv6, 64, cn1);
+  Simulator::Run ();
+
+  stats = tunnel->GetStatistics ();
+  NS_TEST_EXPECT_MSG_EQ (stats.txCompressed, 5, "no CO for the new flows");
+  NS_TEST_EXPECT_MSG_EQ (stats.txBytes, 4 * 142 + 4 * 102 + 103 + 140 + 142 + 140, "uncompressed, IR, uncompressed");
+  NS_TEST_ASSERT_MSG_EQ (m_inner.size (), 12, "all decapsulated");
+  NS_TEST_EXPECT_MSG_EQ (m_inner[9].GetDestinationAddress (), cn2, "uncompressed packet of the second flow");
+  NS_TEST_EXPECT_MSG_EQ (m_inner[10].GetDestinationAddress (), cn2, "context reused by the second flow");
+  NS_TEST_EXPECT_MSG_EQ (m_inner[11].GetDestinationAddress (), cn1, "first flow, now uncompressed");
+
+  /* a CO whose IR was lost is dropped */
+  Ptr<TunnelNetDevice> lmaTunnel = lmaTh->GetTunnelDevice (Ipv6Address ("2001:db8:1::1"));
+  Ptr<Packet> p = Create<Packet> (10);
+  Ipv6TunnelCompressedHeader co;
+  Ipv6Header inner;
+
+  co.SetContextId (9);
+  p->AddHeader (co);
+  NS_TEST_EXPECT_MSG_EQ (lmaTunnel->Decompress (p, inner), false, "unknown context");
+  NS_TEST_EXPECT_MSG_EQ (lmaTunnel->GetStatistics ().rxContextErrors, 1, "context error counted");
+
+  /* and so is a CO of a reused context whose IR was lost, rather than
+   * restored with the addresses of the former flow */
+  Ipv6TunnelCompressedHeader ir;
+  inner.SetSourceAddress (Ipv6Address ("2001:db8:1::1"));
+  inner.SetDestinationAddress (cn1);
+  ir.SetContextId (9);
+  ir.SetGeneration (1);
+  ir.SetInnerHeader (inner);
+  p = Create<Packet> (10);
+  p->AddHeader (ir);
+  NS_TEST_EXPECT_MSG_EQ (lmaTunnel->Decompress (p, inner), true, "IR of the first flow");
+
+  co.SetGeneration (2);
+  p = Create<Packet> (10);
+  p->AddHeader (co);
+  NS_TEST_EXPECT_MSG_EQ (lmaTunnel->Decompress (p, inner), false, "CO of the next generation");
+  NS_TEST_EXPECT_MSG_EQ (lmaTunnel->GetStatistics ().rxContextErrors, 2, "context error counted");
+
+  co.SetGeneration (1);
+  p = Create<Packet> (10);
+  p->AddHeader (co);
+  NS_TEST_EXPECT_MSG_EQ (lmaTunnel->Decompress (p, inner), true, "CO of the context generation");
+
+  Simulator::Destroy ();
+  Config::SetDefault ("ns3::Icmpv6L4Protocol::DAD", BooleanValue (true));
+}
+
+static class Ipv6TunnelTestSuite : public TestSuite
+{
+public:
+  Ipv6TunnelTestSuite ()
+    : TestSuite ("pmip6-tunnel", UNIT)
+  {
+    AddTestCase (new Ipv6TunnelTableTestCase ());
+    AddTestCase (new Ipv6TunnelDecapTestCase ());
+    AddTestCase (new Ipv6TunnelMtuTestCase ());
+    AddTestCase (new Ipv6TunnelForwardTestCase ());
+    AddTestCase (new Ipv6TunnelCompressionTestCase ());
+  }
+} g_ipv6TunnelTestSuite;
+
+} // namespace ns3
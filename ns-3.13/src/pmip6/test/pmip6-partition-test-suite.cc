@@ -0,0 +1,155 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv6-address.h"
+#include "ns3/ipv6-mobility-header.h"
+#include "ns3/pmip6-helper.h"
+#include "ns3/pmip6-partition-helper.h"
+#include "ns3/pmipv6-mag.h"
+#include "ns3/pmipv6-lma.h"
+#include "ns3/pmipv6-mag-notifier.h"
+
+namespace ns3 {
+
+class Pmip6PartitionRankTestCase : public TestCase
+{
+public:
+  Pmip6PartitionRankTestCase ()
+    : TestCase ("The LMAs and MAG clusters are spread over the ranks in contiguous blocks")
+  {
+  }
+
+private:
+  virtual void DoRun (void);
+};
+
+void
+Pmip6PartitionRankTestCase::DoRun (void)
+{
+  Pmip6PartitionHelper partition;
+
+  NS_TEST_EXPECT_MSG_EQ (partition.GetMagRank (9, 10), 0, "a single rank");
+
+  partition.SetNRanks (4);
+
+  NS_TEST_EXPECT_MSG_EQ (partition.GetLmaRank (0, 2), 0, "first LMA");
+  NS_TEST_EXPECT_MSG_EQ (partition.GetLmaRank (1, 2), 2, "second LMA, spread");
+  NS_TEST_EXPECT_MSG_EQ (partition.GetMagRank (0, 10), 0, "first MAG");
+  NS_TEST_EXPECT_MSG_EQ (partition.GetMagRank (2, 10), 0, "block of the first rank");
+  NS_TEST_EXPECT_MSG_EQ (partition.GetMagRank (3, 10), 1, "block of the second rank");
+  NS_TEST_EXPECT_MSG_EQ (partition.GetMagRank (9, 10), 3, "last MAG");
+
+  // clusters of 3 MAGs, 4 clusters for 10 MAGs
+  partition.SetMagClusterSize (3);
+
+  NS_TEST_EXPECT_MSG_EQ (partition.GetMagRank (2, 10), 0, "first cluster");
+  NS_TEST_EXPECT_MSG_EQ (partition.GetMagRank (3, 10), 1, "second cluster");
+  NS_TEST_EXPECT_MSG_EQ (partition.GetMagRank (5, 10), 1, "second cluster");
+  NS_TEST_EXPECT_MSG_EQ (partition.GetMagRank (9, 10), 3, "last cluster");
+
+  NodeContainer mags = partition.CreateMags (10);
+
+  for (uint32_t i = 0; i < mags.GetN (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (mags.Get (i)->GetSystemId (), partition.GetMagRank (i, 10), "system id of the MAG");
+    }
+
+  NodeContainer lmas = partition.CreateLmas (2);
+
+  NS_TEST_EXPECT_MSG_EQ (lmas.Get (1)->GetSystemId (), 2, "system id of the LMA");
+  NS_TEST_EXPECT_MSG_EQ (Pmip6PartitionHelper::IsLocal (lmas.Get (0)), true, "LMA of this rank");
+  NS_TEST_EXPECT_MSG_EQ (Pmip6PartitionHelper::IsLocal (lmas.Get (1)), false, "LMA of another rank");
+
+  Simulator::Destroy ();
+}
+
+class Pmip6PartitionInstallTestCase : public TestCase
+{
+public:
+  Pmip6PartitionInstallTestCase ()
+    : TestCase ("The agents are only installed on the nodes of the local rank")
+  {
+  }
+
+private:
+  virtual void DoRun (void);
+};
+
+void
+Pmip6PartitionInstallTestCase::DoRun (void)
+{
+  Pmip6PartitionHelper partition;
+
+  partition.SetNRanks (2);
+
+  NodeContainer lmas = partition.CreateLmas (2);
+  NodeContainer mags = partition.CreateMags (2);
+  NodeContainer aps;
+
+  // an access point of each MAG, on its rank
+  aps.Add (CreateObject<Node> (mags.Get (0)->GetSystemId ()));
+  aps.Add (CreateObject<Node> (mags.Get (1)->GetSystemId ()));
+
+  InternetStackHelper internet;
+  internet.Install (lmas);
+  internet.Install (mags);
+  internet.Install (aps);
+
+  Pmip6ProfileHelper profile;
+  Pmip6LmaHelper lmaHelper;
+  Pmip6MagHelper magHelper;
+
+  lmaHelper.SetProfileHelper (&profile);
+  magHelper.SetProfileHelper (&profile);
+
+  lmaHelper.Install (lmas.Get (0));
+  lmaHelper.Install (lmas.Get (1));
+  magHelper.Install (mags.Get (0), Ipv6Address::GetAny (), NodeContainer (aps.Get (0)));
+  magHelper.Install (mags.Get (1), Ipv6Address::GetAny (), NodeContainer (aps.Get (1)));
+
+  NS_TEST_EXPECT_MSG_NE (lmas.Get (0)->GetObject<Pmipv6Lma> (), 0, "LMA of this rank");
+  NS_TEST_EXPECT_MSG_EQ (lmas.Get (1)->GetObject<Pmipv6Lma> (), 0, "LMA of another rank");
+  NS_TEST_EXPECT_MSG_NE (mags.Get (0)->GetObject<Pmipv6Mag> (), 0, "MAG of this rank");
+  NS_TEST_EXPECT_MSG_EQ (mags.Get (1)->GetObject<Pmipv6Mag> (), 0, "MAG of another rank");
+  NS_TEST_EXPECT_MSG_NE (aps.Get (0)->GetObject<Pmipv6MagNotifier> (), 0, "access point of this rank");
+  NS_TEST_EXPECT_MSG_EQ (aps.Get (1)->GetObject<Pmipv6MagNotifier> (), 0, "access point of another rank");
+
+  Simulator::Destroy ();
+}
+
+static class Pmip6PartitionTestSuite : public TestSuite
+{
+public:
+  Pmip6PartitionTestSuite ()
+    : TestSuite ("pmip6-partition", UNIT)
+  {
+    AddTestCase (new Pmip6PartitionRankTestCase ());
+    AddTestCase (new Pmip6PartitionInstallTestCase ());
+  }
+} g_pmip6PartitionTestSuite;
+
+} // namespace ns3
@@ -1,67 +1,1310 @@
-/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
 
-// Include a header file from your module to test.
-#include "ns3/pmip6.h"
+#include <list>
+#include <fstream>
+#include <sstream>
 
-// An essential include is test.h
 #include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simple-channel.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv6-address-helper.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/pmip6-helper.h"
+#include "ns3/pmip6-stats-helper.h"
+#include "ns3/pmipv6-mag-notifier.h"
+#include "ns3/pmipv6-attachment-replay.h"
+#include "ns3/pmipv6-prefix-routing-helper.h"
+#include "ns3/ipv6-tunnel-l4-protocol.h"
+#include "ns3/tunnel-net-device.h"
+#include "ns3/ipv6-mobility-header.h"
+#include "ns3/ipv6-mobility-option-header.h"
+#include "ns3/pmipv6-mag.h"
+#include "ns3/pmipv6-lma.h"
+#include "ns3/ipv6-static-source-routing-helper.h"
+#include "ns3/ipv6-static-source-routing.h"
+#include "ns3/pmipv6-handover-buffer.h"
+#include "ns3/pmipv6-processor.h"
+#include "ns3/pmipv6-lma-pool.h"
+#include "ns3/ipv6-header.h"
+#include "ns3/nstime.h"
+#include "ns3/identifier.h"
 
-// Do not put your test classes in namespace ns3.  You may find it useful
-// to use the using directive to access the ns3 namespace directly
-using namespace ns3;
+namespace ns3 {
 
-// This is an example TestCase.
-class Pmip6TestCase1 : public TestCase
+/*
+ * An LMA linked to two MAGs, a mobile node attaching to the first MAG
+ * and handing over to the second one and back.
+ */
+class Pmip6HandoverTestCase : public TestCase
 {
 public:
-  Pmip6TestCase1 ();
-  virtual ~Pmip6TestCase1 ();
+  Pmip6HandoverTestCase ();
+protected:
+  Pmip6HandoverTestCase (std::string name);
+  void Setup (void);
+  void Attach (uint32_t mag);
+  void Check (uint32_t mag);
 
+  NodeContainer m_mags;
+  Ptr<Node> m_lma;
+  Mac48Address m_mnMac;
+  Mac48Address m_access[2];
+  uint32_t m_accessIf[2];
+  Ipv6Address m_magAddress[2];
+  Ipv6Address m_hnp;
+  Mac48Address m_cnMac;         //!< correspondent mobile node, attached by the test cases needing it
+  Ipv6Address m_cnHnp;
 private:
   virtual void DoRun (void);
 };
 
-// Add some help text to this case to describe what it is intended to test
-Pmip6TestCase1::Pmip6TestCase1 ()
-  : TestCase ("Pmip6 test case (does nothing)")
+Pmip6HandoverTestCase::Pmip6HandoverTestCase ()
+  : TestCase ("Check the bindings and routes of a mobile node handing over between two MAGs")
 {
 }
 
-// This destructor does nothing but we include it as a reminder that
-// the test case should clean up after itself
-Pmip6TestCase1::~Pmip6TestCase1 ()
+Pmip6HandoverTestCase::Pmip6HandoverTestCase (std::string name)
+  : TestCase (name)
 {
 }
 
-//
-// This method is the pure virtual method from class TestCase that every
-// TestCase must implement
-//
 void
-Pmip6TestCase1::DoRun (void)
+Pmip6HandoverTestCase::Attach (uint32_t mag)
 {
-  // A wide variety of test macros are available in src/core/test.h
-  NS_TEST_ASSERT_MSG_EQ (true, true, "true doesn't equal true for some reason");
-  // Use this one for floating point comparisons
-  NS_TEST_ASSERT_MSG_EQ_TOL (0.01, 0.01, 0.001, "Numbers are not equal within tolerance");
+  m_mags.Get (mag)->GetObject<Pmipv6MagNotifier> ()->NotifyNewNode (m_mnMac, m_access[mag], Ipv6MobilityHeader::OPT_ATT_IEEE_802_11ABG);
 }
 
-// The TestSuite class names the TestSuite, identifies what type of TestSuite,
-// and enables the TestCases to be run.  Typically, only the constructor for
-// this class must be defined
-//
-class Pmip6TestSuite : public TestSuite
+void
+Pmip6HandoverTestCase::Check (uint32_t mag)
+{
+  Pmipv6PrefixRoutingHelper prefixRoutingHelper;
+  Ptr<Ipv6> ipv6 = m_lma->GetObject<Ipv6> ();
+  Ptr<Pmipv6PrefixRouting> lmaRouting = prefixRoutingHelper.GetPrefixRouting (ipv6);
+  Ptr<Pmipv6PrefixRouting> magRouting = prefixRoutingHelper.GetPrefixRouting (m_mags.Get (mag)->GetObject<Ipv6> ());
+  Ptr<TunnelNetDevice> tunnel = m_lma->GetObject<Ipv6TunnelL4Protocol> ()->GetTunnelDevice (m_magAddress[mag]);
+
+  int32_t tunnelIf = lmaRouting->LookupPrefix (m_hnp);
+
+  NS_TEST_ASSERT_MSG_NE (tunnelIf, -1, "LMA routes the home network prefix");
+  NS_TEST_EXPECT_MSG_EQ (lmaRouting->GetNRoutes (), 1, "a single binding on the LMA");
+  NS_TEST_EXPECT_MSG_EQ (ipv6->GetNetDevice (tunnelIf), tunnel, "through the tunnel to the serving MAG");
+  NS_TEST_EXPECT_MSG_EQ (magRouting->LookupPrefix (m_hnp), (int32_t)m_accessIf[mag], "MAG routes the prefix to the access link");
+}
+
+void
+Pmip6HandoverTestCase::Setup (void)
+{
+  m_lma = CreateObject<Node> ();
+  m_mags.Create (2);
+
+  InternetStackHelper internet;
+  internet.Install (m_lma);
+  internet.Install (m_mags);
+
+  PointToPointHelper p2p;
+  Ipv6AddressHelper address;
+  Ipv6Address lmaAddress;
+
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      uint8_t buf[16] = { 0x3f, 0xfe, 0x00, 0x02, 0x00, (uint8_t)i };
+
+      NetDeviceContainer devs = p2p.Install (m_lma, m_mags.Get (i));
+
+      address.NewNetwork (Ipv6Address (buf), Ipv6Prefix (64));
+      Ipv6InterfaceContainer ifs = address.Assign (devs);
+      ifs.SetRouter (0, true);
+      m_magAddress[i] = ifs.GetAddress (1, 1);
+
+      if (i == 0)
+        {
+          lmaAddress = ifs.GetAddress (0, 1);
+        }
+    }
+
+  m_mnMac = Mac48Address::Allocate ();
+  m_hnp = Ipv6Address ("3ffe:1:4:1::");
+  m_cnMac = Mac48Address::Allocate ();
+  m_cnHnp = Ipv6Address ("3ffe:1:4:2::");
+
+  Pmip6ProfileHelper profile;
+  std::list<Ipv6Address> hnps;
+
+  hnps.push_back (m_hnp);
+  profile.AddProfile (Identifier ("mn@pmip6.test"), Identifier (m_mnMac), lmaAddress, hnps);
+
+  hnps.clear ();
+  hnps.push_back (m_cnHnp);
+  profile.AddProfile (Identifier ("cn@pmip6.test"), Identifier (m_cnMac), lmaAddress, hnps);
+
+  Pmip6LmaHelper lmaHelper;
+  lmaHelper.SetPrefixPoolBase (Ipv6Address ("3ffe:1:4::"), 48);
+  lmaHelper.SetProfileHelper (&profile);
+  lmaHelper.Install (m_lma);
+
+  Pmip6MagHelper magHelper;
+  magHelper.SetProfileHelper (&profile);
+
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      magHelper.Install (m_mags.Get (i), Ipv6Address::GetAny (), NodeContainer ());
+
+      Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice> ();
+      m_access[i] = Mac48Address::Allocate ();
+      dev->SetAddress (m_access[i]);
+      dev->SetChannel (CreateObject<SimpleChannel> ());
+      m_mags.Get (i)->AddDevice (dev);
+
+      Ptr<Ipv6> ipv6 = m_mags.Get (i)->GetObject<Ipv6> ();
+      m_accessIf[i] = ipv6->AddInterface (dev);
+      ipv6->SetUp (m_accessIf[i]);
+      ipv6->SetForwarding (m_accessIf[i], true);
+    }
+}
+
+void
+Pmip6HandoverTestCase::DoRun (void)
+{
+  Setup ();
+
+  Simulator::Schedule (Seconds (1.5), &Pmip6HandoverTestCase::Attach, this, 0);
+  Simulator::Schedule (Seconds (2.0), &Pmip6HandoverTestCase::Check, this, 0);
+  Simulator::Schedule (Seconds (3.0), &Pmip6HandoverTestCase::Attach, this, 1);
+  Simulator::Schedule (Seconds (3.5), &Pmip6HandoverTestCase::Check, this, 1);
+  Simulator::Schedule (Seconds (4.5), &Pmip6HandoverTestCase::Attach, this, 0);
+  Simulator::Schedule (Seconds (5.0), &Pmip6HandoverTestCase::Check, this, 0);
+
+  Simulator::Stop (Seconds (6.0));
+  Simulator::Run ();
+
+  Simulator::Destroy ();
+}
+
+/*
+ * The same network driven by an attachment trace: the mobile node
+ * leaves the first MAG before attaching to the second one, then leaves
+ * the second one for good.
+ */
+class Pmip6ReplayTestCase : public Pmip6HandoverTestCase
 {
 public:
-  Pmip6TestSuite ();
+  Pmip6ReplayTestCase ();
+private:
+  virtual void DoRun (void);
+  void CheckDetached (uint32_t mag);
+  void CheckDeregistered (void);
 };
 
-Pmip6TestSuite::Pmip6TestSuite ()
-  : TestSuite ("pmip6", UNIT)
+Pmip6ReplayTestCase::Pmip6ReplayTestCase ()
+  : Pmip6HandoverTestCase ("Check the bindings of a mobile node replayed from an attachment trace")
+{
+}
+
+void
+Pmip6ReplayTestCase::CheckDetached (uint32_t mag)
 {
-  AddTestCase (new Pmip6TestCase1);
+  Pmipv6PrefixRoutingHelper prefixRoutingHelper;
+  Ptr<Pmipv6PrefixRouting> magRouting = prefixRoutingHelper.GetPrefixRouting (m_mags.Get (mag)->GetObject<Ipv6> ());
+
+  NS_TEST_EXPECT_MSG_EQ (magRouting->LookupPrefix (m_hnp), -1, "MAG no longer routes the prefix of a detached node");
+}
+
+void
+Pmip6ReplayTestCase::CheckDeregistered (void)
+{
+  Pmipv6PrefixRoutingHelper prefixRoutingHelper;
+  Ptr<Pmipv6PrefixRouting> lmaRouting = prefixRoutingHelper.GetPrefixRouting (m_lma->GetObject<Ipv6> ());
+
+  NS_TEST_EXPECT_MSG_EQ (lmaRouting->GetNRoutes (), 0, "binding deleted on the LMA");
+}
+
+void
+Pmip6ReplayTestCase::DoRun (void)
+{
+  Setup ();
+
+  std::string fileName = CreateTempDirFilename ("pmip6-attachments.txt");
+  std::ofstream trace (fileName.c_str ());
+
+  trace << "# time event mn mag [att]" << std::endl
+        << "1.5 attach " << m_mnMac << " 0" << std::endl
+        << "3.0 detach " << m_mnMac << " 0" << std::endl
+        << "3.1 attach " << m_mnMac << " 7" << std::endl
+        << std::endl
+        << "3.1 attach " << m_mnMac << " 1 4" << std::endl
+        << "4.5 detach " << m_mnMac << " 1" << std::endl;
+  trace.close ();
+
+  Ptr<Pmipv6AttachmentReplay> replay = CreateObject<Pmipv6AttachmentReplay> ();
+
+  replay->AddMag (m_mags.Get (0), m_access[0]);
+  replay->AddMag (m_mags.Get (1), m_access[1]);
+
+  NS_TEST_ASSERT_MSG_EQ (replay->Open (fileName), true, "trace opened");
+
+  Simulator::Schedule (Seconds (2.0), &Pmip6ReplayTestCase::Check, this, 0);
+  Simulator::Schedule (Seconds (3.05), &Pmip6ReplayTestCase::CheckDetached, this, 0);
+  Simulator::Schedule (Seconds (3.6), &Pmip6ReplayTestCase::Check, this, 1);
+  Simulator::Schedule (Seconds (5.0), &Pmip6ReplayTestCase::CheckDetached, this, 1);
+  Simulator::Schedule (Seconds (16.0), &Pmip6ReplayTestCase::CheckDeregistered, this);
+
+  Simulator::Stop (Seconds (17.0));
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (replay->GetNAttachments (), 2, "attachments replayed");
+  NS_TEST_EXPECT_MSG_EQ (replay->GetNDetachments (), 2, "detachments replayed");
+  NS_TEST_EXPECT_MSG_EQ (replay->GetNErrors (), 1, "record with an unknown MAG skipped");
+
+  replay->Dispose ();
+  Simulator::Destroy ();
+}
+
+/*
+ * A mobile node leaving its MAG and attaching again to it before the
+ * PBA of its deregistration arrived.
+ */
+class Pmip6ReattachTestCase : public Pmip6HandoverTestCase
+{
+public:
+  Pmip6ReattachTestCase ();
+private:
+  virtual void DoRun (void);
+  void Detach (uint32_t mag);
+};
+
+Pmip6ReattachTestCase::Pmip6ReattachTestCase ()
+  : Pmip6HandoverTestCase ("Check a mobile node attaching again before its deregistration is acknowledged")
+{
+}
+
+void
+Pmip6ReattachTestCase::Detach (uint32_t mag)
+{
+  m_mags.Get (mag)->GetObject<Pmipv6MagNotifier> ()->NotifyDetachedNode (m_mnMac, m_access[mag]);
+}
+
+void
+Pmip6ReattachTestCase::DoRun (void)
+{
+  Setup ();
+
+  Simulator::Schedule (Seconds (1.5), &Pmip6ReattachTestCase::Attach, this, 0);
+  Simulator::Schedule (Seconds (2.0), &Pmip6ReattachTestCase::Check, this, 0);
+  Simulator::Schedule (Seconds (3.0), &Pmip6ReattachTestCase::Detach, this, 0);
+  Simulator::Schedule (Seconds (3.0) + MicroSeconds (1), &Pmip6ReattachTestCase::Attach, this, 0);
+  // registered again, not deregistered by a PBU of lifetime 0
+  Simulator::Schedule (Seconds (4.0), &Pmip6ReattachTestCase::Check, this, 0);
+
+  Simulator::Stop (Seconds (5.0));
+  Simulator::Run ();
+
+  Simulator::Destroy ();
+}
+
+/*
+ * An access point reporting attachments and detachments to its MAG,
+ * several at a time.
+ */
+class Pmip6NotifyBatchTestCase : public TestCase
+{
+public:
+  Pmip6NotifyBatchTestCase ();
+private:
+  virtual void DoRun (void);
+  void Attach (uint32_t mn);
+  void Detach (uint32_t mn);
+  void MagRx (Ptr<const Packet> packet, Ptr<Ipv6> ipv6, uint32_t interface);
+  void Check (uint32_t nAttached, uint32_t nMessages);
+
+  enum
+  {
+    N_MNS = 3
+  };
+
+  Ptr<Node> m_lma;
+  Ptr<Node> m_mag;
+  Ptr<Node> m_ap;
+  uint32_t m_accessIf;
+  Mac48Address m_mnMac[N_MNS];
+  Ipv6Address m_hnp[N_MNS];
+  uint32_t m_nMessages;
+};
+
+Pmip6NotifyBatchTestCase::Pmip6NotifyBatchTestCase ()
+  : TestCase ("Check the notifications of an access point coalesced in one message"),
+    m_nMessages (0)
+{
+}
+
+void
+Pmip6NotifyBatchTestCase::Attach (uint32_t mn)
+{
+  m_ap->GetObject<Pmipv6MagNotifier> ()->NotifyNewNode (m_mnMac[mn], Mac48Address (), Ipv6MobilityHeader::OPT_ATT_IEEE_802_11ABG);
+}
+
+void
+Pmip6NotifyBatchTestCase::Detach (uint32_t mn)
+{
+  m_ap->GetObject<Pmipv6MagNotifier> ()->NotifyDetachedNode (m_mnMac[mn], Mac48Address ());
+}
+
+void
+Pmip6NotifyBatchTestCase::MagRx (Ptr<const Packet> packet, Ptr<Ipv6> ipv6, uint32_t interface)
+{
+  Ipv6Header header;
+
+  packet->PeekHeader (header);
+
+  if (header.GetNextHeader () == Pmipv6MagNotifier::PROT_NUMBER)
+    {
+      m_nMessages++;
+    }
+}
+
+void
+Pmip6NotifyBatchTestCase::Check (uint32_t nAttached, uint32_t nMessages)
+{
+  Pmipv6PrefixRoutingHelper prefixRoutingHelper;
+  Ptr<Pmipv6PrefixRouting> magRouting = prefixRoutingHelper.GetPrefixRouting (m_mag->GetObject<Ipv6> ());
+
+  NS_TEST_EXPECT_MSG_EQ (m_nMessages, nMessages, "notifications sent together");
+
+  for (uint32_t i = 0; i < N_MNS; i++)
+    {
+      int32_t expected = (i >= N_MNS - nAttached) ? (int32_t)m_accessIf : -1;
+
+      NS_TEST_EXPECT_MSG_EQ (magRouting->LookupPrefix (m_hnp[i]), expected, "MAG route of MN " << i);
+    }
 }
 
-// Do not forget to allocate an instance of this TestSuite
-static Pmip6TestSuite pmip6TestSuite;
+void
+Pmip6NotifyBatchTestCase::DoRun (void)
+{
+  //a single notification is the original 16 octets message
+  Pmipv6MagNotifyHeader single;
+
+  single.AddNotification (Mac48Address ("00:00:00:00:00:01"), Ipv6MobilityHeader::OPT_ATT_IEEE_802_11ABG, false);
+  NS_TEST_EXPECT_MSG_EQ (single.GetSerializedSize (), 16, "single notification size");
+
+  Ptr<Packet> p = Create<Packet> ();
+  Pmipv6MagNotifyHeader sent;
+  Pmipv6MagNotifyHeader received;
+
+  sent.AddNotification (Mac48Address ("00:00:00:00:00:01"), Ipv6MobilityHeader::OPT_ATT_IEEE_802_11ABG, false);
+  sent.AddNotification (Mac48Address ("00:00:00:00:00:02"), Ipv6MobilityHeader::OPT_ATT_IEEE_802_3, true);
+  p->AddHeader (sent);
+  p->RemoveHeader (received);
+
+  NS_TEST_EXPECT_MSG_EQ (p->GetSize (), 0, "whole message read");
+  NS_TEST_ASSERT_MSG_EQ (received.GetNNotifications (), 2, "notifications read back");
+  NS_TEST_EXPECT_MSG_EQ (received.GetMacAddress (1), Mac48Address ("00:00:00:00:00:02"), "MAC address read back");
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t)received.GetAccessTechnologyType (1), (uint32_t)Ipv6MobilityHeader::OPT_ATT_IEEE_802_3, "ATT read back");
+  NS_TEST_EXPECT_MSG_EQ (received.IsDetached (0), false, "attachment read back");
+  NS_TEST_EXPECT_MSG_EQ (received.IsDetached (1), true, "detachment read back");
+
+  m_lma = CreateObject<Node> ();
+  m_mag = CreateObject<Node> ();
+  m_ap = CreateObject<Node> ();
+
+  InternetStackHelper internet;
+  internet.Install (m_lma);
+  internet.Install (m_mag);
+  internet.Install (m_ap);
+
+  PointToPointHelper p2p;
+  Ipv6AddressHelper address;
+
+  address.NewNetwork (Ipv6Address ("3ffe:2::"), Ipv6Prefix (64));
+  Ipv6InterfaceContainer core = address.Assign (p2p.Install (m_lma, m_mag));
+  core.SetRouter (0, true);
+
+  address.NewNetwork (Ipv6Address ("3ffe:3::"), Ipv6Prefix (64));
+  Ipv6InterfaceContainer access = address.Assign (p2p.Install (m_mag, m_ap));
+  m_accessIf = access.GetInterfaceIndex (0);
+  m_mag->GetObject<Ipv6> ()->SetForwarding (m_accessIf, true);
+
+  Pmip6ProfileHelper profile;
+
+  for (uint32_t i = 0; i < N_MNS; i++)
+    {
+      std::ostringstream oss;
+      std::list<Ipv6Address> hnps;
+      uint8_t buf[16] = { 0x3f, 0xfe, 0x00, 0x01, 0x00, 0x04, 0x00, (uint8_t)(i + 1) };
+
+      oss << "mn" << i << "@pmip6.test";
+      m_mnMac[i] = Mac48Address::Allocate ();
+      m_hnp[i] = Ipv6Address (buf);
+
+      hnps.push_back (m_hnp[i]);
+      profile.AddProfile (Identifier (oss.str ().c_str ()), Identifier (m_mnMac[i]), core.GetAddress (0, 1), hnps);
+    }
+
+  Pmip6LmaHelper lmaHelper;
+  lmaHelper.SetPrefixPoolBase (Ipv6Address ("3ffe:1:4::"), 48);
+  lmaHelper.SetProfileHelper (&profile);
+  lmaHelper.Install (m_lma);
+
+  Pmip6MagHelper magHelper;
+  magHelper.SetProfileHelper (&profile);
+  magHelper.Install (m_mag, access.GetAddress (0, 1), NodeContainer (m_ap));
+
+  m_ap->GetObject<Pmipv6MagNotifier> ()->SetAttribute ("CoalescingWindow", TimeValue (MilliSeconds (50)));
+  m_mag->GetObject<Ipv6L3Protocol> ()->TraceConnectWithoutContext ("Rx", MakeCallback (&Pmip6NotifyBatchTestCase::MagRx, this));
+
+  Simulator::Schedule (Seconds (1.50), &Pmip6NotifyBatchTestCase::Attach, this, 0);
+  Simulator::Schedule (Seconds (1.51), &Pmip6NotifyBatchTestCase::Attach, this, 1);
+  Simulator::Schedule (Seconds (1.52), &Pmip6NotifyBatchTestCase::Attach, this, 2);
+  Simulator::Schedule (Seconds (2.0), &Pmip6NotifyBatchTestCase::Check, this, 3, 1);
+  Simulator::Schedule (Seconds (2.50), &Pmip6NotifyBatchTestCase::Detach, this, 0);
+  Simulator::Schedule (Seconds (2.52), &Pmip6NotifyBatchTestCase::Detach, this, 1);
+  Simulator::Schedule (Seconds (3.0), &Pmip6NotifyBatchTestCase::Check, this, 1, 2);
+
+  Simulator::Stop (Seconds (3.5));
+  Simulator::Run ();
+
+  Simulator::Destroy ();
+}
+
+/*
+ * A MAG registering several mobile nodes for bulk refresh with a short
+ * lifetime: the bindings are kept alive by one PBU per refresh, then
+ * revoked together.
+ */
+class Pmip6BulkRefreshTestCase : public TestCase
+{
+public:
+  Pmip6BulkRefreshTestCase ();
+private:
+  virtual void DoRun (void);
+  void Attach (uint32_t mn);
+  void Revoke (void);
+  void LmaRx (Ptr<const Packet> packet, Ptr<Ipv6> ipv6, uint32_t interface);
+  void Check (uint32_t nLmaRoutes, bool magRoutes, uint32_t nPbus);
+
+  enum
+  {
+    N_MNS = 3
+  };
+
+  Ptr<Node> m_lma;
+  Ptr<Node> m_mag;
+  Ipv6Address m_lmaAddress;
+  Mac48Address m_access;
+  uint32_t m_accessIf;
+  Mac48Address m_mnMac[N_MNS];
+  Ipv6Address m_hnp[N_MNS];
+  uint32_t m_nPbus;
+};
+
+Pmip6BulkRefreshTestCase::Pmip6BulkRefreshTestCase ()
+  : TestCase ("Check the bulk refresh and revocation of the bindings of a MAG"),
+    m_nPbus (0)
+{
+}
+
+void
+Pmip6BulkRefreshTestCase::Attach (uint32_t mn)
+{
+  m_mag->GetObject<Pmipv6MagNotifier> ()->NotifyNewNode (m_mnMac[mn], m_access, Ipv6MobilityHeader::OPT_ATT_IEEE_802_11ABG);
+}
+
+void
+Pmip6BulkRefreshTestCase::Revoke (void)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_mag->GetObject<Pmipv6Mag> ()->RevokeBindings (m_lmaAddress), true, "bulk binding group revoked");
+}
+
+void
+Pmip6BulkRefreshTestCase::LmaRx (Ptr<const Packet> packet, Ptr<Ipv6> ipv6, uint32_t interface)
+{
+  Ipv6Header header;
+
+  packet->PeekHeader (header);
+
+  if (header.GetNextHeader () == Ipv6Header::IPV6_EXT_MOBILITY)
+    {
+      m_nPbus++;
+    }
+}
+
+void
+Pmip6BulkRefreshTestCase::Check (uint32_t nLmaRoutes, bool magRoutes, uint32_t nPbus)
+{
+  Pmipv6PrefixRoutingHelper prefixRoutingHelper;
+  Ptr<Pmipv6PrefixRouting> lmaRouting = prefixRoutingHelper.GetPrefixRouting (m_lma->GetObject<Ipv6> ());
+  Ptr<Pmipv6PrefixRouting> magRouting = prefixRoutingHelper.GetPrefixRouting (m_mag->GetObject<Ipv6> ());
+
+  NS_TEST_EXPECT_MSG_EQ (m_nPbus, nPbus, "PBUs received by the LMA");
+  NS_TEST_EXPECT_MSG_EQ (lmaRouting->GetNRoutes (), nLmaRoutes, "bindings on the LMA");
+
+  for (uint32_t i = 0; i < N_MNS; i++)
+    {
+      int32_t expected = magRoutes ? (int32_t)m_accessIf : -1;
+
+      NS_TEST_EXPECT_MSG_EQ (magRouting->LookupPrefix (m_hnp[i]), expected, "MAG route of MN " << i);
+    }
+}
+
+void
+Pmip6BulkRefreshTestCase::DoRun (void)
+{
+  //group identifier option round trip
+  Ptr<Packet> p = Create<Packet> ();
+  Ipv6MobilityOptionMobileNodeGroupIdentifierHeader sent (0x01020304);
+  Ipv6MobilityOptionMobileNodeGroupIdentifierHeader received;
+
+  p->AddHeader (sent);
+  NS_TEST_EXPECT_MSG_EQ (p->GetSize (), 8, "group identifier option size");
+  p->RemoveHeader (received);
+  NS_TEST_EXPECT_MSG_EQ (received.GetGroupIdentifier (), 0x01020304, "group identifier read back");
+
+  m_lma = CreateObject<Node> ();
+  m_mag = CreateObject<Node> ();
+
+  InternetStackHelper internet;
+  internet.Install (m_lma);
+  internet.Install (m_mag);
+
+  PointToPointHelper p2p;
+  Ipv6AddressHelper address;
+
+  address.NewNetwork (Ipv6Address ("3ffe:2::"), Ipv6Prefix (64));
+  Ipv6InterfaceContainer core = address.Assign (p2p.Install (m_lma, m_mag));
+  core.SetRouter (0, true);
+  m_lmaAddress = core.GetAddress (0, 1);
+
+  Pmip6ProfileHelper profile;
+
+  for (uint32_t i = 0; i < N_MNS; i++)
+    {
+      std::ostringstream oss;
+      std::list<Ipv6Address> hnps;
+      uint8_t buf[16] = { 0x3f, 0xfe, 0x00, 0x01, 0x00, 0x04, 0x00, (uint8_t)(i + 1) };
+
+      oss << "mn" << i << "@pmip6.test";
+      m_mnMac[i] = Mac48Address::Allocate ();
+      m_hnp[i] = Ipv6Address (buf);
+
+      hnps.push_back (m_hnp[i]);
+      profile.AddProfile (Identifier (oss.str ().c_str ()), Identifier (m_mnMac[i]), m_lmaAddress, hnps);
+    }
+
+  Pmip6LmaHelper lmaHelper;
+  lmaHelper.SetPrefixPoolBase (Ipv6Address ("3ffe:1:4::"), 48);
+  lmaHelper.SetProfileHelper (&profile);
+  lmaHelper.Install (m_lma);
+
+  Pmip6MagHelper magHelper;
+  magHelper.SetProfileHelper (&profile);
+  magHelper.SetBulkRegistration (true);
+  magHelper.SetBindingLifetime (4);
+  magHelper.Install (m_mag, Ipv6Address::GetAny (), NodeContainer ());
+
+  Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice> ();
+  m_access = Mac48Address::Allocate ();
+  dev->SetAddress (m_access);
+  dev->SetChannel (CreateObject<SimpleChannel> ());
+  m_mag->AddDevice (dev);
+
+  Ptr<Ipv6> ipv6 = m_mag->GetObject<Ipv6> ();
+  m_accessIf = ipv6->AddInterface (dev);
+  ipv6->SetUp (m_accessIf);
+  ipv6->SetForwarding (m_accessIf, true);
+
+  m_lma->GetObject<Ipv6L3Protocol> ()->TraceConnectWithoutContext ("Rx", MakeCallback (&Pmip6BulkRefreshTestCase::LmaRx, this));
+
+  for (uint32_t i = 0; i < N_MNS; i++)
+    {
+      Simulator::Schedule (Seconds (1.5 + 0.1 * i), &Pmip6BulkRefreshTestCase::Attach, this, i);
+    }
+
+  //one PBU per MN, then one per refresh every 3.6s: 5.1s, 8.7s
+  Simulator::Schedule (Seconds (2.0), &Pmip6BulkRefreshTestCase::Check, this, N_MNS, true, N_MNS);
+  Simulator::Schedule (Seconds (10.0), &Pmip6BulkRefreshTestCase::Check, this, N_MNS, true, N_MNS + 2);
+  Simulator::Schedule (Seconds (10.5), &Pmip6BulkRefreshTestCase::Revoke, this);
+  Simulator::Schedule (Seconds (11.0), &Pmip6BulkRefreshTestCase::Check, this, N_MNS, false, N_MNS + 3);
+  //deleted on the LMA after MIN_DELAY_BEFORE_BCE_DELETE
+  Simulator::Schedule (Seconds (21.0), &Pmip6BulkRefreshTestCase::Check, this, 0, false, N_MNS + 3);
+
+  Simulator::Stop (Seconds (22.0));
+  Simulator::Run ();
+
+  Simulator::Destroy ();
+}
+
+/*
+ * Predictive fast handover (RFC 5949): the first MAG pushes the context
+ * of the mobile node to the second MAG, which routes the prefix as soon
+ * as the node attaches, before the PBA. The first MAG does not take
+ * fast handovers, and refuses the context on the way back.
+ */
+class Pmip6FastHandoverTestCase : public Pmip6HandoverTestCase
+{
+public:
+  Pmip6FastHandoverTestCase ();
+private:
+  virtual void DoRun (void);
+  void Prepare (uint32_t from, uint32_t to, bool expected);
+  void AttachPrepared (uint32_t mag);
+  void MagRx (Ptr<const Packet> packet, Ptr<Ipv6> ipv6, uint32_t interface);
+  void CheckHack (uint32_t nHacks, uint8_t code);
+
+  uint32_t m_nHacks;
+  uint8_t m_hackCode;
+};
+
+Pmip6FastHandoverTestCase::Pmip6FastHandoverTestCase ()
+  : Pmip6HandoverTestCase ("Check that a MAG prepared by a fast handover routes the prefix before the PBA"),
+    m_nHacks (0),
+    m_hackCode (0xff)
+{
+}
+
+void
+Pmip6FastHandoverTestCase::Prepare (uint32_t from, uint32_t to, bool expected)
+{
+  bool prepared = m_mags.Get (from)->GetObject<Pmipv6Mag> ()->PrepareHandover (m_mnMac, m_magAddress[to]);
+
+  NS_TEST_EXPECT_MSG_EQ (prepared, expected, "HI sent by MAG " << from);
+}
+
+void
+Pmip6FastHandoverTestCase::AttachPrepared (uint32_t mag)
+{
+  Pmipv6PrefixRoutingHelper prefixRoutingHelper;
+  Ptr<Pmipv6PrefixRouting> magRouting = prefixRoutingHelper.GetPrefixRouting (m_mags.Get (mag)->GetObject<Ipv6> ());
+
+  NS_TEST_EXPECT_MSG_EQ (magRouting->LookupPrefix (m_hnp), -1, "no route before the attachment");
+
+  Attach (mag);
+
+  NS_TEST_EXPECT_MSG_EQ (magRouting->LookupPrefix (m_hnp), (int32_t)m_accessIf[mag], "prefix routed at the attachment");
+}
+
+void
+Pmip6FastHandoverTestCase::MagRx (Ptr<const Packet> packet, Ptr<Ipv6> ipv6, uint32_t interface)
+{
+  Ipv6Header header;
+  Ptr<Packet> p = packet->Copy ();
+
+  p->RemoveHeader (header);
+
+  if (header.GetNextHeader () != Ipv6Header::IPV6_EXT_MOBILITY)
+    {
+      return;
+    }
+
+  Ipv6MobilityHeader mh;
+
+  p->PeekHeader (mh);
+
+  if (mh.GetMhType () == Ipv6MobilityHeader::IPV6_MOBILITY_HANDOVER_ACKNOWLEDGE)
+    {
+      Ipv6MobilityHandoverAckHeader hack;
+
+      p->PeekHeader (hack);
+      m_nHacks++;
+      m_hackCode = hack.GetCode ();
+    }
+}
+
+void
+Pmip6FastHandoverTestCase::CheckHack (uint32_t nHacks, uint8_t code)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_nHacks, nHacks, "HAcks received");
+  NS_TEST_EXPECT_MSG_EQ ((uint32_t)m_hackCode, (uint32_t)code, "HAck code");
+}
+
+void
+Pmip6FastHandoverTestCase::DoRun (void)
+{
+  //LMA address option round trip
+  Ptr<Packet> p = Create<Packet> ();
+  Ipv6MobilityOptionIpv6AddressHeader sent (Ipv6MobilityOptionIpv6AddressHeader::LMA_ADDRESS, Ipv6Address ("3ffe:2::1"));
+  Ipv6MobilityOptionIpv6AddressHeader received;
+
+  p->AddHeader (sent);
+  NS_TEST_EXPECT_MSG_EQ (p->GetSize (), 20, "IPv6 address option size");
+  p->RemoveHeader (received);
+  NS_TEST_EXPECT_MSG_EQ (received.GetAddress (), Ipv6Address ("3ffe:2::1"), "LMA address read back");
+
+  Setup ();
+
+  m_mags.Get (1)->GetObject<Pmipv6Mag> ()->SetFastHandover (true);
+
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      m_mags.Get (i)->GetObject<Ipv6L3Protocol> ()->TraceConnectWithoutContext ("Rx", MakeCallback (&Pmip6FastHandoverTestCase::MagRx, this));
+    }
+
+  //nothing to push before the registration
+  Simulator::Schedule (Seconds (1.0), &Pmip6FastHandoverTestCase::Prepare, this, 0, 1, false);
+  Simulator::Schedule (Seconds (1.5), &Pmip6HandoverTestCase::Attach, this, 0);
+  Simulator::Schedule (Seconds (2.0), &Pmip6HandoverTestCase::Check, this, 0);
+  Simulator::Schedule (Seconds (2.9), &Pmip6FastHandoverTestCase::Prepare, this, 0, 1, true);
+  Simulator::Schedule (Seconds (3.0), &Pmip6FastHandoverTestCase::CheckHack, this, 1, Ipv6MobilityHeader::HACK_CODE_HANDOVER_ACCEPTED);
+  Simulator::Schedule (Seconds (3.0), &Pmip6FastHandoverTestCase::AttachPrepared, this, 1);
+  //the PBA does not set up the routes again
+  Simulator::Schedule (Seconds (3.5), &Pmip6HandoverTestCase::Check, this, 1);
+  Simulator::Schedule (Seconds (4.4), &Pmip6FastHandoverTestCase::Prepare, this, 1, 0, true);
+  Simulator::Schedule (Seconds (4.5), &Pmip6FastHandoverTestCase::CheckHack, this, 2, Ipv6MobilityHeader::HACK_CODE_ADMINISTRATIVELY_PROHIBITED);
+  Simulator::Schedule (Seconds (4.5), &Pmip6HandoverTestCase::Attach, this, 0);
+  Simulator::Schedule (Seconds (5.0), &Pmip6HandoverTestCase::Check, this, 0);
+
+  Simulator::Stop (Seconds (6.0));
+  Simulator::Run ();
+
+  Simulator::Destroy ();
+}
+
+/*
+ * The mobile node leaves the first MAG after preparing its handover to
+ * the second one, with downlink packets still tunneled by the LMA to
+ * the first MAG: they are forwarded to the second MAG, held there until
+ * the mobile node attaches and then delivered.
+ */
+class Pmip6HandoverBufferTestCase : public Pmip6HandoverTestCase
+{
+public:
+  Pmip6HandoverBufferTestCase ();
+private:
+  virtual void DoRun (void);
+  void Prepare (void);
+  void Detach (void);
+  void SendDownlink (uint32_t nPackets);
+  void CheckHeld (void);
+  void CheckDelivered (void);
+  void CheckReleased (void);
+  void Forwarded (std::string context, Ptr<const Packet> packet);
+
+  Ptr<Pmipv6HandoverBuffer> m_buffer[2];
+  uint32_t m_nForwarded[2];
+};
+
+Pmip6HandoverBufferTestCase::Pmip6HandoverBufferTestCase ()
+  : Pmip6HandoverTestCase ("Check that the downlink packets of a mobile node handing over are forwarded and delivered")
+{
+  m_nForwarded[0] = m_nForwarded[1] = 0;
+}
+
+void
+Pmip6HandoverBufferTestCase::Prepare (void)
+{
+  bool prepared = m_mags.Get (0)->GetObject<Pmipv6Mag> ()->PrepareHandover (m_mnMac, m_magAddress[1]);
+
+  NS_TEST_EXPECT_MSG_EQ (prepared, true, "HI sent by the first MAG");
+}
+
+void
+Pmip6HandoverBufferTestCase::Detach (void)
+{
+  m_mags.Get (0)->GetObject<Pmipv6MagNotifier> ()->NotifyDetachedNode (m_mnMac, m_access[0]);
+}
+
+void
+Pmip6HandoverBufferTestCase::SendDownlink (uint32_t nPackets)
+{
+  Ptr<Ipv6L3Protocol> ipv6 = m_lma->GetObject<Ipv6L3Protocol> ();
+  Ipv6Address mn ("3ffe:1:4:1::10");
+
+  for (uint32_t i = 0; i < nPackets; i++)
+    {
+      ipv6->Send (Create<Packet> (100), ipv6->GetAddress (1, 1).GetAddress (), mn, 17, 0);
+    }
+}
+
+void
+Pmip6HandoverBufferTestCase::Forwarded (std::string context, Ptr<const Packet> packet)
+{
+  m_nForwarded[context == "0" ? 0 : 1]++;
+}
+
+void
+Pmip6HandoverBufferTestCase::CheckHeld (void)
+{
+  Pmipv6PrefixRoutingHelper prefixRoutingHelper;
+  Ptr<Pmipv6PrefixRouting> nMagRouting = prefixRoutingHelper.GetPrefixRouting (m_mags.Get (1)->GetObject<Ipv6> ());
+
+  NS_TEST_EXPECT_MSG_EQ (m_buffer[0]->GetNBuffered (), 0, "nothing queued by the previous MAG");
+  NS_TEST_EXPECT_MSG_EQ (m_buffer[0]->GetNForwarded (), 3, "packets forwarded by the previous MAG");
+  NS_TEST_EXPECT_MSG_EQ (m_buffer[1]->GetNBuffered (), 3, "packets queued by the next MAG");
+  NS_TEST_EXPECT_MSG_EQ (m_buffer[1]->GetNDropped (), 1, "oldest packet dropped over the limit");
+  NS_TEST_EXPECT_MSG_EQ (m_buffer[1]->GetNPackets (Identifier ("mn@pmip6.test")), 2, "packets held for the MN");
+  NS_TEST_EXPECT_MSG_EQ (nMagRouting->IsHeld (Ipv6Address ("3ffe:1:4:1::10")), true, "prefix held by the next MAG");
+  NS_TEST_EXPECT_MSG_EQ (nMagRouting->LookupPrefix (m_hnp), -1, "held prefix not routed");
+}
+
+void
+Pmip6HandoverBufferTestCase::CheckDelivered (void)
+{
+  Pmipv6PrefixRoutingHelper prefixRoutingHelper;
+  Ptr<Pmipv6PrefixRouting> nMagRouting = prefixRoutingHelper.GetPrefixRouting (m_mags.Get (1)->GetObject<Ipv6> ());
+
+  NS_TEST_EXPECT_MSG_EQ (m_buffer[1]->GetNForwarded (), 2, "held packets delivered once the MN attached");
+  NS_TEST_EXPECT_MSG_EQ (m_buffer[1]->GetNBytes (), 0, "nothing left in the buffer");
+  NS_TEST_EXPECT_MSG_EQ (m_nForwarded[0], 3, "Forwarded trace of the previous MAG");
+  NS_TEST_EXPECT_MSG_EQ (m_nForwarded[1], 2, "Forwarded trace of the next MAG");
+  NS_TEST_EXPECT_MSG_EQ (nMagRouting->IsHeld (Ipv6Address ("3ffe:1:4:1::10")), false, "prefix routed by the next MAG");
+}
+
+void
+Pmip6HandoverBufferTestCase::CheckReleased (void)
+{
+  Pmipv6PrefixRoutingHelper prefixRoutingHelper;
+  Ptr<Pmipv6PrefixRouting> pMagRouting = prefixRoutingHelper.GetPrefixRouting (m_mags.Get (0)->GetObject<Ipv6> ());
+
+  NS_TEST_EXPECT_MSG_EQ (pMagRouting->IsHeld (Ipv6Address ("3ffe:1:4:1::10")), false, "previous MAG stopped forwarding");
+  NS_TEST_EXPECT_MSG_EQ (m_mags.Get (0)->GetObject<Ipv6TunnelL4Protocol> ()->GetTunnelDevice (m_magAddress[1]), 0, "forwarding tunnel released");
+}
+
+void
+Pmip6HandoverBufferTestCase::DoRun (void)
+{
+  Setup ();
+
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      Ptr<Pmipv6Mag> mag = m_mags.Get (i)->GetObject<Pmipv6Mag> ();
+
+      mag->SetFastHandover (true);
+      mag->SetHandoverBuffering (true);
+
+      m_buffer[i] = mag->GetHandoverBuffer ();
+      m_buffer[i]->TraceConnect ("Forwarded", i == 0 ? "0" : "1", MakeCallback (&Pmip6HandoverBufferTestCase::Forwarded, this));
+    }
+
+  m_buffer[1]->SetMaxPackets (2);
+  m_buffer[1]->SetDropPolicy (Pmipv6HandoverBuffer::DROP_HEAD);
+
+  Simulator::Schedule (Seconds (1.5), &Pmip6HandoverTestCase::Attach, this, 0);
+  Simulator::Schedule (Seconds (2.0), &Pmip6HandoverTestCase::Check, this, 0);
+  Simulator::Schedule (Seconds (2.9), &Pmip6HandoverBufferTestCase::Prepare, this);
+  Simulator::Schedule (Seconds (3.0), &Pmip6HandoverBufferTestCase::Detach, this);
+  //still tunneled by the LMA to the first MAG
+  Simulator::Schedule (Seconds (3.0), &Pmip6HandoverBufferTestCase::SendDownlink, this, 3);
+  Simulator::Schedule (Seconds (3.4), &Pmip6HandoverBufferTestCase::CheckHeld, this);
+  Simulator::Schedule (Seconds (3.5), &Pmip6HandoverTestCase::Attach, this, 1);
+  Simulator::Schedule (Seconds (4.0), &Pmip6HandoverTestCase::Check, this, 1);
+  Simulator::Schedule (Seconds (4.0), &Pmip6HandoverBufferTestCase::CheckDelivered, this);
+  //forwarding for as long as a handover context
+  Simulator::Schedule (Seconds (8.5), &Pmip6HandoverBufferTestCase::CheckReleased, this);
+
+  Simulator::Stop (Seconds (9.0));
+  Simulator::Run ();
+
+  Simulator::Destroy ();
+}
+
+/*
+ * Two mobile nodes of the LMA exchanging packets: the LMA hands their
+ * traffic over to the MAGs, directly tunneled between the MAGs, then
+ * through a single MAG once the correspondent moved there.
+ */
+class Pmip6LocalizedRoutingTestCase : public Pmip6HandoverTestCase
+{
+public:
+  Pmip6LocalizedRoutingTestCase ();
+private:
+  virtual void DoRun (void);
+  void AttachCn (uint32_t mag);
+  void SendUplink (void);
+  void CheckTunneled (void);
+  void CheckBypassed (void);
+  void CheckTerminated (void);
+  void CheckLocal (void);
+  uint32_t GetNRoutesFromTo (uint32_t mag);
+
+  uint64_t m_nLmaDecap;
+};
+
+Pmip6LocalizedRoutingTestCase::Pmip6LocalizedRoutingTestCase ()
+  : Pmip6HandoverTestCase ("Check the localized routing between two mobile nodes of the LMA"),
+    m_nLmaDecap (0)
+{
+}
+
+void
+Pmip6LocalizedRoutingTestCase::AttachCn (uint32_t mag)
+{
+  m_mags.Get (mag)->GetObject<Pmipv6MagNotifier> ()->NotifyNewNode (m_cnMac, m_access[mag], Ipv6MobilityHeader::OPT_ATT_IEEE_802_11ABG);
+}
+
+void
+Pmip6LocalizedRoutingTestCase::SendUplink (void)
+{
+  //as if forwarded from the access link of the first MAG
+  Ptr<Ipv6L3Protocol> ipv6 = m_mags.Get (0)->GetObject<Ipv6L3Protocol> ();
+
+  ipv6->Send (Create<Packet> (100), Ipv6Address ("3ffe:1:4:1::10"), Ipv6Address ("3ffe:1:4:2::10"), 17, 0);
+}
+
+uint32_t
+Pmip6LocalizedRoutingTestCase::GetNRoutesFromTo (uint32_t mag)
+{
+  Ipv6StaticSourceRoutingHelper sourceRoutingHelper;
+
+  return sourceRoutingHelper.GetStaticSourceRouting (m_mags.Get (mag)->GetObject<Ipv6> ())->GetNRoutesFromTo ();
+}
+
+void
+Pmip6LocalizedRoutingTestCase::CheckTunneled (void)
+{
+  Ptr<Pmipv6Lma> lma = m_lma->GetObject<Pmipv6Lma> ();
+
+  NS_TEST_EXPECT_MSG_EQ (lma->GetNLocalizedPairs (), 1, "pair detected by the LMA");
+  NS_TEST_EXPECT_MSG_EQ (m_mags.Get (0)->GetObject<Pmipv6Mag> ()->GetNLocalizedRoutes (), 1, "localized route on the first MAG");
+  NS_TEST_EXPECT_MSG_EQ (GetNRoutesFromTo (0), 1, "source and destination route on the first MAG");
+  NS_TEST_EXPECT_MSG_EQ (GetNRoutesFromTo (1), 1, "source and destination route on the second MAG");
+  NS_TEST_EXPECT_MSG_NE (m_mags.Get (0)->GetObject<Ipv6TunnelL4Protocol> ()->GetTunnelDevice (m_magAddress[1]), 0, "tunnel between the MAGs");
+
+  m_nLmaDecap = m_lma->GetObject<Ipv6TunnelL4Protocol> ()->GetDecapStatistics ().packets;
+}
+
+void
+Pmip6LocalizedRoutingTestCase::CheckBypassed (void)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_lma->GetObject<Ipv6TunnelL4Protocol> ()->GetDecapStatistics ().packets, m_nLmaDecap, "LMA bypassed");
+  NS_TEST_EXPECT_MSG_EQ (m_mags.Get (1)->GetObject<Ipv6TunnelL4Protocol> ()->GetDecapStatistics ().packets, 2, "received from the LMA, then from the MAG");
+}
+
+void
+Pmip6LocalizedRoutingTestCase::CheckTerminated (void)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_lma->GetObject<Pmipv6Lma> ()->GetNLocalizedPairs (), 0, "pair terminated by the handover");
+  NS_TEST_EXPECT_MSG_EQ (GetNRoutesFromTo (0), 0, "routes removed from the first MAG");
+  NS_TEST_EXPECT_MSG_EQ (GetNRoutesFromTo (1), 0, "routes removed from the second MAG");
+  NS_TEST_EXPECT_MSG_EQ (m_mags.Get (0)->GetObject<Ipv6TunnelL4Protocol> ()->GetTunnelDevice (m_magAddress[1]), 0, "tunnel between the MAGs released");
+}
+
+void
+Pmip6LocalizedRoutingTestCase::CheckLocal (void)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_lma->GetObject<Pmipv6Lma> ()->GetNLocalizedPairs (), 1, "pair detected again");
+  NS_TEST_EXPECT_MSG_EQ (GetNRoutesFromTo (0), 2, "both directions routed by the first MAG");
+  NS_TEST_EXPECT_MSG_EQ (GetNRoutesFromTo (1), 0, "nothing on the second MAG");
+}
+
+void
+Pmip6LocalizedRoutingTestCase::DoRun (void)
+{
+  Setup ();
+
+  m_lma->GetObject<Pmipv6Lma> ()->SetLocalizedRouting (true);
+
+  Simulator::Schedule (Seconds (1.5), &Pmip6HandoverTestCase::Attach, this, 0);
+  Simulator::Schedule (Seconds (1.5), &Pmip6LocalizedRoutingTestCase::AttachCn, this, 1);
+  //through the LMA, which initiates the localized routing
+  Simulator::Schedule (Seconds (2.0), &Pmip6LocalizedRoutingTestCase::SendUplink, this);
+  Simulator::Schedule (Seconds (2.5), &Pmip6LocalizedRoutingTestCase::CheckTunneled, this);
+  Simulator::Schedule (Seconds (2.6), &Pmip6LocalizedRoutingTestCase::SendUplink, this);
+  Simulator::Schedule (Seconds (3.0), &Pmip6LocalizedRoutingTestCase::CheckBypassed, this);
+  Simulator::Schedule (Seconds (3.5), &Pmip6LocalizedRoutingTestCase::AttachCn, this, 0);
+  Simulator::Schedule (Seconds (4.0), &Pmip6LocalizedRoutingTestCase::CheckTerminated, this);
+  Simulator::Schedule (Seconds (4.5), &Pmip6LocalizedRoutingTestCase::SendUplink, this);
+  Simulator::Schedule (Seconds (5.0), &Pmip6LocalizedRoutingTestCase::CheckLocal, this);
+
+  Simulator::Stop (Seconds (6.0));
+  Simulator::Run ();
+
+  Simulator::Destroy ();
+}
+
+/*
+ * The handovers of the mobile node measured from the trace sources of
+ * the MAGs and the LMA.
+ */
+class Pmip6StatsTestCase : public Pmip6HandoverTestCase
+{
+public:
+  Pmip6StatsTestCase ();
+private:
+  virtual void DoRun (void);
+  void CheckStats (void);
+
+  Pmip6StatsHelper m_stats;
+};
+
+Pmip6StatsTestCase::Pmip6StatsTestCase ()
+  : Pmip6HandoverTestCase ("Check the handover latencies and signaling counters collected from the trace sources")
+{
+}
+
+void
+Pmip6StatsTestCase::CheckStats (void)
+{
+  std::vector<double> latencies = m_stats.GetHandoverLatencies (Identifier ("mn@pmip6.test"));
+
+  NS_TEST_EXPECT_MSG_EQ (m_stats.GetCounter (Pmip6StatsHelper::COUNTER_ATTACH)->GetCount (), 2, "two attachments");
+  NS_TEST_EXPECT_MSG_EQ (m_stats.GetCounter (Pmip6StatsHelper::COUNTER_TX_PBU)->GetCount (), 2, "one PBU per attachment");
+  NS_TEST_EXPECT_MSG_EQ (m_stats.GetCounter (Pmip6StatsHelper::COUNTER_RETRANSMIT_PBU)->GetCount (), 0, "no retransmission");
+  NS_TEST_EXPECT_MSG_EQ (m_stats.GetCounter (Pmip6StatsHelper::COUNTER_RX_PBA)->GetCount (), 2, "PBAs received by the MAGs");
+  NS_TEST_EXPECT_MSG_EQ (m_stats.GetCounter (Pmip6StatsHelper::COUNTER_LMA_RX_PBU)->GetCount (), 2, "PBUs received by the LMA");
+  NS_TEST_EXPECT_MSG_EQ (m_stats.GetCounter (Pmip6StatsHelper::COUNTER_LMA_TX_PBA)->GetCount (), 2, "PBAs sent by the LMA");
+
+  for (uint32_t i = 0; i < Pmip6StatsHelper::N_STAGES; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_stats.GetLatency ((Pmip6StatsHelper::Stage_e)i)->getCount (), 2, "stage reached by both handovers");
+    }
+
+  double pba = m_stats.GetLatency (Pmip6StatsHelper::STAGE_PBA)->getMean ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_stats.GetLatency (Pmip6StatsHelper::STAGE_PBU)->getMax (), 0, "PBU sent on attachment");
+  NS_TEST_EXPECT_MSG_GT (pba, 0, "a round-trip to the LMA for the PBA");
+  NS_TEST_EXPECT_MSG_EQ_TOL (m_stats.GetLatency (Pmip6StatsHelper::STAGE_TUNNEL)->getMean (), pba, 1e-9, "tunnel set up on the PBA");
+  NS_TEST_ASSERT_MSG_EQ (latencies.size (), 2, "both handovers of the MN completed");
+  NS_TEST_EXPECT_MSG_GT (latencies[1], pba - 1e-9, "handover over with the first RA");
+}
+
+void
+Pmip6StatsTestCase::DoRun (void)
+{
+  Setup ();
+
+  m_stats.Install (m_lma);
+  m_stats.Install (m_mags);
+
+  Simulator::Schedule (Seconds (1.5), &Pmip6HandoverTestCase::Attach, this, 0);
+  Simulator::Schedule (Seconds (3.0), &Pmip6HandoverTestCase::Attach, this, 1);
+  Simulator::Schedule (Seconds (4.0), &Pmip6StatsTestCase::CheckStats, this);
+
+  Simulator::Stop (Seconds (4.5));
+  Simulator::Run ();
+
+  Simulator::Destroy ();
+}
+
+/*
+ * The LMA takes 50 ms to process each PBU: the binding is only set
+ * up once the PBU is served.
+ */
+class Pmip6ProcessingTestCase : public Pmip6HandoverTestCase
+{
+public:
+  Pmip6ProcessingTestCase ();
+private:
+  virtual void DoRun (void);
+  void CheckPending (void);
+  void CheckProcessed (void);
+
+  Ptr<Pmipv6Processor> m_processor;
+};
+
+Pmip6ProcessingTestCase::Pmip6ProcessingTestCase ()
+  : Pmip6HandoverTestCase ("Check the bindings of a LMA with a limited processing capacity")
+{
+}
+
+void
+Pmip6ProcessingTestCase::CheckPending (void)
+{
+  Pmipv6PrefixRoutingHelper prefixRoutingHelper;
+  Ptr<Pmipv6PrefixRouting> lmaRouting = prefixRoutingHelper.GetPrefixRouting (m_lma->GetObject<Ipv6> ());
+
+  NS_TEST_EXPECT_MSG_EQ (m_processor->GetNBusy (), 1, "PBU being processed");
+  NS_TEST_EXPECT_MSG_EQ (lmaRouting->GetNRoutes (), 0, "no binding yet");
+}
+
+void
+Pmip6ProcessingTestCase::CheckProcessed (void)
+{
+  Pmipv6Processor::Statistics stats = m_processor->GetStatistics ();
+
+  NS_TEST_EXPECT_MSG_EQ (stats.processed, 1, "PBU processed");
+  NS_TEST_EXPECT_MSG_EQ (stats.maxSojournTime, MilliSeconds (50), "for the service time");
+}
+
+void
+Pmip6ProcessingTestCase::DoRun (void)
+{
+  Setup ();
+
+  m_processor = CreateObject<Pmipv6Processor> ();
+  m_processor->SetDefaultServiceTime (MilliSeconds (50));
+  m_lma->GetObject<Pmipv6Lma> ()->SetProcessor (m_processor);
+
+  Simulator::Schedule (Seconds (1.5), &Pmip6HandoverTestCase::Attach, this, 0);
+  Simulator::Schedule (Seconds (1.54), &Pmip6ProcessingTestCase::CheckPending, this);
+  Simulator::Schedule (Seconds (2.0), &Pmip6HandoverTestCase::Check, this, 0);
+  Simulator::Schedule (Seconds (2.0), &Pmip6ProcessingTestCase::CheckProcessed, this);
+
+  Simulator::Stop (Seconds (2.5));
+  Simulator::Run ();
+
+  m_processor = 0;
+  Simulator::Destroy ();
+}
+
+/*
+ * Two LMAs sharing a pool, the second mobile node of the first LMA
+ * being redirected to the second one (RFC 6463).
+ */
+class Pmip6LmaRedirectTestCase : public TestCase
+{
+public:
+  Pmip6LmaRedirectTestCase ();
+private:
+  virtual void DoRun (void);
+  void Attach (uint32_t mn);
+  void Check (void);
+
+  Ptr<Node> m_mag;
+  Ptr<Node> m_lmas[2];
+  Ipv6Address m_lmaAddress[2];
+  Mac48Address m_access;
+  Mac48Address m_mnMac[3];
+  Ptr<Pmipv6LmaPool> m_pool;
+};
+
+Pmip6LmaRedirectTestCase::Pmip6LmaRedirectTestCase ()
+  : TestCase ("Check the redirection of a registration to a less loaded LMA")
+{
+}
+
+void
+Pmip6LmaRedirectTestCase::Attach (uint32_t mn)
+{
+  m_mag->GetObject<Pmipv6MagNotifier> ()->NotifyNewNode (m_mnMac[mn], m_access, Ipv6MobilityHeader::OPT_ATT_IEEE_802_11ABG);
+}
+
+void
+Pmip6LmaRedirectTestCase::Check (void)
+{
+  Ptr<Pmipv6Lma> lma0 = m_lmas[0]->GetObject<Pmipv6Lma> ();
+  Ptr<Pmipv6Lma> lma1 = m_lmas[1]->GetObject<Pmipv6Lma> ();
+
+  NS_TEST_EXPECT_MSG_EQ (lma0->GetNBindings (), 1, "bindings of the overloaded LMA");
+  NS_TEST_EXPECT_MSG_EQ (lma1->GetNBindings (), 2, "bindings of the peer");
+  NS_TEST_EXPECT_MSG_EQ (lma0->GetNRedirected (), 1, "one registration redirected");
+  NS_TEST_EXPECT_MSG_EQ (m_pool->Lookup (Identifier ("mn2@pmip6.test")), m_lmaAddress[1], "MN moved to the peer");
+  NS_TEST_EXPECT_MSG_EQ (m_pool->GetLoad (m_lmaAddress[0]), 1, "load of the overloaded LMA");
+  NS_TEST_EXPECT_MSG_EQ (m_pool->GetLoad (m_lmaAddress[1]), 2, "load of the peer");
+}
+
+void
+Pmip6LmaRedirectTestCase::DoRun (void)
+{
+  m_mag = CreateObject<Node> ();
+
+  InternetStackHelper internet;
+  internet.Install (m_mag);
+
+  PointToPointHelper p2p;
+  Ipv6AddressHelper address;
+
+  m_pool = CreateObject<Pmipv6LmaPool> ();
+  m_pool->SetSelection (Pmipv6LmaPool::LEAST_LOADED);
+
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      uint8_t buf[16] = { 0x3f, 0xfe, 0x00, 0x02, 0x00, (uint8_t)i };
+
+      m_lmas[i] = CreateObject<Node> ();
+      internet.Install (m_lmas[i]);
+
+      NetDeviceContainer devs = p2p.Install (m_lmas[i], m_mag);
+
+      address.NewNetwork (Ipv6Address (buf), Ipv6Prefix (64));
+      Ipv6InterfaceContainer ifs = address.Assign (devs);
+      ifs.SetRouter (0, true);
+      m_lmaAddress[i] = ifs.GetAddress (0, 1);
+      m_pool->AddLma (m_lmaAddress[i]);
+    }
+
+  Pmip6ProfileHelper profile;
+  std::list<Ipv6Address> hnps;
+
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      std::ostringstream oss;
+
+      oss << "mn" << i << "@pmip6.test";
+      m_mnMac[i] = Mac48Address::Allocate ();
+      profile.AddProfile (Identifier (oss.str ().c_str ()), Identifier (m_mnMac[i]), hnps);
+    }
+  profile.SetLmaPool (m_pool);
+
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      uint8_t buf[16] = { 0x3f, 0xfe, 0x00, 0x01, 0x00, (uint8_t)(4 + i) };
+      Pmip6LmaHelper lmaHelper;
+
+      lmaHelper.SetPrefixPoolBase (Ipv6Address (buf), 48);
+      lmaHelper.SetProfileHelper (&profile);
+      lmaHelper.SetRedirectThreshold (i == 0 ? 1 : 0);
+      lmaHelper.Install (m_lmas[i]);
+    }
+
+  Pmip6MagHelper magHelper;
+  magHelper.SetProfileHelper (&profile);
+  magHelper.Install (m_mag, Ipv6Address::GetAny (), NodeContainer ());
+
+  Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice> ();
+  m_access = Mac48Address::Allocate ();
+  dev->SetAddress (m_access);
+  dev->SetChannel (CreateObject<SimpleChannel> ());
+  m_mag->AddDevice (dev);
+
+  Ptr<Ipv6> ipv6 = m_mag->GetObject<Ipv6> ();
+  uint32_t accessIf = ipv6->AddInterface (dev);
+  ipv6->SetUp (accessIf);
+  ipv6->SetForwarding (accessIf, true);
+
+  // least loaded: mn0 to the first LMA, mn1 to the second, mn2 to the
+  // first again which redirects it to the second
+  Simulator::Schedule (Seconds (1.5), &Pmip6LmaRedirectTestCase::Attach, this, 0);
+  Simulator::Schedule (Seconds (2.0), &Pmip6LmaRedirectTestCase::Attach, this, 1);
+  Simulator::Schedule (Seconds (2.5), &Pmip6LmaRedirectTestCase::Attach, this, 2);
+  Simulator::Schedule (Seconds (4.0), &Pmip6LmaRedirectTestCase::Check, this);
+
+  Simulator::Stop (Seconds (4.5));
+  Simulator::Run ();
+
+  m_pool = 0;
+  Simulator::Destroy ();
+}
+
+static class Pmip6TestSuite : public TestSuite
+{
+public:
+  Pmip6TestSuite ()
+    : TestSuite ("pmip6", SYSTEM)
+  {
+    AddTestCase (new Pmip6HandoverTestCase ());
+    AddTestCase (new Pmip6ReplayTestCase ());
+    AddTestCase (new Pmip6ReattachTestCase ());
+    AddTestCase (new Pmip6NotifyBatchTestCase ());
+    AddTestCase (new Pmip6BulkRefreshTestCase ());
+    AddTestCase (new Pmip6FastHandoverTestCase ());
+    AddTestCase (new Pmip6HandoverBufferTestCase ());
+    AddTestCase (new Pmip6LocalizedRoutingTestCase ());
+    AddTestCase (new Pmip6StatsTestCase ());
+    AddTestCase (new Pmip6ProcessingTestCase ());
+    AddTestCase (new Pmip6LmaRedirectTestCase ());
+  }
+} g_pmip6TestSuite;
 
+} // namespace ns3
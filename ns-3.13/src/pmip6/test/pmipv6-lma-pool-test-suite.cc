@@ -0,0 +1,184 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <sstream>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/ipv6-address.h"
+#include "ns3/identifier.h"
+#include "ns3/pmipv6-lma-pool.h"
+
+namespace ns3 {
+
+static Identifier
+MakeMnId (uint32_t i)
+{
+  std::ostringstream oss;
+
+  oss << "mn" << i << "@example.com";
+
+  return Identifier (oss.str ().c_str ());
+}
+
+class Pmipv6LmaPoolHashTestCase : public TestCase
+{
+public:
+  Pmipv6LmaPoolHashTestCase ()
+    : TestCase ("Consistent hashing spreads the MNs and only moves the share of a new LMA")
+  {
+  }
+
+private:
+  virtual void DoRun (void);
+};
+
+void
+Pmipv6LmaPoolHashTestCase::DoRun (void)
+{
+  const uint32_t nMns = 10000;
+  Ipv6Address lmas[5] = { Ipv6Address ("2001:db8::1"), Ipv6Address ("2001:db8::2"),
+                          Ipv6Address ("2001:db8::3"), Ipv6Address ("2001:db8::4"),
+                          Ipv6Address ("2001:db8::5") };
+  Ptr<Pmipv6LmaPool> pool = CreateObject<Pmipv6LmaPool> ();
+  Ptr<Pmipv6LmaPool> other = CreateObject<Pmipv6LmaPool> ();
+  std::vector<Ipv6Address> before;
+
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      pool->AddLma (lmas[i]);
+    }
+  // the ring does not depend on the order the LMAs are added in
+  for (uint32_t i = 4; i > 0; i--)
+    {
+      other->AddLma (lmas[i - 1]);
+    }
+
+  for (uint32_t i = 0; i < nMns; i++)
+    {
+      Ipv6Address lma = pool->Select (MakeMnId (i));
+      NS_TEST_ASSERT_MSG_EQ (lma, other->Select (MakeMnId (i)), "deterministic");
+      NS_TEST_ASSERT_MSG_EQ (pool->Lookup (MakeMnId (i)), lma, "sticky");
+      before.push_back (lma);
+    }
+
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ_TOL ((double)pool->GetLoad (lmas[i]), nMns / 4.0, nMns / 4.0 * 0.25, "balanced");
+    }
+
+  // a fifth LMA takes over about a fifth of the new MNs, from all of the others
+  Ptr<Pmipv6LmaPool> grown = CreateObject<Pmipv6LmaPool> ();
+  uint32_t moved = 0;
+
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      grown->AddLma (lmas[i]);
+    }
+  for (uint32_t i = 0; i < nMns; i++)
+    {
+      Ipv6Address lma = grown->Select (MakeMnId (i));
+      if (lma != before[i])
+        {
+          NS_TEST_ASSERT_MSG_EQ (lma, lmas[4], "only moves to the new LMA");
+          moved++;
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ_TOL ((double)moved, nMns / 5.0, nMns / 5.0 * 0.25, "share of the new LMA");
+
+  // an assigned MN stays with its LMA when the ring changes
+  pool->AddLma (lmas[4]);
+  for (uint32_t i = 0; i < nMns; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (pool->Select (MakeMnId (i)), before[i], "assignment kept");
+    }
+}
+
+class Pmipv6LmaPoolLoadTestCase : public TestCase
+{
+public:
+  Pmipv6LmaPoolLoadTestCase ()
+    : TestCase ("Least loaded selection, weights, redirection peer and release")
+  {
+  }
+
+private:
+  virtual void DoRun (void);
+};
+
+void
+Pmipv6LmaPoolLoadTestCase::DoRun (void)
+{
+  Ipv6Address lma1 ("2001:db8::1");
+  Ipv6Address lma2 ("2001:db8::2");
+  Ptr<Pmipv6LmaPool> pool = CreateObject<Pmipv6LmaPool> ();
+
+  NS_TEST_EXPECT_MSG_EQ (pool->Select (MakeMnId (0)).IsAny (), true, "no LMA");
+
+  pool->SetSelection (Pmipv6LmaPool::LEAST_LOADED);
+  pool->AddLma (lma1);
+  pool->AddLma (lma2, 2);
+
+  std::vector<Identifier> first;
+
+  for (uint32_t i = 0; i < 30; i++)
+    {
+      if (pool->Select (MakeMnId (i)) == lma1)
+        {
+          first.push_back (MakeMnId (i));
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (pool->GetLoad (lma1), 10, "load for weight 1");
+  NS_TEST_EXPECT_MSG_EQ (pool->GetLoad (lma2), 20, "load for weight 2");
+
+  // balanced for their weights, no peer is less loaded
+  NS_TEST_EXPECT_MSG_EQ (pool->SelectPeer (lma1).IsAny (), true, "no peer when balanced");
+
+  pool->Assign (first[0], lma2);
+  pool->Assign (first[1], lma2);
+  NS_TEST_EXPECT_MSG_EQ (pool->Lookup (first[0]), lma2, "moved");
+  NS_TEST_EXPECT_MSG_EQ (pool->GetLoad (lma1), 8, "load of the source");
+  NS_TEST_EXPECT_MSG_EQ (pool->GetLoad (lma2), 22, "load of the target");
+  NS_TEST_EXPECT_MSG_EQ (pool->SelectPeer (lma2), lma1, "peer of the overloaded LMA");
+
+  pool->Release (first[0]);
+  NS_TEST_EXPECT_MSG_EQ (pool->Lookup (first[0]).IsAny (), true, "released");
+  NS_TEST_EXPECT_MSG_EQ (pool->GetLoad (lma2), 21, "load after release");
+
+  pool->RemoveLma (lma2);
+  NS_TEST_EXPECT_MSG_EQ (pool->GetNLmas (), 1, "removed");
+  NS_TEST_EXPECT_MSG_EQ (pool->Lookup (first[1]).IsAny (), true, "MNs of a removed LMA are released");
+  NS_TEST_EXPECT_MSG_EQ (pool->Select (first[1]), lma1, "reassigned");
+}
+
+static class Pmipv6LmaPoolTestSuite : public TestSuite
+{
+public:
+  Pmipv6LmaPoolTestSuite ()
+    : TestSuite ("pmip6-lma-pool", UNIT)
+  {
+    AddTestCase (new Pmipv6LmaPoolHashTestCase ());
+    AddTestCase (new Pmipv6LmaPoolLoadTestCase ());
+  }
+} g_pmipv6LmaPoolTestSuite;
+
+} // namespace ns3
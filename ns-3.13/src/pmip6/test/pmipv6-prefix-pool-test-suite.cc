@@ -0,0 +1,107 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/pmipv6-prefix-pool.h"
+
+namespace ns3 {
+
+class Pmipv6PrefixPoolTestCase : public TestCase
+{
+public:
+  Pmipv6PrefixPoolTestCase ();
+private:
+  virtual void DoRun (void);
+  void CheckQuarantine (Ptr<Pmipv6PrefixPool> pool, Ipv6Address released);
+};
+
+Pmipv6PrefixPoolTestCase::Pmipv6PrefixPoolTestCase ()
+  : TestCase ("Check prefix assignment, release, reuse and quarantine")
+{
+}
+
+void
+Pmipv6PrefixPoolTestCase::CheckQuarantine (Ptr<Pmipv6PrefixPool> pool, Ipv6Address released)
+{
+  NS_TEST_EXPECT_MSG_EQ (pool->Assign (), released, "released prefix reused after the quarantine");
+  NS_TEST_EXPECT_MSG_EQ (pool->GetNQuarantined (), 0, "quarantine elapsed");
+}
+
+void
+Pmipv6PrefixPoolTestCase::DoRun (void)
+{
+  Ptr<Pmipv6PrefixPool> pool = Create<Pmipv6PrefixPool> (Ipv6Address ("3ffe:1:4::"), 48);
+
+  NS_TEST_EXPECT_MSG_EQ (pool->GetSize (), 65535, "a /48 holds 65535 assignable /64s");
+
+  Ipv6Address p1 = pool->Assign ();
+  Ipv6Address p2 = pool->Assign ();
+  NS_TEST_EXPECT_MSG_EQ (p1, Ipv6Address ("3ffe:1:4:1::"), "first prefix");
+  NS_TEST_EXPECT_MSG_EQ (p2, Ipv6Address ("3ffe:1:4:2::"), "second prefix");
+  NS_TEST_EXPECT_MSG_EQ (pool->GetNAssigned (), 2, "two prefixes assigned");
+  NS_TEST_EXPECT_MSG_EQ (pool->Contains (Ipv6Address ("3ffe:1:5:1::")), false, "outside of the pool");
+
+  // without quarantine a released prefix is reused at once
+  NS_TEST_EXPECT_MSG_EQ (pool->Release (p1), true, "release");
+  NS_TEST_EXPECT_MSG_EQ (pool->Release (p1), false, "double release");
+  NS_TEST_EXPECT_MSG_EQ (pool->Assign (), p1, "free-list reused first");
+
+  // a reservation ahead of the high-water mark is skipped by Assign
+  NS_TEST_EXPECT_MSG_EQ (pool->Reserve (Ipv6Address ("3ffe:1:4:3::")), true, "reserve");
+  NS_TEST_EXPECT_MSG_EQ (pool->Reserve (Ipv6Address ("3ffe:1:4:3::")), false, "already assigned");
+  NS_TEST_EXPECT_MSG_EQ (pool->Assign (), Ipv6Address ("3ffe:1:4:4::"), "reserved prefix skipped");
+
+  // quarantined prefixes can only be reserved back
+  pool->SetQuarantine (Seconds (10.0));
+  pool->Release (p2);
+  NS_TEST_EXPECT_MSG_EQ (pool->IsAssigned (p2), false, "released");
+  NS_TEST_EXPECT_MSG_EQ (pool->GetNQuarantined (), 1, "in quarantine");
+  NS_TEST_EXPECT_MSG_EQ (pool->Assign (), Ipv6Address ("3ffe:1:4:5::"), "quarantined prefix not reused");
+  NS_TEST_EXPECT_MSG_EQ (pool->Reserve (p2), true, "previous owner takes it back");
+  NS_TEST_EXPECT_MSG_EQ (pool->GetNQuarantined (), 0, "left the quarantine");
+
+  pool->Release (p2);
+  Simulator::Schedule (Seconds (10.0), &Pmipv6PrefixPoolTestCase::CheckQuarantine, this, pool, p2);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // exhaustion of a small pool
+  Ptr<Pmipv6PrefixPool> small = Create<Pmipv6PrefixPool> (Ipv6Address ("3ffe:2::"), 62);
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (small->Assign ().IsAny (), false, "prefix available");
+    }
+  NS_TEST_EXPECT_MSG_EQ (small->Assign ().IsAny (), true, "pool exhausted");
+}
+
+static class Pmipv6PrefixPoolTestSuite : public TestSuite
+{
+public:
+  Pmipv6PrefixPoolTestSuite ()
+    : TestSuite ("pmip6-prefix-pool", UNIT)
+  {
+    AddTestCase (new Pmipv6PrefixPoolTestCase ());
+  }
+} g_pmipv6PrefixPoolTestSuite;
+
+} // namespace ns3
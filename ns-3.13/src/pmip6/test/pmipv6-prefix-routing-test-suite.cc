@@ -0,0 +1,144 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simple-channel.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv6-header.h"
+#include "ns3/ipv6-list-routing.h"
+#include "ns3/ipv6-static-routing-helper.h"
+#include "ns3/pmipv6-prefix-routing-helper.h"
+
+namespace ns3 {
+
+class Pmipv6PrefixRoutingTestCase : public TestCase
+{
+public:
+  Pmipv6PrefixRoutingTestCase ();
+private:
+  virtual void DoRun (void);
+  Ptr<Ipv6Route> Route (Ptr<Ipv6> ipv6, Ipv6Address dst);
+};
+
+Pmipv6PrefixRoutingTestCase::Pmipv6PrefixRoutingTestCase ()
+  : TestCase ("Check home network prefix routing ahead of static routing")
+{
+}
+
+Ptr<Ipv6Route>
+Pmipv6PrefixRoutingTestCase::Route (Ptr<Ipv6> ipv6, Ipv6Address dst)
+{
+  Ipv6Header header;
+  Socket::SocketErrno err;
+
+  header.SetDestinationAddress (dst);
+
+  return ipv6->GetRoutingProtocol ()->RouteOutput (Create<Packet> (), header, 0, err);
+}
+
+void
+Pmipv6PrefixRoutingTestCase::DoRun (void)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  InternetStackHelper internet;
+  internet.SetIpv4StackInstall (false);
+  internet.Install (node);
+
+  Ptr<Ipv6> ipv6 = node->GetObject<Ipv6> ();
+  uint32_t ifIndex[2];
+
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice> ();
+      dev->SetAddress (Mac48Address::Allocate ());
+      dev->SetChannel (CreateObject<SimpleChannel> ());
+      node->AddDevice (dev);
+
+      ifIndex[i] = ipv6->AddInterface (dev);
+      ipv6->SetUp (ifIndex[i]);
+    }
+  ipv6->AddAddress (ifIndex[0], Ipv6InterfaceAddress (Ipv6Address ("2001:db8::100"), Ipv6Prefix (64)));
+
+  Ptr<Ipv6ListRouting> listRouting = DynamicCast<Ipv6ListRouting> (ipv6->GetRoutingProtocol ());
+  NS_TEST_ASSERT_MSG_NE (listRouting, 0, "list routing expected");
+  listRouting->AddRoutingProtocol (CreateObject<Pmipv6PrefixRouting> (), 5);
+
+  Pmipv6PrefixRoutingHelper prefixRoutingHelper;
+  Ptr<Pmipv6PrefixRouting> prefixRouting = prefixRoutingHelper.GetPrefixRouting (ipv6);
+  NS_TEST_ASSERT_MSG_NE (prefixRouting, 0, "prefix routing found in the list");
+
+  // a covering static route which the prefix route must take precedence over
+  Ipv6StaticRoutingHelper staticRoutingHelper;
+  staticRoutingHelper.GetStaticRouting (ipv6)->AddNetworkRouteTo (Ipv6Address ("3ffe:1:4::"), Ipv6Prefix (48), ifIndex[0]);
+
+  prefixRouting->AddPrefixRoute (Ipv6Address ("3ffe:1:4:1::"), ifIndex[1]);
+  NS_TEST_EXPECT_MSG_EQ (prefixRouting->GetNRoutes (), 1, "one prefix route");
+  NS_TEST_EXPECT_MSG_EQ (prefixRouting->LookupPrefix (Ipv6Address ("3ffe:1:4:1::1234")), (int32_t)ifIndex[1], "exact /64 lookup");
+
+  Ptr<Ipv6Route> route = Route (ipv6, Ipv6Address ("3ffe:1:4:1::10"));
+  NS_TEST_ASSERT_MSG_NE (route, 0, "prefix route");
+  NS_TEST_EXPECT_MSG_EQ (route->GetOutputDevice (), ipv6->GetNetDevice (ifIndex[1]), "routed by prefix routing");
+
+  route = Route (ipv6, Ipv6Address ("3ffe:1:4:2::10"));
+  NS_TEST_ASSERT_MSG_NE (route, 0, "static route");
+  NS_TEST_EXPECT_MSG_EQ (route->GetOutputDevice (), ipv6->GetNetDevice (ifIndex[0]), "other prefixes fall through");
+
+  // a stale removal on the old interface must not delete the re-pointed route
+  prefixRouting->AddPrefixRoute (Ipv6Address ("3ffe:1:4:1::"), ifIndex[0]);
+  NS_TEST_EXPECT_MSG_EQ (prefixRouting->RemovePrefixRoute (Ipv6Address ("3ffe:1:4:1::"), ifIndex[1]), false, "stale removal ignored");
+  NS_TEST_EXPECT_MSG_EQ (Route (ipv6, Ipv6Address ("3ffe:1:4:1::10"))->GetOutputDevice (), ipv6->GetNetDevice (ifIndex[0]), "route re-pointed");
+  NS_TEST_EXPECT_MSG_EQ (prefixRouting->RemovePrefixRoute (Ipv6Address ("3ffe:1:4:1::"), ifIndex[0]), true, "route removed");
+  NS_TEST_EXPECT_MSG_EQ (prefixRouting->GetNRoutes (), 0, "table empty");
+
+  prefixRouting->AddPrefixRoute (Ipv6Address ("3ffe:1:4:3::"), ifIndex[1]);
+  prefixRouting->NotifyInterfaceDown (ifIndex[1]);
+  NS_TEST_EXPECT_MSG_EQ (prefixRouting->GetNRoutes (), 0, "routes through a down interface are flushed");
+
+  // a held prefix is not routed, until a route replaces the hold
+  prefixRouting->AddHoldRoute (Ipv6Address ("3ffe:1:4:4::"));
+  NS_TEST_EXPECT_MSG_EQ (prefixRouting->IsHeld (Ipv6Address ("3ffe:1:4:4::10")), true, "prefix held");
+  NS_TEST_EXPECT_MSG_EQ (prefixRouting->LookupPrefix (Ipv6Address ("3ffe:1:4:4::10")), -1, "held prefix not routed");
+  NS_TEST_EXPECT_MSG_EQ (prefixRouting->GetNRoutes (), 0, "holds are not routes");
+  prefixRouting->AddPrefixRoute (Ipv6Address ("3ffe:1:4:4::"), ifIndex[1]);
+  NS_TEST_EXPECT_MSG_EQ (prefixRouting->IsHeld (Ipv6Address ("3ffe:1:4:4::10")), false, "hold replaced");
+  NS_TEST_EXPECT_MSG_EQ (prefixRouting->GetNRoutes (), 1, "route added over the hold");
+  NS_TEST_EXPECT_MSG_EQ (prefixRouting->RemoveHoldRoute (Ipv6Address ("3ffe:1:4:4::")), false, "the route is not a hold");
+
+  Simulator::Destroy ();
+}
+
+static class Pmipv6PrefixRoutingTestSuite : public TestSuite
+{
+public:
+  Pmipv6PrefixRoutingTestSuite ()
+    : TestSuite ("pmip6-prefix-routing", UNIT)
+  {
+    AddTestCase (new Pmipv6PrefixRoutingTestCase ());
+  }
+} g_pmipv6PrefixRoutingTestSuite;
+
+} // namespace ns3
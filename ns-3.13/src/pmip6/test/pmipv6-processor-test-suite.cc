@@ -0,0 +1,261 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/ipv6-mobility-header.h"
+#include "ns3/pmipv6-processor.h"
+
+namespace ns3 {
+
+class Pmipv6ProcessorTestCase : public TestCase
+{
+public:
+  Pmipv6ProcessorTestCase (std::string name);
+
+protected:
+  Ptr<Pmipv6Processor> CreateProcessor (Time serviceTime, uint32_t nServers, uint32_t maxQueue);
+  void SendPbu (uint16_t sequence, uint16_t lifetime);
+  uint8_t Process (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface);
+
+  Ptr<Pmipv6Processor> m_processor;
+  std::vector<uint16_t> m_sequences;
+  std::vector<Time> m_times;
+};
+
+Pmipv6ProcessorTestCase::Pmipv6ProcessorTestCase (std::string name)
+  : TestCase (name)
+{
+}
+
+Ptr<Pmipv6Processor>
+Pmipv6ProcessorTestCase::CreateProcessor (Time serviceTime, uint32_t nServers, uint32_t maxQueue)
+{
+  m_sequences.clear ();
+  m_times.clear ();
+
+  m_processor = CreateObject<Pmipv6Processor> ();
+  m_processor->SetDefaultServiceTime (serviceTime);
+  m_processor->SetNServers (nServers);
+  m_processor->SetMaxQueueLength (maxQueue);
+  m_processor->SetProcessCallback (MakeCallback (&Pmipv6ProcessorTestCase::Process, this));
+
+  return m_processor;
+}
+
+void
+Pmipv6ProcessorTestCase::SendPbu (uint16_t sequence, uint16_t lifetime)
+{
+  Ipv6MobilityBindingUpdateHeader pbu;
+  Ptr<Packet> packet = Create<Packet> ();
+
+  pbu.SetSequence (sequence);
+  pbu.SetLifetime (lifetime);
+  pbu.SetFlagP (true);
+  packet->AddHeader (pbu);
+
+  m_processor->Receive (packet, Ipv6Address ("2001:1::1"), Ipv6Address ("2001:1::2"), 0);
+}
+
+uint8_t
+Pmipv6ProcessorTestCase::Process (Ptr<Packet> packet, const Ipv6Address &src, const Ipv6Address &dst, Ptr<Ipv6Interface> interface)
+{
+  Ipv6MobilityBindingUpdateHeader pbu;
+
+  packet->PeekHeader (pbu);
+  m_sequences.push_back (pbu.GetSequence ());
+  m_times.push_back (Simulator::Now ());
+
+  return 0;
+}
+
+class Pmipv6ProcessorQueueTestCase : public Pmipv6ProcessorTestCase
+{
+public:
+  Pmipv6ProcessorQueueTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+Pmipv6ProcessorQueueTestCase::Pmipv6ProcessorQueueTestCase ()
+  : Pmipv6ProcessorTestCase ("Check the service, queue length and sojourn times of the mobility messages")
+{
+}
+
+void
+Pmipv6ProcessorQueueTestCase::DoRun (void)
+{
+  // one server, five messages at once
+  CreateProcessor (MilliSeconds (10), 1, 1000);
+
+  for (uint16_t i = 0; i < 5; i++)
+    {
+      SendPbu (i, 100);
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (m_processor->GetNBusy (), 1, "one message served");
+  NS_TEST_EXPECT_MSG_EQ (m_processor->GetQueueLength (), 4, "the others wait");
+
+  Simulator::Stop (MilliSeconds (100));
+  Simulator::Run ();
+
+  Pmipv6Processor::Statistics stats = m_processor->GetStatistics ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_sequences.size (), 5, "all processed");
+  for (uint32_t i = 0; i < m_sequences.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_sequences[i], i, "in arrival order");
+      NS_TEST_EXPECT_MSG_EQ (m_times[i], MilliSeconds (10 * (i + 1)), "one after the other");
+    }
+  NS_TEST_EXPECT_MSG_EQ (stats.received, 5, "received");
+  NS_TEST_EXPECT_MSG_EQ (stats.processed, 5, "processed");
+  NS_TEST_EXPECT_MSG_EQ (stats.dropped, 0, "none dropped");
+  NS_TEST_EXPECT_MSG_EQ (stats.maxQueueLength, 4, "max queue length");
+  NS_TEST_EXPECT_MSG_EQ (stats.avgSojournTime, MilliSeconds (30), "mean sojourn");
+  NS_TEST_EXPECT_MSG_EQ (stats.maxSojournTime, MilliSeconds (50), "max sojourn");
+  // (4 + 3 + 2 + 1) messages for 10 ms each, over 100 ms
+  NS_TEST_EXPECT_MSG_EQ_TOL (stats.avgQueueLength, 1.0, 1e-9, "time average of the queue length");
+
+  Simulator::Destroy ();
+
+  // two servers share the load
+  CreateProcessor (MilliSeconds (10), 2, 1000);
+
+  for (uint16_t i = 0; i < 4; i++)
+    {
+      SendPbu (i, 100);
+    }
+
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_times.size (), 4, "all processed");
+  NS_TEST_EXPECT_MSG_EQ (m_times[1], MilliSeconds (10), "two at a time");
+  NS_TEST_EXPECT_MSG_EQ (m_times[3], MilliSeconds (20), "two at a time");
+  NS_TEST_EXPECT_MSG_EQ (m_processor->GetStatistics ().maxSojournTime, MilliSeconds (20), "halved sojourn");
+
+  Simulator::Destroy ();
+}
+
+class Pmipv6ProcessorPolicyTestCase : public Pmipv6ProcessorTestCase
+{
+public:
+  Pmipv6ProcessorPolicyTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+Pmipv6ProcessorPolicyTestCase::Pmipv6ProcessorPolicyTestCase ()
+  : Pmipv6ProcessorTestCase ("Check the drop and priority policies of the processor queue")
+{
+}
+
+void
+Pmipv6ProcessorPolicyTestCase::DoRun (void)
+{
+  // drop tail: the newest messages are lost
+  CreateProcessor (MilliSeconds (10), 1, 2);
+
+  for (uint16_t i = 0; i < 5; i++)
+    {
+      SendPbu (i, 100);
+    }
+
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_sequences.size (), 3, "one served, two queued");
+  NS_TEST_EXPECT_MSG_EQ (m_sequences[2], 2, "newest dropped");
+  NS_TEST_EXPECT_MSG_EQ (m_processor->GetStatistics ().dropped, 2, "two dropped");
+
+  Simulator::Destroy ();
+
+  // drop head: the oldest waiting messages are lost
+  CreateProcessor (MilliSeconds (10), 1, 2);
+  m_processor->SetDropPolicy (Pmipv6Processor::DROP_HEAD);
+
+  for (uint16_t i = 0; i < 5; i++)
+    {
+      SendPbu (i, 100);
+    }
+
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_sequences.size (), 3, "one served, two queued");
+  NS_TEST_EXPECT_MSG_EQ (m_sequences[0], 0, "served at once");
+  NS_TEST_EXPECT_MSG_EQ (m_sequences[1], 3, "oldest dropped");
+  NS_TEST_EXPECT_MSG_EQ (m_sequences[2], 4, "oldest dropped");
+
+  Simulator::Destroy ();
+
+  // deregistrations first, and in place of the other messages when full
+  CreateProcessor (MilliSeconds (10), 1, 2);
+  m_processor->SetPriorityPolicy (Pmipv6Processor::DEREGISTRATIONS_FIRST);
+
+  SendPbu (0, 100);
+  SendPbu (1, 100);
+  SendPbu (2, 100);
+  SendPbu (3, 0);
+
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_sequences.size (), 3, "one registration dropped");
+  NS_TEST_EXPECT_MSG_EQ (m_sequences[0], 0, "served at once");
+  NS_TEST_EXPECT_MSG_EQ (m_sequences[1], 3, "deregistration first");
+  NS_TEST_EXPECT_MSG_EQ (m_sequences[2], 1, "newest registration dropped");
+
+  Simulator::Destroy ();
+
+  // drop head never evicts a deregistration for a registration
+  CreateProcessor (MilliSeconds (10), 1, 2);
+  m_processor->SetDropPolicy (Pmipv6Processor::DROP_HEAD);
+  m_processor->SetPriorityPolicy (Pmipv6Processor::DEREGISTRATIONS_FIRST);
+
+  SendPbu (0, 100);
+  SendPbu (1, 0);
+  SendPbu (2, 0);
+  SendPbu (3, 100);
+
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_sequences.size (), 3, "the registration dropped");
+  NS_TEST_EXPECT_MSG_EQ (m_sequences[1], 1, "deregistration kept");
+  NS_TEST_EXPECT_MSG_EQ (m_sequences[2], 2, "deregistration kept");
+
+  Simulator::Destroy ();
+}
+
+static class Pmipv6ProcessorTestSuite : public TestSuite
+{
+public:
+  Pmipv6ProcessorTestSuite ()
+    : TestSuite ("pmip6-processor", UNIT)
+  {
+    AddTestCase (new Pmipv6ProcessorQueueTestCase ());
+    AddTestCase (new Pmipv6ProcessorPolicyTestCase ());
+  }
+} g_pmipv6ProcessorTestSuite;
+
+} // namespace ns3
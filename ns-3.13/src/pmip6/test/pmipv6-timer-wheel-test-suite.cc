@@ -0,0 +1,266 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/pmipv6-timer-wheel.h"
+
+namespace ns3 {
+
+class TimerProbe
+{
+public:
+  TimerProbe ()
+    : m_fired (0),
+      m_rearm (0)
+  {
+    m_timer.SetFunction (&TimerProbe::Fire, this);
+  }
+
+  void Fire (void)
+  {
+    m_fired++;
+    m_lastFired = Simulator::Now ();
+
+    if (m_rearm > 0)
+      {
+        m_rearm--;
+        m_timer.Schedule ();
+      }
+  }
+
+  Pmipv6Timer m_timer;
+  uint32_t m_fired;
+  uint32_t m_rearm;
+  Time m_lastFired;
+};
+
+class Pmipv6TimerWheelExpiryTestCase : public TestCase
+{
+public:
+  Pmipv6TimerWheelExpiryTestCase ();
+private:
+  virtual void DoRun (void);
+  void Check (void);
+
+  std::vector<TimerProbe *> m_batch;
+  TimerProbe m_cancelled;
+  TimerProbe m_moved;
+  TimerProbe m_far;
+  TimerProbe m_periodic;
+};
+
+Pmipv6TimerWheelExpiryTestCase::Pmipv6TimerWheelExpiryTestCase ()
+  : TestCase ("Check expiration, cancellation and batching of wheel timers")
+{
+}
+
+void
+Pmipv6TimerWheelExpiryTestCase::Check (void)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_moved.m_timer.IsRunning (), true, "rescheduled timer still running");
+  NS_TEST_EXPECT_MSG_EQ (m_moved.m_timer.GetDelayLeft (), Seconds (1.5), "time left, rounded up to the tick");
+}
+
+void
+Pmipv6TimerWheelExpiryTestCase::DoRun (void)
+{
+  Pmipv6TimerWheel::SetResolution (MilliSeconds (10));
+
+  uint64_t events = Pmipv6TimerWheel::GetNEvents ();
+
+  // 1000 timers within a single tick fire together
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      TimerProbe *probe = new TimerProbe ();
+
+      probe->m_timer.SetDelay (Seconds (1.0) + MicroSeconds (5 * i + 1));
+      probe->m_timer.Schedule ();
+      m_batch.push_back (probe);
+    }
+
+  m_cancelled.m_timer.Schedule (Seconds (0.5));
+  m_cancelled.m_timer.Cancel ();
+
+  m_moved.m_timer.Schedule (Seconds (0.5));
+  m_moved.m_timer.Schedule (Seconds (2.0));
+
+  // goes through the cascades of every level but the last
+  m_far.m_timer.Schedule (Seconds (20000.0));
+
+  m_periodic.m_timer.SetDelay (Seconds (30.0));
+  m_periodic.m_rearm = 9;
+  m_periodic.m_timer.Schedule ();
+
+  NS_TEST_EXPECT_MSG_EQ (Pmipv6TimerWheel::GetNTimers (), 1003, "running timers");
+
+  Simulator::Schedule (Seconds (0.5), &Pmipv6TimerWheelExpiryTestCase::Check, this);
+  Simulator::Run ();
+
+  uint32_t fired = 0;
+
+  for (uint32_t i = 0; i < m_batch.size (); i++)
+    {
+      fired += m_batch[i]->m_fired;
+      NS_TEST_EXPECT_MSG_EQ (m_batch[i]->m_lastFired, Seconds (1.01), "expiration rounded up to the next tick");
+      delete m_batch[i];
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (fired, 1000, "all batched timers fired once");
+  NS_TEST_EXPECT_MSG_EQ (m_cancelled.m_fired, 0, "cancelled timer not fired");
+  NS_TEST_EXPECT_MSG_EQ (m_moved.m_fired, 1, "rescheduled timer fired once");
+  NS_TEST_EXPECT_MSG_EQ (m_moved.m_lastFired, Seconds (2.0), "at its new expiration");
+  NS_TEST_EXPECT_MSG_EQ (m_far.m_fired, 1, "far timer fired");
+  NS_TEST_EXPECT_MSG_EQ (m_far.m_lastFired, Seconds (20000.0), "far timer on time");
+  NS_TEST_EXPECT_MSG_EQ (m_periodic.m_fired, 10, "periodic timer");
+  NS_TEST_EXPECT_MSG_EQ (m_periodic.m_lastFired, Seconds (300.0), "periodic timer on time");
+  NS_TEST_EXPECT_MSG_EQ (Pmipv6TimerWheel::GetNTimers (), 0, "no timer left");
+
+  // one event per cascade of the first level (2.56s) at most, instead of
+  // one per timer
+  NS_TEST_EXPECT_MSG_LT (Pmipv6TimerWheel::GetNEvents () - events, 20000 / 2.56 + 20, "events shared by the timers");
+
+  Simulator::Destroy ();
+}
+
+class Pmipv6TimerWheelDestroyTestCase : public TestCase
+{
+public:
+  Pmipv6TimerWheelDestroyTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+Pmipv6TimerWheelDestroyTestCase::Pmipv6TimerWheelDestroyTestCase ()
+  : TestCase ("Check that timers are stopped by Simulator::Destroy")
+{
+}
+
+void
+Pmipv6TimerWheelDestroyTestCase::DoRun (void)
+{
+  TimerProbe probe;
+
+  probe.m_timer.Schedule (Seconds (10.0));
+  Simulator::Stop (Seconds (1.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (probe.m_timer.IsRunning (), false, "stopped by the reset of the wheel");
+  NS_TEST_EXPECT_MSG_EQ (Pmipv6TimerWheel::GetNTimers (), 0, "wheel empty");
+
+  probe.m_timer.Schedule (Seconds (1.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (probe.m_fired, 1, "usable in the next simulation");
+  NS_TEST_EXPECT_MSG_EQ (probe.m_lastFired, Seconds (1.0), "from the new start time");
+}
+
+class OrderProbe
+{
+public:
+  OrderProbe ()
+    : m_id (0),
+      m_log (0)
+  {
+    m_timer.SetFunction (&OrderProbe::Fire, this);
+  }
+
+  void Fire (void)
+  {
+    m_log->push_back (m_id);
+  }
+
+  Pmipv6Timer m_timer;
+  uint32_t m_id;
+  std::vector<uint32_t> *m_log;
+};
+
+class Pmipv6TimerWheelOrderTestCase : public TestCase
+{
+public:
+  Pmipv6TimerWheelOrderTestCase ();
+private:
+  virtual void DoRun (void);
+  void ScheduleLate (void);
+
+  OrderProbe m_probes[5];
+  std::vector<uint32_t> m_order;
+};
+
+Pmipv6TimerWheelOrderTestCase::Pmipv6TimerWheelOrderTestCase ()
+  : TestCase ("Check that timers of the same tick fire in the order they were scheduled")
+{
+}
+
+void
+Pmipv6TimerWheelOrderTestCase::ScheduleLate (void)
+{
+  // same tick as probe 2, but placed directly in the first level while
+  // probe 2 is cascaded down from the second one
+  m_probes[3].m_timer.Schedule (Seconds (1.0));
+  m_probes[4].m_timer.Schedule (Seconds (1.0));
+}
+
+void
+Pmipv6TimerWheelOrderTestCase::DoRun (void)
+{
+  Pmipv6TimerWheel::SetResolution (MilliSeconds (10));
+
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      m_probes[i].m_id = i;
+      m_probes[i].m_log = &m_order;
+    }
+
+  m_probes[0].m_timer.Schedule (Seconds (1.0));
+  m_probes[1].m_timer.Schedule (Seconds (1.0));
+  m_probes[2].m_timer.Schedule (Seconds (3.0));
+  Simulator::Schedule (Seconds (2.0), &Pmipv6TimerWheelOrderTestCase::ScheduleLate, this);
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_order.size (), 5, "all timers fired");
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_order[i], i, "fired in scheduling order");
+    }
+}
+
+static class Pmipv6TimerWheelTestSuite : public TestSuite
+{
+public:
+  Pmipv6TimerWheelTestSuite ()
+    : TestSuite ("pmip6-timer-wheel", UNIT)
+  {
+    AddTestCase (new Pmipv6TimerWheelExpiryTestCase ());
+    AddTestCase (new Pmipv6TimerWheelDestroyTestCase ());
+    AddTestCase (new Pmipv6TimerWheelOrderTestCase ());
+  }
+} g_pmipv6TimerWheelTestSuite;
+
+} // namespace ns3
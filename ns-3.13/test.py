@@ -28,6 +28,7 @@ import signal
 import xml.dom.minidom
 import shutil
 import re
+import distutils.spawn
 
 from utils import get_list_from_file
 
@@ -53,6 +54,7 @@ interesting_config_items = [
     "ENABLE_PYTHON_BINDINGS",
     "ENABLE_CLICK",
     "ENABLE_OPENFLOW",
+    "ENABLE_MPI",
 ]
 
 NSC_ENABLED = False
@@ -62,6 +64,7 @@ ENABLE_EXAMPLES = True
 ENABLE_TESTS = True
 ENABLE_CLICK = False
 ENABLE_OPENFLOW = False
+ENABLE_MPI = False
 EXAMPLE_DIRECTORIES = []
 
 #
@@ -122,13 +125,27 @@ def parse_examples_to_run_file(
         #
         #     ("tcp-nsc-lfn", "NSC_ENABLED == True", "NSC_ENABLED == False"),
         #
+        # The example_name may be followed by arguments, and preceded by
+        # a launcher that must be in the PATH.  For example,
+        #
+        #     ("mpirun -np 2 simple-distributed --nix=0", "ENABLE_MPI == True", "False"),
+        #
         cpp_examples = get_list_from_file(examples_to_run_path, "cpp_examples")
         for example_name, do_run, do_valgrind_run in cpp_examples:
-            example_path = os.path.join(cpp_executable_dir, example_name)
-            # Add all of the C++ examples that were built, i.e. found
-            # in the directory, to the list of C++ examples to run.
-            if os.path.exists(example_path):
-                example_tests.append((example_path, do_run, do_valgrind_run))
+            words = example_name.split()
+            for i in range(len(words)):
+                example_path = os.path.join(cpp_executable_dir, words[i])
+                # Add all of the C++ examples that were built, i.e. found
+                # in the directory, to the list of C++ examples to run.
+                if os.path.exists(example_path):
+                    launcher = words[:i]
+                    if len(launcher):
+                        launcher[0] = distutils.spawn.find_executable(launcher[0])
+                        if launcher[0] is None:
+                            break
+                    command = " ".join(launcher + [example_path] + words[i + 1:])
+                    example_tests.append((example_path, command, do_run, do_valgrind_run))
+                    break
 
         # Each tuple in the Python list of examples to run contains
         #
@@ -1275,10 +1292,10 @@ def run_tests():
     if len(options.suite) == 0 and len(options.example) == 0 and len(options.pyexample) == 0:
         if len(options.constrain) == 0 or options.constrain == "example":
             if ENABLE_EXAMPLES:
-                for test, do_run, do_valgrind_run in example_tests:
+                for example_path, test, do_run, do_valgrind_run in example_tests:
 
                     # Don't try to run this example if it isn't runnable.
-                    if os.path.basename(test) in ns3_runnable_programs:
+                    if os.path.basename(example_path) in ns3_runnable_programs:
                         if eval(do_run):
                             job = Job()
                             job.set_is_example(True)
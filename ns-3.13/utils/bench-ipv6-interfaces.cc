@@ -0,0 +1,199 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measures the per-packet cost of Ipv6L3Protocol::Receive on a node with
+ * many interfaces, as an LMA with one tunnel per MAG. Each packet comes in
+ * on interface i and is addressed to interface n-1-i, so both the device
+ * and the address lookups are exercised, then it is handed to a dummy
+ * layer 4 protocol.
+ */
+
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/packet.h"
+#include "ns3/node.h"
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/mac48-address.h"
+#include "ns3/ipv6-header.h"
+#include "ns3/ipv6-l3-protocol.h"
+#include "ns3/ipv6-l4-protocol.h"
+#include "ns3/ipv6-interface.h"
+#include "ns3/internet-stack-helper.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <string.h>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+class BenchL4Protocol : public Ipv6L4Protocol
+{
+public:
+  static const uint8_t PROT_NUMBER = 253;
+
+  BenchL4Protocol () : m_received (0) {}
+
+  virtual int GetProtocolNumber () const
+  {
+    return PROT_NUMBER;
+  }
+
+  virtual enum RxStatus_e Receive (Ptr<Packet> p, Ipv6Address const &src, Ipv6Address const &dst, Ptr<Ipv6Interface> incomingInterface)
+  {
+    m_received++;
+    return RX_OK;
+  }
+
+  uint32_t m_received;
+};
+
+static Ptr<Node> g_node;
+static Ptr<Ipv6L3Protocol> g_ipv6;
+static Ptr<BenchL4Protocol> g_l4;
+static std::vector<Ptr<NetDevice> > g_devices;
+static std::vector<Ipv6Address> g_addresses;
+static uint32_t g_nInterfaces = 1000;
+
+static Ipv6Address
+MakeAddress (uint32_t i)
+{
+  uint8_t buf[16] = { 0x20, 0x01, 0x0d, 0xb8, (uint8_t)(i >> 24), (uint8_t)(i >> 16), (uint8_t)(i >> 8), (uint8_t)i,
+                      0, 0, 0, 0, 0, 0, 0, 1 };
+  return Ipv6Address (buf);
+}
+
+static void
+Setup (void)
+{
+  Config::SetDefault ("ns3::Icmpv6L4Protocol::DAD", BooleanValue (false));
+
+  g_node = CreateObject<Node> ();
+  InternetStackHelper internet;
+  internet.SetIpv4StackInstall (false);
+  internet.Install (g_node);
+
+  g_ipv6 = g_node->GetObject<Ipv6L3Protocol> ();
+  g_l4 = CreateObject<BenchL4Protocol> ();
+  g_ipv6->Insert (g_l4);
+
+  for (uint32_t i = 0; i < g_nInterfaces; i++)
+    {
+      Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+      device->SetAddress (Mac48Address::Allocate ());
+      g_node->AddDevice (device);
+
+      uint32_t index = g_ipv6->AddInterface (device);
+      g_ipv6->AddAddress (index, Ipv6InterfaceAddress (MakeAddress (i), Ipv6Prefix (64)));
+      g_ipv6->SetUp (index);
+
+      g_devices.push_back (device);
+      g_addresses.push_back (MakeAddress (i));
+    }
+}
+
+static void
+benchReceive (uint32_t n)
+{
+  Ptr<Packet> payload = Create<Packet> (64);
+
+  for (uint32_t i = 0; i < n; i++)
+    {
+      uint32_t in = i % g_nInterfaces;
+      Ipv6Header hdr;
+
+      hdr.SetSourceAddress (Ipv6Address ("2001:db8:ffff::1"));
+      hdr.SetDestinationAddress (g_addresses[g_nInterfaces - 1 - in]);
+      hdr.SetNextHeader (BenchL4Protocol::PROT_NUMBER);
+      hdr.SetPayloadLength (payload->GetSize ());
+      hdr.SetHopLimit (64);
+
+      Ptr<Packet> p = payload->Copy ();
+      p->AddHeader (hdr);
+      g_ipv6->Receive (g_devices[in], p, Ipv6L3Protocol::PROT_NUMBER, g_devices[in]->GetAddress (), g_devices[in]->GetAddress (), NetDevice::PACKET_HOST);
+    }
+}
+
+static void
+runBench (void (*bench) (uint32_t), uint32_t n, char const *name)
+{
+  SystemWallClockMs time;
+  time.Start ();
+  (*bench) (n);
+  uint64_t deltaMs = time.End ();
+  double ps = n;
+  ps *= 1000;
+  ps /= deltaMs;
+  std::cout << name<<"=" << ps << " packets/s" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 0;
+  while (argc > 0) {
+      if (strncmp ("--n=", argv[0],strlen ("--n=")) == 0)
+        {
+          char const *nAscii = argv[0] + strlen ("--n=");
+          std::istringstream iss;
+          iss.str (nAscii);
+          iss >> n;
+        }
+      if (strncmp ("--interfaces=", argv[0],strlen ("--interfaces=")) == 0)
+        {
+          char const *nAscii = argv[0] + strlen ("--interfaces=");
+          std::istringstream iss;
+          iss.str (nAscii);
+          iss >> g_nInterfaces;
+        }
+      argc--;
+      argv++;
+  }
+  if (n == 0)
+    {
+      std::cerr << "Error-- number of packets must be specified " <<
+        "by command-line argument --n=(number of packets)" << std::endl;
+      exit (1);
+    }
+  if (g_nInterfaces == 0)
+    {
+      std::cerr << "Error-- --interfaces must be at least 1" << std::endl;
+      exit (1);
+    }
+
+  Setup ();
+
+  std::cout << "Running bench-ipv6-interfaces with n=" << n
+            << " interfaces=" << g_nInterfaces << std::endl;
+
+  runBench (&benchReceive, n, "receive");
+
+  if (g_l4->m_received != n)
+    {
+      std::cerr << "Error-- " << n - g_l4->m_received << " packets were not delivered" << std::endl;
+      exit (1);
+    }
+
+  g_l4 = 0;
+  g_ipv6 = 0;
+  g_devices.clear ();
+  g_node->Dispose ();
+  g_node = 0;
+
+  return 0;
+}
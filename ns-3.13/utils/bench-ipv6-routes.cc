@@ -0,0 +1,187 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measures the route lookups of Ipv6StaticRouting on a core router
+ * table: one /64 per home network prefix, a few /48 aggregates and
+ * a default route. Lookups go through RouteOutput, the destinations
+ * are hosts of the /64 prefixes.
+ */
+
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/node.h"
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/mac48-address.h"
+#include "ns3/ipv6-header.h"
+#include "ns3/ipv6-route.h"
+#include "ns3/ipv6-l3-protocol.h"
+#include "ns3/ipv6-static-routing.h"
+#include "ns3/ipv6-static-routing-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <string.h>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+static Ptr<Node> g_node;
+static Ptr<Ipv6StaticRouting> g_routing;
+static std::vector<Ipv6Address> g_destinations;
+static std::vector<Ipv6Address> g_prefixes;
+static uint32_t g_nRoutes = 10000;
+static uint32_t g_nInterfaces = 4;
+
+static Ipv6Address
+MakePrefix (uint32_t i)
+{
+  uint8_t buf[16] = { 0x20, 0x01, 0x0d, 0xb8, (uint8_t)(i >> 16), (uint8_t)(i >> 8), 0, (uint8_t)i };
+  return Ipv6Address (buf);
+}
+
+static void
+Setup (void)
+{
+  Config::SetDefault ("ns3::Icmpv6L4Protocol::DAD", BooleanValue (false));
+
+  g_node = CreateObject<Node> ();
+  InternetStackHelper internet;
+  internet.SetIpv4StackInstall (false);
+  internet.Install (g_node);
+
+  Ptr<Ipv6L3Protocol> ipv6 = g_node->GetObject<Ipv6L3Protocol> ();
+  for (uint32_t i = 0; i < g_nInterfaces; i++)
+    {
+      Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+      device->SetAddress (Mac48Address::Allocate ());
+      g_node->AddDevice (device);
+      ipv6->SetUp (ipv6->AddInterface (device));
+    }
+
+  Ipv6StaticRoutingHelper helper;
+  g_routing = helper.GetStaticRouting (ipv6);
+
+  g_routing->SetDefaultRoute ("fe80::1", 1);
+  for (uint32_t i = 0; i < 256; i++)
+    {
+      g_routing->AddNetworkRouteTo (MakePrefix (i << 8), Ipv6Prefix (48), "fe80::2", 1 + i % g_nInterfaces);
+    }
+  for (uint32_t i = 0; i < g_nRoutes; i++)
+    {
+      /* spread the /64 over the /48 aggregates */
+      uint32_t p = (i * 2654435761u) >> 8;
+      g_routing->AddNetworkRouteTo (MakePrefix (p), Ipv6Prefix (64), "fe80::3", 1 + i % g_nInterfaces);
+      g_prefixes.push_back (MakePrefix (p));
+
+      uint8_t buf[16];
+      MakePrefix (p).GetBytes (buf);
+      buf[15] = 1;
+      g_destinations.push_back (Ipv6Address (buf));
+    }
+}
+
+static void
+benchLookup (uint32_t n)
+{
+  Ipv6Header header;
+  Socket::SocketErrno err;
+
+  for (uint32_t i = 0; i < n; i++)
+    {
+      header.SetDestinationAddress (g_destinations[i % g_destinations.size ()]);
+      Ptr<Ipv6Route> route = g_routing->RouteOutput (0, header, 0, err);
+      if (!route)
+        {
+          std::cerr << "Error-- no route to " << header.GetDestinationAddress () << std::endl;
+          exit (1);
+        }
+    }
+}
+
+static void
+runBench (void (*bench) (uint32_t), uint32_t n, char const *name)
+{
+  SystemWallClockMs time;
+  time.Start ();
+  (*bench) (n);
+  uint64_t deltaMs = time.End ();
+  double ps = n;
+  ps *= 1000;
+  ps /= deltaMs;
+  std::cout << name<<"=" << ps << " lookups/s" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 0;
+  while (argc > 0) {
+      if (strncmp ("--n=", argv[0],strlen ("--n=")) == 0)
+        {
+          char const *nAscii = argv[0] + strlen ("--n=");
+          std::istringstream iss;
+          iss.str (nAscii);
+          iss >> n;
+        }
+      if (strncmp ("--routes=", argv[0],strlen ("--routes=")) == 0)
+        {
+          char const *nAscii = argv[0] + strlen ("--routes=");
+          std::istringstream iss;
+          iss.str (nAscii);
+          iss >> g_nRoutes;
+        }
+      argc--;
+      argv++;
+  }
+  if (n == 0)
+    {
+      std::cerr << "Error-- number of lookups must be specified " <<
+        "by command-line argument --n=(number of lookups)" << std::endl;
+      exit (1);
+    }
+  if (g_nRoutes == 0)
+    {
+      std::cerr << "Error-- --routes must be at least 1" << std::endl;
+      exit (1);
+    }
+
+  SystemWallClockMs time;
+  time.Start ();
+  Setup ();
+  uint64_t setupMs = time.End ();
+
+  std::cout << "Running bench-ipv6-routes with n=" << n
+            << " routes=" << g_routing->GetNRoutes ()
+            << " (setup " << setupMs << " ms)" << std::endl;
+
+  runBench (&benchLookup, n, "lookup");
+
+  time.Start ();
+  for (uint32_t i = 0; i < g_nRoutes; i++)
+    {
+      g_routing->RemoveRoute (g_prefixes[i], Ipv6Prefix (64), 1 + i % g_nInterfaces, Ipv6Address::GetZero ());
+    }
+  std::cout << "remove=" << time.End () << " ms, " << g_routing->GetNRoutes () << " routes left" << std::endl;
+
+  g_routing = 0;
+  g_node->Dispose ();
+  g_node = 0;
+
+  return 0;
+}
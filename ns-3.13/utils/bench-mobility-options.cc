@@ -0,0 +1,241 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measures the parsing of the mobility options of a PBU, as built by
+ * Pmipv6Mag::BuildPbu, through Ipv6Mobility::ProcessOptions ("buffer")
+ * and through the per-option packet based Process methods ("packet"),
+ * which is how options were parsed before the single pass walker.
+ */
+
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/packet.h"
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/mac48-address.h"
+#include "ns3/identifier.h"
+#include "ns3/ipv6-mobility.h"
+#include "ns3/ipv6-mobility-header.h"
+#include "ns3/ipv6-mobility-option.h"
+#include "ns3/ipv6-mobility-option-header.h"
+#include "ns3/ipv6-mobility-option-demux.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string.h>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+static Ptr<Node> g_node;
+static Ptr<Ipv6MobilityOptionDemux> g_demux;
+static Ptr<Ipv6Mobility> g_mobility;
+static Ptr<Packet> g_pbu;
+static uint8_t g_offset;
+static uint8_t g_length;
+static uint32_t g_nPrefixes = 1;
+
+static void
+Setup (void)
+{
+  g_node = CreateObject<Node> ();
+  g_demux = CreateObject<Ipv6MobilityOptionDemux> ();
+  g_demux->SetNode (g_node);
+  g_node->AggregateObject (g_demux);
+
+  g_demux->Insert (CreateObject<Ipv6MobilityOptionPad1> ());
+  g_demux->Insert (CreateObject<Ipv6MobilityOptionPadn> ());
+  g_demux->Insert (CreateObject<Ipv6MobilityOptionMobileNodeIdentifier> ());
+  g_demux->Insert (CreateObject<Ipv6MobilityOptionHomeNetworkPrefix> ());
+  g_demux->Insert (CreateObject<Ipv6MobilityOptionHandoffIndicator> ());
+  g_demux->Insert (CreateObject<Ipv6MobilityOptionAccessTechnologyType> ());
+  g_demux->Insert (CreateObject<Ipv6MobilityOptionMobileNodeLinkLayerIdentifier> ());
+  g_demux->Insert (CreateObject<Ipv6MobilityOptionLinkLocalAddress> ());
+  g_demux->Insert (CreateObject<Ipv6MobilityOptionTimestamp> ());
+
+  g_mobility = CreateObject<Ipv6MobilityBindingUpdate> ();
+  g_mobility->SetNode (g_node);
+
+  Ipv6MobilityBindingUpdateHeader pbu;
+  Ipv6MobilityOptionMobileNodeIdentifierHeader mnidh;
+  Ipv6MobilityOptionHomeNetworkPrefixHeader hnph;
+  Ipv6MobilityOptionHandoffIndicatorHeader hih;
+  Ipv6MobilityOptionAccessTechnologyTypeHeader atth;
+  Ipv6MobilityOptionMobileNodeLinkLayerIdentifierHeader mnllidh;
+  Ipv6MobilityOptionLinkLocalAddressHeader llah;
+  Ipv6MobilityOptionTimestampHeader timestamph;
+
+  pbu.SetSequence (1);
+  pbu.SetFlagA (true);
+  pbu.SetFlagH (true);
+  pbu.SetFlagL (true);
+  pbu.SetFlagP (true);
+  pbu.SetLifetime (1000);
+
+  mnidh.SetSubtype (1);
+  mnidh.SetNodeIdentifier (Identifier ("mn0001@pmip6.example"));
+  pbu.AddOption (mnidh);
+
+  for (uint32_t i = 0; i < g_nPrefixes; i++)
+    {
+      uint8_t buf[16] = { 0x20, 0x01, 0x0d, 0xb8, 0x00, (uint8_t)(i >> 8), (uint8_t)i, 0 };
+
+      hnph.SetPrefix (Ipv6Address (buf));
+      hnph.SetPrefixLength (64);
+      pbu.AddOption (hnph);
+    }
+
+  hih.SetHandoffIndicator (1);
+  pbu.AddOption (hih);
+
+  atth.SetAccessTechnologyType (4);
+  pbu.AddOption (atth);
+
+  mnllidh.SetLinkLayerIdentifier (Identifier (Mac48Address ("00:00:00:00:00:01")));
+  pbu.AddOption (mnllidh);
+
+  llah.SetLinkLocalAddress (Ipv6Address ("fe80::1"));
+  pbu.AddOption (llah);
+
+  timestamph.SetTimestamp (Seconds (1.5));
+  pbu.AddOption (timestamph);
+
+  g_pbu = Create<Packet> ();
+  g_pbu->AddHeader (pbu);
+
+  Ipv6MobilityBindingUpdateHeader received;
+  g_pbu->PeekHeader (received);
+
+  g_offset = received.GetOptionsOffset ();
+  g_length = ((received.GetHeaderLen () + 1) << 3) - received.GetOptionsOffset ();
+}
+
+static void
+benchPacket (uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ipv6MobilityOptionBundle bundle;
+      Ptr<Packet> p = g_pbu->Copy ();
+      p->RemoveAtStart (g_offset);
+
+      uint32_t size = p->GetSize ();
+      uint8_t *data = new uint8_t[size];
+      p->CopyData (data, size);
+
+      uint8_t processedSize = 0;
+
+      while (processedSize < g_length)
+        {
+          uint8_t optType = data[processedSize];
+          uint8_t optLen;
+          Ptr<Ipv6MobilityOption> option = g_demux->GetOption (optType);
+
+          if (option == 0)
+            {
+              optLen = optType == 0 ? 1 : data[processedSize + 1] + 2;
+            }
+          else
+            {
+              optLen = option->Process (g_pbu, g_offset + processedSize, bundle);
+            }
+
+          processedSize += optLen;
+          p->RemoveAtStart (optLen);
+        }
+
+      delete [] data;
+    }
+}
+
+static void
+benchBuffer (uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      Ipv6MobilityOptionBundle bundle;
+      g_mobility->ProcessOptions (g_pbu, g_offset, g_length, bundle);
+    }
+}
+
+static void
+runBench (void (*bench) (uint32_t), uint32_t n, char const *name)
+{
+  SystemWallClockMs time;
+  time.Start ();
+  (*bench) (n);
+  uint64_t deltaMs = time.End ();
+  double ps = n;
+  ps *= 1000;
+  ps /= deltaMs;
+  std::cout << name<<"=" << ps << " messages/s" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 0;
+  while (argc > 0) {
+      if (strncmp ("--n=", argv[0],strlen ("--n=")) == 0)
+        {
+          char const *nAscii = argv[0] + strlen ("--n=");
+          std::istringstream iss;
+          iss.str (nAscii);
+          iss >> n;
+        }
+      if (strncmp ("--prefixes=", argv[0],strlen ("--prefixes=")) == 0)
+        {
+          char const *nAscii = argv[0] + strlen ("--prefixes=");
+          std::istringstream iss;
+          iss.str (nAscii);
+          iss >> g_nPrefixes;
+        }
+      argc--;
+      argv++;
+  }
+  if (n == 0)
+    {
+      std::cerr << "Error-- number of messages must be specified " <<
+        "by command-line argument --n=(number of messages)" << std::endl;
+      exit (1);
+    }
+  if (g_nPrefixes == 0 || g_nPrefixes > 8)
+    {
+      std::cerr << "Error-- --prefixes must be between 1 and 8" << std::endl;
+      exit (1);
+    }
+
+  Setup ();
+
+  std::cout << "Running bench-mobility-options with n=" << n
+            << " prefixes=" << g_nPrefixes
+            << " (" << (uint32_t)g_length << " option bytes)" << std::endl;
+
+  runBench (&benchPacket, n, "packet");
+  runBench (&benchBuffer, n, "buffer");
+
+  g_mobility = 0;
+  g_demux = 0;
+  g_node->Dispose ();
+  g_node = 0;
+
+  return 0;
+}
@@ -0,0 +1,229 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Proxy Mobile IPv6 (PMIPv6) (RFC5213) Implementation
+ *
+ * Copyright (c) 2010 KUT, ETRI
+ * (Korea Univerity of Technology and Education)
+ * (Electronics and Telecommunications Research Institute)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measures the uplink forwarding of Ipv6StaticSourceRouting on a MAG:
+ * one source route per attached MN home network prefix into the tunnel,
+ * and for one MN out of ten a route from its prefix to the prefix of
+ * another MN, as for local routing. Packets go through RouteInput, from
+ * a host of a home network prefix to a correspondent node.
+ */
+
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/packet.h"
+#include "ns3/node.h"
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/mac48-address.h"
+#include "ns3/ipv6-header.h"
+#include "ns3/ipv6-route.h"
+#include "ns3/ipv6-l3-protocol.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv6-static-source-routing.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <string.h>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+static Ptr<Node> g_node;
+static Ptr<Ipv6StaticSourceRouting> g_routing;
+static Ptr<NetDevice> g_access;
+static std::vector<Ipv6Address> g_sources;
+static std::vector<Ipv6Address> g_prefixes;
+static uint32_t g_nMns = 10000;
+static uint32_t g_nTunnels = 4;
+static uint32_t g_forwarded = 0;
+
+static Ipv6Address
+MakePrefix (uint32_t i)
+{
+  uint8_t buf[16] = { 0x20, 0x01, 0x0d, 0xb8, (uint8_t)(i >> 24), (uint8_t)(i >> 16), (uint8_t)(i >> 8), (uint8_t)i };
+  return Ipv6Address (buf);
+}
+
+static void
+Forward (Ptr<Ipv6Route> route, Ptr<const Packet> p, const Ipv6Header &header)
+{
+  g_forwarded++;
+}
+
+static void
+LocalDeliver (Ptr<const Packet> p, const Ipv6Header &header, uint32_t iif)
+{
+}
+
+static void
+MulticastForward (Ptr<Ipv6MulticastRoute> route, Ptr<const Packet> p, const Ipv6Header &header)
+{
+}
+
+static void
+Error (Ptr<const Packet> p, const Ipv6Header &header, Socket::SocketErrno err)
+{
+}
+
+static void
+Setup (void)
+{
+  Config::SetDefault ("ns3::Icmpv6L4Protocol::DAD", BooleanValue (false));
+
+  g_node = CreateObject<Node> ();
+  InternetStackHelper internet;
+  internet.SetIpv4StackInstall (false);
+  internet.Install (g_node);
+
+  /* interface 1 is the access link, the others the tunnels to the LMAs */
+  Ptr<Ipv6L3Protocol> ipv6 = g_node->GetObject<Ipv6L3Protocol> ();
+  for (uint32_t i = 0; i <= g_nTunnels; i++)
+    {
+      Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+      device->SetAddress (Mac48Address::Allocate ());
+      g_node->AddDevice (device);
+      uint32_t index = ipv6->AddInterface (device);
+      ipv6->SetUp (index);
+      ipv6->SetForwarding (index, true);
+      if (i == 0)
+        {
+          g_access = device;
+        }
+    }
+
+  g_routing = CreateObject<Ipv6StaticSourceRouting> ();
+  g_routing->SetIpv6 (ipv6);
+
+  for (uint32_t i = 0; i < g_nMns; i++)
+    {
+      uint32_t tunnel = 2 + i % g_nTunnels;
+      g_routing->AddNetworkRouteFrom (MakePrefix (i), Ipv6Prefix (64), tunnel);
+      g_prefixes.push_back (MakePrefix (i));
+      if (i % 10 == 0)
+        {
+          g_routing->AddNetworkRouteFromTo (MakePrefix (i), Ipv6Prefix (64), MakePrefix ((i + 1) % g_nMns), Ipv6Prefix (64), 1);
+        }
+
+      uint8_t buf[16];
+      MakePrefix (i).GetBytes (buf);
+      buf[15] = 1;
+      g_sources.push_back (Ipv6Address (buf));
+    }
+}
+
+static void
+benchForward (uint32_t n)
+{
+  Ptr<Packet> p = Create<Packet> (64);
+  Ipv6Header header;
+  header.SetDestinationAddress ("2001:db8:ffff::1");
+
+  for (uint32_t i = 0; i < n; i++)
+    {
+      header.SetSourceAddress (g_sources[(i * 7919) % g_sources.size ()]);
+      g_routing->RouteInput (p, header, g_access,
+                             MakeCallback (&Forward), MakeCallback (&MulticastForward),
+                             MakeCallback (&LocalDeliver), MakeCallback (&Error));
+    }
+}
+
+static void
+runBench (void (*bench) (uint32_t), uint32_t n, char const *name)
+{
+  SystemWallClockMs time;
+  time.Start ();
+  (*bench) (n);
+  uint64_t deltaMs = time.End ();
+  double ps = n;
+  ps *= 1000;
+  ps /= deltaMs;
+  std::cout << name<<"=" << ps << " packets/s" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 0;
+  while (argc > 0) {
+      if (strncmp ("--n=", argv[0],strlen ("--n=")) == 0)
+        {
+          char const *nAscii = argv[0] + strlen ("--n=");
+          std::istringstream iss;
+          iss.str (nAscii);
+          iss >> n;
+        }
+      if (strncmp ("--mns=", argv[0],strlen ("--mns=")) == 0)
+        {
+          char const *nAscii = argv[0] + strlen ("--mns=");
+          std::istringstream iss;
+          iss.str (nAscii);
+          iss >> g_nMns;
+        }
+      argc--;
+      argv++;
+  }
+  if (n == 0)
+    {
+      std::cerr << "Error-- number of packets must be specified " <<
+        "by command-line argument --n=(number of packets)" << std::endl;
+      exit (1);
+    }
+  if (g_nMns == 0)
+    {
+      std::cerr << "Error-- --mns must be at least 1" << std::endl;
+      exit (1);
+    }
+
+  SystemWallClockMs time;
+  time.Start ();
+  Setup ();
+  uint64_t setupMs = time.End ();
+
+  std::cout << "Running bench-source-routes with n=" << n
+            << " routes=" << g_routing->GetNRoutes ()
+            << " routes-from-to=" << g_routing->GetNRoutesFromTo ()
+            << " (setup " << setupMs << " ms)" << std::endl;
+
+  runBench (&benchForward, n, "forward");
+
+  if (g_forwarded != n)
+    {
+      std::cerr << "Error-- " << n - g_forwarded << " packets were not forwarded" << std::endl;
+      exit (1);
+    }
+
+  time.Start ();
+  for (uint32_t i = 0; i < g_nMns; i++)
+    {
+      g_routing->RemoveRoute (g_prefixes[i], Ipv6Prefix (64), 2 + i % g_nTunnels, g_prefixes[i]);
+    }
+  std::cout << "remove=" << time.End () << " ms, " << g_routing->GetNRoutes () << " routes left" << std::endl;
+
+  g_routing->Dispose ();
+  g_routing = 0;
+  g_access = 0;
+  g_node->Dispose ();
+  g_node = 0;
+
+  return 0;
+}